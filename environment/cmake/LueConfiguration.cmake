@@ -240,6 +240,12 @@ if(LUE_BUILD_FRAMEWORK)
                 "2"
     )
 
+    # Numbers of layers of material for which the operations routing multiple layers at once are
+    # instantiated
+    set(LUE_FRAMEWORK_NR_MATERIAL_LAYERS
+        2 3 4 CACHE STRING
+        "Number(s) of layers of material routed at once")
+
     include(CheckTypeSize)
     set(CMAKE_EXTRA_INCLUDE_FILES "chrono")
     check_type_size(
@@ -1,7 +1,9 @@
 #pragma once
+#include "lue/framework/algorithm/flow_network.hpp"
 #include "lue/framework/algorithm/policy.hpp"
 #include "lue/framework/algorithm/scalar.hpp"
 #include "lue/framework/partitioned_array_decl.hpp"
+#include <array>
 
 
 namespace lue {
@@ -27,4 +29,58 @@ namespace lue {
         Scalar<policy::InputElementT<Policies, 1>> const& inflow)
         -> PartitionedArray<policy::OutputElementT<Policies, 0>, 2>;
 
+
+    /*!
+        @overload
+    */
+    template<typename Policies>
+    auto accu(
+        Policies const& policies,
+        FlowNetwork<policy::InputElementT<Policies, 0>, policy::InputElementT<Policies, 1>> const&
+            flow_network,
+        PartitionedArray<policy::InputElementT<Policies, 1>, 2> const& inflow)
+        -> PartitionedArray<policy::OutputElementT<Policies, 0>, 2>;
+
+
+    /*!
+        @overload
+    */
+    template<typename Policies>
+    auto accu(
+        Policies const& policies,
+        FlowNetwork<policy::InputElementT<Policies, 0>, policy::InputElementT<Policies, 1>> const&
+            flow_network,
+        Scalar<policy::InputElementT<Policies, 1>> const& inflow)
+        -> PartitionedArray<policy::OutputElementT<Policies, 0>, 2>;
+
+
+    /*!
+        @brief      Accumulate @a nr_layers layers of @a inflow through @a flow_direction field
+                    and return the results
+
+        This is equivalent to, but cheaper than, calling accu() for each layer. All layers are
+        routed in a single pass through the flow direction field. Per cell draining into a
+        neighbouring partition, the material of all layers is sent in one message.
+
+        Instantiated for the numbers of layers in the LUE_FRAMEWORK_NR_MATERIAL_LAYERS CMake variable.
+    */
+    template<typename Policies, std::size_t nr_layers>
+    auto accu(
+        Policies const& policies,
+        PartitionedArray<policy::InputElementT<Policies, 0>, 2> const& flow_direction,
+        std::array<PartitionedArray<policy::InputElementT<Policies, 1>, 2>, nr_layers> const& inflow)
+        -> std::array<PartitionedArray<policy::OutputElementT<Policies, 0>, 2>, nr_layers>;
+
+
+    /*!
+        @overload
+    */
+    template<typename Policies, std::size_t nr_layers>
+    auto accu(
+        Policies const& policies,
+        FlowNetwork<policy::InputElementT<Policies, 0>, policy::InputElementT<Policies, 1>> const&
+            flow_network,
+        std::array<PartitionedArray<policy::InputElementT<Policies, 1>, 2>, nr_layers> const& inflow)
+        -> std::array<PartitionedArray<policy::OutputElementT<Policies, 0>, 2>, nr_layers>;
+
 }  // namespace lue
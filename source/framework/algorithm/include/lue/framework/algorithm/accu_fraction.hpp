@@ -1,7 +1,9 @@
 #pragma once
+#include "lue/framework/algorithm/flow_network.hpp"
 #include "lue/framework/algorithm/policy.hpp"
 #include "lue/framework/algorithm/scalar.hpp"
 #include "lue/framework/partitioned_array_decl.hpp"
+#include <array>
 
 
 namespace lue {
@@ -49,4 +51,91 @@ namespace lue {
             PartitionedArray<policy::OutputElementT<Policies, 0>, 2>,
             PartitionedArray<policy::OutputElementT<Policies, 1>, 2>>;
 
+
+    template<typename Policies>
+    auto accu_fraction(
+        Policies const& policies,
+        FlowNetwork<policy::InputElementT<Policies, 0>, policy::InputElementT<Policies, 1>> const&
+            flow_network,
+        PartitionedArray<policy::InputElementT<Policies, 1>, 2> const& inflow,
+        PartitionedArray<policy::InputElementT<Policies, 2>, 2> const& fraction)
+        -> std::tuple<
+            PartitionedArray<policy::OutputElementT<Policies, 0>, 2>,
+            PartitionedArray<policy::OutputElementT<Policies, 1>, 2>>;
+
+
+    template<typename Policies>
+    auto accu_fraction(
+        Policies const& policies,
+        FlowNetwork<policy::InputElementT<Policies, 0>, policy::InputElementT<Policies, 1>> const&
+            flow_network,
+        PartitionedArray<policy::InputElementT<Policies, 1>, 2> const& inflow,
+        Scalar<policy::InputElementT<Policies, 2>> const& fraction)
+        -> std::tuple<
+            PartitionedArray<policy::OutputElementT<Policies, 0>, 2>,
+            PartitionedArray<policy::OutputElementT<Policies, 1>, 2>>;
+
+
+    template<typename Policies>
+    auto accu_fraction(
+        Policies const& policies,
+        FlowNetwork<policy::InputElementT<Policies, 0>, policy::InputElementT<Policies, 1>> const&
+            flow_network,
+        Scalar<policy::InputElementT<Policies, 1>> const& inflow,
+        Scalar<policy::InputElementT<Policies, 2>> const& fraction)
+        -> std::tuple<
+            PartitionedArray<policy::OutputElementT<Policies, 0>, 2>,
+            PartitionedArray<policy::OutputElementT<Policies, 1>, 2>>;
+
+
+    template<typename Policies>
+    auto accu_fraction(
+        Policies const& policies,
+        FlowNetwork<policy::InputElementT<Policies, 0>, policy::InputElementT<Policies, 1>> const&
+            flow_network,
+        Scalar<policy::InputElementT<Policies, 1>> const& inflow,
+        PartitionedArray<policy::InputElementT<Policies, 2>, 2> const& fraction)
+        -> std::tuple<
+            PartitionedArray<policy::OutputElementT<Policies, 0>, 2>,
+            PartitionedArray<policy::OutputElementT<Policies, 1>, 2>>;
+
+
+    /*!
+        @brief      Accumulate @a nr_layers layers of @a inflow through @a flow_direction field,
+                    passing on @a fraction of the material in each cell, and return the outflow and
+                    remainder per layer
+
+        This is equivalent to, but cheaper than, calling accu_fraction() for each layer. All layers
+        are routed in a single pass through the flow direction field, using the same fraction for
+        each layer. Per cell draining into a neighbouring partition, the material of all layers is
+        sent in one message.
+
+        Instantiated for the numbers of layers in the LUE_FRAMEWORK_NR_MATERIAL_LAYERS CMake
+        variable.
+    */
+    template<typename Policies, std::size_t nr_layers>
+    auto accu_fraction(
+        Policies const& policies,
+        PartitionedArray<policy::InputElementT<Policies, 0>, 2> const& flow_direction,
+        std::array<PartitionedArray<policy::InputElementT<Policies, 1>, 2>, nr_layers> const& inflow,
+        PartitionedArray<policy::InputElementT<Policies, 2>, 2> const& fraction)
+        -> std::tuple<
+            std::array<PartitionedArray<policy::OutputElementT<Policies, 0>, 2>, nr_layers>,
+            std::array<PartitionedArray<policy::OutputElementT<Policies, 1>, 2>, nr_layers>>;
+
+
+    /*!
+        @overload
+    */
+    template<typename Policies, std::size_t nr_layers>
+    auto accu_fraction(
+        Policies const& policies,
+        FlowNetwork<policy::InputElementT<Policies, 0>, policy::InputElementT<Policies, 1>> const&
+            flow_network,
+        std::array<PartitionedArray<policy::InputElementT<Policies, 1>, 2>, nr_layers> const& inflow,
+        PartitionedArray<policy::InputElementT<Policies, 2>, 2> const& fraction)
+        -> std::tuple<
+            std::array<PartitionedArray<policy::OutputElementT<Policies, 0>, 2>, nr_layers>,
+            std::array<PartitionedArray<policy::OutputElementT<Policies, 1>, 2>, nr_layers>>;
+
 }  // namespace lue
@@ -1,4 +1,5 @@
 #pragma once
+#include "lue/framework/algorithm/flow_network.hpp"
 #include "lue/framework/algorithm/policy.hpp"
 #include "lue/framework/algorithm/scalar.hpp"
 #include "lue/framework/partitioned_array_decl.hpp"
@@ -49,4 +50,52 @@ namespace lue {
             PartitionedArray<policy::OutputElementT<Policies, 0>, 2>,
             PartitionedArray<policy::OutputElementT<Policies, 1>, 2>>;
 
+
+    template<typename Policies>
+    auto accu_threshold(
+        Policies const& policies,
+        FlowNetwork<policy::InputElementT<Policies, 0>, policy::InputElementT<Policies, 1>> const&
+            flow_network,
+        PartitionedArray<policy::InputElementT<Policies, 1>, 2> const& inflow,
+        PartitionedArray<policy::InputElementT<Policies, 2>, 2> const& threshold)
+        -> std::tuple<
+            PartitionedArray<policy::OutputElementT<Policies, 0>, 2>,
+            PartitionedArray<policy::OutputElementT<Policies, 1>, 2>>;
+
+
+    template<typename Policies>
+    auto accu_threshold(
+        Policies const& policies,
+        FlowNetwork<policy::InputElementT<Policies, 0>, policy::InputElementT<Policies, 1>> const&
+            flow_network,
+        PartitionedArray<policy::InputElementT<Policies, 1>, 2> const& inflow,
+        Scalar<policy::InputElementT<Policies, 2>> const& threshold)
+        -> std::tuple<
+            PartitionedArray<policy::OutputElementT<Policies, 0>, 2>,
+            PartitionedArray<policy::OutputElementT<Policies, 1>, 2>>;
+
+
+    template<typename Policies>
+    auto accu_threshold(
+        Policies const& policies,
+        FlowNetwork<policy::InputElementT<Policies, 0>, policy::InputElementT<Policies, 1>> const&
+            flow_network,
+        Scalar<policy::InputElementT<Policies, 1>> const& inflow,
+        Scalar<policy::InputElementT<Policies, 2>> const& threshold)
+        -> std::tuple<
+            PartitionedArray<policy::OutputElementT<Policies, 0>, 2>,
+            PartitionedArray<policy::OutputElementT<Policies, 1>, 2>>;
+
+
+    template<typename Policies>
+    auto accu_threshold(
+        Policies const& policies,
+        FlowNetwork<policy::InputElementT<Policies, 0>, policy::InputElementT<Policies, 1>> const&
+            flow_network,
+        Scalar<policy::InputElementT<Policies, 1>> const& inflow,
+        PartitionedArray<policy::InputElementT<Policies, 2>, 2> const& threshold)
+        -> std::tuple<
+            PartitionedArray<policy::OutputElementT<Policies, 0>, 2>,
+            PartitionedArray<policy::OutputElementT<Policies, 1>, 2>>;
+
 }  // namespace lue
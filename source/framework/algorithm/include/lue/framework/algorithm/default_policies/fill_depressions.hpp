@@ -0,0 +1,31 @@
+#pragma once
+#include "lue/framework/algorithm/fill_depressions.hpp"
+#include <concepts>
+
+
+namespace lue {
+    namespace policy::fill_depressions {
+
+        template<std::integral FlowDirectionElement, std::floating_point ElevationElement>
+        using DefaultPolicies = policy::DefaultPolicies<
+            AllValuesWithinDomain<ElevationElement>,
+            OutputElements<ElevationElement, FlowDirectionElement>,
+            InputElements<ElevationElement>>;
+
+    }  // namespace policy::fill_depressions
+
+
+    namespace default_policies {
+
+        template<std::integral FlowDirectionElement, std::floating_point ElevationElement>
+        auto fill_depressions(PartitionedArray<ElevationElement, 2> const& elevation)
+            -> std::tuple<PartitionedArray<ElevationElement, 2>, PartitionedArray<FlowDirectionElement, 2>>
+        {
+            using Policies =
+                policy::fill_depressions::DefaultPolicies<FlowDirectionElement, ElevationElement>;
+
+            return fill_depressions(Policies{}, elevation);
+        }
+
+    }  // namespace default_policies
+}  // namespace lue
@@ -4,6 +4,9 @@
 #include "lue/framework/algorithm/detail/verify_compatible.hpp"
 #include "lue/framework/algorithm/routing_operation_export.hpp"
 #include "lue/macro.hpp"
+#include <array>
+#include <span>
+#include <tuple>
 
 
 namespace lue {
@@ -223,6 +226,249 @@ namespace lue {
     };
 
 
+    /*!
+        @brief      Functor for accumulating @a nr_layers_ layers of material at once
+
+        Per cell, the material of all layers is accumulated in one go, and sent to neighbouring
+        partitions in a single message.
+    */
+    template<typename Policies, std::size_t nr_layers_>
+    class AccuLayers:
+        public AccumulatingRouterFunctor<
+            policy::detail::RepeatedTypeList<policy::InputElementT<Policies, 1>, nr_layers_>,
+            policy::detail::RepeatedTypeList<policy::OutputElementT<Policies, 0>, nr_layers_>>
+    {
+
+        private:
+
+            using Base = AccumulatingRouterFunctor<
+                policy::detail::RepeatedTypeList<policy::InputElementT<Policies, 1>, nr_layers_>,
+                policy::detail::RepeatedTypeList<policy::OutputElementT<Policies, 0>, nr_layers_>>;
+
+        public:
+
+            static_assert(nr_layers_ > 0);
+
+            template<typename Material>
+            class CellAccumulator
+            {
+
+                public:
+
+                    using DomainPolicy = policy::DomainPolicyT<Policies>;
+                    using InflowNoDataPolicy =
+                        policy::InputNoDataPolicy2T<policy::InputPoliciesT<Policies, 1>>;
+                    using OutflowNoDataPolicy =
+                        policy::OutputNoDataPolicy2T<policy::OutputPoliciesT<Policies, 0>>;
+
+                    static_assert(std::is_same_v<ElementT<Material>, policy::InputElementT<Policies, 1>>);
+
+                    using MaterialElement = policy::ElementT<InflowNoDataPolicy>;
+
+                    static_assert(std::is_same_v<policy::ElementT<InflowNoDataPolicy>, MaterialElement>);
+                    static_assert(std::is_same_v<policy::ElementT<OutflowNoDataPolicy>, MaterialElement>);
+
+                    using MaterialData = DataT<PartitionedArray<MaterialElement, 2>>;
+
+                    static constexpr std::size_t nr_layers{nr_layers_};
+
+
+                    CellAccumulator(
+                        Policies const& policies,
+                        std::array<Material, nr_layers> const& external_inflow,
+                        std::array<MaterialData*, nr_layers> const& outflow):
+
+                        _dp{policies.domain_policy()},
+                        _indp_inflow{std::get<1>(policies.inputs_policies()).input_no_data_policy()},
+                        _ondp_outflow{std::get<0>(policies.outputs_policies()).output_no_data_policy()},
+
+                        _external_inflow{external_inflow},
+                        _outflow{outflow}
+
+                    {
+                    }
+
+
+                    void enter_intra_partition_stream(
+                        [[maybe_unused]] Index const idx0, [[maybe_unused]] Index const idx1)
+                    {
+                    }
+
+
+                    void leave_intra_partition_stream(
+                        [[maybe_unused]] Index const idx0, [[maybe_unused]] Index const idx1)
+                    {
+                    }
+
+
+                    void enter_inter_partition_stream(
+                        std::span<MaterialElement const, nr_layers> const outflow,
+                        Index const idx0,
+                        Index const idx1)
+                    {
+                        // The results for the upstream cell are ready
+                        for (std::size_t layer = 0; layer < nr_layers; ++layer)
+                        {
+                            add_outflow(outflow[layer], (*_outflow[layer])(idx0, idx1));
+                        }
+                    }
+
+
+                    void leave_inter_partition_stream(
+                        [[maybe_unused]] Index const idx0, [[maybe_unused]] Index const idx1)
+                    {
+                    }
+
+
+                    void enter_cell(Index const idx0, Index const idx1)
+                    {
+                        for (std::size_t layer = 0; layer < nr_layers; ++layer)
+                        {
+                            MaterialElement const& external_inflow{
+                                detail::to_value(_external_inflow[layer], idx0, idx1)};
+
+                            MaterialElement& outflow{(*_outflow[layer])(idx0, idx1)};
+
+                            if (!_ondp_outflow.is_no_data(outflow))
+                            {
+                                if (_indp_inflow.is_no_data(external_inflow) ||
+                                    !_dp.within_domain(external_inflow))
+                                {
+                                    _ondp_outflow.mark_no_data(outflow);
+                                }
+                                else
+                                {
+                                    outflow += external_inflow;
+                                }
+                            }
+                        }
+                    }
+
+
+                    void leave_cell(
+                        Index const idx0_from,
+                        Index const idx1_from,
+                        Index const idx0_to,
+                        Index const idx1_to)
+                    {
+                        // The results for the upstream cell are ready. Use
+                        // its outflow as inflow for the downstream cell.
+                        for (std::size_t layer = 0; layer < nr_layers; ++layer)
+                        {
+                            MaterialData& outflow{*_outflow[layer]};
+
+                            add_outflow(outflow(idx0_from, idx1_from), outflow(idx0_to, idx1_to));
+                        }
+                    }
+
+
+                    void stop_at_sink_cell(
+                        [[maybe_unused]] Index const idx0, [[maybe_unused]] Index const idx1)
+                    {
+                    }
+
+
+                    void stop_at_confluence_cell(
+                        [[maybe_unused]] Index const idx0, [[maybe_unused]] Index const idx1)
+                    {
+                    }
+
+
+                    void stop_at_partition_output_cell(
+                        [[maybe_unused]] Index const idx0, [[maybe_unused]] Index const idx1)
+                    {
+                    }
+
+
+                    auto outflow(Index const idx0, Index const idx1) const
+                        -> std::array<MaterialElement, nr_layers>
+                    {
+                        std::array<MaterialElement, nr_layers> result{};
+
+                        for (std::size_t layer = 0; layer < nr_layers; ++layer)
+                        {
+                            result[layer] = (*_outflow[layer])(idx0, idx1);
+                        }
+
+                        return result;
+                    }
+
+
+                    void mark_no_data(Index const idx0, Index const idx1)
+                    {
+                        for (std::size_t layer = 0; layer < nr_layers; ++layer)
+                        {
+                            _ondp_outflow.mark_no_data(*_outflow[layer], idx0, idx1);
+                        }
+                    }
+
+
+                private:
+
+                    void add_outflow(MaterialElement const& outflow, MaterialElement& inflow)
+                    {
+                        if (!_ondp_outflow.is_no_data(inflow))
+                        {
+                            if (_ondp_outflow.is_no_data(outflow))
+                            {
+                                _ondp_outflow.mark_no_data(inflow);
+                            }
+                            else
+                            {
+                                // Just add the outflow from upstream to
+                                // the inflow of the downstream cell
+                                inflow += outflow;
+                            }
+                        }
+                    }
+
+
+                    DomainPolicy _dp;
+
+                    InflowNoDataPolicy _indp_inflow;
+
+                    OutflowNoDataPolicy _ondp_outflow;
+
+                    std::array<Material, nr_layers> const _external_inflow;  // External inflow
+
+                    std::array<MaterialData*, nr_layers> const _outflow;  // Upstream inflow, outflow
+            };
+
+
+            static constexpr char const* name{"accu_layers"};
+
+            using Material = policy::InputElementT<Policies, 1>;
+
+            using MaterialPartitions = typename PartitionedArray<Material, 2>::Partitions;
+            using MaterialPartition = ArrayPartition<Material, 2>;
+            using MaterialData = DataT<MaterialPartition>;
+
+            using IntraPartitionStreamCellsResult = decltype(std::tuple_cat(
+                std::declval<std::array<hpx::future<MaterialData>, nr_layers_>>(),
+                std::declval<std::tuple<
+                    hpx::future<typename Base::InflowCountData>,
+                    hpx::future<std::array<typename Base::CellsIdxs, detail::nr_neighbours<2>()>>>>()));
+
+            using InterPartitionStreamCellsResult =
+                decltype(std::tuple_cat(std::declval<std::array<hpx::future<MaterialData>, nr_layers_>>()));
+
+
+            template<typename... Material>
+            auto cell_accumulator(
+                Policies const& policies,
+                Material const&... external_inflow,
+                std::same_as<MaterialData> auto&... outflow) const
+                -> CellAccumulator<std::common_type_t<Material...>>
+            {
+                static_assert(sizeof...(Material) == nr_layers_);
+                static_assert(sizeof...(outflow) == nr_layers_);
+
+                return CellAccumulator<std::common_type_t<Material...>>{
+                    policies, {external_inflow...}, {&outflow...}};
+            }
+    };
+
+
     template<typename Policies>
     auto accu(
         Policies const& policies,
@@ -246,6 +492,85 @@ namespace lue {
         return std::get<0>(accumulating_router(policies, Accu<Policies>{}, flow_direction, inflow));
     }
 
+
+    template<typename Policies>
+    auto accu(
+        Policies const& policies,
+        FlowNetwork<policy::InputElementT<Policies, 0>, policy::InputElementT<Policies, 1>> const&
+            flow_network,
+        PartitionedArray<policy::InputElementT<Policies, 1>, 2> const& inflow)
+        -> PartitionedArray<policy::OutputElementT<Policies, 0>, 2>
+    {
+        detail::verify_compatible(flow_network.flow_direction(), inflow);
+
+        return std::get<0>(accumulating_router(policies, Accu<Policies>{}, flow_network, inflow));
+    }
+
+
+    template<typename Policies>
+    auto accu(
+        Policies const& policies,
+        FlowNetwork<policy::InputElementT<Policies, 0>, policy::InputElementT<Policies, 1>> const&
+            flow_network,
+        Scalar<policy::InputElementT<Policies, 1>> const& inflow)
+        -> PartitionedArray<policy::OutputElementT<Policies, 0>, 2>
+    {
+        return std::get<0>(accumulating_router(policies, Accu<Policies>{}, flow_network, inflow));
+    }
+
+
+    template<typename Policies, std::size_t nr_layers>
+    auto accu(
+        Policies const& policies,
+        PartitionedArray<policy::InputElementT<Policies, 0>, 2> const& flow_direction,
+        std::array<PartitionedArray<policy::InputElementT<Policies, 1>, 2>, nr_layers> const& inflow)
+        -> std::array<PartitionedArray<policy::OutputElementT<Policies, 0>, 2>, nr_layers>
+    {
+        for (auto const& layer : inflow)
+        {
+            detail::verify_compatible(flow_direction, layer);
+        }
+
+        using Outflow = std::array<PartitionedArray<policy::OutputElementT<Policies, 0>, 2>, nr_layers>;
+
+        return std::apply(
+            [&](auto const&... layers)
+            {
+                return std::apply(
+                    [](auto&&... outflow) -> Outflow { return Outflow{std::move(outflow)...}; },
+                    accumulating_router(
+                        policies, AccuLayers<Policies, nr_layers>{}, flow_direction, layers...));
+            },
+            inflow);
+    }
+
+
+    template<typename Policies, std::size_t nr_layers>
+    auto accu(
+        Policies const& policies,
+        FlowNetwork<policy::InputElementT<Policies, 0>, policy::InputElementT<Policies, 1>> const&
+            flow_network,
+        std::array<PartitionedArray<policy::InputElementT<Policies, 1>, 2>, nr_layers> const& inflow)
+        -> std::array<PartitionedArray<policy::OutputElementT<Policies, 0>, 2>, nr_layers>
+    {
+        for (auto const& layer : inflow)
+        {
+            detail::verify_compatible(flow_network.flow_direction(), layer);
+        }
+
+        using Outflow = std::array<PartitionedArray<policy::OutputElementT<Policies, 0>, 2>, nr_layers>;
+
+        return std::apply(
+            [&](auto const&... layers)
+            {
+                return std::apply(
+                    [](auto&&... outflow) -> Outflow { return Outflow{std::move(outflow)...}; },
+                    accumulating_router(
+                        policies, AccuLayers<Policies, nr_layers>{}, flow_network, layers...));
+            },
+            inflow);
+    }
+
 }  // namespace lue
 
 
@@ -261,4 +586,31 @@ namespace lue {
         ArgumentType<void(Policies)> const&,                                                                 \
         PartitionedArray<policy::InputElementT<Policies, 0>, 2> const&,                                      \
         Scalar<policy::InputElementT<Policies, 1>> const&)                                                   \
+        -> PartitionedArray<policy::OutputElementT<Policies, 0>, 2>;                                         \
+                                                                                                             \
+    template LUE_ROUTING_OPERATION_EXPORT auto accu<ArgumentType<void(Policies)>>(                           \
+        ArgumentType<void(Policies)> const&,                                                                 \
+        FlowNetwork<policy::InputElementT<Policies, 0>, policy::InputElementT<Policies, 1>> const&,          \
+        PartitionedArray<policy::InputElementT<Policies, 1>, 2> const&)                                      \
+        -> PartitionedArray<policy::OutputElementT<Policies, 0>, 2>;                                         \
+                                                                                                             \
+    template LUE_ROUTING_OPERATION_EXPORT auto accu<ArgumentType<void(Policies)>>(                           \
+        ArgumentType<void(Policies)> const&,                                                                 \
+        FlowNetwork<policy::InputElementT<Policies, 0>, policy::InputElementT<Policies, 1>> const&,          \
+        Scalar<policy::InputElementT<Policies, 1>> const&)                                                   \
         -> PartitionedArray<policy::OutputElementT<Policies, 0>, 2>;
+
+
+#define LUE_INSTANTIATE_ACCU_LAYERS(Policies, nr_layers)                                                     \
+                                                                                                             \
+    template LUE_ROUTING_OPERATION_EXPORT auto accu<ArgumentType<void(Policies)>, nr_layers>(                \
+        ArgumentType<void(Policies)> const&,                                                                 \
+        PartitionedArray<policy::InputElementT<Policies, 0>, 2> const&,                                      \
+        std::array<PartitionedArray<policy::InputElementT<Policies, 1>, 2>, nr_layers> const&)               \
+        -> std::array<PartitionedArray<policy::OutputElementT<Policies, 0>, 2>, nr_layers>;                  \
+                                                                                                             \
+    template LUE_ROUTING_OPERATION_EXPORT auto accu<ArgumentType<void(Policies)>, nr_layers>(                \
+        ArgumentType<void(Policies)> const&,                                                                 \
+        FlowNetwork<policy::InputElementT<Policies, 0>, policy::InputElementT<Policies, 1>> const&,          \
+        std::array<PartitionedArray<policy::InputElementT<Policies, 1>, 2>, nr_layers> const&)               \
+        -> std::array<PartitionedArray<policy::OutputElementT<Policies, 0>, 2>, nr_layers>;
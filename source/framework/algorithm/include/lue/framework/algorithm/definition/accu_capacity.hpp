@@ -348,6 +348,72 @@ namespace lue {
         return accumulating_router(policies, AccuCapacity<Policies>{}, flow_direction, inflow, capacity);
     }
 
+
+    template<typename Policies>
+    auto accu_capacity(
+        Policies const& policies,
+        FlowNetwork<policy::InputElementT<Policies, 0>, policy::InputElementT<Policies, 1>> const&
+            flow_network,
+        PartitionedArray<policy::InputElementT<Policies, 1>, 2> const& inflow,
+        PartitionedArray<policy::InputElementT<Policies, 2>, 2> const& capacity)
+        -> std::tuple<
+            PartitionedArray<policy::OutputElementT<Policies, 0>, 2>,
+            PartitionedArray<policy::OutputElementT<Policies, 1>, 2>>
+    {
+        detail::verify_compatible(flow_network.flow_direction(), inflow, capacity);
+
+        return accumulating_router(policies, AccuCapacity<Policies>{}, flow_network, inflow, capacity);
+    }
+
+
+    template<typename Policies>
+    auto accu_capacity(
+        Policies const& policies,
+        FlowNetwork<policy::InputElementT<Policies, 0>, policy::InputElementT<Policies, 1>> const&
+            flow_network,
+        PartitionedArray<policy::InputElementT<Policies, 1>, 2> const& inflow,
+        Scalar<policy::InputElementT<Policies, 2>> const& capacity)
+        -> std::tuple<
+            PartitionedArray<policy::OutputElementT<Policies, 0>, 2>,
+            PartitionedArray<policy::OutputElementT<Policies, 1>, 2>>
+    {
+        detail::verify_compatible(flow_network.flow_direction(), inflow);
+
+        return accumulating_router(policies, AccuCapacity<Policies>{}, flow_network, inflow, capacity);
+    }
+
+
+    template<typename Policies>
+    auto accu_capacity(
+        Policies const& policies,
+        FlowNetwork<policy::InputElementT<Policies, 0>, policy::InputElementT<Policies, 1>> const&
+            flow_network,
+        Scalar<policy::InputElementT<Policies, 1>> const& inflow,
+        Scalar<policy::InputElementT<Policies, 2>> const& capacity)
+        -> std::tuple<
+            PartitionedArray<policy::OutputElementT<Policies, 0>, 2>,
+            PartitionedArray<policy::OutputElementT<Policies, 1>, 2>>
+    {
+        return accumulating_router(policies, AccuCapacity<Policies>{}, flow_network, inflow, capacity);
+    }
+
+
+    template<typename Policies>
+    auto accu_capacity(
+        Policies const& policies,
+        FlowNetwork<policy::InputElementT<Policies, 0>, policy::InputElementT<Policies, 1>> const&
+            flow_network,
+        Scalar<policy::InputElementT<Policies, 1>> const& inflow,
+        PartitionedArray<policy::InputElementT<Policies, 2>, 2> const& capacity)
+        -> std::tuple<
+            PartitionedArray<policy::OutputElementT<Policies, 0>, 2>,
+            PartitionedArray<policy::OutputElementT<Policies, 1>, 2>>
+    {
+        detail::verify_compatible(flow_network.flow_direction(), capacity);
+
+        return accumulating_router(policies, AccuCapacity<Policies>{}, flow_network, inflow, capacity);
+    }
+
 }  // namespace lue
 
 
@@ -385,6 +451,42 @@ namespace lue {
         PartitionedArray<policy::InputElementT<Policies, 0>, 2> const&,                                      \
         Scalar<policy::InputElementT<Policies, 1>> const&,                                                   \
         PartitionedArray<policy::InputElementT<Policies, 2>, 2> const&)                                      \
+        -> std::tuple<                                                                                       \
+            PartitionedArray<policy::OutputElementT<Policies, 0>, 2>,                                        \
+            PartitionedArray<policy::OutputElementT<Policies, 1>, 2>>;                                       \
+                                                                                                             \
+    template LUE_ROUTING_OPERATION_EXPORT auto accu_capacity<ArgumentType<void(Policies)>>(                  \
+        ArgumentType<void(Policies)> const&,                                                                 \
+        FlowNetwork<policy::InputElementT<Policies, 0>, policy::InputElementT<Policies, 1>> const&,          \
+        PartitionedArray<policy::InputElementT<Policies, 1>, 2> const&,                                      \
+        PartitionedArray<policy::InputElementT<Policies, 2>, 2> const&)                                      \
+        -> std::tuple<                                                                                       \
+            PartitionedArray<policy::OutputElementT<Policies, 0>, 2>,                                        \
+            PartitionedArray<policy::OutputElementT<Policies, 1>, 2>>;                                       \
+                                                                                                             \
+    template LUE_ROUTING_OPERATION_EXPORT auto accu_capacity<ArgumentType<void(Policies)>>(                  \
+        ArgumentType<void(Policies)> const&,                                                                 \
+        FlowNetwork<policy::InputElementT<Policies, 0>, policy::InputElementT<Policies, 1>> const&,          \
+        PartitionedArray<policy::InputElementT<Policies, 1>, 2> const&,                                      \
+        Scalar<policy::InputElementT<Policies, 2>> const&)                                                   \
+        -> std::tuple<                                                                                       \
+            PartitionedArray<policy::OutputElementT<Policies, 0>, 2>,                                        \
+            PartitionedArray<policy::OutputElementT<Policies, 1>, 2>>;                                       \
+                                                                                                             \
+    template LUE_ROUTING_OPERATION_EXPORT auto accu_capacity<ArgumentType<void(Policies)>>(                  \
+        ArgumentType<void(Policies)> const&,                                                                 \
+        FlowNetwork<policy::InputElementT<Policies, 0>, policy::InputElementT<Policies, 1>> const&,          \
+        Scalar<policy::InputElementT<Policies, 1>> const&,                                                   \
+        Scalar<policy::InputElementT<Policies, 2>> const&)                                                   \
+        -> std::tuple<                                                                                       \
+            PartitionedArray<policy::OutputElementT<Policies, 0>, 2>,                                        \
+            PartitionedArray<policy::OutputElementT<Policies, 1>, 2>>;                                       \
+                                                                                                             \
+    template LUE_ROUTING_OPERATION_EXPORT auto accu_capacity<ArgumentType<void(Policies)>>(                  \
+        ArgumentType<void(Policies)> const&,                                                                 \
+        FlowNetwork<policy::InputElementT<Policies, 0>, policy::InputElementT<Policies, 1>> const&,          \
+        Scalar<policy::InputElementT<Policies, 1>> const&,                                                   \
+        PartitionedArray<policy::InputElementT<Policies, 2>, 2> const&)                                      \
         -> std::tuple<                                                                                       \
             PartitionedArray<policy::OutputElementT<Policies, 0>, 2>,                                        \
             PartitionedArray<policy::OutputElementT<Policies, 1>, 2>>;
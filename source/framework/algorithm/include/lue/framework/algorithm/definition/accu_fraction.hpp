@@ -4,6 +4,10 @@
 #include "lue/framework/algorithm/detail/verify_compatible.hpp"
 #include "lue/framework/algorithm/routing_operation_export.hpp"
 #include "lue/macro.hpp"
+#include <array>
+#include <span>
+#include <tuple>
+#include <utility>
 
 
 namespace lue {
@@ -284,6 +288,320 @@ namespace lue {
     };
 
 
+    /*!
+        @brief      Functor for accumulating @a nr_layers_ layers of material at once, given a
+                    single fraction per cell
+
+        Per cell, the material of all layers is accumulated and split in one go, and sent to
+        neighbouring partitions in a single message.
+    */
+    template<typename Policies, std::size_t nr_layers_>
+    class AccuFractionLayers:
+        public AccumulatingRouterFunctor<
+            policy::detail::ConcatenatedTypeList<
+                policy::detail::RepeatedTypeList<policy::InputElementT<Policies, 1>, nr_layers_>,
+                policy::detail::TypeList<policy::InputElementT<Policies, 2>>>,
+            policy::detail::ConcatenatedTypeList<
+                policy::detail::RepeatedTypeList<policy::OutputElementT<Policies, 0>, nr_layers_>,
+                policy::detail::RepeatedTypeList<policy::OutputElementT<Policies, 1>, nr_layers_>>>
+    {
+
+        private:
+
+            using Base = AccumulatingRouterFunctor<
+                policy::detail::ConcatenatedTypeList<
+                    policy::detail::RepeatedTypeList<policy::InputElementT<Policies, 1>, nr_layers_>,
+                    policy::detail::TypeList<policy::InputElementT<Policies, 2>>>,
+                policy::detail::ConcatenatedTypeList<
+                    policy::detail::RepeatedTypeList<policy::OutputElementT<Policies, 0>, nr_layers_>,
+                    policy::detail::RepeatedTypeList<policy::OutputElementT<Policies, 1>, nr_layers_>>>;
+
+        public:
+
+            static_assert(nr_layers_ > 0);
+
+            template<typename Material, typename Fraction>
+            class CellAccumulator
+            {
+
+                public:
+
+                    using DomainPolicy = policy::DomainPolicyT<Policies>;
+                    using InflowNoDataPolicy =
+                        policy::InputNoDataPolicy2T<policy::InputPoliciesT<Policies, 1>>;
+                    using FractionNoDataPolicy =
+                        policy::InputNoDataPolicy2T<policy::InputPoliciesT<Policies, 2>>;
+                    using OutflowNoDataPolicy =
+                        policy::OutputNoDataPolicy2T<policy::OutputPoliciesT<Policies, 0>>;
+                    using RemainderNoDataPolicy =
+                        policy::OutputNoDataPolicy2T<policy::OutputPoliciesT<Policies, 1>>;
+
+                    static_assert(std::is_same_v<ElementT<Material>, policy::InputElementT<Policies, 1>>);
+                    static_assert(std::is_same_v<ElementT<Fraction>, policy::InputElementT<Policies, 2>>);
+
+                    using MaterialElement = policy::ElementT<InflowNoDataPolicy>;
+
+                    static_assert(std::is_same_v<policy::ElementT<FractionNoDataPolicy>, MaterialElement>);
+                    static_assert(std::is_same_v<policy::ElementT<OutflowNoDataPolicy>, MaterialElement>);
+                    static_assert(std::is_same_v<policy::ElementT<RemainderNoDataPolicy>, MaterialElement>);
+
+                    using MaterialData = DataT<PartitionedArray<MaterialElement, 2>>;
+
+                    static constexpr std::size_t nr_layers{nr_layers_};
+
+
+                    CellAccumulator(
+                        Policies const& policies,
+                        std::array<Material, nr_layers> const& external_inflow,
+                        Fraction const& fraction,
+                        std::array<MaterialData*, nr_layers> const& outflow,
+                        std::array<MaterialData*, nr_layers> const& remainder):
+
+                        _dp{policies.domain_policy()},
+                        _indp_inflow{std::get<1>(policies.inputs_policies()).input_no_data_policy()},
+                        _indp_fraction{std::get<2>(policies.inputs_policies()).input_no_data_policy()},
+                        _ondp_outflow{std::get<0>(policies.outputs_policies()).output_no_data_policy()},
+                        _ondp_remainder{std::get<1>(policies.outputs_policies()).output_no_data_policy()},
+
+                        _external_inflow{external_inflow},
+                        _fraction{fraction},
+                        _outflow{outflow},
+                        _remainder{remainder}
+
+                    {
+                    }
+
+
+                    void enter_intra_partition_stream(
+                        [[maybe_unused]] Index const idx0, [[maybe_unused]] Index const idx1)
+                    {
+                    }
+
+
+                    void leave_intra_partition_stream(
+                        [[maybe_unused]] Index const idx0, [[maybe_unused]] Index const idx1)
+                    {
+                    }
+
+
+                    void enter_inter_partition_stream(
+                        std::span<MaterialElement const, nr_layers> const outflow,
+                        Index const idx0,
+                        Index const idx1)
+                    {
+                        // The results for the upstream cell are ready
+                        for (std::size_t layer = 0; layer < nr_layers; ++layer)
+                        {
+                            add_outflow(
+                                outflow[layer],
+                                (*_outflow[layer])(idx0, idx1),
+                                (*_remainder[layer])(idx0, idx1));
+                        }
+                    }
+
+
+                    void leave_inter_partition_stream(
+                        [[maybe_unused]] Index const idx0, [[maybe_unused]] Index const idx1)
+                    {
+                    }
+
+
+                    void enter_cell(Index const idx0, Index const idx1)
+                    {
+                        MaterialElement const& fraction{detail::to_value(_fraction, idx0, idx1)};
+
+                        for (std::size_t layer = 0; layer < nr_layers; ++layer)
+                        {
+                            MaterialElement const& external_inflow{
+                                detail::to_value(_external_inflow[layer], idx0, idx1)};
+
+                            MaterialElement& outflow{(*_outflow[layer])(idx0, idx1)};
+                            MaterialElement& remainder{(*_remainder[layer])(idx0, idx1)};
+
+                            if (!_ondp_outflow.is_no_data(outflow))
+                            {
+                                if (_indp_inflow.is_no_data(external_inflow) ||
+                                    _indp_fraction.is_no_data(fraction) ||
+                                    !_dp.within_domain(external_inflow, fraction))
+                                {
+                                    _ondp_outflow.mark_no_data(outflow);
+                                    _ondp_remainder.mark_no_data(remainder);
+                                }
+                                else
+                                {
+                                    // Split the total amount of inflow that enters this cell into
+                                    // outflow and remainder, based on the fraction passed in
+                                    outflow += external_inflow;
+
+                                    MaterialElement delta_flux{fraction * outflow};
+                                    remainder = outflow - delta_flux;
+                                    outflow = delta_flux;
+                                }
+                            }
+                        }
+                    }
+
+
+                    void leave_cell(
+                        Index const idx0_from,
+                        Index const idx1_from,
+                        Index const idx0_to,
+                        Index const idx1_to)
+                    {
+                        // The results for the upstream cell are ready. Use
+                        // its outflow as inflow for the downstream cell.
+                        for (std::size_t layer = 0; layer < nr_layers; ++layer)
+                        {
+                            MaterialData& outflow{*_outflow[layer]};
+
+                            add_outflow(
+                                outflow(idx0_from, idx1_from),
+                                outflow(idx0_to, idx1_to),
+                                (*_remainder[layer])(idx0_to, idx1_to));
+                        }
+                    }
+
+
+                    void stop_at_sink_cell(
+                        [[maybe_unused]] Index const idx0, [[maybe_unused]] Index const idx1)
+                    {
+                    }
+
+
+                    void stop_at_confluence_cell(
+                        [[maybe_unused]] Index const idx0, [[maybe_unused]] Index const idx1)
+                    {
+                    }
+
+
+                    void stop_at_partition_output_cell(
+                        [[maybe_unused]] Index const idx0, [[maybe_unused]] Index const idx1)
+                    {
+                    }
+
+
+                    auto outflow(Index const idx0, Index const idx1) const
+                        -> std::array<MaterialElement, nr_layers>
+                    {
+                        std::array<MaterialElement, nr_layers> result{};
+
+                        for (std::size_t layer = 0; layer < nr_layers; ++layer)
+                        {
+                            result[layer] = (*_outflow[layer])(idx0, idx1);
+                        }
+
+                        return result;
+                    }
+
+
+                    void mark_no_data(Index const idx0, Index const idx1)
+                    {
+                        for (std::size_t layer = 0; layer < nr_layers; ++layer)
+                        {
+                            _ondp_outflow.mark_no_data(*_outflow[layer], idx0, idx1);
+                            _ondp_remainder.mark_no_data(*_remainder[layer], idx0, idx1);
+                        }
+                    }
+
+
+                private:
+
+                    void add_outflow(
+                        MaterialElement const& outflow, MaterialElement& inflow, MaterialElement& remainder)
+                    {
+                        if (!_ondp_outflow.is_no_data(inflow))
+                        {
+                            lue_hpx_assert(!_ondp_remainder.is_no_data(remainder));
+
+                            if (_ondp_outflow.is_no_data(outflow))
+                            {
+                                _ondp_outflow.mark_no_data(inflow);
+                                _ondp_remainder.mark_no_data(remainder);
+                            }
+                            else
+                            {
+                                // Just add the outflow from upstream to
+                                // the inflow of the downstream cell
+                                inflow += outflow;
+                            }
+                        }
+                    }
+
+
+                    DomainPolicy _dp;
+
+                    InflowNoDataPolicy _indp_inflow;
+
+                    FractionNoDataPolicy _indp_fraction;
+
+                    OutflowNoDataPolicy _ondp_outflow;
+
+                    RemainderNoDataPolicy _ondp_remainder;
+
+                    std::array<Material, nr_layers> const _external_inflow;  // External inflow
+
+                    Fraction const _fraction;
+
+                    std::array<MaterialData*, nr_layers> const _outflow;  // Upstream inflow, outflow
+
+                    std::array<MaterialData*, nr_layers> const _remainder;
+            };
+
+
+            static constexpr char const* name{"accu_fraction_layers"};
+
+            using Material = policy::InputElementT<Policies, 1>;
+
+            using MaterialPartitions = typename PartitionedArray<Material, 2>::Partitions;
+            using MaterialPartition = ArrayPartition<Material, 2>;
+            using MaterialData = DataT<MaterialPartition>;
+
+            using IntraPartitionStreamCellsResult = decltype(std::tuple_cat(
+                std::declval<std::array<hpx::future<MaterialData>, 2 * nr_layers_>>(),
+                std::declval<std::tuple<
+                    hpx::future<typename Base::InflowCountData>,
+                    hpx::future<std::array<typename Base::CellsIdxs, detail::nr_neighbours<2>()>>>>()));
+
+            using InterPartitionStreamCellsResult = decltype(std::tuple_cat(
+                std::declval<std::array<hpx::future<MaterialData>, 2 * nr_layers_>>()));
+
+
+            /*!
+                @brief      Return a cell accumulator, given the layers of external inflow and the
+                            fraction in @a arguments, and the outflow and remainder per layer in
+                            @a results
+            */
+            template<typename... Argument>
+            auto cell_accumulator(
+                Policies const& policies,
+                Argument const&... arguments,
+                std::same_as<MaterialData> auto&... results) const
+                -> CellAccumulator<
+                    std::tuple_element_t<0, std::tuple<Argument...>>,
+                    std::tuple_element_t<nr_layers_, std::tuple<Argument...>>>
+            {
+                static_assert(sizeof...(Argument) == nr_layers_ + 1);
+                static_assert(sizeof...(results) == 2 * nr_layers_);
+
+                using Material_ = std::tuple_element_t<0, std::tuple<Argument...>>;
+                using Fraction = std::tuple_element_t<nr_layers_, std::tuple<Argument...>>;
+
+                auto const arguments_{std::forward_as_tuple(arguments...)};
+                std::array<MaterialData*, 2 * nr_layers_> const results_{&results...};
+
+                return [&]<std::size_t... layer>(std::index_sequence<layer...>)
+                {
+                    return CellAccumulator<Material_, Fraction>{
+                        policies,
+                        {std::get<layer>(arguments_)...},
+                        std::get<nr_layers_>(arguments_),
+                        {results_[layer]...},
+                        {results_[nr_layers_ + layer]...}};
+                }(std::make_index_sequence<nr_layers_>{});
+            }
+    };
+
+
     template<typename Policies>
     auto accu_fraction(
         Policies const& policies,
@@ -345,6 +663,160 @@ namespace lue {
         return accumulating_router(policies, AccuFraction<Policies>{}, flow_direction, inflow, fraction);
     }
 
+
+    template<typename Policies>
+    auto accu_fraction(
+        Policies const& policies,
+        FlowNetwork<policy::InputElementT<Policies, 0>, policy::InputElementT<Policies, 1>> const&
+            flow_network,
+        PartitionedArray<policy::InputElementT<Policies, 1>, 2> const& inflow,
+        PartitionedArray<policy::InputElementT<Policies, 2>, 2> const& fraction)
+        -> std::tuple<
+            PartitionedArray<policy::OutputElementT<Policies, 0>, 2>,
+            PartitionedArray<policy::OutputElementT<Policies, 1>, 2>>
+    {
+        detail::verify_compatible(flow_network.flow_direction(), inflow, fraction);
+
+        return accumulating_router(policies, AccuFraction<Policies>{}, flow_network, inflow, fraction);
+    }
+
+
+    template<typename Policies>
+    auto accu_fraction(
+        Policies const& policies,
+        FlowNetwork<policy::InputElementT<Policies, 0>, policy::InputElementT<Policies, 1>> const&
+            flow_network,
+        PartitionedArray<policy::InputElementT<Policies, 1>, 2> const& inflow,
+        Scalar<policy::InputElementT<Policies, 2>> const& fraction)
+        -> std::tuple<
+            PartitionedArray<policy::OutputElementT<Policies, 0>, 2>,
+            PartitionedArray<policy::OutputElementT<Policies, 1>, 2>>
+    {
+        detail::verify_compatible(flow_network.flow_direction(), inflow);
+
+        return accumulating_router(policies, AccuFraction<Policies>{}, flow_network, inflow, fraction);
+    }
+
+
+    template<typename Policies>
+    auto accu_fraction(
+        Policies const& policies,
+        FlowNetwork<policy::InputElementT<Policies, 0>, policy::InputElementT<Policies, 1>> const&
+            flow_network,
+        Scalar<policy::InputElementT<Policies, 1>> const& inflow,
+        Scalar<policy::InputElementT<Policies, 2>> const& fraction)
+        -> std::tuple<
+            PartitionedArray<policy::OutputElementT<Policies, 0>, 2>,
+            PartitionedArray<policy::OutputElementT<Policies, 1>, 2>>
+    {
+        return accumulating_router(policies, AccuFraction<Policies>{}, flow_network, inflow, fraction);
+    }
+
+
+    template<typename Policies>
+    auto accu_fraction(
+        Policies const& policies,
+        FlowNetwork<policy::InputElementT<Policies, 0>, policy::InputElementT<Policies, 1>> const&
+            flow_network,
+        Scalar<policy::InputElementT<Policies, 1>> const& inflow,
+        PartitionedArray<policy::InputElementT<Policies, 2>, 2> const& fraction)
+        -> std::tuple<
+            PartitionedArray<policy::OutputElementT<Policies, 0>, 2>,
+            PartitionedArray<policy::OutputElementT<Policies, 1>, 2>>
+    {
+        detail::verify_compatible(flow_network.flow_direction(), fraction);
+
+        return accumulating_router(policies, AccuFraction<Policies>{}, flow_network, inflow, fraction);
+    }
+
+
+    namespace detail {
+
+        /*!
+            @brief      Split the results of routing @a nr_layers layers of material by
+                        AccuFractionLayers into the outflow and remainder per layer
+        */
+        template<typename Policies, std::size_t nr_layers, typename Results>
+        auto split_accu_fraction_layers(Results&& results) -> std::tuple<
+            std::array<PartitionedArray<policy::OutputElementT<Policies, 0>, 2>, nr_layers>,
+            std::array<PartitionedArray<policy::OutputElementT<Policies, 1>, 2>, nr_layers>>
+        {
+            using Outflow = std::array<PartitionedArray<policy::OutputElementT<Policies, 0>, 2>, nr_layers>;
+            using Remainder = std::array<PartitionedArray<policy::OutputElementT<Policies, 1>, 2>, nr_layers>;
+
+            return [&results]<std::size_t... layer>(std::index_sequence<layer...>)
+            {
+                return std::make_tuple(
+                    Outflow{std::move(std::get<layer>(results))...},
+                    Remainder{std::move(std::get<nr_layers + layer>(results))...});
+            }(std::make_index_sequence<nr_layers>{});
+        }
+
+    }  // namespace detail
+
+
+    template<typename Policies, std::size_t nr_layers>
+    auto accu_fraction(
+        Policies const& policies,
+        PartitionedArray<policy::InputElementT<Policies, 0>, 2> const& flow_direction,
+        std::array<PartitionedArray<policy::InputElementT<Policies, 1>, 2>, nr_layers> const& inflow,
+        PartitionedArray<policy::InputElementT<Policies, 2>, 2> const& fraction)
+        -> std::tuple<
+            std::array<PartitionedArray<policy::OutputElementT<Policies, 0>, 2>, nr_layers>,
+            std::array<PartitionedArray<policy::OutputElementT<Policies, 1>, 2>, nr_layers>>
+    {
+        for (auto const& layer : inflow)
+        {
+            detail::verify_compatible(flow_direction, layer);
+        }
+
+        detail::verify_compatible(flow_direction, fraction);
+
+        return std::apply(
+            [&](auto const&... layers)
+            {
+                return detail::split_accu_fraction_layers<Policies, nr_layers>(accumulating_router(
+                    policies,
+                    AccuFractionLayers<Policies, nr_layers>{},
+                    flow_direction,
+                    layers...,
+                    fraction));
+            },
+            inflow);
+    }
+
+
+    template<typename Policies, std::size_t nr_layers>
+    auto accu_fraction(
+        Policies const& policies,
+        FlowNetwork<policy::InputElementT<Policies, 0>, policy::InputElementT<Policies, 1>> const&
+            flow_network,
+        std::array<PartitionedArray<policy::InputElementT<Policies, 1>, 2>, nr_layers> const& inflow,
+        PartitionedArray<policy::InputElementT<Policies, 2>, 2> const& fraction)
+        -> std::tuple<
+            std::array<PartitionedArray<policy::OutputElementT<Policies, 0>, 2>, nr_layers>,
+            std::array<PartitionedArray<policy::OutputElementT<Policies, 1>, 2>, nr_layers>>
+    {
+        for (auto const& layer : inflow)
+        {
+            detail::verify_compatible(flow_network.flow_direction(), layer);
+        }
+
+        detail::verify_compatible(flow_network.flow_direction(), fraction);
+
+        return std::apply(
+            [&](auto const&... layers)
+            {
+                return detail::split_accu_fraction_layers<Policies, nr_layers>(accumulating_router(
+                    policies,
+                    AccuFractionLayers<Policies, nr_layers>{},
+                    flow_network,
+                    layers...,
+                    fraction));
+            },
+            inflow);
+    }
+
 }  // namespace lue
 
 
@@ -382,6 +854,63 @@ namespace lue {
         PartitionedArray<policy::InputElementT<Policies, 0>, 2> const&,                                      \
         Scalar<policy::InputElementT<Policies, 1>> const&,                                                   \
         PartitionedArray<policy::InputElementT<Policies, 2>, 2> const&)                                      \
+        -> std::tuple<                                                                                       \
+            PartitionedArray<policy::OutputElementT<Policies, 0>, 2>,                                        \
+            PartitionedArray<policy::OutputElementT<Policies, 1>, 2>>;                                       \
+                                                                                                             \
+    template LUE_ROUTING_OPERATION_EXPORT auto accu_fraction<ArgumentType<void(Policies)>>(                  \
+        ArgumentType<void(Policies)> const&,                                                                 \
+        FlowNetwork<policy::InputElementT<Policies, 0>, policy::InputElementT<Policies, 1>> const&,          \
+        PartitionedArray<policy::InputElementT<Policies, 1>, 2> const&,                                      \
+        PartitionedArray<policy::InputElementT<Policies, 2>, 2> const&)                                      \
+        -> std::tuple<                                                                                       \
+            PartitionedArray<policy::OutputElementT<Policies, 0>, 2>,                                        \
+            PartitionedArray<policy::OutputElementT<Policies, 1>, 2>>;                                       \
+                                                                                                             \
+    template LUE_ROUTING_OPERATION_EXPORT auto accu_fraction<ArgumentType<void(Policies)>>(                  \
+        ArgumentType<void(Policies)> const&,                                                                 \
+        FlowNetwork<policy::InputElementT<Policies, 0>, policy::InputElementT<Policies, 1>> const&,          \
+        PartitionedArray<policy::InputElementT<Policies, 1>, 2> const&,                                      \
+        Scalar<policy::InputElementT<Policies, 2>> const&)                                                   \
+        -> std::tuple<                                                                                       \
+            PartitionedArray<policy::OutputElementT<Policies, 0>, 2>,                                        \
+            PartitionedArray<policy::OutputElementT<Policies, 1>, 2>>;                                       \
+                                                                                                             \
+    template LUE_ROUTING_OPERATION_EXPORT auto accu_fraction<ArgumentType<void(Policies)>>(                  \
+        ArgumentType<void(Policies)> const&,                                                                 \
+        FlowNetwork<policy::InputElementT<Policies, 0>, policy::InputElementT<Policies, 1>> const&,          \
+        Scalar<policy::InputElementT<Policies, 1>> const&,                                                   \
+        Scalar<policy::InputElementT<Policies, 2>> const&)                                                   \
+        -> std::tuple<                                                                                       \
+            PartitionedArray<policy::OutputElementT<Policies, 0>, 2>,                                        \
+            PartitionedArray<policy::OutputElementT<Policies, 1>, 2>>;                                       \
+                                                                                                             \
+    template LUE_ROUTING_OPERATION_EXPORT auto accu_fraction<ArgumentType<void(Policies)>>(                  \
+        ArgumentType<void(Policies)> const&,                                                                 \
+        FlowNetwork<policy::InputElementT<Policies, 0>, policy::InputElementT<Policies, 1>> const&,          \
+        Scalar<policy::InputElementT<Policies, 1>> const&,                                                   \
+        PartitionedArray<policy::InputElementT<Policies, 2>, 2> const&)                                      \
         -> std::tuple<                                                                                       \
             PartitionedArray<policy::OutputElementT<Policies, 0>, 2>,                                        \
             PartitionedArray<policy::OutputElementT<Policies, 1>, 2>>;
+
+
+#define LUE_INSTANTIATE_ACCU_FRACTION_LAYERS(Policies, nr_layers)                                            \
+                                                                                                             \
+    template LUE_ROUTING_OPERATION_EXPORT auto accu_fraction<ArgumentType<void(Policies)>, nr_layers>(       \
+        ArgumentType<void(Policies)> const&,                                                                 \
+        PartitionedArray<policy::InputElementT<Policies, 0>, 2> const&,                                      \
+        std::array<PartitionedArray<policy::InputElementT<Policies, 1>, 2>, nr_layers> const&,               \
+        PartitionedArray<policy::InputElementT<Policies, 2>, 2> const&)                                      \
+        -> std::tuple<                                                                                       \
+            std::array<PartitionedArray<policy::OutputElementT<Policies, 0>, 2>, nr_layers>,                 \
+            std::array<PartitionedArray<policy::OutputElementT<Policies, 1>, 2>, nr_layers>>;                \
+                                                                                                             \
+    template LUE_ROUTING_OPERATION_EXPORT auto accu_fraction<ArgumentType<void(Policies)>, nr_layers>(       \
+        ArgumentType<void(Policies)> const&,                                                                 \
+        FlowNetwork<policy::InputElementT<Policies, 0>, policy::InputElementT<Policies, 1>> const&,          \
+        std::array<PartitionedArray<policy::InputElementT<Policies, 1>, 2>, nr_layers> const&,               \
+        PartitionedArray<policy::InputElementT<Policies, 2>, 2> const&)                                      \
+        -> std::tuple<                                                                                       \
+            std::array<PartitionedArray<policy::OutputElementT<Policies, 0>, 2>, nr_layers>,                 \
+            std::array<PartitionedArray<policy::OutputElementT<Policies, 1>, 2>, nr_layers>>;
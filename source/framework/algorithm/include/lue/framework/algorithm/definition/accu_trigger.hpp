@@ -348,6 +348,72 @@ namespace lue {
         return accumulating_router(policies, AccuTrigger<Policies>{}, flow_direction, inflow, trigger);
     }
 
+
+    template<typename Policies>
+    auto accu_trigger(
+        Policies const& policies,
+        FlowNetwork<policy::InputElementT<Policies, 0>, policy::InputElementT<Policies, 1>> const&
+            flow_network,
+        PartitionedArray<policy::InputElementT<Policies, 1>, 2> const& inflow,
+        PartitionedArray<policy::InputElementT<Policies, 2>, 2> const& trigger)
+        -> std::tuple<
+            PartitionedArray<policy::OutputElementT<Policies, 0>, 2>,
+            PartitionedArray<policy::OutputElementT<Policies, 1>, 2>>
+    {
+        detail::verify_compatible(flow_network.flow_direction(), inflow, trigger);
+
+        return accumulating_router(policies, AccuTrigger<Policies>{}, flow_network, inflow, trigger);
+    }
+
+
+    template<typename Policies>
+    auto accu_trigger(
+        Policies const& policies,
+        FlowNetwork<policy::InputElementT<Policies, 0>, policy::InputElementT<Policies, 1>> const&
+            flow_network,
+        PartitionedArray<policy::InputElementT<Policies, 1>, 2> const& inflow,
+        Scalar<policy::InputElementT<Policies, 2>> const& trigger)
+        -> std::tuple<
+            PartitionedArray<policy::OutputElementT<Policies, 0>, 2>,
+            PartitionedArray<policy::OutputElementT<Policies, 1>, 2>>
+    {
+        detail::verify_compatible(flow_network.flow_direction(), inflow);
+
+        return accumulating_router(policies, AccuTrigger<Policies>{}, flow_network, inflow, trigger);
+    }
+
+
+    template<typename Policies>
+    auto accu_trigger(
+        Policies const& policies,
+        FlowNetwork<policy::InputElementT<Policies, 0>, policy::InputElementT<Policies, 1>> const&
+            flow_network,
+        Scalar<policy::InputElementT<Policies, 1>> const& inflow,
+        Scalar<policy::InputElementT<Policies, 2>> const& trigger)
+        -> std::tuple<
+            PartitionedArray<policy::OutputElementT<Policies, 0>, 2>,
+            PartitionedArray<policy::OutputElementT<Policies, 1>, 2>>
+    {
+        return accumulating_router(policies, AccuTrigger<Policies>{}, flow_network, inflow, trigger);
+    }
+
+
+    template<typename Policies>
+    auto accu_trigger(
+        Policies const& policies,
+        FlowNetwork<policy::InputElementT<Policies, 0>, policy::InputElementT<Policies, 1>> const&
+            flow_network,
+        Scalar<policy::InputElementT<Policies, 1>> const& inflow,
+        PartitionedArray<policy::InputElementT<Policies, 2>, 2> const& trigger)
+        -> std::tuple<
+            PartitionedArray<policy::OutputElementT<Policies, 0>, 2>,
+            PartitionedArray<policy::OutputElementT<Policies, 1>, 2>>
+    {
+        detail::verify_compatible(flow_network.flow_direction(), trigger);
+
+        return accumulating_router(policies, AccuTrigger<Policies>{}, flow_network, inflow, trigger);
+    }
+
 }  // namespace lue
 
 
@@ -385,6 +451,42 @@ namespace lue {
         PartitionedArray<policy::InputElementT<Policies, 0>, 2> const&,                                      \
         Scalar<policy::InputElementT<Policies, 1>> const&,                                                   \
         PartitionedArray<policy::InputElementT<Policies, 2>, 2> const&)                                      \
+        -> std::tuple<                                                                                       \
+            PartitionedArray<policy::OutputElementT<Policies, 0>, 2>,                                        \
+            PartitionedArray<policy::OutputElementT<Policies, 1>, 2>>;                                       \
+                                                                                                             \
+    template LUE_ROUTING_OPERATION_EXPORT auto accu_trigger<ArgumentType<void(Policies)>>(                   \
+        ArgumentType<void(Policies)> const&,                                                                 \
+        FlowNetwork<policy::InputElementT<Policies, 0>, policy::InputElementT<Policies, 1>> const&,          \
+        PartitionedArray<policy::InputElementT<Policies, 1>, 2> const&,                                      \
+        PartitionedArray<policy::InputElementT<Policies, 2>, 2> const&)                                      \
+        -> std::tuple<                                                                                       \
+            PartitionedArray<policy::OutputElementT<Policies, 0>, 2>,                                        \
+            PartitionedArray<policy::OutputElementT<Policies, 1>, 2>>;                                       \
+                                                                                                             \
+    template LUE_ROUTING_OPERATION_EXPORT auto accu_trigger<ArgumentType<void(Policies)>>(                   \
+        ArgumentType<void(Policies)> const&,                                                                 \
+        FlowNetwork<policy::InputElementT<Policies, 0>, policy::InputElementT<Policies, 1>> const&,          \
+        PartitionedArray<policy::InputElementT<Policies, 1>, 2> const&,                                      \
+        Scalar<policy::InputElementT<Policies, 2>> const&)                                                   \
+        -> std::tuple<                                                                                       \
+            PartitionedArray<policy::OutputElementT<Policies, 0>, 2>,                                        \
+            PartitionedArray<policy::OutputElementT<Policies, 1>, 2>>;                                       \
+                                                                                                             \
+    template LUE_ROUTING_OPERATION_EXPORT auto accu_trigger<ArgumentType<void(Policies)>>(                   \
+        ArgumentType<void(Policies)> const&,                                                                 \
+        FlowNetwork<policy::InputElementT<Policies, 0>, policy::InputElementT<Policies, 1>> const&,          \
+        Scalar<policy::InputElementT<Policies, 1>> const&,                                                   \
+        Scalar<policy::InputElementT<Policies, 2>> const&)                                                   \
+        -> std::tuple<                                                                                       \
+            PartitionedArray<policy::OutputElementT<Policies, 0>, 2>,                                        \
+            PartitionedArray<policy::OutputElementT<Policies, 1>, 2>>;                                       \
+                                                                                                             \
+    template LUE_ROUTING_OPERATION_EXPORT auto accu_trigger<ArgumentType<void(Policies)>>(                   \
+        ArgumentType<void(Policies)> const&,                                                                 \
+        FlowNetwork<policy::InputElementT<Policies, 0>, policy::InputElementT<Policies, 1>> const&,          \
+        Scalar<policy::InputElementT<Policies, 1>> const&,                                                   \
+        PartitionedArray<policy::InputElementT<Policies, 2>, 2> const&)                                      \
         -> std::tuple<                                                                                       \
             PartitionedArray<policy::OutputElementT<Policies, 0>, 2>,                                        \
             PartitionedArray<policy::OutputElementT<Policies, 1>, 2>>;
@@ -3,6 +3,8 @@
 #include "lue/framework/algorithm/detail/communicator.hpp"
 #include "lue/framework/algorithm/detail/communicator_array.hpp"
 #include "lue/framework/algorithm/detail/idx_converter.hpp"
+#include "lue/framework/algorithm/detail/material_communicator.hpp"
+#include "lue/framework/algorithm/flow_network.hpp"
 #include "lue/framework/algorithm/functor_traits.hpp"
 #include "lue/framework/algorithm/policy/detail/type_list.hpp"
 #include "lue/framework/algorithm/policy/policy_traits.hpp"
@@ -11,7 +13,11 @@
 #include "lue/framework/core/component.hpp"
 #include "lue/framework/core/type_traits.hpp"
 #include "lue/framework.hpp"
+#include <hpx/algorithm.hpp>
+#include <hpx/execution.hpp>
+#include <algorithm>
 #include <concepts>
+#include <span>
 
 
 // Policies determine how to check argument and return element types. Therefore:
@@ -294,91 +300,20 @@ namespace lue {
         }
 
 
-        template<
-            typename MaterialElement,
-            Rank rank>  // Remove parameter
-        class ChannelMaterial
-        {
-
-            public:
-
-                ChannelMaterial() = default;
-
-
-                ChannelMaterial(Index const& idx, MaterialElement const& value):
-
-                    _cell_idx{idx},
-                    _value{value}
-
-                {
-                }
-
-
-                auto cell_idx() const -> Index const&
-                {
-                    return _cell_idx;
-                }
-
-
-                auto value() const -> MaterialElement const&
-                {
-                    return _value;
-                }
-
-
-            private:
-
-                friend class hpx::serialization::access;
-
-
-                template<typename Archive>
-                void serialize(Archive& archive, [[maybe_unused]] unsigned int const version)
-                {
-                    archive & _cell_idx & _value;
-                }
-
-
-                Index _cell_idx;
-
-                MaterialElement _value;
-        };
-
-
-        template<typename MaterialElement, Rank rank>
-        class MaterialCommunicator: public Communicator<ChannelMaterial<MaterialElement, rank>, rank>
-        {
-
-            public:
-
-                using Base = Communicator<ChannelMaterial<MaterialElement, rank>, rank>;
-
-
-                MaterialCommunicator() = default;
-
-
-                MaterialCommunicator(
-                    hpx::id_type const locality_id,
-                    std::string const& basename,
-                    lue::Shape<Count, rank> const& shape_in_partitions,
-                    lue::Indices<Index, rank> const& partition_idxs):
-
-                    Base{locality_id, basename, shape_in_partitions, partition_idxs}
-
-                {
-                }
-
-
-            private:
+        /*!
+            @brief      Number of layers of material routed by a cell accumulator of type
+                        @a CellAccumulator
 
-                friend class hpx::serialization::access;
+            Cell accumulators routing multiple layers of material at once define a static
+            nr_layers member. Per cell, they pass and receive a value per layer.
+        */
+        template<typename CellAccumulator>
+        constexpr std::size_t nr_material_layers{1};
 
 
-                template<typename Archive>
-                void serialize(Archive& archive, unsigned int const version)
-                {
-                    Base::serialize(archive, version);
-                }
-        };
+        template<typename CellAccumulator>
+            requires requires { CellAccumulator::nr_layers; }
+        constexpr std::size_t nr_material_layers<CellAccumulator>{CellAccumulator::nr_layers};
 
 
         template<typename CellAccumulator, typename Communicator>
@@ -389,6 +324,8 @@ namespace lue {
 
                 using MaterialElement = typename CellAccumulator::MaterialElement;
 
+                static constexpr std::size_t nr_layers{nr_material_layers<CellAccumulator>};
+
 
                 Accumulator(
                     CellAccumulator&& cell_accumulator,
@@ -397,9 +334,31 @@ namespace lue {
 
                     _cell_accumulator{std::forward<CellAccumulator>(cell_accumulator)},
                     _communicator{communicator},
-                    _output_cells_idxs{output_cells_idxs}
+                    _output_cells_idxs{output_cells_idxs},
+                    _output_cell_positions{},
+                    _batches{}
 
                 {
+                    // Per direction, index the output cells by their index along the side of the
+                    // partition. Each output cell drains into a single direction, so these indices are
+                    // unique.
+                    for (accu::Direction const direction : accu::directions)
+                    {
+                        auto const& cells_idxs{_output_cells_idxs[direction]};
+                        auto& positions{_output_cell_positions[direction]};
+
+                        for (std::size_t position = 0; position < cells_idxs.size(); ++position)
+                        {
+                            auto const idx{side_idx(direction, cells_idxs[position])};
+
+                            if (idx >= positions.size())
+                            {
+                                positions.resize(idx + 1);
+                            }
+
+                            positions[idx] = position;
+                        }
+                    }
                 }
 
 
@@ -418,11 +377,20 @@ namespace lue {
 
 
                 void enter_inter_partition_stream(
-                    MaterialElement const& value, Index const idx0_to, Index const idx1_to)
+                    std::span<MaterialElement const, nr_layers> const values,
+                    Index const idx0_to,
+                    Index const idx1_to)
                 {
                     // What to do when we enter an inter-partition stream. The current cell is a partition
                     // input cell.
-                    _cell_accumulator.enter_inter_partition_stream(value, idx0_to, idx1_to);
+                    if constexpr (nr_layers == 1)
+                    {
+                        _cell_accumulator.enter_inter_partition_stream(values[0], idx0_to, idx1_to);
+                    }
+                    else
+                    {
+                        _cell_accumulator.enter_inter_partition_stream(values, idx0_to, idx1_to);
+                    }
                 }
 
 
@@ -441,6 +409,29 @@ namespace lue {
                 }
 
 
+                /*!
+                    @brief      Enter the cells in @a cells_idxs, which don't depend on each other
+
+                    Cell accumulators which can handle such cells more efficiently at once than one
+                    at a time define an enter_cells member function. Otherwise, the cells are entered
+                    one at a time.
+                */
+                void enter_cells(std::span<std::array<Index, 2> const> const cells_idxs)
+                {
+                    if constexpr (requires { _cell_accumulator.enter_cells(cells_idxs); })
+                    {
+                        _cell_accumulator.enter_cells(cells_idxs);
+                    }
+                    else
+                    {
+                        for (auto const& [idx0, idx1] : cells_idxs)
+                        {
+                            _cell_accumulator.enter_cell(idx0, idx1);
+                        }
+                    }
+                }
+
+
                 void leave_cell(
                     Index const idx0_from, Index const idx1_from, Index const idx0_to, Index const idx1_to)
                 {
@@ -476,36 +467,43 @@ namespace lue {
                     _cell_accumulator.stop_at_partition_output_cell(idx0, idx1);
 
                     // Remove the partition output cell from the collection. Once all output cells
-                    // are solved / handled, the sending channel can be closed. This will end
-                    // the reading for loop on the other side of the channel.
+                    // are solved / handled, all material has been sent to the neighbouring
+                    // partition. Channels are not closed. The receiving side knows how much material
+                    // to expect, and channels can be reused by subsequent routing operations.
                     auto [direction, idx] = destination_cell(extent0, extent1, idx0, idx1, offset0, offset1);
 
-                    auto& output_cells_idxs{_output_cells_idxs[direction]};
-                    auto iterator = std::find_if(
-                        output_cells_idxs.begin(),
-                        output_cells_idxs.end(),
-                        [idx0, idx1](std::array<Index, 2> const& cell_idxs2) -> auto
-                        { return idx0 == cell_idxs2[0] && idx1 == cell_idxs2[1]; });
-                    lue_hpx_assert(iterator != output_cells_idxs.end());
-                    output_cells_idxs.erase(iterator);
+                    remove_output_cell(direction, {idx0, idx1});
 
                     // Send material to cell in neighbouring partition
                     if (_communicator.has_neighbour(direction))
                     {
                         // We are not at the border of the array
-                        using Value = typename Communicator::Value;
+                        _batches[direction].push_back(idx, _cell_accumulator.outflow(idx0, idx1));
 
-                        _communicator.send(direction, Value{idx, _cell_accumulator.outflow(idx0, idx1)});
-
-                        // The sending channel can be closed
-                        if (output_cells_idxs.empty())
+                        // Don't wait for other material to send to this neighbour
+                        if (_output_cells_idxs[direction].empty())
                         {
-                            _communicator.close(direction);
+                            flush(direction);
                         }
                     }
                 }
 
 
+                /*!
+                    @brief      Send all material batched so far to the neighbouring partitions
+
+                    Call this when no more progress can be made locally, before waiting for
+                    material from neighbouring partitions.
+                */
+                void flush()
+                {
+                    for (accu::Direction const direction : accu::directions)
+                    {
+                        flush(direction);
+                    }
+                }
+
+
                 void mark_no_data(Index const idx0, Index const idx1)
                 {
                     _cell_accumulator.mark_no_data(idx0, idx1);
@@ -514,11 +512,72 @@ namespace lue {
 
             private:
 
+                static auto side_idx(accu::Direction const direction, std::array<Index, 2> const& cell_idxs)
+                    -> std::size_t
+                {
+                    // Output cells draining north or south are positioned along a row, those draining
+                    // west or east along a column. Only a single cell drains into each corner.
+                    switch (direction)
+                    {
+                        case accu::Direction::north:
+                        case accu::Direction::south:
+                        {
+                            return static_cast<std::size_t>(cell_idxs[1]);
+                        }
+                        case accu::Direction::west:
+                        case accu::Direction::east:
+                        {
+                            return static_cast<std::size_t>(cell_idxs[0]);
+                        }
+                        default:
+                        {
+                            return 0;
+                        }
+                    }
+                }
+
+
+                void remove_output_cell(
+                    accu::Direction const direction, std::array<Index, 2> const& cell_idxs)
+                {
+                    auto& cells_idxs{_output_cells_idxs[direction]};
+                    auto& positions{_output_cell_positions[direction]};
+
+                    lue_hpx_assert(side_idx(direction, cell_idxs) < positions.size());
+                    std::size_t const position{positions[side_idx(direction, cell_idxs)]};
+                    lue_hpx_assert(position < cells_idxs.size());
+                    lue_hpx_assert(cells_idxs[position] == cell_idxs);
+
+                    // Move the last output cell into the position of the one removed
+                    cells_idxs[position] = cells_idxs.back();
+                    positions[side_idx(direction, cells_idxs[position])] = position;
+                    cells_idxs.pop_back();
+                }
+
+
+                void flush(accu::Direction const direction)
+                {
+                    auto& batch{_batches[direction]};
+
+                    if (!batch.empty())
+                    {
+                        _communicator.send(direction, batch);
+                        batch.clear();
+                    }
+                }
+
+
                 CellAccumulator _cell_accumulator;
 
                 Communicator& _communicator;
 
                 std::array<std::vector<std::array<Index, 2>>, 8>& _output_cells_idxs;
+
+                //! Per direction, per index along the partition side, the position of the output cell
+                std::array<std::vector<std::size_t>, 8> _output_cell_positions;
+
+                //! Per direction, material not sent yet
+                std::array<typename Communicator::Value, 8> _batches;
         };
 
 
@@ -599,6 +658,176 @@ namespace lue {
         }
 
 
+        /*!
+            @brief      Pass the material of a single cell that has been entered already to the
+                        downstream cell
+
+            Unlike accumulate(), this function does not follow the stream downstream. It is used when
+            visiting cells in a precomputed order.
+        */
+        template<typename Accumulator, typename FlowDirectionData, typename InflowCountData>
+        void leave_entered_cell(
+            Accumulator& accumulator,
+            Index const idx0,
+            Index const idx1,
+            FlowDirectionData const& flow_direction_data,
+            InflowCountData& inflow_count_data)
+        {
+            lue_hpx_assert(inflow_count_data(idx0, idx1) == 0);
+
+            auto const [nr_elements0, nr_elements1] = flow_direction_data.shape();
+            Index offset0{};
+            Index offset1{};
+
+            bool const is_within_partition{downstream_cell(
+                flow_direction_data, nr_elements0, nr_elements1, idx0, idx1, offset0, offset1)};
+
+            if (offset0 == 0 && offset1 == 0)
+            {
+                accumulator.stop_at_sink_cell(idx0, idx1);
+            }
+            else if (!is_within_partition)
+            {
+                accumulator.stop_at_partition_output_cell(
+                    nr_elements0, nr_elements1, idx0, idx1, offset0, offset1);
+            }
+            else
+            {
+                accumulator.leave_cell(idx0, idx1, idx0 + offset0, idx1 + offset1);
+
+                lue_hpx_assert(inflow_count_data(idx0 + offset0, idx1 + offset1) >= 1);
+
+                if (--inflow_count_data(idx0 + offset0, idx1 + offset1) > 0)
+                {
+                    accumulator.stop_at_confluence_cell(idx0 + offset0, idx1 + offset1);
+                }
+            }
+        }
+
+
+        /*!
+            @brief      Determine the order in which to visit the cells of a partition that don't
+                        depend on material from neighbouring partitions
+            @param      inflow_count_partition Per cell, the number of cells draining into it
+            @return     Partition containing the linear indices of the cells to visit, in order. The
+                        remaining elements are set to the number of cells in the partition. Partition
+                        containing a single row with the offsets in the order of the first cell of
+                        each level, followed by the number of cells ordered.
+
+            The order is topological: each cell comes after all cells draining into it. It is
+            determined breadth-first, starting with the ridge cells. The cells of a level only drain
+            into cells of later levels. Visiting cells in this order replaces following streams cell by
+            cell, and jumping around in memory, by a sweep through a compact array.
+        */
+        template<typename Policies, typename FlowDirectionElement>
+        auto intra_partition_stream_order(
+            Policies const& policies,
+            ArrayPartition<FlowDirectionElement, 2> const& flow_direction_partition,
+            ArrayPartition<SmallestIntegralElement, 2> const& inflow_count_partition)
+            -> hpx::tuple<ArrayPartition<IndexElement, 2>, ArrayPartition<IndexElement, 2>>
+        {
+            using FlowDirectionPartition = ArrayPartition<FlowDirectionElement, 2>;
+            using InflowCountPartition = ArrayPartition<SmallestIntegralElement, 2>;
+            using OrderPartition = ArrayPartition<IndexElement, 2>;
+            using OrderData = DataT<OrderPartition>;
+
+            auto [order_partition_f, levels_partition_f] = hpx::split_future(hpx::dataflow(
+                hpx::launch::async,
+
+                [policies](
+                    FlowDirectionPartition const& flow_direction_partition,
+                    InflowCountPartition const& inflow_count_partition)
+                    -> hpx::tuple<OrderPartition, OrderPartition>
+                {
+                    AnnotateFunction const annotation{"accumulating_router: partition: order"};
+
+                    auto const flow_direction_partition_ptr{ready_component_ptr(flow_direction_partition)};
+                    auto const& flow_direction_data{flow_direction_partition_ptr->data()};
+
+                    auto const inflow_count_partition_ptr{ready_component_ptr(inflow_count_partition)};
+                    auto inflow_count_data{deep_copy(inflow_count_partition_ptr->data())};
+
+                    auto const& indp_flow_direction =
+                        std::get<0>(policies.inputs_policies()).input_no_data_policy();
+
+                    auto const& partition_shape{flow_direction_data.shape()};
+                    auto const [nr_elements0, nr_elements1] = partition_shape;
+                    Count const nr_cells{lue::nr_elements(partition_shape)};
+
+                    OrderData order_data{partition_shape, static_cast<IndexElement>(nr_cells)};
+                    Index nr_ordered_cells{0};
+
+                    // Ridge cells
+                    for (Index idx0 = 0; idx0 < nr_elements0; ++idx0)
+                    {
+                        for (Index idx1 = 0; idx1 < nr_elements1; ++idx1)
+                        {
+                            if (!indp_flow_direction.is_no_data(flow_direction_data, idx0, idx1) &&
+                                inflow_count_data(idx0, idx1) == 0)
+                            {
+                                order_data[nr_ordered_cells++] =
+                                    static_cast<IndexElement>(idx0 * nr_elements1 + idx1);
+                            }
+                        }
+                    }
+
+                    // Cells of which all upstream cells are ordered already, one level at a time
+                    std::vector<IndexElement> level_offsets{};
+                    Index level_begin{0};
+                    Index offset0{};
+                    Index offset1{};
+
+                    while (level_begin < nr_ordered_cells)
+                    {
+                        Index const level_end{nr_ordered_cells};
+
+                        level_offsets.push_back(static_cast<IndexElement>(level_begin));
+
+                        for (Index cell_idx = level_begin; cell_idx < level_end; ++cell_idx)
+                        {
+                            Index const idx0{static_cast<Index>(order_data[cell_idx]) / nr_elements1};
+                            Index const idx1{static_cast<Index>(order_data[cell_idx]) % nr_elements1};
+
+                            bool const is_within_partition{downstream_cell(
+                                flow_direction_data,
+                                nr_elements0,
+                                nr_elements1,
+                                idx0,
+                                idx1,
+                                offset0,
+                                offset1)};
+
+                            if (is_within_partition && (offset0 != 0 || offset1 != 0) &&
+                                --inflow_count_data(idx0 + offset0, idx1 + offset1) == 0)
+                            {
+                                order_data[nr_ordered_cells++] = static_cast<IndexElement>(
+                                    (idx0 + offset0) * nr_elements1 + idx1 + offset1);
+                            }
+                        }
+
+                        level_begin = level_end;
+                    }
+
+                    level_offsets.push_back(static_cast<IndexElement>(nr_ordered_cells));
+
+                    OrderData levels_data{{1, static_cast<Count>(level_offsets.size())}};
+                    std::copy(level_offsets.begin(), level_offsets.end(), levels_data.begin());
+
+                    auto const& offset{flow_direction_partition_ptr->offset()};
+
+                    return hpx::make_tuple(
+                        OrderPartition{hpx::find_here(), offset, std::move(order_data)},
+                        OrderPartition{hpx::find_here(), offset, std::move(levels_data)});
+                },
+
+                flow_direction_partition,
+                inflow_count_partition));
+
+            return hpx::make_tuple(
+                OrderPartition{std::move(order_partition_f)}, OrderPartition{std::move(levels_partition_f)});
+        }
+
+
         template<typename MaterialElement, typename IdxConverter, typename Accumulate, Rank rank>
         void monitor_material_inputs(
             std::vector<std::array<Index, rank>>&& input_cells_idxs,
@@ -613,27 +842,54 @@ namespace lue {
             // Whenever material arrives in the channel, call the
             // accumulator to accumulate it through the partition
 
-            // The number of times material should arrive in the channel
-            // is equal to the number of input cells at the specific side
-            // of the partition.
+            // The number of times material should arrive for a cell
+            // is equal to the number of times it occurs in the input cells
+            // at the specific side of the partition. Multiple streams can
+            // join in a single input cell.
+
+            // Per index along the side of the partition, the number of streams still to arrive
+            std::vector<Count> nr_pending_inputs{};
+
+            for (auto const& cell_idxs : input_cells_idxs)
+            {
+                auto const idx{static_cast<std::size_t>(idx_to_idxs.idx(cell_idxs))};
+
+                if (idx >= nr_pending_inputs.size())
+                {
+                    nr_pending_inputs.resize(idx + 1, 0);
+                }
+
+                ++nr_pending_inputs[idx];
+            }
+
+            auto nr_pending_inputs_total{static_cast<Count>(input_cells_idxs.size())};
+            std::vector<std::array<Index, rank>> cells_idxs{};
 
             for (auto const& material : channel)
             {
-                lue_hpx_assert(!input_cells_idxs.empty());
+                lue_hpx_assert(nr_pending_inputs_total > 0);
+                lue_hpx_assert(!material.empty());
 
-                auto const cell_idxs{idx_to_idxs(material.cell_idx())};
+                cells_idxs.clear();
+                cells_idxs.reserve(material.size());
 
-                auto it = std::find_if(
-                    input_cells_idxs.begin(),
-                    input_cells_idxs.end(),
-                    [cell_idxs1 = cell_idxs](std::array<Index, rank> const& cell_idxs2) -> auto
-                    { return cell_idxs1 == cell_idxs2; });
-                lue_hpx_assert(it != input_cells_idxs.end());
-                input_cells_idxs.erase(it);
+                for (Index const idx : material.cell_idxs())
+                {
+                    auto const& cell_idxs{cells_idxs.emplace_back(idx_to_idxs(idx))};
 
-                accumulate(cell_idxs, material.value());
+                    [[maybe_unused]] auto const side_idx{
+                        static_cast<std::size_t>(idx_to_idxs.idx(cell_idxs))};
+                    lue_hpx_assert(side_idx < nr_pending_inputs.size());
+                    lue_hpx_assert(nr_pending_inputs[side_idx] > 0);
+                    --nr_pending_inputs[side_idx];
+                }
 
-                if (input_cells_idxs.empty())
+                nr_pending_inputs_total -= static_cast<Count>(material.size());
+                lue_hpx_assert(nr_pending_inputs_total >= 0);
+
+                accumulate(cells_idxs, material.values());
+
+                if (nr_pending_inputs_total == 0)
                 {
                     // No material should be sent trough this channel
                     // again. We don't need it. It would be a bug.
@@ -641,7 +897,7 @@ namespace lue {
                 }
             }
 
-            lue_hpx_assert(input_cells_idxs.empty());
+            lue_hpx_assert(nr_pending_inputs_total == 0);
         }
 
 
@@ -881,6 +1137,10 @@ namespace lue {
                             }
                         }
 
+                        // Send material to neighbouring partitions. All remaining streams depend on
+                        // material from them.
+                        accumulator.flush();
+
                         return std::apply(
                             [&inflow_count_data_copy, &output_cells_idxs](auto&&... result_data)
                             {
@@ -899,6 +1159,214 @@ namespace lue {
         }
 
 
+        //! Minimum number of cells in a level for entering them concurrently
+        constexpr Count min_nr_concurrent_level_cells{1024};
+
+
+        //! Maximum number of cells of a level entered at once
+        constexpr Count max_nr_level_cells_per_batch{256};
+
+
+        /*!
+            @brief      Like solve_intra_partition_stream_cells, but visiting cells in the order
+                        determined by intra_partition_stream_order()
+            @param      intra_partition_levels Offsets in @a intra_partition_order of the levels
+
+            Cells are visited one level at a time. First, all cells of a level are entered, in
+            batches. This only updates the state of the cells themselves, based on the material
+            received from upstream cells in previous levels. In large levels, batches are entered
+            concurrently.
+            Then, the cells of the level are left, one at a time, passing material downstream. This
+            cannot be done concurrently, since cells draining into the same downstream cell all
+            update it.
+        */
+        template<typename Policies, typename Functor, typename... Arguments>
+        auto sweep_intra_partition_stream_cells(
+            Policies const& policies,
+            Functor functor,
+            ArrayPartition<policy::InputElementT<Policies, 0>, 2> const& flow_direction_partition,
+            Arguments const&... arguments,
+            typename Functor::InflowCountPartition const& inflow_count_partition,
+            ArrayPartition<IndexElement, 2> const& intra_partition_order,
+            ArrayPartition<IndexElement, 2> const& intra_partition_levels,
+            MaterialCommunicator<MaterialT<Functor>, 2>& material_communicator,
+            hpx::future<std::array<typename Functor::CellsIdxs, nr_neighbours<2>()>>&& output_cells_idxs_f)
+            -> IntraPartitionStreamCellsResult<Functor>
+        {
+            using FlowDirectionPartition = ArrayPartition<FlowDirectionElement, 2>;
+            using FlowDirectionData = DataT<FlowDirectionPartition>;
+            using InflowCountData = Functor::InflowCountData;
+            using OrderPartition = ArrayPartition<IndexElement, 2>;
+            using OrderData = DataT<OrderPartition>;
+
+            return hpx::split_future(
+                hpx::dataflow(
+                    hpx::launch::async,
+
+                    [policies, functor = std::move(functor), material_communicator](
+                        FlowDirectionPartition const& flow_direction_partition,
+                        Arguments const&... arguments,
+                        typename Functor::InflowCountPartition const& inflow_count_partition,
+                        OrderPartition const& intra_partition_order,
+                        OrderPartition const& intra_partition_levels,
+                        hpx::future<std::array<typename Functor::CellsIdxs, nr_neighbours<2>()>>&&
+                            output_cells_idxs_f) mutable -> auto
+                    {
+                        AnnotateFunction const annotation{
+                            "accumulating_router: partition: intra_partition_stream"};
+
+                        auto const flow_direction_partition_ptr{
+                            ready_component_ptr(flow_direction_partition)};
+                        FlowDirectionData const& flow_direction_data{flow_direction_partition_ptr->data()};
+
+                        auto const inflow_count_partition_ptr{ready_component_ptr(inflow_count_partition)};
+                        InflowCountData const& inflow_count_data{inflow_count_partition_ptr->data()};
+
+                        auto const intra_partition_order_ptr{ready_component_ptr(intra_partition_order)};
+                        OrderData const& order_data{intra_partition_order_ptr->data()};
+
+                        auto const intra_partition_levels_ptr{ready_component_ptr(intra_partition_levels)};
+                        OrderData const& levels_data{intra_partition_levels_ptr->data()};
+
+                        auto const& partition_shape{inflow_count_data.shape()};
+                        auto const [nr_elements0, nr_elements1] = partition_shape;
+
+                        // Downstream accumulation updates inflow counts
+                        InflowCountData inflow_count_data_copy{deep_copy(inflow_count_data)};
+
+                        auto const& indp_flow_direction =
+                            std::get<0>(policies.inputs_policies()).input_no_data_policy();
+
+                        auto output_cells_idxs{output_cells_idxs_f.get()};
+
+                        // tuple<PartitionData...>
+                        auto result_data = Functor::initialize_result_data(partition_shape);
+
+                        auto cell_accumulator{std::apply(
+                            // MSVC doesn't like this: [&policies, &arguments...](auto&... result_data)
+                            [&](auto&... result_data) -> auto
+                            {
+                                return functor.template cell_accumulator<decltype(get_data(arguments))...>(
+                                    policies, get_data(arguments)..., result_data...);
+                            },
+                            result_data)};
+
+                        Accumulator accumulator{
+                            std::move(cell_accumulator), material_communicator, output_cells_idxs};
+
+                        for (Index idx0 = 0; idx0 < nr_elements0; ++idx0)
+                        {
+                            for (Index idx1 = 0; idx1 < nr_elements1; ++idx1)
+                            {
+                                if (indp_flow_direction.is_no_data(flow_direction_data, idx0, idx1))
+                                {
+                                    accumulator.mark_no_data(idx0, idx1);
+                                }
+                            }
+                        }
+
+                        auto const enter_cells =
+                            [&](Index const batch_begin, Index const batch_end) -> void
+                        {
+                            std::array<std::array<Index, 2>, max_nr_level_cells_per_batch> cells_idxs{};
+
+                            lue_hpx_assert(batch_end - batch_begin <= max_nr_level_cells_per_batch);
+
+                            for (Index cell_idx = batch_begin; cell_idx < batch_end; ++cell_idx)
+                            {
+                                Index const idx0{static_cast<Index>(order_data[cell_idx]) / nr_elements1};
+                                Index const idx1{static_cast<Index>(order_data[cell_idx]) % nr_elements1};
+
+                                if (inflow_count_data(idx0, idx1) == 0)
+                                {
+                                    accumulator.enter_intra_partition_stream(idx0, idx1);
+                                }
+
+                                cells_idxs[cell_idx - batch_begin] = {idx0, idx1};
+                            }
+
+                            accumulator.enter_cells(std::span{
+                                cells_idxs.data(), static_cast<std::size_t>(batch_end - batch_begin)});
+                        };
+
+                        auto const leave_cell = [&](Index const cell_idx) -> void
+                        {
+                            Index const idx0{static_cast<Index>(order_data[cell_idx]) / nr_elements1};
+                            Index const idx1{static_cast<Index>(order_data[cell_idx]) % nr_elements1};
+
+                            leave_entered_cell(
+                                accumulator, idx0, idx1, flow_direction_data, inflow_count_data_copy);
+
+                            if (inflow_count_data(idx0, idx1) == 0)
+                            {
+                                accumulator.leave_intra_partition_stream(idx0, idx1);
+                            }
+                        };
+
+                        Count const nr_levels{lue::nr_elements(levels_data) - 1};
+
+                        for (Index level_idx = 0; level_idx < nr_levels; ++level_idx)
+                        {
+                            Index const level_begin{static_cast<Index>(levels_data[level_idx])};
+                            Index const level_end{static_cast<Index>(levels_data[level_idx + 1])};
+
+                            Count const nr_batches{
+                                (level_end - level_begin + max_nr_level_cells_per_batch - 1) /
+                                max_nr_level_cells_per_batch};
+
+                            auto const enter_batch = [&](Index const batch_idx) -> void
+                            {
+                                Index const batch_begin{
+                                    level_begin + (batch_idx * max_nr_level_cells_per_batch)};
+
+                                enter_cells(
+                                    batch_begin,
+                                    std::min<Index>(batch_begin + max_nr_level_cells_per_batch, level_end));
+                            };
+
+                            if (level_end - level_begin >= min_nr_concurrent_level_cells)
+                            {
+                                hpx::experimental::for_loop(
+                                    hpx::execution::par, Index{0}, nr_batches, enter_batch);
+                            }
+                            else
+                            {
+                                for (Index batch_idx = 0; batch_idx < nr_batches; ++batch_idx)
+                                {
+                                    enter_batch(batch_idx);
+                                }
+                            }
+
+                            for (Index cell_idx = level_begin; cell_idx < level_end; ++cell_idx)
+                            {
+                                leave_cell(cell_idx);
+                            }
+                        }
+
+                        // Send material to neighbouring partitions. All remaining streams depend on
+                        // material from them.
+                        accumulator.flush();
+
+                        return std::apply(
+                            [&inflow_count_data_copy, &output_cells_idxs](auto&&... result_data)
+                            {
+                                return std::make_tuple(
+                                    std::move(result_data)...,
+                                    std::move(inflow_count_data_copy),
+                                    std::move(output_cells_idxs));
+                            },
+                            std::move(result_data));
+                    },
+
+                    flow_direction_partition,
+                    arguments...,
+                    inflow_count_partition,
+                    intra_partition_order,
+                    intra_partition_levels,
+                    std::move(output_cells_idxs_f)));
+        }
+
+
         template<typename Policies, typename Functor, typename... Arguments, typename... Results>
         auto solve_inter_partition_stream_cells(
             Policies const& policies,
@@ -984,29 +1452,44 @@ namespace lue {
                     hpx::mutex accu_mutex{};
                     using MaterialElement = policy::OutputElementT<Policies, 0>;
 
+                    // Per cell, a value is received per layer of material
+                    constexpr std::size_t nr_layers{decltype(accumulator)::nr_layers};
+
                     auto accumulate = [&accu_mutex, &accumulator, &flow_direction_data, &inflow_count_data](
-                                          std::array<Index, 2> const& cell_idxs,
-                                          MaterialElement const value) mutable -> auto
+                                          std::vector<std::array<Index, 2>> const& cells_idxs,
+                                          std::vector<MaterialElement> const& values) mutable -> auto
                     {
-                        auto [idx0, idx1] = cell_idxs;
+                        lue_hpx_assert(cells_idxs.size() * nr_layers == values.size());
 
                         // Prevent multiple threads from touching this data at the same time
                         std::scoped_lock lock{accu_mutex};
 
-                        lue_hpx_assert(inflow_count_data(idx0, idx1) >= 1);
+                        for (std::size_t i = 0; i < cells_idxs.size(); ++i)
+                        {
+                            auto [idx0, idx1] = cells_idxs[i];
 
-                        accumulator.enter_inter_partition_stream(value, idx0, idx1);
+                            lue_hpx_assert(inflow_count_data(idx0, idx1) >= 1);
 
-                        --inflow_count_data(idx0, idx1);
+                            accumulator.enter_inter_partition_stream(
+                                std::span<MaterialElement const, nr_layers>{
+                                    values.data() + (i * nr_layers), nr_layers},
+                                idx0,
+                                idx1);
 
-                        // Note that multiple streams from other partitions can join in a single partition
-                        // input cell. Only start an accumulation if this is the last one.
-                        if (inflow_count_data(idx0, idx1) == 0)
-                        {
-                            detail::accumulate(
-                                accumulator, idx0, idx1, flow_direction_data, inflow_count_data);
-                            accumulator.leave_inter_partition_stream(idx0, idx1);
+                            --inflow_count_data(idx0, idx1);
+
+                            // Note that multiple streams from other partitions can join in a single
+                            // partition input cell. Only start an accumulation if this is the last one.
+                            if (inflow_count_data(idx0, idx1) == 0)
+                            {
+                                detail::accumulate(
+                                    accumulator, idx0, idx1, flow_direction_data, inflow_count_data);
+                                accumulator.leave_inter_partition_stream(idx0, idx1);
+                            }
                         }
+
+                        // No more progress can be made until more material arrives
+                        accumulator.flush();
                     };
                     using Accumulate = decltype(accumulate);
 
@@ -1193,7 +1676,6 @@ namespace lue {
                             [](auto const& idxs) { return idxs.empty(); }));
 
                     // TODO Assert all inflow counts are zero
-                    // TODO Assert all sender channels are closed
 
                     return result_data;
                 },
@@ -1269,14 +1751,7 @@ namespace lue {
                         inflow_count<Policies>(
                             policies, flow_direction_partition, std::move(inflow_count_communicator));
 
-                    using FlowDirectionElement = policy::InputElementT<Policies, 0>;
-                    using FlowDirectionPartition = ArrayPartition<FlowDirectionElement, 2>;
-
-                    hpx::future<typename Functor::InflowCountData> inflow_count_data_f;
-                    auto results_partition_data_fs = Functor::initialize_results_partition_data_fs();
-
-                    // TODO: Merge the tied_references overloads
-                    tied_references1(results_partition_data_fs, inflow_count_data_f, output_cells_idxs_f) =
+                    auto intra_partition_stream_cells =
                         solve_intra_partition_stream_cells<Policies, Functor, Arguments...>(
                             policies,
                             functor,
@@ -1285,6 +1760,106 @@ namespace lue {
                             inflow_count_partition,
                             material_communicator,
                             std::move(output_cells_idxs_f));
+
+                    return route_partition(
+                        policies,
+                        std::move(functor),
+                        flow_direction_partition,
+                        arguments...,
+                        std::move(intra_partition_stream_cells),
+                        std::move(input_cells_idxs_f),
+                        std::move(material_communicator));
+                }
+
+
+                /*!
+                    @brief      Route material through a partition of a flow network
+                    @param      inflow_count_partition Per cell, the number of cells draining into it
+                    @param      intra_partition_order Order in which to visit the cells that don't
+                                depend on material from neighbouring partitions
+                    @param      intra_partition_levels Offsets in @a intra_partition_order of the
+                                levels of cells that can be entered concurrently
+                    @param      input_cells_idxs Per neighbouring partition, the cells receiving material
+                                from it
+                    @param      output_cells_idxs Per neighbouring partition, the cells sending material
+                                to it
+                */
+                static auto accumulate_network_partition(
+                    Policies const& policies,
+                    Functor functor,
+                    ArrayPartition<policy::InputElementT<Policies, 0>, 2> const& flow_direction_partition,
+                    Arguments const&... arguments,
+                    typename Functor::InflowCountPartition const& inflow_count_partition,
+                    ArrayPartition<IndexElement, 2> const& intra_partition_order,
+                    ArrayPartition<IndexElement, 2> const& intra_partition_levels,
+                    std::array<typename Functor::CellsIdxs, nr_neighbours<2>()> const& input_cells_idxs,
+                    std::array<typename Functor::CellsIdxs, nr_neighbours<2>()> output_cells_idxs,
+                    MaterialCommunicator<MaterialT<Functor>, 2> material_communicator)
+                    -> ActionResultT<Functor>
+                {
+                    auto intra_partition_stream_cells =
+                        sweep_intra_partition_stream_cells<Policies, Functor, Arguments...>(
+                            policies,
+                            functor,
+                            flow_direction_partition,
+                            arguments...,
+                            inflow_count_partition,
+                            intra_partition_order,
+                            intra_partition_levels,
+                            material_communicator,
+                            hpx::make_ready_future(std::move(output_cells_idxs)));
+
+                    return route_partition(
+                        policies,
+                        std::move(functor),
+                        flow_direction_partition,
+                        arguments...,
+                        std::move(intra_partition_stream_cells),
+                        hpx::make_ready_future(input_cells_idxs).share(),
+                        std::move(material_communicator));
+                }
+
+
+                struct Action:
+                    hpx::actions::
+                        make_action<decltype(&accumulate_partition), &accumulate_partition, Action>::type
+                {
+                };
+
+
+                struct NetworkAction:
+                    hpx::actions::make_action<
+                        decltype(&accumulate_network_partition),
+                        &accumulate_network_partition,
+                        NetworkAction>::type
+                {
+                };
+
+
+            private:
+
+                static auto route_partition(
+                    Policies const& policies,
+                    Functor functor,
+                    ArrayPartition<policy::InputElementT<Policies, 0>, 2> const& flow_direction_partition,
+                    Arguments const&... arguments,
+                    IntraPartitionStreamCellsResult<Functor>&& intra_partition_stream_cells,
+                    hpx::shared_future<std::array<typename Functor::CellsIdxs, nr_neighbours<2>()>>&&
+                        input_cells_idxs_f,
+                    MaterialCommunicator<MaterialT<Functor>, 2> material_communicator)
+                    -> ActionResultT<Functor>
+                {
+                    using FlowDirectionElement = policy::InputElementT<Policies, 0>;
+                    using FlowDirectionPartition = ArrayPartition<FlowDirectionElement, 2>;
+
+                    hpx::future<typename Functor::InflowCountData> inflow_count_data_f;
+                    hpx::future<std::array<typename Functor::CellsIdxs, nr_neighbours<2>()>>
+                        output_cells_idxs_f;
+                    auto results_partition_data_fs = Functor::initialize_results_partition_data_fs();
+
+                    // TODO: Merge the tied_references overloads
+                    tied_references1(results_partition_data_fs, inflow_count_data_f, output_cells_idxs_f) =
+                        std::move(intra_partition_stream_cells);
                     tied_references2(results_partition_data_fs) =
                         solve_inter_partition_stream_cells<Policies, Functor, Arguments...>(
                             policies,
@@ -1334,19 +1909,15 @@ namespace lue {
                         { return std::make_tuple(partition_f_to_partition(std::move(partition_fs))...); },
                         results_partition_fs);
                 }
-
-
-                struct Action:
-                    hpx::actions::
-                        make_action<decltype(&accumulate_partition), &accumulate_partition, Action>::type
-                {
-                };
         };
 
 
         template<typename Policies, typename Functor, typename... Arguments>
         using AccumulateAction = OverloadPicker<Policies, Functor, Arguments...>::Action;
 
+        template<typename Policies, typename Functor, typename... Arguments>
+        using AccumulateNetworkAction = OverloadPicker<Policies, Functor, Arguments...>::NetworkAction;
+
         // MSVC doesn't like this
         // template<typename Policies, typename Functor, typename... Arguments>
         // struct AccumulateAction:
@@ -1419,6 +1990,99 @@ namespace lue {
     }
 
 
+    /*!
+        @overload
+
+        The setup of the routing operation is skipped. The information needed is taken from
+        @a flow_network.
+    */
+    template<typename Policies, typename Functor, typename... Arguments>
+    auto accumulating_router(
+        Policies const& policies,
+        Functor const& functor,
+        FlowNetwork<policy::InputElementT<Policies, 0>, MaterialT<Functor>> const& flow_network,
+        Arguments const&... arguments) -> ResultsT<Functor>
+    {
+        using FlowNetwork = FlowNetwork<policy::InputElementT<Policies, 0>, MaterialT<Functor>>;
+        using NeighbourCellsIdxs = typename FlowNetwork::NeighbourCellsIdxs;
+
+        auto const& flow_direction{flow_network.flow_direction()};
+        Localities<2> const& localities{flow_direction.localities()};
+
+        auto const& shape_in_partitions{flow_direction.partitions().shape()};
+        Count const nr_partitions{nr_elements(shape_in_partitions)};
+
+        using Action =
+            detail::AccumulateNetworkAction<Policies, Functor, detail::PassedArgumentT<Arguments>...>;
+        Action action{};
+
+        // For each result array a collection to store the final partitions in
+        auto results_partitions = Functor::initialize_results_partitions(shape_in_partitions);
+
+        // For each partition, create a task that will return one or more result partitions and store these
+        // in the collections of partitions just created. Routing in a partition starts once the previous
+        // routing operation using the network's channels has finished in it and its neighbours.
+        flow_network.route(
+            [&](typename FlowNetwork::Routed const& routing_dependencies) -> typename FlowNetwork::Routed
+            {
+                typename FlowNetwork::Routed routed{shape_in_partitions};
+
+                for (Index partition_idx = 0; partition_idx < nr_partitions; ++partition_idx)
+                {
+                    partition_references(results_partitions, partition_idx) =
+                        hpx::split_future(hpx::future<ActionResultT<Functor>>{hpx::dataflow(
+                            hpx::launch::async,
+
+                            [action,
+                             locality_id = localities[partition_idx],
+                             policies,
+                             functor,
+                             flow_direction_partition = flow_direction.partitions()[partition_idx],
+                             ... arguments = detail::pass_argument(arguments, partition_idx),
+                             inflow_count_partition =
+                                 flow_network.inflow_count().partitions()[partition_idx],
+                             intra_partition_order =
+                                 flow_network.intra_partition_order().partitions()[partition_idx],
+                             intra_partition_levels = flow_network.intra_partition_levels()[partition_idx],
+                             material_communicator = flow_network.material_communicators()[partition_idx]](
+                                hpx::shared_future<NeighbourCellsIdxs> const& input_cells_idxs,
+                                hpx::shared_future<NeighbourCellsIdxs> const& output_cells_idxs,
+                                [[maybe_unused]] hpx::shared_future<void> const& routing_dependency)
+                                -> hpx::future<ActionResultT<Functor>>
+                            {
+                                return hpx::async(
+                                    action,
+                                    locality_id,
+                                    policies,
+                                    functor,
+                                    flow_direction_partition,
+                                    arguments...,
+                                    inflow_count_partition,
+                                    intra_partition_order,
+                                    intra_partition_levels,
+                                    input_cells_idxs.get(),
+                                    output_cells_idxs.get(),
+                                    material_communicator);
+                            },
+
+                            flow_network.input_cells_idxs()[partition_idx],
+                            flow_network.output_cells_idxs()[partition_idx],
+                            routing_dependencies[partition_idx])});
+
+                    routed[partition_idx] = hpx::when_all(std::get<0>(results_partitions)[partition_idx])
+                                                .then([]([[maybe_unused]] auto&& partitions) {})
+                                                .share();
+                }
+
+                return routed;
+            });
+
+        // Return partitioned arrays containing the collections of partitions just created
+        return results_partitions_to_arrays(
+            results_partitions, flow_direction.shape(), flow_direction.localities_ptr());
+    }
+
+
     /*!
         @brief      Base class for accumulating router functors
         @tparam     ArgumentElements_ Element types of all arguments
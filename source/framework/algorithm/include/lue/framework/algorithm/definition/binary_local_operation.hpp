@@ -1,5 +1,6 @@
 #pragma once
 #include "lue/framework/algorithm/binary_local_operation.hpp"
+#include "lue/framework/algorithm/detail/dense_local_operation.hpp"
 #include "lue/framework/algorithm/detail/verify_compatible.hpp"
 #include "lue/framework/algorithm/functor_traits.hpp"
 #include "lue/framework/algorithm/local_operation_export.hpp"
@@ -12,6 +13,45 @@ namespace lue {
     namespace detail {
         namespace binary_local_operation {
 
+            /*!
+                @brief      Calculate the output value given a single pair of input values
+
+                This is used for scalar inputs and for uniform array partitions.
+            */
+            template<typename Policies, typename Functor>
+            auto binary_local_operation_value(
+                Policies const& policies,
+                policy::InputElementT<Policies, 0> const& input_value1,
+                policy::InputElementT<Policies, 1> const& input_value2,
+                Functor const& functor) -> policy::OutputElementT<Policies, 0>
+            {
+                auto const& dp = policies.domain_policy();
+                auto const& indp1 = std::get<0>(policies.inputs_policies()).input_no_data_policy();
+                auto const& indp2 = std::get<1>(policies.inputs_policies()).input_no_data_policy();
+                auto const& ondp = std::get<0>(policies.outputs_policies()).output_no_data_policy();
+                auto const& rp = std::get<0>(policies.outputs_policies()).range_policy();
+
+                policy::OutputElementT<Policies, 0> output_value;
+
+                if ((indp1.is_no_data(input_value1) || indp2.is_no_data(input_value2)) ||
+                    !dp.within_domain(input_value1, input_value2))
+                {
+                    ondp.mark_no_data(output_value);
+                }
+                else
+                {
+                    output_value = functor(input_value1, input_value2);
+
+                    if (!rp.within_range(input_value1, input_value2, output_value))
+                    {
+                        ondp.mark_no_data(output_value);
+                    }
+                }
+
+                return output_value;
+            }
+
+
             template<
                 typename T1,
                 typename T2,
@@ -71,6 +111,22 @@ namespace lue {
                                     input_partition1.data(hpx::launch::sync);
                                 InputData2 const input_partition_data2 =
                                     input_partition2.data(hpx::launch::sync);
+
+                                if (input_partition_data1.is_uniform() && input_partition_data2.is_uniform())
+                                {
+                                    return OutputPartition{
+                                        hpx::find_here(),
+                                        offset,
+                                        OutputData{
+                                            input_partition_data1.shape(),
+                                            binary_local_operation_value(
+                                                policies,
+                                                input_partition_data1.uniform_value(),
+                                                input_partition_data2.uniform_value(),
+                                                functor),
+                                            UniformTag{}}};
+                                }
+
                                 OutputData output_partition_data{input_partition_data1.shape()};
 
                                 auto const& dp = policies.domain_policy();
@@ -85,30 +141,55 @@ namespace lue {
                                 Count const nr_elements{lue::nr_elements(input_partition_data1)};
                                 lue_hpx_assert(lue::nr_elements(input_partition_data2) == nr_elements);
 
-                                for (Index i = 0; i < nr_elements; ++i)
+                                if constexpr (dense_local_operation_v<
+                                                  Policies,
+                                                  policy::InputElementT<Policies, 0>,
+                                                  policy::InputElementT<Policies, 1>,
+                                                  policy::OutputElementT<Policies, 0>>)
                                 {
-                                    if (indp1.is_no_data(input_partition_data1, i) ||
-                                        indp2.is_no_data(input_partition_data2, i))
-                                    {
-                                        ondp.mark_no_data(output_partition_data, i);
-                                    }
-                                    else if (!dp.within_domain(
-                                                 input_partition_data1[i], input_partition_data2[i]))
-                                    {
-                                        ondp.mark_no_data(output_partition_data, i);
-                                    }
-                                    else
+                                    // Evaluate the functor for all elements, without branching on
+                                    // no-data. Mark no-data in the output afterwards.
+                                    ValidityMask validity{
+                                        ValidityMask::detect(indp1, input_partition_data1, nr_elements)};
+                                    validity &=
+                                        ValidityMask::detect(indp2, input_partition_data2, nr_elements);
+
+                                    std::transform(
+                                        input_partition_data1.begin(),
+                                        input_partition_data1.end(),
+                                        input_partition_data2.begin(),
+                                        output_partition_data.begin(),
+                                        functor);
+
+                                    validity.mark(ondp, output_partition_data);
+                                }
+                                else
+                                {
+                                    for (Index i = 0; i < nr_elements; ++i)
                                     {
-                                        output_partition_data[i] =
-                                            functor(input_partition_data1[i], input_partition_data2[i]);
-
-                                        if (!rp.within_range(
-                                                input_partition_data1[i],
-                                                input_partition_data2[i],
-                                                output_partition_data[i]))
+                                        if (indp1.is_no_data(input_partition_data1, i) ||
+                                            indp2.is_no_data(input_partition_data2, i))
                                         {
                                             ondp.mark_no_data(output_partition_data, i);
                                         }
+                                        else if (!dp.within_domain(
+                                                     input_partition_data1[i], input_partition_data2[i]))
+                                        {
+                                            ondp.mark_no_data(output_partition_data, i);
+                                        }
+                                        else
+                                        {
+                                            output_partition_data[i] =
+                                                functor(input_partition_data1[i], input_partition_data2[i]);
+
+                                            if (!rp.within_range(
+                                                    input_partition_data1[i],
+                                                    input_partition_data2[i],
+                                                    output_partition_data[i]))
+                                            {
+                                                ondp.mark_no_data(output_partition_data, i);
+                                            }
+                                        }
                                     }
                                 }
 
@@ -174,6 +255,22 @@ namespace lue {
                                 InputData const input_partition_data =
                                     input_partition.data(hpx::launch::sync);
                                 InputElement const input_value = input_scalar.get();
+
+                                if (input_partition_data.is_uniform())
+                                {
+                                    return OutputPartition{
+                                        hpx::find_here(),
+                                        offset,
+                                        OutputData{
+                                            input_partition_data.shape(),
+                                            binary_local_operation_value(
+                                                policies,
+                                                input_partition_data.uniform_value(),
+                                                input_value,
+                                                functor),
+                                            UniformTag{}}};
+                                }
+
                                 OutputData output_partition_data{input_partition_data.shape()};
 
                                 auto const& dp = policies.domain_policy();
@@ -284,6 +381,22 @@ namespace lue {
                                 Offset const offset = input_partition.offset(hpx::launch::sync);
                                 InputData const input_partition_data =
                                     input_partition.data(hpx::launch::sync);
+
+                                if (input_partition_data.is_uniform())
+                                {
+                                    return OutputPartition{
+                                        hpx::find_here(),
+                                        offset,
+                                        OutputData{
+                                            input_partition_data.shape(),
+                                            binary_local_operation_value(
+                                                policies,
+                                                input_value,
+                                                input_partition_data.uniform_value(),
+                                                functor),
+                                            UniformTag{}}};
+                                }
+
                                 OutputData output_partition_data{input_partition_data.shape()};
 
                                 auto const& dp = policies.domain_policy();
@@ -576,30 +689,8 @@ namespace lue {
             hpx::unwrapping(
                 [policies, functor](auto const& input_value1, auto const& input_value2) -> OutputElement
                 {
-                    auto const& dp = policies.domain_policy();
-                    auto const& indp1 = std::get<0>(policies.inputs_policies()).input_no_data_policy();
-                    auto const& indp2 = std::get<1>(policies.inputs_policies()).input_no_data_policy();
-                    auto const& ondp = std::get<0>(policies.outputs_policies()).output_no_data_policy();
-                    auto const& rp = std::get<0>(policies.outputs_policies()).range_policy();
-
-                    OutputElement output_value;
-
-                    if ((indp1.is_no_data(input_value1) || indp2.is_no_data(input_value2)) ||
-                        !dp.within_domain(input_value1, input_value2))
-                    {
-                        ondp.mark_no_data(output_value);
-                    }
-                    else
-                    {
-                        output_value = functor(input_value1, input_value2);
-
-                        if (!rp.within_range(input_value1, input_value2, output_value))
-                        {
-                            ondp.mark_no_data(output_value);
-                        }
-                    }
-
-                    return output_value;
+                    return detail::binary_local_operation::binary_local_operation_value(
+                        policies, input_value1, input_value2, functor);
                 }),
             input_scalar1,
             input_scalar2);
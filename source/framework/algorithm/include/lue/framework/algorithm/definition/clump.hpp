@@ -1,6 +1,7 @@
 #pragma once
 #include "lue/framework/algorithm/clump.hpp"
 #include "lue/framework/algorithm/detail/promise.hpp"
+#include "lue/framework/algorithm/detail/union_find.hpp"
 #include "lue/framework/algorithm/zonal_operation_export.hpp"
 #include "lue/framework/core/annotate.hpp"
 #include "lue/framework/core/component.hpp"
@@ -10,9 +11,13 @@
 
 #include <hpx/serialization.hpp>
 
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <map>
+#include <numeric>
 #include <stack>
-#include <unordered_map>
-#include <unordered_set>
+#include <tuple>
 #include <vector>
 
 
@@ -575,69 +580,21 @@ namespace lue {
 
                 using ClumpData = ArrayPartitionData<ClumpElement, rank<Partition>>;
 
-                using ClumpSides = std::array<std::array<ClumpData, 2>, 2>;
+                using Shape = ShapeT<Partition>;
 
-                using ZoneElement = ElementT<Partition>;
-
-                using ZoneData = ArrayPartitionData<ZoneElement, rank<Partition>>;
-
-                using ZoneSides = std::array<std::array<ZoneData, 2>, 2>;
-
-                using LUT = std::unordered_map<ClumpElement, ClumpElement>;
-
-                enum Direction { horizontal, vertical };
-                enum HorizontalSide { north, south };
-                enum VerticalSide { west, east };
+                //! Per local clump ID, the global clump ID, or empty if these differ by an offset only
+                using LUT = std::vector<ClumpElement>;
 
 
                 template<typename Offset>
-                LocalResult(
-                    Offset const& offset,
-                    ClumpData&& data,
-                    Count const nr_clumps,
-                    ZoneSides&& zone_sides,
-                    ClumpSides&& clump_sides):
+                LocalResult(Offset const& offset, ClumpData&& data, Count const nr_clumps):
 
+                    _shape{data.shape()},
                     _partition{hpx::find_here(), offset, std::move(data)},
-                    _zone_sides{std::move(zone_sides)},
-                    _clump_sides{std::move(clump_sides)},
+                    _nr_clumps{nr_clumps},
                     _lut{}
 
                 {
-                    // Two rows, north and south sides
-                    lue_hpx_assert(zone_sides[Direction::horizontal][HorizontalSide::north].shape()[0] <= 1);
-                    lue_hpx_assert(zone_sides[Direction::horizontal][HorizontalSide::south].shape()[0] <= 1);
-                    lue_hpx_assert(
-                        zone_sides[Direction::horizontal][HorizontalSide::north].shape() ==
-                        zone_sides[Direction::horizontal][HorizontalSide::south].shape());
-
-                    // // Two columns, west and east sides
-                    lue_hpx_assert(zone_sides[Direction::vertical][VerticalSide::west].shape()[1] <= 1);
-                    lue_hpx_assert(zone_sides[Direction::vertical][VerticalSide::east].shape()[1] <= 1);
-                    lue_hpx_assert(
-                        zone_sides[Direction::vertical][VerticalSide::west].shape() ==
-                        zone_sides[Direction::vertical][VerticalSide::east].shape());
-
-                    // Two rows, north and south sides
-                    lue_hpx_assert(clump_sides[Direction::horizontal][HorizontalSide::north].shape()[0] <= 1);
-                    lue_hpx_assert(clump_sides[Direction::horizontal][HorizontalSide::south].shape()[0] <= 1);
-                    lue_hpx_assert(
-                        clump_sides[Direction::horizontal][HorizontalSide::north].shape() ==
-                        clump_sides[Direction::horizontal][HorizontalSide::south].shape());
-
-                    // // Two columns, west and east sides
-                    lue_hpx_assert(clump_sides[Direction::vertical][VerticalSide::west].shape()[1] <= 1);
-                    lue_hpx_assert(clump_sides[Direction::vertical][VerticalSide::east].shape()[1] <= 1);
-                    lue_hpx_assert(
-                        clump_sides[Direction::vertical][VerticalSide::west].shape() ==
-                        clump_sides[Direction::vertical][VerticalSide::east].shape());
-
-                    ClumpElement clump_id{0};
-
-                    for (Count idx = 0; idx < nr_clumps; ++idx, ++clump_id)
-                    {
-                        _lut[clump_id] = clump_id;
-                    }
                 }
 
 
@@ -660,108 +617,62 @@ namespace lue {
                 }
 
 
-                auto reclassify_global_clump_ids(ClumpElement const initial_id) -> Count
+                auto shape() const -> Shape const&
                 {
-                    for (auto& pair : _lut)
-                    {
-                        pair.second += initial_id;
-                    }
-
-                    return _lut.size();
+                    return _shape;
                 }
 
 
-                auto lut() -> LUT const&
+                auto nr_clumps() const -> Count
                 {
-                    return _lut;
+                    return _nr_clumps;
                 }
 
 
-                auto global_clump_id(ClumpElement const local_clump_id) const -> ClumpElement
-                {
-                    lue_hpx_assert(_lut.find(local_clump_id) != _lut.end());
+                /*!
+                    @brief      Determine the global clump IDs of the local clumps
+                    @param      offset Initial global clump ID of the first local clump. The
+                                initial global clump IDs of the local clumps are consecutive.
+                    @param      clumps Sets of initial global clump IDs that are part of the same
+                                global clump
 
-                    return _lut.find(local_clump_id)->second;
-                }
-
-
-                void update_global_clump_id(
-                    ClumpElement const local_clump_id, ClumpElement const new_global_clump_id)
+                    A local clump's global clump ID is the smallest initial global clump ID of the
+                    clumps it is merged with. The LUT is only filled when this differs from the
+                    initial global clump ID for at least one local clump.
+                */
+                void set_global_clump_ids(ClumpElement const offset, UnionFind<ClumpElement>& clumps)
                 {
-                    lue_hpx_assert(_lut.find(local_clump_id) != _lut.end());
-
-                    _lut.find(local_clump_id)->second = new_global_clump_id;
-                }
-
-
-                auto north_side() const -> std::
-                    tuple<std::reference_wrapper<ZoneData const>, std::reference_wrapper<ClumpData const>>
-                {
-                    return {
-                        std::cref(_zone_sides[Direction::horizontal][HorizontalSide::north]),
-                        std::cref(_clump_sides[Direction::horizontal][HorizontalSide::north])};
-                }
-
-
-                auto south_side() const -> std::
-                    tuple<std::reference_wrapper<ZoneData const>, std::reference_wrapper<ClumpData const>>
-                {
-                    return {
-                        std::cref(_zone_sides[Direction::horizontal][HorizontalSide::south]),
-                        std::cref(_clump_sides[Direction::horizontal][HorizontalSide::south])};
-                }
-
-
-                auto west_side() const -> std::
-                    tuple<std::reference_wrapper<ZoneData const>, std::reference_wrapper<ClumpData const>>
-                {
-                    return {
-                        std::cref(_zone_sides[Direction::vertical][VerticalSide::west]),
-                        std::cref(_clump_sides[Direction::vertical][VerticalSide::west])};
-                }
-
-
-                auto east_side() const -> std::
-                    tuple<std::reference_wrapper<ZoneData const>, std::reference_wrapper<ClumpData const>>
-                {
-                    return {
-                        std::cref(_zone_sides[Direction::vertical][VerticalSide::east]),
-                        std::cref(_clump_sides[Direction::vertical][VerticalSide::east])};
-                }
+                    _offset = offset;
+                    _lut.clear();
 
+                    for (Count idx = 0; idx < _nr_clumps; ++idx)
+                    {
+                        auto const initial_id{static_cast<ClumpElement>(offset + idx)};
+                        ClumpElement const global_id{clumps.find(initial_id)};
 
-                auto north_west_corner() const -> std::tuple<ZoneElement, ClumpElement>
-                {
-                    return {
-                        _zone_sides[Direction::horizontal][HorizontalSide::north][0],
-                        _clump_sides[Direction::horizontal][HorizontalSide::north][0]};
-                }
-
+                        if (global_id != initial_id)
+                        {
+                            if (_lut.empty())
+                            {
+                                _lut.resize(_nr_clumps);
+                                std::iota(_lut.begin(), _lut.end(), offset);
+                            }
 
-                auto north_east_corner() const -> std::tuple<ZoneElement, ClumpElement>
-                {
-                    return {
-                        _zone_sides[Direction::vertical][VerticalSide::east][0],
-                        _clump_sides[Direction::vertical][VerticalSide::east][0]};
+                            _lut[idx] = global_id;
+                        }
+                    }
                 }
 
 
-                auto south_east_corner() const -> std::tuple<ZoneElement, ClumpElement>
+                auto offset() const -> ClumpElement
                 {
-                    auto const nr_rows = _zone_sides[Direction::vertical][VerticalSide::east].shape()[0];
-                    lue_hpx_assert(nr_rows > 0);
-
-                    return {
-                        _zone_sides[Direction::vertical][VerticalSide::east][nr_rows - 1],
-                        _clump_sides[Direction::vertical][VerticalSide::east][nr_rows - 1]};
+                    return _offset;
                 }
 
 
-                auto south_west_corner() const -> std::tuple<ZoneElement, ClumpElement>
+                auto lut() const -> LUT const&
                 {
-                    return {
-                        _zone_sides[Direction::horizontal][HorizontalSide::south][0],
-                        _clump_sides[Direction::horizontal][HorizontalSide::south][0]};
+                    return _lut;
                 }
 
 
@@ -775,20 +686,24 @@ namespace lue {
                 {
                     // clang-format off
                     archive
+                        & _shape
                         & _partition
-                        & _zone_sides
-                        & _clump_sides
+                        & _nr_clumps
+                        & _offset
                         & _lut
                         ;
                     // clang-format on
                 }
 
 
+                Shape _shape{};
+
                 Partition _partition;
 
-                ZoneSides _zone_sides;
+                Count _nr_clumps{0};
 
-                ClumpSides _clump_sides;
+                //! Initial global clump ID of the first local clump
+                ClumpElement _offset{0};
 
                 LUT _lut;
         };
@@ -815,9 +730,6 @@ namespace lue {
             using LocalResult = LocalResult<Partition>;
             using ClumpElement = typename LocalResult::ClumpElement;
             using ClumpData = typename LocalResult::ClumpData;
-            using ClumpSides = typename LocalResult::ClumpSides;
-            using ZoneData = typename LocalResult::ZoneData;
-            using ZoneSides = typename LocalResult::ZoneSides;
 
             // Iterate over all cells that have not yet been identified as being part of a
             // clump and execute the flood-fill algorithm for each of these. Start with a result
@@ -862,57 +774,7 @@ namespace lue {
                         }
                     }
 
-                    ZoneData north{{1, nr_cols}};
-                    ZoneData south{{1, nr_cols}};
-                    {
-                        auto src_begin = zone_data.begin();
-                        std::copy(src_begin, src_begin + nr_cols, north.begin());
-
-                        src_begin = zone_data.begin() + (nr_rows - 1) * nr_cols;
-                        std::copy(src_begin, src_begin + nr_cols, south.begin());
-                    }
-
-                    ZoneData west{{nr_rows, 1}};
-                    ZoneData east{{nr_rows, 1}};
-
-                    for (Index row = 0; row < nr_rows; ++row)
-                    {
-                        west[row] = zone_data(row, 0);
-                        east[row] = zone_data(row, nr_cols - 1);
-                    }
-
-                    ZoneSides zone_sides{
-                        {{std::move(north), std::move(south)}, {std::move(west), std::move(east)}}};
-
-                    ClumpData clump_data_north{{1, nr_cols}};
-                    ClumpData clump_data_south{{1, nr_cols}};
-                    {
-                        auto src_begin = clump_data.begin();
-                        std::copy(src_begin, src_begin + nr_cols, clump_data_north.begin());
-
-                        src_begin = clump_data.begin() + (nr_rows - 1) * nr_cols;
-                        std::copy(src_begin, src_begin + nr_cols, clump_data_south.begin());
-                    }
-
-                    ClumpData clump_data_west{{nr_rows, 1}};
-                    ClumpData clump_data_east{{nr_rows, 1}};
-
-                    for (Index row = 0; row < nr_rows; ++row)
-                    {
-                        clump_data_west[row] = clump_data(row, 0);
-                        clump_data_east[row] = clump_data(row, nr_cols - 1);
-                    }
-
-                    ClumpSides clump_sides{
-                        {{std::move(clump_data_north), std::move(clump_data_south)},
-                         {std::move(clump_data_west), std::move(clump_data_east)}}};
-
-                    return {
-                        offset,
-                        std::move(clump_data),
-                        static_cast<Count>(clump_id),
-                        std::move(zone_sides),
-                        std::move(clump_sides)};
+                    return {offset, std::move(clump_data), static_cast<Count>(clump_id)};
                 },
 
                 zone_partition);
@@ -969,890 +831,587 @@ namespace lue {
         }
 
 
-        template<typename InputNoDataPolicy, typename Partition>
-        void merge_clump(
-            InputNoDataPolicy const& indp,
-
-            std::tuple<Index, Index> const& north_partition_idxs,
-            typename LocalResult<Partition>::ClumpData const& north_clump_ids,
-            Index const north_idx,
-            LocalResult<Partition>& north_local_result,
+        //! Local clump in a partition: linear partition index and local clump ID
+        template<typename ClumpElement>
+        using LocalClump = std::tuple<Index, ClumpElement>;
 
-            std::tuple<Index, Index> const& south_partition_idxs,
-            typename LocalResult<Partition>::ClumpData const& south_clump_ids,
-            Index const south_idx,
-            LocalResult<Partition>& south_local_result,
+        //! Pair of local clumps that are part of the same global clump
+        template<typename ClumpElement>
+        using ClumpEdge = std::tuple<LocalClump<ClumpElement>, LocalClump<ClumpElement>>;
 
-            typename LocalResult<Partition>::ClumpData const& clump_data,
+        template<typename ClumpElement>
+        using ClumpEdges = std::vector<ClumpEdge<ClumpElement>>;
 
-            std::map<std::tuple<Index, Index, ElementT<Partition>>, Index>&
-                global_clump_ids_by_local_clump_id,
-            std::vector<std::set<ElementT<Partition>>>& global_clump_ids)
 
+        /*!
+            @brief      Return the pairs of local clumps, along a border between partitions, that are
+                        part of the same global clump
+            @param      zone_data Zones of the cells along the border, from different partitions
+            @param      local_clumps Per cell in @a zone_data, its local clump
+            @param      start_cells Cells to start flood fills from
+
+            Flood filling @a zone_data connects the cells that are part of the same global clump.
+            The local clumps of all cells reached by the same flood fill are paired with the first
+            local clump reached.
+        */
+        template<typename Policies, typename ZoneData, typename ClumpElement>
+        auto border_edges(
+            Policies const& policies,
+            ZoneData const& zone_data,
+            std::vector<LocalClump<ClumpElement>> const& local_clumps,
+            Count const nr_start_rows,
+            Connectivity const connectivity) -> ClumpEdges<ClumpElement>
         {
-            // Here, we talk about north and south partitions, but everything also holds for west and east
-            // partitions.
-
-            // We end up here when a flood fill analysis of the cells shared by the boundaries of two
-            // neighbouring partitions identified two cells that are part of different partitions, but share a
-            // global clump. We need to update the data structures we use to eventually stitch these local
-            // clumps together (global_clump_ids_by_local_clump_id and global_clump_ids).
-
-            // It is crucial that all cells that belong to the same global clump get connected correctly (of
-            // course). It is possible that multiple local clumps in a partition are actually part of the same
-            // global clump because they happen to be connected by local clumps in a neighbouring
-            // partition(!).
-
-            // Strategy:
-            // - All local clump IDs in the north and south boundary that belong to the same clump must be
-            //   associated with the same collection of global clump IDs
-            // - See if a (partition_idxs, local_clump_id) record in global_clump_ids_by_local_clump_id
-            //   already exists. We want to use its global_clump_ids_idx.
-            // - If not present, add a new empty collection of global clump IDs and initialize
-            //   global_clump_ids_idx.
-            // - Revisit all cells in both boundaries that are part of the same clump and add a
-            //   (partition_idxs, local_clump_id) record, if not there yet, and add a global clump ID to the
-            //   collection.
+            auto const& indp = std::get<0>(policies.inputs_policies()).input_no_data_policy();
+            auto const& ondp = std::get<0>(policies.outputs_policies()).output_no_data_policy();
 
-            using ClumpElement = ElementT<Partition>;
+            auto const [nr_rows, nr_cols] = zone_data.shape();
+            Count const nr_elements{nr_rows * nr_cols};
 
-            auto const nr_cols = clump_data.shape()[1];
-            auto const boundary_clump_id = clump_data[north_idx];
-            lue_hpx_assert(clump_data[nr_cols + south_idx] == boundary_clump_id);
+            lue_hpx_assert(static_cast<Count>(local_clumps.size()) == nr_elements);
 
-            Index global_clump_ids_idx{-1};
+            // Zone and clump IDs are of the same type
+            ElementT<ZoneData> clump_nd{};
+            ondp.mark_no_data(clump_nd);
+            ZoneData clump_data{zone_data.shape(), clump_nd};
+            ElementT<ZoneData> clump_id{0};
 
-            // Iterate over all cells to the east of north_idx in the north row that are part of the clumps to
-            // merge. Again, these may have different local clump IDs. First figure out whether we have
-            // already seen any of these (partition_idxs, local_clump_id) combinations.
+            for (Count row = 0; row < nr_start_rows; ++row)
             {
-                auto const [row_in_partitions, col_in_partitions] = north_partition_idxs;
-                auto key = std::make_tuple(row_in_partitions, col_in_partitions, ClumpElement{});
-
-                for (Index idx = north_idx; idx < nr_cols; ++idx)
+                for (Count col = 0; col < nr_cols; ++col)
                 {
-                    if (!indp.is_no_data(clump_data[idx]) && clump_data[idx] == boundary_clump_id)
+                    // Skip cells that do not contain a valid zone ID, or that already contain a valid
+                    // clump ID
+                    if ((!indp.is_no_data(zone_data, row, col)) && ondp.is_no_data(clump_data, row, col))
                     {
-                        auto const local_clump_id{north_clump_ids[idx]};
-                        std::get<2>(key) = local_clump_id;
-
-                        if (auto it = global_clump_ids_by_local_clump_id.find(key);
-                            it != global_clump_ids_by_local_clump_id.end())
-                        {
-                            global_clump_ids_idx = it->second;
-                            lue_hpx_assert(global_clump_ids_idx != -1);
-                            lue_hpx_assert(
-                                global_clump_ids_idx < static_cast<Index>(global_clump_ids.size()));
-                            break;
-                        }
+                        flood_fill(indp, ondp, zone_data, {row, col}, clump_data, clump_id, connectivity);
+                        ++clump_id;
                     }
                 }
             }
 
-            // If the previous did not result in a valid index to a collection of global clump IDs, try the
-            // south row.
-            if (/* connectivity == Connectivity::diagonal && */ global_clump_ids_idx == -1)
-            {
-                auto const [row_in_partitions, col_in_partitions] = south_partition_idxs;
-                auto key = std::make_tuple(row_in_partitions, col_in_partitions, ClumpElement{});
+            // Per border clump, the first local clump found to be part of it
+            std::vector<Index> first_cell_idxs(static_cast<std::size_t>(clump_id), -1);
+            ClumpEdges<ClumpElement> edges{};
 
-                for (Index idx = south_idx; idx < nr_cols; ++idx)
+            for (Index idx = 0; idx < nr_elements; ++idx)
+            {
+                if (!ondp.is_no_data(clump_data, idx))
                 {
-                    if (!indp.is_no_data(clump_data[nr_cols + idx]) &&
-                        clump_data[nr_cols + idx] == boundary_clump_id)
+                    Index& first_cell_idx{first_cell_idxs[static_cast<std::size_t>(clump_data[idx])]};
+
+                    if (first_cell_idx == -1)
+                    {
+                        first_cell_idx = idx;
+                    }
+                    else if (local_clumps[idx] != local_clumps[first_cell_idx])
                     {
-                        auto const local_clump_id{south_clump_ids[idx]};
-                        std::get<2>(key) = local_clump_id;
+                        ClumpEdge<ClumpElement> edge{local_clumps[first_cell_idx], local_clumps[idx]};
 
-                        if (auto it = global_clump_ids_by_local_clump_id.find(key);
-                            it != global_clump_ids_by_local_clump_id.end())
+                        // Neighbouring cells are often part of the same local clumps
+                        if (edges.empty() || edges.back() != edge)
                         {
-                            global_clump_ids_idx = it->second;
-                            lue_hpx_assert(global_clump_ids_idx != -1);
-                            lue_hpx_assert(
-                                global_clump_ids_idx < static_cast<Index>(global_clump_ids.size()));
-                            break;
+                            edges.push_back(std::move(edge));
                         }
                     }
                 }
             }
 
-            // If the previous still did not result in a valid index to a collection of global clump IDs, then
-            // it really isn't there yet. Add one.
-            if (global_clump_ids_idx == -1)
+            return edges;
+        }
+
+
+        //! Kind of border shared by neighbouring partitions
+        enum class BorderKind { horizontal, vertical, corner };
+
+
+        //! Partition sharing a border: linear partition index, shape, zone and local clump partitions
+        template<typename Partition>
+        using BorderPartition = std::tuple<Index, ShapeT<Partition>, Partition, Partition>;
+
+
+        /*!
+            @brief      Border shared by neighbouring partitions
+
+            The partitions sharing a horizontal border are ordered north, south, those sharing a
+            vertical border west, east, and those sharing a corner in row-major order.
+        */
+        template<typename Partition>
+        using Border = std::tuple<BorderKind, std::vector<BorderPartition<Partition>>>;
+
+
+        /*!
+            @brief      Return the slices selecting the cells along a border, in the partition at
+                        position @a idx in the border's partitions
+        */
+        template<typename Partition>
+        auto border_slices(BorderKind const kind, std::size_t const idx, ShapeT<Partition> const& shape)
+            -> SlicesT<Partition>
+        {
+            using Slice = SliceT<Partition>;
+            using Slices = SlicesT<Partition>;
+
+            auto const [nr_rows, nr_cols] = shape;
+
+            Slice const first_row{0, 1};
+            Slice const last_row{nr_rows - 1, nr_rows};
+            Slice const first_col{0, 1};
+            Slice const last_col{nr_cols - 1, nr_cols};
+
+            if (kind == BorderKind::horizontal)
+            {
+                // South side of the north partition, north side of the south partition
+                return Slices{{idx == 0 ? last_row : first_row, Slice{0, nr_cols}}};
+            }
+
+            if (kind == BorderKind::vertical)
             {
-                global_clump_ids.push_back({});
-                global_clump_ids_idx = global_clump_ids.size() - 1;
+                // East side of the west partition, west side of the east partition
+                return Slices{{Slice{0, nr_rows}, idx == 0 ? last_col : first_col}};
             }
 
-            lue_hpx_assert(global_clump_ids_idx != -1);
+            lue_hpx_assert(kind == BorderKind::corner);
 
-            {
-                // Iterate over all cells (again) to the east of north_idx in the north row that are part of
-                // the clumps to merge. Again, these may have different local clump IDs. Now add the global
-                // clump IDs to the collection just found or created. In case we encounter a cell with a
-                // local_clump_id for which a (partition_idxs, local_clump_id) record is not present yet, add
-                // one.
+            // Cell in the corner shared with the other partitions
+            return Slices{{idx < 2 ? last_row : first_row, idx % 2 == 0 ? last_col : first_col}};
+        }
 
-                auto const [row_in_partitions, col_in_partitions] = north_partition_idxs;
-                auto key = std::make_tuple(row_in_partitions, col_in_partitions, ClumpElement{});
 
-                for (Index idx = north_idx; idx < nr_cols; ++idx)
-                {
-                    if (!indp.is_no_data(clump_data[idx]) && clump_data[idx] == boundary_clump_id)
-                    {
-                        auto const local_clump_id{north_clump_ids[idx]};
-                        global_clump_ids[global_clump_ids_idx].insert(
-                            north_local_result.global_clump_id(local_clump_id));
+        /*!
+            @brief      Return the pairs of local clumps, along a border between neighbouring
+                        partitions, that are part of the same global clump
+            @param      partition_idxs Linear indices of the partitions sharing the border
+            @param      zone_slices Per partition, the zones of the cells along the border
+            @param      clump_slices Per partition, the local clump IDs of the cells along the border
+
+            The cells along the border are laid out in two rows, by concatenating the slices. In
+            case of a side, each row contains the cells of one partition. Columns are "rotated"
+            into rows, keeping the cells in each side consecutive in memory. In case of a corner,
+            the four corner cells end up in row-major order.
+        */
+        template<typename Policies, typename Data>
+        auto slice_edges(
+            Policies const& policies,
+            BorderKind const kind,
+            std::vector<Index> const& partition_idxs,
+            std::vector<Data> const& zone_slices,
+            std::vector<Data> const& clump_slices,
+            Connectivity const connectivity) -> ClumpEdges<ElementT<Data>>
+        {
+            using ClumpElement = ElementT<Data>;
 
-                        std::get<2>(key) = local_clump_id;
+            lue_hpx_assert(zone_slices.size() == partition_idxs.size());
+            lue_hpx_assert(clump_slices.size() == partition_idxs.size());
 
-                        if (auto it = global_clump_ids_by_local_clump_id.find(key);
-                            it == global_clump_ids_by_local_clump_id.end())
-                        {
-                            global_clump_ids_by_local_clump_id[key] = global_clump_ids_idx;
-                        }
-                    }
-                }
-            }
+            Count nr_elements{0};
 
+            for (Data const& zone_slice : zone_slices)
             {
-                // Same thing, for the south row.
+                nr_elements += lue::nr_elements(zone_slice);
+            }
 
-                auto const [row_in_partitions, col_in_partitions] = south_partition_idxs;
-                auto key = std::make_tuple(row_in_partitions, col_in_partitions, ClumpElement{});
+            lue_hpx_assert(nr_elements % 2 == 0);
 
-                for (Index idx = south_idx; idx < nr_cols; ++idx)
-                {
-                    if (!indp.is_no_data(clump_data[nr_cols + idx]) &&
-                        clump_data[nr_cols + idx] == boundary_clump_id)
-                    {
-                        auto const local_clump_id{south_clump_ids[idx]};
-                        global_clump_ids[global_clump_ids_idx].insert(
-                            south_local_result.global_clump_id(local_clump_id));
+            Data zone_data{{2, nr_elements / 2}};
+            auto zone_data_it = zone_data.begin();
 
-                        std::get<2>(key) = local_clump_id;
+            std::vector<LocalClump<ClumpElement>> local_clumps{};
+            local_clumps.reserve(static_cast<std::size_t>(nr_elements));
 
-                        if (auto it = global_clump_ids_by_local_clump_id.find(key);
-                            it == global_clump_ids_by_local_clump_id.end())
-                        {
-                            global_clump_ids_by_local_clump_id[key] = global_clump_ids_idx;
-                        }
-                    }
+            for (std::size_t idx = 0; idx < partition_idxs.size(); ++idx)
+            {
+                lue_hpx_assert(lue::nr_elements(clump_slices[idx]) == lue::nr_elements(zone_slices[idx]));
+
+                zone_data_it = std::copy(zone_slices[idx].begin(), zone_slices[idx].end(), zone_data_it);
+
+                for (ClumpElement const local_clump_id : clump_slices[idx])
+                {
+                    local_clumps.emplace_back(partition_idxs[idx], local_clump_id);
                 }
             }
+
+            // In case of a side, no need to start flood fills from the second row: cells not
+            // connected to the first row are not connected to the other partition
+            return border_edges(
+                policies, zone_data, local_clumps, kind == BorderKind::corner ? 2 : 1, connectivity);
         }
 
 
-        template<class Lhs, class Rhs>
-        auto share_element(Lhs const& lhs, Rhs const& rhs) -> bool
+        /*!
+            @brief      Return a smaller collection of pairs of local clumps, connecting the same
+                        local clumps as @a edges
+
+            The local clumps occurring in @a edges are merged in a union-find. Each of them that
+            does not end up as the root of its set is paired with this root. The result contains
+            less edges than the number of local clumps occurring in @a edges, however many edges
+            connect them.
+        */
+        template<typename ClumpElement>
+        auto reduce_edges(ClumpEdges<ClumpElement> const& edges) -> ClumpEdges<ClumpElement>
         {
-            if (lhs.empty() || rhs.empty())
+            std::vector<LocalClump<ClumpElement>> local_clumps{};
+            local_clumps.reserve(2 * edges.size());
+
+            for (auto const& [local_clump1, local_clump2] : edges)
             {
-                return false;
+                local_clumps.push_back(local_clump1);
+                local_clumps.push_back(local_clump2);
             }
 
-            if (lhs.size() * 100 < rhs.size())
+            std::sort(local_clumps.begin(), local_clumps.end());
+            local_clumps.erase(std::unique(local_clumps.begin(), local_clumps.end()), local_clumps.end());
+
+            auto const position = [&local_clumps](LocalClump<ClumpElement> const& local_clump) -> Index
             {
-                for (auto&& x : lhs)
-                {
-                    if (rhs.find(x) != rhs.end())
-                    {
-                        return true;
-                    }
-                }
-                return false;
+                return std::distance(
+                    local_clumps.begin(),
+                    std::lower_bound(local_clumps.begin(), local_clumps.end(), local_clump));
+            };
+
+            UnionFind<Index> clumps{local_clumps.size()};
+
+            for (auto const& [local_clump1, local_clump2] : edges)
+            {
+                clumps.unite(position(local_clump1), position(local_clump2));
             }
 
-            if (rhs.size() * 100 < lhs.size())
+            ClumpEdges<ClumpElement> reduced_edges{};
+
+            for (Index idx = 0; idx < static_cast<Index>(local_clumps.size()); ++idx)
             {
-                for (auto&& x : rhs)
+                Index const root_idx{clumps.find(idx)};
+
+                if (root_idx != idx)
                 {
-                    if (lhs.find(x) != lhs.end())
-                    {
-                        return true;
-                    }
+                    reduced_edges.emplace_back(
+                        local_clumps[static_cast<std::size_t>(root_idx)],
+                        local_clumps[static_cast<std::size_t>(idx)]);
                 }
-                return false;
             }
 
-            using std::begin;
-            using std::end;
+            return reduced_edges;
+        }
+
+
+        /*!
+            @brief      Return the pairs of local clumps, along the borders assigned to this locality,
+                        that are part of the same global clump
+            @param      borders Borders of which the first partition is located in this locality
+
+            Only the cells along the borders are copied from the partitions, some of which may be
+            located in other localities. The pairs found along all borders are reduced before they
+            are returned.
+        */
+        template<typename Policies, typename Partition>
+        auto locality_border_edges(
+            Policies const& policies,
+            std::vector<Border<Partition>> const& borders,
+            Connectivity const connectivity) -> hpx::future<ClumpEdges<ElementT<Partition>>>
+        {
+            using ClumpElement = ElementT<Partition>;
+            using Data = DataT<Partition>;
 
-            auto lit = begin(lhs);
-            auto lend = end(lhs);
+            auto const slice = [](Partition const& partition, SlicesT<Partition> const& slices)
+                -> hpx::future<Data>
+            {
+                return hpx::dataflow(
+                    hpx::launch::async,
+                    [slices](Partition const& ready_partition) -> Data
+                    { return ready_partition.slice(hpx::launch::sync, slices); },
+                    partition);
+            };
 
-            auto rit = begin(rhs);
-            auto rend = end(rhs);
+            std::vector<hpx::future<ClumpEdges<ClumpElement>>> edges_fs{};
+            edges_fs.reserve(borders.size());
 
-            while (lit != lend && rit != rend)
+            for (auto const& border : borders)
             {
-                if (*lit < *rit)
-                {
-                    lit = lhs.lower_bound(*rit);
-                    continue;
-                }
+                BorderKind const kind{std::get<0>(border)};
+                auto const& border_partitions{std::get<1>(border)};
 
-                if (*rit < *lit)
+                std::vector<Index> partition_idxs{};
+                std::vector<hpx::future<Data>> zone_slice_fs{};
+                std::vector<hpx::future<Data>> clump_slice_fs{};
+
+                for (std::size_t idx = 0; idx < border_partitions.size(); ++idx)
                 {
-                    rit = rhs.lower_bound(*lit);
-                    continue;
+                    auto const& [partition_idx, shape, zone_partition, clump_partition] =
+                        border_partitions[idx];
+                    auto const slices{border_slices<Partition>(kind, idx, shape)};
+
+                    partition_idxs.push_back(partition_idx);
+                    zone_slice_fs.push_back(slice(zone_partition, slices));
+                    clump_slice_fs.push_back(slice(clump_partition, slices));
                 }
 
-                return true;
+                edges_fs.push_back(hpx::dataflow(
+                    hpx::launch::async,
+                    hpx::unwrapping(
+
+                        [policies, kind, partition_idxs = std::move(partition_idxs), connectivity](
+                            std::vector<hpx::future<Data>> zone_slice_fs,
+                            std::vector<hpx::future<Data>> clump_slice_fs) -> ClumpEdges<ClumpElement>
+                        {
+                            AnnotateFunction const annotation{"clump: border"};
+
+                            std::vector<Data> zone_slices{};
+                            std::vector<Data> clump_slices{};
+
+                            for (std::size_t idx = 0; idx < partition_idxs.size(); ++idx)
+                            {
+                                zone_slices.push_back(zone_slice_fs[idx].get());
+                                clump_slices.push_back(clump_slice_fs[idx].get());
+                            }
+
+                            return slice_edges(
+                                policies, kind, partition_idxs, zone_slices, clump_slices, connectivity);
+                        }
+
+                        ),
+                    hpx::when_all(std::move(zone_slice_fs)),
+                    hpx::when_all(std::move(clump_slice_fs))));
             }
 
-            return false;
+            return hpx::when_all(std::move(edges_fs))
+                .then(hpx::unwrapping(
+
+                    [](std::vector<hpx::future<ClumpEdges<ClumpElement>>> edges_fs)
+                        -> ClumpEdges<ClumpElement>
+                    {
+                        AnnotateFunction const annotation{"clump: locality: reduce edges"};
+
+                        ClumpEdges<ClumpElement> edges{};
+
+                        for (auto& edges_f : edges_fs)
+                        {
+                            ClumpEdges<ClumpElement> const border_edges{edges_f.get()};
+
+                            edges.insert(edges.end(), border_edges.begin(), border_edges.end());
+                        }
+
+                        return reduce_edges(edges);
+                    }
+
+                    ));
         }
 
 
         template<typename Policies, typename Partition>
+        struct LocalityBorderEdgesAction:
+            hpx::actions::make_action<
+                decltype(&locality_border_edges<Policies, Partition>),
+                &locality_border_edges<Policies, Partition>,
+                LocalityBorderEdgesAction<Policies, Partition>>::type
+        {
+        };
+
+
+        /*!
+            @brief      Determine the global clump IDs of the local clumps in all partitions
+
+            Each border between neighbouring partitions is assigned to the locality of its first
+            partition. Per locality, the pairs of local clumps that are part of the same global
+            clump are determined per border, concurrently, and reduced using a union-find over
+            the local clumps involved. Only the cells along the borders are copied between
+            localities, and only the reduced pairs and the number of local clumps per partition
+            are sent to the root locality.
+
+            Each local clump gets a consecutive initial global clump ID. Merging the pairs of all
+            localities in a union-find results in sets of initial global clump IDs that form the
+            same global clump. The smallest ID in each set becomes the global clump ID.
+        */
+        template<typename Policies, Rank rank>
         auto determine_reclass_tables(
             Policies const& policies,
-            LocalResultFs<Partition>&& local_result_fs,
-            Connectivity const connectivity) -> LocalResultsF<Partition>
+            PartitionedArray<policy::InputElementT<Policies, 0>, rank> const& zone,
+            LocalResultFs<PartitionT<PartitionedArray<policy::OutputElementT<Policies, 0>, rank>>>&&
+                local_result_fs,
+            Connectivity const connectivity)
+            -> LocalResultsF<PartitionT<PartitionedArray<policy::OutputElementT<Policies, 0>, rank>>>
         {
-            using ZoneData = typename LocalResult<Partition>::ZoneData;
-            using ClumpData = typename LocalResult<Partition>::ClumpData;
-            using ClumpElement = typename LocalResult<Partition>::ClumpElement;
+            using Partition = PartitionT<PartitionedArray<policy::OutputElementT<Policies, 0>, rank>>;
+            using LocalResult = LocalResult<Partition>;
+            using ClumpElement = typename LocalResult::ClumpElement;
+            using LocalResultSF = hpx::shared_future<LocalResult>;
+            using BorderPartitionIdxs = std::tuple<BorderKind, std::vector<Index>>;
 
-            return hpx::when_all(local_result_fs.begin(), local_result_fs.end())
-                .then(
-                    hpx::unwrapping(
-                        [policies, shape_in_partitions = local_result_fs.shape(), connectivity](
-                            auto&& local_result_fs) -> LocalResults<Partition>
-                        {
-                            AnnotateFunction const annotation{"clump: array: determine_reclass_tables"};
-                            auto const& indp = std::get<0>(policies.inputs_policies()).input_no_data_policy();
-                            auto const& ondp =
-                                std::get<0>(policies.outputs_policies()).output_no_data_policy();
+            Localities<rank> const& localities{zone.localities()};
+            auto const& zone_partitions{zone.partitions()};
+            auto const shape_in_partitions{local_result_fs.shape()};
+            auto const [nr_rows_in_partitions, nr_cols_in_partitions] = shape_in_partitions;
+            Count const nr_partitions{nr_elements(shape_in_partitions)};
 
-                            LocalResults<Partition> local_results{shape_in_partitions};
-                            Count max_nr_global_ids{0};  // Actual nr is likely smaller
-                            Count const nr_partitions{nr_elements(shape_in_partitions)};
+            Array<LocalResultSF, rank> local_result_sfs{shape_in_partitions};
 
-                            // Initialize LUT per partition and result collection of local results
-                            for (Index partition_idx = 0; partition_idx < nr_partitions; ++partition_idx)
-                            {
-                                local_results[partition_idx] = local_result_fs[partition_idx].get();
-                                max_nr_global_ids += local_results[partition_idx].reclassify_global_clump_ids(
-                                    max_nr_global_ids);
-                            }
+            for (Index partition_idx = 0; partition_idx < nr_partitions; ++partition_idx)
+            {
+                local_result_sfs[partition_idx] = local_result_fs[partition_idx].share();
+            }
+
+            // Per locality, the borders whose first partition is located in it
+            std::map<hpx::id_type, std::vector<BorderPartitionIdxs>> borders_by_locality{};
 
-                            // Current global clump IDs from different partitions that share the
-                            // same final global clumps
-                            std::vector<std::set<ClumpElement>> global_clump_ids{};
+            auto const add_border = [&](BorderKind const kind, std::vector<Index>&& partition_idxs)
+            {
+                borders_by_locality[localities[partition_idxs.front()]].emplace_back(
+                    kind, std::move(partition_idxs));
+            };
 
-                            // Per local clump in a partition the location of the collection of
-                            // current global clump IDs that must be merged
-                            std::map<std::tuple<Index, Index, ClumpElement>, Index>
-                                global_clump_ids_by_local_clump_id{};
+            for (Index row_idx = 0; row_idx < nr_rows_in_partitions; ++row_idx)
+            {
+                for (Index col_idx = 0; col_idx < nr_cols_in_partitions; ++col_idx)
+                {
+                    Index const partition_idx{row_idx * nr_cols_in_partitions + col_idx};
 
-                            // Determine clump IDs for cells in neighbouring partition borderѕ
-                            auto const [nr_rows_in_partitions, nr_cols_in_partitions] = local_results.shape();
+                    if (row_idx < nr_rows_in_partitions - 1)
+                    {
+                        add_border(
+                            BorderKind::horizontal, {partition_idx, partition_idx + nr_cols_in_partitions});
+                    }
 
-                            for (Index row_in_partitions = 0; row_in_partitions < nr_rows_in_partitions;
-                                 ++row_in_partitions)
-                            {
-                                for (Index col_in_partitions = 0; col_in_partitions < nr_cols_in_partitions;
-                                     ++col_in_partitions)
-                                {
-                                    if (row_in_partitions < nr_rows_in_partitions - 1)
-                                    {
-                                        // Horizontal border
-                                        auto& north_local_result{
-                                            local_results(row_in_partitions, col_in_partitions)};
-                                        auto& south_local_result{
-                                            local_results(row_in_partitions + 1, col_in_partitions)};
-
-                                        // Yes, the south side of the north partition is the north side
-                                        // of the array we build here, etc
-                                        auto const& [north_zone_ids, north_clump_ids] =
-                                            north_local_result.south_side();
-                                        auto const& [south_zone_ids, south_clump_ids] =
-                                            south_local_result.north_side();
-
-                                        lue_hpx_assert(north_zone_ids.get().shape()[0] == 1);
-                                        lue_hpx_assert(south_zone_ids.get().shape()[0] == 1);
-                                        lue_hpx_assert(
-                                            north_zone_ids.get().shape()[1] ==
-                                            south_zone_ids.get().shape()[1]);
-
-                                        ZoneData zone_data{{2, north_zone_ids.get().shape()[1]}};
-                                        auto const [nr_rows, nr_cols] = zone_data.shape();
-
-                                        std::copy(
-                                            north_zone_ids.get().begin(),
-                                            north_zone_ids.get().end(),
-                                            zone_data.begin());
-                                        std::copy(
-                                            south_zone_ids.get().begin(),
-                                            south_zone_ids.get().end(),
-                                            zone_data.begin() + nr_cols);
-
-                                        ClumpElement clump_nd{};
-                                        ondp.mark_no_data(clump_nd);
-                                        ClumpData clump_data{zone_data.shape(), clump_nd};
-
-                                        {
-                                            ClumpElement clump_id{0};
-                                            Count const row = 0;  // No need to iterate over south row as well
-
-                                            for (Count col = 0; col < nr_cols; ++col)
-                                            {
-                                                // Skip cells that do not contain a valid zone ID, or that
-                                                // already contain a valid clump ID
-                                                if ((!indp.is_no_data(zone_data, row, col)) &&
-                                                    ondp.is_no_data(clump_data, row, col))
-                                                {
-                                                    flood_fill(
-                                                        indp,
-                                                        ondp,
-                                                        zone_data,
-                                                        {row, col},
-                                                        clump_data,
-                                                        clump_id,
-                                                        connectivity);
-                                                    ++clump_id;
-                                                }
-                                            }
-                                        }
-
-                                        // Find indxs of cells on both sides of the partition
-                                        // boundary that belong to the same clump.
-                                        // For each of those indxs, add information about the
-                                        // partition_idx, local_clump_id, global_clump_id to a
-                                        // collection, if not already present. Aggregate information
-                                        // about the same clump.
-
-                                        std::unordered_set<ClumpElement> clump_handled{};
-
-                                        for (Index north_idx = 0; north_idx < nr_cols; ++north_idx)
-                                        {
-                                            if (!indp.is_no_data(clump_data[north_idx]) &&
-                                                !clump_handled.contains(clump_data[north_idx]))
-                                            {
-                                                auto const boundary_clump_id{clump_data[north_idx]};
-
-                                                Index const south_idx = std::distance(
-                                                    clump_data.begin() + nr_cols,
-                                                    std::find(
-                                                        clump_data.begin() + nr_cols,
-                                                        clump_data.end(),
-                                                        boundary_clump_id));
-
-                                                if (south_idx != nr_cols)
-                                                {
-                                                    // Clump extends on both sides of the partition boundary
-                                                    merge_clump(
-                                                        indp,
-                                                        {row_in_partitions, col_in_partitions},
-                                                        north_clump_ids.get(),
-                                                        north_idx,
-                                                        north_local_result,
-                                                        {row_in_partitions + 1, col_in_partitions},
-                                                        south_clump_ids.get(),
-                                                        south_idx,
-                                                        south_local_result,
-                                                        clump_data,
-                                                        global_clump_ids_by_local_clump_id,
-                                                        global_clump_ids);
-                                                }
-
-                                                clump_handled.insert(boundary_clump_id);
-                                            }
-                                        }
-                                    }
-
-                                    if (col_in_partitions < nr_cols_in_partitions - 1)
-                                    {
-                                        // Vertical border
-                                        auto& west_local_result{
-                                            local_results(row_in_partitions, col_in_partitions)};
-                                        auto& east_local_result{
-                                            local_results(row_in_partitions, col_in_partitions + 1)};
-
-                                        // Yes, the east side of the west partition is the west side
-                                        // of the array we build here, etc
-                                        auto const& [west_zone_ids, west_clump_ids] =
-                                            west_local_result.east_side();
-                                        auto const& [east_zone_ids, east_clump_ids] =
-                                            east_local_result.west_side();
-
-                                        lue_hpx_assert(
-                                            west_zone_ids.get().shape()[0] == east_zone_ids.get().shape()[0]);
-                                        lue_hpx_assert(west_zone_ids.get().shape()[1] == 1);
-                                        lue_hpx_assert(east_zone_ids.get().shape()[1] == 1);
-
-                                        // To keep cells in the west and east columns consecutive
-                                        // in memory, we "rotate" the sides: the upper row will contain
-                                        // the west cells, the bottom row the east cells. A cell
-                                        // at index idx in these rows correspond with a cell at row
-                                        // idx in the original side array.
-
-                                        ZoneData zone_data{{2, west_zone_ids.get().shape()[0]}};
-                                        auto const [nr_rows, nr_cols] = zone_data.shape();
-
-                                        // Rotate each column 45 degrees counter-clock-wise:
-                                        // - west column becomes north row, east column becomes south row
-                                        // - first row in column becomes firs column in row
-                                        std::copy(
-                                            west_zone_ids.get().begin(),
-                                            west_zone_ids.get().end(),
-                                            zone_data.begin());
-                                        std::copy(
-                                            east_zone_ids.get().begin(),
-                                            east_zone_ids.get().end(),
-                                            zone_data.begin() + nr_cols);
-
-                                        ClumpElement clump_nd{};
-                                        ondp.mark_no_data(clump_nd);
-                                        ClumpData clump_data{zone_data.shape(), clump_nd};
-
-                                        {
-                                            ClumpElement clump_id{0};
-                                            Count const row = 0;  // No need to iterate over east row as well
-
-                                            for (Count col = 0; col < nr_cols; ++col)
-                                            {
-                                                // Skip cells that do not contain a valid zone ID, or that
-                                                // already contain a valid clump ID
-                                                if ((!indp.is_no_data(zone_data, row, col)) &&
-                                                    ondp.is_no_data(clump_data, row, col))
-                                                {
-                                                    flood_fill(
-                                                        indp,
-                                                        ondp,
-                                                        zone_data,
-                                                        {row, col},
-                                                        clump_data,
-                                                        clump_id,
-                                                        connectivity);
-                                                    ++clump_id;
-                                                }
-                                            }
-                                        }
-
-                                        // Find indxs of cells on both sides of the partition
-                                        // boundary that belong to the same clump.
-                                        // For each of those indxs, add information about the
-                                        // partition_idx, local_clump_id, global_clump_id to a
-                                        // collection, if not already present. Aggregate information
-                                        // about the same clump.
-
-                                        std::unordered_set<ClumpElement> clump_handled{};
-
-                                        for (Index west_idx = 0; west_idx < nr_cols; ++west_idx)
-                                        {
-                                            if (!indp.is_no_data(clump_data[west_idx]) &&
-                                                !clump_handled.contains(clump_data[west_idx]))
-                                            {
-                                                auto const boundary_clump_id{clump_data[west_idx]};
-
-                                                Index const east_idx = std::distance(
-                                                    clump_data.begin() + nr_cols,
-                                                    std::find(
-                                                        clump_data.begin() + nr_cols,
-                                                        clump_data.end(),
-                                                        boundary_clump_id));
-
-                                                if (east_idx != nr_cols)
-                                                {
-                                                    // Clump extends on both sides of the partition boundary
-                                                    merge_clump(
-                                                        indp,
-                                                        {row_in_partitions, col_in_partitions},
-                                                        west_clump_ids.get(),
-                                                        west_idx,
-                                                        west_local_result,
-                                                        {row_in_partitions, col_in_partitions + 1},
-                                                        east_clump_ids.get(),
-                                                        east_idx,
-                                                        east_local_result,
-                                                        clump_data,
-                                                        global_clump_ids_by_local_clump_id,
-                                                        global_clump_ids);
-                                                }
-
-                                                clump_handled.insert(boundary_clump_id);
-                                            }
-                                        }
-                                    }
-
-                                    if (connectivity == Connectivity::diagonal)
-                                    {
-                                        if (row_in_partitions < nr_rows_in_partitions - 1 &&
-                                            col_in_partitions < nr_cols_in_partitions - 1)
-                                        {
-                                            auto& north_west_local_result{
-                                                local_results(row_in_partitions, col_in_partitions)};
-                                            auto& north_east_local_result{
-                                                local_results(row_in_partitions, col_in_partitions + 1)};
-                                            auto& south_west_local_result{
-                                                local_results(row_in_partitions + 1, col_in_partitions)};
-                                            auto& south_east_local_result{
-                                                local_results(row_in_partitions + 1, col_in_partitions + 1)};
-
-                                            auto const& [north_west_zone_id, north_west_local_clump_id] =
-                                                north_west_local_result.south_east_corner();
-                                            auto const& [north_east_zone_id, north_east_local_clump_id] =
-                                                north_east_local_result.south_west_corner();
-                                            auto const& [south_west_zone_id, south_west_local_clump_id] =
-                                                south_west_local_result.north_east_corner();
-                                            auto const& [south_east_zone_id, south_east_local_clump_id] =
-                                                south_east_local_result.north_west_corner();
-
-                                            ZoneData zone_data{{2, 2}};
-                                            auto const [nr_rows, nr_cols] = zone_data.shape();
-
-                                            Index const north_west_idx{0};
-                                            Index const north_east_idx{1};
-                                            Index const south_west_idx{2};
-                                            Index const south_east_idx{3};
-
-                                            zone_data[north_west_idx] = north_west_zone_id;
-                                            zone_data[north_east_idx] = north_east_zone_id;
-                                            zone_data[south_west_idx] = south_west_zone_id;
-                                            zone_data[south_east_idx] = south_east_zone_id;
-
-                                            ClumpElement clump_nd{};
-                                            ondp.mark_no_data(clump_nd);
-                                            ClumpData clump_data{zone_data.shape(), clump_nd};
-
-                                            {
-                                                ClumpElement clump_id{0};
-
-                                                for (Count row = 0; row < nr_rows; ++row)
-                                                {
-                                                    for (Count col = 0; col < nr_cols; ++col)
-                                                    {
-                                                        // Skip cells that do not contain a valid zone ID, or
-                                                        // that already contain a valid clump ID
-                                                        if ((!indp.is_no_data(zone_data, row, col)) &&
-                                                            ondp.is_no_data(clump_data, row, col))
-                                                        {
-                                                            flood_fill(
-                                                                indp,
-                                                                ondp,
-                                                                zone_data,
-                                                                {row, col},
-                                                                clump_data,
-                                                                clump_id,
-                                                                connectivity);
-                                                            ++clump_id;
-                                                        }
-                                                    }
-                                                }
-                                            }
-
-                                            // We only need to check whether clumps extend in diagonal
-                                            // direction. Other direction is handled above already.
-
-                                            if (!indp.is_no_data(clump_data[north_west_idx]) &&
-                                                !indp.is_no_data(clump_data[south_east_idx]) &&
-                                                clump_data[north_west_idx] == clump_data[south_east_idx])
-                                            {
-                                                // Clump extends in north-west / south-east direction
-                                                auto const north_west_key = std::make_tuple(
-                                                    row_in_partitions,
-                                                    col_in_partitions,
-                                                    north_west_local_clump_id);
-                                                auto const south_east_key = std::make_tuple(
-                                                    row_in_partitions + 1,
-                                                    col_in_partitions + 1,
-                                                    south_east_local_clump_id);
-
-                                                auto const north_west_it =
-                                                    global_clump_ids_by_local_clump_id.find(north_west_key);
-                                                auto const south_east_it =
-                                                    global_clump_ids_by_local_clump_id.find(south_east_key);
-
-                                                Index north_west_global_clump_ids_idx{-1};
-                                                Index south_east_global_clump_ids_idx{-1};
-
-                                                if (north_west_it != global_clump_ids_by_local_clump_id.end())
-                                                {
-                                                    north_west_global_clump_ids_idx = north_west_it->second;
-
-                                                    if (south_east_it ==
-                                                        global_clump_ids_by_local_clump_id.end())
-                                                    {
-                                                        // north_west_it != end && south_east_it == end
-                                                        south_east_global_clump_ids_idx =
-                                                            north_west_global_clump_ids_idx;
-                                                        global_clump_ids_by_local_clump_id[south_east_key] =
-                                                            south_east_global_clump_ids_idx;
-                                                    }
-                                                    else
-                                                    {
-                                                        south_east_global_clump_ids_idx =
-                                                            south_east_it->second;
-                                                    }
-                                                }
-                                                else if (
-                                                    south_east_it != global_clump_ids_by_local_clump_id.end())
-                                                {
-                                                    // north_west_it == end && south_east_it != end
-                                                    south_east_global_clump_ids_idx = south_east_it->second;
-                                                    north_west_global_clump_ids_idx =
-                                                        south_east_global_clump_ids_idx;
-                                                    global_clump_ids_by_local_clump_id[north_west_key] =
-                                                        north_west_global_clump_ids_idx;
-                                                }
-                                                else
-                                                {
-                                                    // north_west_it == end && south_east_it == end
-                                                    global_clump_ids.push_back({});
-                                                    north_west_global_clump_ids_idx =
-                                                        global_clump_ids.size() - 1;
-                                                    south_east_global_clump_ids_idx =
-                                                        north_west_global_clump_ids_idx;
-                                                    global_clump_ids_by_local_clump_id[north_west_key] =
-                                                        north_west_global_clump_ids_idx;
-                                                    global_clump_ids_by_local_clump_id[south_east_key] =
-                                                        south_east_global_clump_ids_idx;
-                                                }
-
-                                                lue_hpx_assert(north_west_global_clump_ids_idx >= 0);
-                                                lue_hpx_assert(south_east_global_clump_ids_idx >= 0);
-
-                                                global_clump_ids[north_west_global_clump_ids_idx].insert(
-                                                    north_west_local_result.global_clump_id(
-                                                        north_west_local_clump_id));
-                                                global_clump_ids[north_west_global_clump_ids_idx].insert(
-                                                    south_east_local_result.global_clump_id(
-                                                        south_east_local_clump_id));
-
-                                                global_clump_ids[south_east_global_clump_ids_idx].insert(
-                                                    north_west_local_result.global_clump_id(
-                                                        north_west_local_clump_id));
-                                                global_clump_ids[south_east_global_clump_ids_idx].insert(
-                                                    south_east_local_result.global_clump_id(
-                                                        south_east_local_clump_id));
-
-                                                lue_hpx_assert(
-                                                    std::find(
-                                                        global_clump_ids[north_west_global_clump_ids_idx]
-                                                            .begin(),
-                                                        global_clump_ids[north_west_global_clump_ids_idx]
-                                                            .end(),
-                                                        north_west_local_result.global_clump_id(
-                                                            north_west_local_clump_id)) !=
-                                                    global_clump_ids[north_west_global_clump_ids_idx].end());
-                                                lue_hpx_assert(
-                                                    std::find(
-                                                        global_clump_ids[south_east_global_clump_ids_idx]
-                                                            .begin(),
-                                                        global_clump_ids[south_east_global_clump_ids_idx]
-                                                            .end(),
-                                                        south_east_local_result.global_clump_id(
-                                                            south_east_local_clump_id)) !=
-                                                    global_clump_ids[south_east_global_clump_ids_idx].end());
-
-                                                lue_hpx_assert(
-                                                    global_clump_ids_by_local_clump_id.find(north_west_key) !=
-                                                    global_clump_ids_by_local_clump_id.end());
-                                                lue_hpx_assert(
-                                                    global_clump_ids_by_local_clump_id.find(south_east_key) !=
-                                                    global_clump_ids_by_local_clump_id.end());
-                                            }
-
-                                            if (!indp.is_no_data(clump_data[north_east_idx]) &&
-                                                !indp.is_no_data(clump_data[south_west_idx]) &&
-                                                clump_data[north_east_idx] == clump_data[south_west_idx])
-                                            {
-                                                // Clump extends in north-west / south-east direction
-                                                auto const north_east_key = std::make_tuple(
-                                                    row_in_partitions,
-                                                    col_in_partitions + 1,
-                                                    north_east_local_clump_id);
-                                                auto const south_west_key = std::make_tuple(
-                                                    row_in_partitions + 1,
-                                                    col_in_partitions,
-                                                    south_west_local_clump_id);
-
-                                                auto const north_east_it =
-                                                    global_clump_ids_by_local_clump_id.find(north_east_key);
-                                                auto const south_west_it =
-                                                    global_clump_ids_by_local_clump_id.find(south_west_key);
-
-                                                Index north_east_global_clump_ids_idx{-1};
-                                                Index south_west_global_clump_ids_idx{-1};
-
-                                                if (north_east_it != global_clump_ids_by_local_clump_id.end())
-                                                {
-                                                    north_east_global_clump_ids_idx = north_east_it->second;
-
-                                                    if (south_west_it ==
-                                                        global_clump_ids_by_local_clump_id.end())
-                                                    {
-                                                        // north_east_it != end && south_west_it == end
-                                                        south_west_global_clump_ids_idx =
-                                                            north_east_global_clump_ids_idx;
-                                                        global_clump_ids_by_local_clump_id[south_west_key] =
-                                                            south_west_global_clump_ids_idx;
-                                                    }
-                                                    else
-                                                    {
-                                                        south_west_global_clump_ids_idx =
-                                                            south_west_it->second;
-                                                    }
-                                                }
-                                                else if (
-                                                    south_west_it != global_clump_ids_by_local_clump_id.end())
-                                                {
-                                                    // north_east_it == end && south_west_it != end
-                                                    south_west_global_clump_ids_idx = south_west_it->second;
-                                                    north_east_global_clump_ids_idx =
-                                                        south_west_global_clump_ids_idx;
-                                                    global_clump_ids_by_local_clump_id[north_east_key] =
-                                                        north_east_global_clump_ids_idx;
-                                                }
-                                                else
-                                                {
-                                                    // north_east_it == end && south_west_it == end
-                                                    global_clump_ids.push_back({});
-                                                    north_east_global_clump_ids_idx =
-                                                        global_clump_ids.size() - 1;
-                                                    south_west_global_clump_ids_idx =
-                                                        north_east_global_clump_ids_idx;
-                                                    global_clump_ids_by_local_clump_id[north_east_key] =
-                                                        north_east_global_clump_ids_idx;
-                                                    global_clump_ids_by_local_clump_id[south_west_key] =
-                                                        south_west_global_clump_ids_idx;
-                                                }
-
-                                                lue_hpx_assert(north_east_global_clump_ids_idx >= 0);
-                                                lue_hpx_assert(south_west_global_clump_ids_idx >= 0);
-
-                                                global_clump_ids[north_east_global_clump_ids_idx].insert(
-                                                    north_east_local_result.global_clump_id(
-                                                        north_east_local_clump_id));
-                                                global_clump_ids[north_east_global_clump_ids_idx].insert(
-                                                    south_west_local_result.global_clump_id(
-                                                        south_west_local_clump_id));
-
-                                                global_clump_ids[south_west_global_clump_ids_idx].insert(
-                                                    north_east_local_result.global_clump_id(
-                                                        north_east_local_clump_id));
-                                                global_clump_ids[south_west_global_clump_ids_idx].insert(
-                                                    south_west_local_result.global_clump_id(
-                                                        south_west_local_clump_id));
-
-                                                lue_hpx_assert(
-                                                    std::find(
-                                                        global_clump_ids[north_east_global_clump_ids_idx]
-                                                            .begin(),
-                                                        global_clump_ids[north_east_global_clump_ids_idx]
-                                                            .end(),
-                                                        north_east_local_result.global_clump_id(
-                                                            north_east_local_clump_id)) !=
-                                                    global_clump_ids[north_east_global_clump_ids_idx].end());
-                                                lue_hpx_assert(
-                                                    std::find(
-                                                        global_clump_ids[south_west_global_clump_ids_idx]
-                                                            .begin(),
-                                                        global_clump_ids[south_west_global_clump_ids_idx]
-                                                            .end(),
-                                                        south_west_local_result.global_clump_id(
-                                                            south_west_local_clump_id)) !=
-                                                    global_clump_ids[south_west_global_clump_ids_idx].end());
-
-                                                lue_hpx_assert(
-                                                    global_clump_ids_by_local_clump_id.find(north_east_key) !=
-                                                    global_clump_ids_by_local_clump_id.end());
-                                                lue_hpx_assert(
-                                                    global_clump_ids_by_local_clump_id.find(south_west_key) !=
-                                                    global_clump_ids_by_local_clump_id.end());
-                                            }
-                                        }
-                                    }
-                                }
-                            }
+                    if (col_idx < nr_cols_in_partitions - 1)
+                    {
+                        add_border(BorderKind::vertical, {partition_idx, partition_idx + 1});
+                    }
+
+                    if (connectivity == Connectivity::diagonal &&
+                        row_idx < nr_rows_in_partitions - 1 &&
+                        col_idx < nr_cols_in_partitions - 1)
+                    {
+                        // Only the diagonal connections are relevant here, the other ones are
+                        // handled by the sides
+                        add_border(
+                            BorderKind::corner,
+                            {partition_idx,
+                             partition_idx + 1,
+                             partition_idx + nr_cols_in_partitions,
+                             partition_idx + nr_cols_in_partitions + 1});
+                    }
+                }
+            }
 
-                            // Update global clump IDs for those local IDs that must be merged. Use the
-                            // lowest original global clump ID as the final global clump ID. Keep track
-                            // of the global clump IDs that got removed this way. Sort this collection.
+            LocalityBorderEdgesAction<Policies, Partition> action{};
+            std::vector<hpx::future<ClumpEdges<ClumpElement>>> edges_fs{};
+            edges_fs.reserve(borders_by_locality.size());
 
-                            // Iterate over all (partition, local clump ID) tuples and replace the associated
-                            // global clump ID with the lowest global clump ID of the current global clump IDs
-                            // that must be merged.
+            for (auto const& [locality_id, locality_borders] : borders_by_locality)
+            {
+                // The shapes and local clump partitions are filled in once the local results of
+                // the partitions sharing the borders are available
+                std::vector<Border<Partition>> borders{};
+                std::vector<LocalResultSF> border_local_result_sfs{};
 
+                for (auto const& [kind, partition_idxs] : locality_borders)
+                {
+                    std::vector<BorderPartition<Partition>> border_partitions{};
 
-                            // It is possible that global clump IDs have been collected in different
-                            // collections while they should be merged because they actually belong to the
-                            // same global clump. This is the case when the intersection of any two sets is
-                            // not empty. If that is the case, replace both by a single union, and update
-                            // global_clump_ids_by_local_clump_id.
+                    for (Index const partition_idx : partition_idxs)
+                    {
+                        border_partitions.emplace_back(
+                            partition_idx, ShapeT<Partition>{}, zone_partitions[partition_idx], Partition{});
+                        border_local_result_sfs.push_back(local_result_sfs[partition_idx]);
+                    }
 
-                            {
-                                std::unordered_map<Index, Index> global_clump_ids_updates{};
+                    borders.emplace_back(kind, std::move(border_partitions));
+                }
 
-                                std::set<ClumpElement> global_clump_ids_union{};
+                edges_fs.emplace_back(hpx::dataflow(
+                    hpx::launch::async,
+                    hpx::unwrapping(
 
-                                // This loop is the most expensive part of the whole algorithm and it executes
-                                // on the root locality. Not nice. Improve if possible.
+                        [locality_id = locality_id,
+                         action,
+                         policies,
+                         borders = std::move(borders),
+                         connectivity](std::vector<LocalResultSF> const& local_result_sfs) mutable
+                        -> hpx::future<ClumpEdges<ClumpElement>>
+                        {
+                            AnnotateFunction const annotation{"clump: array: call border edges action"};
 
-                                for (std::size_t idx1 = 0; idx1 < std::size(global_clump_ids); ++idx1)
-                                {
-                                    for (std::size_t idx2 = idx1 + 1; idx2 < std::size(global_clump_ids);
-                                         ++idx2)
-                                    {
-                                        auto& global_clump_ids1{global_clump_ids[idx1]};
-                                        auto& global_clump_ids2{global_clump_ids[idx2]};
-
-                                        if (share_element(global_clump_ids1, global_clump_ids2))
-                                        {
-                                            global_clump_ids_union.clear();
-
-                                            std::set_union(
-                                                global_clump_ids1.begin(),
-                                                global_clump_ids1.end(),
-                                                global_clump_ids2.begin(),
-                                                global_clump_ids2.end(),
-                                                std::inserter(
-                                                    global_clump_ids_union, global_clump_ids_union.begin()));
-
-                                            global_clump_ids1 = std::move(global_clump_ids_union);
-                                            global_clump_ids2.clear();
-                                            lue_hpx_assert(
-                                                global_clump_ids_updates.find(idx2) ==
-                                                global_clump_ids_updates.end());
-                                            global_clump_ids_updates[idx2] = idx1;
-                                        }
-                                    }
-                                }
+                            // The local results are ordered like the partitions sharing the borders
+                            auto local_result_sf_it = local_result_sfs.begin();
 
-                                for (auto& [clump_tuple, global_clump_ids_idx] :
-                                     global_clump_ids_by_local_clump_id)
+                            for (auto& border : borders)
+                            {
+                                for (auto& border_partition : std::get<1>(border))
                                 {
-                                    if (auto it = global_clump_ids_updates.find(global_clump_ids_idx);
-                                        it != global_clump_ids_updates.end())
-                                    {
-                                        global_clump_ids_idx = it->second;
-                                    }
+                                    LocalResult const& local_result{(local_result_sf_it++)->get()};
+
+                                    std::get<1>(border_partition) = local_result.shape();
+                                    std::get<3>(border_partition) = local_result.partition();
                                 }
                             }
 
-                            for (auto const& [clump_tuple, global_clump_ids_idx] :
-                                 global_clump_ids_by_local_clump_id)
+                            return hpx::async(action, locality_id, policies, borders, connectivity);
+                        }
+
+                        ),
+                    hpx::when_all(std::move(border_local_result_sfs))));
+            }
+
+            return hpx::dataflow(
+                hpx::launch::async,
+                hpx::unwrapping(
+
+                    [shape_in_partitions, nr_partitions](
+                        std::vector<LocalResultSF> const& local_result_sfs,
+                        std::vector<hpx::future<ClumpEdges<ClumpElement>>> edges_fs)
+                        -> LocalResults<Partition>
+                    {
+                        AnnotateFunction const annotation{"clump: array: determine_reclass_tables"};
+
+                        LocalResults<Partition> local_results{shape_in_partitions};
+                        std::vector<ClumpElement> offsets(static_cast<std::size_t>(nr_partitions));
+                        Count nr_clumps{0};
+
+                        // Assign consecutive initial global clump IDs to the local clumps
+                        for (Index partition_idx = 0; partition_idx < nr_partitions; ++partition_idx)
+                        {
+                            local_results[partition_idx] = local_result_sfs[partition_idx].get();
+                            offsets[partition_idx] = static_cast<ClumpElement>(nr_clumps);
+                            nr_clumps += local_results[partition_idx].nr_clumps();
+                        }
+
+                        UnionFind<ClumpElement> clumps{static_cast<std::size_t>(nr_clumps)};
+
+                        for (auto& edges_f : edges_fs)
+                        {
+                            for (auto const& [local_clump1, local_clump2] : edges_f.get())
                             {
-                                auto const [row, col, local_clump_id] = clump_tuple;
-                                ClumpElement const new_global_clump_id =
-                                    *global_clump_ids[global_clump_ids_idx].begin();
+                                auto const [partition_idx1, local_clump_id1] = local_clump1;
+                                auto const [partition_idx2, local_clump_id2] = local_clump2;
 
-                                local_results(row, col).update_global_clump_id(
-                                    local_clump_id, new_global_clump_id);
+                                clumps.unite(
+                                    offsets[partition_idx1] + local_clump_id1,
+                                    offsets[partition_idx2] + local_clump_id2);
                             }
+                        }
+
+                        for (Index partition_idx = 0; partition_idx < nr_partitions; ++partition_idx)
+                        {
+                            local_results[partition_idx].set_global_clump_ids(offsets[partition_idx], clumps);
+                        }
 
-                            return local_results;
-                        }));
+                        return local_results;
+                    }
+
+                    ),
+                hpx::when_all(local_result_sfs.begin(), local_result_sfs.end()),
+                hpx::when_all(std::move(edges_fs)));
         }
 
 
+        /*!
+            @brief      Replace the local clump IDs in @a clump_partition by global clump IDs
+            @param      offset Value to add to the local clump IDs, in case @a lut is empty
+            @param      lut Per local clump ID, the global clump ID
+        */
         template<typename NoDataPolicy, typename Partition, typename LUT>
-        auto reclass_partition(NoDataPolicy const& ndp, Partition const& clump_partition, LUT const& lut)
-            -> Partition
+        auto reclass_partition(
+            NoDataPolicy const& ndp,
+            Partition const& clump_partition,
+            ElementT<Partition> const offset,
+            LUT const& lut) -> Partition
         {
             AnnotateFunction const annotation{"clump: partition: reclass"};
 
@@ -1864,11 +1423,26 @@ namespace lue {
             auto clump_data = ready_component_ptr(clump_partition)->data();
             auto const nr_elements = lue::nr_elements(clump_data.shape());
 
-            for (Index idx = 0; idx < nr_elements; ++idx)
+            if (lut.empty())
             {
-                if (!ndp.is_no_data(clump_data, idx))
+                for (Index idx = 0; idx < nr_elements; ++idx)
                 {
-                    clump_data[idx] = lut.find(clump_data[idx])->second;
+                    if (!ndp.is_no_data(clump_data, idx))
+                    {
+                        clump_data[idx] += offset;
+                    }
+                }
+            }
+            else
+            {
+                for (Index idx = 0; idx < nr_elements; ++idx)
+                {
+                    if (!ndp.is_no_data(clump_data, idx))
+                    {
+                        lue_hpx_assert(static_cast<std::size_t>(clump_data[idx]) < lut.size());
+
+                        clump_data[idx] = lut[static_cast<std::size_t>(clump_data[idx])];
+                    }
                 }
             }
 
@@ -1923,16 +1497,25 @@ namespace lue {
                         {
                             auto& local_result{local_results[partition_idx]};
                             auto partition{local_result.partition()};
+                            auto const offset{local_result.offset()};
                             auto lut{local_result.lut()};
 
                             lue_hpx_assert(partition.is_ready());
 
+                            if (offset == 0 && lut.empty())
+                            {
+                                // Local clump IDs are global clump IDs already
+                                clump_partition_promises[partition_idx].set_value(partition.get_id());
+                                continue;
+                            }
+
                             clump_partition_promises[partition_idx].set_value(
                                 Partition{hpx::async(
                                               action,
                                               hpx::get_colocation_id(hpx::launch::sync, partition.get_id()),
                                               ondp,
                                               std::move(partition),
+                                              offset,
                                               std::move(lut))}
                                     .get_id());
                         }
@@ -1961,7 +1544,7 @@ namespace lue {
 
         auto local_result_fs = detail::clump::solve_clump_locally(policies, zone, connectivity);
         auto local_results_f =
-            detail::clump::determine_reclass_tables(policies, std::move(local_result_fs), connectivity);
+            detail::clump::determine_reclass_tables(policies, zone, std::move(local_result_fs), connectivity);
         auto clump_partitions = detail::clump::solve_clump_globally<Policies, ClumpPartitions>(
             policies, zone.partitions().shape(), std::move(local_results_f));
 
@@ -1,6 +1,8 @@
 #pragma once
 #include "lue/framework/algorithm/convolve.hpp"
 #include "lue/framework/algorithm/definition/focal_operation.hpp"
+#include "lue/framework/algorithm/detail/fft_convolve.hpp"
+#include "lue/framework/algorithm/detail/separable_sum.hpp"
 #include "lue/framework/algorithm/focal_operation_export.hpp"
 
 
@@ -15,6 +17,9 @@ namespace lue {
 
                 static constexpr char const* name{"convolve"};
 
+                //! Kernel size from which on the results are calculated using fast Fourier transforms
+                static constexpr Count min_fft_kernel_size{25};
+
                 using InputElement = Element;
                 using OutputElement = Element;
 
@@ -71,6 +76,95 @@ namespace lue {
 
                     return sum;
                 }
+
+
+                /*!
+                    @brief      Return the factors of @a kernel, if it is separable and contains no
+                                zero weights
+
+                    With zero weights, the number of valid values passed by separable_sum() would
+                    not match the semantics of operator(), which considers all cells in the
+                    neighbourhood.
+                */
+                template<typename Kernel>
+                static auto separable_factors(Kernel const& kernel)
+                    -> std::optional<KernelFactors<ElementT<Kernel>>>
+                {
+                    if (!is_box_kernel(kernel))
+                    {
+                        return std::nullopt;
+                    }
+
+                    return kernel_factors(kernel);
+                }
+
+
+                /*!
+                    @brief      Return whether the results can be calculated using tile(), given
+                                @a kernel
+
+                    This is the case for kernels with floating point weights which are either
+                    separable without zero weights, or whose size is at least min_fft_kernel_size.
+                    For other kernels, direct summation by operator() is faster.
+                */
+                template<typename Kernel>
+                auto supports_tile(Kernel const& kernel) const -> bool
+                {
+                    return std::is_floating_point_v<ElementT<Kernel>> &&
+                           (separable_factors(kernel).has_value() || kernel.size() >= min_fft_kernel_size);
+                }
+
+
+                /*!
+                    @brief      Calculate the results for all cells in a partition, given
+                                @a padded_tile
+
+                    Separable kernels are applied in two passes, one along the rows and one along the
+                    columns. The cost per cell is linear in the kernel size. For other kernels, fast
+                    Fourier transforms are used. The cost per cell is then proportional to the
+                    logarithm of the kernel size.
+                */
+                template<
+                    typename Kernel,
+                    typename OutputPolicies,
+                    typename InputPolicies,
+                    typename Tile,
+                    typename OutputSpan>
+                void tile(
+                    Kernel const& kernel,
+                    OutputPolicies const& output_policies,
+                    InputPolicies const& input_policies,
+                    Tile const& padded_tile,
+                    OutputSpan const& output) const
+                {
+                    auto const& indp = input_policies.input_no_data_policy();
+                    auto const& ondp = output_policies.output_no_data_policy();
+
+                    auto const write = [&ondp, &output](
+                                           Index const idx0,
+                                           Index const idx1,
+                                           double const sum,
+                                           Count const count) -> void
+                    {
+                        if (count == 0)
+                        {
+                            ondp.mark_no_data(output[idx0, idx1]);
+                        }
+                        else
+                        {
+                            output[idx0, idx1] = static_cast<OutputElement>(sum);
+                        }
+                    };
+
+                    if (auto const factors{separable_factors(kernel)}; factors)
+                    {
+                        separable_sum<double>(indp, *factors, padded_tile, write);
+                    }
+                    else
+                    {
+                        fft_convolve(indp, kernel, padded_tile, write);
+                    }
+                }
         };
 
     }  // namespace detail
@@ -85,6 +179,10 @@ namespace lue {
 
         No-data values are filled unless all values within the neighbourhood are no-data.
 
+        For large kernels, the results are calculated using fast Fourier transforms instead of by
+        summing the weighted values per focal cell. Apart from rounding errors, the results are the
+        same.
+
         See focal_sum() for an algorithm that sums values using boolean weights (represented by integrals).
     */
     template<typename Policies, typename Kernel>
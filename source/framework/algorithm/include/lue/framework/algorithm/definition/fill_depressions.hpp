@@ -0,0 +1,1466 @@
+#pragma once
+#include "lue/framework/algorithm/definition/d8_flow_direction.hpp"
+#include "lue/framework/algorithm/detail/flow_direction.hpp"
+#include "lue/framework/algorithm/fill_depressions.hpp"
+#include "lue/framework/algorithm/routing_operation_export.hpp"
+#include "lue/framework/core/annotate.hpp"
+#include "lue/framework/core/component.hpp"
+#include "lue/macro.hpp"
+
+#include <hpx/serialization.hpp>
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <limits>
+#include <map>
+#include <queue>
+#include <tuple>
+#include <vector>
+
+
+namespace lue {
+    namespace detail::fill_depressions {
+
+        /*!
+            @brief      Type for representing the labels of regions
+
+            Labels are local to partitions. Each region contains one or more cells along the
+            partition's sides or next to no-data, and the cells flooded from them.
+        */
+        using LabelElement = IndexElement;
+
+        using LabelData = ArrayPartitionData<LabelElement, 2>;
+
+        //! Label of cells containing no-data, which are not part of a region
+        constexpr LabelElement no_label{std::numeric_limits<LabelElement>::max()};
+
+        //! Global label of the region outside of the array and inside no-data
+        constexpr Index ocean{0};
+
+        //! Offsets of the eight neighbours of a cell
+        constexpr std::array<std::array<Index, 2>, 8> neighbour_offsets{{
+            {-1, -1},
+            {-1, 0},
+            {-1, 1},
+            {0, -1},
+            {0, 1},
+            {1, -1},
+            {1, 0},
+            {1, 1},
+        }};
+
+        enum Side { north_side, south_side, west_side, east_side };
+
+
+        /*!
+            @brief      Pair of neighbouring cells in different regions of a partition
+
+            Material spills from one region into the other once it reaches the elevation of the
+            edge: the highest of the filled elevations of both cells. An edge of which the second
+            label is no_label connects a region with the outside world. Both its cell indices refer
+            to the cell in the region.
+        */
+        template<typename ElevationElement>
+        class SpillEdge
+        {
+
+            public:
+
+                SpillEdge() = default;
+
+
+                SpillEdge(
+                    std::array<LabelElement, 2> const& labels,
+                    std::array<Index, 2> const& cell_idxs,
+                    ElevationElement const elevation):
+
+                    _labels{labels},
+                    _cell_idxs{cell_idxs},
+                    _elevation{elevation}
+
+                {
+                }
+
+
+                //! Return the labels of the regions on both sides of the edge
+                auto labels() const -> std::array<LabelElement, 2> const&
+                {
+                    return _labels;
+                }
+
+
+                //! Return the linear indices of the cells on both sides of the edge
+                auto cell_idxs() const -> std::array<Index, 2> const&
+                {
+                    return _cell_idxs;
+                }
+
+
+                auto elevation() const -> ElevationElement
+                {
+                    return _elevation;
+                }
+
+
+            private:
+
+                friend class hpx::serialization::access;
+
+
+                template<typename Archive>
+                void serialize(Archive& archive, [[maybe_unused]] unsigned int const version)
+                {
+                    // clang-format off
+                    archive
+                        & _labels
+                        & _cell_idxs
+                        & _elevation
+                        ;
+                    // clang-format on
+                }
+
+
+                std::array<LabelElement, 2> _labels;
+
+                std::array<Index, 2> _cell_idxs;
+
+                ElevationElement _elevation;
+        };
+
+
+        /*!
+            @brief      Result of filling the depressions in a partition, ignoring the neighbouring
+                        partitions
+
+            Besides the partitions with the filled elevations and the labels, which stay on the
+            locality the partition is located on, this contains all that is needed to connect the
+            regions of all partitions into a single graph: the edges between regions within the
+            partition, and the filled elevations and labels of the cells along the partition's
+            sides.
+        */
+        template<typename ElevationElement>
+        class LocalResult
+        {
+
+            public:
+
+                using ElevationPartition = ArrayPartition<ElevationElement, 2>;
+
+                using ElevationData = DataT<ElevationPartition>;
+
+                using LabelPartition = ArrayPartition<LabelElement, 2>;
+
+                //! Per side, in the order of Side, the elevations of the cells
+                using ElevationSides = std::array<ElevationData, 4>;
+
+                //! Per side, in the order of Side, the labels of the cells
+                using LabelSides = std::array<LabelData, 4>;
+
+
+                LocalResult(
+                    ElevationPartition&& filled_partition,
+                    LabelPartition&& label_partition,
+                    Count const nr_labels,
+                    std::vector<SpillEdge<ElevationElement>>&& edges,
+                    ElevationSides&& elevation_sides,
+                    LabelSides&& label_sides):
+
+                    _filled_partition{std::move(filled_partition)},
+                    _label_partition{std::move(label_partition)},
+                    _nr_labels{nr_labels},
+                    _edges{std::move(edges)},
+                    _elevation_sides{std::move(elevation_sides)},
+                    _label_sides{std::move(label_sides)}
+
+                {
+                    // Rows at the north and south sides, columns at the west and east sides
+                    lue_hpx_assert(_elevation_sides[north_side].shape()[0] == 1);
+                    lue_hpx_assert(_elevation_sides[south_side].shape()[0] == 1);
+                    lue_hpx_assert(_elevation_sides[west_side].shape()[1] == 1);
+                    lue_hpx_assert(_elevation_sides[east_side].shape()[1] == 1);
+                }
+
+
+                LocalResult() = default;
+
+                LocalResult(LocalResult const&) = default;
+
+                LocalResult(LocalResult&&) noexcept = default;
+
+                ~LocalResult() = default;
+
+                auto operator=(LocalResult const&) -> LocalResult& = default;
+
+                auto operator=(LocalResult&&) noexcept -> LocalResult& = default;
+
+
+                auto filled_partition() const -> ElevationPartition const&
+                {
+                    return _filled_partition;
+                }
+
+
+                auto label_partition() const -> LabelPartition const&
+                {
+                    return _label_partition;
+                }
+
+
+                auto nr_labels() const -> Count
+                {
+                    return _nr_labels;
+                }
+
+
+                auto edges() const -> std::vector<SpillEdge<ElevationElement>> const&
+                {
+                    return _edges;
+                }
+
+
+                auto elevation_sides() const -> ElevationSides const&
+                {
+                    return _elevation_sides;
+                }
+
+
+                auto shape() const -> Shape<Count, 2>
+                {
+                    return {_elevation_sides[west_side].shape()[0], _elevation_sides[north_side].shape()[1]};
+                }
+
+
+                /*!
+                    @brief      Return the linear index, label and filled elevation of the cell at
+                                position @a idx along @a side
+                */
+                auto side_cell(Side const side, Index const idx) const
+                    -> std::tuple<Index, LabelElement, ElevationElement>
+                {
+                    auto const [nr_elements0, nr_elements1] = shape();
+                    Index cell_idx{};
+
+                    switch (side)
+                    {
+                        case north_side:
+                        {
+                            cell_idx = idx;
+                            break;
+                        }
+                        case south_side:
+                        {
+                            cell_idx = (nr_elements0 - 1) * nr_elements1 + idx;
+                            break;
+                        }
+                        case west_side:
+                        {
+                            cell_idx = idx * nr_elements1;
+                            break;
+                        }
+                        case east_side:
+                        {
+                            cell_idx = idx * nr_elements1 + nr_elements1 - 1;
+                            break;
+                        }
+                    }
+
+                    return {cell_idx, _label_sides[side][idx], _elevation_sides[side][idx]};
+                }
+
+
+            private:
+
+                friend class hpx::serialization::access;
+
+
+                template<typename Archive>
+                void serialize(Archive& archive, [[maybe_unused]] unsigned int const version)
+                {
+                    // clang-format off
+                    archive
+                        & _filled_partition
+                        & _label_partition
+                        & _nr_labels
+                        & _edges
+                        & _elevation_sides
+                        & _label_sides
+                        ;
+                    // clang-format on
+                }
+
+
+                ElevationPartition _filled_partition;
+
+                LabelPartition _label_partition;
+
+                Count _nr_labels{0};
+
+                std::vector<SpillEdge<ElevationElement>> _edges;
+
+                ElevationSides _elevation_sides;
+
+                LabelSides _label_sides;
+        };
+
+
+        /*!
+            @brief      Information about the regions of a partition, determined on the root
+                        locality, which is needed to finish filling the partition's depressions
+        */
+        template<typename ElevationElement, typename FlowDirectionElement>
+        class GlobalResult
+        {
+
+            public:
+
+                using ElevationData = ArrayPartitionData<ElevationElement, 2>;
+
+                //! Per side, in the order of Side, the elevations of the neighbouring cells
+                using Halo = std::array<ElevationData, 4>;
+
+
+                GlobalResult(
+                    std::vector<ElevationElement>&& spill_elevations,
+                    std::vector<Index>&& outlet_cell_idxs,
+                    std::vector<FlowDirectionElement>&& outlet_flow_directions,
+                    Halo&& halo):
+
+                    _spill_elevations{std::move(spill_elevations)},
+                    _outlet_cell_idxs{std::move(outlet_cell_idxs)},
+                    _outlet_flow_directions{std::move(outlet_flow_directions)},
+                    _halo{std::move(halo)}
+
+                {
+                    lue_hpx_assert(_outlet_cell_idxs.size() == _spill_elevations.size());
+                    lue_hpx_assert(_outlet_flow_directions.size() == _spill_elevations.size());
+                }
+
+
+                GlobalResult() = default;
+
+                GlobalResult(GlobalResult const&) = default;
+
+                GlobalResult(GlobalResult&&) noexcept = default;
+
+                ~GlobalResult() = default;
+
+                auto operator=(GlobalResult const&) -> GlobalResult& = default;
+
+                auto operator=(GlobalResult&&) noexcept -> GlobalResult& = default;
+
+
+                //! Per region, the elevation at which it spills into the outside world
+                auto spill_elevations() const -> std::vector<ElevationElement> const&
+                {
+                    return _spill_elevations;
+                }
+
+
+                //! Per region, the linear index of the cell through which it spills
+                auto outlet_cell_idxs() const -> std::vector<Index> const&
+                {
+                    return _outlet_cell_idxs;
+                }
+
+
+                //! Per region, the direction in which it spills from its outlet cell
+                auto outlet_flow_directions() const -> std::vector<FlowDirectionElement> const&
+                {
+                    return _outlet_flow_directions;
+                }
+
+
+                /*!
+                    @brief      Return the final elevations of the cells surrounding the partition
+
+                    The north and south sides include the corners. Cells outside of the array
+                    are represented by the largest elevation.
+                */
+                auto halo() const -> Halo const&
+                {
+                    return _halo;
+                }
+
+
+            private:
+
+                friend class hpx::serialization::access;
+
+
+                template<typename Archive>
+                void serialize(Archive& archive, [[maybe_unused]] unsigned int const version)
+                {
+                    // clang-format off
+                    archive
+                        & _spill_elevations
+                        & _outlet_cell_idxs
+                        & _outlet_flow_directions
+                        & _halo
+                        ;
+                    // clang-format on
+                }
+
+
+                std::vector<ElevationElement> _spill_elevations;
+
+                std::vector<Index> _outlet_cell_idxs;
+
+                std::vector<FlowDirectionElement> _outlet_flow_directions;
+
+                Halo _halo;
+        };
+
+
+        /*!
+            @brief      Fill the depressions in a partition, as far as possible without knowing
+                        about the neighbouring partitions
+            @return     Filled elevations, labels, number of labels, and edges between regions
+
+            All cells along the partition's sides and all cells next to no-data are seeds. A
+            priority-flood from the seeds, lowest cell first, labels the cells reached with the
+            label of the cell they are reached from, and raises cells lower than that cell to its
+            elevation. A seed only gets a label of its own if it is not reached from a region
+            before it is visited itself. Seeds reached from a region are not lower than the
+            cell they are reached from, and join its region. This keeps the number of regions,
+            and therefore the size of the graph connecting the regions of all partitions, small.
+            Where two regions meet, the lowest edge between them is recorded. Seeds next to
+            no-data spill into the outside world.
+
+            Whether the seeds along the partition's sides spill into the outside world or into
+            neighbouring partitions is determined on the root locality.
+        */
+        template<typename InputNoDataPolicy, typename OutputNoDataPolicy, typename ElevationData>
+        auto priority_flood(
+            InputNoDataPolicy const& indp,
+            OutputNoDataPolicy const& ondp,
+            ElevationData const& elevation_data)
+            -> std::tuple<ElevationData, LabelData, Count, std::vector<SpillEdge<ElementT<ElevationData>>>>
+        {
+            using ElevationElement = ElementT<ElevationData>;
+            using SpillEdge = SpillEdge<ElevationElement>;
+            using Cell = std::tuple<ElevationElement, Index>;
+
+            auto const& shape{elevation_data.shape()};
+            auto const [nr_elements0, nr_elements1] = shape;
+
+            auto const is_within_partition = [nr_elements0, nr_elements1](
+                                                 Index const idx0, Index const idx1) -> bool
+            { return idx0 >= 0 && idx0 < nr_elements0 && idx1 >= 0 && idx1 < nr_elements1; };
+
+            ElevationData filled_data{shape};
+            LabelData label_data{shape, no_label};
+            Count nr_labels{0};
+
+            // Seeds are in cells_to_visit from the start, at their own elevation
+            std::vector<bool> is_seed(static_cast<std::size_t>(nr_elements(shape)), false);
+            std::vector<Index> seed_idxs_bordering_no_data{};
+
+            // Lowest cell first. Cells at equal elevation in the order they were labelled.
+            std::priority_queue<Cell, std::vector<Cell>, std::greater<Cell>> cells_to_visit{};
+
+            // Cells raised to the elevation of the cell they were reached from. These are visited
+            // before any other cell.
+            std::queue<Index> pit_cells_to_visit{};
+
+            // Per pair of labels, the lowest edge between them
+            std::map<std::array<LabelElement, 2>, SpillEdge> edges_by_labels{};
+
+            auto const add_edge = [&edges_by_labels](SpillEdge&& edge) -> void
+            {
+                auto [it, inserted] = edges_by_labels.try_emplace(edge.labels(), edge);
+
+                if (!inserted && edge.elevation() < it->second.elevation())
+                {
+                    it->second = std::move(edge);
+                }
+            };
+
+            for (Index idx0 = 0; idx0 < nr_elements0; ++idx0)
+            {
+                for (Index idx1 = 0; idx1 < nr_elements1; ++idx1)
+                {
+                    Index const idx{idx0 * nr_elements1 + idx1};
+
+                    if (indp.is_no_data(elevation_data, idx))
+                    {
+                        ondp.mark_no_data(filled_data, idx);
+                        continue;
+                    }
+
+                    filled_data[idx] = elevation_data[idx];
+
+                    bool const is_side_cell{
+                        idx0 == 0 || idx0 == nr_elements0 - 1 || idx1 == 0 || idx1 == nr_elements1 - 1};
+                    bool borders_no_data{false};
+
+                    for (auto const [offset0, offset1] : neighbour_offsets)
+                    {
+                        if (is_within_partition(idx0 + offset0, idx1 + offset1) &&
+                            indp.is_no_data(elevation_data, idx0 + offset0, idx1 + offset1))
+                        {
+                            borders_no_data = true;
+                            break;
+                        }
+                    }
+
+                    if (is_side_cell || borders_no_data)
+                    {
+                        is_seed[static_cast<std::size_t>(idx)] = true;
+                        cells_to_visit.emplace(filled_data[idx], idx);
+
+                        if (borders_no_data)
+                        {
+                            seed_idxs_bordering_no_data.push_back(idx);
+                        }
+                    }
+                }
+            }
+
+            while (!(pit_cells_to_visit.empty() && cells_to_visit.empty()))
+            {
+                Index idx{};
+
+                if (!pit_cells_to_visit.empty())
+                {
+                    idx = pit_cells_to_visit.front();
+                    pit_cells_to_visit.pop();
+                }
+                else
+                {
+                    idx = std::get<1>(cells_to_visit.top());
+                    cells_to_visit.pop();
+                }
+
+                if (label_data[idx] == no_label)
+                {
+                    // Seed not reached from any region
+                    lue_hpx_assert(is_seed[static_cast<std::size_t>(idx)]);
+                    label_data[idx] = static_cast<LabelElement>(nr_labels++);
+                }
+
+                Index const idx0{idx / nr_elements1};
+                Index const idx1{idx % nr_elements1};
+                ElevationElement const elevation{filled_data[idx]};
+                LabelElement const label{label_data[idx]};
+
+                for (auto const [offset0, offset1] : neighbour_offsets)
+                {
+                    if (!is_within_partition(idx0 + offset0, idx1 + offset1))
+                    {
+                        continue;
+                    }
+
+                    Index const neighbour_idx{(idx0 + offset0) * nr_elements1 + idx1 + offset1};
+
+                    if (indp.is_no_data(elevation_data, neighbour_idx))
+                    {
+                        continue;
+                    }
+
+                    LabelElement const neighbour_label{label_data[neighbour_idx]};
+
+                    if (neighbour_label == no_label)
+                    {
+                        label_data[neighbour_idx] = label;
+
+                        if (is_seed[static_cast<std::size_t>(neighbour_idx)])
+                        {
+                            // Visited later on, from cells_to_visit. All lower cells have been
+                            // visited already.
+                            lue_hpx_assert(filled_data[neighbour_idx] >= elevation);
+                        }
+                        else if (filled_data[neighbour_idx] <= elevation)
+                        {
+                            filled_data[neighbour_idx] = elevation;
+                            pit_cells_to_visit.push(neighbour_idx);
+                        }
+                        else
+                        {
+                            cells_to_visit.emplace(filled_data[neighbour_idx], neighbour_idx);
+                        }
+                    }
+                    else if (neighbour_label != label)
+                    {
+                        ElevationElement const spill_elevation{
+                            std::max(elevation, filled_data[neighbour_idx])};
+                        bool const is_ordered{label < neighbour_label};
+
+                        add_edge(SpillEdge{
+                            is_ordered ? std::array<LabelElement, 2>{label, neighbour_label}
+                                       : std::array<LabelElement, 2>{neighbour_label, label},
+                            is_ordered ? std::array<Index, 2>{idx, neighbour_idx}
+                                       : std::array<Index, 2>{neighbour_idx, idx},
+                            spill_elevation});
+                    }
+                }
+            }
+
+            // Per region, the lowest seed next to no-data connects it with the outside world.
+            // Seeds are never raised.
+            for (Index const idx : seed_idxs_bordering_no_data)
+            {
+                add_edge(SpillEdge{
+                    std::array<LabelElement, 2>{label_data[idx], no_label},
+                    std::array<Index, 2>{idx, idx},
+                    filled_data[idx]});
+            }
+
+            std::vector<SpillEdge> edges{};
+            edges.reserve(edges_by_labels.size());
+
+            for (auto& [labels, edge] : edges_by_labels)
+            {
+                edges.push_back(std::move(edge));
+            }
+
+            return {std::move(filled_data), std::move(label_data), nr_labels, std::move(edges)};
+        }
+
+
+        //! Return copies of the cells along the sides of @a data, in the order of Side
+        template<typename Data>
+        auto sides(Data const& data) -> std::array<Data, 4>
+        {
+            auto const [nr_elements0, nr_elements1] = data.shape();
+
+            Data north{{1, nr_elements1}};
+            Data south{{1, nr_elements1}};
+            Data west{{nr_elements0, 1}};
+            Data east{{nr_elements0, 1}};
+
+            std::copy(data.begin(), data.begin() + nr_elements1, north.begin());
+            std::copy(data.begin() + (nr_elements0 - 1) * nr_elements1, data.end(), south.begin());
+
+            for (Index idx0 = 0; idx0 < nr_elements0; ++idx0)
+            {
+                west[idx0] = data(idx0, 0);
+                east[idx0] = data(idx0, nr_elements1 - 1);
+            }
+
+            return {std::move(north), std::move(south), std::move(west), std::move(east)};
+        }
+
+
+        template<typename Policies, typename ElevationElement>
+        auto fill_partition(
+            Policies const& policies, ArrayPartition<ElevationElement, 2> const& elevation_partition)
+            -> hpx::future<LocalResult<ElevationElement>>
+        {
+            using ElevationPartition = ArrayPartition<ElevationElement, 2>;
+            using LabelPartition = ArrayPartition<LabelElement, 2>;
+            using LocalResult = LocalResult<ElevationElement>;
+
+            return hpx::dataflow(
+                hpx::launch::async,
+
+                [policies](ElevationPartition const& elevation_partition) -> LocalResult
+                {
+                    AnnotateFunction const annotation{"fill_depressions: partition: fill"};
+
+                    auto const elevation_partition_ptr{ready_component_ptr(elevation_partition)};
+                    auto const& elevation_data{elevation_partition_ptr->data()};
+                    auto const& offset{elevation_partition_ptr->offset()};
+
+                    auto const& indp = std::get<0>(policies.inputs_policies()).input_no_data_policy();
+                    auto const& ondp = std::get<0>(policies.outputs_policies()).output_no_data_policy();
+
+                    auto [filled_data, label_data, nr_labels, edges] =
+                        priority_flood(indp, ondp, elevation_data);
+
+                    auto elevation_sides{sides(filled_data)};
+                    auto label_sides{sides(label_data)};
+
+                    return {
+                        ElevationPartition{hpx::find_here(), offset, std::move(filled_data)},
+                        LabelPartition{hpx::find_here(), offset, std::move(label_data)},
+                        nr_labels,
+                        std::move(edges),
+                        std::move(elevation_sides),
+                        std::move(label_sides)};
+                },
+
+                elevation_partition);
+        }
+
+
+        template<typename Policies, typename ElevationElement>
+        struct FillPartitionAction:
+            hpx::actions::make_action<
+                decltype(&fill_partition<Policies, ElevationElement>),
+                &fill_partition<Policies, ElevationElement>,
+                FillPartitionAction<Policies, ElevationElement>>::type
+        {
+        };
+
+
+        //! Edge in the graph of the regions of all partitions
+        template<typename ElevationElement>
+        struct GraphEdge
+        {
+                //! Global labels of the regions on both sides of the edge
+                std::array<Index, 2> labels;
+
+                //! Per side, the linear index of the partition and of the cell within it
+                std::array<std::array<Index, 2>, 2> cells;
+
+                //! Offset of the cell at the second side, relative to the cell at the first side
+                std::array<Index, 2> offset;
+
+                ElevationElement elevation;
+        };
+
+
+        /*!
+            @brief      Determine per partition the elevations at which its regions spill into the
+                        outside world, and the final elevations of the cells surrounding it
+
+            The regions of all partitions are connected into a single graph, together with a
+            node representing the outside world. Besides the edges between regions within
+            partitions, this graph contains the edges between neighbouring cells in different
+            partitions, and edges from the cells along the array's border and next to no-data to
+            the outside world. A priority-flood through this graph, starting at the outside world,
+            results in the lowest elevation at which each region spills into the outside world,
+            and the edge through which it does so.
+        */
+        template<typename FlowDirectionElement, typename ElevationElement>
+        auto determine_spill_elevations(
+            Shape<Count, 2> const& shape_in_partitions,
+            std::vector<hpx::shared_future<LocalResult<ElevationElement>>> const& local_results)
+            -> std::vector<GlobalResult<ElevationElement, FlowDirectionElement>>
+        {
+            using GlobalResult = GlobalResult<ElevationElement, FlowDirectionElement>;
+            using ElevationData = typename GlobalResult::ElevationData;
+            using Halo = typename GlobalResult::Halo;
+            using GraphEdge = GraphEdge<ElevationElement>;
+            // Spill elevation, number of regions passed on the way to the outside world, label, edge
+            using Visit = std::tuple<ElevationElement, Count, Index, Index>;
+
+            auto const [nr_partitions0, nr_partitions1] = shape_in_partitions;
+            Count const nr_partitions{nr_partitions0 * nr_partitions1};
+
+            lue_hpx_assert(static_cast<Count>(local_results.size()) == nr_partitions);
+
+            auto const local_result = [&local_results](Index const partition_idx) -> auto const&
+            { return local_results[static_cast<std::size_t>(partition_idx)].get(); };
+
+            // Assign consecutive global labels to the regions, after the outside world
+            std::vector<Index> label_offsets(static_cast<std::size_t>(nr_partitions));
+            Count nr_labels{ocean + 1};
+
+            for (Index partition_idx = 0; partition_idx < nr_partitions; ++partition_idx)
+            {
+                label_offsets[partition_idx] = nr_labels;
+                nr_labels += local_result(partition_idx).nr_labels();
+            }
+
+            auto const global_label = [&label_offsets](
+                                          Index const partition_idx, LabelElement const label) -> Index
+            {
+                return label == no_label ? ocean
+                                         : label_offsets[partition_idx] + static_cast<Index>(label);
+            };
+
+            std::vector<GraphEdge> edges{};
+
+            // Edges within partitions
+            for (Index partition_idx = 0; partition_idx < nr_partitions; ++partition_idx)
+            {
+                Count const nr_elements1{local_result(partition_idx).shape()[1]};
+
+                for (auto const& edge : local_result(partition_idx).edges())
+                {
+                    auto const [label0, label1] = edge.labels();
+                    auto const [cell_idx0, cell_idx1] = edge.cell_idxs();
+
+                    edges.push_back(GraphEdge{
+                        {global_label(partition_idx, label0), global_label(partition_idx, label1)},
+                        {{{partition_idx, cell_idx0}, {partition_idx, cell_idx1}}},
+                        {cell_idx1 / nr_elements1 - cell_idx0 / nr_elements1,
+                         cell_idx1 % nr_elements1 - cell_idx0 % nr_elements1},
+                        edge.elevation()});
+                }
+            }
+
+            // Edge from a cell to the outside world
+            auto const drain = [&](Index const partition_idx, auto const& cell) -> void
+            {
+                auto const [cell_idx, label, elevation] = cell;
+
+                if (label != no_label)
+                {
+                    edges.push_back(GraphEdge{
+                        {global_label(partition_idx, label), ocean},
+                        {{{partition_idx, cell_idx}, {partition_idx, cell_idx}}},
+                        {0, 0},
+                        elevation});
+                }
+            };
+
+            // Edge between neighbouring cells in different partitions. A cell next to no-data
+            // spills into the outside world.
+            auto const connect = [&](Index const partition_idx0,
+                                     auto const& cell0,
+                                     Index const partition_idx1,
+                                     auto const& cell1,
+                                     std::array<Index, 2> const& offset) -> void
+            {
+                auto const [cell_idx0, label0, elevation0] = cell0;
+                auto const [cell_idx1, label1, elevation1] = cell1;
+
+                if (label0 != no_label && label1 != no_label)
+                {
+                    edges.push_back(GraphEdge{
+                        {global_label(partition_idx0, label0), global_label(partition_idx1, label1)},
+                        {{{partition_idx0, cell_idx0}, {partition_idx1, cell_idx1}}},
+                        offset,
+                        std::max(elevation0, elevation1)});
+                }
+                else if (label0 != no_label)
+                {
+                    drain(partition_idx0, cell0);
+                }
+                else if (label1 != no_label)
+                {
+                    drain(partition_idx1, cell1);
+                }
+            };
+
+            for (Index partition_idx0 = 0; partition_idx0 < nr_partitions0; ++partition_idx0)
+            {
+                for (Index partition_idx1 = 0; partition_idx1 < nr_partitions1; ++partition_idx1)
+                {
+                    Index const partition_idx{partition_idx0 * nr_partitions1 + partition_idx1};
+                    auto const& result{local_result(partition_idx)};
+                    auto const [nr_elements0, nr_elements1] = result.shape();
+
+                    // Cells along the array's border spill into the outside world
+                    for (Index idx = 0; idx < nr_elements1; ++idx)
+                    {
+                        if (partition_idx0 == 0)
+                        {
+                            drain(partition_idx, result.side_cell(north_side, idx));
+                        }
+
+                        if (partition_idx0 == nr_partitions0 - 1)
+                        {
+                            drain(partition_idx, result.side_cell(south_side, idx));
+                        }
+                    }
+
+                    for (Index idx = 0; idx < nr_elements0; ++idx)
+                    {
+                        if (partition_idx1 == 0)
+                        {
+                            drain(partition_idx, result.side_cell(west_side, idx));
+                        }
+
+                        if (partition_idx1 == nr_partitions1 - 1)
+                        {
+                            drain(partition_idx, result.side_cell(east_side, idx));
+                        }
+                    }
+
+                    if (partition_idx0 < nr_partitions0 - 1)
+                    {
+                        // Horizontal border. The south side of this partition borders the north
+                        // side of the south partition.
+                        Index const south_partition_idx{partition_idx + nr_partitions1};
+                        auto const& south_result{local_result(south_partition_idx)};
+
+                        for (Index idx = 0; idx < nr_elements1; ++idx)
+                        {
+                            for (Index offset = std::max<Index>(-1, -idx);
+                                 offset <= std::min<Index>(1, nr_elements1 - 1 - idx);
+                                 ++offset)
+                            {
+                                connect(
+                                    partition_idx,
+                                    result.side_cell(south_side, idx),
+                                    south_partition_idx,
+                                    south_result.side_cell(north_side, idx + offset),
+                                    {1, offset});
+                            }
+                        }
+                    }
+
+                    if (partition_idx1 < nr_partitions1 - 1)
+                    {
+                        // Vertical border. The east side of this partition borders the west side
+                        // of the east partition.
+                        Index const east_partition_idx{partition_idx + 1};
+                        auto const& east_result{local_result(east_partition_idx)};
+
+                        for (Index idx = 0; idx < nr_elements0; ++idx)
+                        {
+                            for (Index offset = std::max<Index>(-1, -idx);
+                                 offset <= std::min<Index>(1, nr_elements0 - 1 - idx);
+                                 ++offset)
+                            {
+                                connect(
+                                    partition_idx,
+                                    result.side_cell(east_side, idx),
+                                    east_partition_idx,
+                                    east_result.side_cell(west_side, idx + offset),
+                                    {offset, 1});
+                            }
+                        }
+                    }
+
+                    if (partition_idx0 < nr_partitions0 - 1 && partition_idx1 < nr_partitions1 - 1)
+                    {
+                        // Corner shared by four partitions. Only the diagonal connections are
+                        // not handled by the borders.
+                        Index const east_partition_idx{partition_idx + 1};
+                        Index const south_partition_idx{partition_idx + nr_partitions1};
+                        Index const south_east_partition_idx{south_partition_idx + 1};
+                        auto const& south_result{local_result(south_partition_idx)};
+
+                        connect(
+                            partition_idx,
+                            result.side_cell(south_side, nr_elements1 - 1),
+                            south_east_partition_idx,
+                            local_result(south_east_partition_idx).side_cell(north_side, 0),
+                            {1, 1});
+                        connect(
+                            east_partition_idx,
+                            local_result(east_partition_idx).side_cell(south_side, 0),
+                            south_partition_idx,
+                            south_result.side_cell(north_side, south_result.shape()[1] - 1),
+                            {1, -1});
+                    }
+                }
+            }
+
+            // Priority-flood through the graph, starting at the outside world. Of the regions spilling
+            // at the same elevation, those nearest to the outside world are visited first. This way,
+            // regions along the array's border spill into the outside world directly, instead of
+            // through their neighbours.
+            std::vector<std::vector<Index>> edge_idxs_by_label(static_cast<std::size_t>(nr_labels));
+
+            for (Index edge_idx = 0; edge_idx < static_cast<Index>(edges.size()); ++edge_idx)
+            {
+                for (Index const label : edges[edge_idx].labels)
+                {
+                    edge_idxs_by_label[label].push_back(edge_idx);
+                }
+            }
+
+            std::vector<ElevationElement> spill_elevations(static_cast<std::size_t>(nr_labels));
+            std::vector<Index> spill_edge_idxs(static_cast<std::size_t>(nr_labels), -1);
+            std::vector<bool> is_visited(static_cast<std::size_t>(nr_labels), false);
+            std::priority_queue<Visit, std::vector<Visit>, std::greater<Visit>> labels_to_visit{};
+
+            auto const visit_neighbours =
+                [&](Index const label, ElevationElement const elevation, Count const nr_hops) -> void
+            {
+                for (Index const edge_idx : edge_idxs_by_label[label])
+                {
+                    auto const& [labels, cells, offset, edge_elevation] = edges[edge_idx];
+                    Index const neighbour_label{labels[0] == label ? labels[1] : labels[0]};
+
+                    if (!is_visited[neighbour_label])
+                    {
+                        labels_to_visit.emplace(
+                            std::max(elevation, edge_elevation), nr_hops + 1, neighbour_label, edge_idx);
+                    }
+                }
+            };
+
+            is_visited[ocean] = true;
+            visit_neighbours(ocean, std::numeric_limits<ElevationElement>::lowest(), 0);
+
+            while (!labels_to_visit.empty())
+            {
+                auto const [elevation, nr_hops, label, edge_idx] = labels_to_visit.top();
+                labels_to_visit.pop();
+
+                if (!is_visited[label])
+                {
+                    is_visited[label] = true;
+                    spill_elevations[label] = elevation;
+                    spill_edge_idxs[label] = edge_idx;
+                    visit_neighbours(label, elevation, nr_hops);
+                }
+            }
+
+            // Final elevations of the cells along the partitions' sides
+            std::vector<Halo> final_sides{};
+            final_sides.reserve(static_cast<std::size_t>(nr_partitions));
+
+            for (Index partition_idx = 0; partition_idx < nr_partitions; ++partition_idx)
+            {
+                auto const& result{local_result(partition_idx)};
+                Halo elevation_sides{};
+
+                for (Side const side : {north_side, south_side, west_side, east_side})
+                {
+                    elevation_sides[side] = ElevationData{result.elevation_sides()[side].shape()};
+
+                    for (Index idx = 0; idx < nr_elements(elevation_sides[side].shape()); ++idx)
+                    {
+                        auto const [cell_idx, label, elevation] = result.side_cell(side, idx);
+
+                        elevation_sides[side][idx] =
+                            label == no_label
+                                ? elevation
+                                : std::max(elevation, spill_elevations[global_label(partition_idx, label)]);
+                    }
+                }
+
+                final_sides.push_back(std::move(elevation_sides));
+            }
+
+            constexpr ElevationElement outside{std::numeric_limits<ElevationElement>::max()};
+
+            auto const final_side = [&](Index const partition_idx0,
+                                        Index const partition_idx1,
+                                        Side const side) -> ElevationData const*
+            {
+                return partition_idx0 >= 0 && partition_idx0 < nr_partitions0 && partition_idx1 >= 0 &&
+                               partition_idx1 < nr_partitions1
+                           ? &final_sides[partition_idx0 * nr_partitions1 + partition_idx1][side]
+                           : nullptr;
+            };
+
+            auto const first = [outside](ElevationData const* side) -> ElevationElement
+            { return side != nullptr ? (*side)[0] : outside; };
+
+            auto const last = [outside](ElevationData const* side) -> ElevationElement
+            { return side != nullptr ? (*side)[nr_elements(side->shape()) - 1] : outside; };
+
+            auto const copy =
+                [outside](ElevationData const* side, auto destination, Count const count) -> void
+            {
+                if (side != nullptr)
+                {
+                    lue_hpx_assert(nr_elements(side->shape()) == count);
+                    std::copy(side->begin(), side->end(), destination);
+                }
+                else
+                {
+                    std::fill_n(destination, count, outside);
+                }
+            };
+
+            std::vector<GlobalResult> global_results{};
+            global_results.reserve(static_cast<std::size_t>(nr_partitions));
+
+            for (Index partition_idx0 = 0; partition_idx0 < nr_partitions0; ++partition_idx0)
+            {
+                for (Index partition_idx1 = 0; partition_idx1 < nr_partitions1; ++partition_idx1)
+                {
+                    Index const partition_idx{partition_idx0 * nr_partitions1 + partition_idx1};
+                    auto const& result{local_result(partition_idx)};
+                    auto const [nr_elements0, nr_elements1] = result.shape();
+                    Count const nr_partition_labels{result.nr_labels()};
+                    Index const label_offset{label_offsets[partition_idx]};
+
+                    std::vector<ElevationElement> partition_spill_elevations(
+                        spill_elevations.begin() + label_offset,
+                        spill_elevations.begin() + label_offset + nr_partition_labels);
+                    std::vector<Index> outlet_cell_idxs(static_cast<std::size_t>(nr_partition_labels));
+                    std::vector<FlowDirectionElement> outlet_flow_directions(
+                        static_cast<std::size_t>(nr_partition_labels));
+
+                    for (Index label = 0; label < nr_partition_labels; ++label)
+                    {
+                        lue_hpx_assert(is_visited[label_offset + label]);
+
+                        // The outlet is the region's cell at the edge through which it spills. It
+                        // drains into the cell at the other side, or into the outside world.
+                        auto const& [labels, cells, offset, elevation] =
+                            edges[spill_edge_idxs[label_offset + label]];
+                        Index const side{labels[0] == label_offset + label ? 0 : 1};
+                        Index const sign{side == 0 ? 1 : -1};
+
+                        lue_hpx_assert(cells[side][0] == partition_idx);
+
+                        outlet_cell_idxs[label] = cells[side][1];
+                        outlet_flow_directions[label] =
+                            flow_direction_towards<FlowDirectionElement>(sign * offset[0], sign * offset[1]);
+                    }
+
+                    Halo halo{
+                        ElevationData{{1, nr_elements1 + 2}},
+                        ElevationData{{1, nr_elements1 + 2}},
+                        ElevationData{{nr_elements0, 1}},
+                        ElevationData{{nr_elements0, 1}}};
+
+                    {
+                        auto& north{halo[north_side]};
+
+                        north[0] = last(final_side(partition_idx0 - 1, partition_idx1 - 1, south_side));
+                        copy(
+                            final_side(partition_idx0 - 1, partition_idx1, south_side),
+                            north.begin() + 1,
+                            nr_elements1);
+                        north[nr_elements1 + 1] =
+                            first(final_side(partition_idx0 - 1, partition_idx1 + 1, south_side));
+                    }
+
+                    {
+                        auto& south{halo[south_side]};
+
+                        south[0] = last(final_side(partition_idx0 + 1, partition_idx1 - 1, north_side));
+                        copy(
+                            final_side(partition_idx0 + 1, partition_idx1, north_side),
+                            south.begin() + 1,
+                            nr_elements1);
+                        south[nr_elements1 + 1] =
+                            first(final_side(partition_idx0 + 1, partition_idx1 + 1, north_side));
+                    }
+
+                    copy(
+                        final_side(partition_idx0, partition_idx1 - 1, east_side),
+                        halo[west_side].begin(),
+                        nr_elements0);
+                    copy(
+                        final_side(partition_idx0, partition_idx1 + 1, west_side),
+                        halo[east_side].begin(),
+                        nr_elements0);
+
+                    global_results.emplace_back(
+                        std::move(partition_spill_elevations),
+                        std::move(outlet_cell_idxs),
+                        std::move(outlet_flow_directions),
+                        std::move(halo));
+                }
+            }
+
+            return global_results;
+        }
+
+
+        /*!
+            @brief      Finish filling the depressions in a partition, and determine the flow
+                        directions
+            @param      filled_data Locally filled elevations, which are raised to their final
+                        elevations in place
+            @return     Flow directions
+
+            The cells in each region are raised to the elevation at which the region spills into
+            the outside world. Flow directions are determined by D8FlowDirection, using the final
+            elevations of the surrounding cells as a halo. This leaves cells on flats, whether
+            original or filled, as sinks. The outlet of each region drains into the cell the region
+            spills into. All other sinks drain, through cells in the same region and at the same
+            elevation, into the nearest cell that drains already.
+
+            Along a flow path, either the elevation decreases, or the region spills into the next
+            one, or the distance to a cell that drains already decreases. Flow paths contain no
+            cycles and end in the outside world. Outlets of regions spilling into the outside
+            world remain sinks.
+        */
+        template<typename Policies, typename ElevationData, typename GlobalResult>
+        auto resolve(
+            Policies const& policies,
+            ElevationData& filled_data,
+            LabelData const& label_data,
+            GlobalResult const& global_result)
+            -> ArrayPartitionData<policy::OutputElementT<Policies, 1>, 2>
+        {
+            using ElevationElement = ElementT<ElevationData>;
+            using FlowDirectionElement = policy::OutputElementT<Policies, 1>;
+            using FlowDirectionData = ArrayPartitionData<FlowDirectionElement, 2>;
+            using Slice = typename ElevationData::Slice;
+            using Weight = bool;
+
+            auto const& shape{filled_data.shape()};
+            auto const [nr_elements0, nr_elements1] = shape;
+            Count const nr_cells{nr_elements(shape)};
+
+            auto const& spill_elevations{global_result.spill_elevations()};
+            auto const& outlet_cell_idxs{global_result.outlet_cell_idxs()};
+            auto const& outlet_flow_directions{global_result.outlet_flow_directions()};
+            auto const& halo{global_result.halo()};
+
+            for (Index idx = 0; idx < nr_cells; ++idx)
+            {
+                if (label_data[idx] != no_label)
+                {
+                    filled_data[idx] = std::max(filled_data[idx], spill_elevations[label_data[idx]]);
+                }
+            }
+
+            ElevationData padded_data{{nr_elements0 + 2, nr_elements1 + 2}};
+
+            std::copy(halo[north_side].begin(), halo[north_side].end(), padded_data.begin());
+
+            for (Index idx0 = 0; idx0 < nr_elements0; ++idx0)
+            {
+                padded_data(idx0 + 1, 0) = halo[west_side][idx0];
+                std::copy(
+                    filled_data.begin() + idx0 * nr_elements1,
+                    filled_data.begin() + (idx0 + 1) * nr_elements1,
+                    padded_data.begin() + (idx0 + 1) * (nr_elements1 + 2) + 1);
+                padded_data(idx0 + 1, nr_elements1 + 1) = halo[east_side][idx0];
+            }
+
+            std::copy(
+                halo[south_side].begin(),
+                halo[south_side].end(),
+                padded_data.begin() + (nr_elements0 + 1) * (nr_elements1 + 2));
+
+            Kernel<Weight, 2> const kernel{box_kernel<Weight, 2>(1, true)};
+            detail::D8FlowDirection<FlowDirectionElement, ElevationElement> const d8_flow_direction{};
+            auto const& flow_direction_output_policies{std::get<1>(policies.outputs_policies())};
+            auto const& elevation_input_policies{std::get<0>(policies.inputs_policies())};
+
+            FlowDirectionData flow_direction_data{shape};
+
+            for (Index idx0 = 0; idx0 < nr_elements0; ++idx0)
+            {
+                for (Index idx1 = 0; idx1 < nr_elements1; ++idx1)
+                {
+                    flow_direction_data(idx0, idx1) = d8_flow_direction(
+                        kernel,
+                        flow_direction_output_policies,
+                        elevation_input_policies,
+                        submdspan(padded_data.span(), Slice{idx0, idx0 + 3}, Slice{idx1, idx1 + 3}));
+                }
+            }
+
+            // Breadth-first search from the cells that drain already
+            std::vector<bool> is_reached(static_cast<std::size_t>(nr_cells), false);
+            std::queue<Index> cells_to_visit{};
+
+            for (std::size_t label = 0; label < outlet_cell_idxs.size(); ++label)
+            {
+                Index const idx{outlet_cell_idxs[label]};
+
+                if (flow_direction_data[idx] == sink<FlowDirectionElement>)
+                {
+                    flow_direction_data[idx] = outlet_flow_directions[label];
+                }
+
+                is_reached[idx] = true;
+                cells_to_visit.push(idx);
+            }
+
+            for (Index idx = 0; idx < nr_cells; ++idx)
+            {
+                if (!is_reached[idx] && label_data[idx] != no_label &&
+                    flow_direction_data[idx] != sink<FlowDirectionElement>)
+                {
+                    is_reached[idx] = true;
+                    cells_to_visit.push(idx);
+                }
+            }
+
+            while (!cells_to_visit.empty())
+            {
+                Index const idx{cells_to_visit.front()};
+                cells_to_visit.pop();
+
+                Index const idx0{idx / nr_elements1};
+                Index const idx1{idx % nr_elements1};
+
+                for (auto const [offset0, offset1] : neighbour_offsets)
+                {
+                    if (idx0 + offset0 < 0 || idx0 + offset0 >= nr_elements0 || idx1 + offset1 < 0 ||
+                        idx1 + offset1 >= nr_elements1)
+                    {
+                        continue;
+                    }
+
+                    Index const neighbour_idx{(idx0 + offset0) * nr_elements1 + idx1 + offset1};
+
+                    if (!is_reached[neighbour_idx] && label_data[neighbour_idx] == label_data[idx] &&
+                        filled_data[neighbour_idx] == filled_data[idx])
+                    {
+                        lue_hpx_assert(flow_direction_data[neighbour_idx] == sink<FlowDirectionElement>);
+
+                        flow_direction_data[neighbour_idx] =
+                            flow_direction_towards<FlowDirectionElement>(-offset0, -offset1);
+                        is_reached[neighbour_idx] = true;
+                        cells_to_visit.push(neighbour_idx);
+                    }
+                }
+            }
+
+            return flow_direction_data;
+        }
+
+
+        template<typename Policies, typename ElevationElement, typename FlowDirectionElement>
+        auto resolve_partition(
+            Policies const& policies,
+            ArrayPartition<ElevationElement, 2> const& filled_partition,
+            ArrayPartition<LabelElement, 2> const& label_partition,
+            GlobalResult<ElevationElement, FlowDirectionElement> const& global_result)
+            -> hpx::tuple<ArrayPartition<ElevationElement, 2>, ArrayPartition<FlowDirectionElement, 2>>
+        {
+            using FlowDirectionPartition = ArrayPartition<FlowDirectionElement, 2>;
+
+            AnnotateFunction const annotation{"fill_depressions: partition: resolve"};
+
+            lue_hpx_assert(filled_partition.is_ready());
+            lue_hpx_assert(label_partition.is_ready());
+
+            auto const filled_partition_ptr{ready_component_ptr(filled_partition)};
+            auto filled_data{filled_partition_ptr->data()};
+
+            auto const label_partition_ptr{ready_component_ptr(label_partition)};
+            auto const& label_data{label_partition_ptr->data()};
+
+            auto flow_direction_data{resolve(policies, filled_data, label_data, global_result)};
+
+            // Store the raised elevations in the partition. This does not depend on whether the data
+            // obtained above shares its elements with the partition, and bumps the partition's version.
+            filled_partition_ptr->set_data(filled_data);
+
+            return hpx::make_tuple(
+                filled_partition,
+                FlowDirectionPartition{
+                    hpx::find_here(), filled_partition_ptr->offset(), std::move(flow_direction_data)});
+        }
+
+
+        template<typename Policies, typename ElevationElement, typename FlowDirectionElement>
+        struct ResolvePartitionAction:
+            hpx::actions::make_action<
+                decltype(&resolve_partition<Policies, ElevationElement, FlowDirectionElement>),
+                &resolve_partition<Policies, ElevationElement, FlowDirectionElement>,
+                ResolvePartitionAction<Policies, ElevationElement, FlowDirectionElement>>::type
+        {
+        };
+
+    }  // namespace detail::fill_depressions
+
+
+    /*!
+        @brief      Fill the depressions in @a elevation and determine the flow direction in
+                    each cell
+        @ingroup    routing_operation
+        @return     Tuple of the filled elevations and the D8 flow directions
+
+        Depressions are filled up to the elevation at which they spill into a neighbouring cell
+        that drains towards the array's border or towards no-data. Flow directions follow the
+        steepest descent in the filled elevations. Cells on flats drain towards the nearest cell
+        along the flat's edge that drains already. Cells along the array's border and next to
+        no-data that have no lower neighbour become sinks. All other cells drain.
+
+        Filling happens in three phases:
+        -# Per partition, depressions are filled by a priority-flood from the cells along the
+           partition's sides, ignoring the neighbouring partitions. This results in regions of
+           cells draining into the same side cell, and edges between regions at which material
+           spills from one into the other.
+        -# On the root locality, the regions of all partitions are connected into a graph, and
+           a priority-flood through this graph determines the elevation at which each region
+           spills into the outside world.
+        -# Per partition, cells are raised to the spill elevation of their region and flow
+           directions are determined.
+
+        Only the information about the cells along the partitions' sides is sent to the root
+        locality.
+    */
+    template<typename Policies>
+        requires std::floating_point<policy::InputElementT<Policies, 0>> &&
+                 std::integral<policy::OutputElementT<Policies, 1>>
+    auto fill_depressions(
+        Policies const& policies, PartitionedArray<policy::InputElementT<Policies, 0>, 2> const& elevation)
+        -> std::tuple<
+            PartitionedArray<policy::OutputElementT<Policies, 0>, 2>,
+            PartitionedArray<policy::OutputElementT<Policies, 1>, 2>>
+    {
+        using ElevationElement = policy::InputElementT<Policies, 0>;
+        using FlowDirectionElement = policy::OutputElementT<Policies, 1>;
+        using ElevationArray = PartitionedArray<ElevationElement, 2>;
+        using ElevationPartitions = PartitionsT<ElevationArray>;
+        using FlowDirectionArray = PartitionedArray<FlowDirectionElement, 2>;
+        using FlowDirectionPartitions = PartitionsT<FlowDirectionArray>;
+        using LocalResult = detail::fill_depressions::LocalResult<ElevationElement>;
+        using LocalResultF = hpx::shared_future<LocalResult>;
+        using GlobalResult = detail::fill_depressions::GlobalResult<ElevationElement, FlowDirectionElement>;
+        using GlobalResultsF = hpx::shared_future<std::vector<GlobalResult>>;
+        using ResolvedPartitions = hpx::tuple<PartitionT<ElevationArray>, PartitionT<FlowDirectionArray>>;
+
+        static_assert(std::is_same_v<policy::OutputElementT<Policies, 0>, ElevationElement>);
+
+        AnnotateFunction const annotation{"fill_depressions: array"};
+
+        Localities<2> const& localities{elevation.localities()};
+        auto const& shape_in_partitions{elevation.partitions().shape()};
+        Count const nr_partitions{nr_elements(shape_in_partitions)};
+
+        // Fill the depressions within each partition
+        detail::fill_depressions::FillPartitionAction<Policies, ElevationElement> fill_action{};
+        std::vector<LocalResultF> local_result_fs{};
+        local_result_fs.reserve(static_cast<std::size_t>(nr_partitions));
+
+        for (Index partition_idx = 0; partition_idx < nr_partitions; ++partition_idx)
+        {
+            local_result_fs.push_back(
+                hpx::async(
+                    fill_action, localities[partition_idx], policies, elevation.partitions()[partition_idx])
+                    .share());
+        }
+
+        // Determine the elevations at which the regions spill into the outside world
+        GlobalResultsF global_results_f =
+            hpx::dataflow(
+                hpx::launch::async,
+                hpx::unwrapping(
+
+                    [shape_in_partitions](std::vector<LocalResultF> const& local_result_fs)
+                        -> std::vector<GlobalResult>
+                    {
+                        AnnotateFunction const annotation{"fill_depressions: array: spill_elevations"};
+
+                        return detail::fill_depressions::determine_spill_elevations<FlowDirectionElement>(
+                            shape_in_partitions, local_result_fs);
+                    }
+
+                    ),
+                hpx::when_all(local_result_fs.begin(), local_result_fs.end()))
+                .share();
+
+        // Finish filling the depressions and determine the flow directions within each partition
+        detail::fill_depressions::ResolvePartitionAction<Policies, ElevationElement, FlowDirectionElement>
+            resolve_action{};
+        ElevationPartitions filled_partitions{shape_in_partitions};
+        FlowDirectionPartitions flow_direction_partitions{shape_in_partitions};
+
+        for (Index partition_idx = 0; partition_idx < nr_partitions; ++partition_idx)
+        {
+            auto [filled_partition_f, flow_direction_partition_f] =
+                hpx::split_future(hpx::future<ResolvedPartitions>{hpx::dataflow(
+                    hpx::launch::async,
+
+                    [resolve_action, locality = localities[partition_idx], policies, partition_idx](
+                        LocalResultF const& local_result_f,
+                        GlobalResultsF const& global_results_f) -> hpx::future<ResolvedPartitions>
+                    {
+                        auto const& local_result{local_result_f.get()};
+
+                        return hpx::async(
+                            resolve_action,
+                            locality,
+                            policies,
+                            local_result.filled_partition(),
+                            local_result.label_partition(),
+                            global_results_f.get()[static_cast<std::size_t>(partition_idx)]);
+                    },
+
+                    local_result_fs[partition_idx],
+                    global_results_f)});
+
+            filled_partitions[partition_idx] = std::move(filled_partition_f);
+            flow_direction_partitions[partition_idx] = std::move(flow_direction_partition_f);
+        }
+
+        return {
+            ElevationArray{elevation, std::move(filled_partitions)},
+            FlowDirectionArray{elevation, std::move(flow_direction_partitions)}};
+    }
+
+}  // namespace lue
+
+
+#define LUE_INSTANTIATE_FILL_DEPRESSIONS(Policies)                                                           \
+                                                                                                             \
+    template LUE_ROUTING_OPERATION_EXPORT auto fill_depressions<ArgumentType<void(Policies)>>(               \
+        ArgumentType<void(Policies)> const&, PartitionedArray<policy::InputElementT<Policies, 0>, 2> const&) \
+        -> std::tuple<                                                                                       \
+            PartitionedArray<policy::OutputElementT<Policies, 0>, 2>,                                        \
+            PartitionedArray<policy::OutputElementT<Policies, 1>, 2>>;
@@ -0,0 +1,135 @@
+#pragma once
+#include "lue/framework/algorithm/definition/accumulating_router.hpp"
+#include "lue/framework/algorithm/flow_network.hpp"
+#include "lue/framework/algorithm/routing_operation_export.hpp"
+#include "lue/macro.hpp"
+#include <format>
+
+
+namespace lue {
+    namespace detail::flow_network {
+
+        template<typename Policies, typename FlowDirectionElement>
+        auto flow_network_partition(
+            Policies const& policies,
+            ArrayPartition<FlowDirectionElement, 2> const& flow_direction_partition,
+            InflowCountCommunicator<2> inflow_count_communicator)
+            -> hpx::tuple<
+                ArrayPartition<SmallestIntegralElement, 2>,
+                ArrayPartition<IndexElement, 2>,
+                ArrayPartition<IndexElement, 2>,
+                hpx::shared_future<std::array<std::vector<std::array<Index, 2>>, nr_neighbours<2>()>>,
+                hpx::future<std::array<std::vector<std::array<Index, 2>>, nr_neighbours<2>()>>>
+        {
+            auto [inflow_count_partition, input_cells_idxs_f, output_cells_idxs_f] = inflow_count<Policies>(
+                policies, flow_direction_partition, std::move(inflow_count_communicator));
+
+            auto [intra_partition_order, intra_partition_levels] =
+                intra_partition_stream_order(policies, flow_direction_partition, inflow_count_partition);
+
+            return hpx::make_tuple(
+                std::move(inflow_count_partition),
+                std::move(intra_partition_order),
+                std::move(intra_partition_levels),
+                std::move(input_cells_idxs_f),
+                std::move(output_cells_idxs_f));
+        }
+
+
+        template<typename Policies, typename FlowDirectionElement>
+        struct FlowNetworkPartitionAction:
+            hpx::actions::make_action<
+                decltype(&flow_network_partition<Policies, FlowDirectionElement>),
+                &flow_network_partition<Policies, FlowDirectionElement>,
+                FlowNetworkPartitionAction<Policies, FlowDirectionElement>>::type
+        {
+        };
+
+    }  // namespace detail::flow_network
+
+
+    template<typename MaterialElement, typename Policies, typename FlowDirectionElement>
+    auto flow_network(
+        Policies const& policies, PartitionedArray<FlowDirectionElement, 2> const& flow_direction)
+        -> FlowNetwork<FlowDirectionElement, MaterialElement>
+    {
+        using FlowNetwork = FlowNetwork<FlowDirectionElement, MaterialElement>;
+        using FlowDirectionPartitions = PartitionsT<typename FlowNetwork::FlowDirection>;
+        using InflowCountPartitions = PartitionsT<typename FlowNetwork::InflowCount>;
+        using IntraPartitionOrderPartitions = PartitionsT<typename FlowNetwork::IntraPartitionOrder>;
+        using IntraPartitionLevels = typename FlowNetwork::IntraPartitionLevels;
+        using NeighbourCellsIdxs = typename FlowNetwork::NeighbourCellsIdxs;
+        using NeighbourCellsIdxsFs = typename FlowNetwork::NeighbourCellsIdxsFs;
+        using MaterialCommunicators = typename FlowNetwork::MaterialCommunicators;
+
+        Localities<2> const& localities{flow_direction.localities()};
+        auto const& shape_in_partitions{flow_direction.partitions().shape()};
+        Count const nr_partitions{nr_elements(shape_in_partitions)};
+
+        detail::CommunicatorArray<detail::InflowCountCommunicator<2>, 2> inflow_count_communicators{
+            "/lue/flow_network/inflow_count/", localities};
+        MaterialCommunicators material_communicators{
+            std::format("/lue/flow_network/{}/", as_string<MaterialElement>), localities};
+
+        FlowDirectionPartitions flow_direction_partitions{shape_in_partitions};
+        InflowCountPartitions inflow_count_partitions{shape_in_partitions};
+        IntraPartitionOrderPartitions intra_partition_order_partitions{shape_in_partitions};
+        IntraPartitionLevels intra_partition_levels{shape_in_partitions};
+        NeighbourCellsIdxsFs input_cells_idxs{shape_in_partitions};
+        NeighbourCellsIdxsFs output_cells_idxs{shape_in_partitions};
+
+        detail::flow_network::FlowNetworkPartitionAction<Policies, FlowDirectionElement> action{};
+
+        for (Index partition_idx = 0; partition_idx < nr_partitions; ++partition_idx)
+        {
+            auto [inflow_count_partition_f,
+                  intra_partition_order_partition_f,
+                  intra_partition_levels_partition_f,
+                  input_cells_idxs_f,
+                  output_cells_idxs_f] =
+                hpx::split_future(hpx::async(
+                    action,
+                    localities[partition_idx],
+                    policies,
+                    flow_direction.partitions()[partition_idx],
+                    inflow_count_communicators[partition_idx]));
+
+            flow_direction_partitions[partition_idx] = flow_direction.partitions()[partition_idx];
+            inflow_count_partitions[partition_idx] = std::move(inflow_count_partition_f);
+            intra_partition_order_partitions[partition_idx] = std::move(intra_partition_order_partition_f);
+            intra_partition_levels[partition_idx] = std::move(intra_partition_levels_partition_f);
+            input_cells_idxs[partition_idx] =
+                hpx::shared_future<NeighbourCellsIdxs>{std::move(input_cells_idxs_f)};
+            output_cells_idxs[partition_idx] =
+                hpx::future<NeighbourCellsIdxs>{std::move(output_cells_idxs_f)}.share();
+        }
+
+        // Once all partitions know with which cells they exchange material with their neighbours,
+        // the inflow count channels are not needed anymore. Free up AGAS resources.
+        hpx::when_all(
+            output_cells_idxs.begin(),
+            output_cells_idxs.end(),
+            [inflow_count_communicators =
+                 std::move(inflow_count_communicators)]([[maybe_unused]] auto&& cells_idxs) mutable
+            { inflow_count_communicators.unregister().wait(); });
+
+        return FlowNetwork{
+            typename FlowNetwork::FlowDirection{flow_direction, std::move(flow_direction_partitions)},
+            typename FlowNetwork::InflowCount{flow_direction, std::move(inflow_count_partitions)},
+            typename FlowNetwork::IntraPartitionOrder{
+                flow_direction, std::move(intra_partition_order_partitions)},
+            std::move(intra_partition_levels),
+            std::move(input_cells_idxs),
+            std::move(output_cells_idxs),
+            std::move(material_communicators)};
+    }
+
+}  // namespace lue
+
+
+#define LUE_INSTANTIATE_FLOW_NETWORK(Policies, MaterialElement)                                              \
+                                                                                                             \
+    template LUE_ROUTING_OPERATION_EXPORT auto                                                               \
+    flow_network<MaterialElement, ArgumentType<void(Policies)>, policy::InputElementT<Policies, 0>>(         \
+        ArgumentType<void(Policies)> const&, PartitionedArray<policy::InputElementT<Policies, 0>, 2> const&) \
+        -> FlowNetwork<policy::InputElementT<Policies, 0>, MaterialElement>;
@@ -1,5 +1,6 @@
 #pragma once
 #include "lue/framework/algorithm/definition/focal_operation.hpp"
+#include "lue/framework/algorithm/detail/sliding_histogram.hpp"
 #include "lue/framework/algorithm/focal_majority.hpp"
 #include "lue/framework/algorithm/focal_operation_export.hpp"
 #include <unordered_map>
@@ -82,6 +83,64 @@ namespace lue {
 
                     return majority_value;
                 }
+
+
+                /*!
+                    @brief      Return whether the results can be calculated using tile(), given
+                                @a kernel
+
+                    This is the case for unweighted kernels, whose weights only select the cells in
+                    the neighbourhood. Other kernels are handled per cell, by operator().
+                */
+                template<typename Kernel>
+                auto supports_tile(Kernel const& kernel) const -> bool
+                {
+                    return is_unweighted_kernel(kernel);
+                }
+
+
+                /*!
+                    @brief      Calculate the results for all cells in a partition, given
+                                @a padded_tile
+
+                    A histogram of the values in the neighbourhood is updated incrementally while
+                    moving the neighbourhood over the tile.
+                */
+                template<
+                    typename Kernel,
+                    typename OutputPolicies,
+                    typename InputPolicies,
+                    typename Tile,
+                    typename OutputSpan>
+                void tile(
+                    Kernel const& kernel,
+                    OutputPolicies const& output_policies,
+                    InputPolicies const& input_policies,
+                    Tile const& padded_tile,
+                    OutputSpan const& output) const
+                {
+                    auto const& indp = input_policies.input_no_data_policy();
+                    auto const& ondp = output_policies.output_no_data_policy();
+
+                    sliding_histogram(
+                        indp,
+                        kernel,
+                        padded_tile,
+                        [&ondp, &output](
+                            Index const idx0,
+                            Index const idx1,
+                            SlidingHistogram<InputElement>& histogram) -> void
+                        {
+                            if (histogram.empty())
+                            {
+                                ondp.mark_no_data(output[idx0, idx1]);
+                            }
+                            else
+                            {
+                                output[idx0, idx1] = histogram.majority_value();
+                            }
+                        });
+                }
         };
 
     }  // namespace detail
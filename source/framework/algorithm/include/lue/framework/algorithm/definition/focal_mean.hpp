@@ -1,5 +1,8 @@
 #pragma once
 #include "lue/framework/algorithm/definition/focal_operation.hpp"
+#include "lue/framework/algorithm/detail/box_sum.hpp"
+#include "lue/framework/algorithm/detail/separable_sum.hpp"
+#include "lue/framework/algorithm/detail/sparse_kernel.hpp"
 #include "lue/framework/algorithm/focal_mean.hpp"
 #include "lue/framework/algorithm/focal_operation_export.hpp"
 
@@ -67,6 +70,76 @@ namespace lue {
 
                     return sum;
                 }
+
+
+                /*!
+                    @brief      Return whether the results can be calculated using tile(), given
+                                @a kernel
+
+                    This is the case for unweighted kernels, whose weights only select the cells in
+                    the neighbourhood. Other kernels are handled per cell, by operator().
+                */
+                template<typename Kernel>
+                auto supports_tile(Kernel const& kernel) const -> bool
+                {
+                    return is_unweighted_kernel(kernel);
+                }
+
+
+                /*!
+                    @brief      Calculate the results for all cells in a partition, given
+                                @a padded_tile
+
+                    For box kernels, the cost per cell does not depend on the kernel size. For other
+                    separable kernels, it is linear in the kernel size. For the remaining kernels, like
+                    circular ones, it is linear in the number of non-zero weights.
+                */
+                template<
+                    typename Kernel,
+                    typename OutputPolicies,
+                    typename InputPolicies,
+                    typename Tile,
+                    typename OutputSpan>
+                void tile(
+                    Kernel const& kernel,
+                    OutputPolicies const& output_policies,
+                    InputPolicies const& input_policies,
+                    Tile const& padded_tile,
+                    OutputSpan const& output) const
+                {
+                    auto const& indp = input_policies.input_no_data_policy();
+                    auto const& ondp = output_policies.output_no_data_policy();
+
+                    auto const write = [&ondp, &output](
+                                           Index const idx0,
+                                           Index const idx1,
+                                           BoxSumT<InputElement> const sum,
+                                           Count const count) -> void
+                    {
+                        if (count == 0)
+                        {
+                            ondp.mark_no_data(output[idx0, idx1]);
+                        }
+                        else
+                        {
+                            output[idx0, idx1] = static_cast<OutputElement>(sum / count);
+                        }
+                    };
+
+                    if (is_box_kernel(kernel))
+                    {
+                        box_sum<BoxSumT<InputElement>>(indp, padded_tile, kernel.radius(), write);
+                    }
+                    else if (auto const factors{kernel_factors(kernel)}; factors)
+                    {
+                        separable_sum<BoxSumT<InputElement>>(indp, *factors, padded_tile, write);
+                    }
+                    else
+                    {
+                        sparse_sum<BoxSumT<InputElement>>(
+                            indp, kernel_runs(kernel), kernel.size(), padded_tile, write);
+                    }
+                }
         };
 
     }  // namespace detail
@@ -1,7 +1,10 @@
 #pragma once
 #include "lue/framework/algorithm/definition/focal_operation.hpp"
+#include "lue/framework/algorithm/detail/box_extremum.hpp"
+#include "lue/framework/algorithm/detail/sparse_kernel.hpp"
 #include "lue/framework/algorithm/focal_minimum.hpp"
 #include "lue/framework/algorithm/focal_operation_export.hpp"
+#include <functional>
 
 
 namespace lue {
@@ -69,6 +72,77 @@ namespace lue {
 
                     return min;
                 }
+
+
+                /*!
+                    @brief      Return whether the results can be calculated using tile(), given
+                                @a kernel
+
+                    This is the case for unweighted kernels, whose weights only select the cells in
+                    the neighbourhood. Other kernels are handled per cell, by operator().
+                */
+                template<typename Kernel>
+                auto supports_tile(Kernel const& kernel) const -> bool
+                {
+                    return is_unweighted_kernel(kernel);
+                }
+
+
+                /*!
+                    @brief      Calculate the results for all cells in a partition, given
+                                @a padded_tile
+
+                    For box kernels, the number of comparisons per cell does not depend on the kernel
+                    size. For other kernels, like circular ones, it is linear in the number of non-zero
+                    weights.
+                */
+                template<
+                    typename Kernel,
+                    typename OutputPolicies,
+                    typename InputPolicies,
+                    typename Tile,
+                    typename OutputSpan>
+                void tile(
+                    Kernel const& kernel,
+                    OutputPolicies const& output_policies,
+                    InputPolicies const& input_policies,
+                    Tile const& padded_tile,
+                    OutputSpan const& output) const
+                {
+                    auto const& indp = input_policies.input_no_data_policy();
+                    auto const& ondp = output_policies.output_no_data_policy();
+
+                    auto const write = [&ondp, &output](
+                                           Index const idx0,
+                                           Index const idx1,
+                                           InputElement const min,
+                                           bool const valid) -> void
+                    {
+                        if (!valid)
+                        {
+                            ondp.mark_no_data(output[idx0, idx1]);
+                        }
+                        else
+                        {
+                            output[idx0, idx1] = min;
+                        }
+                    };
+
+                    if (is_box_kernel(kernel))
+                    {
+                        box_extremum(indp, padded_tile, kernel.radius(), std::greater<InputElement>{}, write);
+                    }
+                    else
+                    {
+                        sparse_extremum(
+                            indp,
+                            kernel_runs(kernel),
+                            kernel.size(),
+                            padded_tile,
+                            std::greater<InputElement>{},
+                            write);
+                    }
+                }
         };
 
     }  // namespace detail
@@ -1,14 +1,20 @@
 #pragma once
+#include "lue/framework/algorithm/detail/border_partition.hpp"
 #include "lue/framework/algorithm/detail/halo_partition.hpp"
 #include "lue/framework/algorithm/detail/verify_compatible.hpp"
 #include "lue/framework/algorithm/detail/when_all_get.hpp"
 #include "lue/framework/algorithm/functor_traits.hpp"
+#include "lue/framework/algorithm/kernel.hpp"
 #include "lue/framework/algorithm/policy.hpp"
 #include "lue/framework/core/annotate.hpp"
 #include "lue/framework/core/array.hpp"
 #include "lue/framework/core/component.hpp"
 #include "lue/macro.hpp"
 #include <boost/predef.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <concepts>
 #include <format>
 #include <stdexcept>
 
@@ -48,31 +54,6 @@ namespace lue {
         }
 
 
-        template<
-            typename OutputPolicies,
-            typename InputPolicies,
-            std::size_t... idxs,
-            typename... Element,
-            typename Functor,
-            typename Kernel>
-        auto inner(
-            Functor const& functor,
-            Kernel const& kernel,
-            OutputPolicies const& output_policies,
-            InputPolicies const& input_policies,
-            std::index_sequence<idxs...>,
-            DynamicSpan<Element, rank<Kernel>> const&... windows) -> OutputElementT<Functor>
-        {
-            // windows:
-            // For each array, a span pointing to the data to consider in this
-            // calculation
-
-            // The value for only a single output element is calculated here
-
-            return functor(kernel, output_policies, std::get<idxs>(input_policies)..., windows...);
-        }
-
-
         template<typename Element, Rank rank>
         auto span(Array<Element, rank> const& array) -> DynamicSpan<Element, rank>
         {
@@ -80,157 +61,49 @@ namespace lue {
         }
 
 
-        template<typename Element, typename Shape>
-        auto copy_to_array(
-            Shape const& kernel_shape,
-            Array<DynamicSubspan<Element, rank<Shape>>, rank<Shape>> const& windows)
-            -> Array<Element, rank<Shape>>
-        {
-            // Copy values from different views into a single array and pass it
-            // on to function calculating the result for the focal cell
-
-#ifndef NDEBUG
-
-            // Although the cells are scattered over multiple partitions,
-            // we must see the same number of cells as present in the kernel
-
-            // Check number of columns in each row of partitions
-            for (Count idx0 = 0; idx0 < windows.shape()[0]; ++idx0)
-            {
-                Count count = 0;
-
-                for (Count idx1 = 0; idx1 < windows.shape()[1]; ++idx1)
-                {
-                    lue_hpx_assert(windows(idx0, idx1).extent(1) > 0);
-                    count += windows(idx0, idx1).extent(1);
-                }
-
-                lue_hpx_assert(count == std::get<1>(kernel_shape));
-            }
-
-            // Check number of rows in each column of partitions
-            for (Count idx1 = 0; idx1 < windows.shape()[1]; ++idx1)
-            {
-                Count count = 0;
-
-                for (Count idx0 = 0; idx0 < windows.shape()[0]; ++idx0)
-                {
-                    lue_hpx_assert(windows(idx0, idx1).extent(0) > 0);
-                    count += windows(idx0, idx1).extent(0);
-                }
-
-                lue_hpx_assert(count == std::get<0>(kernel_shape));
-            }
-
-            // Within a row of partitions, the number of rows per
-            // partition must be the same
-            for (Count idx0 = 0; idx0 < windows.shape()[0]; ++idx0)
-            {
-                Count const nr_rows = windows(idx0, 0).extent(0);
-
-                for (Count idx1 = 0; idx1 < windows.shape()[1]; ++idx1)
-                {
-                    lue_hpx_assert(windows(idx0, idx1).extent(0) == nr_rows);
-                }
-            }
-
-            // Within a column of partitions, the number of columns per
-            // partition must be the same
-            for (Count idx1 = 0; idx1 < windows.shape()[1]; ++idx1)
-            {
-                Count const nr_cols = windows(0, idx1).extent(1);
-
-                for (Count idx0 = 0; idx0 < windows.shape()[0]; ++idx0)
-                {
-                    lue_hpx_assert(windows(idx0, idx1).extent(1) == nr_cols);
-                }
-            }
-
-#endif
-
-            Array<Element, rank<Shape>> array{kernel_shape};
-
-            // {idx0,idx1}w : {row,col} index of window in windows
-            // {idx0,idx1}k : {row,col} index of cell in kernel
-
-            Index rk = 0;
-
-            // Iterate over all views into partitions
-            for (Count rw = 0; rw < windows.shape()[0]; ++rw)
-            {
-                Index ck = 0;
-
-                for (Count cw = 0; cw < windows.shape()[1]; ++cw)
-                {
-                    auto const& window = windows(rw, cw);
-
-                    lue_hpx_assert(window.extent(0) <= std::get<0>(kernel_shape));
-                    lue_hpx_assert(window.extent(1) <= std::get<1>(kernel_shape));
-
-                    for (Index idx0 = 0; idx0 < window.extent(0); ++idx0, ++rk)
-                    {
-                        for (Index idx1 = 0; idx1 < window.extent(1); ++idx1, ++ck)
-                        {
-                            lue_hpx_assert(rk < std::get<0>(kernel_shape));
-                            lue_hpx_assert(ck < std::get<1>(kernel_shape));
-
-                            array(rk, ck) = window[idx0, idx1];
-                        }
-
-                        ck -= window.extent(1);  // Carriage return
-                    }
-
-                    // Entering next partition in row
-
-                    // Reset kernel row index to start row
-                    rk -= window.extent(0);
-
-                    // Offset kernel col indices by previous partition's cols
-                    ck += window.extent(1);
-                }
-
-                // Offset kernel row indices by previous partition's rows
-                rk += windows(rw, 0).extent(0);
-            }
-
-            return array;
-        }
+        /*!
+            @brief      Whether @a Functor is able to calculate the results for all cells in a partition at
+                        once, given @a Kernel
+
+            Such functors provide a `tile()` member function, which is passed padded tiles: for each
+            input partition a contiguous array containing the partition's elements, surrounded by a
+            halo of kernel radius width. This allows them to use algorithms whose cost per cell does not
+            depend on the kernel size (running sums, for example). Whether the functor can do so for
+            a specific kernel instance is determined at runtime by `supports_tile()`. If not, the
+            generic per-cell algorithm is used.
+        */
+        template<typename Functor, typename Kernel>
+        concept TileFocalFunctor = requires(Functor const& functor, Kernel const& kernel) {
+            { functor.supports_tile(kernel) } -> std::same_as<bool>;
+        };
 
 
         template<
             typename OutputPolicies,
             typename InputPolicies,
+            std::size_t... idxs,
+            typename OutputSpan,
             typename... Element,
             typename Functor,
             typename Kernel>
-        auto border(
+        void tile(
             Functor const& functor,
             Kernel const& kernel,
             OutputPolicies const& output_policies,
             InputPolicies const& input_policies,
-            Array<DynamicSubspan<Element, rank<Kernel>>, rank<Kernel>> const&... windows)
-            -> OutputElementT<Functor>
+            std::index_sequence<idxs...>,
+            OutputSpan const& output,
+            DynamicSpan<Element, rank<Kernel>> const&... tiles)
         {
-            // windows:
-            // For each array, a collection of spans pointing to the data to
-            // consider in this calculation
+            // tiles:
+            // For each array, a span pointing to the padded tile
 
-            // The value for only a single output element is calculated here
+            // The values for all output elements are calculated here
 
-            // TODO gcc-14 doesn't like this
-            // static_assert(std::is_convertible_v<ElementT<Kernel>, bool>);
-
-            static_assert(rank<Kernel> == 2);
-
-            return inner(
-                functor,
-                kernel,
-                output_policies,
-                input_policies,
-                std::index_sequence_for<Element...>{},
-                span(copy_to_array(kernel.shape(), windows))...);
+            functor.tile(kernel, output_policies, std::get<idxs>(input_policies)..., tiles..., output);
         }
 
+
         template<lue::Rank rank, lue::Index dimension = rank>
         constexpr auto nr_neighbors() -> lue::Count
         {
@@ -627,33 +500,6 @@ namespace lue {
             }
 
 
-            template<typename Element, Rank rank, typename Slice>
-            auto subspans(
-                Array<DynamicSpan<Element, rank>, rank> const& spans,
-                Array<std::array<Slice, rank>, rank> const& slices)
-                -> Array<DynamicSubspan<Element, rank>, rank>
-            {
-                static_assert(rank == 2);
-
-                assert(spans.shape() == slices.shape());
-
-                Array<DynamicSubspan<Element, rank>, 2> subspans{spans.shape()};
-
-                std::transform(
-                    spans.begin(),
-                    spans.end(),
-                    slices.begin(),
-                    subspans.begin(),
-
-                    [](DynamicSpan<Element, rank> const& span, std::array<Slice, rank> const& slices) -> auto
-                    { return submdspan(span, slices[0], slices[1]); }
-
-                );
-
-                return subspans;
-            }
-
-
             template<typename Element, Rank rank>
             auto partition_data(
                 Array<hpx::shared_future<ArrayPartitionData<Element, rank>>, rank> const&
@@ -728,135 +574,263 @@ namespace lue {
             }
 
 
+            /*!
+                @brief      Return whether @a value1 and @a value2 are the same
+
+                Two NaN values are considered the same.
+            */
             template<typename Element>
-            auto nw_corner_partition_spans(
-                lue::Array<ArrayPartitionData<Element, 2>, 2> const& partition_data)
-                -> Array<DynamicSpan<Element, 2>, 2>
+            auto same_value(Element const& value1, Element const& value2) -> bool
             {
-                // Given 3x3 partitions, return the span of those partitions in the nw corner
-                Array<DynamicSpan<Element, 2>, 2> result{{2, 2}};
-
-                result(0, 0) = partition_data(0, 0).span();
-                result(0, 1) = partition_data(0, 1).span();
-                result(1, 0) = partition_data(1, 0).span();
-                result(1, 1) = partition_data(1, 1).span();
+                if constexpr (std::is_floating_point_v<Element>)
+                {
+                    if (std::isnan(value1) && std::isnan(value2))
+                    {
+                        return true;
+                    }
+                }
 
-                return result;
+                return value1 == value2;
             }
 
 
-            template<typename Element>
-            auto ne_corner_partition_spans(
-                lue::Array<ArrayPartitionData<Element, 2>, 2> const& partition_data)
-                -> Array<DynamicSpan<Element, 2>, 2>
-            {
-                // Given 3x3 partitions, return the span of those partitions in the ne corner
-                Array<DynamicSpan<Element, 2>, 2> result{{2, 2}};
-
-                result(0, 0) = partition_data(0, 1).span();
-                result(0, 1) = partition_data(0, 2).span();
-                result(1, 0) = partition_data(1, 1).span();
-                result(1, 1) = partition_data(1, 2).span();
+            /*!
+                @brief      Return whether the collection of 3x3 partition data instances are all uniform,
+                            containing the same value
 
-                return result;
+                If so, the neighbourhood of each cell in the center partition contains only this value.
+            */
+            template<typename Element, Rank rank>
+            auto all_uniform(Array<ArrayPartitionData<Element, rank>, rank> const& partition_data) -> bool
+            {
+                auto const& center_data{partition_data(1, 1)};
+
+                return center_data.is_uniform() &&
+                       std::all_of(
+                           partition_data.begin(),
+                           partition_data.end(),
+                           [&center_data](ArrayPartitionData<Element, rank> const& data) -> bool
+                           {
+                               return data.is_uniform() &&
+                                      same_value(data.uniform_value(), center_data.uniform_value());
+                           });
             }
 
 
-            template<typename Element>
-            auto sw_corner_partition_spans(
-                lue::Array<ArrayPartitionData<Element, 2>, 2> const& partition_data)
-                -> Array<DynamicSpan<Element, 2>, 2>
+            /*!
+                @brief      Return a window with the size of the kernel, containing the value of the uniform
+                            @a partition_data
+            */
+            template<typename Element, Rank rank>
+            auto uniform_window(
+                ArrayPartitionData<Element, rank> const& partition_data, Count const kernel_size)
+                -> ArrayPartitionData<Element, rank>
             {
-                // Given 3x3 partitions, return the span of those partitions in the sw corner
-                Array<DynamicSpan<Element, 2>, 2> result{{2, 2}};
-
-                result(0, 0) = partition_data(1, 0).span();
-                result(0, 1) = partition_data(1, 1).span();
-                result(1, 0) = partition_data(2, 0).span();
-                result(1, 1) = partition_data(2, 1).span();
+                static_assert(rank == 2);
 
-                return result;
+                return ArrayPartitionData<Element, rank>{
+                    typename ArrayPartitionData<Element, rank>::Shape{{kernel_size, kernel_size}},
+                    partition_data.uniform_value()};
             }
 
 
+            /*!
+                @brief      Copy the elements of the center partition, and those of the halo of
+                            @a radius cells surrounding it, into a single contiguous tile
+                @param      partition_data Collection of 3x3 partition data instances. Except for the
+                            center one, these only contain the elements bordering the center partition.
+            */
             template<typename Element>
-            auto se_corner_partition_spans(
-                lue::Array<ArrayPartitionData<Element, 2>, 2> const& partition_data)
-                -> Array<DynamicSpan<Element, 2>, 2>
+            auto padded_tile(
+                Array<ArrayPartitionData<Element, 2>, 2> const& partition_data, Radius const radius)
+                -> Array<Element, 2>
             {
-                // Given 3x3 partitions, return the span of those partitions in the se corner
-                Array<DynamicSpan<Element, 2>, 2> result{{2, 2}};
+                using Shape = typename Array<Element, 2>::Shape;
 
-                result(0, 0) = partition_data(1, 1).span();
-                result(0, 1) = partition_data(1, 2).span();
-                result(1, 0) = partition_data(2, 1).span();
-                result(1, 1) = partition_data(2, 2).span();
+                auto const [nr_elements0, nr_elements1] = partition_data(1, 1).shape();
+                Count const nr_tile_elements1{nr_elements1 + 2 * radius};
 
-                return result;
-            }
+                Array<Element, 2> tile{Shape{{nr_elements0 + 2 * radius, nr_tile_elements1}}};
 
+                // Offsets of the rows and columns of the 3x3 blocks within the tile
+                std::array<Index, 3> const offsets0{0, radius, radius + nr_elements0};
+                std::array<Index, 3> const offsets1{0, radius, radius + nr_elements1};
 
-            template<typename Element>
-            auto n_side_partition_spans(lue::Array<ArrayPartitionData<Element, 2>, 2> const& partition_data)
-                -> Array<DynamicSpan<Element, 2>, 2>
-            {
-                // Given 3x3 partitions, return the span of those partitions in the n side
-                Array<DynamicSpan<Element, 2>, 2> result{{2, 1}};
+                for (Index idx0 = 0; idx0 < 3; ++idx0)
+                {
+                    for (Index idx1 = 0; idx1 < 3; ++idx1)
+                    {
+                        auto const& data{partition_data(idx0, idx1)};
+                        auto const [nr_rows, nr_cols] = data.shape();
 
-                result(0, 0) = partition_data(0, 1).span();
-                result(1, 0) = partition_data(1, 1).span();
+                        lue_hpx_assert(nr_rows == (idx0 == 1 ? nr_elements0 : radius));
+                        lue_hpx_assert(nr_cols == (idx1 == 1 ? nr_elements1 : radius));
 
-                return result;
+                        auto source{data.begin()};
+                        auto destination{tile.begin() + offsets0[idx0] * nr_tile_elements1 + offsets1[idx1]};
+
+                        for (Index row = 0; row < nr_rows;
+                             ++row, source += nr_cols, destination += nr_tile_elements1)
+                        {
+                            std::copy_n(source, nr_cols, destination);
+                        }
+                    }
+                }
+
+                return tile;
             }
 
 
-            template<typename Element>
-            auto s_side_partition_spans(lue::Array<ArrayPartitionData<Element, 2>, 2> const& partition_data)
-                -> Array<DynamicSpan<Element, 2>, 2>
+            /*!
+                @brief      Calculate the results for the cells within @a kernel radius cells from the
+                            sides of the partition
+                @param      output_data Output partition data to write the results to
+                @param      tiles For each input array, the padded tile of the partition, as returned by
+                            padded_tile()
+
+                The window of a cell starts at the cell's own indices in the padded tiles. No copies of
+                the elements within the neighbourhood of individual cells are made.
+            */
+            template<
+                typename Policies,
+                typename Kernel,
+                typename Functor,
+                typename OutputData,
+                typename... Element>
+            void focal_operation_band(
+                Policies const& policies,
+                Kernel const& kernel,
+                Functor const& functor,
+                OutputData& output_data,
+                Array<Element, 2> const&... tiles)
             {
-                // Given 3x3 partitions, return the span of those partitions in the s side
-                Array<DynamicSpan<Element, 2>, 2> result{{2, 1}};
+                using Slice = typename OutputData::Slice;
 
-                result(0, 0) = partition_data(1, 1).span();
-                result(1, 0) = partition_data(2, 1).span();
+                auto const [nr_elements0, nr_elements1] = output_data.shape();
+                Radius const radius{kernel.radius()};
+                Count const size{kernel.size()};
 
-                return result;
+                lue_hpx_assert(nr_elements0 >= size);
+                lue_hpx_assert(nr_elements1 >= size);
+
+                auto const calculate = [&](Index const idx0, Index const idx1) -> void
+                {
+                    output_data(idx0, idx1) = detail::inner(
+                        functor,
+                        kernel,
+                        std::get<0>(policies.outputs_policies()),
+                        policies.inputs_policies(),
+                        std::index_sequence_for<Element...>{},
+                        submdspan(tiles.span(), Slice{idx0, idx0 + size}, Slice{idx1, idx1 + size})...);
+                };
+
+                // North and south sides, including the corners
+                for (Index idx0 = 0; idx0 < radius; ++idx0)
+                {
+                    for (Index idx1 = 0; idx1 < nr_elements1; ++idx1)
+                    {
+                        calculate(idx0, idx1);
+                        calculate(nr_elements0 - radius + idx0, idx1);
+                    }
+                }
+
+                // West and east sides, excluding the corners
+                for (Index idx0 = radius; idx0 < nr_elements0 - radius; ++idx0)
+                {
+                    for (Index idx1 = 0; idx1 < radius; ++idx1)
+                    {
+                        calculate(idx0, idx1);
+                        calculate(idx0, nr_elements1 - radius + idx1);
+                    }
+                }
             }
 
 
-            template<typename Element>
-            auto w_side_partition_spans(lue::Array<ArrayPartitionData<Element, 2>, 2> const& partition_data)
-                -> Array<DynamicSpan<Element, 2>, 2>
+            /*!
+                @brief      Calculate the output partition by passing padded tiles to the functor
+
+                @sa         TileFocalFunctor
+            */
+            template<
+                typename OutputPartition,
+                typename Policies,
+                typename Kernel,
+                typename Functor,
+                typename... InputPartitions,
+                typename... InputPolicies>
+            auto focal_operation_tile_partition(
+                Policies const& policies,
+                Kernel const& kernel,
+                Functor const& functor,
+                WrappedArrayPartitions<InputPolicies, InputPartitions> const&... input_partitions)
+                -> OutputPartition
             {
-                // Given 3x3 partitions, return the span of those partitions in the w side
-                Array<DynamicSpan<Element, 2>, 2> result{{1, 2}};
+                using OutputData = DataT<OutputPartition>;
+                using Offset = OffsetT<OutputPartition>;
+                using Slice = SliceT<OutputPartition>;
 
-                result(0, 0) = partition_data(1, 0).span();
-                result(0, 1) = partition_data(1, 1).span();
+                auto const& first_focal_input_partition{
+                    std::get<0>(std::forward_as_tuple(meh::input_partition(input_partitions, 1, 1)...))};
 
-                return result;
-            }
+                return hpx::dataflow(
+                    hpx::launch::async,
+                    hpx::unwrapping(
 
+                        [policies, kernel, functor](
+                            Offset const& offset,
+                            lue::Array<meh::InputData<InputPartitions>, rank<Kernel>> const&...
+                                partition_data) -> OutputPartition
+                        {
+                            AnnotateFunction const annotation{
+                                std::format("{}: partition", functor_name<Functor>)};
 
-            template<typename Element>
-            auto e_side_partition_spans(lue::Array<ArrayPartitionData<Element, 2>, 2> const& partition_data)
-                -> Array<DynamicSpan<Element, 2>, 2>
-            {
-                // Given 3x3 partitions, return the span of those partitions in the e side
-                Array<DynamicSpan<Element, 2>, 2> result{{1, 2}};
+                            auto const& first_partition_data{
+                                std::get<0>(std::forward_as_tuple(partition_data...))};
+                            auto const& partition_shape{first_partition_data(1, 1).shape()};
 
-                result(0, 0) = partition_data(1, 1).span();
-                result(0, 1) = partition_data(1, 2).span();
+                            auto const [nr_elements0, nr_elements1] = partition_shape;
 
-                return result;
-            }
+                            verify_partition_large_enough(nr_elements0, nr_elements1, kernel.size());
 
+                            if ((meh::all_uniform(partition_data) && ...))
+                            {
+                                // The neighbourhoods of all cells are equal. Calculate the result once.
+                                return OutputPartition{
+                                    hpx::find_here(),
+                                    offset,
+                                    OutputData{
+                                        partition_shape,
+                                        detail::inner(
+                                            functor,
+                                            kernel,
+                                            std::get<0>(policies.outputs_policies()),
+                                            policies.inputs_policies(),
+                                            std::index_sequence_for<InputPartitions...>{},
+                                            meh::subspan(
+                                                meh::uniform_window(partition_data(1, 1), kernel.size()),
+                                                Slice{0, kernel.size()},
+                                                Slice{0, kernel.size()})...),
+                                        UniformTag{}}};
+                            }
 
-            template<typename Slice>
-            auto extent(Slice const& slice)
-            {
-                return std::get<1>(slice) - std::get<0>(slice);
-            };
+                            OutputData output_data{partition_shape};
+
+                            detail::tile(
+                                functor,
+                                kernel,
+                                std::get<0>(policies.outputs_policies()),
+                                policies.inputs_policies(),
+                                std::index_sequence_for<InputPartitions...>{},
+                                output_data.span(),
+                                span(meh::padded_tile(partition_data, kernel.radius()))...);
+
+                            return OutputPartition{hpx::find_here(), offset, std::move(output_data)};
+                        }
+
+                        ),
+                    first_focal_input_partition.offset(hpx::launch::async),
+                    meh::get_partition_data(input_partitions)...);
+            }
 
 
             template<
@@ -873,6 +847,17 @@ namespace lue {
                 WrappedArrayPartitions<InputPolicies, InputPartitions> const&... input_partitions)
                 -> OutputPartition
             {
+                if constexpr (TileFocalFunctor<Functor, Kernel>)
+                {
+                    // Kernels the functor's tile() does not handle fall through to the generic
+                    // per-cell algorithm below
+                    if (functor.supports_tile(kernel))
+                    {
+                        return focal_operation_tile_partition<OutputPartition>(
+                            policies, kernel, functor, input_partitions...);
+                    }
+                }
+
                 // Data is being read. Attach tasks for computing the results for
                 // the inner partition to the futures representing the data. These
                 // are in the wrapped input partitions passed in.
@@ -890,7 +875,6 @@ namespace lue {
                 hpx::future<Offset> offset{first_focal_input_partition.offset(hpx::launch::async)};
 
                 using Slice = SliceT<OutputPartition>;
-                using Slices = SlicesT<OutputPartition>;
 
                 // Once the elements from the center partition have arrived,
                 // perform calculations for all cells whose neighborhoods are
@@ -915,6 +899,26 @@ namespace lue {
 
                             verify_partition_large_enough(nr_elements0, nr_elements1, kernel.size());
 
+                            if ((partition_data.is_uniform() && ...))
+                            {
+                                // The neighbourhoods of all inner cells are equal. Calculate the result
+                                // once. The output data is expanded in case border cells turn out to
+                                // differ.
+                                return OutputData{
+                                    partition_shape,
+                                    detail::inner(
+                                        functor,
+                                        kernel,
+                                        std::get<0>(policies.outputs_policies()),
+                                        policies.inputs_policies(),
+                                        std::index_sequence_for<InputPartitions...>{},
+                                        meh::subspan(
+                                            meh::uniform_window(partition_data, kernel.size()),
+                                            Slice{0, kernel.size()},
+                                            Slice{0, kernel.size()})...),
+                                    UniformTag{}};
+                            }
+
                             OutputData output_data{partition_shape};
 
                             // rf, cf are indices of focal cell in array
@@ -969,532 +973,24 @@ namespace lue {
 
                             HPX_UNUSED(input_partitions);
 
-                            // For the first 3x3 collection of input partitions,
-                            // the shapes. We assume that the partitions in
-                            // the other collections have the same shape.
-                            using Shape = ShapeT<OutputPartition>;
-                            Array<Shape, 2> partition_shapes{Shape{{3, 3}}};
-
+                            if (output_partition_data.is_uniform() &&
+                                (meh::all_uniform(partition_data) && ...))
                             {
-                                // First array with 3x3 partition_data instances
-                                auto const first_partitions_data{
-                                    std::get<0>(std::make_tuple(partition_data...))};
-
-                                std::transform(
-                                    first_partitions_data.begin(),
-                                    first_partitions_data.end(),
-                                    partition_shapes.begin(),
-
-                                    [](auto const& data) -> auto { return data.shape(); }
-
-                                );
+                                // The neighbourhoods of all cells, including the border cells, are equal to
+                                // the ones of the inner cells
+                                return OutputPartition{
+                                    hpx::find_here(), offset, std::move(output_partition_data)};
                             }
 
-                            // Extents of the inner partition
-                            auto const [nr_elements0, nr_elements1] = partition_shapes(1, 1);
-
-                            // rf, cf are indices of focal cell in array
-                            // ck, ck are indices of first cell in array
-                            //     that is visible from kernel
-
-                            {
-                                // Four partitions are involved when calculating
-                                // the convolution for the corner cells. In this
-                                // object we store the views into these partitions
-                                // which are used to calculate the convolution for
-                                // a single focal cell.
-                                Array<Slices, 2> slices{{2, 2}};
-
-                                // Indices of the four partition views used in the corners
-                                // {row, col}, {north-west, ..., south-west}, {begin, end}
-                                // → {idx0,idx1}{nw,ne,se,sw}{b,e}
-                                Index rnwb, rnwe, cnwb, cnwe;
-                                Index rneb, rnee, cneb, cnee;
-                                Index rswb, rswe, cswb, cswe;
-                                Index rseb, rsee, cseb, csee;
-
-                                // North-west corner
-                                {
-                                    auto const& nw_shape{partition_shapes(0, 0)};
-                                    auto const& ne_shape{partition_shapes(0, 2)};
-                                    auto const& sw_shape{partition_shapes(2, 0)};
-
-                                    rnwb = nw_shape[0] - kernel.radius();
-                                    rnwe = nw_shape[0];
-                                    cnwe = nw_shape[1];
-
-                                    rneb = ne_shape[0] - kernel.radius();
-                                    rnee = ne_shape[0];
-                                    cneb = 0;
-
-                                    rswb = 0;
-                                    rswe = kernel.radius() + 1;
-                                    cswe = sw_shape[1];
-
-                                    rseb = 0;
-                                    rsee = kernel.radius() + 1;
-                                    cseb = 0;
-
-                                    for (Index rf = 0; rf < kernel.radius();
-                                         ++rf, ++rnwb, ++rneb, ++rswe, ++rsee)
-                                    {
-                                        cnwb = nw_shape[1] - kernel.radius();
-                                        cnee = kernel.radius() + 1;
-                                        cswb = sw_shape[1] - kernel.radius();
-                                        csee = kernel.radius() + 1;
-
-                                        for (Index cf = 0; cf < kernel.radius();
-                                             ++cf, ++cnwb, ++cnee, ++cswb, ++csee)
-                                        {
-                                            // NW partition view
-                                            slices(0, 0) = {Slice{rnwb, rnwe}, Slice{cnwb, cnwe}};
-                                            lue_hpx_assert(extent(slices(0, 0)[0]) > 0);
-                                            lue_hpx_assert(extent(slices(0, 0)[1]) > 0);
-                                            lue_hpx_assert(extent(slices(0, 0)[0]) <= kernel.radius());
-                                            lue_hpx_assert(extent(slices(0, 0)[1]) <= kernel.radius());
-
-                                            // NE partition view
-                                            slices(0, 1) = {Slice{rneb, rnee}, Slice{cneb, cnee}};
-                                            lue_hpx_assert(extent(slices(0, 1)[0]) > 0);
-                                            lue_hpx_assert(extent(slices(0, 1)[1]) > 0);
-                                            lue_hpx_assert(extent(slices(0, 1)[0]) <= kernel.radius());
-                                            lue_hpx_assert(extent(slices(0, 1)[1]) < kernel.size());
-
-                                            // SW partition view
-                                            slices(1, 0) = {Slice{rswb, rswe}, Slice{cswb, cswe}};
-                                            lue_hpx_assert(extent(slices(1, 0)[0]) > 0);
-                                            lue_hpx_assert(extent(slices(1, 0)[1]) > 0);
-                                            lue_hpx_assert(extent(slices(1, 0)[0]) < kernel.size());
-                                            lue_hpx_assert(extent(slices(1, 0)[1]) <= kernel.radius());
-
-                                            // SE partition view
-                                            slices(1, 1) = {Slice{rseb, rsee}, Slice{cseb, csee}};
-                                            lue_hpx_assert(extent(slices(1, 1)[0]) > 0);
-                                            lue_hpx_assert(extent(slices(1, 1)[1]) > 0);
-                                            lue_hpx_assert(extent(slices(1, 1)[0]) < kernel.size());
-                                            lue_hpx_assert(extent(slices(1, 1)[1]) < kernel.size());
-
-                                            output_partition_data(rf, cf) = detail::border(
-                                                functor,
-                                                kernel,
-                                                std::get<0>(policies.outputs_policies()),
-                                                policies.inputs_policies(),
-                                                // TODO(KDJ): how to only grab the span once, for all corner
-                                                // cells?
-                                                meh::subspans(
-                                                    nw_corner_partition_spans(partition_data), slices)...);
-                                        }
-                                    }
-                                }
-
-                                // North-east corner
-                                {
-                                    auto const& nw_shape{partition_shapes(0, 1)};
-                                    auto const& ne_shape{partition_shapes(0, 2)};
-                                    auto const& sw_shape{partition_shapes(1, 1)};
-
-                                    rnwb = nw_shape[0] - kernel.radius();
-                                    rnwe = nw_shape[0];
-                                    cnwe = nw_shape[1];
-
-                                    rneb = ne_shape[0] - kernel.radius();
-                                    rnee = ne_shape[0];
-                                    cneb = 0;
-
-                                    rswb = 0;
-                                    rswe = kernel.radius() + 1;
-                                    cswe = sw_shape[1];
-
-                                    rseb = 0;
-                                    rsee = kernel.radius() + 1;
-                                    cseb = 0;
-
-                                    for (Index rf = 0; rf < kernel.radius();
-                                         ++rf, ++rnwb, ++rneb, ++rswe, ++rsee)
-                                    {
-                                        cnwb = nw_shape[1] - (kernel.size() - 1);
-                                        cnee = cneb + 1;
-                                        csee = cseb + 1;
-                                        cswb = sw_shape[1] - (kernel.size() - 1);
-
-                                        for (Index cf = nr_elements1 - kernel.radius(); cf < nr_elements1;
-                                             ++cf, ++cnwb, ++cnee, ++cswb, ++csee)
-                                        {
-                                            // NW partition view
-                                            slices(0, 0) = {Slice{rnwb, rnwe}, Slice{cnwb, cnwe}};
-                                            lue_hpx_assert(extent(slices(0, 0)[0]) > 0);
-                                            lue_hpx_assert(extent(slices(0, 0)[1]) > 0);
-                                            lue_hpx_assert(extent(slices(0, 0)[0]) <= kernel.radius());
-                                            lue_hpx_assert(extent(slices(0, 0)[1]) < kernel.size());
-
-                                            // NE partition view
-                                            slices(0, 1) = {Slice{rneb, rnee}, Slice{cneb, cnee}};
-                                            lue_hpx_assert(extent(slices(0, 1)[0]) > 0);
-                                            lue_hpx_assert(extent(slices(0, 1)[1]) > 0);
-                                            lue_hpx_assert(extent(slices(0, 1)[0]) <= kernel.radius());
-                                            lue_hpx_assert(extent(slices(0, 1)[1]) <= kernel.radius());
-
-                                            // SW partition view
-                                            slices(1, 0) = {Slice{rswb, rswe}, Slice{cswb, cswe}};
-                                            lue_hpx_assert(extent(slices(1, 0)[0]) > 0);
-                                            lue_hpx_assert(extent(slices(1, 0)[1]) > 0);
-                                            lue_hpx_assert(extent(slices(1, 0)[0]) < kernel.size());
-                                            lue_hpx_assert(extent(slices(1, 0)[1]) < kernel.size());
-
-                                            // SE partition view
-                                            slices(1, 1) = {Slice{rseb, rsee}, Slice{cseb, csee}};
-                                            lue_hpx_assert(extent(slices(1, 1)[0]) > 0);
-                                            lue_hpx_assert(extent(slices(1, 1)[1]) > 0);
-                                            lue_hpx_assert(extent(slices(1, 1)[0]) < kernel.size());
-                                            lue_hpx_assert(extent(slices(1, 1)[1]) <= kernel.radius());
-
-                                            output_partition_data(rf, cf) = detail::border(
-                                                functor,
-                                                kernel,
-                                                std::get<0>(policies.outputs_policies()),
-                                                policies.inputs_policies(),
-                                                // TODO(KDJ): how to only grab the span once, for all corner
-                                                // cells?
-                                                meh::subspans(
-                                                    ne_corner_partition_spans(partition_data), slices)...);
-                                        }
-                                    }
-                                }
-
-                                // South-west corner
-                                {
-                                    auto const& nw_shape{partition_shapes(1, 0)};
-                                    auto const& ne_shape{partition_shapes(1, 1)};
-                                    auto const& sw_shape{partition_shapes(2, 0)};
-
-                                    rnwb = nw_shape[0] - (kernel.size() - 1);
-                                    rnwe = nw_shape[0];
-                                    cnwe = nw_shape[1];
-
-                                    rneb = ne_shape[0] - (kernel.size() - 1);
-                                    rnee = ne_shape[0];
-                                    cneb = 0;
-
-                                    rswb = 0;
-                                    rswe = rswb + 1;
-                                    cswe = sw_shape[1];
-
-                                    rseb = 0;
-                                    rsee = rseb + 1;
-                                    cseb = 0;
-
-                                    for (Index rf = nr_elements0 - kernel.radius(); rf < nr_elements0;
-                                         ++rf, ++rnwb, ++rneb, ++rswe, ++rsee)
-                                    {
-                                        cnwb = nw_shape[1] - kernel.radius();
-                                        cnee = kernel.radius() + 1;
-                                        cswb = sw_shape[1] - kernel.radius();
-                                        csee = kernel.radius() + 1;
-
-                                        for (Index cf = 0; cf < kernel.radius();
-                                             ++cf, ++cnwb, ++cnee, ++cswb, ++csee)
-                                        {
-
-                                            // NW partition view
-                                            slices(0, 0) = {Slice{rnwb, rnwe}, Slice{cnwb, cnwe}};
-                                            lue_hpx_assert(extent(slices(0, 0)[0]) > 0);
-                                            lue_hpx_assert(extent(slices(0, 0)[1]) > 0);
-                                            lue_hpx_assert(extent(slices(0, 0)[0]) < kernel.size());
-                                            lue_hpx_assert(extent(slices(0, 0)[1]) <= kernel.radius());
-
-                                            // NE partition view
-                                            slices(0, 1) = {Slice{rneb, rnee}, Slice{cneb, cnee}};
-                                            lue_hpx_assert(extent(slices(0, 1)[0]) > 0);
-                                            lue_hpx_assert(extent(slices(0, 1)[1]) > 0);
-                                            lue_hpx_assert(extent(slices(0, 1)[0]) < kernel.size());
-                                            lue_hpx_assert(extent(slices(0, 1)[1]) < kernel.size());
-
-                                            // SW partition view
-                                            slices(1, 0) = {Slice{rswb, rswe}, Slice{cswb, cswe}};
-                                            lue_hpx_assert(extent(slices(1, 0)[0]) > 0);
-                                            lue_hpx_assert(extent(slices(1, 0)[1]) > 0);
-                                            lue_hpx_assert(extent(slices(1, 0)[0]) <= kernel.radius());
-                                            lue_hpx_assert(extent(slices(1, 0)[1]) <= kernel.radius());
-
-                                            slices(1, 1) = {Slice{rseb, rsee}, Slice{cseb, csee}};
-                                            lue_hpx_assert(extent(slices(1, 1)[0]) > 0);
-                                            lue_hpx_assert(extent(slices(1, 1)[1]) > 0);
-                                            lue_hpx_assert(extent(slices(1, 1)[0]) <= kernel.radius());
-                                            lue_hpx_assert(extent(slices(1, 1)[1]) < kernel.size());
-
-                                            output_partition_data(rf, cf) = detail::border(
-                                                functor,
-                                                kernel,
-                                                std::get<0>(policies.outputs_policies()),
-                                                policies.inputs_policies(),
-                                                // TODO(KDJ): how to only grab the span once, for all corner
-                                                // cells?
-                                                meh::subspans(
-                                                    sw_corner_partition_spans(partition_data), slices)...);
-                                        }
-                                    }
-                                }
-
-                                // South-east corner
-                                {
-                                    auto const& nw_shape{partition_shapes(1, 1)};
-                                    auto const& ne_shape{partition_shapes(1, 2)};
-                                    auto const& sw_shape{partition_shapes(2, 1)};
-
-                                    rnwb = nw_shape[0] - (kernel.size() - 1);
-                                    rnwe = nw_shape[0];
-                                    cnwe = nw_shape[1];
-
-                                    rneb = ne_shape[0] - (kernel.size() - 1);
-                                    rnee = ne_shape[0];
-                                    cneb = 0;
-
-                                    rswb = 0;
-                                    rswe = rswb + 1;
-                                    cswe = sw_shape[1];
-
-                                    rseb = 0;
-                                    rsee = rseb + 1;
-                                    cseb = 0;
-
-                                    for (Index rf = nr_elements0 - kernel.radius(); rf < nr_elements0;
-                                         ++rf, ++rnwb, ++rneb, ++rswe, ++rsee)
-                                    {
-                                        cnwb = nw_shape[1] - (kernel.size() - 1);
-                                        cnee = cneb + 1;
-                                        cswb = sw_shape[1] - (kernel.size() - 1);
-                                        csee = cseb + 1;
-
-                                        for (Index cf = nr_elements1 - kernel.radius(); cf < nr_elements1;
-                                             ++cf, ++cnwb, ++cnee, ++cswb, ++csee)
-                                        {
-                                            // NW partition view
-                                            slices(0, 0) = {Slice{rnwb, rnwe}, Slice{cnwb, cnwe}};
-                                            lue_hpx_assert(extent(slices(0, 0)[0]) > 0);
-                                            lue_hpx_assert(extent(slices(0, 0)[1]) > 0);
-                                            lue_hpx_assert(extent(slices(0, 0)[0]) < kernel.size());
-                                            lue_hpx_assert(extent(slices(0, 0)[1]) < kernel.size());
-
-                                            // NE partition view
-                                            slices(0, 1) = {Slice{rneb, rnee}, Slice{cneb, cnee}};
-                                            lue_hpx_assert(extent(slices(0, 1)[0]) > 0);
-                                            lue_hpx_assert(extent(slices(0, 1)[1]) > 0);
-                                            lue_hpx_assert(extent(slices(0, 1)[0]) < kernel.size());
-                                            lue_hpx_assert(extent(slices(0, 1)[1]) <= kernel.radius());
-
-                                            // SW partition view
-                                            slices(1, 0) = {Slice{rswb, rswe}, Slice{cswb, cswe}};
-                                            lue_hpx_assert(extent(slices(1, 0)[0]) > 0);
-                                            lue_hpx_assert(extent(slices(1, 0)[1]) > 0);
-                                            lue_hpx_assert(extent(slices(1, 0)[0]) <= kernel.radius());
-                                            lue_hpx_assert(extent(slices(1, 0)[1]) < kernel.size());
-
-                                            // SE partition view
-                                            slices(1, 1) = {Slice{rseb, rsee}, Slice{cseb, csee}};
-                                            lue_hpx_assert(extent(slices(1, 1)[0]) > 0);
-                                            lue_hpx_assert(extent(slices(1, 1)[1]) > 0);
-                                            lue_hpx_assert(extent(slices(1, 1)[0]) <= kernel.radius());
-                                            lue_hpx_assert(extent(slices(1, 1)[1]) <= kernel.radius());
-
-                                            output_partition_data(rf, cf) = detail::border(
-                                                functor,
-                                                kernel,
-                                                std::get<0>(policies.outputs_policies()),
-                                                policies.inputs_policies(),
-                                                // TODO(KDJ): how to only grab the span once, for all corner
-                                                // cells?
-                                                meh::subspans(
-                                                    se_corner_partition_spans(partition_data), slices)...);
-                                        }
-                                    }
-                                }
-                            }
-
-                            {
-                                // Two partitions are involved when calculating
-                                // the convolution for the side cells.
-
-                                // North side
-                                {
-                                    Array<Slices, 2> slices{{2, 1}};
-
-                                    auto const& n_shape{partition_shapes(0, 1)};
-
-                                    Index rnb = n_shape[0] - kernel.radius();
-                                    Index const rne = n_shape[0];
-                                    Index const rsb = 0;
-                                    Index rse = kernel.radius() + 1;
-
-                                    for (Index rf = 0; rf < kernel.radius(); ++rf, ++rnb, ++rse)
-                                    {
-                                        for (Index cf = kernel.radius(), cb = 0;
-                                             cf < nr_elements1 - kernel.radius();
-                                             ++cf, ++cb)
-                                        {
-                                            // N partition view
-                                            slices(0, 0) = {Slice{rnb, rne}, Slice{cb, cb + kernel.size()}};
-                                            lue_hpx_assert(extent(slices(0, 0)[0]) > 0);
-                                            lue_hpx_assert(extent(slices(0, 0)[1]) > 0);
-                                            lue_hpx_assert(extent(slices(0, 0)[0]) <= kernel.radius());
-                                            lue_hpx_assert(extent(slices(0, 0)[1]) == kernel.size());
-
-                                            // S partition view
-                                            slices(1, 0) = {Slice{rsb, rse}, Slice{cb, cb + kernel.size()}};
-                                            lue_hpx_assert(extent(slices(1, 0)[0]) > 0);
-                                            lue_hpx_assert(extent(slices(1, 0)[1]) > 0);
-                                            lue_hpx_assert(extent(slices(1, 0)[0]) < kernel.size());
-                                            lue_hpx_assert(extent(slices(1, 0)[1]) == kernel.size());
-
-                                            output_partition_data(rf, cf) = detail::border(
-                                                functor,
-                                                kernel,
-                                                std::get<0>(policies.outputs_policies()),
-                                                policies.inputs_policies(),
-                                                // TODO(KDJ): how to only grab the span once, for all corner
-                                                // cells?
-                                                meh::subspans(
-                                                    n_side_partition_spans(partition_data), slices)...);
-                                        }
-                                    }
-                                }
-
-                                // West side
-                                {
-                                    Array<Slices, 2> slices{{1, 2}};
-
-                                    auto const& w_shape{partition_shapes(1, 0)};
-
-                                    Index const cwe = w_shape[1];
-                                    Index const ceb = 0;
-
-                                    for (Index rf = kernel.radius(), rb = 0;
-                                         rf < nr_elements0 - kernel.radius();
-                                         ++rf, ++rb)
-                                    {
-                                        Index cwb = w_shape[1] - kernel.radius();
-                                        Index cee = kernel.radius() + 1;
-
-                                        for (Index cf = 0; cf < kernel.radius(); ++cf, ++cwb, ++cee)
-                                        {
-                                            // W partition view
-                                            slices(0, 0) = {Slice{rb, rb + kernel.size()}, Slice{cwb, cwe}};
-                                            lue_hpx_assert(extent(slices(0, 0)[0]) > 0);
-                                            lue_hpx_assert(extent(slices(0, 0)[1]) > 0);
-                                            lue_hpx_assert(extent(slices(0, 0)[0]) == kernel.size());
-                                            lue_hpx_assert(extent(slices(0, 0)[1]) <= kernel.radius());
-
-                                            // E partition view
-                                            slices(0, 1) = {Slice{rb, rb + kernel.size()}, Slice{ceb, cee}};
-                                            lue_hpx_assert(extent(slices(0, 1)[0]) > 0);
-                                            lue_hpx_assert(extent(slices(0, 1)[1]) > 0);
-                                            lue_hpx_assert(extent(slices(0, 1)[0]) == kernel.size());
-                                            lue_hpx_assert(extent(slices(0, 1)[1]) < kernel.size());
-
-                                            output_partition_data(rf, cf) = detail::border(
-                                                functor,
-                                                kernel,
-                                                std::get<0>(policies.outputs_policies()),
-                                                policies.inputs_policies(),
-                                                // TODO(KDJ): how to only grab the span once, for all corner
-                                                // cells?
-                                                meh::subspans(
-                                                    w_side_partition_spans(partition_data), slices)...);
-                                        }
-                                    }
-                                }
-
-                                // East side
-                                {
-                                    Array<Slices, 2> slices{{1, 2}};
-
-                                    auto const& w_shape{partition_shapes(1, 1)};
-
-                                    Index const cwe = w_shape[1];
-                                    Index const ceb = 0;
-
-                                    for (Index rf = kernel.radius(), rb = 0;
-                                         rf < nr_elements0 - kernel.radius();
-                                         ++rf, ++rb)
-                                    {
-                                        Index cwb = w_shape[1] - (kernel.size() - 1);
-                                        Index cee = ceb + 1;
-
-                                        for (Index cf = nr_elements1 - kernel.radius(); cf < nr_elements1;
-                                             ++cf, ++cwb, ++cee)
-                                        {
-                                            // W partition view
-                                            slices(0, 0) = {Slice{rb, rb + kernel.size()}, Slice{cwb, cwe}};
-                                            lue_hpx_assert(extent(slices(0, 0)[0]) > 0);
-                                            lue_hpx_assert(extent(slices(0, 0)[1]) > 0);
-                                            lue_hpx_assert(extent(slices(0, 0)[0]) == kernel.size());
-                                            lue_hpx_assert(extent(slices(0, 0)[1]) < kernel.size());
-
-                                            // E partition view
-                                            slices(0, 1) = {Slice{rb, rb + kernel.size()}, Slice{ceb, cee}};
-                                            lue_hpx_assert(extent(slices(0, 1)[0]) > 0);
-                                            lue_hpx_assert(extent(slices(0, 1)[1]) > 0);
-                                            lue_hpx_assert(extent(slices(0, 1)[0]) == kernel.size());
-                                            lue_hpx_assert(extent(slices(0, 1)[1]) <= kernel.radius());
-
-                                            output_partition_data(rf, cf) = detail::border(
-                                                functor,
-                                                kernel,
-                                                std::get<0>(policies.outputs_policies()),
-                                                policies.inputs_policies(),
-                                                // TODO(KDJ): how to only grab the span once, for all corner
-                                                // cells?
-                                                meh::subspans(
-                                                    e_side_partition_spans(partition_data), slices)...);
-                                        }
-                                    }
-                                }
-
-                                // South side
-                                {
-                                    Array<Slices, 2> slices{{2, 1}};
-
-                                    auto const& n_shape{partition_shapes(1, 1)};
-
-                                    Index rnb = n_shape[0] - (kernel.size() - 1);
-                                    Index const rne = n_shape[0];
-
-                                    Index const rsb = 0;
-                                    Index rse = rsb + 1;
-
-                                    for (Index rf = nr_elements0 - kernel.radius(); rf < nr_elements0;
-                                         ++rf, ++rnb, ++rse)
-                                    {
-                                        for (Index cf = kernel.radius(), cb = 0;
-                                             cf < nr_elements1 - kernel.radius();
-                                             ++cf, ++cb)
-                                        {
-                                            // N partition view
-                                            slices(0, 0) = {Slice{rnb, rne}, Slice{cb, cb + kernel.size()}};
-                                            lue_hpx_assert(extent(slices(0, 0)[0]) > 0);
-                                            lue_hpx_assert(extent(slices(0, 0)[1]) > 0);
-                                            lue_hpx_assert(extent(slices(0, 0)[0]) < kernel.size());
-                                            lue_hpx_assert(extent(slices(0, 0)[1]) == kernel.size());
-
-                                            // S partition view
-                                            slices(1, 0) = {Slice{rsb, rse}, Slice{cb, cb + kernel.size()}};
-                                            lue_hpx_assert(extent(slices(1, 0)[0]) > 0);
-                                            lue_hpx_assert(extent(slices(1, 0)[1]) > 0);
-                                            lue_hpx_assert(extent(slices(1, 0)[0]) <= kernel.radius());
-                                            lue_hpx_assert(extent(slices(1, 0)[1]) == kernel.size());
-
-                                            output_partition_data(rf, cf) = detail::border(
-                                                functor,
-                                                kernel,
-                                                std::get<0>(policies.outputs_policies()),
-                                                policies.inputs_policies(),
-                                                // TODO(KDJ): how to only grab the span once, for all corner
-                                                // cells?
-                                                meh::subspans(
-                                                    s_side_partition_spans(partition_data), slices)...);
-                                        }
-                                    }
-                                }
-                            }
+                            // Copy the elements of the center partitions and their halos into padded tiles
+                            // once. The results for the cells along the sides are then calculated in the
+                            // same way as the ones for the inner cells, using windows into these tiles.
+                            meh::focal_operation_band(
+                                policies,
+                                kernel,
+                                functor,
+                                output_partition_data,
+                                meh::padded_tile(partition_data, kernel.radius())...);
 
                             // Done, create and return the output partition --------
                             return OutputPartition{
@@ -1655,6 +1151,8 @@ namespace lue {
 
                 using Shape = ShapeT<InputArray>;
 
+                using Halos = typename HaloStore<InputElement, lue::rank<InputArray>>::Halos;
+
 
                 WrappedPartitionedArray(
                     InputPolicies const& input_policies, InputArray const& array, Radius const kernel_radius):
@@ -1662,7 +1160,8 @@ namespace lue {
                     _input_policies{input_policies},
                     _array{array},
                     _kernel_radius{kernel_radius},
-                    _halo_partitions{}
+                    _halo_partitions{},
+                    _halos{}
 
                 {
                     create_halo_partitions();
@@ -1677,60 +1176,123 @@ namespace lue {
 
                 auto north_west_corner_input_partitions() const -> InputPartitions
                 {
-                    return detail::north_west_corner_input_partitions(_array.partitions(), _halo_partitions);
+                    return with_halo(
+                        detail::north_west_corner_input_partitions(_array.partitions(), _halo_partitions),
+                        0,
+                        0);
                 }
 
 
                 auto north_east_corner_input_partitions() const -> InputPartitions
                 {
-                    return detail::north_east_corner_input_partitions(_array.partitions(), _halo_partitions);
+                    Count const nr_partitions1{std::get<1>(_array.partitions().shape())};
+
+                    return with_halo(
+                        detail::north_east_corner_input_partitions(_array.partitions(), _halo_partitions),
+                        0,
+                        nr_partitions1 - 1);
                 }
 
 
                 auto south_west_corner_input_partitions() const -> InputPartitions
                 {
-                    return detail::south_west_corner_input_partitions(_array.partitions(), _halo_partitions);
+                    Count const nr_partitions0{std::get<0>(_array.partitions().shape())};
+
+                    return with_halo(
+                        detail::south_west_corner_input_partitions(_array.partitions(), _halo_partitions),
+                        nr_partitions0 - 1,
+                        0);
                 }
 
 
                 auto south_east_corner_input_partitions() const -> InputPartitions
                 {
-                    return detail::south_east_corner_input_partitions(_array.partitions(), _halo_partitions);
+                    auto const [nr_partitions0, nr_partitions1] = _array.partitions().shape();
+
+                    return with_halo(
+                        detail::south_east_corner_input_partitions(_array.partitions(), _halo_partitions),
+                        nr_partitions0 - 1,
+                        nr_partitions1 - 1);
                 }
 
 
                 auto north_side_input_partitions(Index const idx1) const -> InputPartitions
                 {
-                    return detail::north_side_input_partitions(idx1, _array.partitions(), _halo_partitions);
+                    return with_halo(
+                        detail::north_side_input_partitions(idx1, _array.partitions(), _halo_partitions),
+                        0,
+                        idx1);
                 }
 
 
                 auto south_side_input_partitions(Index const idx1) const -> InputPartitions
                 {
-                    return detail::south_side_input_partitions(idx1, _array.partitions(), _halo_partitions);
+                    Count const nr_partitions0{std::get<0>(_array.partitions().shape())};
+
+                    return with_halo(
+                        detail::south_side_input_partitions(idx1, _array.partitions(), _halo_partitions),
+                        nr_partitions0 - 1,
+                        idx1);
                 }
 
 
                 auto west_side_input_partitions(Index const idx0) const -> InputPartitions
                 {
-                    return detail::west_side_input_partitions(idx0, _array.partitions(), _halo_partitions);
+                    return with_halo(
+                        detail::west_side_input_partitions(idx0, _array.partitions(), _halo_partitions),
+                        idx0,
+                        0);
                 }
 
 
                 auto east_side_input_partitions(Index const idx0) const -> InputPartitions
                 {
-                    return detail::east_side_input_partitions(idx0, _array.partitions(), _halo_partitions);
+                    Count const nr_partitions1{std::get<1>(_array.partitions().shape())};
+
+                    return with_halo(
+                        detail::east_side_input_partitions(idx0, _array.partitions(), _halo_partitions),
+                        idx0,
+                        nr_partitions1 - 1);
                 }
 
 
                 auto inner_input_partitions(Index const idx0, Index const idx1) const -> InputPartitions
                 {
-                    return detail::inner_input_partitions(idx0, idx1, _array.partitions());
+                    return with_halo(
+                        detail::inner_input_partitions(idx0, idx1, _array.partitions()), idx0, idx1);
                 }
 
 
             private:
 
+                /*!
+                    @brief      Replace the neighbours in the collection of @a partitions surrounding
+                                partition (@a idx0, @a idx1) by the partitions in its halo
+
+                    The halo's partitions contain the borders of the neighbours facing the partition
+                    and are located in the same locality, which avoids copying elements between
+                    localities each time a focal operation is performed.
+                */
+                auto with_halo(InputPartitions&& partitions, Index const idx0, Index const idx1) const
+                    -> InputPartitions
+                {
+                    auto const& halo{_halos(idx0, idx1)};
+
+                    for (Index position0 = 0; position0 < 3; ++position0)
+                    {
+                        for (Index position1 = 0; position1 < 3; ++position1)
+                        {
+                            if (halo(position0, position1).valid())
+                            {
+                                partitions(position0, position1) = halo(position0, position1);
+                            }
+                        }
+                    }
+
+                    return std::move(partitions);
+                }
+
+
                 void create_halo_partitions()
                 {
                     static_assert(lue::rank<InputArray> == 2);
@@ -1744,6 +1306,7 @@ namespace lue {
 
                     _halo_partitions =
                         detail::halo_partitions(_input_policies, localities, min_shape, input_partitions);
+                    _halos = detail::halos(_array, _kernel_radius);
                 }
 
 
@@ -1753,7 +1316,11 @@ namespace lue {
 
                 Radius const _kernel_radius;
 
+                //! Partitions containing the no-data or fill values surrounding the array
                 std::array<InputPartitions, 3> _halo_partitions;
+
+                //! Per partition, partitions containing the borders of its neighbours
+                Halos _halos;
         };
 
 
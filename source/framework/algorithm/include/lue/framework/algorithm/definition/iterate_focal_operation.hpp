@@ -0,0 +1,351 @@
+#pragma once
+#include "lue/framework/algorithm/definition/focal_operation.hpp"
+#include <type_traits>
+
+
+namespace lue {
+    namespace detail {
+
+        /*!
+            @brief      Sides of a partition which coincide with the sides of the array: north, south,
+                        west, east
+        */
+        using ArraySides = std::array<bool, 4>;
+
+
+        /*!
+            @brief      Return the value the halo is filled with at position (@a position0, @a position1)
+                        in the 3x3 collection of partitions surrounding a partition
+            @param      outside0 Whether the position is located outside of the array along the first
+                        dimension
+            @param      outside1 Idem, along the second dimension
+        */
+        template<typename HaloPolicy>
+        auto fill_value_outside_array(
+            HaloPolicy const& halo_policy,
+            bool const outside0,
+            bool const outside1,
+            Index const position0,
+            Index const position1)
+        {
+            lue_hpx_assert(outside0 || outside1);
+
+            if (outside0 && outside1)
+            {
+                if (position0 == 0)
+                {
+                    return position1 == 0 ? halo_policy.north_west_corner() : halo_policy.north_east_corner();
+                }
+
+                return position1 == 0 ? halo_policy.south_west_corner() : halo_policy.south_east_corner();
+            }
+
+            if (outside0)
+            {
+                return position0 == 0 ? halo_policy.north_side() : halo_policy.south_side();
+            }
+
+            return position1 == 0 ? halo_policy.west_side() : halo_policy.east_side();
+        }
+
+
+        /*!
+            @brief      Reset the cells in @a tile which are located outside of the array to the halo's
+                        fill values
+            @param      margin Number of cells surrounding the partition's cells in @a tile
+            @param      partition_shape Shape of the partition surrounded by the margin
+
+            After each iteration, the cells outside of the array must again contain the values the
+            halo was filled with, like they do at the start of each regular focal operation.
+        */
+        template<typename Element, typename HaloPolicy, typename Shape>
+        void reset_cells_outside_array(
+            Array<Element, 2>& tile,
+            Radius const margin,
+            Shape const& partition_shape,
+            ArraySides const& array_sides,
+            HaloPolicy const& halo_policy)
+        {
+            auto const [nr_elements0, nr_elements1] = partition_shape;
+            auto const [north, south, west, east] = array_sides;
+
+            // Per dimension, the begin and end indices of the 3 blocks within the tile
+            std::array<Index, 4> const bounds0{0, margin, margin + nr_elements0, (2 * margin) + nr_elements0};
+            std::array<Index, 4> const bounds1{0, margin, margin + nr_elements1, (2 * margin) + nr_elements1};
+
+            for (Index position0 = 0; position0 < 3; ++position0)
+            {
+                bool const outside0{(position0 == 0 && north) || (position0 == 2 && south)};
+
+                for (Index position1 = 0; position1 < 3; ++position1)
+                {
+                    bool const outside1{(position1 == 0 && west) || (position1 == 2 && east)};
+
+                    if (!(outside0 || outside1))
+                    {
+                        continue;
+                    }
+
+                    Element const fill_value{
+                        fill_value_outside_array(halo_policy, outside0, outside1, position0, position1)};
+
+                    for (Index idx0 = bounds0[position0]; idx0 < bounds0[position0 + 1]; ++idx0)
+                    {
+                        for (Index idx1 = bounds1[position1]; idx1 < bounds1[position1 + 1]; ++idx1)
+                        {
+                            tile(idx0, idx1) = fill_value;
+                        }
+                    }
+                }
+            }
+        }
+
+
+        /*!
+            @brief      Apply a focal operation @a nr_iterations times to the partition in the center
+                        of @a input_partitions
+            @param      input_partitions Center partition and its 8 neighbours, or the partitions
+                        containing the fill values if the center partition is located at the array's
+                        side
+            @param      array_sides Sides of the center partition which coincide with the array's sides
+
+            The halo read from the neighbours is @a nr_iterations times the kernel radius wide. Each
+            iteration calculates results for a region which is one kernel radius smaller on all sides
+            than the region of the previous one. The last iteration calculates the results for the
+            partition itself.
+        */
+        template<
+            typename Policies,
+            typename OutputPartition,
+            typename Kernel,
+            typename Functor,
+            typename InputPartitions>
+        auto iterate_focal_operation_partition(
+            Policies const& policies,
+            InputPartitions const& input_partitions,
+            ArraySides const& array_sides,
+            Kernel const& kernel,
+            Functor const& functor,
+            Count const nr_iterations) -> OutputPartition
+        {
+            using Element = ElementT<OutputPartition>;
+            using OutputData = DataT<OutputPartition>;
+            using Offset = OffsetT<OutputPartition>;
+            using Shape = ShapeT<OutputPartition>;
+            using Slice = SliceT<OutputPartition>;
+
+            auto const& input_policies{std::get<0>(policies.inputs_policies())};
+            Radius const halo_radius{nr_iterations * kernel.radius()};
+
+            WrappedArrayPartitions const wrapped_partitions{input_policies, input_partitions, halo_radius};
+
+            return hpx::dataflow(
+                hpx::launch::async,
+                hpx::unwrapping(
+
+                    [policies, input_partitions, array_sides, kernel, functor, nr_iterations, halo_radius](
+                        Offset const& offset,
+                        Array<meh::InputData<InputPartitions>, 2> const& partition_data) -> OutputPartition
+                    {
+                        AnnotateFunction const annotation{
+                            std::format("{}: iterate partition", functor_name<Functor>)};
+
+                        HPX_UNUSED(input_partitions);
+
+                        Shape const partition_shape{partition_data(1, 1).shape()};
+                        auto const [nr_elements0, nr_elements1] = partition_shape;
+
+                        verify_partition_large_enough(nr_elements0, nr_elements1, kernel.size());
+
+                        Count const size{kernel.size()};
+                        Array<Element, 2> tile{meh::padded_tile(partition_data, halo_radius)};
+
+                        for (Count iteration = 1; iteration <= nr_iterations; ++iteration)
+                        {
+                            Radius const margin{halo_radius - (iteration * kernel.radius())};
+                            Count const nr_results0{nr_elements0 + (2 * margin)};
+                            Count const nr_results1{nr_elements1 + (2 * margin)};
+
+                            Array<Element, 2> results{Shape{{nr_results0, nr_results1}}};
+
+                            for (Index idx0 = 0; idx0 < nr_results0; ++idx0)
+                            {
+                                for (Index idx1 = 0; idx1 < nr_results1; ++idx1)
+                                {
+                                    results(idx0, idx1) = detail::inner(
+                                        functor,
+                                        kernel,
+                                        std::get<0>(policies.outputs_policies()),
+                                        policies.inputs_policies(),
+                                        std::index_sequence<0>{},
+                                        submdspan(
+                                            tile.span(), Slice{idx0, idx0 + size}, Slice{idx1, idx1 + size}));
+                                }
+                            }
+
+                            if (margin > 0)
+                            {
+                                reset_cells_outside_array(
+                                    results,
+                                    margin,
+                                    partition_shape,
+                                    array_sides,
+                                    std::get<0>(policies.inputs_policies()).halo_policy());
+                            }
+
+                            tile = std::move(results);
+                        }
+
+                        OutputData output_data{partition_shape};
+
+                        std::copy(tile.begin(), tile.end(), output_data.begin());
+
+                        return OutputPartition{hpx::find_here(), offset, std::move(output_data)};
+                    }
+
+                    ),
+                meh::input_partition(wrapped_partitions, 1, 1).offset(hpx::launch::async),
+                meh::get_partition_data(wrapped_partitions));
+        }
+
+
+        template<
+            typename Policies,
+            typename OutputPartition,
+            typename Kernel,
+            typename Functor,
+            typename InputPartitions>
+        struct IterateFocalOperationPartitionAction:
+            hpx::actions::make_action<
+                decltype(&iterate_focal_operation_partition<
+                         Policies,
+                         OutputPartition,
+                         Kernel,
+                         Functor,
+                         InputPartitions>),
+                &iterate_focal_operation_partition<
+                    Policies,
+                    OutputPartition,
+                    Kernel,
+                    Functor,
+                    InputPartitions>,
+                IterateFocalOperationPartitionAction<
+                    Policies,
+                    OutputPartition,
+                    Kernel,
+                    Functor,
+                    InputPartitions>>::type
+        {
+        };
+
+    }  // namespace detail
+
+
+    /*!
+        @brief      Apply a focal operation @a nr_iterations times in succession to @a array
+        @param      nr_iterations Number of times to apply the operation. Must be at least one.
+        @return     The same result as calling focal_operation() @a nr_iterations times, passing in the
+                    result of the previous call
+        @exception  std::runtime_error In case @a nr_iterations is smaller than one
+        @exception  std::runtime_error In case the partitions are too small for a halo of
+                    @a nr_iterations times the kernel radius
+
+        Instead of exchanging a halo of kernel radius cells wide with the neighbouring partitions
+        each iteration, a halo of @a nr_iterations times the kernel radius is exchanged once. The
+        iterations are then performed locally, each one calculating results for a region that is
+        one kernel radius smaller on all sides. This trades some redundant calculations near the
+        partition's sides for fewer, larger messages. This is useful for models that apply the same
+        focal operation many times, like diffusion and cellular automata.
+    */
+    template<typename Policies, typename Element, typename Kernel, typename Functor>
+    auto iterate_focal_operation(
+        Policies const& policies,
+        PartitionedArray<Element, 2> const& array,
+        Kernel const& kernel,
+        Functor functor,
+        Count const nr_iterations) -> PartitionedArray<Element, 2>
+    {
+        static_assert(std::is_same_v<detail::OutputElementT<Functor>, Element>);
+        static_assert(rank<Kernel> == 2);
+
+        using OutputArray = PartitionedArray<Element, 2>;
+        using Partitions = PartitionsT<OutputArray>;
+        using Partition = PartitionT<OutputArray>;
+
+        if (nr_iterations < 1)
+        {
+            throw std::runtime_error(
+                std::format("Number of iterations must be at least 1, but it is {}", nr_iterations));
+        }
+
+        if (array.nr_elements() == 0)
+        {
+            return OutputArray{};
+        }
+
+        detail::WrappedPartitionedArray const wrapped_array{
+            std::get<0>(policies.inputs_policies()), array, nr_iterations * kernel.radius()};
+
+        detail::IterateFocalOperationPartitionAction<Policies, Partition, Kernel, Functor, Partitions>
+            action;
+
+        Localities<2> const& localities{array.localities()};
+        auto const [nr_partitions0, nr_partitions1] = lue::shape_in_partitions(array);
+        Partitions output_partitions{lue::shape_in_partitions(array)};
+
+        // Same selection of the collection of input partitions as in focal_operation_2d
+        auto const input_partitions = [&](Index const idx0, Index const idx1) -> Partitions
+        {
+            bool const north{idx0 == 0};
+            bool const south{idx0 == nr_partitions0 - 1};
+            bool const west{idx1 == 0};
+            bool const east{idx1 == nr_partitions1 - 1};
+
+            return north && west   ? wrapped_array.north_west_corner_input_partitions()
+                   : north && east ? wrapped_array.north_east_corner_input_partitions()
+                   : south && west ? wrapped_array.south_west_corner_input_partitions()
+                   : south && east ? wrapped_array.south_east_corner_input_partitions()
+                   : north         ? wrapped_array.north_side_input_partitions(idx1)
+                   : south         ? wrapped_array.south_side_input_partitions(idx1)
+                   : west          ? wrapped_array.west_side_input_partitions(idx0)
+                   : east          ? wrapped_array.east_side_input_partitions(idx0)
+                                   : wrapped_array.inner_input_partitions(idx0, idx1);
+        };
+
+        for (Index idx0 = 0; idx0 < nr_partitions0; ++idx0)
+        {
+            for (Index idx1 = 0; idx1 < nr_partitions1; ++idx1)
+            {
+                detail::ArraySides const array_sides{
+                    idx0 == 0, idx0 == nr_partitions0 - 1, idx1 == 0, idx1 == nr_partitions1 - 1};
+
+                output_partitions(idx0, idx1) =
+                    detail::when_all_get(input_partitions(idx0, idx1))
+                        .then(
+                            hpx::unwrapping(
+                                [locality_id = localities(idx0, idx1),
+                                 action,
+                                 policies,
+                                 array_sides,
+                                 kernel,
+                                 functor,
+                                 nr_iterations](Partitions&& input_partitions) -> Partition
+                                {
+                                    return action(
+                                        locality_id,
+                                        policies,
+                                        std::move(input_partitions),
+                                        array_sides,
+                                        kernel,
+                                        functor,
+                                        nr_iterations);
+                                }
+
+                                ));
+            }
+        }
+
+        return {array, std::move(output_partitions)};
+    }
+
+}  // namespace lue
@@ -5,11 +5,32 @@
 #include "lue/framework/algorithm/routing_operation_export.hpp"
 #include "lue/macro.hpp"
 #include <boost/math/tools/roots.hpp>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
 
 
 namespace lue {
     namespace detail {
 
+        //! Number of digits of the new discharge the solver iterates to
+        template<std::floating_point FloatingPoint>
+        constexpr int new_discharge_digits{
+            static_cast<int>(std::numeric_limits<FloatingPoint>::digits * 0.6)};
+
+
+        // In general, 2-3 iterations are enough. In rare cases more are needed. The unit tests don't
+        // seem to reach 8, so max 10 should be enough. This max is used in special cases:
+        // - upstream_discharge + current_discharge == 0 and beta <  1
+        constexpr std::uintmax_t max_nr_new_discharge_iterations{10};
+
+
+        template<std::floating_point FloatingPoint>
+        class NonLinearKinematicWaveBatch;
+
+
         template<std::floating_point FloatingPoint>
         class NonLinearKinematicWave
         {
@@ -30,6 +51,7 @@ namespace lue {
                     _lateral_inflow{lateral_inflow},
                     _alpha{alpha},
                     _beta{beta},
+                    _beta_minus_one{_beta - FloatingPoint{1}},
                     _alpha_beta{_alpha * _beta},
                     _time_step_duration{time_step_duration}
 
@@ -71,7 +93,7 @@ namespace lue {
                         FloatingPoint const a_b_pq =
                             _alpha_beta * std::pow(
                                               (_current_discharge + _upstream_discharge) / FloatingPoint{2},
-                                              _beta - FloatingPoint{1});
+                                              _beta_minus_one);
 
                         lue_hpx_assert(!std::isnan(a_b_pq));
 
@@ -91,10 +113,27 @@ namespace lue {
                 }
 
 
+                /*!
+                    @brief      Return fq and dfq for @a new_discharge
+
+                    This is called by the solver in each iteration. Both functions share the
+                    expensive part: new_discharge^beta equals new_discharge * new_discharge^(beta - 1).
+                    The latter is computed as exp((beta - 1) * log(new_discharge)), like
+                    NonLinearKinematicWaveBatch does. This keeps the results of both solvers the same.
+                */
                 auto operator()(FloatingPoint const new_discharge) const
                     -> std::pair<FloatingPoint, FloatingPoint>
                 {
-                    return std::make_pair(fq(new_discharge), dfq(new_discharge));
+                    lue_hpx_assert(new_discharge > FloatingPoint{0});  // log(0) is not defined
+
+                    FloatingPoint const discharge_pow_beta_minus_one{
+                        std::exp(_beta_minus_one * std::log(new_discharge))};
+
+                    return std::make_pair(
+                        (_time_step_duration_over_channel_length * new_discharge) +
+                            (_alpha * new_discharge * discharge_pow_beta_minus_one) - _known_terms,
+                        _time_step_duration_over_channel_length +
+                            (_alpha_beta * discharge_pow_beta_minus_one));
                 }
 
 
@@ -112,12 +151,14 @@ namespace lue {
                     lue_hpx_assert(new_discharge > FloatingPoint{0});  // pow(0, -) is not defined
 
                     return _time_step_duration_over_channel_length +
-                           (_alpha_beta * std::pow(new_discharge, _beta - FloatingPoint{1}));
+                           (_alpha_beta * std::pow(new_discharge, _beta_minus_one));
                 }
 
 
             private:
 
+                friend class NonLinearKinematicWaveBatch<FloatingPoint>;
+
                 //! Updated / new discharge in the upstream cell
                 FloatingPoint _upstream_discharge;
 
@@ -132,6 +173,8 @@ namespace lue {
                 //! Momentum coefficient / Boussinesq coefficient [1.01, 1.33] (Chow, p278)
                 FloatingPoint _beta;
 
+                FloatingPoint _beta_minus_one;
+
                 FloatingPoint _alpha_beta;
 
                 FloatingPoint _time_step_duration;
@@ -142,6 +185,242 @@ namespace lue {
         };
 
 
+        /*!
+            @brief      Collection of independent kinematic wave equations, solved together
+
+            The equations are solved using the same Newton-Raphson steps as
+            boost::math::tools::newton_raphson_iterate, which iterate_to_new_discharge() uses for a
+            single equation. Instead of iterating to the solution of each equation in turn, each
+            iteration performs a step for all equations that have not converged yet. The state of the
+            equations is stored per coefficient, in contiguous arrays.
+        */
+        template<std::floating_point FloatingPoint>
+        class NonLinearKinematicWaveBatch
+        {
+
+            public:
+
+                explicit NonLinearKinematicWaveBatch(std::size_t const capacity)
+                {
+                    for (auto* values : {
+                             &_time_step_duration_over_channel_length,
+                             &_alpha,
+                             &_alpha_beta,
+                             &_beta_minus_one,
+                             &_known_terms,
+                             &_new_discharge})
+                    {
+                        values->reserve(capacity);
+                    }
+                }
+
+
+                void push_back(NonLinearKinematicWave<FloatingPoint> const& kinematic_wave)
+                {
+                    _time_step_duration_over_channel_length.push_back(
+                        kinematic_wave._time_step_duration_over_channel_length);
+                    _alpha.push_back(kinematic_wave._alpha);
+                    _alpha_beta.push_back(kinematic_wave._alpha_beta);
+                    _beta_minus_one.push_back(kinematic_wave._beta_minus_one);
+                    _known_terms.push_back(kinematic_wave._known_terms);
+                    _new_discharge.push_back(kinematic_wave.guess());
+                }
+
+
+                [[nodiscard]] auto size() const -> std::size_t
+                {
+                    return _new_discharge.size();
+                }
+
+
+                /*!
+                    @brief      Iterate to the new discharges of all equations
+                    @return     New discharges, in the order in which the equations were added
+                */
+                auto iterate_to_new_discharges() -> std::span<FloatingPoint const>
+                {
+                    iterate([this](std::size_t const idx) -> FloatingPoint { return _beta_minus_one[idx]; });
+
+                    return _new_discharge;
+                }
+
+
+                /*!
+                    @overload
+
+                    All equations must share the same @a beta. Its value is used for all of them,
+                    instead of looking up the value per equation.
+                */
+                auto iterate_to_new_discharges(FloatingPoint const beta) -> std::span<FloatingPoint const>
+                {
+                    FloatingPoint const beta_minus_one{beta - FloatingPoint{1}};
+
+                    lue_hpx_assert(std::ranges::all_of(
+                        _beta_minus_one,
+                        [beta_minus_one](FloatingPoint const value) { return value == beta_minus_one; }));
+
+                    iterate([beta_minus_one]([[maybe_unused]] std::size_t const idx) -> FloatingPoint
+                            { return beta_minus_one; });
+
+                    return _new_discharge;
+                }
+
+
+            private:
+
+                template<typename BetaMinusOne>
+                void iterate(BetaMinusOne const& beta_minus_one)
+                {
+                    std::size_t const nr_equations{size()};
+
+                    // See boost::math::tools::newton_raphson_iterate for the meaning of these. Each
+                    // equation starts with the bracket used by iterate_to_new_discharge().
+                    FloatingPoint const factor{
+                        std::ldexp(FloatingPoint{1}, 1 - new_discharge_digits<FloatingPoint>)};
+                    FloatingPoint const max_discharge{std::numeric_limits<FloatingPoint>::max()};
+
+                    std::vector<FloatingPoint> delta(nr_equations, max_discharge);
+                    std::vector<FloatingPoint> delta1(nr_equations, max_discharge);
+                    std::vector<FloatingPoint> delta2(nr_equations, max_discharge);
+                    std::vector<FloatingPoint> min(nr_equations, FloatingPoint{0});
+                    std::vector<FloatingPoint> max(nr_equations, max_discharge);
+                    std::vector<std::uint8_t> converged(nr_equations, 0);
+                    std::size_t nr_converged{0};
+
+                    for (std::uintmax_t iteration = 0;
+                         iteration < max_nr_new_discharge_iterations && nr_converged < nr_equations;
+                         ++iteration)
+                    {
+                        for (std::size_t idx = 0; idx < nr_equations; ++idx)
+                        {
+                            if (converged[idx] != 0)
+                            {
+                                continue;
+                            }
+
+                            FloatingPoint result{_new_discharge[idx]};
+
+                            // Evaluate fq and dfq, like NonLinearKinematicWave::operator()
+                            FloatingPoint const discharge_pow_beta_minus_one{
+                                std::exp(beta_minus_one(idx) * std::log(result))};
+                            FloatingPoint const f0{
+                                (_time_step_duration_over_channel_length[idx] * result) +
+                                (_alpha[idx] * result * discharge_pow_beta_minus_one) - _known_terms[idx]};
+                            FloatingPoint const f1{
+                                _time_step_duration_over_channel_length[idx] +
+                                (_alpha_beta[idx] * discharge_pow_beta_minus_one)};
+
+                            delta2[idx] = delta1[idx];
+                            delta1[idx] = delta[idx];
+
+                            if (f0 == FloatingPoint{0})
+                            {
+                                converged[idx] = 1;
+                                ++nr_converged;
+                                continue;
+                            }
+
+                            // dfq is always positive
+                            delta[idx] = f0 / f1;
+
+                            if (std::abs(delta[idx] * 2) > std::abs(delta2[idx]))
+                            {
+                                // Last two steps haven't converged
+                                FloatingPoint const shift{
+                                    delta[idx] > 0 ? (result - min[idx]) / 2 : (result - max[idx]) / 2};
+
+                                delta[idx] = result != 0 && std::abs(shift) > std::abs(result)
+                                                 ? std::copysign(std::abs(result) * 1.1f, delta[idx])
+                                                 : shift;
+                                delta1[idx] = 3 * delta[idx];
+                                delta2[idx] = 3 * delta[idx];
+                            }
+
+                            FloatingPoint const guess{result};
+                            bool at_bound{false};
+
+                            result -= delta[idx];
+
+                            if (result <= min[idx] || result >= max[idx])
+                            {
+                                FloatingPoint const bound{result <= min[idx] ? min[idx] : max[idx]};
+
+                                delta[idx] = 0.5F * (guess - bound);
+                                result = guess - delta[idx];
+                                at_bound = result == min[idx] || result == max[idx];
+                            }
+
+                            if (!at_bound)
+                            {
+                                // Update brackets
+                                (delta[idx] > 0 ? max[idx] : min[idx]) = guess;
+                            }
+
+                            _new_discharge[idx] = result;
+
+                            if (at_bound || !(std::abs(result * factor) < std::abs(delta[idx])))
+                            {
+                                converged[idx] = 1;
+                                ++nr_converged;
+                            }
+                        }
+                    }
+                }
+
+
+                std::vector<FloatingPoint> _time_step_duration_over_channel_length;
+
+                std::vector<FloatingPoint> _alpha;
+
+                std::vector<FloatingPoint> _alpha_beta;
+
+                std::vector<FloatingPoint> _beta_minus_one;
+
+                std::vector<FloatingPoint> _known_terms;
+
+                std::vector<FloatingPoint> _new_discharge;
+        };
+
+
+        /*!
+            @brief      Return whether a cell receives water, from upstream and/or from an external
+                        source
+        */
+        template<std::floating_point FloatingPoint>
+        auto receives_water(
+            FloatingPoint const upstream_discharge,
+            FloatingPoint const current_discharge,
+            FloatingPoint const lateral_inflow) -> bool
+        {
+            return upstream_discharge + current_discharge > 0 || lateral_inflow > 0;
+        }
+
+
+        /*!
+            @brief      Subtract the extraction represented by a negative @a lateral_inflow from
+                        @a new_discharge, as far as possible
+        */
+        template<std::floating_point FloatingPoint>
+        auto subtract_extraction(
+            FloatingPoint new_discharge,
+            FloatingPoint const lateral_inflow,
+            FloatingPoint const channel_length) -> FloatingPoint
+        {
+            if (lateral_inflow < FloatingPoint{0})
+            {
+                // Convert units: m³ / m / s → m³ / s
+                FloatingPoint const extraction{
+                    std::min(channel_length * std::abs(lateral_inflow), new_discharge)};
+
+                new_discharge -= extraction;
+            }
+
+            lue_hpx_assert(new_discharge >= FloatingPoint{0});
+
+            return new_discharge;
+        }
+
+
         template<std::floating_point FloatingPoint>
         auto iterate_to_new_discharge(
             FloatingPoint const upstream_discharge,  // Summed discharge for cells draining into current cell
@@ -174,7 +453,7 @@ namespace lue {
 
             FloatingPoint new_discharge{0};
 
-            if (upstream_discharge + current_discharge > 0 || lateral_inflow > 0)
+            if (receives_water(upstream_discharge, current_discharge, lateral_inflow))
             {
                 // The cell receives water, from upstream and/or from an external source
                 FloatingPoint const inflow = lateral_inflow >= 0 ? lateral_inflow : FloatingPoint{0};
@@ -194,13 +473,8 @@ namespace lue {
                 // bounds min and max may as well be set to the widest limits"
                 FloatingPoint const min_discharge{0};
                 FloatingPoint const max_discharge{std::numeric_limits<FloatingPoint>::max()};
-                int const digits = static_cast<int>(std::numeric_limits<FloatingPoint>::digits * 0.6);
-
-                // In general, 2-3 iterations are enough. In rare cases more are needed. The unit tests don't
-                // seem to reach 8, so max 10 should be enough. This max is used in special cases:
-                // - upstream_discharge + current_discharge == 0 and beta <  1
-                std::uintmax_t const max_nr_iterations{10};
-                std::uintmax_t actual_nr_iterations{max_nr_iterations};
+                int const digits{new_discharge_digits<FloatingPoint>};
+                std::uintmax_t actual_nr_iterations{max_nr_new_discharge_iterations};
 
                 // https://www.boost.org/doc/libs/1_85_0/libs/math/doc/html/math_toolkit/roots_deriv.html
                 // std::cout.precision(std::numeric_limits<FloatingPoint>::digits10);
@@ -214,7 +488,7 @@ namespace lue {
 
                 // TODO We can't throw an exception as this actually happens once in a while
                 // https://github.com/computationalgeography/lue/issues/703
-                // if (actual_nr_iterations == max_nr_iterations)
+                // if (actual_nr_iterations == max_nr_new_discharge_iterations)
                 // {
                 //     // This only seems to happen when upstream_discharge == 0, current_discharge == 0, and
                 //     // lateral_inflow > 0
@@ -239,18 +513,7 @@ namespace lue {
                 // }
             }
 
-            if (lateral_inflow < FloatingPoint{0})
-            {
-                // Convert units: m³ / m / s → m³ / s
-                FloatingPoint const extraction{
-                    std::min(channel_length * std::abs(lateral_inflow), new_discharge)};
-
-                new_discharge -= extraction;
-            }
-
-            lue_hpx_assert(new_discharge >= FloatingPoint{0});
-
-            return new_discharge;
+            return subtract_extraction(new_discharge, lateral_inflow, channel_length);
         }
 
 
@@ -415,47 +678,109 @@ namespace lue {
 
                         void enter_cell(Index const idx0, Index const idx1)
                         {
-                            MaterialElement const& current_outflow{to_value(_current_outflow, idx0, idx1)};
-                            MaterialElement const& inflow{to_value(_inflow, idx0, idx1)};
-                            MaterialElement const& alpha{to_value(_alpha, idx0, idx1)};
-                            MaterialElement const& beta{to_value(_beta, idx0, idx1)};
-                            MaterialElement const& time_step_duration{
-                                to_value(_time_step_duration, idx0, idx1)};
-                            MaterialElement const& channel_length{to_value(_channel_length, idx0, idx1)};
-
                             MaterialElement& outflow{_outflow(idx0, idx1)};
 
                             // TODO: what about domain of alpha and beta? time step duration?
 
                             if (!_ondp_outflow.is_no_data(outflow))
                             {
-                                if (_indp_current_outflow.is_no_data(current_outflow) ||
-                                    _indp_inflow.is_no_data(inflow) || _indp_alpha.is_no_data(alpha) ||
-                                    _indp_beta.is_no_data(beta) ||
-                                    _indp_time_step_duration.is_no_data(time_step_duration) ||
-                                    _indp_channel_length.is_no_data(channel_length) ||
-                                    !_dp.within_domain(current_outflow, inflow, channel_length))
+                                if (!inputs_are_valid(idx0, idx1))
                                 {
                                     _ondp_outflow.mark_no_data(outflow);
                                 }
                                 else
                                 {
                                     lue_hpx_assert(outflow >= 0);
-                                    lue_hpx_assert(inflow >= 0);
+                                    lue_hpx_assert(to_value(_inflow, idx0, idx1) >= 0);
 
                                     outflow = iterate_to_new_discharge(
                                         outflow,
-                                        current_outflow,
-                                        inflow,
-                                        alpha,
-                                        beta,
-                                        time_step_duration,
-                                        channel_length);
+                                        to_value(_current_outflow, idx0, idx1),
+                                        to_value(_inflow, idx0, idx1),
+                                        to_value(_alpha, idx0, idx1),
+                                        to_value(_beta, idx0, idx1),
+                                        to_value(_time_step_duration, idx0, idx1),
+                                        to_value(_channel_length, idx0, idx1));
                                 }
                             }
                         }
 
 
+                        /*!
+                            @brief      Enter the cells in @a cells_idxs, which don't depend on each other
+
+                            The result is the same as entering the cells one at a time. The kinematic
+                            wave equations of the cells receiving water are solved together.
+                        */
+                        void enter_cells(std::span<std::array<Index, 2> const> const cells_idxs)
+                        {
+                            NonLinearKinematicWaveBatch<MaterialElement> kinematic_waves{cells_idxs.size()};
+                            std::vector<std::array<Index, 2>> wet_cells_idxs{};
+
+                            wet_cells_idxs.reserve(cells_idxs.size());
+
+                            for (auto const& [idx0, idx1] : cells_idxs)
+                            {
+                                MaterialElement& outflow{_outflow(idx0, idx1)};
+
+                                if (!_ondp_outflow.is_no_data(outflow))
+                                {
+                                    if (!inputs_are_valid(idx0, idx1))
+                                    {
+                                        _ondp_outflow.mark_no_data(outflow);
+                                    }
+                                    else
+                                    {
+                                        MaterialElement const& current_outflow{
+                                            to_value(_current_outflow, idx0, idx1)};
+                                        MaterialElement const& inflow{to_value(_inflow, idx0, idx1)};
+
+                                        lue_hpx_assert(outflow >= 0);
+                                        lue_hpx_assert(inflow >= 0);
+
+                                        if (receives_water(outflow, current_outflow, inflow))
+                                        {
+                                            kinematic_waves.push_back(
+                                                {outflow,
+                                                 current_outflow,
+                                                 std::max(inflow, MaterialElement{0}),
+                                                 to_value(_alpha, idx0, idx1),
+                                                 to_value(_beta, idx0, idx1),
+                                                 to_value(_time_step_duration, idx0, idx1),
+                                                 to_value(_channel_length, idx0, idx1)});
+                                            wet_cells_idxs.push_back({idx0, idx1});
+                                        }
+                                        else
+                                        {
+                                            outflow = MaterialElement{0};
+                                        }
+                                    }
+                                }
+                            }
+
+                            std::span<MaterialElement const> new_discharges{};
+
+                            if constexpr (std::is_arithmetic_v<Beta>)
+                            {
+                                new_discharges = kinematic_waves.iterate_to_new_discharges(_beta);
+                            }
+                            else
+                            {
+                                new_discharges = kinematic_waves.iterate_to_new_discharges();
+                            }
+
+                            for (std::size_t idx = 0; idx < wet_cells_idxs.size(); ++idx)
+                            {
+                                auto const [idx0, idx1] = wet_cells_idxs[idx];
+
+                                _outflow(idx0, idx1) = subtract_extraction(
+                                    new_discharges[idx],
+                                    to_value(_inflow, idx0, idx1),
+                                    to_value(_channel_length, idx0, idx1));
+                            }
+                        }
+
+
                         void leave_cell(
                             Index const idx0_from,
                             Index const idx1_from,
@@ -517,6 +842,26 @@ namespace lue {
 
                     private:
 
+                        auto inputs_are_valid(Index const idx0, Index const idx1) const -> bool
+                        {
+                            MaterialElement const& current_outflow{to_value(_current_outflow, idx0, idx1)};
+                            MaterialElement const& inflow{to_value(_inflow, idx0, idx1)};
+                            MaterialElement const& alpha{to_value(_alpha, idx0, idx1)};
+                            MaterialElement const& beta{to_value(_beta, idx0, idx1)};
+                            MaterialElement const& time_step_duration{
+                                to_value(_time_step_duration, idx0, idx1)};
+                            MaterialElement const& channel_length{to_value(_channel_length, idx0, idx1)};
+
+                            return !(
+                                _indp_current_outflow.is_no_data(current_outflow) ||
+                                _indp_inflow.is_no_data(inflow) || _indp_alpha.is_no_data(alpha) ||
+                                _indp_beta.is_no_data(beta) ||
+                                _indp_time_step_duration.is_no_data(time_step_duration) ||
+                                _indp_channel_length.is_no_data(channel_length) ||
+                                !_dp.within_domain(current_outflow, inflow, channel_length));
+                        }
+
+
                         DomainPolicy _dp;
 
                         CurrentOutflowNoDataPolicy _indp_current_outflow;
@@ -656,6 +1001,63 @@ namespace lue {
             channel_length));
     }
 
+
+    template<typename Policies>
+    auto kinematic_wave(
+        Policies const& policies,
+        FlowNetwork<policy::InputElementT<Policies, 0>, policy::InputElementT<Policies, 1>> const&
+            flow_network,
+        PartitionedArray<policy::InputElementT<Policies, 1>, 2> const& current_outflow,
+        PartitionedArray<policy::InputElementT<Policies, 2>, 2> const& inflow,
+        PartitionedArray<policy::InputElementT<Policies, 3>, 2> const& alpha,
+        PartitionedArray<policy::InputElementT<Policies, 4>, 2> const& beta,
+        Scalar<policy::InputElementT<Policies, 5>> const& time_step_duration,
+        PartitionedArray<policy::InputElementT<Policies, 6>, 2> const& channel_length)
+        -> PartitionedArray<policy::OutputElementT<Policies, 0>, 2>
+    {
+        detail::verify_compatible(
+            flow_network.flow_direction(), current_outflow, inflow, alpha, beta, channel_length);
+
+        return std::get<0>(accumulating_router(
+            policies,
+            detail::KinematicWave<Policies>{},
+            flow_network,
+            current_outflow,
+            inflow,
+            alpha,
+            beta,
+            time_step_duration,
+            channel_length));
+    }
+
+
+    template<typename Policies>
+    auto kinematic_wave(
+        Policies const& policies,
+        FlowNetwork<policy::InputElementT<Policies, 0>, policy::InputElementT<Policies, 1>> const&
+            flow_network,
+        PartitionedArray<policy::InputElementT<Policies, 1>, 2> const& current_outflow,
+        PartitionedArray<policy::InputElementT<Policies, 2>, 2> const& inflow,
+        Scalar<policy::InputElementT<Policies, 3>> const& alpha,
+        Scalar<policy::InputElementT<Policies, 4>> const& beta,
+        Scalar<policy::InputElementT<Policies, 5>> const& time_step_duration,
+        Scalar<policy::InputElementT<Policies, 6>> const& channel_length)
+        -> PartitionedArray<policy::OutputElementT<Policies, 0>, 2>
+    {
+        detail::verify_compatible(flow_network.flow_direction(), current_outflow, inflow);
+
+        return std::get<0>(accumulating_router(
+            policies,
+            detail::KinematicWave<Policies>{},
+            flow_network,
+            current_outflow,
+            inflow,
+            alpha,
+            beta,
+            time_step_duration,
+            channel_length));
+    }
+
 }  // namespace lue
 
 
@@ -681,4 +1083,26 @@ namespace lue {
         Scalar<policy::InputElementT<Policies, 4>> const&,                                                   \
         Scalar<policy::InputElementT<Policies, 5>> const&,                                                   \
         Scalar<policy::InputElementT<Policies, 6>> const&)                                                   \
+        -> PartitionedArray<policy::OutputElementT<Policies, 0>, 2>;                                         \
+                                                                                                             \
+    template LUE_ROUTING_OPERATION_EXPORT auto kinematic_wave<ArgumentType<void(Policies)>>(                 \
+        ArgumentType<void(Policies)> const&,                                                                 \
+        FlowNetwork<policy::InputElementT<Policies, 0>, policy::InputElementT<Policies, 1>> const&,          \
+        PartitionedArray<policy::InputElementT<Policies, 1>, 2> const&,                                      \
+        PartitionedArray<policy::InputElementT<Policies, 2>, 2> const&,                                      \
+        PartitionedArray<policy::InputElementT<Policies, 3>, 2> const&,                                      \
+        PartitionedArray<policy::InputElementT<Policies, 4>, 2> const&,                                      \
+        Scalar<policy::InputElementT<Policies, 5>> const&,                                                   \
+        PartitionedArray<policy::InputElementT<Policies, 6>, 2> const&)                                      \
+        -> PartitionedArray<policy::OutputElementT<Policies, 0>, 2>;                                         \
+                                                                                                             \
+    template LUE_ROUTING_OPERATION_EXPORT auto kinematic_wave<ArgumentType<void(Policies)>>(                 \
+        ArgumentType<void(Policies)> const&,                                                                 \
+        FlowNetwork<policy::InputElementT<Policies, 0>, policy::InputElementT<Policies, 1>> const&,          \
+        PartitionedArray<policy::InputElementT<Policies, 1>, 2> const&,                                      \
+        PartitionedArray<policy::InputElementT<Policies, 2>, 2> const&,                                      \
+        Scalar<policy::InputElementT<Policies, 3>> const&,                                                   \
+        Scalar<policy::InputElementT<Policies, 4>> const&,                                                   \
+        Scalar<policy::InputElementT<Policies, 5>> const&,                                                   \
+        Scalar<policy::InputElementT<Policies, 6>> const&)                                                   \
         -> PartitionedArray<policy::OutputElementT<Policies, 0>, 2>
@@ -0,0 +1,159 @@
+#pragma once
+#include "lue/framework/algorithm/detail/verify_compatible.hpp"
+#include "lue/framework/algorithm/local_expression.hpp"
+#include "lue/framework/algorithm/policy/default_value_policies.hpp"
+#include "lue/framework/core/annotate.hpp"
+#include "lue/framework/core/component.hpp"
+#include <utility>
+
+
+namespace lue::local_expression {
+    namespace detail {
+
+        /*!
+            @brief      Evaluate @a node given the values of the input elements
+
+            The result is marked as no-data if any of the @a values is no-data, or if evaluating the
+            node resulted in a value outside of the domain of one of the operations.
+        */
+        template<typename Node, typename... Element, std::size_t... idxs>
+        auto evaluate_element(
+            Node const& node,
+            std::tuple<Element...> const& values,
+            [[maybe_unused]] std::index_sequence<idxs...> indices) -> OutputElementT<Node>
+        {
+            using OutputElement = OutputElementT<Node>;
+
+            std::tuple<policy::DefaultInputNoDataPolicy<Element>...> const indps{};
+            policy::DefaultOutputNoDataPolicy<OutputElement> const ondp{};
+
+            OutputElement result{};
+            bool within_domain{!(std::get<idxs>(indps).is_no_data(std::get<idxs>(values)) || ...)};
+
+            if (within_domain)
+            {
+                result = node(values, within_domain);
+            }
+
+            if (!within_domain)
+            {
+                ondp.mark_no_data(result);
+            }
+
+            return result;
+        }
+
+
+        template<typename Node, typename OutputData, typename... InputData, std::size_t... idxs>
+        auto evaluate_data(
+            Node const& node,
+            std::tuple<InputData...> const& input_data,
+            std::index_sequence<idxs...> indices) -> OutputData
+        {
+            auto const& data0{std::get<0>(input_data)};
+
+            if ((std::get<idxs>(input_data).is_uniform() && ...))
+            {
+                return OutputData{
+                    data0.shape(),
+                    evaluate_element(
+                        node, std::make_tuple(std::get<idxs>(input_data).uniform_value()...), indices),
+                    UniformTag{}};
+            }
+
+            OutputData output_data{data0.shape()};
+            Count const nr_elements{lue::nr_elements(data0)};
+
+            for (Index element_idx = 0; element_idx < nr_elements; ++element_idx)
+            {
+                output_data[element_idx] = evaluate_element(
+                    node, std::make_tuple(std::get<idxs>(input_data)[element_idx]...), indices);
+            }
+
+            return output_data;
+        }
+
+
+        template<typename Node, typename OutputPartition, typename... InputPartition>
+        auto evaluate_partition(Node const& node, InputPartition const&... input_partitions)
+            -> OutputPartition
+        {
+            using Offset = OffsetT<OutputPartition>;
+            using OutputData = DataT<OutputPartition>;
+
+            return hpx::dataflow(
+                hpx::launch::async,
+
+                [node](InputPartition const&... input_partitions) -> OutputPartition
+                {
+                    AnnotateFunction const annotation{"local_expression: partition"};
+
+                    Offset const offset{
+                        std::get<0>(std::forward_as_tuple(input_partitions...)).offset(hpx::launch::sync)};
+                    std::tuple<DataT<InputPartition>...> const input_data{
+                        input_partitions.data(hpx::launch::sync)...};
+
+                    return OutputPartition{
+                        hpx::find_here(),
+                        offset,
+                        evaluate_data<Node, OutputData>(
+                            node, input_data, std::index_sequence_for<InputPartition...>{})};
+                },
+
+                input_partitions...);
+        }
+
+
+        template<typename Node, typename OutputPartition, typename... InputPartition>
+        struct EvaluatePartitionAction:
+            hpx::actions::make_action<
+                decltype(&evaluate_partition<Node, OutputPartition, InputPartition...>),
+                &evaluate_partition<Node, OutputPartition, InputPartition...>,
+                EvaluatePartitionAction<Node, OutputPartition, InputPartition...>>::type
+        {
+        };
+
+    }  // namespace detail
+
+
+    template<typename Node, Rank rank, typename... Element>
+    auto evaluate(Expression<Node, rank, Element...> const& expression)
+        -> PartitionedArray<OutputElementT<Node>, rank>
+    {
+        static_assert(sizeof...(Element) > 0);
+
+        using OutputArray = PartitionedArray<OutputElementT<Node>, rank>;
+        using OutputPartitions = PartitionsT<OutputArray>;
+        using OutputPartition = PartitionT<OutputArray>;
+
+        AnnotateFunction const annotation{"local_expression: array"};
+
+        auto const& arrays{expression.arrays()};
+        auto const& array0{std::get<0>(arrays)};
+
+        std::apply([](auto const&... array) { lue::detail::verify_compatible(array...); }, arrays);
+
+        detail::EvaluatePartitionAction<Node, OutputPartition, PartitionT<PartitionedArray<Element, rank>>...>
+            action;
+
+        Localities<rank> const& localities{array0.localities()};
+        OutputPartitions output_partitions{shape_in_partitions(array0)};
+
+        for (Index partition_idx = 0; partition_idx < nr_partitions(array0); ++partition_idx)
+        {
+            output_partitions[partition_idx] = std::apply(
+                [&](auto const&... array)
+                {
+                    return hpx::async(
+                        action,
+                        localities[partition_idx],
+                        expression.node(),
+                        array.partitions()[partition_idx]...);
+                },
+                arrays);
+        }
+
+        return {array0, std::move(output_partitions)};
+    }
+
+}  // namespace lue::local_expression
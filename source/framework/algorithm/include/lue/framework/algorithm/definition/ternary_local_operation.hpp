@@ -1,4 +1,5 @@
 #pragma once
+#include "lue/framework/algorithm/detail/dense_local_operation.hpp"
 #include "lue/framework/algorithm/functor_traits.hpp"
 #include "lue/framework/core/annotate.hpp"
 #include "lue/framework/partitioned_array_decl.hpp"
@@ -91,28 +92,57 @@ namespace lue {
                                 lue_hpx_assert(lue::nr_elements(input_partition_data2) == nr_elements);
                                 lue_hpx_assert(lue::nr_elements(input_partition_data3) == nr_elements);
 
-                                for (Index i = 0; i < nr_elements; ++i)
+                                if constexpr (dense_local_operation_v<
+                                                  Policies,
+                                                  policy::InputElementT<Policies, 0>,
+                                                  policy::InputElementT<Policies, 1>,
+                                                  policy::InputElementT<Policies, 2>,
+                                                  policy::OutputElementT<Policies, 0>>)
                                 {
-                                    if (indp1.is_no_data(input_partition_data1, i) ||
-                                        indp2.is_no_data(input_partition_data2, i) ||
-                                        indp3.is_no_data(input_partition_data3, i))
-                                    {
-                                        ondp.mark_no_data(output_partition_data, i);
-                                    }
-                                    else if (!dp.within_domain(
-                                                 input_partition_data1[i],
-                                                 input_partition_data2[i],
-                                                 input_partition_data3[i]))
-                                    {
-                                        ondp.mark_no_data(output_partition_data, i);
-                                    }
-                                    else
+                                    // Evaluate the functor for all elements, without branching on
+                                    // no-data. Mark no-data in the output afterwards.
+                                    ValidityMask validity{
+                                        ValidityMask::detect(indp1, input_partition_data1, nr_elements)};
+                                    validity &=
+                                        ValidityMask::detect(indp2, input_partition_data2, nr_elements);
+                                    validity &=
+                                        ValidityMask::detect(indp3, input_partition_data3, nr_elements);
+
+                                    for (Index i = 0; i < nr_elements; ++i)
                                     {
                                         output_partition_data[i] = functor(
                                             input_partition_data1[i],
                                             input_partition_data2[i],
                                             input_partition_data3[i]);
                                     }
+
+                                    validity.mark(ondp, output_partition_data);
+                                }
+                                else
+                                {
+                                    for (Index i = 0; i < nr_elements; ++i)
+                                    {
+                                        if (indp1.is_no_data(input_partition_data1, i) ||
+                                            indp2.is_no_data(input_partition_data2, i) ||
+                                            indp3.is_no_data(input_partition_data3, i))
+                                        {
+                                            ondp.mark_no_data(output_partition_data, i);
+                                        }
+                                        else if (!dp.within_domain(
+                                                     input_partition_data1[i],
+                                                     input_partition_data2[i],
+                                                     input_partition_data3[i]))
+                                        {
+                                            ondp.mark_no_data(output_partition_data, i);
+                                        }
+                                        else
+                                        {
+                                            output_partition_data[i] = functor(
+                                                input_partition_data1[i],
+                                                input_partition_data2[i],
+                                                input_partition_data3[i]);
+                                        }
+                                    }
                                 }
 
                                 return {hpx::find_here(), offset, std::move(output_partition_data)};
@@ -184,7 +214,7 @@ namespace lue {
                                 InputData2 const input_partition_data2 =
                                     input_partition2.data(hpx::launch::sync);
                                 InputElement3 const input_value = input_scalar.get();
-                                Offset const offset = input_partition.offset(hpx::launch::sync);
+                                Offset const offset = input_partition1.offset(hpx::launch::sync);
                                 OutputData output_partition_data{input_partition_data1.shape()};
 
                                 auto const& dp = policies.domain_policy();
@@ -209,27 +239,54 @@ namespace lue {
                                 }
                                 else
                                 {
-                                    for (Index i = 0; i < nr_elements; ++i)
+                                    if constexpr (dense_local_operation_v<
+                                                      Policies,
+                                                      policy::InputElementT<Policies, 0>,
+                                                      policy::InputElementT<Policies, 1>,
+                                                      policy::InputElementT<Policies, 2>,
+                                                      policy::OutputElementT<Policies, 0>>)
                                     {
-                                        if (indp1.is_no_data(input_partition_data1, i) ||
-                                            indp2.is_no_data(input_partition_data2, i))
-                                        {
-                                            ondp.mark_no_data(output_partition_data, i);
-                                        }
-                                        else if (!dp.within_domain(
-                                                     input_partition_data1[i],
-                                                     input_partition_data2[i],
-                                                     input_value))
-                                        {
-                                            ondp.mark_no_data(output_partition_data, i);
-                                        }
-                                        else
+                                        // Evaluate the functor for all elements, without branching on
+                                        // no-data. Mark no-data in the output afterwards.
+                                        ValidityMask validity{
+                                            ValidityMask::detect(indp1, input_partition_data1, nr_elements)};
+                                        validity &=
+                                            ValidityMask::detect(indp2, input_partition_data2, nr_elements);
+
+                                        for (Index i = 0; i < nr_elements; ++i)
                                         {
                                             output_partition_data[i] = functor(
                                                 input_partition_data1[i],
                                                 input_partition_data2[i],
                                                 input_value);
                                         }
+
+                                        validity.mark(ondp, output_partition_data);
+                                    }
+                                    else
+                                    {
+                                        for (Index i = 0; i < nr_elements; ++i)
+                                        {
+                                            if (indp1.is_no_data(input_partition_data1, i) ||
+                                                indp2.is_no_data(input_partition_data2, i))
+                                            {
+                                                ondp.mark_no_data(output_partition_data, i);
+                                            }
+                                            else if (!dp.within_domain(
+                                                         input_partition_data1[i],
+                                                         input_partition_data2[i],
+                                                         input_value))
+                                            {
+                                                ondp.mark_no_data(output_partition_data, i);
+                                            }
+                                            else
+                                            {
+                                                output_partition_data[i] = functor(
+                                                    input_partition_data1[i],
+                                                    input_partition_data2[i],
+                                                    input_value);
+                                            }
+                                        }
                                     }
                                 }
 
@@ -327,27 +384,54 @@ namespace lue {
                                 }
                                 else
                                 {
-                                    for (Index i = 0; i < nr_elements; ++i)
+                                    if constexpr (dense_local_operation_v<
+                                                      Policies,
+                                                      policy::InputElementT<Policies, 0>,
+                                                      policy::InputElementT<Policies, 1>,
+                                                      policy::InputElementT<Policies, 2>,
+                                                      policy::OutputElementT<Policies, 0>>)
                                     {
-                                        if (indp1.is_no_data(input_partition_data1, i) ||
-                                            indp3.is_no_data(input_partition_data2, i))
-                                        {
-                                            ondp.mark_no_data(output_partition_data, i);
-                                        }
-                                        else if (!dp.within_domain(
-                                                     input_partition_data1[i],
-                                                     input_value,
-                                                     input_partition_data2[i]))
-                                        {
-                                            ondp.mark_no_data(output_partition_data, i);
-                                        }
-                                        else
+                                        // Evaluate the functor for all elements, without branching on
+                                        // no-data. Mark no-data in the output afterwards.
+                                        ValidityMask validity{
+                                            ValidityMask::detect(indp1, input_partition_data1, nr_elements)};
+                                        validity &=
+                                            ValidityMask::detect(indp3, input_partition_data2, nr_elements);
+
+                                        for (Index i = 0; i < nr_elements; ++i)
                                         {
                                             output_partition_data[i] = functor(
                                                 input_partition_data1[i],
                                                 input_value,
                                                 input_partition_data2[i]);
                                         }
+
+                                        validity.mark(ondp, output_partition_data);
+                                    }
+                                    else
+                                    {
+                                        for (Index i = 0; i < nr_elements; ++i)
+                                        {
+                                            if (indp1.is_no_data(input_partition_data1, i) ||
+                                                indp3.is_no_data(input_partition_data2, i))
+                                            {
+                                                ondp.mark_no_data(output_partition_data, i);
+                                            }
+                                            else if (!dp.within_domain(
+                                                         input_partition_data1[i],
+                                                         input_value,
+                                                         input_partition_data2[i]))
+                                            {
+                                                ondp.mark_no_data(output_partition_data, i);
+                                            }
+                                            else
+                                            {
+                                                output_partition_data[i] = functor(
+                                                    input_partition_data1[i],
+                                                    input_value,
+                                                    input_partition_data2[i]);
+                                            }
+                                        }
                                     }
                                 }
 
@@ -441,22 +525,45 @@ namespace lue {
                                 }
                                 else
                                 {
-                                    for (Index i = 0; i < nr_elements; ++i)
+                                    if constexpr (dense_local_operation_v<
+                                                      Policies,
+                                                      policy::InputElementT<Policies, 0>,
+                                                      policy::InputElementT<Policies, 1>,
+                                                      policy::InputElementT<Policies, 2>,
+                                                      policy::OutputElementT<Policies, 0>>)
                                     {
-                                        if (indp1.is_no_data(input_partition_data, i))
-                                        {
-                                            ondp.mark_no_data(output_partition_data, i);
-                                        }
-                                        else if (!dp.within_domain(
-                                                     input_partition_data[i], input_value1, input_value2))
-                                        {
-                                            ondp.mark_no_data(output_partition_data, i);
-                                        }
-                                        else
+                                        // Evaluate the functor for all elements, without branching on
+                                        // no-data. Mark no-data in the output afterwards.
+                                        ValidityMask validity{
+                                            ValidityMask::detect(indp1, input_partition_data, nr_elements)};
+
+                                        for (Index i = 0; i < nr_elements; ++i)
                                         {
                                             output_partition_data[i] =
                                                 functor(input_partition_data[i], input_value1, input_value2);
                                         }
+
+                                        validity.mark(ondp, output_partition_data);
+                                    }
+                                    else
+                                    {
+                                        for (Index i = 0; i < nr_elements; ++i)
+                                        {
+                                            if (indp1.is_no_data(input_partition_data, i))
+                                            {
+                                                ondp.mark_no_data(output_partition_data, i);
+                                            }
+                                            else if (!dp.within_domain(
+                                                         input_partition_data[i], input_value1, input_value2))
+                                            {
+                                                ondp.mark_no_data(output_partition_data, i);
+                                            }
+                                            else
+                                            {
+                                                output_partition_data[i] = functor(
+                                                    input_partition_data[i], input_value1, input_value2);
+                                            }
+                                        }
                                     }
                                 }
 
@@ -1,4 +1,5 @@
 #pragma once
+#include "lue/framework/algorithm/detail/dense_local_operation.hpp"
 #include "lue/framework/algorithm/functor_traits.hpp"
 #include "lue/framework/algorithm/local_operation_export.hpp"
 #include "lue/framework/algorithm/unary_local_operation.hpp"
@@ -10,6 +11,42 @@
 namespace lue {
     namespace detail {
 
+        /*!
+            @brief      Calculate the output value given a single input value
+
+            This is used for scalar inputs and for uniform array partitions.
+        */
+        template<typename Policies, typename Functor>
+        auto unary_local_operation_value(
+            Policies const& policies,
+            policy::InputElementT<Policies, 0> const& input_value,
+            Functor const& functor) -> policy::OutputElementT<Policies, 0>
+        {
+            auto const& dp = policies.domain_policy();
+            auto const& indp = std::get<0>(policies.inputs_policies()).input_no_data_policy();
+            auto const& ondp = std::get<0>(policies.outputs_policies()).output_no_data_policy();
+            auto const& rp = std::get<0>(policies.outputs_policies()).range_policy();
+
+            policy::OutputElementT<Policies, 0> output_value;
+
+            if (indp.is_no_data(input_value) || !dp.within_domain(input_value))
+            {
+                ondp.mark_no_data(output_value);
+            }
+            else
+            {
+                output_value = functor(input_value);
+
+                if (!rp.within_range(input_value, output_value))
+                {
+                    ondp.mark_no_data(output_value);
+                }
+            }
+
+            return output_value;
+        }
+
+
         template<typename Policies, typename InputPartition, typename OutputPartition, typename Functor>
         auto unary_local_operation_partition(
             Policies const& policies, InputPartition const& input_partition, Functor const& functor)
@@ -28,6 +65,19 @@ namespace lue {
 
                     Offset const offset = input_partition.offset(hpx::launch::sync);
                     InputData const input_partition_data = input_partition.data(hpx::launch::sync);
+
+                    if (input_partition_data.is_uniform())
+                    {
+                        return OutputPartition{
+                            hpx::find_here(),
+                            offset,
+                            OutputData{
+                                input_partition_data.shape(),
+                                unary_local_operation_value(
+                                    policies, input_partition_data.uniform_value(), functor),
+                                UniformTag{}}};
+                    }
+
                     OutputData output_partition_data{input_partition_data.shape()};
 
                     auto const& dp = policies.domain_policy();
@@ -37,25 +87,48 @@ namespace lue {
 
                     Count const nr_elements{lue::nr_elements(input_partition_data)};
 
-                    for (Index element_idx = 0; element_idx < nr_elements; ++element_idx)
+                    if constexpr (dense_local_operation_v<
+                                      Policies,
+                                      policy::InputElementT<Policies, 0>,
+                                      policy::OutputElementT<Policies, 0>>)
                     {
-                        if (indp.is_no_data(input_partition_data, element_idx))
-                        {
-                            ondp.mark_no_data(output_partition_data, element_idx);
-                        }
-                        else if (!dp.within_domain(input_partition_data[element_idx]))
-                        {
-                            ondp.mark_no_data(output_partition_data, element_idx);
-                        }
-                        else
+                        // Evaluate the functor for all elements, without branching on no-data. Mark
+                        // no-data in the output afterwards.
+                        ValidityMask const validity{
+                            ValidityMask::detect(indp, input_partition_data, nr_elements)};
+
+                        std::transform(
+                            input_partition_data.begin(),
+                            input_partition_data.end(),
+                            output_partition_data.begin(),
+                            functor);
+
+                        validity.mark(ondp, output_partition_data);
+                    }
+                    else
+                    {
+                        for (Index element_idx = 0; element_idx < nr_elements; ++element_idx)
                         {
-                            output_partition_data[element_idx] = functor(input_partition_data[element_idx]);
-
-                            if (!rp.within_range(
-                                    input_partition_data[element_idx], output_partition_data[element_idx]))
+                            if (indp.is_no_data(input_partition_data, element_idx))
+                            {
+                                ondp.mark_no_data(output_partition_data, element_idx);
+                            }
+                            else if (!dp.within_domain(input_partition_data[element_idx]))
                             {
                                 ondp.mark_no_data(output_partition_data, element_idx);
                             }
+                            else
+                            {
+                                output_partition_data[element_idx] =
+                                    functor(input_partition_data[element_idx]);
+
+                                if (!rp.within_range(
+                                        input_partition_data[element_idx],
+                                        output_partition_data[element_idx]))
+                                {
+                                    ondp.mark_no_data(output_partition_data, element_idx);
+                                }
+                            }
                         }
                     }
 
@@ -133,30 +206,7 @@ namespace lue {
             hpx::launch::async,
             hpx::unwrapping(
                 [policies, functor](auto const& input_value) -> OutputElement
-                {
-                    auto const& dp = policies.domain_policy();
-                    auto const& indp = std::get<0>(policies.inputs_policies()).input_no_data_policy();
-                    auto const& ondp = std::get<0>(policies.outputs_policies()).output_no_data_policy();
-                    auto const& rp = std::get<0>(policies.outputs_policies()).range_policy();
-
-                    OutputElement output_value;
-
-                    if (indp.is_no_data(input_value) || !dp.within_domain(input_value))
-                    {
-                        ondp.mark_no_data(output_value);
-                    }
-                    else
-                    {
-                        output_value = functor(input_value);
-
-                        if (!rp.within_range(input_value, output_value))
-                        {
-                            ondp.mark_no_data(output_value);
-                        }
-                    }
-
-                    return output_value;
-                }),
+                { return detail::unary_local_operation_value(policies, input_value, functor); }),
             input_scalar.future());
     }
 
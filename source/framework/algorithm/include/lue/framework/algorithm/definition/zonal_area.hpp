@@ -14,6 +14,16 @@ namespace lue {
         return zonal_operation(policies, Count{1}, zones, Functor{});
     }
 
+
+    template<typename Count, typename Policies, typename Zone, Rank rank>
+    auto zonal_area(Policies const& policies, ZoneIndex<Zone, rank> const& zone_index)
+        -> PartitionedArray<Count, rank>
+    {
+        using Functor = detail::ZonalSum<Count, Zone>;
+
+        return zonal_operation(policies, Count{1}, zone_index, Functor{});
+    }
+
 }  // namespace lue
 
 
@@ -21,4 +31,8 @@ namespace lue {
                                                                                                              \
     template LUE_ZONAL_OPERATION_EXPORT PartitionedArray<Count, 2>                                           \
     zonal_area<Count, ArgumentType<void(Policies)>, Zone, 2>(                                                \
-        ArgumentType<void(Policies)> const&, PartitionedArray<Zone, 2> const&);
+        ArgumentType<void(Policies)> const&, PartitionedArray<Zone, 2> const&);                              \
+                                                                                                             \
+    template LUE_ZONAL_OPERATION_EXPORT PartitionedArray<Count, 2>                                           \
+    zonal_area<Count, ArgumentType<void(Policies)>, Zone, 2>(                                                \
+        ArgumentType<void(Policies)> const&, ZoneIndex<Zone, 2> const&);
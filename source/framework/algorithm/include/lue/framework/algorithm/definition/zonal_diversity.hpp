@@ -1,5 +1,6 @@
 #pragma once
 #include "lue/framework/algorithm/definition/zonal_operation.hpp"
+#include "lue/framework/algorithm/detail/zone_map.hpp"
 #include "lue/framework/algorithm/zonal_diversity.hpp"
 #include "lue/framework/algorithm/zonal_operation_export.hpp"
 #include <set>
@@ -30,49 +31,72 @@ namespace lue {
 
                         using Statistic = std::set<InputElement>;
 
-                        using Map = std::unordered_map<Zone, Statistic>;
+                        using Map = ZoneMap<Zone, Statistic>;
+
+
+                        void reserve(Zone const min_zone, Zone const max_zone, std::size_t const nr_zones)
+                        {
+                            _statistic_by_zone.reserve(min_zone, max_zone, nr_zones);
+                        }
 
 
                         void add(Zone const zone, InputElement const value)
                         {
-                            _statistic_by_zone[zone].insert(value);
+                            _statistic_by_zone.insert(zone).insert(value);
                         }
 
 
                         void merge(Aggregator const& other)
                         {
-                            for (auto const& [zone, value] : other._statistic_by_zone)
-                            {
-                                if (!contains(zone))
-                                {
-                                    _statistic_by_zone[zone] = value;
-                                }
-                                else
-                                {
-                                    _statistic_by_zone[zone].insert(value.begin(), value.end());
-                                }
-                            }
+                            _statistic_by_zone.merge(other._statistic_by_zone, combine);
+                        }
+
+
+                        /*!
+                            @brief      Add the statistics of @a other, whose zones are labels of a
+                                        zone index
+                            @param      zones Zone per label
+                        */
+                        template<typename LabelAggregator>
+                        void merge(LabelAggregator const& other, std::vector<Zone> const& zones)
+                        {
+                            other.for_each(
+                                [this, &zones](auto const label, auto const& statistic)
+                                { _statistic_by_zone.add(zones[label], statistic, combine); });
                         }
 
 
                         bool contains(Zone const zone) const
                         {
-                            return _statistic_by_zone.find(zone) != _statistic_by_zone.end();
+                            return _statistic_by_zone.contains(zone);
                         }
 
 
-                        OutputElement operator[](Zone const zone) const
+                        /*!
+                            @brief      Call @a function for each zone, passing in the zone and its
+                                        statistic
+                        */
+                        template<typename Function>
+                        void for_each(Function const& function) const
                         {
-                            auto it{_statistic_by_zone.find(zone)};
+                            _statistic_by_zone.for_each(function);
+                        }
 
-                            lue_hpx_assert(it != _statistic_by_zone.end());
 
-                            return (*it).second.size();
+                        OutputElement operator[](Zone const zone) const
+                        {
+                            return _statistic_by_zone[zone].size();
                         }
 
 
                     private:
 
+                        static void combine(Statistic& this_values, Statistic const& other_values)
+                        {
+                            this_values.insert(other_values.begin(), other_values.end());
+                        }
+
+
                         friend class hpx::serialization::access;
 
 
@@ -85,6 +109,11 @@ namespace lue {
 
                         Map _statistic_by_zone;
                 };
+
+
+                //! Type of the aggregator of the statistics per label of a zone index
+                using LabelAggregator =
+                    typename ZonalDiversity<Count, InputElement, IndexElement>::Aggregator;
         };
 
     }  // namespace detail
@@ -106,6 +135,18 @@ namespace lue {
         return zonal_operation(policies, array, zones, Functor{});
     }
 
+
+    template<typename Count, typename Policies, typename Element, typename Zone, Rank rank>
+    PartitionedArray<Count, rank> zonal_diversity(
+        Policies const& policies,
+        PartitionedArray<Element, rank> const& array,
+        ZoneIndex<Zone, rank> const& zone_index)
+    {
+        using Functor = detail::ZonalDiversity<Count, Element, Zone>;
+
+        return zonal_operation(policies, array, zone_index, Functor{});
+    }
+
 }  // namespace lue
 
 
@@ -115,4 +156,10 @@ namespace lue {
     zonal_diversity<Count, ArgumentType<void(Policies)>, Element, Zone, 2>(                                  \
         ArgumentType<void(Policies)> const&,                                                                 \
         PartitionedArray<Element, 2> const&,                                                                 \
-        PartitionedArray<Zone, 2> const&);
+        PartitionedArray<Zone, 2> const&);                                                                   \
+                                                                                                             \
+    template LUE_ZONAL_OPERATION_EXPORT PartitionedArray<Count, 2>                                           \
+    zonal_diversity<Count, ArgumentType<void(Policies)>, Element, Zone, 2>(                                  \
+        ArgumentType<void(Policies)> const&,                                                                 \
+        PartitionedArray<Element, 2> const&,                                                                 \
+        ZoneIndex<Zone, 2> const&);
@@ -1,5 +1,6 @@
 #pragma once
 #include "lue/framework/algorithm/definition/zonal_operation.hpp"
+#include "lue/framework/algorithm/detail/zone_map.hpp"
 #include "lue/framework/algorithm/zonal_majority.hpp"
 #include "lue/framework/algorithm/zonal_operation_export.hpp"
 #include <unordered_map>
@@ -30,66 +31,70 @@ namespace lue {
                         // Per zone we need to keep track of the frequency of the values
                         using Statistic = std::unordered_map<InputElement, Count>;
 
-                        using Map = std::unordered_map<Zone, Statistic>;
+                        using Map = ZoneMap<Zone, Statistic>;
+
+
+                        void reserve(Zone const min_zone, Zone const max_zone, std::size_t const nr_zones)
+                        {
+                            _statistic_by_zone.reserve(min_zone, max_zone, nr_zones);
+                        }
 
 
                         void add(Zone const zone, InputElement const value)
                         {
-                            // Obtain a pointer to the map for keeping track of frequencies
-                            // per value for the zone passed in. If necessary, add an empty map first.
-                            auto [it1, inserted1] = _statistic_by_zone.try_emplace(zone, Statistic{});
+                            // Obtain the map for keeping track of frequencies per value for the zone
+                            // passed in. If necessary, add an empty map first.
+                            Statistic& frequencies{_statistic_by_zone.insert(zone)};
 
                             // Obtain a pointer to the (value, frequency) pair for the value passed in.
                             // If necessary, add an (value, 0) pair first.
-                            auto [it2, inserted2] = (*it1).second.try_emplace(value, 0);
+                            auto [it, inserted] = frequencies.try_emplace(value, 0);
 
                             // Increase the frequency of the current value within the current zone
-                            ++(*it2).second;
+                            ++(*it).second;
                         }
 
 
                         void merge(Aggregator const& other)
                         {
-                            for (auto const& [zone, other_frequencies] : other._statistic_by_zone)
-                            {
-                                if (!contains(zone))
-                                {
-                                    // We don't have any frequencies for this zone. Add 'm all.
-                                    _statistic_by_zone[zone] = other_frequencies;
-                                }
-                                else
-                                {
-                                    auto& this_frequencies{_statistic_by_zone[zone]};
+                            _statistic_by_zone.merge(other._statistic_by_zone, combine);
+                        }
 
-                                    for (auto const& [value, frequency] : other_frequencies)
-                                    {
-                                        if (this_frequencies.find(value) == this_frequencies.end())
-                                        {
-                                            // We don't have a frequency for the current
-                                            // value. Add the value and frequency.
-                                            this_frequencies[value] = frequency;
-                                        }
-                                        else
-                                        {
-                                            // We already have a frequency for the current
-                                            // value. Add the frequency.
-                                            this_frequencies[value] += frequency;
-                                        }
-                                    }
-                                }
-                            }
+
+                        /*!
+                            @brief      Add the statistics of @a other, whose zones are labels of a
+                                        zone index
+                            @param      zones Zone per label
+                        */
+                        template<typename LabelAggregator>
+                        void merge(LabelAggregator const& other, std::vector<Zone> const& zones)
+                        {
+                            other.for_each(
+                                [this, &zones](auto const label, auto const& statistic)
+                                { _statistic_by_zone.add(zones[label], statistic, combine); });
                         }
 
 
                         bool contains(Zone const zone) const
                         {
-                            return _statistic_by_zone.find(zone) != _statistic_by_zone.end();
+                            return _statistic_by_zone.contains(zone);
+                        }
+
+
+                        /*!
+                            @brief      Call @a function for each zone, passing in the zone and its
+                                        statistic
+                        */
+                        template<typename Function>
+                        void for_each(Function const& function) const
+                        {
+                            _statistic_by_zone.for_each(function);
                         }
 
 
                         OutputElement operator[](Zone const zone) const
                         {
-                            auto const& frequencies{(*_statistic_by_zone.find(zone)).second};
+                            auto const& frequencies{_statistic_by_zone[zone]};
 
                             // TODO This could happen! Valid zone with only no-data values in it.
                             //      We need access to the ondp.
@@ -128,6 +133,17 @@ namespace lue {
 
                     private:
 
+                        static void combine(Statistic& this_frequencies, Statistic const& other_frequencies)
+                        {
+                            for (auto const& [value, frequency] : other_frequencies)
+                            {
+                                // Add the frequency, adding the value with a zero frequency first if
+                                // we don't have a frequency for it yet
+                                this_frequencies[value] += frequency;
+                            }
+                        }
+
+
                         friend class hpx::serialization::access;
 
 
@@ -140,6 +156,10 @@ namespace lue {
 
                         Map _statistic_by_zone;
                 };
+
+
+                //! Type of the aggregator of the statistics per label of a zone index
+                using LabelAggregator = typename ZonalMajority<InputElement, IndexElement>::Aggregator;
         };
 
     }  // namespace detail
@@ -156,6 +176,18 @@ namespace lue {
         return zonal_operation(policies, array, zones, Functor{});
     }
 
+
+    template<typename Policies, typename Element, typename Zone, Rank rank>
+    PartitionedArray<Element, rank> zonal_majority(
+        Policies const& policies,
+        PartitionedArray<Element, rank> const& array,
+        ZoneIndex<Zone, rank> const& zone_index)
+    {
+        using Functor = detail::ZonalMajority<Element, Zone>;
+
+        return zonal_operation(policies, array, zone_index, Functor{});
+    }
+
 }  // namespace lue
 
 
@@ -165,4 +197,10 @@ namespace lue {
     zonal_majority<ArgumentType<void(Policies)>, Element, Zone, 2>(                                          \
         ArgumentType<void(Policies)> const&,                                                                 \
         PartitionedArray<Element, 2> const&,                                                                 \
-        PartitionedArray<Zone, 2> const&);
+        PartitionedArray<Zone, 2> const&);                                                                   \
+                                                                                                             \
+    template LUE_ZONAL_OPERATION_EXPORT PartitionedArray<Element, 2>                                         \
+    zonal_majority<ArgumentType<void(Policies)>, Element, Zone, 2>(                                          \
+        ArgumentType<void(Policies)> const&,                                                                 \
+        PartitionedArray<Element, 2> const&,                                                                 \
+        ZoneIndex<Zone, 2> const&);
@@ -1,8 +1,8 @@
 #pragma once
 #include "lue/framework/algorithm/definition/zonal_operation.hpp"
+#include "lue/framework/algorithm/detail/zone_map.hpp"
 #include "lue/framework/algorithm/zonal_maximum.hpp"
 #include "lue/framework/algorithm/zonal_operation_export.hpp"
-#include <unordered_map>
 
 
 namespace lue {
@@ -28,44 +28,72 @@ namespace lue {
 
                     public:
 
-                        using Map = std::unordered_map<Zone, OutputElement>;
+                        using Map = ZoneMap<Zone, OutputElement>;
 
 
-                        void add(Zone const zone, InputElement const value)
+                        void reserve(Zone const min_zone, Zone const max_zone, std::size_t const nr_zones)
                         {
-                            auto [it, inserted] = _maximum_by_zone.try_emplace(zone, value);
+                            _maximum_by_zone.reserve(min_zone, max_zone, nr_zones);
+                        }
+
 
-                            (*it).second = std::max((*it).second, value);
+                        void add(Zone const zone, InputElement const value)
+                        {
+                            _maximum_by_zone.add(zone, value, combine);
                         }
 
 
                         void merge(Aggregator const& other)
                         {
-                            for (auto const& [zone, value] : other._maximum_by_zone)
-                            {
-                                add(zone, value);
-                            }
+                            _maximum_by_zone.merge(other._maximum_by_zone, combine);
+                        }
+
+
+                        /*!
+                            @brief      Add the statistics of @a other, whose zones are labels of a
+                                        zone index
+                            @param      zones Zone per label
+                        */
+                        template<typename LabelAggregator>
+                        void merge(LabelAggregator const& other, std::vector<Zone> const& zones)
+                        {
+                            other.for_each(
+                                [this, &zones](auto const label, auto const& statistic)
+                                { _maximum_by_zone.add(zones[label], statistic, combine); });
                         }
 
 
                         bool contains(Zone const zone) const
                         {
-                            return _maximum_by_zone.find(zone) != _maximum_by_zone.end();
+                            return _maximum_by_zone.contains(zone);
                         }
 
 
-                        OutputElement operator[](Zone const zone) const
+                        /*!
+                            @brief      Call @a function for each zone, passing in the zone and its
+                                        statistic
+                        */
+                        template<typename Function>
+                        void for_each(Function const& function) const
                         {
-                            auto it{_maximum_by_zone.find(zone)};
+                            _maximum_by_zone.for_each(function);
+                        }
 
-                            lue_hpx_assert(it != _maximum_by_zone.end());
 
-                            return (*it).second;
+                        OutputElement operator[](Zone const zone) const
+                        {
+                            return _maximum_by_zone[zone];
                         }
 
 
                     private:
 
+                        static void combine(OutputElement& maximum, OutputElement const value)
+                        {
+                            maximum = std::max(maximum, value);
+                        }
+
+
                         friend class hpx::serialization::access;
 
 
@@ -78,6 +106,10 @@ namespace lue {
 
                         Map _maximum_by_zone;
                 };
+
+
+                //! Type of the aggregator of the statistics per label of a zone index
+                using LabelAggregator = typename ZonalMaximum<InputElement, IndexElement>::Aggregator;
         };
 
     }  // namespace detail
@@ -94,6 +126,18 @@ namespace lue {
         return zonal_operation(policies, array, zones, Functor{});
     }
 
+
+    template<typename Policies, typename Element, typename Zone, Rank rank>
+    PartitionedArray<Element, rank> zonal_maximum(
+        Policies const& policies,
+        PartitionedArray<Element, rank> const& array,
+        ZoneIndex<Zone, rank> const& zone_index)
+    {
+        using Functor = detail::ZonalMaximum<Element, Zone>;
+
+        return zonal_operation(policies, array, zone_index, Functor{});
+    }
+
 }  // namespace lue
 
 
@@ -103,4 +147,10 @@ namespace lue {
     zonal_maximum<ArgumentType<void(Policies)>, Element, Zone, 2>(                                           \
         ArgumentType<void(Policies)> const&,                                                                 \
         PartitionedArray<Element, 2> const&,                                                                 \
-        PartitionedArray<Zone, 2> const&);
+        PartitionedArray<Zone, 2> const&);                                                                   \
+                                                                                                             \
+    template LUE_ZONAL_OPERATION_EXPORT PartitionedArray<Element, 2>                                         \
+    zonal_maximum<ArgumentType<void(Policies)>, Element, Zone, 2>(                                           \
+        ArgumentType<void(Policies)> const&,                                                                 \
+        PartitionedArray<Element, 2> const&,                                                                 \
+        ZoneIndex<Zone, 2> const&);
@@ -1,9 +1,9 @@
 #pragma once
 #include "lue/framework/algorithm/definition/zonal_operation.hpp"
+#include "lue/framework/algorithm/detail/zone_map.hpp"
 #include "lue/framework/algorithm/zonal_mean.hpp"
 #include "lue/framework/algorithm/zonal_operation_export.hpp"
 #include "lue/framework/configure.hpp"
-#include <unordered_map>
 
 
 namespace lue {
@@ -34,25 +34,18 @@ namespace lue {
 
                         using Statistic = std::tuple<Sum, Count>;
 
-                        using Map = std::unordered_map<Zone, Statistic>;
+                        using Map = ZoneMap<Zone, Statistic>;
+
+
+                        void reserve(Zone const min_zone, Zone const max_zone, std::size_t const nr_zones)
+                        {
+                            _statistic_by_zone.reserve(min_zone, max_zone, nr_zones);
+                        }
 
 
                         void add(Zone const zone, Statistic const& statistic)
                         {
-                            auto it{_statistic_by_zone.find(zone)};
-
-                            if (it == _statistic_by_zone.end())
-                            {
-                                _statistic_by_zone[zone] = statistic;
-                            }
-                            else
-                            {
-                                auto& [this_sum, this_count] = (*it).second;
-                                auto const [other_sum, other_count] = statistic;
-
-                                this_sum += other_sum;
-                                this_count += other_count;
-                            }
+                            _statistic_by_zone.add(zone, statistic, combine);
                         }
 
 
@@ -64,26 +57,44 @@ namespace lue {
 
                         void merge(Aggregator const& other)
                         {
-                            for (auto const& [zone, value] : other._statistic_by_zone)
-                            {
-                                add(zone, value);
-                            }
+                            _statistic_by_zone.merge(other._statistic_by_zone, combine);
+                        }
+
+
+                        /*!
+                            @brief      Add the statistics of @a other, whose zones are labels of a
+                                        zone index
+                            @param      zones Zone per label
+                        */
+                        template<typename LabelAggregator>
+                        void merge(LabelAggregator const& other, std::vector<Zone> const& zones)
+                        {
+                            other.for_each(
+                                [this, &zones](auto const label, auto const& statistic)
+                                { _statistic_by_zone.add(zones[label], statistic, combine); });
                         }
 
 
                         bool contains(Zone const zone) const
                         {
-                            return _statistic_by_zone.find(zone) != _statistic_by_zone.end();
+                            return _statistic_by_zone.contains(zone);
                         }
 
 
-                        OutputElement operator[](Zone const zone) const
+                        /*!
+                            @brief      Call @a function for each zone, passing in the zone and its
+                                        statistic
+                        */
+                        template<typename Function>
+                        void for_each(Function const& function) const
                         {
-                            auto it{_statistic_by_zone.find(zone)};
+                            _statistic_by_zone.for_each(function);
+                        }
 
-                            lue_hpx_assert(it != _statistic_by_zone.end());
 
-                            auto [sum, count] = (*it).second;
+                        OutputElement operator[](Zone const zone) const
+                        {
+                            auto const [sum, count] = _statistic_by_zone[zone];
 
                             return sum / count;
                         }
@@ -91,6 +102,16 @@ namespace lue {
 
                     private:
 
+                        static void combine(Statistic& this_statistic, Statistic const& other_statistic)
+                        {
+                            auto& [this_sum, this_count] = this_statistic;
+                            auto const [other_sum, other_count] = other_statistic;
+
+                            this_sum += other_sum;
+                            this_count += other_count;
+                        }
+
+
                         friend class hpx::serialization::access;
 
 
@@ -103,6 +124,10 @@ namespace lue {
 
                         Map _statistic_by_zone;
                 };
+
+
+                //! Type of the aggregator of the statistics per label of a zone index
+                using LabelAggregator = typename ZonalMean<InputElement, IndexElement>::Aggregator;
         };
 
     }  // namespace detail
@@ -119,6 +144,18 @@ namespace lue {
         return zonal_operation(policies, array, zones, Functor{});
     }
 
+
+    template<typename Policies, typename Element, typename Zone, Rank rank>
+    PartitionedArray<Element, rank> zonal_mean(
+        Policies const& policies,
+        PartitionedArray<Element, rank> const& array,
+        ZoneIndex<Zone, rank> const& zone_index)
+    {
+        using Functor = detail::ZonalMean<Element, Zone>;
+
+        return zonal_operation(policies, array, zone_index, Functor{});
+    }
+
 }  // namespace lue
 
 
@@ -128,4 +165,10 @@ namespace lue {
     zonal_mean<ArgumentType<void(Policies)>, Element, Zone, 2>(                                              \
         ArgumentType<void(Policies)> const&,                                                                 \
         PartitionedArray<Element, 2> const&,                                                                 \
-        PartitionedArray<Zone, 2> const&);
+        PartitionedArray<Zone, 2> const&);                                                                   \
+                                                                                                             \
+    template LUE_ZONAL_OPERATION_EXPORT PartitionedArray<Element, 2>                                         \
+    zonal_mean<ArgumentType<void(Policies)>, Element, Zone, 2>(                                              \
+        ArgumentType<void(Policies)> const&,                                                                 \
+        PartitionedArray<Element, 2> const&,                                                                 \
+        ZoneIndex<Zone, 2> const&);
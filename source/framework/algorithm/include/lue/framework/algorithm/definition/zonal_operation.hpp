@@ -1,15 +1,96 @@
 #pragma once
 #include "lue/framework/algorithm/detail/verify_compatible.hpp"
+#include "lue/framework/algorithm/detail/zone_map.hpp"
 #include "lue/framework/algorithm/functor_traits.hpp"
+#include "lue/framework/algorithm/zone_index.hpp"
 #include "lue/framework/core/annotate.hpp"
 #include "lue/framework/partitioned_array_decl.hpp"
 #include "lue/macro.hpp"
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <tuple>
+#include <vector>
 
 
 namespace lue {
     namespace detail {
         namespace zonal_operation {
 
+            //! Type of the partitions of the labels of a zone index
+            template<typename ZonesPartition>
+            using LabelsPartition = ArrayPartition<IndexElement, rank<ZonesPartition>>;
+
+            //! Number of cells per zone
+            template<typename Zone>
+            using ZoneCounts = ZoneMap<Zone, Count>;
+
+
+            /*!
+                @brief      Whether aggregators of type @a Aggregator keep track of the cells of a zone
+                            whose values are not aggregated, because they are no-data or outside of the
+                            domain
+            */
+            template<typename Aggregator, typename Zone>
+            concept SkipsCells = requires(Aggregator& aggregator, Zone const zone) { aggregator.skip(zone); };
+
+
+            /*!
+                @brief      Let @a aggregator know about a cell of @a zone whose value is not
+                            aggregated, if it keeps track of such cells
+            */
+            template<typename Aggregator, typename Zone>
+            void skip(Aggregator& aggregator, Zone const zone)
+            {
+                if constexpr (SkipsCells<Aggregator, Zone>)
+                {
+                    aggregator.skip(zone);
+                }
+            }
+
+
+            /*!
+                @brief      Prepare @a collections for the cells in @a zones_partition_data
+                @param      indp Input no-data policy of the zones
+                @param      collections Aggregators and zone maps to prepare
+
+                The range of zone ids is determined in a separate pass, before aggregating the cells,
+                so the collections can decide how to store their statistics independent of the order
+                in which the zones occur.
+            */
+            template<typename InputNoDataPolicy, typename ZonesData, typename... Collections>
+            void reserve(
+                InputNoDataPolicy const& indp,
+                ZonesData const& zones_partition_data,
+                Collections&... collections)
+            {
+                using Zone = ElementT<ZonesData>;
+
+                Count const nr_elements{lue::nr_elements(zones_partition_data)};
+                Count nr_cells{0};
+                Zone min_zone{};
+                Zone max_zone{};
+
+                for (Index i = 0; i < nr_elements; ++i)
+                {
+                    if (!indp.is_no_data(zones_partition_data, i))
+                    {
+                        Zone const zone{zones_partition_data[i]};
+
+                        min_zone = nr_cells == 0 ? zone : std::min(min_zone, zone);
+                        max_zone = nr_cells == 0 ? zone : std::max(max_zone, zone);
+                        ++nr_cells;
+                    }
+                }
+
+                if (nr_cells > 0)
+                {
+                    // Each cell can be in a different zone
+                    (collections.reserve(min_zone, max_zone, static_cast<std::size_t>(nr_cells)), ...);
+                }
+            }
+
+
             template<typename Policies, typename Input, typename ZonesPartition, typename Functor>
             class OverloadPicker
             {
@@ -18,20 +99,33 @@ namespace lue {
 
                     using InputElement = Input;
 
+                    //! Type of the input for all partitions located in a single locality
+                    using Inputs = hpx::shared_future<InputElement>;
+
+
+                    static auto input(Inputs const& inputs, [[maybe_unused]] std::size_t const idx)
+                        -> Inputs const&
+                    {
+                        return inputs;
+                    }
+
 
                     /*!
                         @brief      For this partition, calculate some statistic per zone
                         @param      input_scalar Input element to aggregate
                         @param      zones_partition Input zones
-                        @return     Future to collection of statistic per zone
+                        @return     Future to collection of statistic per zone, and to the number of
+                                    cells per zone, also for the zones without input values to aggregate
                     */
                     static auto zonal_operation_partition(
                         Policies const& policies,
                         hpx::shared_future<InputElement> const& input_scalar,
                         ZonesPartition const& zones_partition,
-                        Functor /* functor */) -> hpx::future<AggregatorT<Functor>>
+                        Functor /* functor */)
+                        -> hpx::future<std::tuple<AggregatorT<Functor>, ZoneCounts<ElementT<ZonesPartition>>>>
                     {
                         using ZonesData = DataT<ZonesPartition>;
+                        using Zone = ElementT<ZonesPartition>;
                         using Aggregator = AggregatorT<Functor>;
 
                         return hpx::dataflow(
@@ -55,24 +149,40 @@ namespace lue {
                                     std::get<1>(policies.inputs_policies()).input_no_data_policy();
 
                                 Aggregator result{};
+                                ZoneCounts<Zone> zone_counts{};
 
-                                if (!indp1.is_no_data(input_value))
+                                if (zones_partition_data.is_uniform() &&
+                                    indp2.is_no_data(zones_partition_data.uniform_value()))
                                 {
-                                    Count const nr_elements{lue::nr_elements(zones_partition_data)};
+                                    // All zones are no-data
+                                    return std::make_tuple(std::move(result), std::move(zone_counts));
+                                }
 
-                                    for (Index i = 0; i < nr_elements; ++i)
+                                reserve(indp2, zones_partition_data, result, zone_counts);
+
+                                bool const input_is_valid{!indp1.is_no_data(input_value)};
+                                Count const nr_elements{lue::nr_elements(zones_partition_data)};
+
+                                for (Index i = 0; i < nr_elements; ++i)
+                                {
+                                    if (!indp2.is_no_data(zones_partition_data, i))
                                     {
-                                        if (!indp2.is_no_data(zones_partition_data, i))
+                                        Zone const zone{zones_partition_data[i]};
+
+                                        ++zone_counts.insert(zone);
+
+                                        if (input_is_valid && dp.within_domain(zone, input_value))
                                         {
-                                            if (dp.within_domain(zones_partition_data[i], input_value))
-                                            {
-                                                result.add(zones_partition_data[i], input_value);
-                                            }
+                                            result.add(zone, input_value);
+                                        }
+                                        else
+                                        {
+                                            skip(result, zone);
                                         }
                                     }
                                 }
 
-                                return result;
+                                return std::make_tuple(std::move(result), std::move(zone_counts));
                             },
 
                             input_scalar,
@@ -80,13 +190,93 @@ namespace lue {
                     }
 
 
-                    struct Action:
-                        hpx::actions::make_action<
-                            decltype(&zonal_operation_partition),
-                            &zonal_operation_partition,
-                            Action>::type
+                    /*!
+                        @brief      For this partition, calculate some statistic per zone, given the
+                                    labels of a zone index
+                        @param      input_scalar Input element to aggregate
+                        @param      labels_partition Per cell the position of its zone in @a zones
+                        @param      zones Zones occurring in the locality, in increasing order
+                        @return     Future to collection of statistic per label
+
+                        Statistics are aggregated per label, in a dense map spanning all labels, and
+                        only translated to zones once per locality.
+                    */
+                    static auto zonal_operation_partition_indexed(
+                        Policies const& policies,
+                        hpx::shared_future<InputElement> const& input_scalar,
+                        LabelsPartition<ZonesPartition> const& labels_partition,
+                        std::shared_ptr<std::vector<ElementT<ZonesPartition>> const> const& zones,
+                        Functor /* functor */) -> hpx::future<LabelAggregatorT<Functor>>
                     {
-                    };
+                        using LabelsData = DataT<LabelsPartition<ZonesPartition>>;
+                        using Aggregator = LabelAggregatorT<Functor>;
+
+                        return hpx::dataflow(
+                            hpx::launch::async,
+
+                            [policies, zones_ptr = zones](
+                                hpx::shared_future<InputElement> const& input_scalar,
+                                LabelsPartition<ZonesPartition> const& labels_partition) -> auto
+                            {
+                                AnnotateFunction const annotation{
+                                    std::format("{}: partition", functor_name<Functor>)};
+
+                                auto const& zones{*zones_ptr};
+
+                                InputElement const input_value = input_scalar.get();
+                                LabelsData const labels_partition_data =
+                                    labels_partition.data(hpx::launch::sync);
+
+                                auto const& dp = policies.domain_policy();
+                                auto const& indp1 =
+                                    std::get<0>(policies.inputs_policies()).input_no_data_policy();
+
+                                auto const nr_zones{static_cast<IndexElement>(zones.size())};
+
+                                Aggregator result{};
+
+                                if (labels_partition_data.is_uniform() &&
+                                    labels_partition_data.uniform_value() == nr_zones)
+                                {
+                                    // All zones are no-data
+                                    return result;
+                                }
+
+                                bool const input_is_valid{!indp1.is_no_data(input_value)};
+
+                                if (input_is_valid || SkipsCells<Aggregator, IndexElement>)
+                                {
+                                    if (nr_zones > 0)
+                                    {
+                                        result.reserve(0, nr_zones - 1, static_cast<std::size_t>(nr_zones));
+                                    }
+
+                                    Count const nr_elements{lue::nr_elements(labels_partition_data)};
+
+                                    for (Index i = 0; i < nr_elements; ++i)
+                                    {
+                                        IndexElement const label{labels_partition_data[i]};
+
+                                        if (label < nr_zones)
+                                        {
+                                            if (input_is_valid && dp.within_domain(zones[label], input_value))
+                                            {
+                                                result.add(label, input_value);
+                                            }
+                                            else
+                                            {
+                                                skip(result, label);
+                                            }
+                                        }
+                                    }
+                                }
+
+                                return result;
+                            },
+
+                            input_scalar,
+                            labels_partition);
+                    }
             };
 
 
@@ -102,21 +292,33 @@ namespace lue {
 
                     using InputPartition = ArrayPartition<InputElement, rank<ZonesPartition>>;
 
+                    //! Type of the inputs for all partitions located in a single locality
+                    using Inputs = std::vector<InputPartition>;
+
+
+                    static auto input(Inputs const& inputs, std::size_t const idx) -> InputPartition const&
+                    {
+                        return inputs[idx];
+                    }
+
 
                     /*!
                         @brief      For this partition, calculate some statistic per zone
                         @param      input_partition Input elements to aggregate
                         @param      zones_partition Input zones
-                        @return     Future to collection of statistic per zone
+                        @return     Future to collection of statistic per zone, and to the number of
+                                    cells per zone, also for the zones without input values to aggregate
                     */
                     static auto zonal_operation_partition(
                         Policies const& policies,
                         InputPartition const& input_partition,
                         ZonesPartition const& zones_partition,
-                        Functor /* functor */) -> hpx::future<AggregatorT<Functor>>
+                        Functor /* functor */)
+                        -> hpx::future<std::tuple<AggregatorT<Functor>, ZoneCounts<ElementT<ZonesPartition>>>>
                     {
                         using InputData = DataT<InputPartition>;
                         using ZonesData = DataT<ZonesPartition>;
+                        using Zone = ElementT<ZonesPartition>;
                         using Aggregator = AggregatorT<Functor>;
 
                         return hpx::dataflow(
@@ -145,21 +347,38 @@ namespace lue {
                                 lue_hpx_assert(lue::nr_elements(input_partition_data) == nr_elements);
 
                                 Aggregator result{};
+                                ZoneCounts<Zone> zone_counts{};
+
+                                if (zones_partition_data.is_uniform() &&
+                                    indp2.is_no_data(zones_partition_data.uniform_value()))
+                                {
+                                    // All zones are no-data
+                                    return std::make_tuple(std::move(result), std::move(zone_counts));
+                                }
+
+                                reserve(indp2, zones_partition_data, result, zone_counts);
 
                                 for (Index i = 0; i < nr_elements; ++i)
                                 {
-                                    if (!indp1.is_no_data(input_partition_data, i) &&
-                                        !indp2.is_no_data(zones_partition_data, i))
+                                    if (!indp2.is_no_data(zones_partition_data, i))
                                     {
-                                        if (dp.within_domain(
-                                                zones_partition_data[i], input_partition_data[i]))
+                                        Zone const zone{zones_partition_data[i]};
+
+                                        ++zone_counts.insert(zone);
+
+                                        if (!indp1.is_no_data(input_partition_data, i) &&
+                                            dp.within_domain(zone, input_partition_data[i]))
+                                        {
+                                            result.add(zone, input_partition_data[i]);
+                                        }
+                                        else
                                         {
-                                            result.add(zones_partition_data[i], input_partition_data[i]);
+                                            skip(result, zone);
                                         }
                                     }
                                 }
 
-                                return result;
+                                return std::make_tuple(std::move(result), std::move(zone_counts));
                             },
 
                             input_partition,
@@ -167,299 +386,1187 @@ namespace lue {
                     }
 
 
-                    struct Action:
-                        hpx::actions::make_action<
-                            decltype(&zonal_operation_partition),
-                            &zonal_operation_partition,
-                            Action>::type
+                    /*!
+                        @brief      For this partition, calculate some statistic per zone, given the
+                                    labels of a zone index
+                        @param      input_partition Input elements to aggregate
+                        @param      labels_partition Per cell the position of its zone in @a zones
+                        @param      zones Zones occurring in the locality, in increasing order
+                        @return     Future to collection of statistic per label
+
+                        Statistics are aggregated per label, in a dense map spanning all labels, and
+                        only translated to zones once per locality.
+                    */
+                    static auto zonal_operation_partition_indexed(
+                        Policies const& policies,
+                        InputPartition const& input_partition,
+                        LabelsPartition<ZonesPartition> const& labels_partition,
+                        std::shared_ptr<std::vector<ElementT<ZonesPartition>> const> const& zones,
+                        Functor /* functor */) -> hpx::future<LabelAggregatorT<Functor>>
                     {
-                    };
+                        using InputData = DataT<InputPartition>;
+                        using LabelsData = DataT<LabelsPartition<ZonesPartition>>;
+                        using Aggregator = LabelAggregatorT<Functor>;
+
+                        return hpx::dataflow(
+                            hpx::launch::async,
+
+                            [policies, zones_ptr = zones](
+                                InputPartition const& input_partition,
+                                LabelsPartition<ZonesPartition> const& labels_partition) -> auto
+                            {
+                                AnnotateFunction const annotation{
+                                    std::format("{}: partition", functor_name<Functor>)};
+
+                                auto const& zones{*zones_ptr};
+
+                                InputData const input_partition_data =
+                                    input_partition.data(hpx::launch::sync);
+                                LabelsData const labels_partition_data =
+                                    labels_partition.data(hpx::launch::sync);
+
+                                auto const& dp = policies.domain_policy();
+                                auto const& indp1 =
+                                    std::get<0>(policies.inputs_policies()).input_no_data_policy();
+
+                                auto const nr_zones{static_cast<IndexElement>(zones.size())};
+                                Count const nr_elements{lue::nr_elements(labels_partition_data)};
+
+                                lue_hpx_assert(lue::nr_elements(input_partition_data) == nr_elements);
+
+                                Aggregator result{};
+
+                                if ((input_partition_data.is_uniform() &&
+                                     indp1.is_no_data(input_partition_data.uniform_value()) &&
+                                     !SkipsCells<Aggregator, IndexElement>) ||
+                                    (labels_partition_data.is_uniform() &&
+                                     labels_partition_data.uniform_value() == nr_zones))
+                                {
+                                    // All input values or all zones are no-data
+                                    return result;
+                                }
+
+                                if (nr_zones > 0)
+                                {
+                                    result.reserve(0, nr_zones - 1, static_cast<std::size_t>(nr_zones));
+                                }
+
+                                for (Index i = 0; i < nr_elements; ++i)
+                                {
+                                    IndexElement const label{labels_partition_data[i]};
+
+                                    if (label < nr_zones)
+                                    {
+                                        if (!indp1.is_no_data(input_partition_data, i) &&
+                                            dp.within_domain(zones[label], input_partition_data[i]))
+                                        {
+                                            result.add(label, input_partition_data[i]);
+                                        }
+                                        else
+                                        {
+                                            skip(result, label);
+                                        }
+                                    }
+                                }
+
+                                return result;
+                            },
+
+                            input_partition,
+                            labels_partition);
+                    }
             };
 
-        }  // Namespace zonal_operation
 
+            //! Statistic per zone, as assigned to the cells of each zone
+            template<typename Zone, typename Functor>
+            using Statistics = ZoneMap<Zone, OutputElementT<Functor>>;
 
-        /*!
-            @brief      For a partition, translate input zones to result values,
-                        given a collection of statistic per zone passed in
-            @param      zones_partition Input zones
-            @param      aggregator Collection of statistic per zone
-            @return     Partition with per zone the corresponding statistic
-        */
-        template<typename Policies, typename ZonesPartition, typename OutputPartition, typename Functor>
-        auto zonal_operation_partition2(
-            Policies const& policies, ZonesPartition const& zones_partition, AggregatorT<Functor> aggregator)
-            -> OutputPartition
-        {
-            using Offset = OffsetT<ZonesPartition>;
-            using ZonesData = DataT<ZonesPartition>;
-            using OutputData = DataT<OutputPartition>;
 
-            return hpx::dataflow(
-                hpx::launch::async,
+            /*!
+                @brief      Merge the collections in @a collections
+                @param      merge Function merging a second collection into a first one
+                @return     Future to the merged collection
+
+                Pairs of collections are merged concurrently, level by level, like in a binary tree.
+                This keeps the number of merges which must be performed one after the other
+                logarithmic in the number of collections.
+            */
+            template<typename Functor, typename Collection, typename Merge>
+            auto merge(std::vector<hpx::future<Collection>>&& collections, Merge const& merge)
+                -> hpx::future<Collection>
+            {
+                if (collections.empty())
+                {
+                    return hpx::make_ready_future<Collection>();
+                }
 
-                [policies,
-                 aggregator = std::move(aggregator)](ZonesPartition const& zones_partition) -> OutputPartition
+                while (collections.size() > 1)
                 {
-                    AnnotateFunction const annotation{
-                        std::format("{}: partition: reclass", functor_name<Functor>)};
+                    std::vector<hpx::future<Collection>> merged_collections{};
+                    merged_collections.reserve((collections.size() + 1) / 2);
+
+                    for (std::size_t idx = 0; idx + 1 < collections.size(); idx += 2)
+                    {
+                        merged_collections.push_back(hpx::dataflow(
+                            hpx::launch::async,
+                            hpx::unwrapping(
+
+                                [merge](Collection collection1, Collection const& collection2) -> Collection
+                                {
+                                    AnnotateFunction const annotation{
+                                        std::format("{}: merge", functor_name<Functor>)};
+
+                                    merge(collection1, collection2);
+
+                                    return collection1;
+                                }
+
+                                ),
+                            std::move(collections[idx]),
+                            std::move(collections[idx + 1])));
+                    }
+
+                    if (collections.size() % 2 == 1)
+                    {
+                        merged_collections.push_back(std::move(collections.back()));
+                    }
+
+                    collections = std::move(merged_collections);
+                }
+
+                return std::move(collections.front());
+            }
 
-                    ZonesData const zones_partition_data = zones_partition.data(hpx::launch::sync);
-                    Offset const offset = zones_partition.offset(hpx::launch::sync);
-                    OutputData output_partition_data{zones_partition_data.shape()};
 
-                    auto const& ondp = std::get<0>(policies.outputs_policies()).output_no_data_policy();
+            template<typename Functor>
+            auto merge_aggregators(std::vector<hpx::future<AggregatorT<Functor>>>&& aggregators)
+                -> hpx::future<AggregatorT<Functor>>
+            {
+                using Aggregator = AggregatorT<Functor>;
+
+                return merge<Functor>(
+                    std::move(aggregators),
+                    [](Aggregator& aggregator1, Aggregator const& aggregator2)
+                    { aggregator1.merge(aggregator2); });
+            }
 
-                    Count const nr_elements{lue::nr_elements(zones_partition_data)};
 
-                    for (Index i = 0; i < nr_elements; ++i)
+            template<typename Functor, typename Zone>
+            auto merge_zone_counts(std::vector<hpx::future<ZoneCounts<Zone>>>&& zone_counts)
+                -> hpx::future<ZoneCounts<Zone>>
+            {
+                return merge<Functor>(
+                    std::move(zone_counts),
+                    [](ZoneCounts<Zone>& zone_counts1, ZoneCounts<Zone> const& zone_counts2)
                     {
-                        if (!aggregator.contains(zones_partition_data[i]))
+                        zone_counts1.merge(
+                            zone_counts2, [](Count& count1, Count const count2) { count1 += count2; });
+                    });
+            }
+
+
+            /*!
+                @brief      For this partition, count the number of cells per zone
+                @param      indp Input no-data policy of the zones
+                @param      zones_partition Input zones
+                @return     Future to collection of number of cells per zone
+
+                Cells containing no-data are skipped. Zonal operations count the cells while
+                aggregating them. This function is for when only the zones are needed, like when
+                building a zone index.
+            */
+            template<typename Functor, typename InputNoDataPolicy, typename ZonesPartition>
+            auto zone_counts_partition(InputNoDataPolicy const& indp, ZonesPartition const& zones_partition)
+                -> hpx::future<ZoneCounts<ElementT<ZonesPartition>>>
+            {
+                using Zone = ElementT<ZonesPartition>;
+                using ZonesData = DataT<ZonesPartition>;
+
+                return hpx::dataflow(
+                    hpx::launch::async,
+
+                    [indp](ZonesPartition const& zones_partition) -> ZoneCounts<Zone>
+                    {
+                        AnnotateFunction const annotation{
+                            std::format("{}: partition: count zones", functor_name<Functor>)};
+
+                        ZonesData const zones_partition_data = zones_partition.data(hpx::launch::sync);
+
+                        Count const nr_elements{lue::nr_elements(zones_partition_data)};
+                        ZoneCounts<Zone> result{};
+
+                        if (zones_partition_data.is_uniform())
                         {
-                            ondp.mark_no_data(output_partition_data, i);
+                            if (!indp.is_no_data(zones_partition_data.uniform_value()))
+                            {
+                                result.insert(zones_partition_data.uniform_value()) = nr_elements;
+                            }
+
+                            return result;
                         }
-                        else
+
+                        reserve(indp, zones_partition_data, result);
+
+                        for (Index i = 0; i < nr_elements; ++i)
                         {
-                            output_partition_data[i] = aggregator[zones_partition_data[i]];
+                            if (!indp.is_no_data(zones_partition_data, i))
+                            {
+                                ++result.insert(zones_partition_data[i]);
+                            }
                         }
-                    }
 
-                    return {hpx::find_here(), offset, std::move(output_partition_data)};
-                },
+                        return result;
+                    },
 
-                zones_partition);
-        }
+                    zones_partition);
+            }
 
 
-        template<typename Policies, typename T, typename ZonesPartition, typename Functor>
-        using ZonalOperationPartitionAction1 =
-            typename zonal_operation::OverloadPicker<Policies, T, ZonesPartition, Functor>::Action;
+            /*!
+                @brief      For all partitions located in this locality, calculate some statistic per
+                            zone
+                @param      inputs Inputs to aggregate
+                @param      zones_partitions Input zones
+                @return     Future to collection of statistic per zone, merged over all partitions, and
+                            to the number of cells per zone occurring in the partitions
+            */
+            template<typename Policies, typename T, typename ZonesPartition, typename Functor>
+            auto zonal_operation_locality(
+                Policies const& policies,
+                typename OverloadPicker<Policies, T, ZonesPartition, Functor>::Inputs const& inputs,
+                std::vector<ZonesPartition> const& zones_partitions,
+                Functor const& functor)
+                -> hpx::future<std::tuple<AggregatorT<Functor>, ZoneCounts<ElementT<ZonesPartition>>>>
+            {
+                using Picker = OverloadPicker<Policies, T, ZonesPartition, Functor>;
+                using Aggregator = AggregatorT<Functor>;
+                using Zone = ElementT<ZonesPartition>;
 
+                std::vector<hpx::future<Aggregator>> aggregators{};
+                std::vector<hpx::future<ZoneCounts<Zone>>> zone_counts{};
+                aggregators.reserve(zones_partitions.size());
+                zone_counts.reserve(zones_partitions.size());
 
-        template<typename Policies, typename ZonesPartition, typename OutputPartition, typename Functor>
-        struct ZonalOperationPartitionAction2:
-            hpx::actions::make_action<
-                decltype(&zonal_operation_partition2<Policies, ZonesPartition, OutputPartition, Functor>),
-                &zonal_operation_partition2<Policies, ZonesPartition, OutputPartition, Functor>,
-                ZonalOperationPartitionAction2<Policies, ZonesPartition, OutputPartition, Functor>>::type
-        {
-        };
+                for (std::size_t idx = 0; idx < zones_partitions.size(); ++idx)
+                {
+                    // The zones are counted while aggregating, in the same pass over the partition
+                    auto [aggregator, counts] = hpx::split_future(Picker::zonal_operation_partition(
+                        policies, Picker::input(inputs, idx), zones_partitions[idx], functor));
 
-    }  // namespace detail
+                    aggregators.push_back(std::move(aggregator));
+                    zone_counts.push_back(std::move(counts));
+                }
 
+                return hpx::dataflow(
+                    hpx::launch::async,
+                    hpx::unwrapping(
+                        [](Aggregator&& aggregator, ZoneCounts<Zone>&& zone_counts)
+                        { return std::make_tuple(std::move(aggregator), std::move(zone_counts)); }),
+                    merge_aggregators<Functor>(std::move(aggregators)),
+                    merge_zone_counts<Functor>(std::move(zone_counts)));
+            }
 
-    template<typename Policies, typename InputElement, typename Zone, Rank rank, typename Functor>
-    auto zonal_operation(
-        Policies const& policies,
-        hpx::shared_future<InputElement> const input_scalar,
-        PartitionedArray<Zone, rank> const& zones_array,
-        Functor const& functor) -> PartitionedArray<OutputElementT<Functor>, rank>
-    {
-        using ZonesArray = PartitionedArray<Zone, rank>;
-        using ZonesPartitions = PartitionsT<ZonesArray>;
-        using ZonesPartition = PartitionT<ZonesArray>;
 
-        using OutputArray = PartitionedArray<OutputElementT<Functor>, rank>;
-        using OutputPartitions = PartitionsT<OutputArray>;
-        using OutputPartition = PartitionT<OutputArray>;
+            /*!
+                @brief      Return the statistic per zone for the zones in @a zone_counts
+                @param      aggregator Collection of statistic per zone, for the whole array
+                @param      zone_counts Zones occurring in the partitions located in a locality
+                @param      select Function returning the statistic of a zone, given @a aggregator
+
+                The statistics are calculated once per zone, instead of once per cell, and only for
+                the zones occurring in the locality's partitions. Zones for which no statistic could
+                be calculated are skipped.
+            */
+            template<typename Functor, typename Zone, typename Aggregator, typename Select>
+            auto statistics(
+                Aggregator const& aggregator,
+                ZoneCounts<Zone> const& zone_counts,
+                Select const& select) -> Statistics<Zone, Functor>
+            {
+                AnnotateFunction const annotation{
+                    std::format("{}: select statistics", functor_name<Functor>)};
 
-        using Aggregator = AggregatorT<Functor>;
-        using Aggregators = std::vector<hpx::future<Aggregator>>;
+                Statistics<Zone, Functor> result{};
 
-        Count const nr_partitions{lue::nr_partitions(zones_array)};
+                zone_counts.for_each(
+                    [&aggregator, &select, &result](Zone const zone, [[maybe_unused]] Count const count)
+                    {
+                        if (aggregator.contains(zone))
+                        {
+                            result.insert(zone) = select(aggregator, zone);
+                        }
+                    });
+
+                return result;
+            }
 
-        Localities<rank> const& localities{zones_array.localities()};
-        ZonesPartitions const& zones_partitions{zones_array.partitions()};
 
-        // -------------------------------------------------------------------------
-        // 1. Per partition, calculate a statistic per zone. This
-        //     results in some operation-specific object that contains this
-        //     information. Example: sum per zone
-        Aggregators aggregators{static_cast<std::size_t>(nr_partitions)};
+            template<typename Policies, typename T, typename ZonesPartition, typename Functor>
+            struct ZonalOperationLocalityAction:
+                hpx::actions::make_action<
+                    decltype(&zonal_operation_locality<Policies, T, ZonesPartition, Functor>),
+                    &zonal_operation_locality<Policies, T, ZonesPartition, Functor>,
+                    ZonalOperationLocalityAction<Policies, T, ZonesPartition, Functor>>::type
+            {
+            };
 
-        {
-            detail::ZonalOperationPartitionAction1<Policies, InputElement, ZonesPartition, Functor> action;
 
-            for (Index partition_idx = 0; partition_idx < nr_partitions; ++partition_idx)
+            /*!
+                @brief      Return the zones in @a zone_counts, in increasing order
+            */
+            template<typename Zone>
+            auto sorted_zones(ZoneCounts<Zone> const& zone_counts) -> std::vector<Zone>
             {
-                aggregators[partition_idx] = hpx::async(
-                    action,
-                    localities[partition_idx],
-                    policies,
-                    input_scalar,
-                    zones_partitions[partition_idx],
-                    functor);
+                std::vector<Zone> result{};
+                result.reserve(zone_counts.nr_zones());
+
+                zone_counts.for_each([&result](Zone const zone, [[maybe_unused]] Count const count)
+                                     { result.push_back(zone); });
+
+                std::sort(result.begin(), result.end());
+
+                return result;
             }
-        }
 
-        // -------------------------------------------------------------------------
-        // 2. Merge the zonal statistics of all partitions. This
-        //     results in the same operation-specific object, but now
-        //     containing information for the whole array.
 
-        hpx::shared_future<Aggregator> aggregator =
-            hpx::when_all(std::move(aggregators))
-                .then(
-                    [](hpx::future<Aggregators>&& aggregators) -> auto
+            /*!
+                @brief      For all partitions located in this locality, calculate some statistic per
+                            zone, given the labels of a zone index
+                @param      inputs Inputs to aggregate
+                @param      labels_partitions Per cell the position of its zone in @a zones
+                @param      zones Zones occurring in the locality, in increasing order
+                @return     Future to collection of statistic per zone, merged over all partitions
+
+                The statistics of the partitions are merged per label, after which the merged
+                statistics are translated to zones once.
+            */
+            template<typename Policies, typename T, typename ZonesPartition, typename Functor>
+            auto zonal_operation_locality_indexed(
+                Policies const& policies,
+                typename OverloadPicker<Policies, T, ZonesPartition, Functor>::Inputs const& inputs,
+                std::vector<LabelsPartition<ZonesPartition>> const& labels_partitions,
+                std::vector<ElementT<ZonesPartition>> zones,
+                Functor const& functor) -> hpx::future<AggregatorT<Functor>>
+            {
+                using Picker = OverloadPicker<Policies, T, ZonesPartition, Functor>;
+                using Aggregator = AggregatorT<Functor>;
+                using LabelAggregator = LabelAggregatorT<Functor>;
+                using Zones = std::vector<ElementT<ZonesPartition>>;
+
+                auto const zones_ptr{std::make_shared<Zones const>(std::move(zones))};
+
+                std::vector<hpx::future<LabelAggregator>> aggregators{};
+                aggregators.reserve(labels_partitions.size());
+
+                for (std::size_t idx = 0; idx < labels_partitions.size(); ++idx)
+                {
+                    aggregators.push_back(Picker::zonal_operation_partition_indexed(
+                        policies, Picker::input(inputs, idx), labels_partitions[idx], zones_ptr, functor));
+                }
+
+                return merge<Functor>(
+                           std::move(aggregators),
+                           [](LabelAggregator& aggregator1, LabelAggregator const& aggregator2)
+                           { aggregator1.merge(aggregator2); })
+                    .then(
+                        [zones_ptr](hpx::future<LabelAggregator>&& label_aggregator) -> Aggregator
+                        {
+                            AnnotateFunction const annotation{
+                                std::format("{}: translate labels", functor_name<Functor>)};
+
+                            auto const& zones{*zones_ptr};
+
+                            Aggregator result{};
+
+                            if (!zones.empty())
+                            {
+                                result.reserve(zones.front(), zones.back(), zones.size());
+                            }
+
+                            result.merge(label_aggregator.get(), zones);
+
+                            return result;
+                        });
+            }
+
+
+            template<typename Policies, typename T, typename ZonesPartition, typename Functor>
+            struct ZonalOperationLocalityIndexedAction:
+                hpx::actions::make_action<
+                    decltype(&zonal_operation_locality_indexed<Policies, T, ZonesPartition, Functor>),
+                    &zonal_operation_locality_indexed<Policies, T, ZonesPartition, Functor>,
+                    ZonalOperationLocalityIndexedAction<Policies, T, ZonesPartition, Functor>>::type
+            {
+            };
+
+
+            /*!
+                @brief      For a partition, translate input zones to result values,
+                            given a collection of statistic per zone passed in
+                @param      zones_partition Input zones
+                @param      statistics Collection of statistic per zone, for at least the zones
+                            occurring in @a zones_partition
+                @return     Partition with per zone the corresponding statistic
+            */
+            template<typename Policies, typename ZonesPartition, typename OutputPartition, typename Functor>
+            auto zonal_operation_partition2(
+                Policies const& policies,
+                ZonesPartition const& zones_partition,
+                std::shared_ptr<Statistics<ElementT<ZonesPartition>, Functor> const> const& statistics)
+                -> OutputPartition
+            {
+                using Offset = OffsetT<ZonesPartition>;
+                using ZonesData = DataT<ZonesPartition>;
+                using OutputData = DataT<OutputPartition>;
+
+                return hpx::dataflow(
+                    hpx::launch::async,
+
+                    [policies, statistics_ptr = statistics](
+                        ZonesPartition const& zones_partition) -> OutputPartition
                     {
                         AnnotateFunction const annotation{
-                            std::format("{}: aggregate", functor_name<Functor>)};
+                            std::format("{}: partition: reclass", functor_name<Functor>)};
 
-                        Aggregator result{};
+                        auto const& statistics{*statistics_ptr};
 
-                        for (hpx::future<Aggregator>& aggregator : aggregators.get())
+                        ZonesData const zones_partition_data = zones_partition.data(hpx::launch::sync);
+                        Offset const offset = zones_partition.offset(hpx::launch::sync);
+
+                        auto const& ondp = std::get<0>(policies.outputs_policies()).output_no_data_policy();
+
+                        if (zones_partition_data.is_uniform())
                         {
-                            result.merge(aggregator.get());
+                            // All cells are in the same zone, or are no-data
+                            auto const zone = zones_partition_data.uniform_value();
+                            OutputElementT<Functor> output_value;
+
+                            if (!statistics.contains(zone))
+                            {
+                                ondp.mark_no_data(output_value);
+                            }
+                            else
+                            {
+                                output_value = statistics[zone];
+                            }
+
+                            return {
+                                hpx::find_here(),
+                                offset,
+                                OutputData{zones_partition_data.shape(), output_value, UniformTag{}}};
                         }
 
-                        return result;
-                    });
+                        OutputData output_partition_data{zones_partition_data.shape()};
+
+                        Count const nr_elements{lue::nr_elements(zones_partition_data)};
+
+                        for (Index i = 0; i < nr_elements; ++i)
+                        {
+                            if (!statistics.contains(zones_partition_data[i]))
+                            {
+                                ondp.mark_no_data(output_partition_data, i);
+                            }
+                            else
+                            {
+                                output_partition_data[i] = statistics[zones_partition_data[i]];
+                            }
+                        }
+
+                        return {hpx::find_here(), offset, std::move(output_partition_data)};
+                    },
 
-        // -------------------------------------------------------------------------
-        // 3. Per input partition, translate input zone to output statistic.
+                    zones_partition);
+            }
 
-        OutputPartitions output_partitions{shape_in_partitions(zones_array)};
 
-        {
-            detail::ZonalOperationPartitionAction2<Policies, ZonesPartition, OutputPartition, Functor> action;
+            /*!
+                @brief      For all partitions located in this locality, translate input zones to
+                            result values, given a collection of statistic per zone passed in
+                @param      zones_partitions Input zones
+                @param      statistics Collection of statistic per zone, for the zones occurring in
+                            @a zones_partitions, shared by all partitions
+                @return     Partitions with per zone the corresponding statistic
+
+                The partitions are returned immediately. Each of them becomes ready on its own, once
+                its statistics are assigned.
+            */
+            template<typename Policies, typename ZonesPartition, typename OutputPartition, typename Functor>
+            auto zonal_operation_locality2(
+                Policies const& policies,
+                std::vector<ZonesPartition> const& zones_partitions,
+                Statistics<ElementT<ZonesPartition>, Functor> statistics) -> std::vector<OutputPartition>
+            {
+                using LocalityStatistics = Statistics<ElementT<ZonesPartition>, Functor>;
+
+                auto const statistics_ptr{std::make_shared<LocalityStatistics const>(std::move(statistics))};
+
+                std::vector<OutputPartition> output_partitions{};
+                output_partitions.reserve(zones_partitions.size());
+
+                for (ZonesPartition const& zones_partition : zones_partitions)
+                {
+                    output_partitions.push_back(
+                        zonal_operation_partition2<Policies, ZonesPartition, OutputPartition, Functor>(
+                            policies, zones_partition, statistics_ptr));
+                }
+
+                return output_partitions;
+            }
+
+
+            template<typename Policies, typename ZonesPartition, typename OutputPartition, typename Functor>
+            struct ZonalOperationLocalityAction2:
+                hpx::actions::make_action<
+                    decltype(&zonal_operation_locality2<Policies, ZonesPartition, OutputPartition, Functor>),
+                    &zonal_operation_locality2<Policies, ZonesPartition, OutputPartition, Functor>,
+                    ZonalOperationLocalityAction2<Policies, ZonesPartition, OutputPartition, Functor>>::type
+            {
+            };
+
+
+            /*!
+                @brief      Return the statistic per zone for the zones in @a zones, followed by a
+                            no-data value
+                @param      aggregator Collection of statistic per zone, for the whole array
+                @param      zones Zones occurring in the partitions located in a locality, in
+                            increasing order
+                @param      select Function returning the statistic of a zone, given @a aggregator
+
+                The result can be indexed by the labels of a zone index. Zones for which no statistic
+                could be calculated are marked as no-data.
+            */
+            template<typename Functor, typename Policies, typename Zone, typename Aggregator, typename Select>
+            auto statistic_values(
+                Policies const& policies,
+                Aggregator const& aggregator,
+                std::vector<Zone> const& zones,
+                Select const& select) -> std::vector<OutputElementT<Functor>>
+            {
+                using OutputElement = OutputElementT<Functor>;
+
+                AnnotateFunction const annotation{
+                    std::format("{}: select statistics", functor_name<Functor>)};
+
+                auto const& ondp = std::get<0>(policies.outputs_policies()).output_no_data_policy();
+
+                std::vector<OutputElement> result(zones.size() + 1);
+
+                for (std::size_t idx = 0; idx < zones.size(); ++idx)
+                {
+                    if (aggregator.contains(zones[idx]))
+                    {
+                        result[idx] = select(aggregator, zones[idx]);
+                    }
+                    else
+                    {
+                        ondp.mark_no_data(result[idx]);
+                    }
+                }
+
+                // Value of cells without a zone
+                ondp.mark_no_data(result.back());
+
+                return result;
+            }
 
-            for (Index partition_idx = 0; partition_idx < nr_partitions; ++partition_idx)
+
+            /*!
+                @brief      For a partition, translate labels of a zone index to result values,
+                            given a collection of statistic per label passed in
+                @param      labels_partition Per cell the position of its zone in the locality's zones
+                @param      values Statistic per label, as returned by statistic_values()
+                @return     Partition with per zone the corresponding statistic
+            */
+            template<typename LabelsPartition, typename OutputPartition, typename Functor>
+            auto zonal_operation_partition2_indexed(
+                LabelsPartition const& labels_partition,
+                std::shared_ptr<std::vector<OutputElementT<Functor>> const> const& values) -> OutputPartition
             {
-                output_partitions[partition_idx] = hpx::dataflow(
+                using Offset = OffsetT<LabelsPartition>;
+                using LabelsData = DataT<LabelsPartition>;
+                using OutputData = DataT<OutputPartition>;
+
+                return hpx::dataflow(
                     hpx::launch::async,
 
-                    [locality_id = localities[partition_idx],
-                     action,
-                     policies,
-                     zones_partition = zones_partitions[partition_idx]](
-                        hpx::shared_future<Aggregator> const& aggregator) -> OutputPartition
-                    { return hpx::async(action, locality_id, policies, zones_partition, aggregator.get()); },
+                    [values_ptr = values](LabelsPartition const& labels_partition) -> OutputPartition
+                    {
+                        AnnotateFunction const annotation{
+                            std::format("{}: partition: reclass", functor_name<Functor>)};
+
+                        auto const& values{*values_ptr};
+
+                        LabelsData const labels_partition_data = labels_partition.data(hpx::launch::sync);
+                        Offset const offset = labels_partition.offset(hpx::launch::sync);
+
+                        if (labels_partition_data.is_uniform())
+                        {
+                            // All cells are in the same zone, or are no-data
+                            return {
+                                hpx::find_here(),
+                                offset,
+                                OutputData{
+                                    labels_partition_data.shape(),
+                                    values[labels_partition_data.uniform_value()],
+                                    UniformTag{}}};
+                        }
+
+                        OutputData output_partition_data{labels_partition_data.shape()};
+
+                        Count const nr_elements{lue::nr_elements(labels_partition_data)};
+
+                        for (Index i = 0; i < nr_elements; ++i)
+                        {
+                            output_partition_data[i] = values[labels_partition_data[i]];
+                        }
 
-                    aggregator);
+                        return {hpx::find_here(), offset, std::move(output_partition_data)};
+                    },
+
+                    labels_partition);
             }
-        }
 
-        return {zones_array, std::move(output_partitions)};
-    }
 
+            /*!
+                @brief      For all partitions located in this locality, translate labels of a zone
+                            index to result values, given a collection of statistic per label passed in
+                @param      labels_partitions Per cell the position of its zone in the locality's zones
+                @param      values Statistic per label, as returned by statistic_values(), shared by
+                            all partitions
+                @return     Partitions with per zone the corresponding statistic
+
+                The partitions are returned immediately. Each of them becomes ready on its own, once
+                its statistics are assigned.
+            */
+            template<typename LabelsPartition, typename OutputPartition, typename Functor>
+            auto zonal_operation_locality2_indexed(
+                std::vector<LabelsPartition> const& labels_partitions,
+                std::vector<OutputElementT<Functor>> values) -> std::vector<OutputPartition>
+            {
+                using Values = std::vector<OutputElementT<Functor>>;
 
-    template<typename Policies, typename InputElement, typename Zone, Rank rank, typename Functor>
-    auto zonal_operation(
-        Policies const& policies,
-        InputElement const input_value,
-        PartitionedArray<Zone, rank> const& zones_array,
-        Functor const& functor) -> PartitionedArray<OutputElementT<Functor>, rank>
-    {
-        return zonal_operation(
-            policies, hpx::make_ready_future<InputElement>(input_value).share(), zones_array, functor);
-    }
+                auto const values_ptr{std::make_shared<Values const>(std::move(values))};
 
+                std::vector<OutputPartition> output_partitions{};
+                output_partitions.reserve(labels_partitions.size());
 
-    template<typename Policies, typename InputElement, typename Zone, Rank rank, typename Functor>
-    auto zonal_operation(
-        Policies const& policies,
-        PartitionedArray<InputElement, rank> const& input_array,
-        PartitionedArray<Zone, rank> const& zones_array,
-        Functor const& functor) -> PartitionedArray<OutputElementT<Functor>, rank>
-    {
-        using InputArray = PartitionedArray<InputElement, rank>;
-        using InputPartitions = PartitionsT<InputArray>;
-        using InputPartition = PartitionT<InputArray>;
+                for (LabelsPartition const& labels_partition : labels_partitions)
+                {
+                    output_partitions.push_back(
+                        zonal_operation_partition2_indexed<LabelsPartition, OutputPartition, Functor>(
+                            labels_partition, values_ptr));
+                }
 
-        using ZonesArray = PartitionedArray<Zone, rank>;
-        using ZonesPartitions = PartitionsT<ZonesArray>;
-        using ZonesPartition = PartitionT<ZonesArray>;
+                return output_partitions;
+            }
 
-        using OutputArray = PartitionedArray<OutputElementT<Functor>, rank>;
-        using OutputPartitions = PartitionsT<OutputArray>;
-        using OutputPartition = PartitionT<OutputArray>;
 
-        using Aggregator = AggregatorT<Functor>;
-        using Aggregators = std::vector<hpx::future<Aggregator>>;
+            template<typename LabelsPartition, typename OutputPartition, typename Functor>
+            struct ZonalOperationLocalityIndexedAction2:
+                hpx::actions::make_action<
+                    decltype(&zonal_operation_locality2_indexed<LabelsPartition, OutputPartition, Functor>),
+                    &zonal_operation_locality2_indexed<LabelsPartition, OutputPartition, Functor>,
+                    ZonalOperationLocalityIndexedAction2<LabelsPartition, OutputPartition, Functor>>::type
+            {
+            };
 
-        detail::verify_compatible(input_array, zones_array);
+        }  // Namespace zonal_operation
 
-        Count const nr_partitions{lue::nr_partitions(zones_array)};
 
-        Localities<rank> const& localities{zones_array.localities()};
-        ZonesPartitions const& zones_partitions{zones_array.partitions()};
+        /*!
+            @brief      Return, per locality, the linear indices of the partitions located in it
+        */
+        template<Rank rank>
+        auto partition_idxs_by_locality(Localities<rank> const& localities)
+            -> std::map<hpx::id_type, std::vector<Index>>
+        {
+            std::map<hpx::id_type, std::vector<Index>> partition_idxs{};
 
-        // -------------------------------------------------------------------------
-        // 1. Per input partition, calculate a statistic per zone. This
-        //     results in some operation-specific object that contains this
-        //     information. Example: sum per zone
-        Aggregators aggregators{static_cast<std::size_t>(nr_partitions)};
+            for (Index partition_idx = 0; partition_idx < localities.nr_elements(); ++partition_idx)
+            {
+                partition_idxs[localities[partition_idx]].push_back(partition_idx);
+            }
+
+            return partition_idxs;
+        }
+
+
+        /*!
+            @brief      Collection of statistic per zone, resulting from aggregating input values per
+                        zone, and information about where the zones occur
+        */
+        template<typename Zone, typename Aggregator>
+        struct ZonalAggregate
+        {
+                //! Per locality, the linear indices of the partitions located in it
+                std::map<hpx::id_type, std::vector<Index>> partition_idxs;
 
+                //! Collection of statistic per zone, for the whole array
+                hpx::shared_future<Aggregator> aggregator;
+
+                //! Per locality, in the order of @a partition_idxs, the zones occurring in it
+                std::vector<hpx::shared_future<zonal_operation::ZoneCounts<Zone>>> zone_counts;
+        };
+
+
+        /*!
+            @brief      Return the partitions of @a array with linear indices @a idxs
+        */
+        template<typename Element, Rank rank>
+        auto select_partitions(PartitionedArray<Element, rank> const& array, std::vector<Index> const& idxs)
+            -> std::vector<PartitionT<PartitionedArray<Element, rank>>>
         {
-            detail::ZonalOperationPartitionAction1<Policies, InputPartition, ZonesPartition, Functor> action;
+            auto const& partitions{array.partitions()};
 
-            InputPartitions const& input_partitions{input_array.partitions()};
+            std::vector<PartitionT<PartitionedArray<Element, rank>>> result{};
+            result.reserve(idxs.size());
 
-            for (Index partition_idx = 0; partition_idx < nr_partitions; ++partition_idx)
+            for (Index const partition_idx : idxs)
             {
-                aggregators[partition_idx] = hpx::async(
-                    action,
-                    localities[partition_idx],
-                    policies,
-                    input_partitions[partition_idx],
-                    zones_partitions[partition_idx],
-                    functor);
+                result.push_back(partitions[partition_idx]);
             }
+
+            return result;
         }
 
-        // -------------------------------------------------------------------------
-        // 2. Merge the zonal statistics of all input partitions. This
-        //     results in the same operation-specific object, but now
-        //     containing information for the whole array.
 
-        hpx::shared_future<Aggregator> aggregator =
-            hpx::when_all(std::move(aggregators))
-                .then(
-                    [](hpx::future<Aggregators>&& aggregators) -> auto
+        /*!
+            @brief      Calculate a statistic per zone
+            @tparam     T Type of the inputs to aggregate: an element type or a partition type
+            @param      inputs Function returning, for a collection of partition indices, the inputs
+                        to aggregate for these partitions
+
+            The statistics are reduced hierarchically. First, the statistics of the partitions
+            located in the same locality are merged in that locality. Then, the statistics of all
+            localities are merged.
+        */
+        template<typename T, typename Policies, typename Zone, Rank rank, typename Functor, typename Inputs>
+        auto zonal_aggregate(
+            Policies const& policies,
+            Inputs const& inputs,
+            PartitionedArray<Zone, rank> const& zones_array,
+            Functor const& functor) -> ZonalAggregate<Zone, AggregatorT<Functor>>
+        {
+            using ZonesPartition = PartitionT<PartitionedArray<Zone, rank>>;
+            using Aggregator = AggregatorT<Functor>;
+            using ZoneCounts = zonal_operation::ZoneCounts<Zone>;
+
+            ZonalAggregate<Zone, Aggregator> result{partition_idxs_by_locality(zones_array.localities())};
+
+            // -------------------------------------------------------------------------
+            // 1. Per locality, calculate a statistic per zone, for all partitions located
+            //     there. This results in some operation-specific object that contains this
+            //     information. Example: sum per zone. Also keep track of the zones
+            //     occurring in each locality.
+            std::vector<hpx::future<Aggregator>> aggregators{};
+            aggregators.reserve(result.partition_idxs.size());
+            result.zone_counts.reserve(result.partition_idxs.size());
+
+            {
+                zonal_operation::ZonalOperationLocalityAction<Policies, T, ZonesPartition, Functor> action;
+
+                for (auto const& [locality_id, idxs] : result.partition_idxs)
+                {
+                    auto [aggregator, zone_counts] = hpx::split_future(hpx::async(
+                        action,
+                        locality_id,
+                        policies,
+                        inputs(idxs),
+                        select_partitions(zones_array, idxs),
+                        functor));
+
+                    aggregators.push_back(std::move(aggregator));
+                    result.zone_counts.push_back(zone_counts.share());
+                }
+            }
+
+            // -------------------------------------------------------------------------
+            // 2. Merge the zonal statistics of all localities. This
+            //     results in the same operation-specific object, but now
+            //     containing information for the whole array.
+            result.aggregator = zonal_operation::merge_aggregators<Functor>(std::move(aggregators));
+
+            return result;
+        }
+
+
+        /*!
+            @brief      Assign the statistic of each zone to the cells of the zone
+            @tparam     Functor Functor determining the output element type
+            @param      aggregate Result of zonal_aggregate(), for @a zones_array
+            @param      select Function returning the statistic of a zone, given the collection of
+                        statistic per zone
+
+            Each locality is sent the statistics of only the zones occurring in its partitions,
+            which all partitions share.
+        */
+        template<
+            typename Functor,
+            typename Policies,
+            typename Zone,
+            Rank rank,
+            typename Aggregator,
+            typename Select>
+        auto zonal_assign(
+            Policies const& policies,
+            PartitionedArray<Zone, rank> const& zones_array,
+            ZonalAggregate<Zone, Aggregator> const& aggregate,
+            Select const& select) -> PartitionedArray<OutputElementT<Functor>, rank>
+        {
+            using ZonesPartition = PartitionT<PartitionedArray<Zone, rank>>;
+
+            using OutputArray = PartitionedArray<OutputElementT<Functor>, rank>;
+            using OutputPartitions = PartitionsT<OutputArray>;
+            using OutputPartition = PartitionT<OutputArray>;
+
+            using ZoneCounts = zonal_operation::ZoneCounts<Zone>;
+
+            // -------------------------------------------------------------------------
+            // 3. Per locality, translate input zone to output statistic, for all partitions
+            //     located there. Only the statistics of the zones occurring in the locality
+            //     are sent. The collection of output partitions is ready once the action has
+            //     returned. Each output partition becomes ready on its own.
+            OutputPartitions output_partitions{shape_in_partitions(zones_array)};
+
+            using Action = zonal_operation::
+                ZonalOperationLocalityAction2<Policies, ZonesPartition, OutputPartition, Functor>;
+
+            Action action;
+            std::size_t locality_idx{0};
+
+            for (auto const& [locality_id, idxs] : aggregate.partition_idxs)
+            {
+                hpx::shared_future<std::vector<OutputPartition>> locality_output_partitions{hpx::dataflow(
+                    hpx::launch::async,
+
+                    [locality_id,
+                     action,
+                     policies,
+                     select,
+                     locality_zones_partitions = select_partitions(zones_array, idxs)](
+                        hpx::shared_future<Aggregator> const& aggregator,
+                        hpx::shared_future<ZoneCounts> const& zone_counts)
+                        -> hpx::future<std::vector<OutputPartition>>
                     {
                         AnnotateFunction const annotation{
-                            std::format("{}: array: merge", functor_name<Functor>)};
+                            std::format("{}: locality: call reclass action", functor_name<Functor>)};
+
+                        return hpx::async(
+                            action,
+                            locality_id,
+                            policies,
+                            locality_zones_partitions,
+                            zonal_operation::statistics<Functor>(
+                                aggregator.get(), zone_counts.get(), select));
+                    },
 
-                        Aggregator result{};
+                    aggregate.aggregator,
+                    aggregate.zone_counts[locality_idx++])};
 
-                        for (hpx::future<Aggregator>& aggregator : aggregators.get())
-                        {
-                            result.merge(aggregator.get());
-                        }
+                for (std::size_t idx = 0; idx < idxs.size(); ++idx)
+                {
+                    output_partitions[idxs[idx]] = locality_output_partitions.then(
+                        [idx](hpx::shared_future<std::vector<OutputPartition>> const& partitions)
+                            -> OutputPartition { return partitions.get()[idx]; });
+                }
+            }
+
+            return {zones_array, std::move(output_partitions)};
+        }
 
-                        return result;
-                    });
 
-        // -------------------------------------------------------------------------
-        // 3. Per input partition, translate input zone to output statistic.
+        /*!
+            @brief      Calculate a statistic per zone and assign it to the cells of each zone
+            @tparam     T Type of the inputs to aggregate: an element type or a partition type
+            @param      inputs Function returning, for a collection of partition indices, the inputs
+                        to aggregate for these partitions
+        */
+        template<typename T, typename Policies, typename Zone, Rank rank, typename Functor, typename Inputs>
+        auto zonal_operation(
+            Policies const& policies,
+            Inputs const& inputs,
+            PartitionedArray<Zone, rank> const& zones_array,
+            Functor const& functor) -> PartitionedArray<OutputElementT<Functor>, rank>
+        {
+            using Aggregator = AggregatorT<Functor>;
+
+            return zonal_assign<Functor>(
+                policies,
+                zones_array,
+                zonal_aggregate<T>(policies, inputs, zones_array, functor),
+                [](Aggregator const& aggregator, Zone const zone) -> OutputElementT<Functor>
+                { return aggregator[zone]; });
+        }
 
-        OutputPartitions output_partitions{shape_in_partitions(input_array)};
 
+        /*!
+            @brief      Calculate a statistic per zone, given a zone index
+            @tparam     T Type of the inputs to aggregate: an element type or a partition type
+            @param      inputs Function returning, for a collection of partition indices, the inputs
+                        to aggregate for these partitions
+            @return     Future to collection of statistic per zone, for the whole array
+        */
+        template<typename T, typename Policies, typename Zone, Rank rank, typename Functor, typename Inputs>
+        auto zonal_aggregate(
+            Policies const& policies,
+            Inputs const& inputs,
+            ZoneIndex<Zone, rank> const& zone_index,
+            Functor const& functor) -> hpx::shared_future<AggregatorT<Functor>>
         {
-            detail::ZonalOperationPartitionAction2<Policies, ZonesPartition, OutputPartition, Functor> action;
+            using ZonesPartition = PartitionT<PartitionedArray<Zone, rank>>;
+            using Aggregator = AggregatorT<Functor>;
 
-            for (Index partition_idx = 0; partition_idx < nr_partitions; ++partition_idx)
+            // -------------------------------------------------------------------------
+            // 1. Per locality, calculate a statistic per zone, for all partitions located
+            //     there. The zones occurring in each locality are known already.
+            using Action =
+                zonal_operation::ZonalOperationLocalityIndexedAction<Policies, T, ZonesPartition, Functor>;
+
+            Action action;
+            std::size_t locality_idx{0};
+
+            std::vector<hpx::future<Aggregator>> aggregators{};
+            aggregators.reserve(zone_index.partition_idxs().size());
+
+            for (auto const& [locality_id, idxs] : zone_index.partition_idxs())
             {
-                output_partitions[partition_idx] = hpx::dataflow(
+                aggregators.push_back(hpx::dataflow(
                     hpx::launch::async,
 
-                    [locality_id = localities[partition_idx],
+                    [locality_id,
                      action,
                      policies,
-                     zones_partition = zones_partitions[partition_idx]](
-                        hpx::shared_future<Aggregator> const& aggregator) -> OutputPartition
+                     functor,
+                     locality_inputs = inputs(idxs),
+                     locality_labels_partitions = select_partitions(zone_index.labels(), idxs)](
+                        hpx::shared_future<std::vector<Zone>> const& zones) -> hpx::future<Aggregator>
                     {
-                        AnnotateFunction const annotation{
-                            std::format("{}: partition: call reclass action", functor_name<Functor>)};
+                        return hpx::async(
+                            action,
+                            locality_id,
+                            policies,
+                            locality_inputs,
+                            locality_labels_partitions,
+                            zones.get(),
+                            functor);
+                    },
+
+                    zone_index.locality_zones()[locality_idx++]));
+            }
+
+            // -------------------------------------------------------------------------
+            // 2. Merge the zonal statistics of all localities
+            return zonal_operation::merge_aggregators<Functor>(std::move(aggregators)).share();
+        }
+
+
+        /*!
+            @brief      Assign the statistic of each zone to the cells of the zone, given a zone
+                        index
+            @tparam     Functor Functor determining the output element type
+            @param      aggregator Result of zonal_aggregate(), for @a zone_index
+            @param      select Function returning the statistic of a zone, given the collection of
+                        statistic per zone
+
+            Each locality is sent the statistics of only the zones occurring in its partitions,
+            in the order of the labels. Cells are assigned their statistic by label, without looking
+            up their zone.
+        */
+        template<
+            typename Functor,
+            typename Policies,
+            typename Zone,
+            Rank rank,
+            typename Aggregator,
+            typename Select>
+        auto zonal_assign(
+            Policies const& policies,
+            ZoneIndex<Zone, rank> const& zone_index,
+            hpx::shared_future<Aggregator> const& aggregator,
+            Select const& select) -> PartitionedArray<OutputElementT<Functor>, rank>
+        {
+            using LabelsPartition = PartitionT<typename ZoneIndex<Zone, rank>::Labels>;
+
+            using OutputArray = PartitionedArray<OutputElementT<Functor>, rank>;
+            using OutputPartitions = PartitionsT<OutputArray>;
+            using OutputPartition = PartitionT<OutputArray>;
+
+            // -------------------------------------------------------------------------
+            // 3. Per locality, translate labels to output statistic, for all partitions
+            //     located there. Each output partition becomes ready on its own.
+            OutputPartitions output_partitions{shape_in_partitions(zone_index.labels())};
+
+            using Action = zonal_operation::
+                ZonalOperationLocalityIndexedAction2<LabelsPartition, OutputPartition, Functor>;
+
+            Action action;
+            std::size_t locality_idx{0};
+
+            for (auto const& [locality_id, idxs] : zone_index.partition_idxs())
+            {
+                hpx::shared_future<std::vector<OutputPartition>> locality_output_partitions{hpx::dataflow(
+                    hpx::launch::async,
 
-                        return hpx::async(action, locality_id, policies, zones_partition, aggregator.get());
+                    [locality_id,
+                     action,
+                     policies,
+                     select,
+                     locality_labels_partitions = select_partitions(zone_index.labels(), idxs)](
+                        hpx::shared_future<Aggregator> const& aggregator,
+                        hpx::shared_future<std::vector<Zone>> const& zones)
+                        -> hpx::future<std::vector<OutputPartition>>
+                    {
+                        AnnotateFunction const annotation{
+                            std::format("{}: locality: call reclass action", functor_name<Functor>)};
+
+                        return hpx::async(
+                            action,
+                            locality_id,
+                            locality_labels_partitions,
+                            zonal_operation::statistic_values<Functor>(
+                                policies, aggregator.get(), zones.get(), select));
                     },
 
-                    aggregator);
+                    aggregator,
+                    zone_index.locality_zones()[locality_idx++])};
+
+                for (std::size_t idx = 0; idx < idxs.size(); ++idx)
+                {
+                    output_partitions[idxs[idx]] = locality_output_partitions.then(
+                        [idx](hpx::shared_future<std::vector<OutputPartition>> const& partitions)
+                            -> OutputPartition { return partitions.get()[idx]; });
+                }
             }
+
+            return {zone_index.labels(), std::move(output_partitions)};
         }
 
-        return {zones_array, std::move(output_partitions)};
+
+        /*!
+            @brief      Calculate a statistic per zone and assign it to the cells of each zone,
+                        given a zone index
+            @tparam     T Type of the inputs to aggregate: an element type or a partition type
+            @param      inputs Function returning, for a collection of partition indices, the inputs
+                        to aggregate for these partitions
+        */
+        template<typename T, typename Policies, typename Zone, Rank rank, typename Functor, typename Inputs>
+        auto zonal_operation(
+            Policies const& policies,
+            Inputs const& inputs,
+            ZoneIndex<Zone, rank> const& zone_index,
+            Functor const& functor) -> PartitionedArray<OutputElementT<Functor>, rank>
+        {
+            using Aggregator = AggregatorT<Functor>;
+
+            return zonal_assign<Functor>(
+                policies,
+                zone_index,
+                zonal_aggregate<T>(policies, inputs, zone_index, functor),
+                [](Aggregator const& aggregator, Zone const zone) -> OutputElementT<Functor>
+                { return aggregator[zone]; });
+        }
+
+    }  // namespace detail
+
+
+    template<typename Policies, typename InputElement, typename Zone, Rank rank, typename Functor>
+    auto zonal_operation(
+        Policies const& policies,
+        hpx::shared_future<InputElement> const input_scalar,
+        PartitionedArray<Zone, rank> const& zones_array,
+        Functor const& functor) -> PartitionedArray<OutputElementT<Functor>, rank>
+    {
+        // All partitions use the same scalar input
+        return detail::zonal_operation<InputElement>(
+            policies,
+            [input_scalar]([[maybe_unused]] std::vector<Index> const& partition_idxs)
+                -> hpx::shared_future<InputElement> { return input_scalar; },
+            zones_array,
+            functor);
+    }
+
+
+    template<typename Policies, typename InputElement, typename Zone, Rank rank, typename Functor>
+    auto zonal_operation(
+        Policies const& policies,
+        InputElement const input_value,
+        PartitionedArray<Zone, rank> const& zones_array,
+        Functor const& functor) -> PartitionedArray<OutputElementT<Functor>, rank>
+    {
+        return zonal_operation(
+            policies, hpx::make_ready_future<InputElement>(input_value).share(), zones_array, functor);
+    }
+
+
+    template<typename Policies, typename InputElement, typename Zone, Rank rank, typename Functor>
+    auto zonal_operation(
+        Policies const& policies,
+        PartitionedArray<InputElement, rank> const& input_array,
+        PartitionedArray<Zone, rank> const& zones_array,
+        Functor const& functor) -> PartitionedArray<OutputElementT<Functor>, rank>
+    {
+        using InputPartition = PartitionT<PartitionedArray<InputElement, rank>>;
+
+        detail::verify_compatible(input_array, zones_array);
+
+        // Each partition uses the corresponding input partition
+        return detail::zonal_operation<InputPartition>(
+            policies,
+            [&input_array](std::vector<Index> const& partition_idxs) -> std::vector<InputPartition>
+            { return detail::select_partitions(input_array, partition_idxs); },
+            zones_array,
+            functor);
+    }
+
+
+    template<typename Policies, typename InputElement, typename Zone, Rank rank, typename Functor>
+    auto zonal_operation(
+        Policies const& policies,
+        hpx::shared_future<InputElement> const input_scalar,
+        ZoneIndex<Zone, rank> const& zone_index,
+        Functor const& functor) -> PartitionedArray<OutputElementT<Functor>, rank>
+    {
+        // All partitions use the same scalar input
+        return detail::zonal_operation<InputElement>(
+            policies,
+            [input_scalar]([[maybe_unused]] std::vector<Index> const& partition_idxs)
+                -> hpx::shared_future<InputElement> { return input_scalar; },
+            zone_index,
+            functor);
+    }
+
+
+    template<typename Policies, typename InputElement, typename Zone, Rank rank, typename Functor>
+    auto zonal_operation(
+        Policies const& policies,
+        InputElement const input_value,
+        ZoneIndex<Zone, rank> const& zone_index,
+        Functor const& functor) -> PartitionedArray<OutputElementT<Functor>, rank>
+    {
+        return zonal_operation(
+            policies, hpx::make_ready_future<InputElement>(input_value).share(), zone_index, functor);
+    }
+
+
+    template<typename Policies, typename InputElement, typename Zone, Rank rank, typename Functor>
+    auto zonal_operation(
+        Policies const& policies,
+        PartitionedArray<InputElement, rank> const& input_array,
+        ZoneIndex<Zone, rank> const& zone_index,
+        Functor const& functor) -> PartitionedArray<OutputElementT<Functor>, rank>
+    {
+        using InputPartition = PartitionT<PartitionedArray<InputElement, rank>>;
+
+        detail::verify_compatible(input_array, zone_index.labels());
+
+        // Each partition uses the corresponding input partition
+        return detail::zonal_operation<InputPartition>(
+            policies,
+            [&input_array](std::vector<Index> const& partition_idxs) -> std::vector<InputPartition>
+            { return detail::select_partitions(input_array, partition_idxs); },
+            zone_index,
+            functor);
     }
 
 }  // namespace lue
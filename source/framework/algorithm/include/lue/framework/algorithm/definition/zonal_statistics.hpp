@@ -0,0 +1,1038 @@
+#pragma once
+#include "lue/framework/algorithm/definition/zonal_operation.hpp"
+#include "lue/framework/algorithm/detail/box_sum.hpp"
+#include "lue/framework/algorithm/detail/zone_map.hpp"
+#include "lue/framework/algorithm/zonal_operation_export.hpp"
+#include "lue/framework/algorithm/zonal_statistics.hpp"
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+
+namespace lue {
+    namespace detail {
+
+        template<typename InputElement, typename Zone>
+        class ZonalStatistics
+        {
+
+            public:
+
+                static_assert(std::is_floating_point_v<InputElement>);
+
+                static_assert(std::is_integral_v<Zone>);
+
+                static constexpr char const* name{"zonal_statistics"};
+
+                using OutputElement = InputElement;
+
+
+                class Aggregator
+                {
+
+                    public:
+
+                        //! Type for accumulating the sum of the values of a zone
+                        using Sum = BoxSumT<InputElement>;
+
+                        //! All statistics of a zone, from which the requested ones are obtained
+                        struct Statistic
+                        {
+                                //! Number of cells in the zone
+                                Count area;
+
+                                //! Number of cells in the zone containing a valid value
+                                Count nr_values;
+
+                                Sum sum;
+
+                                //! Minimum valid value, only relevant if nr_values > 0
+                                InputElement minimum;
+
+                                //! Maximum valid value, only relevant if nr_values > 0
+                                InputElement maximum;
+
+
+                                template<typename Archive>
+                                void serialize(Archive& archive, unsigned int const /* version */)
+                                {
+                                    archive & area & nr_values & sum & minimum & maximum;
+                                }
+                        };
+
+                        using Map = ZoneMap<Zone, Statistic>;
+
+
+                        void reserve(Zone const min_zone, Zone const max_zone, std::size_t const nr_zones)
+                        {
+                            _statistic_by_zone.reserve(min_zone, max_zone, nr_zones);
+                        }
+
+
+                        void add(Zone const zone, InputElement const value)
+                        {
+                            _statistic_by_zone.add(zone, Statistic{1, 1, value, value, value}, combine);
+                        }
+
+
+                        /*!
+                            @brief      Add a cell of @a zone whose value is not valid
+
+                            The cell only counts for the area of the zone.
+                        */
+                        void skip(Zone const zone)
+                        {
+                            _statistic_by_zone.add(
+                                zone, Statistic{1, 0, Sum{0}, InputElement{}, InputElement{}}, combine);
+                        }
+
+
+                        void merge(Aggregator const& other)
+                        {
+                            _statistic_by_zone.merge(other._statistic_by_zone, combine);
+                        }
+
+
+                        /*!
+                            @brief      Add the statistics of @a other, whose zones are labels of a
+                                        zone index
+                            @param      zones Zone per label
+                        */
+                        template<typename LabelAggregator>
+                        void merge(LabelAggregator const& other, std::vector<Zone> const& zones)
+                        {
+                            other.for_each(
+                                [this, &zones](auto const label, auto const& statistic)
+                                {
+                                    _statistic_by_zone.add(
+                                        zones[label],
+                                        Statistic{
+                                            statistic.area,
+                                            statistic.nr_values,
+                                            statistic.sum,
+                                            statistic.minimum,
+                                            statistic.maximum},
+                                        combine);
+                                });
+                        }
+
+
+                        bool contains(Zone const zone) const
+                        {
+                            return _statistic_by_zone.contains(zone);
+                        }
+
+
+                        /*!
+                            @brief      Call @a function for each zone, passing in the zone and its
+                                        statistic
+                        */
+                        template<typename Function>
+                        void for_each(Function const& function) const
+                        {
+                            _statistic_by_zone.for_each(function);
+                        }
+
+
+                        /*!
+                            @brief      Return whether @a statistic can be calculated for @a zone
+
+                            The area can be calculated for all zones containing cells. The other
+                            statistics only for zones containing valid values.
+                        */
+                        bool is_valid(Zone const zone, ZonalStatistic const statistic) const
+                        {
+                            return _statistic_by_zone.contains(zone) &&
+                                   (statistic == ZonalStatistic::area ||
+                                    _statistic_by_zone[zone].nr_values > 0);
+                        }
+
+
+                        /*!
+                            @brief      Return the value of @a statistic for @a zone
+                            @warning    is_valid() must be true for @a zone and @a statistic
+                        */
+                        OutputElement value(Zone const zone, ZonalStatistic const statistic) const
+                        {
+                            lue_hpx_assert(is_valid(zone, statistic));
+
+                            auto const& [area, nr_values, sum, minimum, maximum] = _statistic_by_zone[zone];
+
+                            switch (statistic)
+                            {
+                                case ZonalStatistic::area:
+                                {
+                                    return static_cast<OutputElement>(area);
+                                }
+                                case ZonalStatistic::sum:
+                                {
+                                    return static_cast<OutputElement>(sum);
+                                }
+                                case ZonalStatistic::mean:
+                                {
+                                    return static_cast<OutputElement>(sum / static_cast<Sum>(nr_values));
+                                }
+                                case ZonalStatistic::minimum:
+                                {
+                                    return minimum;
+                                }
+                                case ZonalStatistic::maximum:
+                                {
+                                    return maximum;
+                                }
+                            }
+
+                            lue_hpx_assert(false);
+
+                            return static_cast<OutputElement>(sum);
+                        }
+
+
+                        /*!
+                            @brief      Return the zones for which a statistic is stored, in increasing
+                                        order
+                        */
+                        std::vector<Zone> zones() const
+                        {
+                            std::vector<Zone> result{};
+                            result.reserve(_statistic_by_zone.nr_zones());
+
+                            _statistic_by_zone.for_each(
+                                [&result](Zone const zone, [[maybe_unused]] Statistic const& statistic)
+                                { result.push_back(zone); });
+
+                            std::sort(result.begin(), result.end());
+
+                            return result;
+                        }
+
+
+                    private:
+
+                        static void combine(Statistic& this_statistic, Statistic const& other_statistic)
+                        {
+                            if (other_statistic.nr_values > 0)
+                            {
+                                if (this_statistic.nr_values == 0)
+                                {
+                                    this_statistic.minimum = other_statistic.minimum;
+                                    this_statistic.maximum = other_statistic.maximum;
+                                }
+                                else
+                                {
+                                    this_statistic.minimum =
+                                        std::min(this_statistic.minimum, other_statistic.minimum);
+                                    this_statistic.maximum =
+                                        std::max(this_statistic.maximum, other_statistic.maximum);
+                                }
+                            }
+
+                            this_statistic.area += other_statistic.area;
+                            this_statistic.nr_values += other_statistic.nr_values;
+                            this_statistic.sum += other_statistic.sum;
+                        }
+
+
+                        friend class hpx::serialization::access;
+
+
+                        template<typename Archive>
+                        void serialize(Archive& archive, unsigned int const /* version */)
+                        {
+                            archive & _statistic_by_zone;
+                        }
+
+
+                        Map _statistic_by_zone;
+                };
+
+
+                //! Type of the aggregator of the statistics per label of a zone index
+                using LabelAggregator = typename ZonalStatistics<InputElement, IndexElement>::Aggregator;
+        };
+
+
+        /*!
+            @brief      Return a table with per zone in @a aggregator the values of @a statistics
+
+            Values of statistics which could not be calculated for a zone are marked as no-data.
+        */
+        template<typename Zone, typename Element, typename Policies, typename Aggregator>
+        auto zonal_statistics_table(
+            Policies const& policies,
+            hpx::shared_future<Aggregator> const& aggregator,
+            std::vector<ZonalStatistic> const& statistics) -> hpx::future<ZonalStatisticsTable<Zone, Element>>
+        {
+            using Table = ZonalStatisticsTable<Zone, Element>;
+
+            return aggregator.then(
+                [policies, statistics](hpx::shared_future<Aggregator> const& aggregator_f) -> Table
+                {
+                    AnnotateFunction const annotation{"zonal_statistics: table"};
+
+                    auto const& ondp = std::get<0>(policies.outputs_policies()).output_no_data_policy();
+
+                    Aggregator const& aggregator{aggregator_f.get()};
+                    Table table{aggregator.zones(), {}};
+
+                    table.values.reserve(statistics.size());
+
+                    for (ZonalStatistic const statistic : statistics)
+                    {
+                        std::vector<Element> values{};
+                        values.reserve(table.zones.size());
+
+                        for (Zone const zone : table.zones)
+                        {
+                            if (aggregator.is_valid(zone, statistic))
+                            {
+                                values.push_back(aggregator.value(zone, statistic));
+                            }
+                            else
+                            {
+                                ondp.mark_no_data(values.emplace_back());
+                            }
+                        }
+
+                        table.values.push_back(std::move(values));
+                    }
+
+                    return table;
+                });
+        }
+
+
+        //! Per zone, the values of the requested statistics, in the order they were requested
+        template<typename Zone, typename Element>
+        using ZonalStatisticsValues = ZoneMap<Zone, std::vector<Element>>;
+
+
+        /*!
+            @brief      Return per zone in @a zone_counts the values of @a statistics
+
+            Zones for which no statistics could be calculated are skipped. Values of statistics
+            which could not be calculated for a zone are marked as no-data.
+        */
+        template<typename Element, typename Policies, typename Zone, typename Aggregator>
+        auto zonal_statistics_values(
+            Policies const& policies,
+            Aggregator const& aggregator,
+            zonal_operation::ZoneCounts<Zone> const& zone_counts,
+            std::vector<ZonalStatistic> const& statistics) -> ZonalStatisticsValues<Zone, Element>
+        {
+            AnnotateFunction const annotation{"zonal_statistics: select statistics"};
+
+            auto const& ondp = std::get<0>(policies.outputs_policies()).output_no_data_policy();
+
+            ZonalStatisticsValues<Zone, Element> result{};
+
+            zone_counts.for_each(
+                [&ondp, &aggregator, &statistics, &result](
+                    Zone const zone, [[maybe_unused]] Count const count)
+                {
+                    if (aggregator.contains(zone))
+                    {
+                        std::vector<Element>& values{result.insert(zone)};
+                        values.reserve(statistics.size());
+
+                        for (ZonalStatistic const statistic : statistics)
+                        {
+                            if (aggregator.is_valid(zone, statistic))
+                            {
+                                values.push_back(aggregator.value(zone, statistic));
+                            }
+                            else
+                            {
+                                ondp.mark_no_data(values.emplace_back());
+                            }
+                        }
+                    }
+                });
+
+            return result;
+        }
+
+
+        /*!
+            @brief      Return per zone in @a zones the values of @a statistics, followed by no-data
+                        values
+            @param      zones Zones occurring in the partitions located in a locality, in increasing
+                        order
+
+            The values of the zone with label `label` start at position `label * statistics.size()`.
+            The values of zones for which no statistics could be calculated, and of cells without a
+            zone, are marked as no-data.
+        */
+        template<typename Element, typename Policies, typename Zone, typename Aggregator>
+        auto zonal_statistics_values(
+            Policies const& policies,
+            Aggregator const& aggregator,
+            std::vector<Zone> const& zones,
+            std::vector<ZonalStatistic> const& statistics) -> std::vector<Element>
+        {
+            AnnotateFunction const annotation{"zonal_statistics: select statistics"};
+
+            auto const& ondp = std::get<0>(policies.outputs_policies()).output_no_data_policy();
+
+            std::size_t const nr_statistics{statistics.size()};
+            std::vector<Element> result((zones.size() + 1) * nr_statistics);
+
+            for (std::size_t idx = 0; idx < zones.size(); ++idx)
+            {
+                for (std::size_t s = 0; s < nr_statistics; ++s)
+                {
+                    if (aggregator.is_valid(zones[idx], statistics[s]))
+                    {
+                        result[idx * nr_statistics + s] = aggregator.value(zones[idx], statistics[s]);
+                    }
+                    else
+                    {
+                        ondp.mark_no_data(result[idx * nr_statistics + s]);
+                    }
+                }
+            }
+
+            // Values of cells without a zone
+            for (std::size_t s = 0; s < nr_statistics; ++s)
+            {
+                ondp.mark_no_data(result[zones.size() * nr_statistics + s]);
+            }
+
+            return result;
+        }
+
+
+        /*!
+            @brief      For a partition, assign the values of the statistics of each zone to the cells
+                        of the zone
+            @param      zones_partition Input zones
+            @param      values Per zone, the values of the statistics, for at least the zones occurring
+                        in @a zones_partition
+            @param      nr_statistics Number of statistics per zone
+            @return     Per statistic, a partition with per zone the value of the statistic
+
+            The zones are read once for all statistics.
+        */
+        template<typename Policies, typename ZonesPartition, typename OutputPartition, typename Values>
+        auto zonal_statistics_partition(
+            Policies const& policies,
+            ZonesPartition const& zones_partition,
+            std::shared_ptr<Values const> const& values,
+            Count const nr_statistics) -> hpx::future<std::vector<OutputPartition>>
+        {
+            using Zone = ElementT<ZonesPartition>;
+            using Offset = OffsetT<ZonesPartition>;
+            using ZonesData = DataT<ZonesPartition>;
+            using OutputElement = ElementT<OutputPartition>;
+            using OutputData = DataT<OutputPartition>;
+
+            return hpx::dataflow(
+                hpx::launch::async,
+
+                [policies, values_ptr = values, nr_statistics](
+                    ZonesPartition const& zones_partition) -> std::vector<OutputPartition>
+                {
+                    AnnotateFunction const annotation{"zonal_statistics: partition: reclass"};
+
+                    auto const& values{*values_ptr};
+
+                    ZonesData const zones_partition_data = zones_partition.data(hpx::launch::sync);
+                    Offset const offset = zones_partition.offset(hpx::launch::sync);
+
+                    auto const& ondp = std::get<0>(policies.outputs_policies()).output_no_data_policy();
+
+                    std::vector<OutputPartition> result{};
+                    result.reserve(nr_statistics);
+
+                    if (zones_partition_data.is_uniform())
+                    {
+                        // All cells are in the same zone, or are no-data
+                        Zone const zone{zones_partition_data.uniform_value()};
+
+                        for (Index s = 0; s < nr_statistics; ++s)
+                        {
+                            OutputElement output_value;
+
+                            if (!values.contains(zone))
+                            {
+                                ondp.mark_no_data(output_value);
+                            }
+                            else
+                            {
+                                output_value = values[zone][s];
+                            }
+
+                            result.emplace_back(
+                                hpx::find_here(),
+                                offset,
+                                OutputData{zones_partition_data.shape(), output_value, UniformTag{}});
+                        }
+
+                        return result;
+                    }
+
+                    std::vector<OutputData> outputs_partition_data{};
+                    outputs_partition_data.reserve(nr_statistics);
+
+                    for (Index s = 0; s < nr_statistics; ++s)
+                    {
+                        outputs_partition_data.emplace_back(zones_partition_data.shape());
+                    }
+
+                    Count const nr_elements{lue::nr_elements(zones_partition_data)};
+
+                    for (Index i = 0; i < nr_elements; ++i)
+                    {
+                        if (!values.contains(zones_partition_data[i]))
+                        {
+                            for (Index s = 0; s < nr_statistics; ++s)
+                            {
+                                ondp.mark_no_data(outputs_partition_data[s], i);
+                            }
+                        }
+                        else
+                        {
+                            std::vector<OutputElement> const& zone_values{values[zones_partition_data[i]]};
+
+                            for (Index s = 0; s < nr_statistics; ++s)
+                            {
+                                outputs_partition_data[s][i] = zone_values[s];
+                            }
+                        }
+                    }
+
+                    for (Index s = 0; s < nr_statistics; ++s)
+                    {
+                        result.emplace_back(hpx::find_here(), offset, std::move(outputs_partition_data[s]));
+                    }
+
+                    return result;
+                },
+
+                zones_partition);
+        }
+
+
+        /*!
+            @brief      For a partition, assign the values of the statistics of each zone to the cells
+                        of the zone, given the labels of a zone index
+            @param      labels_partition Per cell the position of its zone in the locality's zones
+            @param      values Values of the statistics per label, as returned by
+                        zonal_statistics_values()
+            @param      nr_statistics Number of statistics per zone
+            @return     Per statistic, a partition with per zone the value of the statistic
+        */
+        template<typename LabelsPartition, typename OutputPartition>
+        auto zonal_statistics_partition_indexed(
+            LabelsPartition const& labels_partition,
+            std::shared_ptr<std::vector<ElementT<OutputPartition>> const> const& values,
+            Count const nr_statistics) -> hpx::future<std::vector<OutputPartition>>
+        {
+            using Offset = OffsetT<LabelsPartition>;
+            using LabelsData = DataT<LabelsPartition>;
+            using OutputData = DataT<OutputPartition>;
+
+            return hpx::dataflow(
+                hpx::launch::async,
+
+                [values_ptr = values, nr_statistics](
+                    LabelsPartition const& labels_partition) -> std::vector<OutputPartition>
+                {
+                    AnnotateFunction const annotation{"zonal_statistics: partition: reclass"};
+
+                    auto const& values{*values_ptr};
+
+                    LabelsData const labels_partition_data = labels_partition.data(hpx::launch::sync);
+                    Offset const offset = labels_partition.offset(hpx::launch::sync);
+
+                    std::vector<OutputPartition> result{};
+                    result.reserve(nr_statistics);
+
+                    if (labels_partition_data.is_uniform())
+                    {
+                        // All cells are in the same zone, or are no-data
+                        Index const first{
+                            static_cast<Index>(labels_partition_data.uniform_value()) * nr_statistics};
+
+                        for (Index s = 0; s < nr_statistics; ++s)
+                        {
+                            result.emplace_back(
+                                hpx::find_here(),
+                                offset,
+                                OutputData{labels_partition_data.shape(), values[first + s], UniformTag{}});
+                        }
+
+                        return result;
+                    }
+
+                    std::vector<OutputData> outputs_partition_data{};
+                    outputs_partition_data.reserve(nr_statistics);
+
+                    for (Index s = 0; s < nr_statistics; ++s)
+                    {
+                        outputs_partition_data.emplace_back(labels_partition_data.shape());
+                    }
+
+                    Count const nr_elements{lue::nr_elements(labels_partition_data)};
+
+                    for (Index i = 0; i < nr_elements; ++i)
+                    {
+                        Index const first{static_cast<Index>(labels_partition_data[i]) * nr_statistics};
+
+                        for (Index s = 0; s < nr_statistics; ++s)
+                        {
+                            outputs_partition_data[s][i] = values[first + s];
+                        }
+                    }
+
+                    for (Index s = 0; s < nr_statistics; ++s)
+                    {
+                        result.emplace_back(hpx::find_here(), offset, std::move(outputs_partition_data[s]));
+                    }
+
+                    return result;
+                },
+
+                labels_partition);
+        }
+
+
+        /*!
+            @brief      Wait for the output partitions of all partitions located in a locality
+            @return     Future to, per partition, per statistic, the output partition
+        */
+        template<typename OutputPartition>
+        auto when_all_outputs(std::vector<hpx::future<std::vector<OutputPartition>>>&& outputs)
+            -> hpx::future<std::vector<std::vector<OutputPartition>>>
+        {
+            return hpx::when_all(std::move(outputs))
+                .then(
+                    [](hpx::future<std::vector<hpx::future<std::vector<OutputPartition>>>>&& outputs_f)
+                        -> std::vector<std::vector<OutputPartition>>
+                    {
+                        auto outputs{outputs_f.get()};
+
+                        std::vector<std::vector<OutputPartition>> result{};
+                        result.reserve(outputs.size());
+
+                        for (auto& output : outputs)
+                        {
+                            result.push_back(output.get());
+                        }
+
+                        return result;
+                    });
+        }
+
+
+        /*!
+            @brief      For all partitions located in this locality, assign the values of the
+                        statistics of each zone to the cells of the zone
+            @param      values Per zone, the values of the statistics, for the zones occurring in
+                        @a zones_partitions, shared by all partitions
+        */
+        template<typename Policies, typename ZonesPartition, typename OutputPartition>
+        auto zonal_statistics_locality(
+            Policies const& policies,
+            std::vector<ZonesPartition> const& zones_partitions,
+            ZonalStatisticsValues<ElementT<ZonesPartition>, ElementT<OutputPartition>> values,
+            Count const nr_statistics) -> hpx::future<std::vector<std::vector<OutputPartition>>>
+        {
+            using Values = ZonalStatisticsValues<ElementT<ZonesPartition>, ElementT<OutputPartition>>;
+
+            auto const values_ptr{std::make_shared<Values const>(std::move(values))};
+
+            std::vector<hpx::future<std::vector<OutputPartition>>> outputs{};
+            outputs.reserve(zones_partitions.size());
+
+            for (ZonesPartition const& zones_partition : zones_partitions)
+            {
+                outputs.push_back(zonal_statistics_partition<Policies, ZonesPartition, OutputPartition>(
+                    policies, zones_partition, values_ptr, nr_statistics));
+            }
+
+            return when_all_outputs(std::move(outputs));
+        }
+
+
+        template<typename Policies, typename ZonesPartition, typename OutputPartition>
+        struct ZonalStatisticsLocalityAction:
+            hpx::actions::make_action<
+                decltype(&zonal_statistics_locality<Policies, ZonesPartition, OutputPartition>),
+                &zonal_statistics_locality<Policies, ZonesPartition, OutputPartition>,
+                ZonalStatisticsLocalityAction<Policies, ZonesPartition, OutputPartition>>::type
+        {
+        };
+
+
+        /*!
+            @brief      For all partitions located in this locality, assign the values of the
+                        statistics of each zone to the cells of the zone, given the labels of a zone
+                        index
+            @param      values Values of the statistics per label, shared by all partitions
+        */
+        template<typename LabelsPartition, typename OutputPartition>
+        auto zonal_statistics_locality_indexed(
+            std::vector<LabelsPartition> const& labels_partitions,
+            std::vector<ElementT<OutputPartition>> values,
+            Count const nr_statistics) -> hpx::future<std::vector<std::vector<OutputPartition>>>
+        {
+            using Values = std::vector<ElementT<OutputPartition>>;
+
+            auto const values_ptr{std::make_shared<Values const>(std::move(values))};
+
+            std::vector<hpx::future<std::vector<OutputPartition>>> outputs{};
+            outputs.reserve(labels_partitions.size());
+
+            for (LabelsPartition const& labels_partition : labels_partitions)
+            {
+                outputs.push_back(zonal_statistics_partition_indexed<LabelsPartition, OutputPartition>(
+                    labels_partition, values_ptr, nr_statistics));
+            }
+
+            return when_all_outputs(std::move(outputs));
+        }
+
+
+        template<typename LabelsPartition, typename OutputPartition>
+        struct ZonalStatisticsLocalityIndexedAction:
+            hpx::actions::make_action<
+                decltype(&zonal_statistics_locality_indexed<LabelsPartition, OutputPartition>),
+                &zonal_statistics_locality_indexed<LabelsPartition, OutputPartition>,
+                ZonalStatisticsLocalityIndexedAction<LabelsPartition, OutputPartition>>::type
+        {
+        };
+
+
+        /*!
+            @brief      Assign the values of @a statistics of each zone to the cells of the zone
+            @param      aggregate Result of zonal_aggregate(), for @a zones_array
+            @return     Per statistic, an array with per cell the statistic of its zone
+
+            Each locality is sent the values of only the zones occurring in its partitions. Per
+            partition, a single task assigns the values of all statistics.
+        */
+        template<typename Element, typename Policies, typename Zone, Rank rank, typename Aggregator>
+        auto zonal_statistics_assign(
+            Policies const& policies,
+            PartitionedArray<Zone, rank> const& zones_array,
+            ZonalAggregate<Zone, Aggregator> const& aggregate,
+            std::vector<ZonalStatistic> const& statistics) -> std::vector<PartitionedArray<Element, rank>>
+        {
+            using ZonesPartition = PartitionT<PartitionedArray<Zone, rank>>;
+            using ZoneCounts = zonal_operation::ZoneCounts<Zone>;
+
+            using OutputArray = PartitionedArray<Element, rank>;
+            using OutputPartitions = PartitionsT<OutputArray>;
+            using OutputPartition = PartitionT<OutputArray>;
+
+            using Action = ZonalStatisticsLocalityAction<Policies, ZonesPartition, OutputPartition>;
+
+            Count const nr_statistics{static_cast<Count>(statistics.size())};
+            std::vector<OutputPartitions> output_partitions(
+                statistics.size(), OutputPartitions{shape_in_partitions(zones_array)});
+
+            Action action;
+            std::size_t locality_idx{0};
+
+            for (auto const& [locality_id, idxs] : aggregate.partition_idxs)
+            {
+                hpx::shared_future<std::vector<std::vector<OutputPartition>>> locality_output_partitions{
+                    hpx::dataflow(
+                        hpx::launch::async,
+
+                        [locality_id,
+                         action,
+                         policies,
+                         statistics,
+                         nr_statistics,
+                         locality_zones_partitions = select_partitions(zones_array, idxs)](
+                            hpx::shared_future<Aggregator> const& aggregator,
+                            hpx::shared_future<ZoneCounts> const& zone_counts)
+                            -> hpx::future<std::vector<std::vector<OutputPartition>>>
+                        {
+                            AnnotateFunction const annotation{
+                                "zonal_statistics: locality: call reclass action"};
+
+                            return hpx::async(
+                                action,
+                                locality_id,
+                                policies,
+                                locality_zones_partitions,
+                                zonal_statistics_values<Element>(
+                                    policies, aggregator.get(), zone_counts.get(), statistics),
+                                nr_statistics);
+                        },
+
+                        aggregate.aggregator,
+                        aggregate.zone_counts[locality_idx++])};
+
+                for (std::size_t idx = 0; idx < idxs.size(); ++idx)
+                {
+                    for (Index s = 0; s < nr_statistics; ++s)
+                    {
+                        output_partitions[s][idxs[idx]] = locality_output_partitions.then(
+                            [idx, s](hpx::shared_future<std::vector<std::vector<OutputPartition>>> const&
+                                         partitions) -> OutputPartition { return partitions.get()[idx][s]; });
+                    }
+                }
+            }
+
+            std::vector<OutputArray> result{};
+            result.reserve(statistics.size());
+
+            for (Index s = 0; s < nr_statistics; ++s)
+            {
+                result.push_back(OutputArray{zones_array, std::move(output_partitions[s])});
+            }
+
+            return result;
+        }
+
+
+        /*!
+            @brief      Assign the values of @a statistics of each zone to the cells of the zone,
+                        given a zone index
+            @param      aggregator Result of zonal_aggregate(), for @a zone_index
+            @return     Per statistic, an array with per cell the statistic of its zone
+
+            Each locality is sent the values of only the zones occurring in its partitions, in the
+            order of the labels. Per partition, a single task assigns the values of all statistics.
+        */
+        template<typename Element, typename Policies, typename Zone, Rank rank, typename Aggregator>
+        auto zonal_statistics_assign(
+            Policies const& policies,
+            ZoneIndex<Zone, rank> const& zone_index,
+            hpx::shared_future<Aggregator> const& aggregator,
+            std::vector<ZonalStatistic> const& statistics) -> std::vector<PartitionedArray<Element, rank>>
+        {
+            using LabelsPartition = PartitionT<typename ZoneIndex<Zone, rank>::Labels>;
+
+            using OutputArray = PartitionedArray<Element, rank>;
+            using OutputPartitions = PartitionsT<OutputArray>;
+            using OutputPartition = PartitionT<OutputArray>;
+
+            using Action = ZonalStatisticsLocalityIndexedAction<LabelsPartition, OutputPartition>;
+
+            Count const nr_statistics{static_cast<Count>(statistics.size())};
+            std::vector<OutputPartitions> output_partitions(
+                statistics.size(), OutputPartitions{shape_in_partitions(zone_index.labels())});
+
+            Action action;
+            std::size_t locality_idx{0};
+
+            for (auto const& [locality_id, idxs] : zone_index.partition_idxs())
+            {
+                hpx::shared_future<std::vector<std::vector<OutputPartition>>> locality_output_partitions{
+                    hpx::dataflow(
+                        hpx::launch::async,
+
+                        [locality_id,
+                         action,
+                         policies,
+                         statistics,
+                         nr_statistics,
+                         locality_labels_partitions = select_partitions(zone_index.labels(), idxs)](
+                            hpx::shared_future<Aggregator> const& aggregator,
+                            hpx::shared_future<std::vector<Zone>> const& zones)
+                            -> hpx::future<std::vector<std::vector<OutputPartition>>>
+                        {
+                            AnnotateFunction const annotation{
+                                "zonal_statistics: locality: call reclass action"};
+
+                            return hpx::async(
+                                action,
+                                locality_id,
+                                locality_labels_partitions,
+                                zonal_statistics_values<Element>(
+                                    policies, aggregator.get(), zones.get(), statistics),
+                                nr_statistics);
+                        },
+
+                        aggregator,
+                        zone_index.locality_zones()[locality_idx++])};
+
+                for (std::size_t idx = 0; idx < idxs.size(); ++idx)
+                {
+                    for (Index s = 0; s < nr_statistics; ++s)
+                    {
+                        output_partitions[s][idxs[idx]] = locality_output_partitions.then(
+                            [idx, s](hpx::shared_future<std::vector<std::vector<OutputPartition>>> const&
+                                         partitions) -> OutputPartition { return partitions.get()[idx][s]; });
+                    }
+                }
+            }
+
+            std::vector<OutputArray> result{};
+            result.reserve(statistics.size());
+
+            for (Index s = 0; s < nr_statistics; ++s)
+            {
+                result.push_back(OutputArray{zone_index.labels(), std::move(output_partitions[s])});
+            }
+
+            return result;
+        }
+
+    }  // namespace detail
+
+
+    /*!
+        @brief      Calculate multiple statistics per zone, in a single pass over the input
+        @param      array Values to calculate statistics of
+        @param      zones Zone per cell
+        @param      statistics Statistics to calculate
+        @return     Per requested statistic, in the same order, an array with per cell the statistic
+                    of its zone
+
+        Calling this function is cheaper than calling the zonal operations calculating the individual
+        statistics one after the other. The input values are aggregated and reduced only once, for
+        all statistics.
+    */
+    template<typename Policies, typename Element, typename Zone, Rank rank>
+    auto zonal_statistics(
+        Policies const& policies,
+        PartitionedArray<Element, rank> const& array,
+        PartitionedArray<Zone, rank> const& zones,
+        std::vector<ZonalStatistic> const& statistics) -> std::vector<PartitionedArray<Element, rank>>
+    {
+        using Functor = detail::ZonalStatistics<Element, Zone>;
+        using InputPartition = PartitionT<PartitionedArray<Element, rank>>;
+
+        detail::verify_compatible(array, zones);
+
+        if (statistics.empty())
+        {
+            return {};
+        }
+
+        auto const aggregate{detail::zonal_aggregate<InputPartition>(
+            policies,
+            [&array](std::vector<Index> const& partition_idxs) -> std::vector<InputPartition>
+            { return detail::select_partitions(array, partition_idxs); },
+            zones,
+            Functor{})};
+
+        return detail::zonal_statistics_assign<Element>(policies, zones, aggregate, statistics);
+    }
+
+
+    /*!
+        @brief      Calculate multiple statistics per zone, in a single pass over the input
+        @param      array Values to calculate statistics of
+        @param      zones Zone per cell
+        @param      statistics Statistics to calculate
+        @return     Table with per zone the values of the requested statistics
+    */
+    template<typename Policies, typename Element, typename Zone, Rank rank>
+    auto zonal_statistics_table(
+        Policies const& policies,
+        PartitionedArray<Element, rank> const& array,
+        PartitionedArray<Zone, rank> const& zones,
+        std::vector<ZonalStatistic> const& statistics) -> hpx::future<ZonalStatisticsTable<Zone, Element>>
+    {
+        using Functor = detail::ZonalStatistics<Element, Zone>;
+        using InputPartition = PartitionT<PartitionedArray<Element, rank>>;
+
+        detail::verify_compatible(array, zones);
+
+        auto const aggregate{detail::zonal_aggregate<InputPartition>(
+            policies,
+            [&array](std::vector<Index> const& partition_idxs) -> std::vector<InputPartition>
+            { return detail::select_partitions(array, partition_idxs); },
+            zones,
+            Functor{})};
+
+        return detail::zonal_statistics_table<Zone, Element>(policies, aggregate.aggregator, statistics);
+    }
+
+
+    /*!
+        @overload
+    */
+    template<typename Policies, typename Element, typename Zone, Rank rank>
+    auto zonal_statistics(
+        Policies const& policies,
+        PartitionedArray<Element, rank> const& array,
+        ZoneIndex<Zone, rank> const& zone_index,
+        std::vector<ZonalStatistic> const& statistics) -> std::vector<PartitionedArray<Element, rank>>
+    {
+        using Functor = detail::ZonalStatistics<Element, Zone>;
+        using InputPartition = PartitionT<PartitionedArray<Element, rank>>;
+
+        detail::verify_compatible(array, zone_index.labels());
+
+        if (statistics.empty())
+        {
+            return {};
+        }
+
+        auto const aggregate{detail::zonal_aggregate<InputPartition>(
+            policies,
+            [&array](std::vector<Index> const& partition_idxs) -> std::vector<InputPartition>
+            { return detail::select_partitions(array, partition_idxs); },
+            zone_index,
+            Functor{})};
+
+        return detail::zonal_statistics_assign<Element>(policies, zone_index, aggregate, statistics);
+    }
+
+
+    /*!
+        @overload
+    */
+    template<typename Policies, typename Element, typename Zone, Rank rank>
+    auto zonal_statistics_table(
+        Policies const& policies,
+        PartitionedArray<Element, rank> const& array,
+        ZoneIndex<Zone, rank> const& zone_index,
+        std::vector<ZonalStatistic> const& statistics) -> hpx::future<ZonalStatisticsTable<Zone, Element>>
+    {
+        using Functor = detail::ZonalStatistics<Element, Zone>;
+        using InputPartition = PartitionT<PartitionedArray<Element, rank>>;
+
+        detail::verify_compatible(array, zone_index.labels());
+
+        return detail::zonal_statistics_table<Zone, Element>(
+            policies,
+            detail::zonal_aggregate<InputPartition>(
+                policies,
+                [&array](std::vector<Index> const& partition_idxs) -> std::vector<InputPartition>
+                { return detail::select_partitions(array, partition_idxs); },
+                zone_index,
+                Functor{}),
+            statistics);
+    }
+
+}  // namespace lue
+
+
+#define LUE_INSTANTIATE_ZONAL_STATISTICS(Policies, Element, Zone)                                            \
+                                                                                                             \
+    template LUE_ZONAL_OPERATION_EXPORT std::vector<PartitionedArray<Element, 2>>                            \
+    zonal_statistics<ArgumentType<void(Policies)>, Element, Zone, 2>(                                        \
+        ArgumentType<void(Policies)> const&,                                                                 \
+        PartitionedArray<Element, 2> const&,                                                                 \
+        PartitionedArray<Zone, 2> const&,                                                                    \
+        std::vector<ZonalStatistic> const&);                                                                 \
+                                                                                                             \
+    template LUE_ZONAL_OPERATION_EXPORT hpx::future<ZonalStatisticsTable<Zone, Element>>                     \
+    zonal_statistics_table<ArgumentType<void(Policies)>, Element, Zone, 2>(                                  \
+        ArgumentType<void(Policies)> const&,                                                                 \
+        PartitionedArray<Element, 2> const&,                                                                 \
+        PartitionedArray<Zone, 2> const&,                                                                    \
+        std::vector<ZonalStatistic> const&);                                                                 \
+                                                                                                             \
+    template LUE_ZONAL_OPERATION_EXPORT std::vector<PartitionedArray<Element, 2>>                            \
+    zonal_statistics<ArgumentType<void(Policies)>, Element, Zone, 2>(                                        \
+        ArgumentType<void(Policies)> const&,                                                                 \
+        PartitionedArray<Element, 2> const&,                                                                 \
+        ZoneIndex<Zone, 2> const&,                                                                           \
+        std::vector<ZonalStatistic> const&);                                                                 \
+                                                                                                             \
+    template LUE_ZONAL_OPERATION_EXPORT hpx::future<ZonalStatisticsTable<Zone, Element>>                     \
+    zonal_statistics_table<ArgumentType<void(Policies)>, Element, Zone, 2>(                                  \
+        ArgumentType<void(Policies)> const&,                                                                 \
+        PartitionedArray<Element, 2> const&,                                                                 \
+        ZoneIndex<Zone, 2> const&,                                                                           \
+        std::vector<ZonalStatistic> const&);
@@ -0,0 +1,230 @@
+#pragma once
+#include "lue/framework/algorithm/definition/zonal_operation.hpp"
+#include "lue/framework/algorithm/detail/zone_map.hpp"
+#include "lue/framework/algorithm/zonal_operation_export.hpp"
+#include "lue/framework/algorithm/zone_index.hpp"
+#include "lue/framework/core/annotate.hpp"
+#include "lue/macro.hpp"
+#include <tuple>
+#include <vector>
+
+
+namespace lue {
+    namespace detail::zone_index {
+
+        class BuildZoneIndex
+        {
+
+            public:
+
+                static constexpr char const* name{"zone_index"};
+        };
+
+
+        template<typename ZonesPartition>
+        using LabelsPartition = zonal_operation::LabelsPartition<ZonesPartition>;
+
+
+        /*!
+            @brief      For this partition, label each cell with the position of its zone in @a zones
+            @param      zones_partition Input zones
+            @param      zones Zones occurring in the locality, in increasing order
+            @return     Partition with per cell its label
+
+            Cells containing no-data are labelled with the number of zones.
+        */
+        template<typename Policies, typename ZonesPartition>
+        auto labels_partition(
+            Policies const& policies,
+            ZonesPartition const& zones_partition,
+            hpx::shared_future<std::vector<ElementT<ZonesPartition>>> const& zones)
+            -> LabelsPartition<ZonesPartition>
+        {
+            using Zone = ElementT<ZonesPartition>;
+            using ZonesData = DataT<ZonesPartition>;
+            using Offset = OffsetT<ZonesPartition>;
+            using LabelsData = DataT<LabelsPartition<ZonesPartition>>;
+
+            return hpx::dataflow(
+                hpx::launch::async,
+
+                [policies](
+                    ZonesPartition const& zones_partition,
+                    hpx::shared_future<std::vector<Zone>> const& zones_f) -> LabelsPartition<ZonesPartition>
+                {
+                    AnnotateFunction const annotation{"zone_index: partition: label"};
+
+                    ZonesData const zones_partition_data = zones_partition.data(hpx::launch::sync);
+                    Offset const offset = zones_partition.offset(hpx::launch::sync);
+                    std::vector<Zone> const& zones{zones_f.get()};
+
+                    auto const& indp = std::get<0>(policies.inputs_policies()).input_no_data_policy();
+
+                    auto const no_zone{static_cast<IndexElement>(zones.size())};
+
+                    ZoneMap<Zone, IndexElement> label_by_zone{};
+
+                    if (!zones.empty())
+                    {
+                        label_by_zone.reserve(zones.front(), zones.back(), zones.size());
+                    }
+
+                    for (std::size_t idx = 0; idx < zones.size(); ++idx)
+                    {
+                        label_by_zone.insert(zones[idx]) = static_cast<IndexElement>(idx);
+                    }
+
+                    if (zones_partition_data.is_uniform())
+                    {
+                        // All cells are in the same zone, or are no-data
+                        Zone const zone{zones_partition_data.uniform_value()};
+
+                        return {
+                            hpx::find_here(),
+                            offset,
+                            LabelsData{
+                                zones_partition_data.shape(),
+                                indp.is_no_data(zone) ? no_zone : label_by_zone[zone],
+                                UniformTag{}}};
+                    }
+
+                    LabelsData labels_partition_data{zones_partition_data.shape()};
+
+                    Count const nr_elements{lue::nr_elements(zones_partition_data)};
+
+                    for (Index i = 0; i < nr_elements; ++i)
+                    {
+                        labels_partition_data[i] = indp.is_no_data(zones_partition_data, i)
+                                                       ? no_zone
+                                                       : label_by_zone[zones_partition_data[i]];
+                    }
+
+                    return {hpx::find_here(), offset, std::move(labels_partition_data)};
+                },
+
+                zones_partition,
+                zones);
+        }
+
+
+        /*!
+            @brief      For all partitions located in this locality, determine the zones occurring
+                        in them and label each cell with the position of its zone in these zones
+            @param      zones_partitions Input zones
+            @return     Future to the partitions with per cell its label, and to the zones
+                        occurring in the locality, in increasing order
+        */
+        template<typename Policies, typename ZonesPartition>
+        auto zone_index_locality(
+            Policies const& policies, std::vector<ZonesPartition> const& zones_partitions)
+            -> hpx::future<std::tuple<
+                std::vector<LabelsPartition<ZonesPartition>>,
+                std::vector<ElementT<ZonesPartition>>>>
+        {
+            using Zone = ElementT<ZonesPartition>;
+            using ZoneCounts = zonal_operation::ZoneCounts<Zone>;
+
+            auto const& indp = std::get<0>(policies.inputs_policies()).input_no_data_policy();
+
+            std::vector<hpx::future<ZoneCounts>> zone_counts{};
+            zone_counts.reserve(zones_partitions.size());
+
+            for (ZonesPartition const& zones_partition : zones_partitions)
+            {
+                zone_counts.push_back(
+                    zonal_operation::zone_counts_partition<BuildZoneIndex>(indp, zones_partition));
+            }
+
+            hpx::shared_future<std::vector<Zone>> zones =
+                zonal_operation::merge_zone_counts<BuildZoneIndex>(std::move(zone_counts))
+                    .then([](hpx::future<ZoneCounts>&& zone_counts) -> std::vector<Zone>
+                          { return zonal_operation::sorted_zones(zone_counts.get()); });
+
+            std::vector<LabelsPartition<ZonesPartition>> labels_partitions{};
+            labels_partitions.reserve(zones_partitions.size());
+
+            for (ZonesPartition const& zones_partition : zones_partitions)
+            {
+                labels_partitions.push_back(labels_partition(policies, zones_partition, zones));
+            }
+
+            return hpx::dataflow(
+                hpx::launch::async,
+                hpx::unwrapping(
+                    [](std::vector<LabelsPartition<ZonesPartition>>&& labels_partitions,
+                       std::vector<Zone> const& zones)
+                    { return std::make_tuple(std::move(labels_partitions), zones); }),
+                hpx::when_all(std::move(labels_partitions)),
+                zones);
+        }
+
+
+        template<typename Policies, typename ZonesPartition>
+        struct ZoneIndexLocalityAction:
+            hpx::actions::make_action<
+                decltype(&zone_index_locality<Policies, ZonesPartition>),
+                &zone_index_locality<Policies, ZonesPartition>,
+                ZoneIndexLocalityAction<Policies, ZonesPartition>>::type
+        {
+        };
+
+    }  // namespace detail::zone_index
+
+
+    /*!
+        @brief      Create an index of the zones in @a zones, for reuse by zonal operations
+        @param      zones Zone per cell
+        @return     Zone index
+
+        Creating an index costs about as much as a single zonal operation. Each zonal operation
+        passed the index instead of the zones array is cheaper.
+    */
+    template<typename Policies, typename Zone, Rank rank>
+    auto zone_index(Policies const& policies, PartitionedArray<Zone, rank> const& zones)
+        -> ZoneIndex<Zone, rank>
+    {
+        using ZonesPartition = PartitionT<PartitionedArray<Zone, rank>>;
+        using Labels = typename ZoneIndex<Zone, rank>::Labels;
+        using LabelsPartitions = PartitionsT<Labels>;
+        using LabelsPartition = PartitionT<Labels>;
+
+        auto partition_idxs{detail::partition_idxs_by_locality(zones.localities())};
+
+        LabelsPartitions labels_partitions{shape_in_partitions(zones)};
+        std::vector<hpx::shared_future<std::vector<Zone>>> locality_zones{};
+        locality_zones.reserve(partition_idxs.size());
+
+        detail::zone_index::ZoneIndexLocalityAction<Policies, ZonesPartition> action;
+
+        for (auto const& [locality_id, idxs] : partition_idxs)
+        {
+            auto [locality_labels_partitions_f, locality_zones_f] = hpx::split_future(
+                hpx::async(action, locality_id, policies, detail::select_partitions(zones, idxs)));
+
+            hpx::shared_future<std::vector<LabelsPartition>> locality_labels_partitions{
+                locality_labels_partitions_f.share()};
+
+            for (std::size_t idx = 0; idx < idxs.size(); ++idx)
+            {
+                labels_partitions[idxs[idx]] = locality_labels_partitions.then(
+                    [idx](hpx::shared_future<std::vector<LabelsPartition>> const& partitions)
+                        -> LabelsPartition { return partitions.get()[idx]; });
+            }
+
+            locality_zones.push_back(locality_zones_f.share());
+        }
+
+        return {
+            Labels{zones, std::move(labels_partitions)},
+            std::move(partition_idxs),
+            std::move(locality_zones)};
+    }
+
+}  // namespace lue
+
+
+#define LUE_INSTANTIATE_ZONE_INDEX(Policies, Zone)                                                           \
+                                                                                                             \
+    template LUE_ZONAL_OPERATION_EXPORT ZoneIndex<Zone, 2>                                                   \
+    zone_index<ArgumentType<void(Policies)>, Zone, 2>(                                                       \
+        ArgumentType<void(Policies)> const&, PartitionedArray<Zone, 2> const&);
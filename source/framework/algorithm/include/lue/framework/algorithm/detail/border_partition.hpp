@@ -0,0 +1,199 @@
+#pragma once
+#include "lue/framework/core/component.hpp"
+#include "lue/framework/partitioned_array_decl.hpp"
+#include <algorithm>
+#include <memory>
+
+
+namespace lue::detail {
+
+    /*!
+        @brief      Asynchronously create a new partition in the current locality, containing the
+                    border of @a partition facing a neighbouring partition
+        @param      radius Width of the border
+        @param      position0 Position of @a partition relative to its neighbour, along the first
+                    dimension: 0 if it is located north of it, 1 if it is located at the same rows, 2 if
+                    it is located south of it
+        @param      position1 Idem, along the second dimension: west, same columns, east
+
+        If @a partition is smaller than @a radius, the whole partition is copied. Focal operations
+        detect and report this.
+    */
+    template<typename Element>
+    auto border_partition(
+        ArrayPartition<Element, 2> const& partition,
+        Radius const radius,
+        Index const position0,
+        Index const position1) -> ArrayPartition<Element, 2>
+    {
+        using Partition = ArrayPartition<Element, 2>;
+        using Offset = OffsetT<Partition>;
+        using Shape = ShapeT<Partition>;
+        using Slice = SliceT<Partition>;
+        using Slices = SlicesT<Partition>;
+
+        lue_hpx_assert(position0 >= 0 && position0 <= 2);
+        lue_hpx_assert(position1 >= 0 && position1 <= 2);
+        lue_hpx_assert(!(position0 == 1 && position1 == 1));
+
+        return hpx::dataflow(
+            hpx::launch::async,
+
+            [radius, position0, position1](Partition const& partition) -> Partition
+            {
+                Shape const shape{partition.shape(hpx::launch::sync)};
+                Offset offset{partition.offset(hpx::launch::sync)};
+                Slices slices{};
+
+                for (std::size_t dimension = 0; dimension < 2; ++dimension)
+                {
+                    Count const extent{shape[dimension]};
+                    Count const width{std::min(radius, extent)};
+                    Index const position{dimension == 0 ? position0 : position1};
+
+                    slices[dimension] = position == 0   ? Slice{extent - width, extent}
+                                        : position == 1 ? Slice{0, extent}
+                                                        : Slice{0, width};
+                    offset[dimension] += std::get<0>(slices[dimension]);
+                }
+
+                return Partition{hpx::find_here(), offset, partition.slice(hpx::launch::sync, slices)};
+            },
+
+            partition);
+    }
+
+
+    template<typename Element>
+    struct BorderPartitionAction:
+        hpx::actions::make_action<
+            decltype(&border_partition<Element>),
+            &border_partition<Element>,
+            BorderPartitionAction<Element>>::type
+    {
+    };
+
+
+    /*!
+        @brief      Asynchronously return a partition in locality @a locality_id, containing the border
+                    of @a neighbour
+        @param      store_ptr Store to look for a previously copied border in, and to store a newly
+                    copied border in
+        @param      slot Slot in the store corresponding with the partition and the position of
+                    @a neighbour
+
+        A stored border is reused if it was copied from @a neighbour, while it had the same version as
+        it has now. Otherwise the border is copied, using border_partition().
+    */
+    template<typename Element>
+    auto halo_border(
+        std::shared_ptr<HaloStore<Element, 2>> const& store_ptr,
+        Index const slot,
+        hpx::id_type const locality_id,
+        ArrayPartition<Element, 2> const& neighbour,
+        Radius const radius,
+        Index const position0,
+        Index const position1) -> ArrayPartition<Element, 2>
+    {
+        using Store = HaloStore<Element, 2>;
+        using Partition = typename Store::Partition;
+        using Version = typename Store::Version;
+        using Border = typename Store::Border;
+
+        return hpx::dataflow(
+            hpx::launch::async,
+
+            [store_ptr, slot, locality_id, radius, position0, position1](
+                Partition const& neighbour) -> Partition
+            {
+                hpx::id_type const neighbour_id{neighbour.get_id()};
+                Version const version{neighbour.version(hpx::launch::sync)};
+
+                if (auto border = store_ptr->border(slot, neighbour_id, version, radius); border)
+                {
+                    return *border;
+                }
+
+                // The version is obtained before copying the border. If the neighbour changes in
+                // between, the border is stored for an outdated version, and will be copied again
+                // the next time it is asked for.
+                Partition border{BorderPartitionAction<Element>{}(
+                    locality_id, neighbour, radius, position0, position1)};
+
+                store_ptr->store(slot, Border{neighbour_id, version, radius, border});
+
+                return border;
+            },
+
+            neighbour);
+    }
+
+
+    /*!
+        @brief      Return the halos of the partitions in @a array, for a kernel of @a radius
+
+        For each partition, the borders of its neighbours are copied to partitions located in the
+        partition's locality. Borders stored in the array's halo store are reused as long as the
+        neighbours they were copied from did not change. Otherwise, new borders are copied and
+        stored. This way, each border is transferred once, instead of once per focal operation.
+    */
+    template<typename Element>
+    auto halos(PartitionedArray<Element, 2> const& array, Radius const radius) ->
+        typename HaloStore<Element, 2>::Halos
+    {
+        using Store = HaloStore<Element, 2>;
+        using Halo = typename Store::Halo;
+        using Halos = typename Store::Halos;
+        using Shape = ShapeT<Halo>;
+
+        std::shared_ptr<Store> const& store_ptr{array.halo_store()};
+
+        auto const& partitions{array.partitions()};
+        auto const& localities{array.localities()};
+        auto const [nr_partitions0, nr_partitions1] = partitions.shape();
+
+        // One slot per partition and position of a neighbour
+        store_ptr->resize(nr_partitions0 * nr_partitions1 * 9);
+
+        Halos halos{partitions.shape()};
+
+        for (Index idx0 = 0; idx0 < nr_partitions0; ++idx0)
+        {
+            for (Index idx1 = 0; idx1 < nr_partitions1; ++idx1)
+            {
+                Halo halo{Shape{{3, 3}}};
+
+                for (Index position0 = 0; position0 < 3; ++position0)
+                {
+                    for (Index position1 = 0; position1 < 3; ++position1)
+                    {
+                        Index const neighbour_idx0{idx0 + position0 - 1};
+                        Index const neighbour_idx1{idx1 + position1 - 1};
+
+                        if ((position0 != 1 || position1 != 1) && neighbour_idx0 >= 0 &&
+                            neighbour_idx0 < nr_partitions0 && neighbour_idx1 >= 0 &&
+                            neighbour_idx1 < nr_partitions1)
+                        {
+                            Index const slot{
+                                (((idx0 * nr_partitions1) + idx1) * 9) + (position0 * 3) + position1};
+
+                            halo(position0, position1) = halo_border(
+                                store_ptr,
+                                slot,
+                                localities(idx0, idx1),
+                                partitions(neighbour_idx0, neighbour_idx1),
+                                radius,
+                                position0,
+                                position1);
+                        }
+                    }
+                }
+
+                halos(idx0, idx1) = std::move(halo);
+            }
+        }
+
+        return halos;
+    }
+
+}  // namespace lue::detail
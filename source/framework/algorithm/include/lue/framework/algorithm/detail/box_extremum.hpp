@@ -0,0 +1,167 @@
+#pragma once
+#include "lue/framework/core/array.hpp"
+#include "lue/framework/core/assert.hpp"
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
+
+namespace lue::detail {
+    namespace extremum {
+
+        /*!
+            @brief      Element value which may be absent, because all values it represents are no-data
+        */
+        template<typename Element>
+        class Value
+        {
+
+            public:
+
+                Element value{};
+
+                bool valid{false};
+        };
+
+
+        /*!
+            @brief      Return the extremum of @a value1 and @a value2, ignoring absent values
+            @param      compare Comparison used to select the extremum, like std::max does
+        */
+        template<typename Element, typename Compare>
+        auto combine(Value<Element> const& value1, Value<Element> const& value2, Compare const& compare)
+            -> Value<Element>
+        {
+            if (!value1.valid)
+            {
+                return value2;
+            }
+
+            if (!value2.valid)
+            {
+                return value1;
+            }
+
+            return {std::max(value1.value, value2.value, compare), true};
+        }
+
+    }  // namespace extremum
+
+
+    /*!
+        @brief      Calculate per cell the extremum of the valid values within the square neighbourhood
+                    of @a radius
+        @param      tile Padded tile: the cells for which to calculate results, surrounded by a halo of
+                    @a radius cells
+        @param      compare Comparison used to select the extremum, like std::max does: std::less
+                    results in the maximum, std::greater in the minimum
+        @param      function Function called for each cell with its indices, the extremum and whether
+                    any of the values in the neighbourhood is valid
+
+        Values detected as no-data by @a indp are skipped. The van Herk / Gil-Werman algorithm is
+        used, first along the tile rows, then along the columns. Per dimension, the sequence of values
+        is split in blocks of kernel size, within which prefix and suffix extrema are calculated. The
+        extremum of each window is the extremum of the suffix extremum at its start and the prefix
+        extremum at its end. This requires about three comparisons per cell per dimension, independent
+        of the @a radius.
+    */
+    template<typename InputNoDataPolicy, typename Tile, typename Compare, typename Function>
+    void box_extremum(
+        InputNoDataPolicy const& indp,
+        Tile const& tile,
+        Radius const radius,
+        Compare const& compare,
+        Function&& function)
+    {
+        using Element = std::remove_cvref_t<decltype(tile[0, 0])>;
+        using Value = extremum::Value<Element>;
+        using Shape = typename Array<Value, 2>::Shape;
+
+        auto const combine = [&compare](Value const& value1, Value const& value2) -> Value
+        { return extremum::combine(value1, value2, compare); };
+
+        Count const size{2 * radius + 1};
+        Count const nr_tile_rows{static_cast<Count>(tile.extent(0))};
+        Count const nr_tile_cols{static_cast<Count>(tile.extent(1))};
+        Count const nr_rows{nr_tile_rows - 2 * radius};
+        Count const nr_cols{nr_tile_cols - 2 * radius};
+
+        lue_hpx_assert(nr_rows > 0);
+        lue_hpx_assert(nr_cols > 0);
+
+        // Per tile row and output column, the extremum of the values in the columns of the
+        // neighbourhood
+        Array<Value, 2> row_extrema{Shape{{nr_tile_rows, nr_cols}}};
+
+        {
+            std::vector<Value> prefix(nr_tile_cols);
+            std::vector<Value> suffix(nr_tile_cols);
+
+            for (Index row = 0; row < nr_tile_rows; ++row)
+            {
+                for (Index col = 0; col < nr_tile_cols; ++col)
+                {
+                    Element const value{tile[row, col]};
+
+                    prefix[col] = Value{value, !indp.is_no_data(value)};
+
+                    if (col % size != 0)
+                    {
+                        prefix[col] = combine(prefix[col - 1], prefix[col]);
+                    }
+                }
+
+                for (Index col = nr_tile_cols - 1; col >= 0; --col)
+                {
+                    Element const value{tile[row, col]};
+
+                    suffix[col] = Value{value, !indp.is_no_data(value)};
+
+                    if (col % size != size - 1 && col != nr_tile_cols - 1)
+                    {
+                        suffix[col] = combine(suffix[col], suffix[col + 1]);
+                    }
+                }
+
+                for (Index col = 0; col < nr_cols; ++col)
+                {
+                    row_extrema(row, col) = combine(suffix[col], prefix[col + size - 1]);
+                }
+            }
+        }
+
+        // Per output column, the extremum of the row extrema in the rows of the neighbourhood
+        Array<Value, 2> prefix{Shape{{nr_tile_rows, nr_cols}}};
+        Array<Value, 2> suffix{Shape{{nr_tile_rows, nr_cols}}};
+
+        for (Index row = 0; row < nr_tile_rows; ++row)
+        {
+            for (Index col = 0; col < nr_cols; ++col)
+            {
+                prefix(row, col) = row % size == 0 ? row_extrema(row, col)
+                                                   : combine(prefix(row - 1, col), row_extrema(row, col));
+            }
+        }
+
+        for (Index row = nr_tile_rows - 1; row >= 0; --row)
+        {
+            for (Index col = 0; col < nr_cols; ++col)
+            {
+                suffix(row, col) = row % size == size - 1 || row == nr_tile_rows - 1
+                                       ? row_extrema(row, col)
+                                       : combine(row_extrema(row, col), suffix(row + 1, col));
+            }
+        }
+
+        for (Index row = 0; row < nr_rows; ++row)
+        {
+            for (Index col = 0; col < nr_cols; ++col)
+            {
+                Value const extremum{combine(suffix(row, col), prefix(row + size - 1, col))};
+
+                function(row, col, extremum.value, extremum.valid);
+            }
+        }
+    }
+
+}  // namespace lue::detail
@@ -0,0 +1,311 @@
+#pragma once
+#include "lue/framework/core/array.hpp"
+#include "lue/framework/core/assert.hpp"
+#include <cmath>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+
+namespace lue::detail {
+
+    /*!
+        @brief      Type used for accumulating element values in box_sum()
+
+        Floating point values are accumulated in double precision, to limit the error introduced by
+        repeatedly adding and subtracting values from a running sum.
+    */
+    template<typename Element>
+    using BoxSumT = std::conditional_t<std::is_floating_point_v<Element>, double, Element>;
+
+
+    /*!
+        @brief      Number of non-finite values within a window, used by box_sum()
+
+        Non-finite values are not added to a running sum. Subtracting an infinite value from a sum
+        containing it results in NaN, instead of in the sum of the remaining values. Such values are
+        counted instead, and the sum of the window is corrected for them when it is reported.
+    */
+    template<typename Sum>
+    class NonFiniteCount
+    {
+
+        public:
+
+            static auto is_finite(Sum const value) -> bool
+            {
+                return std::isfinite(value);
+            }
+
+
+            void add(Sum const value)
+            {
+                update(value, 1);
+            }
+
+
+            void remove(Sum const value)
+            {
+                update(value, -1);
+            }
+
+
+            auto operator+=(NonFiniteCount const& other) -> NonFiniteCount&
+            {
+                _nr_nan += other._nr_nan;
+                _nr_positive_inf += other._nr_positive_inf;
+                _nr_negative_inf += other._nr_negative_inf;
+
+                return *this;
+            }
+
+
+            auto operator-=(NonFiniteCount const& other) -> NonFiniteCount&
+            {
+                _nr_nan -= other._nr_nan;
+                _nr_positive_inf -= other._nr_positive_inf;
+                _nr_negative_inf -= other._nr_negative_inf;
+
+                return *this;
+            }
+
+
+            /*!
+                @brief      Return the sum of the finite values in the window, @a sum, combined with the
+                            non-finite values counted
+            */
+            auto apply(Sum const sum) const -> Sum
+            {
+                if (_nr_nan > 0 || (_nr_positive_inf > 0 && _nr_negative_inf > 0))
+                {
+                    return std::numeric_limits<Sum>::quiet_NaN();
+                }
+
+                if (_nr_positive_inf > 0)
+                {
+                    return std::numeric_limits<Sum>::infinity();
+                }
+
+                if (_nr_negative_inf > 0)
+                {
+                    return -std::numeric_limits<Sum>::infinity();
+                }
+
+                return sum;
+            }
+
+        private:
+
+            void update(Sum const value, Count const delta)
+            {
+                lue_hpx_assert(!is_finite(value));
+
+                if (std::isnan(value))
+                {
+                    _nr_nan += delta;
+                }
+                else if (value > 0)
+                {
+                    _nr_positive_inf += delta;
+                }
+                else
+                {
+                    _nr_negative_inf += delta;
+                }
+            }
+
+
+            Count _nr_nan{0};
+
+            Count _nr_positive_inf{0};
+
+            Count _nr_negative_inf{0};
+    };
+
+
+    /*!
+        @brief      Specialization for integral sums, which are always finite
+    */
+    template<typename Sum>
+        requires std::is_integral_v<Sum>
+    class NonFiniteCount<Sum>
+    {
+
+        public:
+
+            static constexpr auto is_finite([[maybe_unused]] Sum const value) -> bool
+            {
+                return true;
+            }
+
+
+            void add([[maybe_unused]] Sum const value)
+            {
+            }
+
+
+            void remove([[maybe_unused]] Sum const value)
+            {
+            }
+
+
+            auto operator+=([[maybe_unused]] NonFiniteCount const& other) -> NonFiniteCount&
+            {
+                return *this;
+            }
+
+
+            auto operator-=([[maybe_unused]] NonFiniteCount const& other) -> NonFiniteCount&
+            {
+                return *this;
+            }
+
+
+            auto apply(Sum const sum) const -> Sum
+            {
+                return sum;
+            }
+    };
+
+
+    /*!
+        @brief      Calculate per cell the sum and the number of valid values within the square
+                    neighbourhood of @a radius
+        @param      tile Padded tile: the cells for which to calculate results, surrounded by a halo of
+                    @a radius cells
+        @param      function Function called for each cell with its indices, sum and number of valid
+                    values
+
+        Values detected as no-data by @a indp are skipped. The cost per cell does not depend on the
+        @a radius. First, per tile row, running sums over a window of kernel size columns are
+        calculated. Then, per output row, running sums of these over a window of kernel size rows are
+        calculated.
+
+        Non-finite values are counted separately from the running sums, like no-data values. The sum
+        passed to @a function is NaN or infinite while the window contains such values.
+    */
+    template<typename Sum, typename InputNoDataPolicy, typename Tile, typename Function>
+    void box_sum(InputNoDataPolicy const& indp, Tile const& tile, Radius const radius, Function&& function)
+    {
+        using Shape = typename Array<Sum, 2>::Shape;
+        using NonFinite = NonFiniteCount<Sum>;
+
+        Count const size{2 * radius + 1};
+        Count const nr_tile_rows{static_cast<Count>(tile.extent(0))};
+        Count const nr_rows{nr_tile_rows - 2 * radius};
+        Count const nr_cols{static_cast<Count>(tile.extent(1)) - 2 * radius};
+
+        lue_hpx_assert(nr_rows > 0);
+        lue_hpx_assert(nr_cols > 0);
+
+        // Per tile row and output column, the sum and count of the values in the columns of the
+        // neighbourhood
+        Array<Sum, 2> row_sums{Shape{{nr_tile_rows, nr_cols}}};
+        Array<Count, 2> row_counts{Shape{{nr_tile_rows, nr_cols}}};
+        Array<NonFinite, 2> row_non_finites{typename Array<NonFinite, 2>::Shape{{nr_tile_rows, nr_cols}}};
+
+        for (Index row = 0; row < nr_tile_rows; ++row)
+        {
+            Sum sum{0};
+            Count count{0};
+            NonFinite non_finite{};
+
+            for (Index col = 0; col < size; ++col)
+            {
+                auto const value{tile[row, col]};
+
+                if (!indp.is_no_data(value))
+                {
+                    if (NonFinite::is_finite(value))
+                    {
+                        sum += value;
+                    }
+                    else
+                    {
+                        non_finite.add(value);
+                    }
+
+                    ++count;
+                }
+            }
+
+            row_sums(row, 0) = sum;
+            row_counts(row, 0) = count;
+            row_non_finites(row, 0) = non_finite;
+
+            for (Index col = 1; col < nr_cols; ++col)
+            {
+                auto const leaving_value{tile[row, col - 1]};
+                auto const entering_value{tile[row, col + size - 1]};
+
+                if (!indp.is_no_data(leaving_value))
+                {
+                    if (NonFinite::is_finite(leaving_value))
+                    {
+                        sum -= leaving_value;
+                    }
+                    else
+                    {
+                        non_finite.remove(leaving_value);
+                    }
+
+                    --count;
+                }
+
+                if (!indp.is_no_data(entering_value))
+                {
+                    if (NonFinite::is_finite(entering_value))
+                    {
+                        sum += entering_value;
+                    }
+                    else
+                    {
+                        non_finite.add(entering_value);
+                    }
+
+                    ++count;
+                }
+
+                row_sums(row, col) = sum;
+                row_counts(row, col) = count;
+                row_non_finites(row, col) = non_finite;
+            }
+        }
+
+        // Per output column, the sum and count of the row sums and counts in the rows of the
+        // neighbourhood
+        std::vector<Sum> sums(nr_cols, Sum{0});
+        std::vector<Count> counts(nr_cols, 0);
+        std::vector<NonFinite> non_finites(nr_cols);
+
+        for (Index row = 0; row < size; ++row)
+        {
+            for (Index col = 0; col < nr_cols; ++col)
+            {
+                sums[col] += row_sums(row, col);
+                counts[col] += row_counts(row, col);
+                non_finites[col] += row_non_finites(row, col);
+            }
+        }
+
+        for (Index row = 0; row < nr_rows; ++row)
+        {
+            for (Index col = 0; col < nr_cols; ++col)
+            {
+                function(row, col, non_finites[col].apply(sums[col]), counts[col]);
+            }
+
+            if (row + 1 < nr_rows)
+            {
+                for (Index col = 0; col < nr_cols; ++col)
+                {
+                    sums[col] += row_sums(row + size, col) - row_sums(row, col);
+                    counts[col] += row_counts(row + size, col) - row_counts(row, col);
+                    non_finites[col] += row_non_finites(row + size, col);
+                    non_finites[col] -= row_non_finites(row, col);
+                }
+            }
+        }
+    }
+
+}  // namespace lue::detail
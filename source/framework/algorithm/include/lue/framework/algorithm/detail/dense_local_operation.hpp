@@ -0,0 +1,27 @@
+#pragma once
+#include "lue/framework/algorithm/policy/all_values_within_domain.hpp"
+#include "lue/framework/algorithm/policy/all_values_within_range.hpp"
+#include "lue/framework/algorithm/policy/policy_traits.hpp"
+#include "lue/framework/core/validity_mask.hpp"
+#include <type_traits>
+
+
+namespace lue::detail {
+
+    /*!
+        @brief      Whether a local operation can be evaluated for all elements in a single dense loop,
+                    handling no-data afterwards, using a ValidityMask
+        @tparam     Element Types of the input and output elements
+
+        This is the case when the domain and range policies don't check anything and all elements involved
+        are floating point. Evaluating the functor for a no-data element then does not result in undefined
+        behaviour. The result for such an element is replaced by no-data afterwards.
+    */
+    template<typename Policies, typename... Element>
+    inline constexpr bool dense_local_operation_v =
+        policy::is_all_values_within_domain_v<policy::DomainPolicyT<Policies>> &&
+        policy::is_all_values_within_range_v<std::remove_cvref_t<
+            decltype(std::get<0>(std::declval<Policies const&>().outputs_policies()).range_policy())>> &&
+        (std::is_floating_point_v<Element> && ...);
+
+}  // namespace lue::detail
@@ -0,0 +1,152 @@
+#pragma once
+#include "lue/framework/core/assert.hpp"
+#include "lue/framework/core/define.hpp"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <numbers>
+#include <vector>
+
+
+namespace lue::detail {
+
+    using Complex = std::complex<double>;
+
+
+    /*!
+        @brief      Discrete Fourier transform of sequences of values whose length is a power of two
+
+        The iterative radix-2 Cooley-Tukey algorithm is used. The roots of unity are calculated once,
+        upon construction, and reused for each transform. The inverse transform is not scaled.
+    */
+    class FFT
+    {
+
+        public:
+
+            /*!
+                @brief      Construct an instance for sequences of @a size values
+                @warning    @a size must be a power of two
+            */
+            explicit FFT(Count const size):
+
+                _size{size},
+                _roots(static_cast<std::size_t>(size / 2))
+
+            {
+                lue_hpx_assert(size > 0);
+                lue_hpx_assert(std::has_single_bit(static_cast<std::uint64_t>(size)));
+
+                // Calculating each root directly, instead of by repeated multiplication, limits the
+                // rounding errors
+                for (Index idx = 0; idx < size / 2; ++idx)
+                {
+                    _roots[idx] = std::polar(
+                        1.0, -2.0 * std::numbers::pi * static_cast<double>(idx) / static_cast<double>(size));
+                }
+            }
+
+
+            auto size() const -> Count
+            {
+                return _size;
+            }
+
+
+            /*!
+                @brief      Transform the @a size values starting at @a values, which are @a stride
+                            elements apart
+                @param      buffer Buffer used to collect the values, must contain at least @a size
+                            elements
+            */
+            void transform(
+                Complex* values, Count const stride, bool const inverse, std::vector<Complex>& buffer) const
+            {
+                lue_hpx_assert(static_cast<Count>(buffer.size()) >= _size);
+
+                // Gather the values in bit-reversed order
+                int const nr_bits{std::countr_zero(static_cast<std::uint64_t>(_size))};
+
+                for (Index idx = 0; idx < _size; ++idx)
+                {
+                    buffer[reverse_bits(idx, nr_bits)] = values[idx * stride];
+                }
+
+                for (Count length = 2; length <= _size; length *= 2)
+                {
+                    Count const half_length{length / 2};
+                    Count const root_stride{_size / length};
+
+                    for (Index start = 0; start < _size; start += length)
+                    {
+                        for (Index idx = 0; idx < half_length; ++idx)
+                        {
+                            Complex const root{
+                                inverse ? std::conj(_roots[idx * root_stride]) : _roots[idx * root_stride]};
+                            Complex const even{buffer[start + idx]};
+                            Complex const odd{root * buffer[start + idx + half_length]};
+
+                            buffer[start + idx] = even + odd;
+                            buffer[start + idx + half_length] = even - odd;
+                        }
+                    }
+                }
+
+                for (Index idx = 0; idx < _size; ++idx)
+                {
+                    values[idx * stride] = buffer[idx];
+                }
+            }
+
+        private:
+
+            static auto reverse_bits(Index value, int const nr_bits) -> Index
+            {
+                Index result{0};
+
+                for (int bit = 0; bit < nr_bits; ++bit)
+                {
+                    result = (result << 1) | (value & 1);
+                    value >>= 1;
+                }
+
+                return result;
+            }
+
+
+            Count _size;
+
+            std::vector<Complex> _roots;
+    };
+
+
+    /*!
+        @brief      Two-dimensional discrete Fourier transform of a row-major array of values
+        @param      fft0 Transform to use for the columns, sized for the number of rows
+        @param      fft1 Transform to use for the rows, sized for the number of columns
+
+        The inverse transform is not scaled.
+    */
+    inline void fft_2d(std::vector<Complex>& values, FFT const& fft0, FFT const& fft1, bool const inverse)
+    {
+        Count const nr_rows{fft0.size()};
+        Count const nr_cols{fft1.size()};
+
+        lue_hpx_assert(static_cast<Count>(values.size()) == nr_rows * nr_cols);
+
+        std::vector<Complex> buffer(static_cast<std::size_t>(std::max(nr_rows, nr_cols)));
+
+        for (Index row = 0; row < nr_rows; ++row)
+        {
+            fft1.transform(values.data() + row * nr_cols, 1, inverse, buffer);
+        }
+
+        for (Index col = 0; col < nr_cols; ++col)
+        {
+            fft0.transform(values.data() + col, nr_cols, inverse, buffer);
+        }
+    }
+
+}  // namespace lue::detail
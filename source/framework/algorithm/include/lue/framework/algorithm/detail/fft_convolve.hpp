@@ -0,0 +1,225 @@
+#pragma once
+#include "lue/framework/algorithm/detail/fft.hpp"
+#include "lue/framework/core/array.hpp"
+#include "lue/framework/core/assert.hpp"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+
+namespace lue::detail {
+
+    /*!
+        @brief      Calculate per cell the sum of the valid values within the neighbourhood, multiplied
+                    by the corresponding weights of @a kernel, using fast Fourier transforms
+        @param      tile Padded tile: the cells for which to calculate results, surrounded by a halo of
+                    kernel radius cells
+        @param      function Function called for each cell with its indices, the weighted sum and the
+                    number of valid values within the neighbourhood
+
+        Values detected as no-data by @a indp contribute nothing to the sum. The overlap-save method
+        is used: the tile is processed in blocks whose size is about twice the kernel size. Each block
+        is transformed, multiplied by the transformed kernel and transformed back. The cells near the
+        block's borders, which are affected by wrap-around, are discarded. The blocks overlap such
+        that each cell's result is calculated once. The cost per cell is proportional to the
+        logarithm of the kernel size, instead of to its square.
+
+        Non-finite values are kept out of the blocks. Transforming a block containing such a value
+        would turn all results in the block into NaN or infinity. They are counted instead, like
+        no-data values, and the results of the neighbourhoods containing them are calculated by
+        summing the weighted values directly.
+    */
+    template<typename InputNoDataPolicy, typename Kernel, typename Tile, typename Function>
+    void fft_convolve(
+        InputNoDataPolicy const& indp, Kernel const& kernel, Tile const& tile, Function&& function)
+    {
+        using Shape = typename Array<Count, 2>::Shape;
+        using Element = std::remove_cvref_t<decltype(tile[0, 0])>;
+
+        auto const is_finite = [](Element const value) -> bool
+        {
+            if constexpr (std::is_floating_point_v<Element>)
+            {
+                return std::isfinite(value);
+            }
+            else
+            {
+                return true;
+            }
+        };
+
+        Count const size{kernel.size()};
+        Count const nr_tile_rows{static_cast<Count>(tile.extent(0))};
+        Count const nr_tile_cols{static_cast<Count>(tile.extent(1))};
+        Count const nr_rows{nr_tile_rows - size + 1};
+        Count const nr_cols{nr_tile_cols - size + 1};
+
+        lue_hpx_assert(nr_rows > 0);
+        lue_hpx_assert(nr_cols > 0);
+
+        // Per dimension, the size of the blocks. No need for them to be larger than the tile.
+        auto const block_size = [size](Count const tile_size) -> Count
+        {
+            return static_cast<Count>(
+                std::bit_ceil(static_cast<std::uint64_t>(std::min(2 * size, tile_size))));
+        };
+
+        FFT const fft0{block_size(nr_tile_rows)};
+        FFT const fft1{block_size(nr_tile_cols)};
+        Count const nr_block_rows{fft0.size()};
+        Count const nr_block_cols{fft1.size()};
+
+        // Per dimension, the number of valid results per block
+        Count const block_stride0{nr_block_rows - size + 1};
+        Count const block_stride1{nr_block_cols - size + 1};
+
+        lue_hpx_assert(block_stride0 > 0);
+        lue_hpx_assert(block_stride1 > 0);
+
+        // Conjugate of the transformed kernel, scaled to undo the scaling of the inverse transform.
+        // Multiplying by the conjugate results in a correlation, which is what is needed here:
+        // result(r, c) = Σ weight(i, j) * value(r + i, c + j).
+        std::vector<Complex> kernel_spectrum(nr_block_rows * nr_block_cols, Complex{0});
+
+        for (Index idx0 = 0; idx0 < size; ++idx0)
+        {
+            for (Index idx1 = 0; idx1 < size; ++idx1)
+            {
+                kernel_spectrum[idx0 * nr_block_cols + idx1] = static_cast<double>(kernel(idx0, idx1));
+            }
+        }
+
+        fft_2d(kernel_spectrum, fft0, fft1, false);
+
+        double const scale{1.0 / static_cast<double>(nr_block_rows * nr_block_cols)};
+
+        for (Complex& value : kernel_spectrum)
+        {
+            value = std::conj(value) * scale;
+        }
+
+        // Summed area tables of the number of valid values and of the number of valid non-finite
+        // values, used to obtain these numbers within each neighbourhood in constant time
+        Array<Count, 2> nr_valid{Shape{{nr_tile_rows + 1, nr_tile_cols + 1}}};
+        Array<Count, 2> nr_non_finite{Shape{{nr_tile_rows + 1, nr_tile_cols + 1}}};
+
+        for (Index idx1 = 0; idx1 <= nr_tile_cols; ++idx1)
+        {
+            nr_valid(0, idx1) = 0;
+            nr_non_finite(0, idx1) = 0;
+        }
+
+        for (Index idx0 = 0; idx0 < nr_tile_rows; ++idx0)
+        {
+            nr_valid(idx0 + 1, 0) = 0;
+            nr_non_finite(idx0 + 1, 0) = 0;
+
+            for (Index idx1 = 0; idx1 < nr_tile_cols; ++idx1)
+            {
+                auto const value{tile[idx0, idx1]};
+                bool const is_valid{!indp.is_no_data(value)};
+                Count const valid{is_valid ? 1 : 0};
+                Count const non_finite{is_valid && !is_finite(value) ? 1 : 0};
+
+                nr_valid(idx0 + 1, idx1 + 1) =
+                    nr_valid(idx0, idx1 + 1) + nr_valid(idx0 + 1, idx1) - nr_valid(idx0, idx1) + valid;
+                nr_non_finite(idx0 + 1, idx1 + 1) = nr_non_finite(idx0, idx1 + 1) +
+                                                    nr_non_finite(idx0 + 1, idx1) -
+                                                    nr_non_finite(idx0, idx1) + non_finite;
+            }
+        }
+
+        auto const window_count =
+            [size](Array<Count, 2> const& table, Index const row, Index const col) -> Count
+        {
+            return table(row + size, col + size) - table(row, col + size) - table(row + size, col) +
+                   table(row, col);
+        };
+
+        // Sum of the weighted valid values within the neighbourhood of a cell, for neighbourhoods
+        // containing non-finite values
+        auto const direct_sum = [&indp, &kernel, &tile, size](Index const row, Index const col) -> double
+        {
+            double sum{0};
+
+            for (Index idx0 = 0; idx0 < size; ++idx0)
+            {
+                for (Index idx1 = 0; idx1 < size; ++idx1)
+                {
+                    auto const value{tile[row + idx0, col + idx1]};
+
+                    if (!indp.is_no_data(value))
+                    {
+                        sum += static_cast<double>(kernel(idx0, idx1)) * static_cast<double>(value);
+                    }
+                }
+            }
+
+            return sum;
+        };
+
+        std::vector<Complex> block(nr_block_rows * nr_block_cols);
+
+        for (Index row = 0; row < nr_rows; row += block_stride0)
+        {
+            for (Index col = 0; col < nr_cols; col += block_stride1)
+            {
+                // Copy the block's values, padding with zeros beyond the tile's extent
+                for (Index idx0 = 0; idx0 < nr_block_rows; ++idx0)
+                {
+                    for (Index idx1 = 0; idx1 < nr_block_cols; ++idx1)
+                    {
+                        Complex& cell{block[idx0 * nr_block_cols + idx1]};
+
+                        cell = Complex{0};
+
+                        if (row + idx0 < nr_tile_rows && col + idx1 < nr_tile_cols)
+                        {
+                            auto const value{tile[row + idx0, col + idx1]};
+
+                            if (!indp.is_no_data(value) && is_finite(value))
+                            {
+                                cell = static_cast<double>(value);
+                            }
+                        }
+                    }
+                }
+
+                fft_2d(block, fft0, fft1, false);
+
+                for (Index idx = 0; idx < nr_block_rows * nr_block_cols; ++idx)
+                {
+                    block[idx] *= kernel_spectrum[idx];
+                }
+
+                fft_2d(block, fft0, fft1, true);
+
+                Count const nr_result_rows{std::min(block_stride0, nr_rows - row)};
+                Count const nr_result_cols{std::min(block_stride1, nr_cols - col)};
+
+                for (Index idx0 = 0; idx0 < nr_result_rows; ++idx0)
+                {
+                    for (Index idx1 = 0; idx1 < nr_result_cols; ++idx1)
+                    {
+                        Index const row0{row + idx0};
+                        Index const col0{col + idx1};
+                        Count const count{window_count(nr_valid, row0, col0)};
+
+                        if (window_count(nr_non_finite, row0, col0) > 0)
+                        {
+                            function(row0, col0, direct_sum(row0, col0), count);
+                        }
+                        else
+                        {
+                            function(row0, col0, block[idx0 * nr_block_cols + idx1].real(), count);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+}  // namespace lue::detail
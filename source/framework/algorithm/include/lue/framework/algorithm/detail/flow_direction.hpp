@@ -3,6 +3,7 @@
 #include "lue/framework/core/assert.hpp"
 #include "lue/framework/core/define.hpp"
 #include "lue/framework/core/type_traits.hpp"
+#include <array>
 #include <tuple>
 
 
@@ -126,4 +127,26 @@ namespace lue::detail {
         return {idx0 + offset0, idx1 + offset1};
     }
 
+
+    /*!
+        @brief      Return the flow direction towards the neighbouring cell at @a offset0, @a offset1
+                    from a cell
+
+        This is the inverse of downstream_cell(). An offset of zero results in a sink.
+    */
+    template<typename FlowDirectionElement>
+    auto flow_direction_towards(Index const offset0, Index const offset1) -> FlowDirectionElement
+    {
+        lue_hpx_assert(offset0 >= -1 && offset0 <= 1);
+        lue_hpx_assert(offset1 >= -1 && offset1 <= 1);
+
+        static constexpr std::array<std::array<FlowDirectionElement, 3>, 3> flow_directions{{
+            {north_west<FlowDirectionElement>, north<FlowDirectionElement>, north_east<FlowDirectionElement>},
+            {west<FlowDirectionElement>, sink<FlowDirectionElement>, east<FlowDirectionElement>},
+            {south_west<FlowDirectionElement>, south<FlowDirectionElement>, south_east<FlowDirectionElement>},
+        }};
+
+        return flow_directions[static_cast<std::size_t>(offset0 + 1)][static_cast<std::size_t>(offset1 + 1)];
+    }
+
 }  // namespace lue::detail
@@ -98,6 +98,13 @@ namespace lue::detail {
             }
 
 
+            //! Return the index along the side of the partition of the cell at @a cell_idxs
+            auto idx(std::array<Index, 2> const& cell_idxs) const -> Index
+            {
+                return cell_idxs[1];
+            }
+
+
         private:
 
             Index _row;
@@ -131,6 +138,13 @@ namespace lue::detail {
             }
 
 
+            //! Return the index along the side of the partition of the cell at @a cell_idxs
+            auto idx(std::array<Index, 2> const& cell_idxs) const -> Index
+            {
+                return cell_idxs[0];
+            }
+
+
         private:
 
             Index _col;
@@ -165,6 +179,13 @@ namespace lue::detail {
             }
 
 
+            //! Return the index along the side of the partition of the cell at @a cell_idxs: always 0
+            auto idx([[maybe_unused]] std::array<Index, 2> const& cell_idxs) const -> Index
+            {
+                return 0;
+            }
+
+
         private:
 
             Index _row;
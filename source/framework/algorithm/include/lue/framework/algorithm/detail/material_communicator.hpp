@@ -0,0 +1,131 @@
+#pragma once
+#include "lue/framework/algorithm/detail/communicator.hpp"
+#include <hpx/serialization.hpp>
+#include <span>
+#include <string>
+#include <vector>
+
+
+namespace lue::detail {
+
+    /*!
+        @brief      Batch of material sent to input cells of a neighbouring partition
+
+        Each cell is identified by its index along the side of the partition bordering the
+        sending partition. Batching material reduces the number of messages sent through
+        the channels.
+
+        When routing multiple layers of material at once, the values of all layers are stored per
+        cell, one after the other. The number of values per cell is the same for all cells.
+    */
+    template<
+        typename MaterialElement,
+        Rank rank>  // Remove parameter
+    class ChannelMaterial
+    {
+
+        public:
+
+            ChannelMaterial() = default;
+
+
+            void push_back(Index const idx, MaterialElement const& value)
+            {
+                _cell_idxs.push_back(idx);
+                _values.push_back(value);
+            }
+
+
+            void push_back(Index const idx, std::span<MaterialElement const> const values)
+            {
+                _cell_idxs.push_back(idx);
+                _values.insert(_values.end(), values.begin(), values.end());
+            }
+
+
+            void clear()
+            {
+                _cell_idxs.clear();
+                _values.clear();
+            }
+
+
+            auto empty() const -> bool
+            {
+                return _cell_idxs.empty();
+            }
+
+
+            auto size() const -> std::size_t
+            {
+                return _cell_idxs.size();
+            }
+
+
+            auto cell_idxs() const -> std::vector<Index> const&
+            {
+                return _cell_idxs;
+            }
+
+
+            auto values() const -> std::vector<MaterialElement> const&
+            {
+                return _values;
+            }
+
+
+        private:
+
+            friend class hpx::serialization::access;
+
+
+            template<typename Archive>
+            void serialize(Archive& archive, [[maybe_unused]] unsigned int const version)
+            {
+                archive & _cell_idxs & _values;
+            }
+
+
+            std::vector<Index> _cell_idxs;
+
+            std::vector<MaterialElement> _values;
+    };
+
+
+    template<typename MaterialElement, Rank rank>
+    class MaterialCommunicator: public Communicator<ChannelMaterial<MaterialElement, rank>, rank>
+    {
+
+        public:
+
+            using Base = Communicator<ChannelMaterial<MaterialElement, rank>, rank>;
+
+
+            MaterialCommunicator() = default;
+
+
+            MaterialCommunicator(
+                hpx::id_type const locality_id,
+                std::string const& basename,
+                lue::Shape<Count, rank> const& shape_in_partitions,
+                lue::Indices<Index, rank> const& partition_idxs):
+
+                Base{locality_id, basename, shape_in_partitions, partition_idxs}
+
+            {
+            }
+
+
+        private:
+
+            friend class hpx::serialization::access;
+
+
+            template<typename Archive>
+            void serialize(Archive& archive, unsigned int const version)
+            {
+                Base::serialize(archive, version);
+            }
+    };
+
+}  // namespace lue::detail
@@ -0,0 +1,124 @@
+#pragma once
+#include "lue/framework/algorithm/kernel.hpp"
+#include "lue/framework/core/array.hpp"
+#include "lue/framework/core/assert.hpp"
+#include <type_traits>
+#include <vector>
+
+
+namespace lue::detail {
+
+    /*!
+        @brief      Calculate per cell the weighted sum and the number of valid values within the
+                    neighbourhood of a separable kernel
+        @param      factors Factors of the kernel, as returned by kernel_factors()
+        @param      tile Padded tile: the cells for which to calculate results, surrounded by a halo of
+                    kernel radius cells
+        @param      function Function called for each cell with its indices, sum and number of valid
+                    values
+
+        Values detected as no-data by @a indp are skipped, as are cells whose weight is zero. Floating
+        point weights are multiplied by the values. Integral weights only select the values to sum,
+        like the focal operations using them do. First, per tile row, the values in the columns of the
+        neighbourhood are aggregated, using the row factors. Then, per output cell, these intermediate
+        results in the rows of the neighbourhood are aggregated, using the column factors. The cost
+        per cell is linear in the kernel size, instead of quadratic.
+    */
+    template<typename Sum, typename InputNoDataPolicy, typename Weight, typename Tile, typename Function>
+    void separable_sum(
+        InputNoDataPolicy const& indp,
+        KernelFactors<Weight> const& factors,
+        Tile const& tile,
+        Function&& function)
+    {
+        using Shape = typename Array<Sum, 2>::Shape;
+
+        Count const size{static_cast<Count>(factors.weights0.size())};
+        Count const nr_tile_rows{static_cast<Count>(tile.extent(0))};
+        Count const nr_rows{nr_tile_rows - size + 1};
+        Count const nr_cols{static_cast<Count>(tile.extent(1)) - size + 1};
+
+        lue_hpx_assert(static_cast<Count>(factors.weights1.size()) == size);
+        lue_hpx_assert(nr_rows > 0);
+        lue_hpx_assert(nr_cols > 0);
+
+        auto const weigh = [](Weight const weight, Sum const value) -> Sum
+        {
+            if constexpr (std::is_floating_point_v<Weight>)
+            {
+                return static_cast<Sum>(weight) * value;
+            }
+            else
+            {
+                return value;
+            }
+        };
+
+        // Per dimension, the offsets of the non-zero weights
+        auto const non_zero_offsets = [](std::vector<Weight> const& weights) -> std::vector<Index>
+        {
+            std::vector<Index> offsets{};
+
+            for (Index idx = 0; idx < static_cast<Index>(weights.size()); ++idx)
+            {
+                if (weights[idx] != Weight{0})
+                {
+                    offsets.push_back(idx);
+                }
+            }
+
+            return offsets;
+        };
+
+        std::vector<Index> const offsets0{non_zero_offsets(factors.weights0)};
+        std::vector<Index> const offsets1{non_zero_offsets(factors.weights1)};
+
+        // Per tile row and output column, the weighted sum and count of the values in the columns
+        // of the neighbourhood
+        Array<Sum, 2> row_sums{Shape{{nr_tile_rows, nr_cols}}};
+        Array<Count, 2> row_counts{Shape{{nr_tile_rows, nr_cols}}};
+
+        for (Index row = 0; row < nr_tile_rows; ++row)
+        {
+            for (Index col = 0; col < nr_cols; ++col)
+            {
+                Sum sum{0};
+                Count count{0};
+
+                for (Index const offset : offsets1)
+                {
+                    auto const value{tile[row, col + offset]};
+
+                    if (!indp.is_no_data(value))
+                    {
+                        sum += weigh(factors.weights1[offset], static_cast<Sum>(value));
+                        ++count;
+                    }
+                }
+
+                row_sums(row, col) = sum;
+                row_counts(row, col) = count;
+            }
+        }
+
+        // Per output cell, the weighted sum and count of the row sums and counts in the rows of the
+        // neighbourhood
+        for (Index row = 0; row < nr_rows; ++row)
+        {
+            for (Index col = 0; col < nr_cols; ++col)
+            {
+                Sum sum{0};
+                Count count{0};
+
+                for (Index const offset : offsets0)
+                {
+                    sum += weigh(factors.weights0[offset], row_sums(row + offset, col));
+                    count += row_counts(row + offset, col);
+                }
+
+                function(row, col, sum, count);
+            }
+        }
+    }
+
+}  // namespace lue::detail
@@ -0,0 +1,372 @@
+#pragma once
+#include "lue/framework/core/assert.hpp"
+#include "lue/framework/core/define.hpp"
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+
+namespace lue::detail {
+
+    /*!
+        @brief      Histogram of element values in a moving window, supporting incremental updates
+
+        Counts are stored in a dense array indexed by value when the range of values to expect is
+        small, and in a hash map otherwise. The range is small when it is within a small multiple of
+        the number of values present at the same time. Searching for a new majority value then costs
+        about as much for both representations.
+
+        Besides the counts, the number of distinct values, the largest frequency and the majority
+        value are kept up to date. The majority value is the value with the largest frequency. If
+        there are multiple, it is the smallest one. Only when a count of the current majority value
+        is removed, the histogram has to be searched for the new majority value, the next time it is
+        asked for.
+    */
+    template<std::integral Element>
+    class SlidingHistogram
+    {
+
+        public:
+
+            //! Maximum size of the range of values for which counts are stored in a dense array
+            static constexpr std::uint64_t max_nr_dense_counts{std::uint64_t{1} << 16};
+
+            //! Maximum size of the range of values, relative to the number of values present at the same
+            //! time, for which counts are stored in a dense array
+            static constexpr std::uint64_t max_dense_range_factor{4};
+
+
+            /*!
+                @brief      Construct an instance for values in the range [@a min_value, @a max_value]
+                @param      max_nr_values Maximum number of values present at the same time
+            */
+            SlidingHistogram(Element const min_value, Element const max_value, Count const max_nr_values):
+
+                _min_value{min_value},
+                _dense{is_dense(range(min_value, max_value), max_nr_values)},
+                _dense_counts(_dense ? range(min_value, max_value) + 1 : 0, 0),
+                _sparse_counts{},
+                _nr_values{0},
+                _nr_distinct_values{0},
+                _nr_values_with_frequency(1, 0),
+                _max_frequency{0},
+                _majority_value{},
+                _majority_value_valid{false}
+
+            {
+                lue_hpx_assert(min_value <= max_value);
+            }
+
+
+            /*!
+                @brief      Add a count for @a value
+            */
+            void add(Element const value)
+            {
+                Count& count{this->count(value)};
+
+                if (count == 0)
+                {
+                    ++_nr_distinct_values;
+                }
+                else
+                {
+                    --_nr_values_with_frequency[count];
+                }
+
+                ++count;
+                ++_nr_values;
+
+                if (count == static_cast<Count>(_nr_values_with_frequency.size()))
+                {
+                    _nr_values_with_frequency.push_back(0);
+                }
+
+                ++_nr_values_with_frequency[count];
+
+                if (count > _max_frequency)
+                {
+                    _max_frequency = count;
+                    _majority_value = value;
+                    _majority_value_valid = true;
+                }
+                else if (count == _max_frequency && _majority_value_valid && value < _majority_value)
+                {
+                    _majority_value = value;
+                }
+            }
+
+
+            /*!
+                @brief      Remove a count for @a value, which must have been added before
+            */
+            void remove(Element const value)
+            {
+                Count& count{this->count(value)};
+
+                lue_hpx_assert(count > 0);
+
+                --_nr_values_with_frequency[count];
+
+                if (count == _max_frequency && _nr_values_with_frequency[count] == 0)
+                {
+                    --_max_frequency;
+                }
+
+                --count;
+                --_nr_values;
+
+                if (count == 0)
+                {
+                    --_nr_distinct_values;
+
+                    if (!_dense)
+                    {
+                        _sparse_counts.erase(value);
+                    }
+                }
+                else
+                {
+                    ++_nr_values_with_frequency[count];
+                }
+
+                if (_majority_value_valid && value == _majority_value)
+                {
+                    _majority_value_valid = false;
+                }
+            }
+
+
+            /*!
+                @brief      Return whether no counts are present
+            */
+            auto empty() const -> bool
+            {
+                return _nr_values == 0;
+            }
+
+
+            auto nr_distinct_values() const -> Count
+            {
+                return _nr_distinct_values;
+            }
+
+
+            /*!
+                @brief      Return the value with the largest frequency
+                @warning    The histogram must not be empty
+
+                If multiple values have the largest frequency, the smallest one is returned.
+            */
+            auto majority_value() -> Element
+            {
+                lue_hpx_assert(!empty());
+
+                if (!_majority_value_valid)
+                {
+                    if (_dense)
+                    {
+                        auto const it = std::find(_dense_counts.begin(), _dense_counts.end(), _max_frequency);
+
+                        lue_hpx_assert(it != _dense_counts.end());
+
+                        _majority_value = static_cast<Element>(
+                            static_cast<std::uint64_t>(_min_value) +
+                            static_cast<std::uint64_t>(it - _dense_counts.begin()));
+                    }
+                    else
+                    {
+                        bool found{false};
+
+                        for (auto const& [value, count] : _sparse_counts)
+                        {
+                            if (count == _max_frequency && (!found || value < _majority_value))
+                            {
+                                _majority_value = value;
+                                found = true;
+                            }
+                        }
+
+                        lue_hpx_assert(found);
+                    }
+
+                    _majority_value_valid = true;
+                }
+
+                return _majority_value;
+            }
+
+        private:
+
+            static auto is_dense(std::uint64_t const range, Count const max_nr_values) -> bool
+            {
+                std::uint64_t const nr_values{static_cast<std::uint64_t>(std::max<Count>(max_nr_values, 1))};
+
+                return range < std::min(max_nr_dense_counts, max_dense_range_factor * nr_values);
+            }
+
+
+            static auto range(Element const min_value, Element const max_value) -> std::uint64_t
+            {
+                // Modular arithmetic results in the correct difference, also for signed elements
+                return static_cast<std::uint64_t>(max_value) - static_cast<std::uint64_t>(min_value);
+            }
+
+
+            auto count(Element const value) -> Count&
+            {
+                if (_dense)
+                {
+                    lue_hpx_assert(value >= _min_value);
+                    lue_hpx_assert(range(_min_value, value) < _dense_counts.size());
+
+                    return _dense_counts[range(_min_value, value)];
+                }
+
+                return _sparse_counts[value];
+            }
+
+
+            Element _min_value;
+
+            bool _dense;
+
+            std::vector<Count> _dense_counts;
+
+            std::unordered_map<Element, Count> _sparse_counts;
+
+            //! Number of counts
+            Count _nr_values;
+
+            //! Number of values with a count larger than zero
+            Count _nr_distinct_values;
+
+            //! Per frequency, the number of values having this frequency
+            std::vector<Count> _nr_values_with_frequency;
+
+            Count _max_frequency;
+
+            Element _majority_value;
+
+            bool _majority_value_valid;
+    };
+
+
+    /*!
+        @brief      Call @a function for each cell in @a tile, with a histogram of the valid values
+                    within the neighbourhood defined by @a kernel
+        @param      tile Padded tile: the cells for which to call the function, surrounded by a halo
+                    of kernel radius cells
+        @param      function Function called for each cell with its indices and the histogram
+
+        Only cells for which the kernel weight is non-zero are part of the neighbourhood. Values
+        detected as no-data by @a indp are skipped. Moving the window one column only requires
+        updating the histogram for the cells at the left and right edges of the kernel. The cost per
+        cell is therefore linear in the kernel size, instead of quadratic.
+    */
+    template<typename InputNoDataPolicy, typename Kernel, typename Tile, typename Function>
+    void sliding_histogram(
+        InputNoDataPolicy const& indp, Kernel const& kernel, Tile const& tile, Function&& function)
+    {
+        using Element = std::remove_cvref_t<decltype(tile[0, 0])>;
+        using Offset = std::array<Index, 2>;
+
+        Count const size{kernel.size()};
+        Count const nr_tile_rows{static_cast<Count>(tile.extent(0))};
+        Count const nr_tile_cols{static_cast<Count>(tile.extent(1))};
+        Count const nr_rows{nr_tile_rows - size + 1};
+        Count const nr_cols{nr_tile_cols - size + 1};
+
+        lue_hpx_assert(nr_rows > 0);
+        lue_hpx_assert(nr_cols > 0);
+
+        // Offsets of the cells in the neighbourhood, of the cells leaving the neighbourhood when
+        // moving it one column, and of the cells entering it. The latter ones are relative to the
+        // new position.
+        std::vector<Offset> offsets{};
+        std::vector<Offset> leaving_offsets{};
+        std::vector<Offset> entering_offsets{};
+
+        for (Index idx0 = 0; idx0 < size; ++idx0)
+        {
+            for (Index idx1 = 0; idx1 < size; ++idx1)
+            {
+                if (kernel(idx0, idx1))
+                {
+                    offsets.push_back({idx0, idx1});
+
+                    if (idx1 == 0 || !kernel(idx0, idx1 - 1))
+                    {
+                        leaving_offsets.push_back({idx0, idx1});
+                    }
+
+                    if (idx1 == size - 1 || !kernel(idx0, idx1 + 1))
+                    {
+                        entering_offsets.push_back({idx0, idx1});
+                    }
+                }
+            }
+        }
+
+        // Determine the range of the valid values, to be able to select the histogram's storage
+        bool found{false};
+        Element min_value{};
+        Element max_value{};
+
+        for (Index idx0 = 0; idx0 < nr_tile_rows; ++idx0)
+        {
+            for (Index idx1 = 0; idx1 < nr_tile_cols; ++idx1)
+            {
+                Element const value{tile[idx0, idx1]};
+
+                if (!indp.is_no_data(value))
+                {
+                    min_value = found ? std::min(min_value, value) : value;
+                    max_value = found ? std::max(max_value, value) : value;
+                    found = true;
+                }
+            }
+        }
+
+        SlidingHistogram<Element> histogram{min_value, max_value, static_cast<Count>(offsets.size())};
+
+        auto const update = [&indp, &tile, &histogram](
+                                std::vector<Offset> const& cell_offsets,
+                                Index const row,
+                                Index const col,
+                                bool const add) -> void
+        {
+            for (auto const& [offset0, offset1] : cell_offsets)
+            {
+                Element const value{tile[row + offset0, col + offset1]};
+
+                if (!indp.is_no_data(value))
+                {
+                    add ? histogram.add(value) : histogram.remove(value);
+                }
+            }
+        };
+
+        for (Index row = 0; row < nr_rows; ++row)
+        {
+            update(offsets, row, 0, true);
+            function(row, 0, histogram);
+
+            for (Index col = 1; col < nr_cols; ++col)
+            {
+                update(leaving_offsets, row, col - 1, false);
+                update(entering_offsets, row, col, true);
+                function(row, col, histogram);
+            }
+
+            update(offsets, row, nr_cols - 1, false);
+
+            lue_hpx_assert(histogram.empty());
+        }
+    }
+
+}  // namespace lue::detail
@@ -0,0 +1,132 @@
+#pragma once
+#include "lue/framework/algorithm/kernel.hpp"
+#include "lue/framework/core/assert.hpp"
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
+
+namespace lue::detail {
+
+    /*!
+        @brief      Calculate per cell the sum and the number of valid values within the neighbourhood,
+                    only visiting the cells whose kernel weight is non-zero
+        @param      runs Runs of non-zero weights, as returned by kernel_runs()
+        @param      kernel_size Size of the kernel the runs are obtained from
+        @param      tile Padded tile: the cells for which to calculate results, surrounded by a halo of
+                    kernel radius cells
+        @param      function Function called for each cell with its indices, sum and number of valid
+                    values
+
+        Values detected as no-data by @a indp are skipped. The weights only select the values to sum,
+        like the focal operations using them do. The cost per cell is linear in the number of non-zero
+        weights, instead of in the number of cells in the kernel.
+    */
+    template<typename Sum, typename InputNoDataPolicy, typename Weight, typename Tile, typename Function>
+    void sparse_sum(
+        InputNoDataPolicy const& indp,
+        std::vector<KernelRun<Weight>> const& runs,
+        Count const kernel_size,
+        Tile const& tile,
+        Function&& function)
+    {
+        Count const nr_rows{static_cast<Count>(tile.extent(0)) - kernel_size + 1};
+        Count const nr_cols{static_cast<Count>(tile.extent(1)) - kernel_size + 1};
+
+        lue_hpx_assert(nr_rows > 0);
+        lue_hpx_assert(nr_cols > 0);
+
+        for (Index row = 0; row < nr_rows; ++row)
+        {
+            for (Index col = 0; col < nr_cols; ++col)
+            {
+                Sum sum{0};
+                Count count{0};
+
+                for (KernelRun<Weight> const& run : runs)
+                {
+                    Index const idx0{row + run.idx0};
+                    Index const idx1{col + run.idx1};
+
+                    for (Index idx = 0; idx < static_cast<Index>(run.weights.size()); ++idx)
+                    {
+                        auto const value{tile[idx0, idx1 + idx]};
+
+                        if (!indp.is_no_data(value))
+                        {
+                            sum += static_cast<Sum>(value);
+                            ++count;
+                        }
+                    }
+                }
+
+                function(row, col, sum, count);
+            }
+        }
+    }
+
+
+    /*!
+        @brief      Calculate per cell the extremum of the valid values within the neighbourhood, only
+                    visiting the cells whose kernel weight is non-zero
+        @param      runs Runs of non-zero weights, as returned by kernel_runs()
+        @param      kernel_size Size of the kernel the runs are obtained from
+        @param      tile Padded tile: the cells for which to calculate results, surrounded by a halo of
+                    kernel radius cells
+        @param      compare Comparison used to select the extremum, like std::max does: std::less
+                    results in the maximum, std::greater in the minimum
+        @param      function Function called for each cell with its indices, the extremum and whether
+                    any of the values in the neighbourhood is valid
+    */
+    template<
+        typename InputNoDataPolicy,
+        typename Weight,
+        typename Tile,
+        typename Compare,
+        typename Function>
+    void sparse_extremum(
+        InputNoDataPolicy const& indp,
+        std::vector<KernelRun<Weight>> const& runs,
+        Count const kernel_size,
+        Tile const& tile,
+        Compare const& compare,
+        Function&& function)
+    {
+        using Element = std::remove_cvref_t<decltype(tile[0, 0])>;
+
+        Count const nr_rows{static_cast<Count>(tile.extent(0)) - kernel_size + 1};
+        Count const nr_cols{static_cast<Count>(tile.extent(1)) - kernel_size + 1};
+
+        lue_hpx_assert(nr_rows > 0);
+        lue_hpx_assert(nr_cols > 0);
+
+        for (Index row = 0; row < nr_rows; ++row)
+        {
+            for (Index col = 0; col < nr_cols; ++col)
+            {
+                Element extremum{};
+                bool valid{false};
+
+                for (KernelRun<Weight> const& run : runs)
+                {
+                    Index const idx0{row + run.idx0};
+                    Index const idx1{col + run.idx1};
+
+                    for (Index idx = 0; idx < static_cast<Index>(run.weights.size()); ++idx)
+                    {
+                        Element const value{tile[idx0, idx1 + idx]};
+
+                        if (!indp.is_no_data(value))
+                        {
+                            extremum = valid ? std::max(extremum, value, compare) : value;
+                            valid = true;
+                        }
+                    }
+                }
+
+                function(row, col, extremum, valid);
+            }
+        }
+    }
+
+}  // namespace lue::detail
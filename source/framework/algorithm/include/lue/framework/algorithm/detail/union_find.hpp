@@ -0,0 +1,98 @@
+#pragma once
+#include "lue/framework/core/assert.hpp"
+#include <cstddef>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+
+
+namespace lue::detail {
+
+    /*!
+        @brief      Disjoint sets of the IDs in the range [0, nr_ids)
+        @tparam     ID Integral type of the IDs
+
+        The sets are stored as a forest in a single flat vector, containing per ID the ID of its
+        parent. The root of each tree is the smallest ID in the set. Finding the root of an ID
+        compresses the path to it, keeping the trees shallow.
+    */
+    template<typename ID>
+    class UnionFind
+    {
+
+        public:
+
+            static_assert(std::is_integral_v<ID>);
+
+
+            /*!
+                @brief      Create @a nr_ids sets, each containing a single ID
+            */
+            explicit UnionFind(std::size_t const nr_ids):
+
+                _parent(nr_ids)
+
+            {
+                std::iota(_parent.begin(), _parent.end(), ID{0});
+            }
+
+
+            /*!
+                @brief      Return the number of IDs
+            */
+            auto nr_ids() const -> std::size_t
+            {
+                return _parent.size();
+            }
+
+
+            /*!
+                @brief      Return the smallest ID in the set containing @a id
+            */
+            auto find(ID id) -> ID
+            {
+                lue_hpx_assert(static_cast<std::size_t>(id) < _parent.size());
+
+                // Path halving: make every other ID on the path point to its grandparent
+                while (parent(id) != id)
+                {
+                    parent(id) = parent(parent(id));
+                    id = parent(id);
+                }
+
+                return id;
+            }
+
+
+            /*!
+                @brief      Merge the sets containing @a id1 and @a id2
+            */
+            void unite(ID const id1, ID const id2)
+            {
+                ID const root1{find(id1)};
+                ID const root2{find(id2)};
+
+                if (root1 < root2)
+                {
+                    parent(root2) = root1;
+                }
+                else if (root2 < root1)
+                {
+                    parent(root1) = root2;
+                }
+            }
+
+
+        private:
+
+            auto parent(ID const id) -> ID&
+            {
+                return _parent[static_cast<std::size_t>(id)];
+            }
+
+
+            //! Per ID, the ID of its parent. Roots are their own parent.
+            std::vector<ID> _parent;
+    };
+
+}  // namespace lue::detail
@@ -0,0 +1,510 @@
+#pragma once
+#include "lue/framework/core/assert.hpp"
+#include <hpx/serialization.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+
+namespace lue::detail {
+
+    /*!
+        @brief      Collection of statistics per zone
+        @tparam     Zone Integral type of the zone ids
+        @tparam     Statistic Type of the statistic stored per zone
+
+        Zone rasters often contain a compact range of zone ids, like 1 to N. As long as the range
+        of zone ids is small compared to the number of zones, the statistics are stored in a vector,
+        indexed by the zone id minus the zone id of the first position. This avoids hashing zone ids
+        in the per-cell loops and turns merging two collections into an element-wise combine. Once
+        the range becomes too sparse, the statistics are moved to a hash map.
+
+        To not make the representation depend on the order in which zones are added, call reserve()
+        with the range of zone ids before adding statistics. Merging picks the representation from
+        all zones stored afterwards, independent of the representations of the collections merged.
+    */
+    template<typename Zone, typename Statistic>
+    class ZoneMap
+    {
+
+        public:
+
+            static_assert(std::is_integral_v<Zone>);
+
+            /*!
+                @brief      Minimum size of the range of zone ids which is stored in a vector,
+                            independent of the number of zones
+            */
+            static constexpr std::size_t min_dense_extent{1024};
+
+            /*!
+                @brief      Maximum number of positions in the vector per zone, before switching to
+                            a hash map
+            */
+            static constexpr std::size_t max_dense_extent_per_zone{4};
+
+
+            /*!
+                @brief      Return whether the statistics are stored in a vector
+            */
+            auto is_dense() const -> bool
+            {
+                return _dense;
+            }
+
+
+            /*!
+                @brief      Return the number of zones for which a statistic is stored
+            */
+            auto nr_zones() const -> std::size_t
+            {
+                return _dense ? _nr_zones : _statistic_by_zone.size();
+            }
+
+
+            /*!
+                @brief      Prepare for storing statistics of at most @a nr_zones zones, in the range
+                            [@a min_zone, @a max_zone]
+
+                Whether the statistics are stored in a vector is decided here, from the range of zone
+                ids and the number of zones, instead of from the order in which zones are added.
+            */
+            void reserve(Zone const min_zone, Zone const max_zone, std::size_t const nr_zones)
+            {
+                lue_hpx_assert(min_zone <= max_zone);
+
+                _max_nr_zones = std::max(_max_nr_zones, nr_zones);
+
+                auto const [first_zone, last_zone] = range(min_zone, max_zone);
+
+                if (dense_extent(first_zone, last_zone, this->nr_zones()))
+                {
+                    if (!_dense)
+                    {
+                        to_dense();
+                    }
+
+                    grow(first_zone, last_zone);
+                }
+                else if (_dense)
+                {
+                    to_sparse();
+                }
+            }
+
+
+            /*!
+                @brief      Add @a statistic to the statistic stored for @a zone
+                @param      combine Function for combining the statistic stored with @a statistic, in
+                            case a statistic is already stored for @a zone
+            */
+            template<typename Combine>
+            void add(Zone const zone, Statistic const& statistic, Combine const& combine)
+            {
+                if (make_room(zone))
+                {
+                    add_at(position(zone), statistic, combine);
+                }
+                else
+                {
+                    add_sparse(zone, statistic, combine);
+                }
+            }
+
+
+            /*!
+                @brief      Return the statistic stored for @a zone, storing a default constructed
+                            one first if there is none
+            */
+            auto insert(Zone const zone) -> Statistic&
+            {
+                if (make_room(zone))
+                {
+                    std::size_t const idx{position(zone)};
+
+                    if (!_present[idx])
+                    {
+                        _present[idx] = 1;
+                        ++_nr_zones;
+                    }
+
+                    return _statistics[idx];
+                }
+
+                return _statistic_by_zone[zone];
+            }
+
+
+            /*!
+                @brief      Add the statistics stored in @a other to the ones stored in this instance
+                @param      combine Function for combining two statistics of the same zone
+            */
+            template<typename Combine>
+            void merge(ZoneMap const& other, Combine const& combine)
+            {
+                _max_nr_zones += other._max_nr_zones;
+
+                if (other.nr_zones() == 0)
+                {
+                    return;
+                }
+
+                std::size_t nr_zones{this->nr_zones()};
+
+                other.for_each(
+                    [this, &nr_zones](Zone const zone, [[maybe_unused]] Statistic const& statistic)
+                    {
+                        if (!contains(zone))
+                        {
+                            ++nr_zones;
+                        }
+                    });
+
+                auto const [first_zone, last_zone] = range(other._min_zone, other._max_zone);
+
+                // Base the representation on all zones stored after merging, so the result does not
+                // depend on the order in which collections are merged
+                if (dense_extent(first_zone, last_zone, nr_zones))
+                {
+                    if (!_dense)
+                    {
+                        to_dense();
+                    }
+
+                    grow(first_zone, last_zone);
+
+                    other.for_each([this, &combine](Zone const zone, Statistic const& statistic)
+                                   { add_at(position(zone), statistic, combine); });
+                }
+                else
+                {
+                    if (_dense)
+                    {
+                        to_sparse();
+                    }
+
+                    other.for_each([this, &combine](Zone const zone, Statistic const& statistic)
+                                   { add_sparse(zone, statistic, combine); });
+                }
+
+                _min_zone = first_zone;
+                _max_zone = last_zone;
+            }
+
+
+            /*!
+                @brief      Return whether a statistic is stored for @a zone
+            */
+            auto contains(Zone const zone) const -> bool
+            {
+                if (_dense)
+                {
+                    return covers(zone) && _present[position(zone)];
+                }
+
+                return _statistic_by_zone.find(zone) != _statistic_by_zone.end();
+            }
+
+
+            /*!
+                @brief      Return the statistic stored for @a zone
+                @warning    A statistic must be stored for @a zone
+            */
+            auto operator[](Zone const zone) const -> Statistic const&
+            {
+                lue_hpx_assert(contains(zone));
+
+                if (_dense)
+                {
+                    return _statistics[position(zone)];
+                }
+
+                return (*_statistic_by_zone.find(zone)).second;
+            }
+
+
+            /*!
+                @brief      Call @a function for each zone, passing in the zone and its statistic
+            */
+            template<typename Function>
+            void for_each(Function const& function) const
+            {
+                if (_dense)
+                {
+                    for (std::size_t idx = 0; idx < _statistics.size(); ++idx)
+                    {
+                        if (_present[idx])
+                        {
+                            function(zone(idx), _statistics[idx]);
+                        }
+                    }
+                }
+                else
+                {
+                    for (auto const& [zone, statistic] : _statistic_by_zone)
+                    {
+                        function(zone, statistic);
+                    }
+                }
+            }
+
+
+        private:
+
+            using UnsignedZone = std::make_unsigned_t<Zone>;
+
+
+            /*!
+                @brief      Return the distance between @a zone1 and @a zone2
+                @warning    @a zone1 must not be larger than @a zone2
+            */
+            static auto offset(Zone const zone1, Zone const zone2) -> std::size_t
+            {
+                lue_hpx_assert(zone1 <= zone2);
+
+                // Cast the difference as well, since operands smaller than int are promoted to int
+                return static_cast<std::size_t>(static_cast<UnsignedZone>(
+                    static_cast<UnsignedZone>(zone2) - static_cast<UnsignedZone>(zone1)));
+            }
+
+
+            auto zone(std::size_t const idx) const -> Zone
+            {
+                return static_cast<Zone>(
+                    static_cast<UnsignedZone>(_first_zone) + static_cast<UnsignedZone>(idx));
+            }
+
+
+            auto position(Zone const zone) const -> std::size_t
+            {
+                return offset(_first_zone, zone);
+            }
+
+
+            /*!
+                @brief      Return whether the vector contains a position for @a zone
+            */
+            auto covers(Zone const zone) const -> bool
+            {
+                return zone >= _first_zone && position(zone) < _statistics.size();
+            }
+
+
+            /*!
+                @brief      Return the range of zone ids containing both the zones stored and the range
+                            [@a min_zone, @a max_zone]
+            */
+            auto range(Zone const min_zone, Zone const max_zone) const -> std::pair<Zone, Zone>
+            {
+                if (nr_zones() == 0)
+                {
+                    return {min_zone, max_zone};
+                }
+
+                return {std::min(min_zone, _min_zone), std::max(max_zone, _max_zone)};
+            }
+
+
+            /*!
+                @brief      Return whether the statistics of @a nr_zones zones, in the range
+                            [@a min_zone, @a max_zone], can be stored in a vector
+            */
+            auto dense_extent(Zone const min_zone, Zone const max_zone, std::size_t const nr_zones) const
+                -> bool
+            {
+                // Compare offsets instead of extents, which can overflow
+                return offset(min_zone, max_zone) <
+                       std::max(
+                           min_dense_extent, max_dense_extent_per_zone * std::max(nr_zones, _max_nr_zones));
+            }
+
+
+            /*!
+                @brief      Make sure a statistic can be stored for @a zone
+                @return     Whether the statistics are stored in a vector. If the range of zone ids
+                            becomes too sparse, the statistics are moved to the hash map.
+            */
+            auto make_room(Zone const zone) -> bool
+            {
+                if (_dense && !covers(zone))
+                {
+                    auto const [first_zone, last_zone] = range(zone, zone);
+
+                    if (dense_extent(first_zone, last_zone, _nr_zones + 1))
+                    {
+                        grow(first_zone, last_zone);
+                    }
+                    else
+                    {
+                        to_sparse();
+                    }
+                }
+
+                if (nr_zones() == 0)
+                {
+                    _min_zone = zone;
+                    _max_zone = zone;
+                }
+                else
+                {
+                    _min_zone = std::min(_min_zone, zone);
+                    _max_zone = std::max(_max_zone, zone);
+                }
+
+                return _dense;
+            }
+
+
+            /*!
+                @brief      Make sure the vector contains a position for each zone in the range
+                            [@a min_zone, @a max_zone]
+
+                The vector is grown at the front by at least its current size, so adding zones in
+                decreasing order takes amortized constant time, as it does in increasing order.
+            */
+            void grow(Zone const min_zone, Zone const max_zone)
+            {
+                lue_hpx_assert(_dense);
+
+                if (_statistics.empty())
+                {
+                    _first_zone = min_zone;
+                }
+                else if (min_zone < _first_zone)
+                {
+                    std::size_t const shift{std::min(
+                        std::max(offset(min_zone, _first_zone), _statistics.size()),
+                        offset(std::numeric_limits<Zone>::min(), _first_zone))};
+
+                    _statistics.insert(_statistics.begin(), shift, Statistic{});
+                    _present.insert(_present.begin(), shift, 0);
+                    _first_zone = static_cast<Zone>(
+                        static_cast<UnsignedZone>(_first_zone) - static_cast<UnsignedZone>(shift));
+                }
+
+                std::size_t const extent{offset(_first_zone, max_zone) + 1};
+
+                if (extent > _statistics.size())
+                {
+                    _statistics.resize(extent);
+                    _present.resize(extent, 0);
+                }
+            }
+
+
+            template<typename Combine>
+            void add_at(std::size_t const idx, Statistic const& statistic, Combine const& combine)
+            {
+                if (_present[idx])
+                {
+                    combine(_statistics[idx], statistic);
+                }
+                else
+                {
+                    _statistics[idx] = statistic;
+                    _present[idx] = 1;
+                    ++_nr_zones;
+                }
+            }
+
+
+            template<typename Combine>
+            void add_sparse(Zone const zone, Statistic const& statistic, Combine const& combine)
+            {
+                auto [it, inserted] = _statistic_by_zone.try_emplace(zone, statistic);
+
+                if (!inserted)
+                {
+                    combine((*it).second, statistic);
+                }
+            }
+
+
+            void to_sparse()
+            {
+                lue_hpx_assert(_dense);
+
+                _statistic_by_zone.reserve(_nr_zones);
+
+                for (std::size_t idx = 0; idx < _statistics.size(); ++idx)
+                {
+                    if (_present[idx])
+                    {
+                        _statistic_by_zone.emplace(zone(idx), std::move(_statistics[idx]));
+                    }
+                }
+
+                _dense = false;
+                _nr_zones = 0;
+                _statistics = {};
+                _present = {};
+            }
+
+
+            void to_dense()
+            {
+                lue_hpx_assert(!_dense);
+
+                _dense = true;
+
+                if (!_statistic_by_zone.empty())
+                {
+                    grow(_min_zone, _max_zone);
+
+                    for (auto& [zone, statistic] : _statistic_by_zone)
+                    {
+                        _statistics[position(zone)] = std::move(statistic);
+                        _present[position(zone)] = 1;
+                    }
+
+                    _nr_zones = _statistic_by_zone.size();
+                }
+
+                _statistic_by_zone = {};
+            }
+
+
+            friend class hpx::serialization::access;
+
+
+            template<typename Archive>
+            void serialize(Archive& archive, unsigned int const /* version */)
+            {
+                archive & _dense & _first_zone & _min_zone & _max_zone & _nr_zones & _max_nr_zones &
+                    _statistics & _present & _statistic_by_zone;
+            }
+
+
+            //! Whether the statistics are stored in the vector or in the hash map
+            bool _dense{true};
+
+            //! Zone id of the first position in the vector
+            Zone _first_zone{};
+
+            //! Smallest zone id stored, if any
+            Zone _min_zone{};
+
+            //! Largest zone id stored, if any
+            Zone _max_zone{};
+
+            //! Number of zones stored in the vector
+            std::size_t _nr_zones{0};
+
+            //! Maximum number of zones expected, as passed to reserve() and summed when merging
+            std::size_t _max_nr_zones{0};
+
+            //! Statistics per zone, indexed by zone id minus the zone id of the first position
+            std::vector<Statistic> _statistics;
+
+            //! Per position in the vector, whether a statistic is stored
+            std::vector<std::uint8_t> _present;
+
+            //! Statistics per zone, once the range of zone ids is too sparse for the vector
+            std::unordered_map<Zone, Statistic> _statistic_by_zone;
+    };
+
+}  // namespace lue::detail
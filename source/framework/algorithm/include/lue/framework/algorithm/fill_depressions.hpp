@@ -0,0 +1,18 @@
+#pragma once
+#include "lue/framework/algorithm/policy.hpp"
+#include "lue/framework/partitioned_array_decl.hpp"
+#include <tuple>
+
+
+namespace lue {
+
+    template<typename Policies>
+        requires std::floating_point<policy::InputElementT<Policies, 0>> &&
+                 std::integral<policy::OutputElementT<Policies, 1>>
+    auto fill_depressions(
+        Policies const& policies, PartitionedArray<policy::InputElementT<Policies, 0>, 2> const& elevation)
+        -> std::tuple<
+            PartitionedArray<policy::OutputElementT<Policies, 0>, 2>,
+            PartitionedArray<policy::OutputElementT<Policies, 1>, 2>>;
+
+}  // namespace lue
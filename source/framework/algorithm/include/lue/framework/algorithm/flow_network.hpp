@@ -0,0 +1,305 @@
+#pragma once
+#include "lue/framework/algorithm/detail/communicator_array.hpp"
+#include "lue/framework/algorithm/detail/material_communicator.hpp"
+#include "lue/framework/algorithm/inflow_count.hpp"
+#include "lue/framework/algorithm/policy.hpp"
+#include "lue/framework/core/array.hpp"
+#include "lue/framework/partitioned_array_decl.hpp"
+#include <hpx/synchronization/mutex.hpp>
+#include <array>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+
+namespace lue {
+    namespace policy::flow_network {
+
+        template<typename FlowDirectionElement>
+        using DefaultPolicies = inflow_count::DefaultPolicies<SmallestIntegralElement, FlowDirectionElement>;
+
+        template<typename FlowDirectionElement>
+        using DefaultValuePolicies =
+            inflow_count::DefaultValuePolicies<SmallestIntegralElement, FlowDirectionElement>;
+
+    }  // namespace policy::flow_network
+
+
+    /*!
+        @brief      Class template for storing the flow network defined by a flow direction array,
+                    for reuse by routing operations
+        @tparam     FlowDirectionElement Type for representing flow directions
+        @tparam     MaterialElement Type for representing the material routed through the network
+
+        Before routing material, the routing operations determine per cell the number of cells
+        draining into it, and per partition which cells exchange material with which neighbouring
+        partitions. They also set up the channels for sending material between partitions. This
+        involves visiting all cells, communicating with the neighbouring partitions, and registering
+        the channels.
+
+        A flow network stores the result of all this. It also stores per partition a topological
+        order of the cells that don't depend on material from neighbouring partitions, grouped in
+        levels of cells that don't drain into each other. Routing operations passed a flow network
+        instead of the flow direction array skip these steps, and sweep through the cells in this
+        order, one level at a time, instead of following streams cell by cell. This pays
+        off when the flow directions don't change, while routing operations are performed
+        repeatedly, like in time-stepped models.
+
+        Routing operations using the same network share its channels. Per partition, a routing
+        operation starts once the previous one using the network has finished in the partition
+        and its neighbours. Routing operations using the same network may be called from different
+        threads. They are ordered in the order in which they are started by route().
+
+        A flow network is created by flow_network(). It must be recreated when the flow directions
+        change.
+    */
+    template<typename FlowDirectionElement, typename MaterialElement>
+    class FlowNetwork
+    {
+
+        public:
+
+            //! Type of the array containing the flow directions
+            using FlowDirection = PartitionedArray<FlowDirectionElement, 2>;
+
+            //! Type for representing the number of cells draining into a cell (max 8)
+            using InflowCountElement = SmallestIntegralElement;
+
+            //! Type of the array containing the inflow counts
+            using InflowCount = PartitionedArray<InflowCountElement, 2>;
+
+            /*!
+                @brief      Type of the array containing per partition the order in which to visit
+                            the cells that don't depend on material from neighbouring partitions
+            */
+            using IntraPartitionOrder = PartitionedArray<IndexElement, 2>;
+
+            /*!
+                @brief      Type containing per partition the offsets in the intra-partition order of
+                            the levels of cells that can be visited concurrently
+            */
+            using IntraPartitionLevels = Array<ArrayPartition<IndexElement, 2>, 2>;
+
+            //! Type for storing the indices of cells in a partition
+            using CellsIdxs = std::vector<std::array<Index, 2>>;
+
+            //! Per neighbouring partition, the indices of cells
+            using NeighbourCellsIdxs = std::array<CellsIdxs, detail::nr_neighbours<2>()>;
+
+            //! Per partition, a future to the indices of cells per neighbouring partition
+            using NeighbourCellsIdxsFs = Array<hpx::shared_future<NeighbourCellsIdxs>, 2>;
+
+            //! Type of the array containing per partition the communicator for sending material
+            using MaterialCommunicators =
+                detail::CommunicatorArray<detail::MaterialCommunicator<MaterialElement, 2>, 2>;
+
+            //! Per partition, a future that becomes ready once routing has finished in it
+            using Routed = Array<hpx::shared_future<void>, 2>;
+
+
+            FlowNetwork(
+                FlowDirection&& flow_direction,
+                InflowCount&& inflow_count,
+                IntraPartitionOrder&& intra_partition_order,
+                IntraPartitionLevels&& intra_partition_levels,
+                NeighbourCellsIdxsFs&& input_cells_idxs,
+                NeighbourCellsIdxsFs&& output_cells_idxs,
+                MaterialCommunicators&& material_communicators):
+
+                _flow_direction{std::move(flow_direction)},
+                _inflow_count{std::move(inflow_count)},
+                _intra_partition_order{std::move(intra_partition_order)},
+                _intra_partition_levels{std::move(intra_partition_levels)},
+                _input_cells_idxs{std::move(input_cells_idxs)},
+                _output_cells_idxs{std::move(output_cells_idxs)},
+                _material_communicators{std::move(material_communicators)},
+                _routed_mutex{std::make_unique<hpx::mutex>()},
+                _routed{_flow_direction.partitions().shape()}
+
+            {
+                std::fill(_routed.begin(), _routed.end(), hpx::make_ready_future().share());
+            }
+
+
+            FlowNetwork(FlowNetwork const&) = delete;
+
+            FlowNetwork(FlowNetwork&&) = default;
+
+
+            ~FlowNetwork()
+            {
+                if (!_routed.empty())
+                {
+                    // Free up AGAS resources, once all routing operations using the channels have
+                    // finished
+                    hpx::when_all(_routed.begin(), _routed.end())
+                        .then(
+                            [material_communicators = std::move(_material_communicators)](
+                                [[maybe_unused]] auto&& routed) mutable
+                            { material_communicators.unregister().wait(); });
+                }
+            }
+
+
+            auto operator=(FlowNetwork const&) -> FlowNetwork& = delete;
+
+            auto operator=(FlowNetwork&&) -> FlowNetwork& = delete;
+
+
+            //! Return the flow directions
+            auto flow_direction() const -> FlowDirection const&
+            {
+                return _flow_direction;
+            }
+
+
+            //! Return per cell the number of cells draining into it
+            auto inflow_count() const -> InflowCount const&
+            {
+                return _inflow_count;
+            }
+
+
+            /*!
+                @brief      Return per partition the order in which to visit the cells that don't
+                            depend on material from neighbouring partitions
+            */
+            auto intra_partition_order() const -> IntraPartitionOrder const&
+            {
+                return _intra_partition_order;
+            }
+
+
+            /*!
+                @brief      Return per partition the offsets in the intra-partition order of the
+                            levels of cells that can be visited concurrently
+            */
+            auto intra_partition_levels() const -> IntraPartitionLevels const&
+            {
+                return _intra_partition_levels;
+            }
+
+
+            //! Return per partition, per neighbouring partition, the cells receiving material from it
+            auto input_cells_idxs() const -> NeighbourCellsIdxsFs const&
+            {
+                return _input_cells_idxs;
+            }
+
+
+            //! Return per partition, per neighbouring partition, the cells sending material to it
+            auto output_cells_idxs() const -> NeighbourCellsIdxsFs const&
+            {
+                return _output_cells_idxs;
+            }
+
+
+            //! Return per partition the communicator for sending material
+            auto material_communicators() const -> MaterialCommunicators const&
+            {
+                return _material_communicators;
+            }
+
+
+            /*!
+                @brief      Start a routing operation using the network
+                @param      start Function which, passed per partition a future that becomes ready
+                            once the previous routing operation using the network has finished in
+                            the partition and its neighbours, starts the routing operation and
+                            returns per partition a future that becomes ready once it has finished
+                            in it
+
+                Routing operations are started one at a time: obtaining the dependencies on the
+                previous routing operation and storing the futures of the current one happen
+                while holding a lock.
+            */
+            template<typename Start>
+            void route(Start&& start) const
+            {
+                std::lock_guard<hpx::mutex> lock{*_routed_mutex};
+
+                Routed routed{std::forward<Start>(start)(routing_dependencies())};
+
+                lue_hpx_assert(routed.shape() == _routed.shape());
+
+                _routed = std::move(routed);
+            }
+
+
+        private:
+
+            /*!
+                @brief      Return per partition a future that becomes ready once the previous
+                            routing operation using the network has finished in the partition and
+                            its neighbours
+            */
+            auto routing_dependencies() const -> Routed
+            {
+                auto const [extent0, extent1] = _routed.shape();
+                Routed dependencies{_routed.shape()};
+
+                for (Index idx0 = 0; idx0 < extent0; ++idx0)
+                {
+                    for (Index idx1 = 0; idx1 < extent1; ++idx1)
+                    {
+                        std::vector<hpx::shared_future<void>> neighbourhood{};
+                        neighbourhood.reserve(detail::nr_neighbours<2>() + 1);
+
+                        for (Index offset0 = -1; offset0 <= 1; ++offset0)
+                        {
+                            for (Index offset1 = -1; offset1 <= 1; ++offset1)
+                            {
+                                Index const neighbour_idx0{idx0 + offset0};
+                                Index const neighbour_idx1{idx1 + offset1};
+
+                                if (neighbour_idx0 >= 0 && neighbour_idx0 < extent0 && neighbour_idx1 >= 0 &&
+                                    neighbour_idx1 < extent1)
+                                {
+                                    neighbourhood.push_back(_routed(neighbour_idx0, neighbour_idx1));
+                                }
+                            }
+                        }
+
+                        dependencies(idx0, idx1) =
+                            hpx::when_all(std::move(neighbourhood))
+                                .then([]([[maybe_unused]] auto&& neighbourhood) {})
+                                .share();
+                    }
+                }
+
+                return dependencies;
+            }
+
+
+            FlowDirection _flow_direction;
+
+            InflowCount _inflow_count;
+
+            IntraPartitionOrder _intra_partition_order;
+
+            IntraPartitionLevels _intra_partition_levels;
+
+            NeighbourCellsIdxsFs _input_cells_idxs;
+
+            NeighbourCellsIdxsFs _output_cells_idxs;
+
+            MaterialCommunicators _material_communicators;
+
+            //! Serializes the routing operations using the network
+            std::unique_ptr<hpx::mutex> _routed_mutex;
+
+            //! Updated by each routing operation using the network, guarded by _routed_mutex
+            mutable Routed _routed;
+    };
+
+
+    /*!
+        @brief      Determine the flow network defined by @a flow_direction, for routing material
+                    of type @a MaterialElement
+    */
+    template<typename MaterialElement, typename Policies, typename FlowDirectionElement>
+    auto flow_network(
+        Policies const& policies, PartitionedArray<FlowDirectionElement, 2> const& flow_direction)
+        -> FlowNetwork<FlowDirectionElement, MaterialElement>;
+
+}  // namespace lue
@@ -11,6 +11,10 @@ namespace lue {
     using AggregatorT = typename Functor::Aggregator;
 
 
+    template<typename Functor>
+    using LabelAggregatorT = typename Functor::LabelAggregator;
+
+
     template<class SomeType>
     class FunctorTraits
     {
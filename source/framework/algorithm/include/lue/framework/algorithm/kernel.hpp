@@ -1,5 +1,11 @@
 #pragma once
 #include "lue/framework/core/array.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <type_traits>
+#include <vector>
 
 
 namespace lue {
@@ -179,6 +185,196 @@ namespace lue {
     }
 
 
+    /*!
+        @brief      Return whether all weights in @a kernel are non-zero
+
+        Focal operations using such a kernel consider all cells in the square neighbourhood.
+    */
+    template<typename Weight, Rank rank>
+    auto is_box_kernel(Kernel<Weight, rank> const& kernel) -> bool
+    {
+        return std::all_of(kernel.begin(), kernel.end(), [](Weight const weight) -> bool { return weight; });
+    }
+
+
+    /*!
+        @brief      Return whether all weights in @a kernel are zero or one
+
+        Such kernels only select the cells in the neighbourhood to consider. Box kernels with a weight
+        of one are an example.
+    */
+    template<typename Weight, Rank rank>
+    auto is_unweighted_kernel(Kernel<Weight, rank> const& kernel) -> bool
+    {
+        return std::all_of(
+            kernel.begin(),
+            kernel.end(),
+            [](Weight const weight) -> bool { return weight == Weight{0} || weight == Weight{1}; });
+    }
+
+
+    /*!
+        @brief      Factors of a separable two-dimensional kernel
+
+        The kernel's weight at (idx0, idx1) equals `weights0[idx0] * weights1[idx1]`. Focal operations
+        can use this to first aggregate along the rows, using @a weights1, and then aggregate the
+        results along the columns, using @a weights0.
+    */
+    template<typename Weight>
+    class KernelFactors
+    {
+
+        public:
+
+            std::vector<Weight> weights0;
+
+            std::vector<Weight> weights1;
+    };
+
+
+    /*!
+        @brief      Return the factors of @a kernel, if it is separable
+
+        A kernel is separable if its weights are the outer product of a column and a row of weights,
+        like box kernels and Gaussian kernels. For integral weights the product must match exactly.
+        For floating point weights, differences due to rounding are accepted.
+    */
+    template<typename Weight>
+    auto kernel_factors(Kernel<Weight, 2> const& kernel) -> std::optional<KernelFactors<Weight>>
+    {
+        Count const size{kernel.size()};
+
+        auto const magnitude = [](Weight const weight) -> Weight
+        {
+            if constexpr (std::is_signed_v<Weight>)
+            {
+                return weight < 0 ? -weight : weight;
+            }
+            else
+            {
+                return weight;
+            }
+        };
+
+        // Use the weight with the largest magnitude as pivot, to limit rounding errors
+        Index pivot_idx0{0};
+        Index pivot_idx1{0};
+
+        for (Index idx0 = 0; idx0 < size; ++idx0)
+        {
+            for (Index idx1 = 0; idx1 < size; ++idx1)
+            {
+                if (magnitude(kernel(idx0, idx1)) > magnitude(kernel(pivot_idx0, pivot_idx1)))
+                {
+                    pivot_idx0 = idx0;
+                    pivot_idx1 = idx1;
+                }
+            }
+        }
+
+        Weight const pivot{kernel(pivot_idx0, pivot_idx1)};
+
+        if (pivot == Weight{0})
+        {
+            return std::nullopt;
+        }
+
+        KernelFactors<Weight> factors{std::vector<Weight>(size), std::vector<Weight>(size)};
+
+        for (Index idx = 0; idx < size; ++idx)
+        {
+            factors.weights0[idx] = kernel(idx, pivot_idx1);
+            factors.weights1[idx] = static_cast<Weight>(kernel(pivot_idx0, idx) / pivot);
+        }
+
+        for (Index idx0 = 0; idx0 < size; ++idx0)
+        {
+            for (Index idx1 = 0; idx1 < size; ++idx1)
+            {
+                Weight const weight{kernel(idx0, idx1)};
+                Weight const product{static_cast<Weight>(factors.weights0[idx0] * factors.weights1[idx1])};
+
+                if constexpr (std::is_floating_point_v<Weight>)
+                {
+                    if (std::abs(weight - product) >
+                        4 * std::numeric_limits<Weight>::epsilon() * magnitude(pivot))
+                    {
+                        return std::nullopt;
+                    }
+                }
+                else
+                {
+                    if (weight != product)
+                    {
+                        return std::nullopt;
+                    }
+                }
+            }
+        }
+
+        return factors;
+    }
+
+
+    /*!
+        @brief      Run of consecutive non-zero weights within a row of a two-dimensional kernel
+
+        The weight of the cell at (idx0, idx1 + idx) equals `weights[idx]`.
+    */
+    template<typename Weight>
+    class KernelRun
+    {
+
+        public:
+
+            //! Index of the row containing the run
+            Index idx0;
+
+            //! Index of the column containing the first weight of the run
+            Index idx1;
+
+            std::vector<Weight> weights;
+    };
+
+
+    /*!
+        @brief      Return the non-zero weights of @a kernel, as runs of consecutive weights per row
+
+        Focal operations can use these to only visit the cells within a neighbourhood whose weight
+        is non-zero, like those within a circle or an annulus. Runs are ordered by row and, within
+        a row, by column, so the values visited are laid out contiguously in memory.
+    */
+    template<typename Weight>
+    auto kernel_runs(Kernel<Weight, 2> const& kernel) -> std::vector<KernelRun<Weight>>
+    {
+        Count const size{kernel.size()};
+        std::vector<KernelRun<Weight>> runs{};
+
+        for (Index idx0 = 0; idx0 < size; ++idx0)
+        {
+            for (Index idx1 = 0; idx1 < size;)
+            {
+                if (kernel(idx0, idx1) == Weight{0})
+                {
+                    ++idx1;
+                    continue;
+                }
+
+                KernelRun<Weight> run{idx0, idx1, {}};
+
+                for (; idx1 < size && kernel(idx0, idx1) != Weight{0}; ++idx1)
+                {
+                    run.weights.push_back(kernel(idx0, idx1));
+                }
+
+                runs.push_back(std::move(run));
+            }
+        }
+
+        return runs;
+    }
+
+
     namespace detail {
 
         template<typename E, Rank r>
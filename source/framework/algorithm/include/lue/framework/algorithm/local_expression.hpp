@@ -0,0 +1,439 @@
+#pragma once
+#include "lue/framework/algorithm/abs.hpp"
+#include "lue/framework/algorithm/add.hpp"
+#include "lue/framework/algorithm/divide.hpp"
+#include "lue/framework/algorithm/exp.hpp"
+#include "lue/framework/algorithm/functor_traits.hpp"
+#include "lue/framework/algorithm/log.hpp"
+#include "lue/framework/algorithm/multiply.hpp"
+#include "lue/framework/algorithm/negate.hpp"
+#include "lue/framework/algorithm/policy/all_values_within_domain.hpp"
+#include "lue/framework/algorithm/sqrt.hpp"
+#include "lue/framework/algorithm/subtract.hpp"
+#include "lue/framework/partitioned_array_decl.hpp"
+#include <hpx/serialization/tuple.hpp>
+#include <tuple>
+
+
+/*!
+    @file
+
+    Deferred evaluation of chains of local operations
+
+    Each local operation (add, sqrt, ...) creates a new partitioned array, and spawns a task per
+    partition which reads its inputs and writes its output once. For a chain of such operations, like
+    `sqrt(a * a + b * b) / c`, this results in a temporary array per intermediate result, and in
+    repeated passes over memory.
+
+    The types in this file allow such a chain to be described first, and evaluated afterwards, in a
+    single task per partition and a single pass over the elements:
+
+    @code
+    using namespace lue::local_expression;
+
+    auto const a_ = deferred(a);
+    auto const b_ = deferred(b);
+
+    PartitionedArray<double, 2> const result = evaluate(sqrt(a_ * a_ + b_ * b_) / deferred(c));
+    @endcode
+
+    Expressions are built from nodes. Argument nodes refer to an element of one of the input arrays,
+    Constant nodes to a scalar value, and Operation nodes combine the values of their operands using one of
+    the existing local operation functors.
+*/
+namespace lue::local_expression {
+
+    /*!
+        @brief      Node representing an element of the @a idx -th input array
+    */
+    template<Index idx, typename Element>
+    class Argument
+    {
+
+        public:
+
+            using OutputElement = Element;
+
+
+            template<typename Values>
+            auto operator()(Values const& values, [[maybe_unused]] bool& within_domain) const -> OutputElement
+            {
+                return std::get<idx>(values);
+            }
+
+        private:
+
+            friend class hpx::serialization::access;
+
+
+            template<typename Archive>
+            void serialize([[maybe_unused]] Archive& archive, [[maybe_unused]] unsigned int const version)
+            {
+            }
+    };
+
+
+    /*!
+        @brief      Node representing a constant value
+    */
+    template<typename Element>
+    class Constant
+    {
+
+        public:
+
+            using OutputElement = Element;
+
+
+            Constant():
+
+                _value{}
+
+            {
+            }
+
+
+            explicit Constant(Element const value):
+
+                _value{value}
+
+            {
+            }
+
+
+            template<typename Values>
+            auto operator()(
+                [[maybe_unused]] Values const& values, [[maybe_unused]] bool& within_domain) const
+                -> OutputElement
+            {
+                return _value;
+            }
+
+        private:
+
+            friend class hpx::serialization::access;
+
+
+            template<typename Archive>
+            void serialize(Archive& archive, [[maybe_unused]] unsigned int const version)
+            {
+                // clang-format off
+                archive & _value;
+                // clang-format on
+            }
+
+
+            Element _value;
+    };
+
+
+    /*!
+        @brief      Node representing the application of @a Functor to the values of @a Operand nodes
+        @tparam     DomainPolicy Policy for checking whether the operand values are within the
+                    domain of @a Functor
+
+        The functor is only called when all operand values are valid and within its domain. Otherwise
+        the @a within_domain flag passed in is cleared, and the result must be marked as no-data.
+    */
+    template<typename Functor, typename DomainPolicy, typename... Operand>
+    class Operation
+    {
+
+        public:
+
+            using OutputElement = OutputElementT<Functor>;
+
+
+            Operation() = default;
+
+
+            explicit Operation(Operand const&... operand):
+
+                _operands{operand...}
+
+            {
+            }
+
+
+            template<typename Values>
+            auto operator()(Values const& values, bool& within_domain) const -> OutputElement
+            {
+                return std::apply(
+                    [&values, &within_domain](Operand const&... operand) -> OutputElement
+                    {
+                        return apply_functor(within_domain, operand(values, within_domain)...);
+                    },
+                    _operands);
+            }
+
+
+            auto operands() const -> std::tuple<Operand...> const&
+            {
+                return _operands;
+            }
+
+        private:
+
+            template<typename... OperandValue>
+            static auto apply_functor(bool& within_domain, OperandValue const... operand_value)
+                -> OutputElement
+            {
+                if (!within_domain || !DomainPolicy::within_domain(operand_value...))
+                {
+                    within_domain = false;
+
+                    return OutputElement{};
+                }
+
+                return Functor{}(operand_value...);
+            }
+
+
+            friend class hpx::serialization::access;
+
+
+            template<typename Archive>
+            void serialize(Archive& archive, [[maybe_unused]] unsigned int const version)
+            {
+                // clang-format off
+                archive & _operands;
+                // clang-format on
+            }
+
+
+            std::tuple<Operand...> _operands;
+    };
+
+
+    /*!
+        @brief      Return a copy of @a node with argument indices increased by @a offset
+
+        This is used when combining two expressions. The arguments of the second expression follow
+        the ones of the first expression.
+    */
+    template<Index offset, Index idx, typename Element>
+    auto shift([[maybe_unused]] Argument<idx, Element> const& node) -> Argument<idx + offset, Element>
+    {
+        return {};
+    }
+
+
+    template<Index offset, typename Element>
+    auto shift(Constant<Element> const& node) -> Constant<Element>
+    {
+        return node;
+    }
+
+
+    template<Index offset, typename Functor, typename DomainPolicy, typename... Operand>
+    auto shift(Operation<Functor, DomainPolicy, Operand...> const& node)
+    {
+        return std::apply(
+            [](Operand const&... operand)
+            {
+                return Operation<Functor, DomainPolicy, decltype(shift<offset>(operand))...>{
+                    shift<offset>(operand)...};
+            },
+            node.operands());
+    }
+
+
+    /*!
+        @brief      Expression which can be evaluated into a partitioned array
+        @tparam     Node Type of the root node of the expression
+        @tparam     Element Types of the elements of the input arrays, in argument order
+
+        An expression refers to the input arrays, which must outlive the expression. These all must
+        have the same shape and partitioning.
+    */
+    template<typename Node, Rank rank, typename... Element>
+    class Expression
+    {
+
+        public:
+
+            using OutputElement = OutputElementT<Node>;
+
+            using Arrays = std::tuple<PartitionedArray<Element, rank> const&...>;
+
+
+            Expression(Node const& node, Arrays const& arrays):
+
+                _node{node},
+                _arrays{arrays}
+
+            {
+            }
+
+
+            auto node() const -> Node const&
+            {
+                return _node;
+            }
+
+
+            auto arrays() const -> Arrays const&
+            {
+                return _arrays;
+            }
+
+        private:
+
+            Node _node;
+
+            Arrays _arrays;
+    };
+
+
+    /*!
+        @brief      Create an expression representing the elements of @a array
+    */
+    template<typename Element, Rank rank>
+    auto deferred(PartitionedArray<Element, rank> const& array)
+        -> Expression<Argument<0, Element>, rank, Element>
+    {
+        using Result = Expression<Argument<0, Element>, rank, Element>;
+
+        return Result{Argument<0, Element>{}, typename Result::Arrays{array}};
+    }
+
+
+    template<typename Element, Rank rank>
+    void deferred(PartitionedArray<Element, rank>&& array) = delete;
+
+
+    namespace detail {
+
+        template<typename Element>
+        using BinaryAllValuesWithinDomain = policy::AllValuesWithinDomain<Element, Element>;
+
+
+        template<typename Functor, typename DomainPolicy, typename Node, Rank rank, typename... Element>
+        auto combine(Expression<Node, rank, Element...> const& expression)
+        {
+            using Result = Operation<Functor, DomainPolicy, Node>;
+
+            return Expression<Result, rank, Element...>{Result{expression.node()}, expression.arrays()};
+        }
+
+
+        template<
+            typename Functor,
+            typename DomainPolicy,
+            typename Node1,
+            typename Node2,
+            Rank rank,
+            typename... Element1,
+            typename... Element2>
+        auto combine(
+            Expression<Node1, rank, Element1...> const& expression1,
+            Expression<Node2, rank, Element2...> const& expression2)
+        {
+            auto const node2{shift<sizeof...(Element1)>(expression2.node())};
+
+            using Result = Operation<Functor, DomainPolicy, Node1, std::remove_const_t<decltype(node2)>>;
+
+            return Expression<Result, rank, Element1..., Element2...>{
+                Result{expression1.node(), node2},
+                std::tuple_cat(expression1.arrays(), expression2.arrays())};
+        }
+
+
+        template<typename Functor, typename DomainPolicy, typename Node, Rank rank, typename... Element>
+        auto combine(Expression<Node, rank, Element...> const& expression, OutputElementT<Node> const value)
+        {
+            using Result = Operation<Functor, DomainPolicy, Node, Constant<OutputElementT<Node>>>;
+
+            return Expression<Result, rank, Element...>{
+                Result{expression.node(), Constant<OutputElementT<Node>>{value}}, expression.arrays()};
+        }
+
+
+        template<typename Functor, typename DomainPolicy, typename Node, Rank rank, typename... Element>
+        auto combine(OutputElementT<Node> const value, Expression<Node, rank, Element...> const& expression)
+        {
+            using Result = Operation<Functor, DomainPolicy, Constant<OutputElementT<Node>>, Node>;
+
+            return Expression<Result, rank, Element...>{
+                Result{Constant<OutputElementT<Node>>{value}, expression.node()}, expression.arrays()};
+        }
+
+    }  // namespace detail
+
+
+#define LUE_LOCAL_EXPRESSION_BINARY_OPERATOR(op, Functor, DomainPolicy)                                      \
+                                                                                                             \
+    template<typename Node1, typename Node2, Rank rank, typename... Element1, typename... Element2>          \
+    auto operator op(                                                                                        \
+        Expression<Node1, rank, Element1...> const& expression1,                                             \
+        Expression<Node2, rank, Element2...> const& expression2)                                             \
+    {                                                                                                        \
+        using Element_ = OutputElementT<Node1>;                                                              \
+                                                                                                             \
+        return detail::combine<Functor<Element_>, DomainPolicy<Element_>>(expression1, expression2);         \
+    }                                                                                                        \
+                                                                                                             \
+                                                                                                             \
+    template<typename Node, Rank rank, typename... Element>                                                  \
+    auto operator op(                                                                                        \
+        Expression<Node, rank, Element...> const& expression, OutputElementT<Node> const value)              \
+    {                                                                                                        \
+        using Element_ = OutputElementT<Node>;                                                               \
+                                                                                                             \
+        return detail::combine<Functor<Element_>, DomainPolicy<Element_>>(expression, value);                \
+    }                                                                                                        \
+                                                                                                             \
+                                                                                                             \
+    template<typename Node, Rank rank, typename... Element>                                                  \
+    auto operator op(                                                                                        \
+        OutputElementT<Node> const value, Expression<Node, rank, Element...> const& expression)              \
+    {                                                                                                        \
+        using Element_ = OutputElementT<Node>;                                                               \
+                                                                                                             \
+        return detail::combine<Functor<Element_>, DomainPolicy<Element_>>(value, expression);                \
+    }
+
+
+#define LUE_LOCAL_EXPRESSION_UNARY_FUNCTION(name, Functor, DomainPolicy)                                     \
+                                                                                                             \
+    template<typename Node, Rank rank, typename... Element>                                                  \
+    auto name(Expression<Node, rank, Element...> const& expression)                                          \
+    {                                                                                                        \
+        using Element_ = OutputElementT<Node>;                                                               \
+                                                                                                             \
+        return detail::combine<Functor<Element_>, DomainPolicy<Element_>>(expression);                       \
+    }
+
+
+    LUE_LOCAL_EXPRESSION_BINARY_OPERATOR(+, lue::detail::Add, detail::BinaryAllValuesWithinDomain)
+    LUE_LOCAL_EXPRESSION_BINARY_OPERATOR(-, lue::detail::Subtract, detail::BinaryAllValuesWithinDomain)
+    LUE_LOCAL_EXPRESSION_BINARY_OPERATOR(*, lue::detail::Multiply, detail::BinaryAllValuesWithinDomain)
+    LUE_LOCAL_EXPRESSION_BINARY_OPERATOR(/, lue::detail::Divide, policy::divide::DomainPolicy)
+
+    LUE_LOCAL_EXPRESSION_UNARY_FUNCTION(operator-, lue::detail::Negate, policy::AllValuesWithinDomain)
+    LUE_LOCAL_EXPRESSION_UNARY_FUNCTION(abs, lue::detail::Abs, policy::AllValuesWithinDomain)
+    LUE_LOCAL_EXPRESSION_UNARY_FUNCTION(exp, lue::detail::Exp, policy::AllValuesWithinDomain)
+    LUE_LOCAL_EXPRESSION_UNARY_FUNCTION(log, lue::detail::Log, policy::log::DomainPolicy)
+    LUE_LOCAL_EXPRESSION_UNARY_FUNCTION(sqrt, lue::detail::Sqrt, policy::sqrt::DomainPolicy)
+
+#undef LUE_LOCAL_EXPRESSION_UNARY_FUNCTION
+#undef LUE_LOCAL_EXPRESSION_BINARY_OPERATOR
+
+
+    /*!
+        @brief      Evaluate @a expression
+        @return     New partitioned array containing the result of evaluating the expression for each
+                    element of the input arrays
+        @exception  std::runtime_error In case the input arrays are not compatible
+
+        The expression is evaluated in a single task per partition. No-data is handled like the value
+        policies do: the result is no-data when any of the input elements is no-data, or when any of
+        the intermediate values is outside of the domain of the operation applied to it.
+
+        Contrary to the value policies, intermediate results are not checked for being within range.
+    */
+    template<typename Node, Rank rank, typename... Element>
+    auto evaluate(Expression<Node, rank, Element...> const& expression)
+        -> PartitionedArray<OutputElementT<Node>, rank>;
+
+}  // namespace lue::local_expression
@@ -23,4 +23,14 @@ namespace lue::policy {
             }
     };
 
+
+    /*!
+        @brief      Whether @a Policy is a domain policy which does not check anything
+    */
+    template<typename Policy>
+    inline constexpr bool is_all_values_within_domain_v = false;
+
+    template<typename... Element>
+    inline constexpr bool is_all_values_within_domain_v<AllValuesWithinDomain<Element...>> = true;
+
 }  // namespace lue::policy
@@ -31,6 +31,17 @@ namespace lue::policy {
     };
 
 
+    /*!
+        @brief      Whether @a Policy is a range policy which does not check anything
+    */
+    template<typename Policy>
+    inline constexpr bool is_all_values_within_range_v = false;
+
+    template<typename OutputElement, typename... InputElement>
+    inline constexpr bool is_all_values_within_range_v<AllValuesWithinRange<OutputElement, InputElement...>> =
+        true;
+
+
     namespace detail {
 
         template<typename OutputElement, typename... InputElement>
@@ -1,4 +1,6 @@
 #pragma once
+#include <cstddef>
+#include <utility>
 
 
 namespace lue {
@@ -10,6 +12,50 @@ namespace lue {
             {
             };
 
+
+            template<typename T, typename Idxs>
+            class RepeatedTypeListHelper;
+
+
+            template<typename T, std::size_t... idxs>
+            class RepeatedTypeListHelper<T, std::index_sequence<idxs...>>
+            {
+
+                private:
+
+                    template<std::size_t>
+                    using Repeat = T;
+
+                public:
+
+                    using type = TypeList<Repeat<idxs>...>;
+            };
+
+
+            //! Type list containing @a count times type @a T
+            template<typename T, std::size_t count>
+            using RepeatedTypeList =
+                typename RepeatedTypeListHelper<T, std::make_index_sequence<count>>::type;
+
+
+            template<typename TypeList1, typename TypeList2>
+            class ConcatenatedTypeListHelper;
+
+
+            template<typename... T1, typename... T2>
+            class ConcatenatedTypeListHelper<TypeList<T1...>, TypeList<T2...>>
+            {
+
+                public:
+
+                    using type = TypeList<T1..., T2...>;
+            };
+
+
+            //! Type list containing the types of @a TypeList1, followed by those of @a TypeList2
+            template<typename TypeList1, typename TypeList2>
+            using ConcatenatedTypeList = typename ConcatenatedTypeListHelper<TypeList1, TypeList2>::type;
+
         }  // namespace detail
     }  // namespace policy
 }  // namespace lue
@@ -1,5 +1,6 @@
 #pragma once
 #include "lue/framework/algorithm/accu.hpp"
+#include <array>
 #include <concepts>
 
 
@@ -54,5 +55,62 @@ namespace lue {
             return accu(Policies{}, flow_direction, inflow);
         }
 
+
+        template<std::integral FlowDirectionElement, std::floating_point FloatingPointElement>
+        auto accu(
+            FlowNetwork<FlowDirectionElement, FloatingPointElement> const& flow_network,
+            PartitionedArray<FloatingPointElement, 2> const& inflow)
+            -> PartitionedArray<FloatingPointElement, 2>
+        {
+            using Policies =
+                lue::policy::accu::DefaultValuePolicies<FlowDirectionElement, FloatingPointElement>;
+
+            return accu(Policies{}, flow_network, inflow);
+        }
+
+
+        template<std::integral FlowDirectionElement, std::floating_point FloatingPointElement>
+        auto accu(
+            FlowNetwork<FlowDirectionElement, FloatingPointElement> const& flow_network,
+            Scalar<FloatingPointElement> const& inflow) -> PartitionedArray<FloatingPointElement, 2>
+        {
+            using Policies =
+                lue::policy::accu::DefaultValuePolicies<FlowDirectionElement, FloatingPointElement>;
+
+            return accu(Policies{}, flow_network, inflow);
+        }
+
+
+        template<
+            std::integral FlowDirectionElement,
+            std::floating_point FloatingPointElement,
+            std::size_t nr_layers>
+        auto accu(
+            PartitionedArray<FlowDirectionElement, 2> const& flow_direction,
+            std::array<PartitionedArray<FloatingPointElement, 2>, nr_layers> const& inflow)
+            -> std::array<PartitionedArray<FloatingPointElement, 2>, nr_layers>
+        {
+            using Policies =
+                lue::policy::accu::DefaultValuePolicies<FlowDirectionElement, FloatingPointElement>;
+
+            return accu(Policies{}, flow_direction, inflow);
+        }
+
+
+        template<
+            std::integral FlowDirectionElement,
+            std::floating_point FloatingPointElement,
+            std::size_t nr_layers>
+        auto accu(
+            FlowNetwork<FlowDirectionElement, FloatingPointElement> const& flow_network,
+            std::array<PartitionedArray<FloatingPointElement, 2>, nr_layers> const& inflow)
+            -> std::array<PartitionedArray<FloatingPointElement, 2>, nr_layers>
+        {
+            using Policies =
+                lue::policy::accu::DefaultValuePolicies<FlowDirectionElement, FloatingPointElement>;
+
+            return accu(Policies{}, flow_network, inflow);
+        }
+
     }  // namespace value_policies
 }  // namespace lue
@@ -86,5 +86,61 @@ namespace lue {
             return accu_capacity(Policies{}, flow_direction, inflow, capacity);
         }
 
+
+        template<std::integral FlowDirectionElement, std::floating_point FloatingPointElement>
+        auto accu_capacity(
+            FlowNetwork<FlowDirectionElement, FloatingPointElement> const& flow_network,
+            PartitionedArray<FloatingPointElement, 2> const& inflow,
+            PartitionedArray<FloatingPointElement, 2> const& capacity) -> std::
+            tuple<PartitionedArray<FloatingPointElement, 2>, PartitionedArray<FloatingPointElement, 2>>
+        {
+            using Policies =
+                policy::accu_capacity::DefaultValuePolicies<FlowDirectionElement, FloatingPointElement>;
+
+            return accu_capacity(Policies{}, flow_network, inflow, capacity);
+        }
+
+
+        template<std::integral FlowDirectionElement, std::floating_point FloatingPointElement>
+        auto accu_capacity(
+            FlowNetwork<FlowDirectionElement, FloatingPointElement> const& flow_network,
+            PartitionedArray<FloatingPointElement, 2> const& inflow,
+            Scalar<FloatingPointElement> const& capacity) -> std::
+            tuple<PartitionedArray<FloatingPointElement, 2>, PartitionedArray<FloatingPointElement, 2>>
+        {
+            using Policies =
+                policy::accu_capacity::DefaultValuePolicies<FlowDirectionElement, FloatingPointElement>;
+
+            return accu_capacity(Policies{}, flow_network, inflow, capacity);
+        }
+
+
+        template<std::integral FlowDirectionElement, std::floating_point FloatingPointElement>
+        auto accu_capacity(
+            FlowNetwork<FlowDirectionElement, FloatingPointElement> const& flow_network,
+            Scalar<FloatingPointElement> const& inflow,
+            Scalar<FloatingPointElement> const& capacity) -> std::
+            tuple<PartitionedArray<FloatingPointElement, 2>, PartitionedArray<FloatingPointElement, 2>>
+        {
+            using Policies =
+                policy::accu_capacity::DefaultValuePolicies<FlowDirectionElement, FloatingPointElement>;
+
+            return accu_capacity(Policies{}, flow_network, inflow, capacity);
+        }
+
+
+        template<std::integral FlowDirectionElement, std::floating_point FloatingPointElement>
+        auto accu_capacity(
+            FlowNetwork<FlowDirectionElement, FloatingPointElement> const& flow_network,
+            Scalar<FloatingPointElement> const& inflow,
+            PartitionedArray<FloatingPointElement, 2> const& capacity) -> std::
+            tuple<PartitionedArray<FloatingPointElement, 2>, PartitionedArray<FloatingPointElement, 2>>
+        {
+            using Policies =
+                policy::accu_capacity::DefaultValuePolicies<FlowDirectionElement, FloatingPointElement>;
+
+            return accu_capacity(Policies{}, flow_network, inflow, capacity);
+        }
+
     }  // namespace value_policies
 }  // namespace lue
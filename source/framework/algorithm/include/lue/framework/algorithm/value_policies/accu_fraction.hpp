@@ -1,5 +1,6 @@
 #pragma once
 #include "lue/framework/algorithm/accu_fraction.hpp"
+#include <array>
 #include <concepts>
 
 
@@ -86,5 +87,99 @@ namespace lue {
             return accu_fraction(Policies{}, flow_direction, inflow, fraction);
         }
 
+
+        template<std::integral FlowDirectionElement, std::floating_point FloatingPointElement>
+        auto accu_fraction(
+            FlowNetwork<FlowDirectionElement, FloatingPointElement> const& flow_network,
+            PartitionedArray<FloatingPointElement, 2> const& inflow,
+            PartitionedArray<FloatingPointElement, 2> const& fraction) -> std::
+            tuple<PartitionedArray<FloatingPointElement, 2>, PartitionedArray<FloatingPointElement, 2>>
+        {
+            using Policies =
+                policy::accu_fraction::DefaultValuePolicies<FlowDirectionElement, FloatingPointElement>;
+
+            return accu_fraction(Policies{}, flow_network, inflow, fraction);
+        }
+
+
+        template<std::integral FlowDirectionElement, std::floating_point FloatingPointElement>
+        auto accu_fraction(
+            FlowNetwork<FlowDirectionElement, FloatingPointElement> const& flow_network,
+            PartitionedArray<FloatingPointElement, 2> const& inflow,
+            Scalar<FloatingPointElement> const& fraction) -> std::
+            tuple<PartitionedArray<FloatingPointElement, 2>, PartitionedArray<FloatingPointElement, 2>>
+        {
+            using Policies =
+                policy::accu_fraction::DefaultValuePolicies<FlowDirectionElement, FloatingPointElement>;
+
+            return accu_fraction(Policies{}, flow_network, inflow, fraction);
+        }
+
+
+        template<std::integral FlowDirectionElement, std::floating_point FloatingPointElement>
+        auto accu_fraction(
+            FlowNetwork<FlowDirectionElement, FloatingPointElement> const& flow_network,
+            Scalar<FloatingPointElement> const& inflow,
+            Scalar<FloatingPointElement> const& fraction) -> std::
+            tuple<PartitionedArray<FloatingPointElement, 2>, PartitionedArray<FloatingPointElement, 2>>
+        {
+            using Policies =
+                policy::accu_fraction::DefaultValuePolicies<FlowDirectionElement, FloatingPointElement>;
+
+            return accu_fraction(Policies{}, flow_network, inflow, fraction);
+        }
+
+
+        template<std::integral FlowDirectionElement, std::floating_point FloatingPointElement>
+        auto accu_fraction(
+            FlowNetwork<FlowDirectionElement, FloatingPointElement> const& flow_network,
+            Scalar<FloatingPointElement> const& inflow,
+            PartitionedArray<FloatingPointElement, 2> const& fraction) -> std::
+            tuple<PartitionedArray<FloatingPointElement, 2>, PartitionedArray<FloatingPointElement, 2>>
+        {
+            using Policies =
+                policy::accu_fraction::DefaultValuePolicies<FlowDirectionElement, FloatingPointElement>;
+
+            return accu_fraction(Policies{}, flow_network, inflow, fraction);
+        }
+
+
+        template<
+            std::integral FlowDirectionElement,
+            std::floating_point FloatingPointElement,
+            std::size_t nr_layers>
+        auto accu_fraction(
+            PartitionedArray<FlowDirectionElement, 2> const& flow_direction,
+            std::array<PartitionedArray<FloatingPointElement, 2>, nr_layers> const& inflow,
+            PartitionedArray<FloatingPointElement, 2> const& fraction)
+            -> std::tuple<
+                std::array<PartitionedArray<FloatingPointElement, 2>, nr_layers>,
+                std::array<PartitionedArray<FloatingPointElement, 2>, nr_layers>>
+        {
+            using Policies =
+                policy::accu_fraction::DefaultValuePolicies<FlowDirectionElement, FloatingPointElement>;
+
+            return accu_fraction(Policies{}, flow_direction, inflow, fraction);
+        }
+
+
+        template<
+            std::integral FlowDirectionElement,
+            std::floating_point FloatingPointElement,
+            std::size_t nr_layers>
+        auto accu_fraction(
+            FlowNetwork<FlowDirectionElement, FloatingPointElement> const& flow_network,
+            std::array<PartitionedArray<FloatingPointElement, 2>, nr_layers> const& inflow,
+            PartitionedArray<FloatingPointElement, 2> const& fraction)
+            -> std::tuple<
+                std::array<PartitionedArray<FloatingPointElement, 2>, nr_layers>,
+                std::array<PartitionedArray<FloatingPointElement, 2>, nr_layers>>
+        {
+            using Policies =
+                policy::accu_fraction::DefaultValuePolicies<FlowDirectionElement, FloatingPointElement>;
+
+            return accu_fraction(Policies{}, flow_network, inflow, fraction);
+        }
+
     }  // namespace value_policies
 }  // namespace lue
@@ -86,5 +86,61 @@ namespace lue {
             return accu_threshold(Policies{}, flow_direction, inflow, threshold);
         }
 
+
+        template<std::integral FlowDirectionElement, std::floating_point FloatingPointElement>
+        auto accu_threshold(
+            FlowNetwork<FlowDirectionElement, FloatingPointElement> const& flow_network,
+            PartitionedArray<FloatingPointElement, 2> const& inflow,
+            PartitionedArray<FloatingPointElement, 2> const& threshold) -> std::
+            tuple<PartitionedArray<FloatingPointElement, 2>, PartitionedArray<FloatingPointElement, 2>>
+        {
+            using Policies =
+                policy::accu_threshold::DefaultValuePolicies<FlowDirectionElement, FloatingPointElement>;
+
+            return accu_threshold(Policies{}, flow_network, inflow, threshold);
+        }
+
+
+        template<std::integral FlowDirectionElement, std::floating_point FloatingPointElement>
+        auto accu_threshold(
+            FlowNetwork<FlowDirectionElement, FloatingPointElement> const& flow_network,
+            PartitionedArray<FloatingPointElement, 2> const& inflow,
+            Scalar<FloatingPointElement> const& threshold) -> std::
+            tuple<PartitionedArray<FloatingPointElement, 2>, PartitionedArray<FloatingPointElement, 2>>
+        {
+            using Policies =
+                policy::accu_threshold::DefaultValuePolicies<FlowDirectionElement, FloatingPointElement>;
+
+            return accu_threshold(Policies{}, flow_network, inflow, threshold);
+        }
+
+
+        template<std::integral FlowDirectionElement, std::floating_point FloatingPointElement>
+        auto accu_threshold(
+            FlowNetwork<FlowDirectionElement, FloatingPointElement> const& flow_network,
+            Scalar<FloatingPointElement> const& inflow,
+            Scalar<FloatingPointElement> const& threshold) -> std::
+            tuple<PartitionedArray<FloatingPointElement, 2>, PartitionedArray<FloatingPointElement, 2>>
+        {
+            using Policies =
+                policy::accu_threshold::DefaultValuePolicies<FlowDirectionElement, FloatingPointElement>;
+
+            return accu_threshold(Policies{}, flow_network, inflow, threshold);
+        }
+
+
+        template<std::integral FlowDirectionElement, std::floating_point FloatingPointElement>
+        auto accu_threshold(
+            FlowNetwork<FlowDirectionElement, FloatingPointElement> const& flow_network,
+            Scalar<FloatingPointElement> const& inflow,
+            PartitionedArray<FloatingPointElement, 2> const& threshold) -> std::
+            tuple<PartitionedArray<FloatingPointElement, 2>, PartitionedArray<FloatingPointElement, 2>>
+        {
+            using Policies =
+                policy::accu_threshold::DefaultValuePolicies<FlowDirectionElement, FloatingPointElement>;
+
+            return accu_threshold(Policies{}, flow_network, inflow, threshold);
+        }
+
     }  // namespace value_policies
 }  // namespace lue
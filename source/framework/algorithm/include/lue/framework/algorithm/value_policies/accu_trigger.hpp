@@ -86,5 +86,61 @@ namespace lue {
             return accu_trigger(Policies{}, flow_direction, inflow, trigger);
         }
 
+
+        template<std::integral FlowDirectionElement, std::floating_point FloatingPointElement>
+        auto accu_trigger(
+            FlowNetwork<FlowDirectionElement, FloatingPointElement> const& flow_network,
+            PartitionedArray<FloatingPointElement, 2> const& inflow,
+            PartitionedArray<FloatingPointElement, 2> const& trigger) -> std::
+            tuple<PartitionedArray<FloatingPointElement, 2>, PartitionedArray<FloatingPointElement, 2>>
+        {
+            using Policies =
+                policy::accu_trigger::DefaultValuePolicies<FlowDirectionElement, FloatingPointElement>;
+
+            return accu_trigger(Policies{}, flow_network, inflow, trigger);
+        }
+
+
+        template<std::integral FlowDirectionElement, std::floating_point FloatingPointElement>
+        auto accu_trigger(
+            FlowNetwork<FlowDirectionElement, FloatingPointElement> const& flow_network,
+            PartitionedArray<FloatingPointElement, 2> const& inflow,
+            Scalar<FloatingPointElement> const& trigger) -> std::
+            tuple<PartitionedArray<FloatingPointElement, 2>, PartitionedArray<FloatingPointElement, 2>>
+        {
+            using Policies =
+                policy::accu_trigger::DefaultValuePolicies<FlowDirectionElement, FloatingPointElement>;
+
+            return accu_trigger(Policies{}, flow_network, inflow, trigger);
+        }
+
+
+        template<std::integral FlowDirectionElement, std::floating_point FloatingPointElement>
+        auto accu_trigger(
+            FlowNetwork<FlowDirectionElement, FloatingPointElement> const& flow_network,
+            Scalar<FloatingPointElement> const& inflow,
+            Scalar<FloatingPointElement> const& trigger) -> std::
+            tuple<PartitionedArray<FloatingPointElement, 2>, PartitionedArray<FloatingPointElement, 2>>
+        {
+            using Policies =
+                policy::accu_trigger::DefaultValuePolicies<FlowDirectionElement, FloatingPointElement>;
+
+            return accu_trigger(Policies{}, flow_network, inflow, trigger);
+        }
+
+
+        template<std::integral FlowDirectionElement, std::floating_point FloatingPointElement>
+        auto accu_trigger(
+            FlowNetwork<FlowDirectionElement, FloatingPointElement> const& flow_network,
+            Scalar<FloatingPointElement> const& inflow,
+            PartitionedArray<FloatingPointElement, 2> const& trigger) -> std::
+            tuple<PartitionedArray<FloatingPointElement, 2>, PartitionedArray<FloatingPointElement, 2>>
+        {
+            using Policies =
+                policy::accu_trigger::DefaultValuePolicies<FlowDirectionElement, FloatingPointElement>;
+
+            return accu_trigger(Policies{}, flow_network, inflow, trigger);
+        }
+
     }  // namespace value_policies
 }  // namespace lue
@@ -0,0 +1,17 @@
+#pragma once
+#include "lue/framework/algorithm/flow_network.hpp"
+#include <concepts>
+
+
+namespace lue::value_policies {
+
+    template<std::floating_point MaterialElement, std::integral FlowDirectionElement>
+    auto flow_network(PartitionedArray<FlowDirectionElement, 2> const& flow_direction)
+        -> FlowNetwork<FlowDirectionElement, MaterialElement>
+    {
+        using Policies = lue::policy::flow_network::DefaultValuePolicies<FlowDirectionElement>;
+
+        return flow_network<MaterialElement>(Policies{}, flow_direction);
+    }
+
+}  // namespace lue::value_policies
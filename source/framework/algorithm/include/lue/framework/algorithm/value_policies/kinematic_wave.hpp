@@ -90,5 +90,56 @@ namespace lue {
                 channel_length);
         }
 
+
+        template<std::integral FlowDirectionElement, std::floating_point FloatingPointElement>
+        auto kinematic_wave(
+            FlowNetwork<FlowDirectionElement, FloatingPointElement> const& flow_network,
+            PartitionedArray<FloatingPointElement, 2> const& current_outflow,
+            PartitionedArray<FloatingPointElement, 2> const& inflow,
+            PartitionedArray<FloatingPointElement, 2> const& alpha,
+            PartitionedArray<FloatingPointElement, 2> const& beta,
+            Scalar<FloatingPointElement> const& time_step_duration,
+            PartitionedArray<FloatingPointElement, 2> const& channel_length)
+            -> PartitionedArray<FloatingPointElement, 2>
+        {
+            using Policies =
+                policy::kinematic_wave::DefaultValuePolicies<FlowDirectionElement, FloatingPointElement>;
+
+            return kinematic_wave(
+                Policies{},
+                flow_network,
+                current_outflow,
+                inflow,
+                alpha,
+                beta,
+                time_step_duration,
+                channel_length);
+        }
+
+
+        template<std::integral FlowDirectionElement, std::floating_point FloatingPointElement>
+        auto kinematic_wave(
+            FlowNetwork<FlowDirectionElement, FloatingPointElement> const& flow_network,
+            PartitionedArray<FloatingPointElement, 2> const& current_outflow,
+            PartitionedArray<FloatingPointElement, 2> const& inflow,
+            Scalar<FloatingPointElement> const& alpha,
+            Scalar<FloatingPointElement> const& beta,
+            Scalar<FloatingPointElement> const& time_step_duration,
+            Scalar<FloatingPointElement> const& channel_length) -> PartitionedArray<FloatingPointElement, 2>
+        {
+            using Policies =
+                policy::kinematic_wave::DefaultValuePolicies<FlowDirectionElement, FloatingPointElement>;
+
+            return kinematic_wave(
+                Policies{},
+                flow_network,
+                current_outflow,
+                inflow,
+                alpha,
+                beta,
+                time_step_duration,
+                channel_length);
+        }
+
     }  // namespace value_policies
 }  // namespace lue
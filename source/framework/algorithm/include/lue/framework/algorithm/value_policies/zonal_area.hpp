@@ -22,5 +22,14 @@ namespace lue {
             return zonal_area<Count>(Policies{}, zones);
         }
 
+
+        template<typename Count, typename Zone, Rank rank>
+        auto zonal_area(ZoneIndex<Zone, rank> const& zone_index) -> PartitionedArray<Count, rank>
+        {
+            using Policies = policy::zonal_area::DefaultValuePolicies<Count, Zone>;
+
+            return zonal_area<Count>(Policies{}, zone_index);
+        }
+
     }  // namespace value_policies
 }  // namespace lue
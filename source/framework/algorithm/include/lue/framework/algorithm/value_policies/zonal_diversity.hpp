@@ -25,5 +25,15 @@ namespace lue {
             return zonal_diversity<Count>(Policies{}, array, zones);
         }
 
+
+        template<typename Count, typename Element, typename Zone, Rank rank>
+        PartitionedArray<Count, rank> zonal_diversity(
+            PartitionedArray<Element, rank> const& array, ZoneIndex<Zone, rank> const& zone_index)
+        {
+            using Policies = policy::zonal_diversity::DefaultValuePolicies<Count, Element, Zone>;
+
+            return zonal_diversity<Count>(Policies{}, array, zone_index);
+        }
+
     }  // namespace value_policies
 }  // namespace lue
@@ -25,5 +25,15 @@ namespace lue {
             return zonal_majority(Policies{}, array, zones);
         }
 
+
+        template<typename Element, typename Zone, Rank rank>
+        PartitionedArray<Element, rank> zonal_majority(
+            PartitionedArray<Element, rank> const& array, ZoneIndex<Zone, rank> const& zone_index)
+        {
+            using Policies = policy::zonal_majority::DefaultValuePolicies<Element, Zone>;
+
+            return zonal_majority(Policies{}, array, zone_index);
+        }
+
     }  // namespace value_policies
 }  // namespace lue
@@ -25,5 +25,15 @@ namespace lue {
             return zonal_maximum(Policies{}, array, zones);
         }
 
+
+        template<typename Element, typename Zone, Rank rank>
+        PartitionedArray<Element, rank> zonal_maximum(
+            PartitionedArray<Element, rank> const& array, ZoneIndex<Zone, rank> const& zone_index)
+        {
+            using Policies = policy::zonal_maximum::DefaultValuePolicies<Element, Zone>;
+
+            return zonal_maximum(Policies{}, array, zone_index);
+        }
+
     }  // namespace value_policies
 }  // namespace lue
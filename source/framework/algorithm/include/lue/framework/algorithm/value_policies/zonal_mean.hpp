@@ -25,5 +25,15 @@ namespace lue {
             return zonal_mean(Policies{}, array, zones);
         }
 
+
+        template<typename Element, typename Zone, Rank rank>
+        PartitionedArray<Element, rank> zonal_mean(
+            PartitionedArray<Element, rank> const& array, ZoneIndex<Zone, rank> const& zone_index)
+        {
+            using Policies = policy::zonal_mean::DefaultValuePolicies<Element, Zone>;
+
+            return zonal_mean(Policies{}, array, zone_index);
+        }
+
     }  // namespace value_policies
 }  // namespace lue
@@ -25,5 +25,15 @@ namespace lue {
             return zonal_minimum(Policies{}, array, zones);
         }
 
+
+        template<typename Element, typename Zone, Rank rank>
+        PartitionedArray<Element, rank> zonal_minimum(
+            PartitionedArray<Element, rank> const& array, ZoneIndex<Zone, rank> const& zone_index)
+        {
+            using Policies = policy::zonal_minimum::DefaultValuePolicies<Element, Zone>;
+
+            return zonal_minimum(Policies{}, array, zone_index);
+        }
+
     }  // namespace value_policies
 }  // namespace lue
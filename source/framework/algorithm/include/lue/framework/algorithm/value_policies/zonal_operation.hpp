@@ -7,5 +7,7 @@
 #include "lue/framework/algorithm/value_policies/zonal_mean.hpp"
 #include "lue/framework/algorithm/value_policies/zonal_minimum.hpp"
 #include "lue/framework/algorithm/value_policies/zonal_normal.hpp"
+#include "lue/framework/algorithm/value_policies/zonal_statistics.hpp"
 #include "lue/framework/algorithm/value_policies/zonal_sum.hpp"
 #include "lue/framework/algorithm/value_policies/zonal_uniform.hpp"
+#include "lue/framework/algorithm/value_policies/zone_index.hpp"
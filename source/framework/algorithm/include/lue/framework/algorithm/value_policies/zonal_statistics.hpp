@@ -0,0 +1,67 @@
+#pragma once
+#include "lue/framework/algorithm/zonal_statistics.hpp"
+
+
+namespace lue {
+    namespace policy::zonal_statistics {
+
+        template<typename Element, typename Zone>
+        using DefaultValuePolicies = policy::DefaultValuePolicies<
+            AllValuesWithinDomain<Element, Zone>,
+            OutputElements<Element>,
+            InputElements<Element, Zone>>;
+
+    }  // namespace policy::zonal_statistics
+
+
+    namespace value_policies {
+
+        template<typename Element, typename Zone, Rank rank>
+        auto zonal_statistics(
+            PartitionedArray<Element, rank> const& array,
+            PartitionedArray<Zone, rank> const& zones,
+            std::vector<ZonalStatistic> const& statistics) -> std::vector<PartitionedArray<Element, rank>>
+        {
+            using Policies = policy::zonal_statistics::DefaultValuePolicies<Element, Zone>;
+
+            return zonal_statistics(Policies{}, array, zones, statistics);
+        }
+
+
+        template<typename Element, typename Zone, Rank rank>
+        auto zonal_statistics_table(
+            PartitionedArray<Element, rank> const& array,
+            PartitionedArray<Zone, rank> const& zones,
+            std::vector<ZonalStatistic> const& statistics) -> hpx::future<ZonalStatisticsTable<Zone, Element>>
+        {
+            using Policies = policy::zonal_statistics::DefaultValuePolicies<Element, Zone>;
+
+            return zonal_statistics_table(Policies{}, array, zones, statistics);
+        }
+
+
+        template<typename Element, typename Zone, Rank rank>
+        auto zonal_statistics(
+            PartitionedArray<Element, rank> const& array,
+            ZoneIndex<Zone, rank> const& zone_index,
+            std::vector<ZonalStatistic> const& statistics) -> std::vector<PartitionedArray<Element, rank>>
+        {
+            using Policies = policy::zonal_statistics::DefaultValuePolicies<Element, Zone>;
+
+            return zonal_statistics(Policies{}, array, zone_index, statistics);
+        }
+
+
+        template<typename Element, typename Zone, Rank rank>
+        auto zonal_statistics_table(
+            PartitionedArray<Element, rank> const& array,
+            ZoneIndex<Zone, rank> const& zone_index,
+            std::vector<ZonalStatistic> const& statistics) -> hpx::future<ZonalStatisticsTable<Zone, Element>>
+        {
+            using Policies = policy::zonal_statistics::DefaultValuePolicies<Element, Zone>;
+
+            return zonal_statistics_table(Policies{}, array, zone_index, statistics);
+        }
+
+    }  // namespace value_policies
+}  // namespace lue
@@ -25,5 +25,15 @@ namespace lue {
             return zonal_sum(Policies{}, array, zones);
         }
 
+
+        template<typename Element, typename Zone, Rank rank>
+        PartitionedArray<Element, rank> zonal_sum(
+            PartitionedArray<Element, rank> const& array, ZoneIndex<Zone, rank> const& zone_index)
+        {
+            using Policies = policy::zonal_sum::DefaultValuePolicies<Element, Zone>;
+
+            return zonal_sum(Policies{}, array, zone_index);
+        }
+
     }  // namespace value_policies
 }  // namespace lue
@@ -0,0 +1,28 @@
+#pragma once
+#include "lue/framework/algorithm/zone_index.hpp"
+
+
+namespace lue {
+    namespace policy::zone_index {
+
+        template<typename Zone>
+        using DefaultValuePolicies = policy::DefaultValuePolicies<
+            AllValuesWithinDomain<Zone>,
+            OutputElements<IndexElement>,
+            InputElements<Zone>>;
+
+    }  // namespace policy::zone_index
+
+
+    namespace value_policies {
+
+        template<typename Zone, Rank rank>
+        auto zone_index(PartitionedArray<Zone, rank> const& zones) -> ZoneIndex<Zone, rank>
+        {
+            using Policies = policy::zone_index::DefaultValuePolicies<Zone>;
+
+            return zone_index(Policies{}, zones);
+        }
+
+    }  // namespace value_policies
+}  // namespace lue
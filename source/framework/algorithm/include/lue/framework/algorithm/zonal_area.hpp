@@ -1,5 +1,6 @@
 #pragma once
 #include "lue/framework/algorithm/policy.hpp"
+#include "lue/framework/algorithm/zone_index.hpp"
 #include "lue/framework/partitioned_array_decl.hpp"
 
 
@@ -9,4 +10,9 @@ namespace lue {
     PartitionedArray<Count, rank> zonal_area(
         Policies const& policies, PartitionedArray<Zone, rank> const& zones);
 
+
+    template<typename Count, typename Policies, typename Zone, Rank rank>
+    PartitionedArray<Count, rank> zonal_area(
+        Policies const& policies, ZoneIndex<Zone, rank> const& zone_index);
+
 }  // namespace lue
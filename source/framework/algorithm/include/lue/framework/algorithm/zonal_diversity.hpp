@@ -1,5 +1,6 @@
 #pragma once
 #include "lue/framework/algorithm/policy.hpp"
+#include "lue/framework/algorithm/zone_index.hpp"
 #include "lue/framework/partitioned_array_decl.hpp"
 
 
@@ -11,4 +12,11 @@ namespace lue {
         PartitionedArray<Element, rank> const& array,
         PartitionedArray<Zone, rank> const& zones);
 
+
+    template<typename Count, typename Policies, typename Element, typename Zone, Rank rank>
+    PartitionedArray<Count, rank> zonal_diversity(
+        Policies const& policies,
+        PartitionedArray<Element, rank> const& array,
+        ZoneIndex<Zone, rank> const& zone_index);
+
 }  // namespace lue
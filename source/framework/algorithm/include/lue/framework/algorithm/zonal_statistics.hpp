@@ -0,0 +1,65 @@
+#pragma once
+#include "lue/framework/algorithm/policy.hpp"
+#include "lue/framework/algorithm/zone_index.hpp"
+#include "lue/framework/partitioned_array_decl.hpp"
+#include <vector>
+
+
+namespace lue {
+
+    /*!
+        @brief      Statistics which can be calculated per zone by zonal_statistics()
+
+        The area of a zone is its number of cells, like zonal_area() calculates. The other statistics
+        only consider the cells of a zone containing a valid input value. For zones without such
+        cells, they are no-data.
+    */
+    enum class ZonalStatistic { area, sum, mean, minimum, maximum };
+
+
+    /*!
+        @brief      Per zone, the values of the requested statistics
+    */
+    template<typename Zone, typename Element>
+    struct ZonalStatisticsTable
+    {
+            //! Zones containing at least one cell, in increasing order
+            std::vector<Zone> zones;
+
+            //! Per requested statistic, the value per zone, in the order of @a zones
+            std::vector<std::vector<Element>> values;
+    };
+
+
+    template<typename Policies, typename Element, typename Zone, Rank rank>
+    auto zonal_statistics(
+        Policies const& policies,
+        PartitionedArray<Element, rank> const& array,
+        PartitionedArray<Zone, rank> const& zones,
+        std::vector<ZonalStatistic> const& statistics) -> std::vector<PartitionedArray<Element, rank>>;
+
+
+    template<typename Policies, typename Element, typename Zone, Rank rank>
+    auto zonal_statistics_table(
+        Policies const& policies,
+        PartitionedArray<Element, rank> const& array,
+        PartitionedArray<Zone, rank> const& zones,
+        std::vector<ZonalStatistic> const& statistics) -> hpx::future<ZonalStatisticsTable<Zone, Element>>;
+
+
+    template<typename Policies, typename Element, typename Zone, Rank rank>
+    auto zonal_statistics(
+        Policies const& policies,
+        PartitionedArray<Element, rank> const& array,
+        ZoneIndex<Zone, rank> const& zone_index,
+        std::vector<ZonalStatistic> const& statistics) -> std::vector<PartitionedArray<Element, rank>>;
+
+
+    template<typename Policies, typename Element, typename Zone, Rank rank>
+    auto zonal_statistics_table(
+        Policies const& policies,
+        PartitionedArray<Element, rank> const& array,
+        ZoneIndex<Zone, rank> const& zone_index,
+        std::vector<ZonalStatistic> const& statistics) -> hpx::future<ZonalStatisticsTable<Zone, Element>>;
+
+}  // namespace lue
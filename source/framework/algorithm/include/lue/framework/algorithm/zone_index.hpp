@@ -0,0 +1,91 @@
+#pragma once
+#include "lue/framework/algorithm/policy.hpp"
+#include "lue/framework/partitioned_array_decl.hpp"
+#include <map>
+#include <vector>
+
+
+namespace lue {
+
+    /*!
+        @brief      Class template for storing the relation between the cells and zones of a zones
+                    array, for reuse by zonal operations
+        @tparam     Zone Type for representing zones
+        @tparam     rank Array rank
+
+        Per locality, the zones occurring in the partitions located there are stored, in increasing
+        order. Each cell is labelled with the position of its zone in this collection. Cells without
+        a zone are labelled with the number of zones in the locality.
+
+        Zonal operations passed an index don't have to determine which zones occur in which
+        localities, and don't have to test each cell's zone for no-data or look it up when assigning
+        statistics to cells. This pays off when the zones don't change, while zonal operations are
+        performed repeatedly, like in time-stepped models.
+
+        An index is created by zone_index(). It must be recreated when the zones change.
+    */
+    template<typename Zone, Rank rank>
+    class ZoneIndex
+    {
+
+        public:
+
+            //! Type for representing the position of a zone in a locality's collection of zones
+            using Label = IndexElement;
+
+            //! Type of the array containing the labels
+            using Labels = PartitionedArray<Label, rank>;
+
+
+            ZoneIndex() = default;
+
+
+            ZoneIndex(
+                Labels&& labels,
+                std::map<hpx::id_type, std::vector<Index>> partition_idxs,
+                std::vector<hpx::shared_future<std::vector<Zone>>> locality_zones):
+
+                _labels{std::move(labels)},
+                _partition_idxs{std::move(partition_idxs)},
+                _locality_zones{std::move(locality_zones)}
+
+            {
+            }
+
+
+            //! Return the labels, per cell the position of its zone in its locality's zones
+            auto labels() const -> Labels const&
+            {
+                return _labels;
+            }
+
+
+            //! Return, per locality, the linear indices of the partitions located in it
+            auto partition_idxs() const -> std::map<hpx::id_type, std::vector<Index>> const&
+            {
+                return _partition_idxs;
+            }
+
+
+            //! Return, per locality, in the order of partition_idxs(), the zones occurring in it
+            auto locality_zones() const -> std::vector<hpx::shared_future<std::vector<Zone>>> const&
+            {
+                return _locality_zones;
+            }
+
+
+        private:
+
+            Labels _labels;
+
+            std::map<hpx::id_type, std::vector<Index>> _partition_idxs;
+
+            std::vector<hpx::shared_future<std::vector<Zone>>> _locality_zones;
+    };
+
+
+    template<typename Policies, typename Zone, Rank rank>
+    auto zone_index(Policies const& policies, PartitionedArray<Zone, rank> const& zones)
+        -> ZoneIndex<Zone, rank>;
+
+}  // namespace lue
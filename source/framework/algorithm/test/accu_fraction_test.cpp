@@ -1,6 +1,9 @@
 #define BOOST_TEST_MODULE lue framework algorithm accu_fraction
 #include "flow_accumulation.hpp"
+#include "lue/framework/algorithm/create_partitioned_array.hpp"
+#include "lue/framework/algorithm/range.hpp"
 #include "lue/framework/algorithm/value_policies/accu_fraction.hpp"
+#include "lue/framework/algorithm/value_policies/flow_network.hpp"
 #include "lue/framework/test/hpx_unit_test.hpp"
 #include "lue/framework.hpp"
 
@@ -409,3 +412,38 @@ BOOST_AUTO_TEST_CASE(merging_streams_case_01)
     lue::test::check_arrays_are_equal(outflow_we_got, outflow_we_want);
     lue::test::check_arrays_are_equal(residue_we_got, residue_we_want);
 }
+
+
+BOOST_AUTO_TEST_CASE(layers)
+{
+    using MaterialElement = lue::FloatingPointElement<0>;
+    using MaterialArray = lue::PartitionedArray<MaterialElement, 2>;
+
+    auto const flow_direction = lue::test::merging_streams();
+    auto const flow_network = lue::value_policies::flow_network<MaterialElement>(flow_direction);
+
+    std::array<MaterialArray, 3> inflow{
+        lue::test::ones<MaterialElement>(),
+        lue::create_partitioned_array<MaterialElement>(lue::test::array_shape, lue::test::partition_shape),
+        lue::test::no_data<MaterialElement>()};
+    lue::range(inflow[1], MaterialElement{1}).get();
+
+    auto const fraction = lue::test::filled(MaterialElement{0.5});
+
+    // Routing all layers at once results in the same values as routing each layer by itself
+    auto const [outflow_we_got, remainder_we_got] =
+        lue::value_policies::accu_fraction(flow_direction, inflow, fraction);
+    auto const [outflow_network_we_got, remainder_network_we_got] =
+        lue::value_policies::accu_fraction(flow_network, inflow, fraction);
+
+    for (std::size_t layer = 0; layer < inflow.size(); ++layer)
+    {
+        auto const [outflow_we_want, remainder_we_want] =
+            lue::value_policies::accu_fraction(flow_direction, inflow[layer], fraction);
+
+        lue::test::check_arrays_are_equal(outflow_we_got[layer], outflow_we_want);
+        lue::test::check_arrays_are_equal(remainder_we_got[layer], remainder_we_want);
+        lue::test::check_arrays_are_equal(outflow_network_we_got[layer], outflow_we_want);
+        lue::test::check_arrays_are_equal(remainder_network_we_got[layer], remainder_we_want);
+    }
+}
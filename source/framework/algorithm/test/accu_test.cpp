@@ -1,6 +1,9 @@
 #define BOOST_TEST_MODULE lue framework algorithm accu
 #include "flow_accumulation.hpp"
+#include "lue/framework/algorithm/create_partitioned_array.hpp"
+#include "lue/framework/algorithm/range.hpp"
 #include "lue/framework/algorithm/value_policies/accu.hpp"
+#include "lue/framework/algorithm/value_policies/flow_network.hpp"
 #include "lue/framework/test/hpx_unit_test.hpp"
 #include "lue/framework.hpp"
 
@@ -1308,4 +1311,33 @@ BOOST_AUTO_TEST_CASE(back_and_forth)
 }
 
 
+BOOST_AUTO_TEST_CASE(layers)
+{
+    using MaterialElement = lue::FloatingPointElement<0>;
+    using MaterialArray = lue::PartitionedArray<MaterialElement, 2>;
+
+    auto const flow_direction = lue::test::merging_streams();
+    auto const flow_network = lue::value_policies::flow_network<MaterialElement>(flow_direction);
+
+    std::array<MaterialArray, 3> inflow{
+        lue::test::ones<MaterialElement>(),
+        lue::create_partitioned_array<MaterialElement>(lue::test::array_shape, lue::test::partition_shape),
+        lue::test::no_data<MaterialElement>()};
+    lue::range(inflow[1], MaterialElement{1}).get();
+
+    // Routing all layers at once results in the same values as routing each layer by itself
+    std::array<MaterialArray, 3> const outflow_we_got = lue::value_policies::accu(flow_direction, inflow);
+    std::array<MaterialArray, 3> const outflow_network_we_got =
+        lue::value_policies::accu(flow_network, inflow);
+
+    for (std::size_t layer = 0; layer < inflow.size(); ++layer)
+    {
+        MaterialArray const outflow_we_want = lue::value_policies::accu(flow_direction, inflow[layer]);
+
+        lue::test::check_arrays_are_equal(outflow_we_got[layer], outflow_we_want);
+        lue::test::check_arrays_are_equal(outflow_network_we_got[layer], outflow_we_want);
+    }
+}
+
+
 // TODO: Out of domain values: negative material is out of domain!
@@ -1,12 +1,16 @@
 #define BOOST_TEST_MODULE lue framework algorithm convolve
 #include "lue/framework/algorithm/create_partitioned_array.hpp"
 #include "lue/framework/algorithm/kernel.hpp"
+#include "lue/framework/algorithm/range.hpp"
 #include "lue/framework/algorithm/value_policies/convolve.hpp"
+#include "lue/framework/algorithm/value_policies/focal_sum.hpp"
 #include "lue/framework/test/hpx_unit_test.hpp"
 #include "lue/framework.hpp"
+#include <cmath>
+#include <cstdlib>
+#include <limits>
 
 
-// TODO Test with larger kernel radius
 // TODO Test with different float weights
 
 // TODO Test empty input raster
@@ -297,3 +301,192 @@ BOOST_AUTO_TEST_CASE(window_total_2d_single_col_of_partitions)
 
     lue::test::check_arrays_are_equal(result_we_got, result_we_want);
 }
+
+
+BOOST_AUTO_TEST_CASE(large_kernel)
+{
+    // Kernels this large which are not separable are handled using fast Fourier transforms. With
+    // unit weights, the results must equal those of focal_sum. A box kernel would be handled by
+    // the two-pass algorithm for separable kernels instead.
+    using Element = lue::FloatingPointElement<0>;
+    std::size_t const rank = 2;
+
+    using ElementArray = lue::PartitionedArray<Element, rank>;
+    using Shape = lue::ShapeT<ElementArray>;
+
+    Shape const array_shape{{40, 40}};
+    Shape const partition_shape{{20, 20}};
+
+    ElementArray array{lue::create_partitioned_array<Element>(array_shape, partition_shape)};
+    lue::range(array, Element{1}).get();
+
+    lue::Radius const radius{12};
+    auto const result_we_got =
+        lue::value_policies::convolve(array, lue::circle_kernel<Element, rank>(radius, 1));
+    auto const result_we_want =
+        lue::value_policies::focal_sum(array, lue::circle_kernel<lue::BooleanElement, rank>(radius, 1));
+
+    lue::test::check_arrays_are_close(result_we_got, result_we_want, Element{1e-5});
+}
+
+
+BOOST_AUTO_TEST_CASE(large_kernel_non_finite_value)
+{
+    // An infinite value must only affect the results of the neighbourhoods containing it, also when
+    // the results are calculated using fast Fourier transforms. Transforming the value would turn the
+    // results of all cells calculated using the same block into NaN or infinity.
+    using Element = lue::FloatingPointElement<0>;
+    std::size_t const rank = 2;
+
+    using ElementArray = lue::PartitionedArray<Element, rank>;
+    using Shape = lue::ShapeT<ElementArray>;
+
+    Shape const array_shape{{40, 40}};
+    Shape const partition_shape{{20, 20}};
+    lue::Radius const radius{12};
+    lue::Index const idx0_infinity{10};
+    lue::Index const idx1_infinity{10};
+
+    ElementArray array{lue::create_partitioned_array<Element>(array_shape, partition_shape, 1)};
+
+    {
+        auto& partition{array.partitions()[0]};
+        auto data{partition.data(hpx::launch::sync)};
+
+        data(idx0_infinity, idx1_infinity) = std::numeric_limits<Element>::infinity();
+        partition.set_data(hpx::launch::sync, data);
+    }
+
+    auto const result_we_got =
+        lue::value_policies::convolve(array, lue::circle_kernel<Element, rank>(radius, 1));
+    auto const result_we_want = lue::value_policies::focal_sum(
+        lue::create_partitioned_array<Element>(array_shape, partition_shape, 1),
+        lue::circle_kernel<lue::BooleanElement, rank>(radius, 1));
+
+    for (lue::Index partition_idx = 0; partition_idx < result_we_got.nr_partitions(); ++partition_idx)
+    {
+        auto const& partition_we_got{result_we_got.partitions()[partition_idx]};
+        auto const& partition_we_want{result_we_want.partitions()[partition_idx]};
+
+        auto const offset{partition_we_got.offset(hpx::launch::sync)};
+        auto const data_we_got{partition_we_got.data(hpx::launch::sync)};
+        auto const data_we_want{partition_we_want.data(hpx::launch::sync)};
+
+        for (lue::Index idx0 = 0; idx0 < partition_shape[0]; ++idx0)
+        {
+            for (lue::Index idx1 = 0; idx1 < partition_shape[1]; ++idx1)
+            {
+                lue::Index const array_idx0{offset[0] + idx0};
+                lue::Index const array_idx1{offset[1] + idx1};
+
+                BOOST_TEST_CONTEXT("cell " << array_idx0 << ", " << array_idx1)
+                {
+                    if (array_idx0 == idx0_infinity && array_idx1 == idx1_infinity)
+                    {
+                        BOOST_CHECK(std::isinf(data_we_got(idx0, idx1)));
+                    }
+                    else if (
+                        std::abs(array_idx0 - idx0_infinity) > radius ||
+                        std::abs(array_idx1 - idx1_infinity) > radius)
+                    {
+                        BOOST_TEST(
+                            data_we_got(idx0, idx1) == data_we_want(idx0, idx1),
+                            tt::tolerance(Element{1e-5}));
+                    }
+                }
+            }
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(separable_kernel_no_data_in_window)
+{
+    // Separable kernels are handled by a two-pass algorithm. The factors of this kernel differ, so
+    // swapping the passes results in different values. No-data cells in the neighbourhood are
+    // skipped. The window of the cell in the center of the no-data block contains only no-data
+    // cells.
+    using Element = lue::FloatingPointElement<0>;
+    std::size_t const rank = 2;
+
+    using ElementArray = lue::PartitionedArray<Element, rank>;
+    using Shape = lue::ShapeT<ElementArray>;
+
+    Shape const array_shape{{6, 8}};
+    Shape const partition_shape{{3, 4}};
+
+    Element const x{lue::policy::no_data_value<Element>};
+
+    auto const array = lue::test::create_partitioned_array<ElementArray>(
+        array_shape,
+        partition_shape,
+        {
+            // NOLINTBEGIN
+            // clang-format off
+            {
+                 2, -1,  4,  0,
+                -4,  3,  x,  x,
+                 1,  0,  x,  x,
+            },
+            {
+                -3,  5,  1, -2,
+                 x,  2, -1,  6,
+                 x, -5,  3,  2,
+            },
+            {
+                 5, -2,  x,  x,
+                -3,  6,  2, -4,
+                 4, -1,  3,  x,
+            },
+            {
+                 x,  4,  x, -1,
+                 1,  0, -2,  3,
+                 2, -6,  5,  1,
+            },
+            // clang-format on
+            // NOLINTEND
+        });
+
+    // Outer product of [1, 0.5, 2] and [3, 1, 0.25]
+    // clang-format off
+    lue::Kernel<Element, 2> const kernel{
+        Shape{{3, 3}},
+        {
+                3,     1,  0.25,
+              1.5,   0.5, 0.125,
+                6,     2,   0.5,
+        }};
+    // clang-format on
+    auto const result_we_got = lue::value_policies::convolve(array, kernel);
+    auto const result_we_want = lue::test::create_partitioned_array<ElementArray>(
+        array_shape,
+        partition_shape,
+        {
+            // NOLINTBEGIN
+            // clang-format off
+            {
+                 -5.625,     -15,    18.5,   5.625,
+                  2.125,     7.5,     5.5,   11.25,
+                   6.25,    18.5,      -3,       x,
+            },
+            {
+                  0.125,   1.625,   20.75,     6.5,
+                     -4, -11.375,   -4.25,    24.5,
+                  1.875,   7.625,   24.25,     6.5,
+            },
+            {
+                   0.25,     4.5,      35,     4.5,
+                  11.25,   35.25,     3.5,  20.125,
+                  0.375,   3.375,      19,       7,
+            },
+            {
+                 -22.75,    2.75,  -8.125,     4.5,
+                   -3.5,    7.75, -14.375,    29.5,
+                 -10.75,   3.125,  -7.625,       5,
+            },
+            // clang-format on
+            // NOLINTEND
+        });
+
+    lue::test::check_arrays_are_close(result_we_got, result_we_want);
+}
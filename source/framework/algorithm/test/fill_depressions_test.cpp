@@ -0,0 +1,127 @@
+#define BOOST_TEST_MODULE lue framework algorithm fill_depressions
+#include "lue/framework/algorithm/value_policies/fill_depressions.hpp"
+#include "lue/framework/test/hpx_unit_test.hpp"
+#include "lue/framework.hpp"
+
+
+BOOST_AUTO_TEST_CASE(pits_at_partition_corner)
+{
+    using Elevation = lue::FloatingPointElement<0>;
+    using FlowDirection = lue::FlowDirectionElement;
+    std::size_t const rank = 2;
+
+    using ElevationArray = lue::PartitionedArray<Elevation, rank>;
+    using FlowDirectionArray = lue::PartitionedArray<FlowDirection, rank>;
+    using Shape = lue::ShapeT<ElevationArray>;
+
+    Shape const array_shape{{6, 6}};
+    Shape const partition_shape{{3, 3}};
+
+    auto const n{lue::north<FlowDirection>};
+    auto const ne{lue::north_east<FlowDirection>};
+    auto const e{lue::east<FlowDirection>};
+    auto const se{lue::south_east<FlowDirection>};
+    auto const s{lue::south<FlowDirection>};
+    auto const w{lue::west<FlowDirection>};
+    auto const p{lue::sink<FlowDirection>};
+
+    // Two connected pits, in different partitions. They spill over the lowest cells around them
+    // into the stream towards the east border of the array.
+    auto const elevation = lue::test::create_partitioned_array<ElevationArray>(
+        array_shape,
+        partition_shape,
+        {
+            // NOLINTBEGIN
+            // clang-format off
+            {
+                10, 9, 8,
+                10, 9, 8,
+                10, 9, 0,
+            },
+            {
+                7, 6,   5,
+                7, 6,   5,
+                7, 6.5, 5,
+            },
+            {
+                10, 9, 8,
+                10, 9, 8,
+                10, 9, 8,
+            },
+            {
+                0, 6,   5,
+                7, 6.5, 5,
+                7, 6,   5,
+            },
+            // clang-format on
+            // NOLINTEND
+        });
+
+    auto const [filled_elevation_we_got, flow_direction_we_got] =
+        lue::value_policies::fill_depressions<FlowDirection>(elevation);
+
+    auto const filled_elevation_we_want = lue::test::create_partitioned_array<ElevationArray>(
+        array_shape,
+        partition_shape,
+        {
+            // NOLINTBEGIN
+            // clang-format off
+            {
+                10, 9, 8,
+                10, 9, 8,
+                10, 9, 6,
+            },
+            {
+                7, 6,   5,
+                7, 6,   5,
+                7, 6.5, 5,
+            },
+            {
+                10, 9, 8,
+                10, 9, 8,
+                10, 9, 8,
+            },
+            {
+                6, 6,   5,
+                7, 6.5, 5,
+                7, 6,   5,
+            },
+            // clang-format on
+            // NOLINTEND
+        });
+
+    // Cells along the border of the array without a lower neighbour become sinks. The cells in
+    // the pits drain towards the cell they spill over.
+    auto const flow_direction_we_want = lue::test::create_partitioned_array<FlowDirectionArray>(
+        array_shape,
+        partition_shape,
+        {
+            // NOLINTBEGIN
+            // clang-format off
+            {
+                e, e,  e,
+                e, se, s,
+                e, e,  se,
+            },
+            {
+                e, e, p,
+                e, e, p,
+                w, e, p,
+            },
+            {
+                e, ne, n,
+                e, e,  ne,
+                e, e,  e,
+            },
+            {
+                e, e, p,
+                n, e, p,
+                e, e, p,
+            },
+            // clang-format on
+            // NOLINTEND
+        });
+
+    lue::test::check_arrays_are_equal(filled_elevation_we_got, filled_elevation_we_want);
+    lue::test::check_arrays_are_equal(flow_direction_we_got, flow_direction_we_want);
+}
@@ -0,0 +1,229 @@
+#define BOOST_TEST_MODULE lue framework algorithm flow_network
+#include "flow_accumulation.hpp"
+#include "lue/framework/algorithm/create_partitioned_array.hpp"
+#include "lue/framework/algorithm/range.hpp"
+#include "lue/framework/algorithm/value_policies/accu.hpp"
+#include "lue/framework/algorithm/value_policies/accu_capacity.hpp"
+#include "lue/framework/algorithm/value_policies/accu_fraction.hpp"
+#include "lue/framework/algorithm/value_policies/accu_threshold.hpp"
+#include "lue/framework/algorithm/value_policies/accu_trigger.hpp"
+#include "lue/framework/algorithm/value_policies/flow_network.hpp"
+#include "lue/framework/algorithm/value_policies/kinematic_wave.hpp"
+#include "lue/framework/test/hpx_unit_test.hpp"
+#include "lue/framework.hpp"
+
+
+namespace {
+
+    using FlowDirectionElement = lue::FlowDirectionElement;
+    using MaterialElement = lue::FloatingPointElement<0>;
+    using FlowDirectionArray = lue::PartitionedArray<FlowDirectionElement, 2>;
+    using MaterialArray = lue::PartitionedArray<MaterialElement, 2>;
+
+
+    auto converging_flow_direction() -> FlowDirectionArray
+    {
+        using namespace lue::test;
+
+        return lue::test::create_partitioned_array<FlowDirectionArray>(
+            array_shape,
+            partition_shape,
+            {
+                // NOLINTBEGIN
+                // clang-format off
+                {
+                    se, se, se,
+                    se, se, se,
+                    se, se, se,
+                },
+                {
+                    s, s, s,
+                    s, s, s,
+                    s, s, s,
+                },
+                {
+                    sw, sw, sw,
+                    sw, sw, sw,
+                    sw, sw, sw,
+                },
+                {
+                    e, e, e,
+                    e, e, e,
+                    e, e, e,
+                },
+                {
+                    se, s, sw,
+                    e, p, w,
+                    ne, n, nw,
+                },
+                {
+                    w, w, w,
+                    w, w, w,
+                    w, w, w,
+                },
+                {
+                    ne, ne, ne,
+                    ne, ne, ne,
+                    ne, ne, ne,
+                },
+                {
+                    n, n, n,
+                    n, n, n,
+                    n, n, n,
+                },
+                {
+                    nw, nw, nw,
+                    nw, nw, nw,
+                    nw, nw, nw,
+                },
+                // clang-format on
+                // NOLINTEND
+            });
+    }
+
+
+    auto material(MaterialElement const start_value) -> MaterialArray
+    {
+        MaterialArray array{lue::create_partitioned_array<MaterialElement>(
+            lue::test::array_shape, lue::test::partition_shape)};
+        lue::range(array, start_value).get();
+
+        return array;
+    }
+
+}  // Anonymous namespace
+
+
+BOOST_AUTO_TEST_CASE(accu)
+{
+    FlowDirectionArray const flow_direction = converging_flow_direction();
+    auto const flow_network = lue::value_policies::flow_network<MaterialElement>(flow_direction);
+
+    // The network can be reused, and results in the same values as the flow direction array
+    for (MaterialElement const start_value : {1, 5, 10})
+    {
+        MaterialArray const inflow = material(start_value);
+
+        lue::test::check_arrays_are_equal(
+            lue::value_policies::accu(flow_network, inflow),
+            lue::value_policies::accu(flow_direction, inflow));
+
+        lue::Scalar<MaterialElement> const inflow_scalar{start_value};
+
+        lue::test::check_arrays_are_equal(
+            lue::value_policies::accu(flow_network, inflow_scalar),
+            lue::value_policies::accu(flow_direction, inflow_scalar));
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(accu_threshold)
+{
+    FlowDirectionArray const flow_direction = converging_flow_direction();
+    auto const flow_network = lue::value_policies::flow_network<MaterialElement>(flow_direction);
+    lue::Scalar<MaterialElement> const threshold{5};
+
+    for (MaterialElement const start_value : {1, 5, 10})
+    {
+        MaterialArray const inflow = material(start_value);
+
+        auto const [outflow_we_got, remainder_we_got] =
+            lue::value_policies::accu_threshold(flow_network, inflow, threshold);
+        auto const [outflow_we_want, remainder_we_want] =
+            lue::value_policies::accu_threshold(flow_direction, inflow, threshold);
+
+        lue::test::check_arrays_are_equal(outflow_we_got, outflow_we_want);
+        lue::test::check_arrays_are_equal(remainder_we_got, remainder_we_want);
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(accu_fraction)
+{
+    FlowDirectionArray const flow_direction = converging_flow_direction();
+    auto const flow_network = lue::value_policies::flow_network<MaterialElement>(flow_direction);
+    lue::Scalar<MaterialElement> const fraction{0.5};
+
+    for (MaterialElement const start_value : {1, 5, 10})
+    {
+        MaterialArray const inflow = material(start_value);
+
+        auto const [outflow_we_got, remainder_we_got] =
+            lue::value_policies::accu_fraction(flow_network, inflow, fraction);
+        auto const [outflow_we_want, remainder_we_want] =
+            lue::value_policies::accu_fraction(flow_direction, inflow, fraction);
+
+        lue::test::check_arrays_are_equal(outflow_we_got, outflow_we_want);
+        lue::test::check_arrays_are_equal(remainder_we_got, remainder_we_want);
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(accu_capacity)
+{
+    FlowDirectionArray const flow_direction = converging_flow_direction();
+    auto const flow_network = lue::value_policies::flow_network<MaterialElement>(flow_direction);
+    lue::Scalar<MaterialElement> const capacity{8};
+
+    for (MaterialElement const start_value : {1, 5, 10})
+    {
+        MaterialArray const inflow = material(start_value);
+
+        auto const [outflow_we_got, remainder_we_got] =
+            lue::value_policies::accu_capacity(flow_network, inflow, capacity);
+        auto const [outflow_we_want, remainder_we_want] =
+            lue::value_policies::accu_capacity(flow_direction, inflow, capacity);
+
+        lue::test::check_arrays_are_equal(outflow_we_got, outflow_we_want);
+        lue::test::check_arrays_are_equal(remainder_we_got, remainder_we_want);
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(accu_trigger)
+{
+    FlowDirectionArray const flow_direction = converging_flow_direction();
+    auto const flow_network = lue::value_policies::flow_network<MaterialElement>(flow_direction);
+    lue::Scalar<MaterialElement> const trigger{5};
+
+    for (MaterialElement const start_value : {1, 5, 10})
+    {
+        MaterialArray const inflow = material(start_value);
+
+        auto const [outflow_we_got, remainder_we_got] =
+            lue::value_policies::accu_trigger(flow_network, inflow, trigger);
+        auto const [outflow_we_want, remainder_we_want] =
+            lue::value_policies::accu_trigger(flow_direction, inflow, trigger);
+
+        lue::test::check_arrays_are_equal(outflow_we_got, outflow_we_want);
+        lue::test::check_arrays_are_equal(remainder_we_got, remainder_we_want);
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(kinematic_wave)
+{
+    FlowDirectionArray const flow_direction = converging_flow_direction();
+    auto const flow_network = lue::value_policies::flow_network<MaterialElement>(flow_direction);
+
+    lue::Scalar<MaterialElement> const alpha{1.5};
+    lue::Scalar<MaterialElement> const beta{0.6};
+    lue::Scalar<MaterialElement> const time_step_duration{15};
+    lue::Scalar<MaterialElement> const channel_length{10};
+
+    MaterialArray const inflow = material(1);
+    MaterialArray outflow_we_got = material(1);
+    MaterialArray outflow_we_want = material(1);
+
+    // Time-stepped routing, using the outflow of the previous time step as the current outflow
+    for (int time_step = 0; time_step < 3; ++time_step)
+    {
+        outflow_we_got = lue::value_policies::kinematic_wave(
+            flow_network, outflow_we_got, inflow, alpha, beta, time_step_duration, channel_length);
+        outflow_we_want = lue::value_policies::kinematic_wave(
+            flow_direction, outflow_we_want, inflow, alpha, beta, time_step_duration, channel_length);
+
+        // Cells are visited in a different order, which may affect the rounding of sums of inflows
+        lue::test::check_arrays_are_close(outflow_we_got, outflow_we_want);
+    }
+}
@@ -95,3 +95,192 @@ BOOST_AUTO_TEST_CASE(all_no_data)
 
     lue::test::check_arrays_are_equal(result_we_got, result_we_want);
 }
+
+
+BOOST_AUTO_TEST_CASE(kernel_with_gaps)
+{
+    // The histogram is updated for the cells entering and leaving the neighbourhood when moving it
+    // one column. With a ring-shaped kernel, each row of the kernel in between the first and last
+    // one contains two runs of cells. The small range of values results in many ties.
+    using Element = lue::LargestSignedIntegralElement;
+    std::size_t const rank = 2;
+
+    using ElementArray = lue::PartitionedArray<Element, rank>;
+    using Shape = lue::ShapeT<ElementArray>;
+
+    Shape const array_shape{{10, 10}};
+    Shape const partition_shape{{5, 5}};
+
+    Element const x{lue::policy::no_data_value<Element>};
+
+    auto const array = lue::test::create_partitioned_array<ElementArray>(
+        array_shape,
+        partition_shape,
+        {
+            // NOLINTBEGIN
+            // clang-format off
+            {
+                x, 1, 3, 0, 0,
+                4, 1, 0, 0, 3,
+                3, 0, 4, 0, x,
+                0, 1, 0, 4, 1,
+                4, 2, 4, 1, 0,
+            },
+            {
+                4, 0, 2, 4, 0,
+                3, 0, 1, 0, 4,
+                4, 0, 4, 4, 3,
+                2, 3, 1, 4, x,
+                x, 4, 1, 2, 0,
+            },
+            {
+                4, 0, 4, 0, x,
+                3, 4, 3, 2, 2,
+                2, 4, 3, 2, 3,
+                3, 1, 2, 1, 3,
+                2, 2, x, 4, 3,
+            },
+            {
+                1, 3, 4, 3, 2,
+                1, 1, 1, 0, 4,
+                2, 4, x, 0, 4,
+                3, 0, 0, 4, 4,
+                4, 3, 0, 0, 2,
+            },
+            // clang-format on
+            // NOLINTEND
+        });
+
+    // clang-format off
+    lue::Kernel<lue::BooleanElement, 2> const kernel{
+        Shape{{5, 5}},
+        {
+            1, 1, 1, 1, 1,
+            1, 0, 0, 0, 1,
+            1, 0, 0, 0, 1,
+            1, 0, 0, 0, 1,
+            1, 1, 1, 1, 1,
+        }};
+    // clang-format on
+    auto const result_we_got = lue::value_policies::focal_majority(array, kernel);
+    auto const result_we_want = lue::test::create_partitioned_array<ElementArray>(
+        array_shape,
+        partition_shape,
+        {
+            // NOLINTBEGIN
+            // clang-format off
+            {
+                0, 0, 0, 4, 0,
+                0, 0, 0, 1, 0,
+                4, 0, 0, 0, 0,
+                4, 0, 0, 0, 0,
+                4, 0, 0, 2, 4,
+            },
+            {
+                0, 4, 4, 0, 4,
+                0, 4, 4, 0, 1,
+                0, 4, 4, 0, 1,
+                1, 3, 3, 0, 1,
+                1, 1, 1, 4, 4,
+            },
+            {
+                4, 0, 4, 1, 3,
+                3, 2, 2, 1, 3,
+                2, 2, 3, 4, 3,
+                3, 2, 3, 2, 2,
+                2, 2, 3, 2, 2,
+            },
+            {
+                1, 2, 4, 4, 1,
+                0, 0, 4, 4, 4,
+                0, 3, 4, 0, 0,
+                1, 0, 4, 0, 0,
+                0, 3, 4, 0, 0,
+            },
+            // clang-format on
+            // NOLINTEND
+        });
+
+    lue::test::check_arrays_are_equal(result_we_got, result_we_want);
+}
+
+
+BOOST_AUTO_TEST_CASE(wide_range_of_values)
+{
+    // When the range of values in a tile is too large to store counts for each of them, counts are
+    // stored per value present
+    using Element = lue::LargestSignedIntegralElement;
+    std::size_t const rank = 2;
+
+    using ElementArray = lue::PartitionedArray<Element, rank>;
+    using Shape = lue::ShapeT<ElementArray>;
+
+    Shape const array_shape{{6, 6}};
+    Shape const partition_shape{{3, 3}};
+
+    Element const x{lue::policy::no_data_value<Element>};
+    Element const m{1'000'000};
+
+    auto const array = lue::test::create_partitioned_array<ElementArray>(
+        array_shape,
+        partition_shape,
+        {
+            // NOLINTBEGIN
+            // clang-format off
+            {
+                 m,  m,  0,
+                -m,  1,  0,
+                 0,  x,  m,
+            },
+            {
+                -m,  x, -m,
+                 m, -m,  m,
+                 0,  0,  x,
+            },
+            {
+                 m, -m,  x,
+                -m, -1,  m,
+                 0,  m, -m,
+            },
+            {
+                 m, -m,  0,
+                 0,  x,  m,
+                 x,  m, -m,
+            },
+            // clang-format on
+            // NOLINTEND
+        });
+    auto const kernel = lue::box_kernel<lue::BooleanElement, 2>(1, 1);
+    auto const result_we_got = lue::value_policies::focal_majority(array, kernel);
+    auto const result_we_want = lue::test::create_partitioned_array<ElementArray>(
+        array_shape,
+        partition_shape,
+        {
+            // NOLINTBEGIN
+            // clang-format off
+            {
+                 m,  0,  0,
+                 m,  0,  0,
+                -m, -m,  m,
+            },
+            {
+                -m, -m, -m,
+                 0, -m, -m,
+                 0,  0, -m,
+            },
+            {
+                -m,  m,  m,
+                -m, -m,  m,
+                -m, -m,  m,
+            },
+            {
+                 0,  0,  0,
+                 m,  m, -m,
+                 m,  m,  m,
+            },
+            // clang-format on
+            // NOLINTEND
+        });
+
+    lue::test::check_arrays_are_equal(result_we_got, result_we_want);
+}
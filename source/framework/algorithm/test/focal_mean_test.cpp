@@ -95,3 +95,84 @@ BOOST_AUTO_TEST_CASE(all_no_data)
 
     lue::test::check_arrays_are_equal(result_we_got, result_we_want);
 }
+
+
+BOOST_AUTO_TEST_CASE(box_kernel_no_data_in_window)
+{
+    // Box kernels are handled by running sums over whole partitions. No-data cells must be kept
+    // out of these sums, also when they span partition borders. The window of the cell in the
+    // center of the no-data block contains only no-data cells.
+    using Element = lue::FloatingPointElement<0>;
+    std::size_t const rank = 2;
+
+    using ElementArray = lue::PartitionedArray<Element, rank>;
+    using Shape = lue::ShapeT<ElementArray>;
+
+    Shape const array_shape{{6, 8}};
+    Shape const partition_shape{{3, 4}};
+
+    Element const x{lue::policy::no_data_value<Element>};
+
+    auto const array = lue::test::create_partitioned_array<ElementArray>(
+        array_shape,
+        partition_shape,
+        {
+            // NOLINTBEGIN
+            // clang-format off
+            {
+                 3, -1,  4,  1,
+                 5,  3,  x,  x,
+                -9,  3,  x,  x,
+            },
+            {
+                -5,  9,  2, -6,
+                 x,  8, -9,  7,
+                 x, -2,  3,  8,
+            },
+            {
+                 4, -6,  x,  x,
+                 7,  9, -5,  2,
+                -9,  7,  1,  x,
+            },
+            {
+                 x,  3,  x,  2,
+                 8, -8,  4,  1,
+                 6,  4, -2,  6,
+            },
+            // clang-format on
+            // NOLINTEND
+        });
+    auto const kernel = lue::box_kernel<lue::BooleanElement, 2>(1, 1);
+    auto const result_we_got = lue::value_policies::focal_mean(array, kernel);
+    auto const result_we_want = lue::test::create_partitioned_array<ElementArray>(
+        array_shape,
+        partition_shape,
+        {
+            // NOLINTBEGIN
+            // clang-format off
+            {
+                 2.5000,  2.8000,  1.7500,  0.0000,
+                 0.6667,  1.1429,  2.0000,  0.0000,
+                 0.0000,  0.0000,  0.0000,       x,
+            },
+            {
+                 3.2500,  1.0000,  1.8333, -1.5000,
+                 2.2000,  0.8571,  2.2222,  0.8333,
+                 3.0000,  0.6000,  2.5000,  2.2000,
+            },
+            {
+                 1.3333,  0.4286,  0.6000,  1.6667,
+                 2.0000,  1.0000,  1.3333,  2.4000,
+                 3.5000,  1.6667,  2.8000,  2.4000,
+            },
+            {
+                 0.6000,  1.3333,  1.3750,  3.6000,
+                 2.5000,  2.1429,  1.2500,  2.2000,
+                 2.4000,  2.0000,  0.8333,  2.2500,
+            },
+            // clang-format on
+            // NOLINTEND
+        });
+
+    lue::test::check_arrays_are_close(result_we_got, result_we_want, Element{1e-3});
+}
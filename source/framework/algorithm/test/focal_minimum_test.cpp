@@ -95,3 +95,101 @@ BOOST_AUTO_TEST_CASE(all_no_data)
 
     lue::test::check_arrays_are_equal(result_we_got, result_we_want);
 }
+
+
+BOOST_AUTO_TEST_CASE(box_kernel_no_data_in_window)
+{
+    // Box kernels are handled by the van Herk / Gil-Werman algorithm, which splits rows and
+    // columns of the padded tile in blocks of kernel size. The padded tiles here are not a multiple
+    // of the kernel size, extremes are located next to the partition borders, and the window of
+    // the cell in the north-west corner contains only no-data cells.
+    using Element = lue::LargestSignedIntegralElement;
+    std::size_t const rank = 2;
+
+    using ElementArray = lue::PartitionedArray<Element, rank>;
+    using Shape = lue::ShapeT<ElementArray>;
+
+    Shape const array_shape{{10, 14}};
+    Shape const partition_shape{{5, 7}};
+
+    Element const x{lue::policy::no_data_value<Element>};
+
+    auto const array = lue::test::create_partitioned_array<ElementArray>(
+        array_shape,
+        partition_shape,
+        {
+            // NOLINTBEGIN
+            // clang-format off
+            {
+                  x,   x,   x, -25,   1,  18, -14,
+                  x,   x,   x,  19, -29, -13,   1,
+                  x,   x,   x, -18,   6,   5,  14,
+                -25,  24,  -3,  -9, -25,  -7,  21,
+                -18,  14,  10,  20, -12, -24,   x,
+            },
+            {
+                -28, -30, -21,  12,   7,   0,  45,
+                 21, -18,  16,  25,  -4,  28,   4,
+                 21,  16, -14,   x,  21,   9,  13,
+                 -4,  21, -14,  -2,  14, -24,  18,
+                -50,   7,  27, -18,  22,  11,  28,
+            },
+            {
+                 -7,   1,  29,  23,  28, -18,  50,
+                -29,  10,  -7, -15,   8,  -3, -11,
+                  3, -18, -23,   x,  12, -13, -11,
+                -17,  23,  25,  26,  14,   3, -30,
+                -45,  12,   9,   9, -11,  -7,  -6,
+            },
+            {
+                  x,  11,  14,  27,  21,   2,  28,
+                 -8,   7, -23, -25,   2,   x,  13,
+                 16, -18,  -6,   0, -16, -22,   8,
+                -18,  19, -20, -29,  11,  -9,   5,
+                  3,  -6, -12, -22,  13,   1,   x,
+            },
+            // clang-format on
+            // NOLINTEND
+        });
+    auto const kernel = lue::box_kernel<lue::BooleanElement, 2>(2, 1);
+    auto const result_we_got = lue::value_policies::focal_minimum(array, kernel);
+    auto const result_we_want = lue::test::create_partitioned_array<ElementArray>(
+        array_shape,
+        partition_shape,
+        {
+            // NOLINTBEGIN
+            // clang-format off
+            {
+                  x, -25, -29, -29, -29, -29, -30,
+                -25, -25, -29, -29, -29, -29, -30,
+                -25, -25, -29, -29, -29, -50, -50,
+                -25, -25, -29, -29, -29, -50, -50,
+                -29, -29, -29, -25, -25, -50, -50,
+            },
+            {
+                -30, -30, -30, -30, -21,  -4,  -4,
+                -30, -30, -30, -30, -24, -24, -24,
+                -50, -50, -50, -30, -24, -24, -24,
+                -50, -50, -50, -24, -24, -24, -24,
+                -50, -50, -50, -25, -25, -25, -24,
+            },
+            {
+                -29, -29, -29, -25, -25, -50, -50,
+                -29, -29, -29, -24, -30, -50, -50,
+                -45, -45, -45, -23, -30, -30, -30,
+                -45, -45, -45, -23, -30, -30, -30,
+                -45, -45, -45, -23, -30, -30, -30,
+            },
+            {
+                -50, -50, -50, -25, -25, -25, -24,
+                -50, -50, -50, -29, -29, -29, -22,
+                -30, -30, -29, -29, -29, -29, -22,
+                -30, -30, -29, -29, -29, -29, -22,
+                -30, -30, -29, -29, -29, -29, -22,
+            },
+            // clang-format on
+            // NOLINTEND
+        });
+
+    lue::test::check_arrays_are_equal(result_we_got, result_we_want);
+}
@@ -1,6 +1,7 @@
 #define BOOST_TEST_MODULE lue framework algorithm focal_operation
 #include "lue/framework/algorithm/create_partitioned_array.hpp"
 #include "lue/framework/algorithm/definition/focal_operation.hpp"
+#include "lue/framework/algorithm/definition/iterate_focal_operation.hpp"
 #include "lue/framework/algorithm/kernel.hpp"
 #include "lue/framework/algorithm/policy/default_policies.hpp"
 #include "lue/framework/algorithm/serialize/kernel.hpp"
@@ -56,6 +57,44 @@ class Functor
 };
 
 
+template<typename Element>
+class SumFunctor
+{
+
+    public:
+
+        using OutputElement = Element;
+
+        static constexpr char const* name{"sum_functor"};
+
+        SumFunctor() = default;
+
+        template<typename Kernel, typename OutputPolicies, typename InputPolicies, typename Subspan>
+        auto operator()(
+            Kernel const& kernel,
+            [[maybe_unused]] OutputPolicies const& output_policies,
+            [[maybe_unused]] InputPolicies const& input_policies,
+            Subspan const& window) const -> OutputElement
+        {
+            // Return the sum of the values in the window for which the kernel is true
+            OutputElement sum{0};
+
+            for (lue::Index idx0 = 0; idx0 < window.extent(0); ++idx0)
+            {
+                for (lue::Index idx1 = 0; idx1 < window.extent(1); ++idx1)
+                {
+                    if (kernel(idx0, idx1))
+                    {
+                        sum += window[idx0, idx1];
+                    }
+                }
+            }
+
+            return sum;
+        }
+};
+
+
 template<typename OutputElement, typename... InputElement>
 using DefaultPolicies = lue::policy::DefaultSpatialOperationPolicies<
     lue::policy::AllValuesWithinDomain<InputElement...>,
@@ -152,3 +191,57 @@ BOOST_AUTO_TEST_CASE(binary_focal_operation_2d)
 
     lue::test::check_arrays_are_equal(output_array, array_we_want);
 }
+
+
+BOOST_AUTO_TEST_CASE(iterate_focal_operation_2d)
+{
+    using Element = lue::LargestSignedIntegralElement;
+
+    using Functor = ::SumFunctor<Element>;
+    using Policies = ::DefaultPolicies<Element, Element>;
+
+    // Cells outside of the array must contain the fill value in each iteration
+    Element const fill_value{1};
+
+    std::size_t const rank = 2;
+
+    using Array = lue::PartitionedArray<Element, rank>;
+    using Shape = lue::ShapeT<Array>;
+
+    Shape const array_shape{{9, 9}};
+    Shape const partition_shape{{3, 3}};
+
+    auto const array = lue::test::create_partitioned_array<Array>(
+        array_shape,
+        partition_shape,
+        {
+            {1, 2, 3, 4, 5, 6, 7, 8, 9},
+            {2, 3, 4, 5, 6, 7, 8, 9, 1},
+            {3, 4, 5, 6, 7, 8, 9, 1, 2},
+            {4, 5, 6, 7, 8, 9, 1, 2, 3},
+            {5, 6, 7, 8, 9, 1, 2, 3, 4},
+            {6, 7, 8, 9, 1, 2, 3, 4, 5},
+            {7, 8, 9, 1, 2, 3, 4, 5, 6},
+            {8, 9, 1, 2, 3, 4, 5, 6, 7},
+            {9, 1, 2, 3, 4, 5, 6, 7, 8},
+        });
+
+    auto const kernel = lue::box_kernel<lue::BooleanElement, rank>(1, true);
+
+    // Iterating n times requires a halo of n cells wide, which must fit in the partitions
+    for (lue::Count const nr_iterations : {1, 2, 3})
+    {
+        Array array_we_want = lue::focal_operation(Policies{fill_value}, array, kernel, Functor{});
+
+        for (lue::Count iteration = 1; iteration < nr_iterations; ++iteration)
+        {
+            Array result = lue::focal_operation(Policies{fill_value}, array_we_want, kernel, Functor{});
+            array_we_want = std::move(result);
+        }
+
+        Array const array_we_got =
+            lue::iterate_focal_operation(Policies{fill_value}, array, kernel, Functor{}, nr_iterations);
+
+        lue::test::check_arrays_are_equal(array_we_got, array_we_want);
+    }
+}
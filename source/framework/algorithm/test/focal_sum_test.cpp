@@ -95,3 +95,709 @@ BOOST_AUTO_TEST_CASE(all_no_data)
 
     lue::test::check_arrays_are_equal(result_we_got, result_we_want);
 }
+
+
+BOOST_AUTO_TEST_CASE(non_finite_values)
+{
+    // Infinite values must not affect the sums of windows which do not contain them. Running sums
+    // would turn into NaN after subtracting them.
+    using Element = lue::FloatingPointElement<0>;
+    std::size_t const rank = 2;
+
+    using ElementArray = lue::PartitionedArray<Element, rank>;
+    using Shape = lue::ShapeT<ElementArray>;
+
+    Shape const array_shape{{4, 6}};
+    Shape const partition_shape{{2, 3}};
+
+    Element const x{lue::policy::no_data_value<Element>};
+    Element const i{std::numeric_limits<Element>::infinity()};
+
+    auto const array = lue::test::create_partitioned_array<ElementArray>(
+        array_shape,
+        partition_shape,
+        {
+            // NOLINTBEGIN
+            // clang-format off
+            {
+                1, 1, 1,
+                1, 1, i,
+            },
+            {
+                1,  1, 1,
+                1,  1, 1,
+            },
+            {
+                1, 1, 1,
+                1, 1, 1,
+            },
+            {
+                1, -i, 1,
+                1,  1, x,
+            },
+            // clang-format on
+            // NOLINTEND
+        });
+    auto const kernel = lue::box_kernel<lue::BooleanElement, 2>(1, 1);
+    auto const result_we_got = lue::value_policies::focal_sum(array, kernel);
+
+    // Windows containing both positive and negative infinity sum to NaN, which is no-data
+    auto const result_we_want = lue::test::create_partitioned_array<ElementArray>(
+        array_shape,
+        partition_shape,
+        {
+            // NOLINTBEGIN
+            // clang-format off
+            {
+                4, i, i,
+                6, i, i,
+            },
+            {
+                i,  6,  4,
+                x, -i, -i,
+            },
+            {
+                6, i, i,
+                4, 6, 6,
+            },
+            {
+                 x, -i, -i,
+                -i, -i, -i,
+            },
+            // clang-format on
+            // NOLINTEND
+        });
+
+    lue::test::check_arrays_are_equal(result_we_got, result_we_want);
+}
+
+
+BOOST_AUTO_TEST_CASE(box_kernel_no_data_in_window)
+{
+    // Box kernels are handled by running sums over whole partitions. No-data cells must be kept
+    // out of these sums, also when they span partition borders. The window of the cell in the
+    // center of the no-data block contains only no-data cells.
+    using Element = lue::LargestSignedIntegralElement;
+    std::size_t const rank = 2;
+
+    using ElementArray = lue::PartitionedArray<Element, rank>;
+    using Shape = lue::ShapeT<ElementArray>;
+
+    Shape const array_shape{{6, 8}};
+    Shape const partition_shape{{3, 4}};
+
+    Element const x{lue::policy::no_data_value<Element>};
+
+    auto const array = lue::test::create_partitioned_array<ElementArray>(
+        array_shape,
+        partition_shape,
+        {
+            // NOLINTBEGIN
+            // clang-format off
+            {
+                 3, -1,  4,  1,
+                 5,  3,  x,  x,
+                -9,  3,  x,  x,
+            },
+            {
+                -5,  9,  2, -6,
+                 x,  8, -9,  7,
+                 x, -2,  3,  8,
+            },
+            {
+                 4, -6,  x,  x,
+                 7,  9, -5,  2,
+                -9,  7,  1,  x,
+            },
+            {
+                 x,  3,  x,  2,
+                 8, -8,  4,  1,
+                 6,  4, -2,  6,
+            },
+            // clang-format on
+            // NOLINTEND
+        });
+    auto const kernel = lue::box_kernel<lue::BooleanElement, 2>(1, 1);
+    auto const result_we_got = lue::value_policies::focal_sum(array, kernel);
+    auto const result_we_want = lue::test::create_partitioned_array<ElementArray>(
+        array_shape,
+        partition_shape,
+        {
+            // NOLINTBEGIN
+            // clang-format off
+            {
+                10, 14,  7,  0,
+                 4,  8, 10,  0,
+                 0,  0,  0,  x,
+            },
+            {
+                13,  5, 11, -6,
+                11,  6, 20,  5,
+                 9,  3, 20, 11,
+            },
+            {
+                 8,  3,  3,  5,
+                12,  8,  8, 12,
+                14, 10, 14, 12,
+            },
+            {
+                 3,  8, 11, 18,
+                15, 15, 10, 11,
+                12, 12,  5,  9,
+            },
+            // clang-format on
+            // NOLINTEND
+        });
+
+    lue::test::check_arrays_are_equal(result_we_got, result_we_want);
+}
+
+
+BOOST_AUTO_TEST_CASE(multiple_partitions_separable_kernel)
+{
+    // Separable kernels which are not box kernels are handled by a two-pass algorithm
+    using Element = lue::LargestSignedIntegralElement;
+    std::size_t const rank = 2;
+
+    using ElementArray = lue::PartitionedArray<Element, rank>;
+    using Shape = lue::ShapeT<ElementArray>;
+
+    Shape const array_shape{{10, 10}};
+    Shape const partition_shape{{5, 5}};
+
+    Element const x{lue::policy::no_data_value<Element>};
+
+    auto const array = lue::test::create_partitioned_array<ElementArray>(
+        array_shape,
+        partition_shape,
+        {
+            // NOLINTBEGIN
+            // clang-format off
+            {
+                 -5,   2,  -2,   5,   1,
+                 -2,   x,   1,  -3,   4,
+                  1,  -3,   4,   0,  -4,
+                  4,   0,  -4,   3,  -1,
+                 -4,   3,  -1,  -5,   2,
+            },
+            {
+                 -3,   4,   0,  -4,   3,
+                  0,  -4,   3,  -1,  -5,
+                  3,  -1,  -5,   2,  -2,
+                 -5,   2,  -2,   5,   1,
+                  x,   5,   1,  -3,   4,
+            },
+            {
+                 -1,  -5,   2,  -2,   x,
+                  2,  -2,   5,   1,  -3,
+                  5,   1,  -3,   4,   0,
+                 -3,   4,   0,  -4,   3,
+                  x,  -4,   3,  -1,  -5,
+            },
+            {
+                  1,  -3,   4,   0,  -4,
+                  4,   0,  -4,   3,  -1,
+                 -4,   3,  -1,   x,   2,
+                 -1,  -5,   2,  -2,   5,
+                  2,  -2,   5,   1,  -3,
+            },
+            // clang-format on
+            // NOLINTEND
+        });
+
+    // clang-format off
+    lue::Kernel<lue::BooleanElement, 2> const kernel{
+        Shape{{5, 5}},
+        {
+            0, 0, 0, 0, 0,
+            1, 1, 1, 1, 1,
+            1, 1, 1, 1, 1,
+            1, 1, 1, 1, 1,
+            0, 0, 0, 0, 0,
+        }};
+    // clang-format on
+    auto const result_we_got = lue::value_policies::focal_sum(array, kernel);
+    auto const result_we_want = lue::test::create_partitioned_array<ElementArray>(
+        array_shape,
+        partition_shape,
+        {
+            // NOLINTBEGIN
+            // clang-format off
+            {
+                 -6,  -4,   1,   5,   3,
+                 -4,  -2,  -1,   5,   5,
+                  1,   1,   0,  -5,  -5,
+                  0,  -2,  -5,  -8,  -2,
+                 -6, -10,  -9, -12,  -6,
+            },
+            {
+                  7,   0,  -7,  -4,  -4,
+                  0,  -5, -10, -10,  -9,
+                -10,  -4,  -9,  -7,  -4,
+                 -7,  -1,   5,   7,   1,
+                  0,   6,   6,  10,   6,
+            },
+            {
+                 -1,  -7,  -8,   0,   6,
+                  4,   7,   4,  -1,   5,
+                  9,  10,  10,   5,   0,
+                  3,   2,   0,  -5, -10,
+                  0,  -5,  -7,  -3, -10,
+            },
+            {
+                  1,   7,   7,   2,   0,
+                  0,   0,   0,  -1,  -1,
+                 -5,  -5,   1,   2,   4,
+                 -4,  -4,   2,   5,   9,
+                 -6,  -2,   2,   1,   8,
+            },
+
+            // clang-format on
+            // NOLINTEND
+        });
+
+    lue::test::check_arrays_are_equal(result_we_got, result_we_want);
+}
+
+
+BOOST_AUTO_TEST_CASE(successive_operations_on_same_array)
+{
+    // Focal operations on the same array share the halos of its partitions. Halos obtained for a
+    // larger kernel are also used for smaller kernels.
+    using Element = lue::LargestSignedIntegralElement;
+    std::size_t const rank = 2;
+
+    using ElementArray = lue::PartitionedArray<Element, rank>;
+    using Shape = lue::ShapeT<ElementArray>;
+
+    Shape const array_shape{{10, 10}};
+    Shape const partition_shape{{5, 5}};
+
+    Element const x{lue::policy::no_data_value<Element>};
+
+    auto const array = lue::test::create_partitioned_array<ElementArray>(
+        array_shape,
+        partition_shape,
+        {
+            // NOLINTBEGIN
+            // clang-format off
+            {
+                 -5,   2,  -2,   5,   1,
+                 -2,   x,   1,  -3,   4,
+                  1,  -3,   4,   0,  -4,
+                  4,   0,  -4,   3,  -1,
+                 -4,   3,  -1,  -5,   2,
+            },
+            {
+                 -3,   4,   0,  -4,   3,
+                  0,  -4,   3,  -1,  -5,
+                  3,  -1,  -5,   2,  -2,
+                 -5,   2,  -2,   5,   1,
+                  x,   5,   1,  -3,   4,
+            },
+            {
+                 -1,  -5,   2,  -2,   x,
+                  2,  -2,   5,   1,  -3,
+                  5,   1,  -3,   4,   0,
+                 -3,   4,   0,  -4,   3,
+                  x,  -4,   3,  -1,  -5,
+            },
+            {
+                  1,  -3,   4,   0,  -4,
+                  4,   0,  -4,   3,  -1,
+                 -4,   3,  -1,   x,   2,
+                 -1,  -5,   2,  -2,   5,
+                  2,  -2,   5,   1,  -3,
+            },
+            // clang-format on
+            // NOLINTEND
+        });
+    auto const result_we_want1 = lue::test::create_partitioned_array<ElementArray>(
+        array_shape,
+        partition_shape,
+        {
+            // NOLINTBEGIN
+            // clang-format off
+            {
+                 -5,  -6,   3,   6,   4,
+                 -7,  -4,   4,   6,   3,
+                  0,   1,  -2,   0,  -3,
+                  1,   0,  -3,  -6,  -7,
+                 -3,  -6,  -9,  -6,  -7,
+            },
+            {
+                  2,   0,  -2,  -4,  -7,
+                  0,  -3,  -6,  -9,  -7,
+                 -6,  -9,  -1,  -4,   0,
+                  1,  -2,   4,   1,   7,
+                  1,   3,   9,   6,   3,
+            },
+            {
+                 -7,  -1,  -4,  -1,  -2,
+                  0,   4,   1,   4,   1,
+                  7,   9,   6,   3,   0,
+                  3,   3,   0,  -3,  -6,
+                 -3,   0,  -2,  -4,  -6,
+            },
+            {
+                  6,   8,   3,   0,  -1,
+                 -2,   0,   2,  -1,   0,
+                 -3,  -6,  -4,   4,   7,
+                 -9,  -1,   1,   9,   3,
+                 -8,   1,  -1,   8,   1,
+            },
+            // clang-format on
+            // NOLINTEND
+        });
+    auto const result_we_want2 = lue::test::create_partitioned_array<ElementArray>(
+        array_shape,
+        partition_shape,
+        {
+            // NOLINTBEGIN
+            // clang-format off
+            {
+                 -4,  -2,  -1,   5,   5,
+                 -4,   1,   1,  -2,   0,
+                 -6,  -6,  -4,  -3,   1,
+                 -5, -12, -11, -10,  -6,
+                  1,  -2,  -8,  -7,   3,
+            },
+            {
+                  0,  -5, -10, -10,  -9,
+                 -3,  -6,  -9,  -4,  -5,
+                  0,  -1,  -2,   3,  -3,
+                 -7,   3,  -4,  -3,  -2,
+                 -9,   1,   5,   2,  -1,
+            },
+            {
+                  2,   3,   1,  -9,   1,
+                  3,  -3,  -1,   0,  -1,
+                  4,   2,  -3,  -4,  -5,
+                  8,   8,   3,   0,  -3,
+                  3,   2,   0,  -5, -10,
+            },
+            {
+                  0,   4,   8,  12,   5,
+                 -2,   2,   6,   6,   6,
+                 -6,  -2,   2,   0,   7,
+                 -6,  -4,   4,   3,   7,
+                 -4,  -4,   2,   5,   9,
+            },
+            // clang-format on
+            // NOLINTEND
+        });
+
+    for (lue::Radius const radius : {1, 2, 1, 2})
+    {
+        auto const kernel = lue::box_kernel<lue::BooleanElement, rank>(radius, 1);
+        auto const result_we_got = lue::value_policies::focal_sum(array, kernel);
+
+        lue::test::check_arrays_are_equal(result_we_got, radius == 1 ? result_we_want1 : result_we_want2);
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(modified_partition_between_operations)
+{
+    // Halos stored with the array must not be reused once the partitions they were copied from
+    // are modified, also not when this happens through a copy of a partition client
+    using Element = lue::LargestSignedIntegralElement;
+    std::size_t const rank = 2;
+
+    using ElementArray = lue::PartitionedArray<Element, rank>;
+    using Shape = lue::ShapeT<ElementArray>;
+
+    Shape const array_shape{{6, 6}};
+    Shape const partition_shape{{3, 3}};
+
+    auto const array = lue::test::create_partitioned_array<ElementArray>(
+        array_shape,
+        partition_shape,
+        {
+            // NOLINTBEGIN
+            // clang-format off
+            {
+                1, 1, 1,
+                1, 1, 1,
+                1, 1, 1,
+            },
+            {
+                1, 1, 1,
+                1, 1, 1,
+                1, 1, 1,
+            },
+            {
+                1, 1, 1,
+                1, 1, 1,
+                1, 1, 1,
+            },
+            {
+                1, 1, 1,
+                1, 1, 1,
+                1, 1, 1,
+            },
+            // clang-format on
+            // NOLINTEND
+        });
+    auto const kernel = lue::box_kernel<lue::BooleanElement, rank>(1, 1);
+    auto const result_we_want1 = lue::test::create_partitioned_array<ElementArray>(
+        array_shape,
+        partition_shape,
+        {
+            // NOLINTBEGIN
+            // clang-format off
+            {
+                4, 6, 6,
+                6, 9, 9,
+                6, 9, 9,
+            },
+            {
+                6, 6, 4,
+                9, 9, 6,
+                9, 9, 6,
+            },
+            {
+                6, 9, 9,
+                6, 9, 9,
+                4, 6, 6,
+            },
+            {
+                9, 9, 6,
+                9, 9, 6,
+                6, 6, 4,
+            },
+            // clang-format on
+            // NOLINTEND
+        });
+    auto const result_we_want2 = lue::test::create_partitioned_array<ElementArray>(
+        array_shape,
+        partition_shape,
+        {
+            // NOLINTBEGIN
+            // clang-format off
+            {
+                 8, 12, 10,
+                12, 18, 15,
+                10, 15, 13,
+            },
+            {
+                 8,  6,  4,
+                12,  9,  6,
+                11,  9,  6,
+            },
+            {
+                 8, 12, 11,
+                 6,  9,  9,
+                 4,  6,  6,
+            },
+            {
+                10,  9,  6,
+                 9,  9,  6,
+                 6,  6,  4,
+            },
+            // clang-format on
+            // NOLINTEND
+        });
+
+    lue::test::check_arrays_are_equal(lue::value_policies::focal_sum(array, kernel), result_we_want1);
+
+    auto partition{array.partitions()(0, 0)};
+    partition.fill(hpx::launch::sync, 2);
+
+    lue::test::check_arrays_are_equal(lue::value_policies::focal_sum(array, kernel), result_we_want2);
+}
+
+
+BOOST_AUTO_TEST_CASE(multiple_partitions_circle_kernel)
+{
+    // Kernels which are not separable are handled by only visiting the cells with a non-zero weight
+    using Element = lue::LargestSignedIntegralElement;
+    std::size_t const rank = 2;
+
+    using ElementArray = lue::PartitionedArray<Element, rank>;
+    using Shape = lue::ShapeT<ElementArray>;
+
+    Shape const array_shape{{10, 10}};
+    Shape const partition_shape{{5, 5}};
+
+    Element const x{lue::policy::no_data_value<Element>};
+
+    auto const array = lue::test::create_partitioned_array<ElementArray>(
+        array_shape,
+        partition_shape,
+        {
+            // NOLINTBEGIN
+            // clang-format off
+            {
+                 -5,   2,  -2,   5,   1,
+                 -2,   x,   1,  -3,   4,
+                  1,  -3,   4,   0,  -4,
+                  4,   0,  -4,   3,  -1,
+                 -4,   3,  -1,  -5,   2,
+            },
+            {
+                 -3,   4,   0,  -4,   3,
+                  0,  -4,   3,  -1,  -5,
+                  3,  -1,  -5,   2,  -2,
+                 -5,   2,  -2,   5,   1,
+                  x,   5,   1,  -3,   4,
+            },
+            {
+                 -1,  -5,   2,  -2,   x,
+                  2,  -2,   5,   1,  -3,
+                  5,   1,  -3,   4,   0,
+                 -3,   4,   0,  -4,   3,
+                  x,  -4,   3,  -1,  -5,
+            },
+            {
+                  1,  -3,   4,   0,  -4,
+                  4,   0,  -4,   3,  -1,
+                 -4,   3,  -1,   x,   2,
+                 -1,  -5,   2,  -2,   5,
+                  2,  -2,   5,   1,  -3,
+            },
+            // clang-format on
+            // NOLINTEND
+        });
+
+    auto const kernel = lue::circle_kernel<lue::BooleanElement, rank>(2, 1);
+    auto const result_we_got = lue::value_policies::focal_sum(array, kernel);
+
+    auto const result_we_want = lue::test::create_partitioned_array<ElementArray>(
+        array_shape,
+        partition_shape,
+        {
+            // NOLINTBEGIN
+            // clang-format off
+            {
+                 -6,  -4,   3,   5,   2,
+                 -2,  -7,   2,   9,  -1,
+                 -5,   6,  -8,   0,   3,
+                 -6,  -2,   3, -16,  -5,
+                 -1, -16,  -2,  -2, -10,
+            },
+            {
+                 10,  -4,  -7,   2,  -9,
+                 -5,   2, -13,  -8,  -3,
+                -14,  -2,   1, -12,   2,
+                  3,  -5,   7,   2,  -4,
+                  4,   1,   4,  16,   1,
+            },
+            {
+                  4,  -2, -12,   2,  -4,
+                 -2,  12,  -1,  -3,  11,
+                  3,   4,  16,  -3,  -5,
+                  5,  -3,   5,   1, -14,
+                  5,   0, -10,  -2,  -5,
+            },
+            {
+                 -1,  13,  -3,   2,   6,
+                 -6,   0,   8,  -6,   5,
+                  3, -11,   3,   8,  -1,
+                 -7,   0,   1,   7,   4,
+                 -8,   0,  -3,   6,   8,
+            },
+            // clang-format on
+            // NOLINTEND
+        });
+
+    lue::test::check_arrays_are_equal(result_we_got, result_we_want);
+}
+
+
+BOOST_AUTO_TEST_CASE(weighted_kernel)
+{
+    // Kernels with weights other than zero and one are handled per cell instead of per partition.
+    // Integral weights only select the values to sum, so both must result in the same values.
+    using Element = lue::LargestSignedIntegralElement;
+    std::size_t const rank = 2;
+
+    using ElementArray = lue::PartitionedArray<Element, rank>;
+    using Shape = lue::ShapeT<ElementArray>;
+
+    Shape const array_shape{{6, 8}};
+    Shape const partition_shape{{3, 4}};
+
+    Element const x{lue::policy::no_data_value<Element>};
+
+    auto const array = lue::test::create_partitioned_array<ElementArray>(
+        array_shape,
+        partition_shape,
+        {
+            // NOLINTBEGIN
+            // clang-format off
+            {
+                 3, -1,  4,  1,
+                 5,  3,  x,  x,
+                -9,  3,  x,  x,
+            },
+            {
+                -5,  9,  2, -6,
+                 x,  8, -9,  7,
+                 x, -2,  3,  8,
+            },
+            {
+                 4, -6,  x,  x,
+                 7,  9, -5,  2,
+                -9,  7,  1,  x,
+            },
+            {
+                 x,  3,  x,  2,
+                 8, -8,  4,  1,
+                 6,  4, -2,  6,
+            },
+            // clang-format on
+            // NOLINTEND
+        });
+
+    // clang-format off
+    lue::Kernel<lue::BooleanElement, 2> const weighted_kernel{
+        Shape{{3, 3}},
+        {
+            0, 2, 0,
+            2, 1, 2,
+            0, 2, 0,
+        }};
+    lue::Kernel<lue::BooleanElement, 2> const unweighted_kernel{
+        Shape{{3, 3}},
+        {
+            0, 1, 0,
+            1, 1, 1,
+            0, 1, 0,
+        }};
+    // clang-format on
+    auto const result_we_want = lue::test::create_partitioned_array<ElementArray>(
+        array_shape,
+        partition_shape,
+        {
+            // NOLINTBEGIN
+            // clang-format off
+            {
+                  7,   9,   4,   0,
+                  2,  10,   7,   1,
+                  3,  -9,   3,   x,
+            },
+            {
+                  5,  14,  -4,   3,
+                  3,   6,  11,   0,
+                 -2,  12,   0,  20,
+            },
+            {
+                 -4,  10, -11,   2,
+                 11,  12,   7,   5,
+                  5,   8,   3,   9,
+            },
+            {
+                 11,  -7,  12,  11,
+                  8,  11,  -5,  13,
+                 18,   0,  12,   5,
+            },
+            // clang-format on
+            // NOLINTEND
+        });
+
+    lue::test::check_arrays_are_equal(
+        lue::value_policies::focal_sum(array, weighted_kernel), result_we_want);
+    lue::test::check_arrays_are_equal(
+        lue::value_policies::focal_sum(array, unweighted_kernel), result_we_want);
+}
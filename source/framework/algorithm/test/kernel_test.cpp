@@ -2,7 +2,11 @@
 #include "lue/framework/algorithm/kernel.hpp"
 #include "lue/framework/test/stream.hpp"
 #include <hpx/config.hpp>
+#include <algorithm>
+#include <array>
 #include <boost/test/included/unit_test.hpp>
+#include <cstdint>
+#include <vector>
 
 
 BOOST_AUTO_TEST_CASE(kernel_bool_1d)
@@ -176,3 +180,158 @@ BOOST_AUTO_TEST_CASE(circle_kernel_bool_2d)
         BOOST_CHECK_EQUAL(kernel(4, 4), false);
     }
 }
+
+
+BOOST_AUTO_TEST_CASE(kernel_factors_box_kernel)
+{
+    using Weight = bool;
+    lue::Rank const rank = 2;
+
+    auto const kernel = lue::box_kernel<Weight, rank>(2, true);
+    auto const factors = lue::kernel_factors(kernel);
+
+    BOOST_REQUIRE(factors);
+    BOOST_CHECK_EQUAL(factors->weights0.size(), 5u);
+    BOOST_CHECK_EQUAL(factors->weights1.size(), 5u);
+    BOOST_CHECK(std::all_of(factors->weights0.begin(), factors->weights0.end(), [](bool w) { return w; }));
+    BOOST_CHECK(std::all_of(factors->weights1.begin(), factors->weights1.end(), [](bool w) { return w; }));
+}
+
+
+BOOST_AUTO_TEST_CASE(kernel_factors_circle_kernel)
+{
+    using Weight = bool;
+    lue::Rank const rank = 2;
+
+    auto const kernel = lue::circle_kernel<Weight, rank>(2, true);
+
+    BOOST_CHECK(!lue::kernel_factors(kernel));
+}
+
+
+BOOST_AUTO_TEST_CASE(kernel_factors_outer_product)
+{
+    using Weight = float;
+    lue::Rank const rank = 2;
+    using Kernel = lue::Kernel<Weight, rank>;
+    using Shape = lue::ShapeT<Kernel>;
+
+    // clang-format off
+    Kernel kernel{
+        Shape{{3, 3}},
+        {
+            0.5f, 1.0f, 0.5f,
+            1.0f, 2.0f, 1.0f,
+            0.5f, 1.0f, 0.5f,
+        }};
+    // clang-format on
+
+    {
+        auto const factors = lue::kernel_factors(kernel);
+
+        BOOST_REQUIRE(factors);
+
+        for (lue::Index idx0 = 0; idx0 < 3; ++idx0)
+        {
+            for (lue::Index idx1 = 0; idx1 < 3; ++idx1)
+            {
+                BOOST_CHECK_CLOSE(
+                    factors->weights0[idx0] * factors->weights1[idx1], kernel(idx0, idx1), 1e-4);
+            }
+        }
+    }
+
+    {
+        kernel(0, 0) = 1.0f;
+
+        BOOST_CHECK(!lue::kernel_factors(kernel));
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(kernel_runs_circle_kernel)
+{
+    using Weight = std::int32_t;
+    lue::Rank const rank = 2;
+
+    auto const kernel = lue::circle_kernel<Weight, rank>(2, 1);
+    auto const runs = lue::kernel_runs(kernel);
+
+    // Per row, a single run, centred on the center column
+    BOOST_REQUIRE_EQUAL(runs.size(), 5u);
+
+    std::array<lue::Index, 5> const idxs1{2, 1, 0, 1, 2};
+    std::array<std::size_t, 5> const nr_weights{1, 3, 5, 3, 1};
+
+    for (std::size_t idx = 0; idx < 5; ++idx)
+    {
+        BOOST_CHECK_EQUAL(runs[idx].idx0, static_cast<lue::Index>(idx));
+        BOOST_CHECK_EQUAL(runs[idx].idx1, idxs1[idx]);
+        BOOST_CHECK_EQUAL(runs[idx].weights.size(), nr_weights[idx]);
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(kernel_runs_annulus)
+{
+    using Weight = float;
+    lue::Rank const rank = 2;
+    using Kernel = lue::Kernel<Weight, rank>;
+    using Shape = lue::ShapeT<Kernel>;
+
+    // clang-format off
+    Kernel const kernel{
+        Shape{{3, 3}},
+        {
+            1.0f, 2.0f, 3.0f,
+            4.0f, 0.0f, 5.0f,
+            6.0f, 7.0f, 8.0f,
+        }};
+    // clang-format on
+
+    auto const runs = lue::kernel_runs(kernel);
+
+    // The center row contains two runs, separated by the zero weight
+    BOOST_REQUIRE_EQUAL(runs.size(), 4u);
+
+    BOOST_CHECK_EQUAL(runs[0].idx0, 0);
+    BOOST_CHECK_EQUAL(runs[0].idx1, 0);
+    BOOST_CHECK(runs[0].weights == (std::vector<Weight>{1.0f, 2.0f, 3.0f}));
+
+    BOOST_CHECK_EQUAL(runs[1].idx0, 1);
+    BOOST_CHECK_EQUAL(runs[1].idx1, 0);
+    BOOST_CHECK(runs[1].weights == (std::vector<Weight>{4.0f}));
+
+    BOOST_CHECK_EQUAL(runs[2].idx0, 1);
+    BOOST_CHECK_EQUAL(runs[2].idx1, 2);
+    BOOST_CHECK(runs[2].weights == (std::vector<Weight>{5.0f}));
+
+    BOOST_CHECK_EQUAL(runs[3].idx0, 2);
+    BOOST_CHECK_EQUAL(runs[3].idx1, 0);
+    BOOST_CHECK(runs[3].weights == (std::vector<Weight>{6.0f, 7.0f, 8.0f}));
+}
+
+
+BOOST_AUTO_TEST_CASE(is_unweighted_kernel)
+{
+    using Weight = std::uint8_t;
+    lue::Rank const rank = 2;
+    using Kernel = lue::Kernel<Weight, rank>;
+    using Shape = lue::ShapeT<Kernel>;
+
+    BOOST_CHECK(lue::is_unweighted_kernel(lue::box_kernel<Weight, rank>(2, 1)));
+    BOOST_CHECK(lue::is_unweighted_kernel(lue::circle_kernel<Weight, rank>(2, 1)));
+    BOOST_CHECK(!lue::is_unweighted_kernel(lue::box_kernel<Weight, rank>(2, 2)));
+
+    // clang-format off
+    Kernel const kernel{
+        Shape{{3, 3}},
+        {
+            0, 1, 0,
+            1, 2, 1,
+            0, 1, 0,
+        }};
+    // clang-format on
+
+    BOOST_CHECK(!lue::is_unweighted_kernel(kernel));
+}
@@ -371,3 +371,93 @@ BOOST_AUTO_TEST_CASE(random_input)
         BOOST_CHECK(outflow_we_got >= 0);
     }
 }
+
+
+BOOST_AUTO_TEST_CASE(newton_raphson_functions)
+{
+    using FloatingPoint = lue::FloatingPointElement<0>;
+
+    lue::detail::NonLinearKinematicWave<FloatingPoint> const kinematic_wave{
+        1,     // upstream_discharge
+        2,     // current_outflow
+        0.1,   // lateral_inflow
+        1.5,   // alpha
+        0.6,   // beta
+        15,    // time_step_duration
+        10};   // channel_length
+
+    // The functions evaluated together by the solver must equal the ones evaluated separately
+    for (FloatingPoint const new_discharge : {0.001, 0.5, 1.0, 3.0, 1000.0})
+    {
+        auto const [fq, dfq] = kinematic_wave(new_discharge);
+
+        BOOST_TEST(fq == kinematic_wave.fq(new_discharge), tt::tolerance(1e-6));
+        BOOST_TEST(dfq == kinematic_wave.dfq(new_discharge), tt::tolerance(1e-6));
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(newton_raphson_batch)
+{
+    using FloatingPoint = lue::FloatingPointElement<0>;
+
+    std::default_random_engine random_number_engine{};
+
+    std::uniform_real_distribution<FloatingPoint> discharge_distribution{0, 1000};
+    std::uniform_real_distribution<FloatingPoint> lateral_inflow_distribution{0, 1000};
+    std::uniform_real_distribution<FloatingPoint> alpha_distribution{0.5, 6.0};
+    std::uniform_real_distribution<FloatingPoint> beta_distribution{0.5, 2.0};
+    std::uniform_real_distribution<FloatingPoint> time_step_duration_distribution{1, 100};
+    std::uniform_real_distribution<FloatingPoint> channel_length_distribution{1, 100};
+
+    FloatingPoint const shared_beta{0.6};
+    std::size_t const nr_equations{1000};
+
+    std::vector<std::array<FloatingPoint, 7>> arguments(nr_equations);
+
+    for (std::size_t idx = 0; idx < nr_equations; ++idx)
+    {
+        FloatingPoint const channel_length{channel_length_distribution(random_number_engine)};
+
+        arguments[idx] = {
+            // Include cells without water from upstream
+            idx % 10 == 0 ? FloatingPoint{0} : discharge_distribution(random_number_engine),
+            idx % 10 == 0 ? FloatingPoint{0} : discharge_distribution(random_number_engine),
+            lateral_inflow_distribution(random_number_engine) / channel_length,
+            alpha_distribution(random_number_engine),
+            beta_distribution(random_number_engine),
+            time_step_duration_distribution(random_number_engine),
+            channel_length};
+    }
+
+    // Solving the equations together must result in the same discharges as solving them one by one
+    for (bool const share_beta : {false, true})
+    {
+        lue::detail::NonLinearKinematicWaveBatch<FloatingPoint> kinematic_waves{nr_equations};
+
+        for (auto& equation_arguments : arguments)
+        {
+            if (share_beta)
+            {
+                equation_arguments[4] = shared_beta;
+            }
+
+            kinematic_waves.push_back(
+                std::make_from_tuple<lue::detail::NonLinearKinematicWave<FloatingPoint>>(equation_arguments));
+        }
+
+        std::span<FloatingPoint const> const outflow_we_got{
+            share_beta ? kinematic_waves.iterate_to_new_discharges(shared_beta)
+                       : kinematic_waves.iterate_to_new_discharges()};
+
+        BOOST_REQUIRE_EQUAL(outflow_we_got.size(), nr_equations);
+
+        for (std::size_t idx = 0; idx < nr_equations; ++idx)
+        {
+            FloatingPoint const outflow_we_want{std::apply(
+                lue::detail::iterate_to_new_discharge<FloatingPoint>, arguments[idx])};
+
+            BOOST_TEST(outflow_we_got[idx] == outflow_we_want, tt::tolerance(1e-6));
+        }
+    }
+}
@@ -0,0 +1,121 @@
+#define BOOST_TEST_MODULE lue framework algorithm local_expression
+#include "lue/framework/algorithm/create_partitioned_array.hpp"
+#include "lue/framework/algorithm/definition/local_expression.hpp"
+#include "lue/framework/algorithm/value_policies/add.hpp"
+#include "lue/framework/algorithm/value_policies/all.hpp"
+#include "lue/framework/algorithm/value_policies/close_to.hpp"
+#include "lue/framework/algorithm/value_policies/divide.hpp"
+#include "lue/framework/algorithm/value_policies/equal_to.hpp"
+#include "lue/framework/algorithm/value_policies/multiply.hpp"
+#include "lue/framework/algorithm/value_policies/none.hpp"
+#include "lue/framework/algorithm/value_policies/sqrt.hpp"
+#include "lue/framework/algorithm/value_policies/uniform.hpp"
+#include "lue/framework/algorithm/value_policies/valid.hpp"
+#include "lue/framework/test/hpx_unit_test.hpp"
+#include "lue/framework.hpp"
+
+
+namespace lx = lue::local_expression;
+
+
+BOOST_AUTO_TEST_CASE(use_case_01)
+{
+    if constexpr (lue::BuildOptions::default_value_policies_enabled)
+    {
+        using namespace lue::value_policies;
+
+        using Element = lue::FloatingPointElement<0>;
+        lue::Rank const rank = 2;
+
+        using Array = lue::PartitionedArray<Element, rank>;
+
+        auto const array_shape{lue::Test<Array>::shape()};
+        auto const partition_shape{lue::Test<Array>::partition_shape()};
+
+        Array const a{lue::create_partitioned_array(array_shape, partition_shape, Element{3})};
+        Array const b{lue::create_partitioned_array(array_shape, partition_shape, Element{4})};
+        Array const c{lue::create_partitioned_array(array_shape, partition_shape, Element{5})};
+
+        auto const a_{lx::deferred(a)};
+        auto const b_{lx::deferred(b)};
+
+        Array const result{lx::evaluate(lx::sqrt(a_ * a_ + b_ * b_) / lx::deferred(c))};
+
+        BOOST_CHECK(all(result == Element{1}).future().get());
+        BOOST_CHECK(all(Array{lx::evaluate(Element{2} * a_ - Element{1})} == Element{5}).future().get());
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(compare_with_local_operations)
+{
+    if constexpr (lue::BuildOptions::default_value_policies_enabled)
+    {
+        using namespace lue::value_policies;
+
+        using Element = lue::FloatingPointElement<0>;
+        using BooleanElement = lue::BooleanElement;
+        lue::Rank const rank = 2;
+
+        using Array = lue::PartitionedArray<Element, rank>;
+
+        auto const array_shape{lue::Test<Array>::shape()};
+        auto const partition_shape{lue::Test<Array>::partition_shape()};
+
+        Array const a{uniform(array_shape, partition_shape, Element{1}, Element{10})};
+        Array const b{uniform(array_shape, partition_shape, Element{1}, Element{10})};
+        Array const c{uniform(array_shape, partition_shape, Element{1}, Element{10})};
+
+        Array const expected{divide(sqrt(add(multiply(a, a), multiply(b, b))), c)};
+
+        auto const a_{lx::deferred(a)};
+        auto const b_{lx::deferred(b)};
+
+        Array const result{lx::evaluate(lx::sqrt(a_ * a_ + b_ * b_) / lx::deferred(c))};
+
+        BOOST_CHECK(all(close_to<BooleanElement>(result, expected)).future().get());
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(no_data)
+{
+    if constexpr (lue::BuildOptions::default_value_policies_enabled)
+    {
+        using namespace lue::value_policies;
+
+        using Element = lue::FloatingPointElement<0>;
+        using BooleanElement = lue::BooleanElement;
+        lue::Rank const rank = 2;
+
+        using Array = lue::PartitionedArray<Element, rank>;
+
+        auto const array_shape{lue::Test<Array>::shape()};
+        auto const partition_shape{lue::Test<Array>::partition_shape()};
+
+        Array const a{lue::create_partitioned_array(array_shape, partition_shape, Element{4})};
+        Array const zero{lue::create_partitioned_array(array_shape, partition_shape, Element{0})};
+        Array const no_data{divide(a, zero)};
+
+        // Input element is no-data
+        {
+            Array const result{lx::evaluate(lx::deferred(no_data) + Element{1})};
+
+            BOOST_CHECK(none(valid<BooleanElement>(result)).future().get());
+        }
+
+        // Divide by zero
+        {
+            Array const result{lx::evaluate(lx::deferred(a) / lx::deferred(zero))};
+
+            BOOST_CHECK(none(valid<BooleanElement>(result)).future().get());
+        }
+
+        // Intermediate value outside of the domain of sqrt
+        {
+            Array const result{lx::evaluate(lx::sqrt(-lx::deferred(a)) + Element{1})};
+
+            BOOST_CHECK(none(valid<BooleanElement>(result)).future().get());
+        }
+    }
+}
@@ -70,3 +70,64 @@ BOOST_AUTO_TEST_CASE(use_case_01)
 
     lue::test::check_arrays_are_equal(zonal_minimum, array_we_want);
 }
+
+
+BOOST_AUTO_TEST_CASE(zone_with_no_data_partition)
+{
+    using Value = lue::SignedIntegralElement<0>;
+    using Class = lue::UnsignedIntegralElement<0>;
+    std::size_t const rank = 2;
+
+    using ValueArray = lue::PartitionedArray<Value, rank>;
+    using ClassArray = lue::PartitionedArray<Class, rank>;
+    using Shape = lue::ShapeT<ValueArray>;
+
+    Shape const array_shape{{6, 6}};
+    Shape const partition_shape{{3, 3}};
+
+    Value const vx{lue::policy::no_data_value<Value>};  // Value no-data
+
+    // Zone 1 occurs in the upper left partition, whose values are all no-data, and in the lower right
+    // one. All values of zone 3 are no-data.
+    // NOLINTBEGIN
+    // clang-format off
+    ValueArray value_array = lue::test::create_partitioned_array<ValueArray>(
+        array_shape,
+        partition_shape,
+        {
+            {vx, vx, vx, vx, vx, vx, vx, vx, vx},
+            {5, 2, 9, 4, 3, 8, 7, 6, 1},
+            {vx, vx, vx, vx, vx, vx, vx, vx, vx},
+            {15, 12, 19, 14, 13, 18, 17, 16, 11},
+        });
+
+    ClassArray class_array = lue::test::create_partitioned_array<ClassArray>(
+        array_shape,
+        partition_shape,
+        {
+            {1, 1, 1, 1, 1, 1, 1, 1, 1},
+            {2, 2, 2, 2, 2, 2, 2, 2, 2},
+            {3, 3, 3, 3, 3, 3, 3, 3, 3},
+            {1, 1, 1, 1, 1, 1, 1, 1, 1},
+        });
+    // clang-format on
+    // NOLINTEND
+
+    auto zonal_minimum = lue::value_policies::zonal_minimum(value_array, class_array);
+
+    // NOLINTBEGIN
+    // clang-format off
+    ValueArray array_we_want = lue::test::create_partitioned_array<ValueArray>(
+        array_shape,
+        partition_shape,
+        {
+            {11, 11, 11, 11, 11, 11, 11, 11, 11},
+            {1, 1, 1, 1, 1, 1, 1, 1, 1},
+            {vx, vx, vx, vx, vx, vx, vx, vx, vx},
+            {11, 11, 11, 11, 11, 11, 11, 11, 11},
+        });
+    // clang-format on
+    // NOLINTEND
+
+    lue::test::check_arrays_are_equal(zonal_minimum, array_we_want);
+}
@@ -0,0 +1,234 @@
+#define BOOST_TEST_MODULE lue framework algorithm zonal_statistics
+#include "lue/framework/algorithm/create_partitioned_array.hpp"
+#include "lue/framework/algorithm/value_policies/zonal_statistics.hpp"
+#include "lue/framework/test/hpx_unit_test.hpp"
+#include "lue/framework.hpp"
+#include <cmath>
+
+
+namespace {
+
+    using Value = lue::FloatingPointElement<0>;
+    using Class = lue::UnsignedIntegralElement<0>;
+    std::size_t const rank = 2;
+
+    using ValueArray = lue::PartitionedArray<Value, rank>;
+    using ClassArray = lue::PartitionedArray<Class, rank>;
+    using Shape = lue::ShapeT<ValueArray>;
+
+    Shape const array_shape{{5, 5}};
+    Shape const partition_shape{{5, 5}};
+
+    Class const cx{lue::policy::no_data_value<Class>};  // Class no-data
+    Value const vx{lue::policy::no_data_value<Value>};  // Value no-data
+
+
+    // Example from the PCRaster manual, also used for zonal_mean
+    auto value_array() -> ValueArray
+    {
+        return lue::test::create_partitioned_array<ValueArray>(
+            array_shape,
+            partition_shape,
+            {{
+                -9, 0, -6, -6, -6, 1, 1, -6, -6, vx, 1, 1, -1, 7, 2, 1, 1, 3, 5, 8, 8, vx, vx, 2.5, 1.4,
+            }});
+    }
+
+
+    auto class_array() -> ClassArray
+    {
+        return lue::test::create_partitioned_array<ClassArray>(
+            array_shape,
+            partition_shape,
+            {{
+                2, 6, 2, 2, cx, 6, 6, 2, 2, 2, 6, 6, 0, 0, 0, 6, 6, 0, 0, 0, 6, 3, 3, 4, 4,
+            }});
+    }
+
+}  // Anonymous namespace
+
+
+BOOST_AUTO_TEST_CASE(use_case_01)
+{
+    auto const statistics = lue::value_policies::zonal_statistics(
+        value_array(),
+        class_array(),
+        {lue::ZonalStatistic::area, lue::ZonalStatistic::mean, lue::ZonalStatistic::maximum});
+
+    BOOST_REQUIRE_EQUAL(statistics.size(), 3);
+
+    // Area
+    {
+        ValueArray array_we_want = lue::test::create_partitioned_array<ValueArray>(
+            array_shape,
+            partition_shape,
+            {{
+                6, 8, 6, 6, vx, 8, 8, 6, 6, 6, 8, 8, 6, 6, 6, 8, 8, 6, 6, 6, 8, 2, 2, 2, 2,
+            }});
+
+        lue::test::check_arrays_are_equal(statistics[0], array_we_want);
+    }
+
+    // Mean
+    {
+        ValueArray array_we_want = lue::test::create_partitioned_array<ValueArray>(
+            array_shape,
+            partition_shape,
+            {{
+                -6.6, 1.75, -6.6, -6.6, vx, 1.75, 1.75, -6.6, -6.6, -6.6, 1.75, 1.75, 4,
+                4,    4,    1.75, 1.75, 4,  4,    4,    1.75, vx,   vx,   1.95, 1.95,
+            }});
+
+        lue::test::check_arrays_are_equal(statistics[1], array_we_want);
+    }
+
+    // Maximum
+    {
+        ValueArray array_we_want = lue::test::create_partitioned_array<ValueArray>(
+            array_shape,
+            partition_shape,
+            {{
+                -6, 8, -6, -6, vx, 8, 8, -6, -6, -6, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, vx, vx, 2.5, 2.5,
+            }});
+
+        lue::test::check_arrays_are_equal(statistics[2], array_we_want);
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(use_case_01_table)
+{
+    auto const table = lue::value_policies::zonal_statistics_table(
+                           value_array(),
+                           class_array(),
+                           {lue::ZonalStatistic::area,
+                            lue::ZonalStatistic::sum,
+                            lue::ZonalStatistic::mean,
+                            lue::ZonalStatistic::minimum,
+                            lue::ZonalStatistic::maximum})
+                           .get();
+
+    // Zone 3 only contains no-data values. Only its area can be calculated.
+    std::vector<Class> const zones_we_want{0, 2, 3, 4, 6};
+    std::vector<std::vector<Value>> const values_we_want{
+        {6, 6, 2, 2, 8},
+        {24, -33, vx, 3.9, 14},
+        {4, -6.6, vx, 1.95, 1.75},
+        {-1, -9, vx, 1.4, 0},
+        {8, -6, vx, 2.5, 8},
+    };
+
+    BOOST_CHECK_EQUAL_COLLECTIONS(
+        table.zones.begin(), table.zones.end(), zones_we_want.begin(), zones_we_want.end());
+
+    BOOST_REQUIRE_EQUAL(table.values.size(), values_we_want.size());
+
+    for (std::size_t statistic_idx = 0; statistic_idx < values_we_want.size(); ++statistic_idx)
+    {
+        BOOST_REQUIRE_EQUAL(table.values[statistic_idx].size(), zones_we_want.size());
+
+        for (std::size_t zone_idx = 0; zone_idx < zones_we_want.size(); ++zone_idx)
+        {
+            if (std::isnan(values_we_want[statistic_idx][zone_idx]))
+            {
+                BOOST_CHECK(std::isnan(table.values[statistic_idx][zone_idx]));
+            }
+            else
+            {
+                BOOST_CHECK_CLOSE(
+                    table.values[statistic_idx][zone_idx], values_we_want[statistic_idx][zone_idx], 1e-4);
+            }
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(multiple_partitions)
+{
+    Shape const array_shape{{4, 4}};
+    Shape const partition_shape{{2, 2}};
+
+    // The ones added to the large value in the first partition are lost when summing in single
+    // precision
+    Value const l{100'000'000};
+
+    // NOLINTBEGIN
+    // clang-format off
+    ValueArray const value_array = lue::test::create_partitioned_array<ValueArray>(
+        array_shape,
+        partition_shape,
+        {
+            {l, 1, 1, 1},
+            {1, 1, 1, 1},
+            {1, 1, 1, 1},
+            {1, 1, 2, 4},
+        });
+
+    ClassArray const class_array = lue::test::create_partitioned_array<ClassArray>(
+        array_shape,
+        partition_shape,
+        {
+            {1, 1, 1, 1},
+            {1, 1, 1, 1},
+            {1, 1, 1, 1},
+            {1, 1, 2, 2},
+        });
+    // clang-format on
+    // NOLINTEND
+
+    auto const statistics = lue::value_policies::zonal_statistics(
+        value_array,
+        class_array,
+        {lue::ZonalStatistic::sum, lue::ZonalStatistic::mean, lue::ZonalStatistic::minimum});
+
+    BOOST_REQUIRE_EQUAL(statistics.size(), 3);
+
+    // Sum
+    {
+        Value const s{static_cast<Value>(100'000'013.0)};
+
+        ValueArray array_we_want = lue::test::create_partitioned_array<ValueArray>(
+            array_shape,
+            partition_shape,
+            {
+                {s, s, s, s},
+                {s, s, s, s},
+                {s, s, s, s},
+                {s, s, 6, 6},
+            });
+
+        lue::test::check_arrays_are_equal(statistics[0], array_we_want);
+    }
+
+    // Mean
+    {
+        Value const m{static_cast<Value>(100'000'013.0 / 14)};
+
+        ValueArray array_we_want = lue::test::create_partitioned_array<ValueArray>(
+            array_shape,
+            partition_shape,
+            {
+                {m, m, m, m},
+                {m, m, m, m},
+                {m, m, m, m},
+                {m, m, 3, 3},
+            });
+
+        lue::test::check_arrays_are_equal(statistics[1], array_we_want);
+    }
+
+    // Minimum
+    {
+        ValueArray array_we_want = lue::test::create_partitioned_array<ValueArray>(
+            array_shape,
+            partition_shape,
+            {
+                {1, 1, 1, 1},
+                {1, 1, 1, 1},
+                {1, 1, 1, 1},
+                {1, 1, 2, 2},
+            });
+
+        lue::test::check_arrays_are_equal(statistics[2], array_we_want);
+    }
+}
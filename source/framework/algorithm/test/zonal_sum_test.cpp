@@ -91,3 +91,120 @@ BOOST_AUTO_TEST_CASE(zonal_sum_2d_2d_int32)
 
     lue::test::check_arrays_are_equal(zonal_sum, array_we_want);
 }
+
+
+BOOST_AUTO_TEST_CASE(zonal_sum_2d_2d_sparse_zones)
+{
+    using Value = lue::LargestIntegralElement;
+    using Class = lue::LargestUnsignedIntegralElement;
+    std::size_t const rank = 2;
+
+    using ValueArray = lue::PartitionedArray<Value, rank>;
+    using ClassArray = lue::PartitionedArray<Class, rank>;
+    using Shape = lue::ShapeT<ValueArray>;
+
+    Shape const array_shape{{6, 6}};
+    Shape const partition_shape{{3, 3}};
+
+    // Zone ids too far apart to be indexed by a vector, within a partition and across partitions
+    Class const z1{1};
+    Class const z2{1'000'000'000'000};
+    Class const z3{3};
+
+    ValueArray value_array{lue::create_partitioned_array<Value>(array_shape, partition_shape)};
+    lue::range(value_array, Value{1}).get();
+
+    ClassArray class_array = lue::test::create_partitioned_array<ClassArray>(
+        array_shape,
+        partition_shape,
+        {
+            {z1, z1, z1, z1, z1, z1, z1, z1, z1},
+            {z2, z2, z2, z2, z2, z2, z2, z2, z2},
+            {z1, z2, z1, z2, z1, z2, z1, z2, z1},
+            {z3, z3, z3, z3, z3, z3, z3, z3, z3},
+        });
+
+    auto zonal_sum = lue::value_policies::zonal_sum(value_array, class_array);
+
+    //  1  2  3 |  4  5  6
+    //  7  8  9 | 10 11 12
+    // 13 14 15 | 16 17 18
+    // ---------+---------
+    // 19 20 21 | 22 23 24
+    // 25 26 27 | 28 29 30
+    // 31 32 33 | 34 35 36
+    Value const s1{(1 + 2 + 3 + 7 + 8 + 9 + 13 + 14 + 15) + (19 + 21 + 26 + 31 + 33)};
+    Value const s2{(4 + 5 + 6 + 10 + 11 + 12 + 16 + 17 + 18) + (20 + 25 + 27 + 32)};
+    Value const s3{22 + 23 + 24 + 28 + 29 + 30 + 34 + 35 + 36};
+
+    ValueArray array_we_want = lue::test::create_partitioned_array<ValueArray>(
+        array_shape,
+        partition_shape,
+        {
+            {s1, s1, s1, s1, s1, s1, s1, s1, s1},
+            {s2, s2, s2, s2, s2, s2, s2, s2, s2},
+            {s1, s2, s1, s2, s1, s2, s1, s2, s1},
+            {s3, s3, s3, s3, s3, s3, s3, s3, s3},
+        });
+
+    lue::test::check_arrays_are_equal(zonal_sum, array_we_want);
+}
+
+
+BOOST_AUTO_TEST_CASE(zonal_sum_2d_2d_decreasing_zones)
+{
+    using Value = lue::LargestIntegralElement;
+    using Class = lue::LargestUnsignedIntegralElement;
+    std::size_t const rank = 2;
+
+    using ValueArray = lue::PartitionedArray<Value, rank>;
+    using ClassArray = lue::PartitionedArray<Class, rank>;
+    using Shape = lue::ShapeT<ValueArray>;
+
+    Shape const array_shape{{6, 6}};
+    Shape const partition_shape{{3, 3}};
+
+    //  1  2  3 |  4  5  6
+    //  7  8  9 | 10 11 12
+    // 13 14 15 | 16 17 18
+    // ---------+---------
+    // 19 20 21 | 22 23 24
+    // 25 26 27 | 28 29 30
+    // 31 32 33 | 34 35 36
+    ValueArray value_array{lue::create_partitioned_array<Value>(array_shape, partition_shape)};
+    lue::range(value_array, Value{1}).get();
+
+    // Zone ids decrease with the cell index, and each pair of cells in a row forms a zone, also across
+    // partitions
+    // NOLINTBEGIN
+    // clang-format off
+    ClassArray class_array = lue::test::create_partitioned_array<ClassArray>(
+        array_shape,
+        partition_shape,
+        {
+            {1000, 1000, 999, 997, 997, 996, 994, 994, 993},
+            {999, 998, 998, 996, 995, 995, 993, 992, 992},
+            {991, 991, 990, 988, 988, 987, 985, 985, 984},
+            {990, 989, 989, 987, 986, 986, 984, 983, 983},
+        });
+    // clang-format on
+    // NOLINTEND
+
+    auto zonal_sum = lue::value_policies::zonal_sum(value_array, class_array);
+
+    // NOLINTBEGIN
+    // clang-format off
+    ValueArray array_we_want = lue::test::create_partitioned_array<ValueArray>(
+        array_shape,
+        partition_shape,
+        {
+            {3, 3, 7, 15, 15, 19, 27, 27, 31},
+            {7, 11, 11, 19, 23, 23, 31, 35, 35},
+            {39, 39, 43, 51, 51, 55, 63, 63, 67},
+            {43, 47, 47, 55, 59, 59, 67, 71, 71},
+        });
+    // clang-format on
+    // NOLINTEND
+
+    lue::test::check_arrays_are_equal(zonal_sum, array_we_want);
+}
@@ -0,0 +1,177 @@
+#define BOOST_TEST_MODULE lue framework algorithm zone_index
+#include "lue/framework/algorithm/create_partitioned_array.hpp"
+#include "lue/framework/algorithm/range.hpp"
+#include "lue/framework/algorithm/value_policies/zonal_area.hpp"
+#include "lue/framework/algorithm/value_policies/zonal_statistics.hpp"
+#include "lue/framework/algorithm/value_policies/zonal_sum.hpp"
+#include "lue/framework/algorithm/value_policies/zone_index.hpp"
+#include "lue/framework/test/hpx_unit_test.hpp"
+#include "lue/framework.hpp"
+
+
+namespace {
+
+    using Class = lue::LargestUnsignedIntegralElement;
+    std::size_t const rank = 2;
+
+    using ClassArray = lue::PartitionedArray<Class, rank>;
+    using Shape = lue::ShapeT<ClassArray>;
+
+    Shape const array_shape{{6, 6}};
+    Shape const partition_shape{{3, 3}};
+
+    Class const cx{lue::policy::no_data_value<Class>};  // Class no-data
+
+    // Zone ids too far apart to be indexed by a vector
+    Class const z1{1};
+    Class const z2{1'000'000'000'000};
+
+
+    auto class_array() -> ClassArray
+    {
+        return lue::test::create_partitioned_array<ClassArray>(
+            array_shape,
+            partition_shape,
+            {
+                {z1, z1, z1, z1, cx, z1, z1, z1, z1},
+                {z2, z2, z2, z2, z2, z2, z2, z2, z2},
+                {z1, z2, z1, z2, z1, z2, z1, z2, z1},
+                {cx, cx, cx, cx, cx, cx, cx, cx, cx},
+            });
+    }
+
+}  // Anonymous namespace
+
+
+BOOST_AUTO_TEST_CASE(labels)
+{
+    using Labels = lue::ZoneIndex<Class, rank>::Labels;
+    using Label = lue::ZoneIndex<Class, rank>::Label;
+
+    auto const zone_index = lue::value_policies::zone_index(class_array());
+
+    if (hpx::get_num_localities().get() == 1)
+    {
+        // Position of each zone in the sorted zones of the locality: z1, z2. Cells without a zone
+        // are labelled with the number of zones.
+        Label const l1{0};
+        Label const l2{1};
+        Label const lx{2};
+
+        Labels labels_we_want = lue::test::create_partitioned_array<Labels>(
+            array_shape,
+            partition_shape,
+            {
+                {l1, l1, l1, l1, lx, l1, l1, l1, l1},
+                {l2, l2, l2, l2, l2, l2, l2, l2, l2},
+                {l1, l2, l1, l2, l1, l2, l1, l2, l1},
+                {lx, lx, lx, lx, lx, lx, lx, lx, lx},
+            });
+
+        lue::test::check_arrays_are_equal(zone_index.labels(), labels_we_want);
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(zonal_sum)
+{
+    using Value = lue::LargestIntegralElement;
+    using ValueArray = lue::PartitionedArray<Value, rank>;
+
+    Value const vx{lue::policy::no_data_value<Value>};
+
+    ValueArray value_array{lue::create_partitioned_array<Value>(array_shape, partition_shape)};
+    lue::range(value_array, Value{1}).get();
+
+    ClassArray const zones = class_array();
+    auto const zone_index = lue::value_policies::zone_index(zones);
+
+    //  1  2  3 |  4  5  6
+    //  7  8  9 | 10 11 12
+    // 13 14 15 | 16 17 18
+    // ---------+---------
+    // 19 20 21 | 22 23 24
+    // 25 26 27 | 28 29 30
+    // 31 32 33 | 34 35 36
+    Value const s1{(1 + 2 + 3 + 7 + 9 + 13 + 14 + 15) + (19 + 21 + 26 + 31 + 33)};
+    Value const s2{(4 + 5 + 6 + 10 + 11 + 12 + 16 + 17 + 18) + (20 + 25 + 27 + 32)};
+
+    ValueArray array_we_want = lue::test::create_partitioned_array<ValueArray>(
+        array_shape,
+        partition_shape,
+        {
+            {s1, s1, s1, s1, vx, s1, s1, s1, s1},
+            {s2, s2, s2, s2, s2, s2, s2, s2, s2},
+            {s1, s2, s1, s2, s1, s2, s1, s2, s1},
+            {vx, vx, vx, vx, vx, vx, vx, vx, vx},
+        });
+
+    // The index can be reused, and results in the same values as the zones array
+    lue::test::check_arrays_are_equal(lue::value_policies::zonal_sum(value_array, zone_index), array_we_want);
+    lue::test::check_arrays_are_equal(lue::value_policies::zonal_sum(value_array, zone_index), array_we_want);
+    lue::test::check_arrays_are_equal(lue::value_policies::zonal_sum(value_array, zones), array_we_want);
+}
+
+
+BOOST_AUTO_TEST_CASE(zonal_area)
+{
+    using Count = lue::CountElement;
+    using CountArray = lue::PartitionedArray<Count, rank>;
+
+    Count const nx{lue::policy::no_data_value<Count>};  // Count no-data
+    Count const a1{8 + 5};
+    Count const a2{9 + 4};
+
+    auto const zone_index = lue::value_policies::zone_index(class_array());
+
+    CountArray array_we_want = lue::test::create_partitioned_array<CountArray>(
+        array_shape,
+        partition_shape,
+        {
+            {a1, a1, a1, a1, nx, a1, a1, a1, a1},
+            {a2, a2, a2, a2, a2, a2, a2, a2, a2},
+            {a1, a2, a1, a2, a1, a2, a1, a2, a1},
+            {nx, nx, nx, nx, nx, nx, nx, nx, nx},
+        });
+
+    lue::test::check_arrays_are_equal(lue::value_policies::zonal_area<Count>(zone_index), array_we_want);
+}
+
+
+BOOST_AUTO_TEST_CASE(zonal_statistics)
+{
+    using Value = lue::FloatingPointElement<0>;
+    using ValueArray = lue::PartitionedArray<Value, rank>;
+
+    ValueArray value_array{lue::create_partitioned_array<Value>(array_shape, partition_shape)};
+    lue::range(value_array, Value{1}).get();
+
+    ClassArray const zones = class_array();
+    auto const zone_index = lue::value_policies::zone_index(zones);
+
+    std::vector<lue::ZonalStatistic> const statistics{
+        lue::ZonalStatistic::area,
+        lue::ZonalStatistic::sum,
+        lue::ZonalStatistic::mean,
+        lue::ZonalStatistic::minimum,
+        lue::ZonalStatistic::maximum};
+
+    auto const arrays_we_got = lue::value_policies::zonal_statistics(value_array, zone_index, statistics);
+    auto const arrays_we_want = lue::value_policies::zonal_statistics(value_array, zones, statistics);
+
+    BOOST_REQUIRE_EQUAL(arrays_we_got.size(), statistics.size());
+    BOOST_REQUIRE_EQUAL(arrays_we_want.size(), statistics.size());
+
+    for (std::size_t idx = 0; idx < statistics.size(); ++idx)
+    {
+        lue::test::check_arrays_are_equal(arrays_we_got[idx], arrays_we_want[idx]);
+    }
+
+    auto const table_we_got =
+        lue::value_policies::zonal_statistics_table(value_array, zone_index, statistics).get();
+    auto const table_we_want =
+        lue::value_policies::zonal_statistics_table(value_array, zones, statistics).get();
+
+    BOOST_CHECK(table_we_got.zones == table_we_want.zones);
+    BOOST_CHECK(table_we_got.values == table_we_want.values);
+}
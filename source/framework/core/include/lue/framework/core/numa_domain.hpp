@@ -29,6 +29,8 @@ namespace lue {
 
     TargetIndex scattered_target_index();
 
+    TargetIndex worker_thread_target_index(std::size_t worker_thread_idx);
+
 
     class ScatterTargetIndex
     {
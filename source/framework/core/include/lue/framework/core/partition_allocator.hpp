@@ -1,110 +1,590 @@
 #pragma once
+#include "lue/framework/core/configuration_entry.hpp"
+#include "lue/framework/core/numa_domain.hpp"
+#include <hpx/modules/runtime_local.hpp>
+#include <hpx/synchronization/mutex.hpp>
+#include <algorithm>
+#include <atomic>
 #include <map>
 #include <memory>
 #include <mutex>
-#include <stack>
-
-// #include <iostream>
+#include <vector>
 
 
 namespace lue {
 
+    /*!
+        @brief      Statistics about the use of a buffer pool
+
+        The values are a snapshot. Other threads may be using the pool while the statistics are obtained.
+    */
+    class BufferPoolStatistics
+    {
+
+        public:
+
+            //! Number of allocations served by a buffer present in the pool
+            std::size_t nr_hits{0};
+
+            //! Number of allocations for which a new buffer had to be allocated
+            std::size_t nr_misses{0};
+
+            //! Number of bytes held by the pool, in buffers not handed out
+            std::size_t nr_bytes_held{0};
+
+            //! Number of buffers given back to the system, because of the cap or because of trimming
+            std::size_t nr_buffers_released{0};
+    };
+
+
+    /*!
+        @brief      Pool of buffers for @a Element s
+        @tparam     Element Type of the elements stored in the buffers
+
+        Buffers are cached at two levels:
+
+        - Per HPX worker thread, a small magazine of recently deallocated buffers. Allocating and
+          deallocating buffers through a magazine does not involve locking. An HPX thread does not yield
+          while (de)allocating, so a magazine is only ever accessed by a single thread at a time.
+        - Per NUMA domain, a free list of buffers, ordered by buffer size. Buffers are allocated using an
+          allocator which binds the memory to the domain. A worker thread uses the free list of the domain
+          it is bound to.
+
+        The total number of bytes held by the pool is capped. Deallocated buffers that would make the pool
+        grow beyond the cap are released to the system. Use trim() to release buffers explicitly, for
+        example in between phases of a model which use differently sized partitions.
+
+        Threads which are not HPX worker threads bypass the magazines and use the free list of the first
+        NUMA domain.
+
+        Buffers are allocated using an HPX allocator. Call drain() before the HPX runtime is stopped, to
+        give back all buffers held. After draining, the pool does not hold on to buffers anymore.
+
+        @warning    The buffer's memory is not initialized. The caller needs to instantiate or copy
+                    Element instances into the buffer.
+    */
     template<typename Element>
-    class RecycleBin
+    class BufferPool
     {
 
         public:
 
-            ~RecycleBin()
+            //! Default maximum number of bytes to hold in the pool
+            static constexpr std::size_t default_max_nr_bytes{std::size_t{1} << 30};
+
+            //! Maximum number of buffers to cache per worker thread
+            static constexpr std::size_t magazine_capacity{8};
+
+
+            /*!
+                @brief      Construct an instance
+                @param      max_nr_bytes Maximum number of bytes to hold in the pool
+            */
+            explicit BufferPool(std::size_t const max_nr_bytes = default_max_nr_bytes):
+
+                _max_nr_bytes{max_nr_bytes}
+
             {
-                Lock lock{_mutex};
+            }
 
-                for (auto& [size, stack] : _cache)
-                {
 
-                    while (!stack.empty())
+            BufferPool(BufferPool const& other) = delete;
+
+            BufferPool(BufferPool&& other) = delete;
+
+
+            ~BufferPool()
+            {
+                for (auto& magazine : _magazines)
+                {
+                    for (auto const& [nr_elements, buffer] : magazine.buffers)
                     {
+                        _domains[magazine.domain_idx]->release(buffer, nr_elements);
+                    }
+                }
+
+                for (auto& domain : _domains)
+                {
+                    domain->release_all();
+                }
+            }
+
+
+            auto operator=(BufferPool const& other) -> BufferPool& = delete;
+
+            auto operator=(BufferPool&& other) -> BufferPool& = delete;
+
+
+            /*!
+                @brief      Return a buffer for @a nr_elements elements
+            */
+            auto allocate(std::size_t const nr_elements) -> Element*
+            {
+                initialize();
+
+                Element* buffer{nullptr};
+                Magazine* magazine{this_magazine()};
+                std::size_t const domain_idx{magazine != nullptr ? magazine->domain_idx : 0};
+
+                if (magazine != nullptr)
+                {
+                    buffer = magazine->pop(nr_elements);
+                }
+
+                if (buffer == nullptr)
+                {
+                    buffer = _domains[domain_idx]->pop(nr_elements);
+                }
+
+                if (buffer != nullptr)
+                {
+                    // A buffer popped from the pool is accounted for in _nr_bytes_held
+                    _nr_bytes_held -= nr_bytes(nr_elements);
+                    ++_nr_hits;
+                }
+                else
+                {
+                    buffer = _domains[domain_idx]->allocate(nr_elements);
+                    ++_nr_misses;
+                }
 
-                        Element* buffer = stack.top();
-                        stack.pop();
+                return buffer;
+            }
+
+
+            /*!
+                @brief      Give back @a buffer, containing @a nr_elements elements, to the pool
+
+                In case holding on to the buffer would make the pool grow beyond its cap, or in case the
+                pool has been drained, the buffer is released to the system.
+            */
+            void deallocate(Element* buffer, std::size_t const nr_elements)
+            {
+                initialize();
+
+                Magazine* magazine{this_magazine()};
+                std::size_t const domain_idx{magazine != nullptr ? magazine->domain_idx : 0};
 
-                        _allocator.deallocate(buffer, size);  // Release memory
+                if (_drained || !hold(nr_bytes(nr_elements)))
+                {
+                    _domains[domain_idx]->release(buffer, nr_elements);
+                    ++_nr_buffers_released;
+                    return;
+                }
+
+                if (magazine != nullptr)
+                {
+                    if (magazine->buffers.size() == magazine_capacity)
+                    {
+                        // Make room by moving the oldest buffer to the domain's free list
+                        auto const [oldest_nr_elements, oldest_buffer] = magazine->buffers.front();
+                        magazine->buffers.erase(magazine->buffers.begin());
+                        _domains[domain_idx]->push(oldest_buffer, oldest_nr_elements);
                     }
+
+                    magazine->buffers.emplace_back(nr_elements, buffer);
+                }
+                else
+                {
+                    _domains[domain_idx]->push(buffer, nr_elements);
                 }
             }
 
 
-            Element* allocate(std::size_t const nr_elements)
+            /*!
+                @brief      Release buffers held by the pool until at most @a max_nr_bytes are held
+
+                Buffers in the free lists of the NUMA domains are released first, largest buffers first.
+                Buffers in the magazine of the calling worker thread are released if necessary. Magazines
+                of other worker threads are left alone.
+            */
+            void trim(std::size_t const max_nr_bytes = 0)
             {
-                // See if a buffer of the requested nr_elements is available
-                // already. If so, return it. Otherwise, allocate a new buffer.
+                initialize();
+
+                for (auto& domain : _domains)
+                {
+                    while (_nr_bytes_held > max_nr_bytes)
+                    {
+                        std::size_t const nr_elements{domain->release_largest()};
 
-                // This code tries to release the mutex as fast as possible
-                // We assume _allocator.allocate is thread-safe. It is therefore
-                // not protected by the mutex.
+                        if (nr_elements == 0)
+                        {
+                            break;
+                        }
 
-                Element* buffer{nullptr};
+                        _nr_bytes_held -= nr_bytes(nr_elements);
+                        ++_nr_buffers_released;
+                    }
+                }
 
+                if (Magazine* magazine{this_magazine()}; magazine != nullptr)
                 {
-                    Lock lock{_mutex};
+                    while (_nr_bytes_held > max_nr_bytes && !magazine->buffers.empty())
+                    {
+                        auto const [nr_elements, buffer] = magazine->buffers.back();
+                        magazine->buffers.pop_back();
+                        _domains[magazine->domain_idx]->release(buffer, nr_elements);
+                        _nr_bytes_held -= nr_bytes(nr_elements);
+                        ++_nr_buffers_released;
+                    }
+                }
+            }
 
-                    auto& stack = _cache[nr_elements];
 
-                    if (!stack.empty())
+            /*!
+                @brief      Release all buffers held by the pool and stop holding on to buffers
+
+                Buffers allocated afterwards are released to the system when they are deallocated.
+
+                @warning    The magazines of all worker threads are emptied. Only call this function
+                            when no other threads use the pool, e.g. while the HPX runtime shuts down.
+            */
+            void drain()
+            {
+                _drained = true;
+
+                if (!_initialized)
+                {
+                    return;
+                }
+
+                for (auto& magazine : _magazines)
+                {
+                    for (auto const& [nr_elements, buffer] : magazine.buffers)
                     {
-                        buffer = stack.top();
-                        stack.pop();
+                        _domains[magazine.domain_idx]->release(buffer, nr_elements);
+                        _nr_bytes_held -= nr_bytes(nr_elements);
+                        ++_nr_buffers_released;
+                    }
 
-                        // std::cout << &_cache << ": reuse buffer: " << buffer << std::endl;
-                        return buffer;
+                    magazine.buffers.clear();
+                }
+
+                for (auto& domain : _domains)
+                {
+                    while (std::size_t const nr_elements = domain->release_largest())
+                    {
+                        _nr_bytes_held -= nr_bytes(nr_elements);
+                        ++_nr_buffers_released;
                     }
                 }
+            }
 
-                // No buffer is available to reuse: allocate a new one
-                buffer = _allocator.allocate(nr_elements);
 
-                // std::cout << &_cache << ": new buffer...: " << buffer << std::endl;
-                return buffer;
+            auto drained() const -> bool
+            {
+                return _drained;
             }
 
 
-            void deallocate(Element* buffer, std::size_t const nr_elements)
+            /*!
+                @brief      Set the maximum number of bytes to hold in the pool to @a max_nr_bytes
+
+                If the pool currently holds more bytes than the new cap, it is trimmed.
+            */
+            void set_max_nr_bytes(std::size_t const max_nr_bytes)
             {
-                // Add buffer to the collection of buffers to recycle
+                _max_nr_bytes = max_nr_bytes;
+                trim(max_nr_bytes);
+            }
 
-                Lock lock{_mutex};
 
-                // std::cout << &_cache << ": store buffer...: " << buffer << std::endl;
-                _cache[nr_elements].push(buffer);
+            auto max_nr_bytes() const -> std::size_t
+            {
+                return _max_nr_bytes;
+            }
+
+
+            auto statistics() const -> BufferPoolStatistics
+            {
+                return BufferPoolStatistics{
+                    .nr_hits = _nr_hits,
+                    .nr_misses = _nr_misses,
+                    .nr_bytes_held = _nr_bytes_held,
+                    .nr_buffers_released = _nr_buffers_released};
             }
 
         private:
 
-            using Mutex = std::mutex;
+            static constexpr auto nr_bytes(std::size_t const nr_elements) -> std::size_t
+            {
+                return nr_elements * sizeof(Element);
+            }
+
+
+            /*!
+                @brief      Account for holding on to an additional @a nr_bytes bytes, if this does not
+                            make the pool grow beyond its cap
+                @return     Whether the bytes are accounted for
+
+                Checking the cap and adding to the number of bytes held is a single atomic operation.
+                Concurrent deallocations cannot make the pool grow beyond its cap.
+            */
+            auto hold(std::size_t const nr_bytes) -> bool
+            {
+                std::size_t nr_bytes_held{_nr_bytes_held.load()};
+
+                do
+                {
+                    if (nr_bytes_held + nr_bytes > _max_nr_bytes)
+                    {
+                        return false;
+                    }
+                } while (!_nr_bytes_held.compare_exchange_weak(nr_bytes_held, nr_bytes_held + nr_bytes));
+
+                return true;
+            }
+
+
+            /*!
+                @brief      Free list of buffers whose memory is bound to a single NUMA domain
+            */
+            class Domain
+            {
+
+                public:
+
+                    explicit Domain(TargetIndex const target_idx):
+
+                        _allocator{Targets{1, target(target_idx)}}
+
+                    {
+                    }
+
+
+                    auto allocate(std::size_t const nr_elements) -> Element*
+                    {
+                        // The allocator is thread-safe. It is not protected by the mutex.
+                        return _allocator.allocate(nr_elements);
+                    }
+
+
+                    void release(Element* buffer, std::size_t const nr_elements)
+                    {
+                        _allocator.deallocate(buffer, nr_elements);
+                    }
+
+
+                    auto pop(std::size_t const nr_elements) -> Element*
+                    {
+                        Lock const lock{_mutex};
+
+                        auto it = _buffers.find(nr_elements);
+
+                        if (it == _buffers.end() || it->second.empty())
+                        {
+                            return nullptr;
+                        }
+
+                        Element* buffer{it->second.back()};
+                        it->second.pop_back();
+
+                        return buffer;
+                    }
+
+
+                    void push(Element* buffer, std::size_t const nr_elements)
+                    {
+                        Lock const lock{_mutex};
+
+                        _buffers[nr_elements].push_back(buffer);
+                    }
+
+
+                    /*!
+                        @brief      Release one of the largest buffers held and return its number of
+                                    elements, or zero if no buffer is held
+                    */
+                    auto release_largest() -> std::size_t
+                    {
+                        Element* buffer{nullptr};
+                        std::size_t nr_elements{0};
+
+                        {
+                            Lock const lock{_mutex};
+
+                            while (!_buffers.empty() && _buffers.rbegin()->second.empty())
+                            {
+                                _buffers.erase(std::prev(_buffers.end()));
+                            }
+
+                            if (_buffers.empty())
+                            {
+                                return 0;
+                            }
+
+                            auto& [size, buffers] = *_buffers.rbegin();
+                            nr_elements = size;
+                            buffer = buffers.back();
+                            buffers.pop_back();
+                        }
+
+                        release(buffer, nr_elements);
+
+                        return nr_elements;
+                    }
+
+
+                    void release_all()
+                    {
+                        Lock const lock{_mutex};
+
+                        for (auto& [nr_elements, buffers] : _buffers)
+                        {
+                            for (Element* buffer : buffers)
+                            {
+                                release(buffer, nr_elements);
+                            }
+                        }
+
+                        _buffers.clear();
+                    }
+
+                private:
+
+                    using Mutex = std::mutex;
+                    using Lock = std::lock_guard<Mutex>;
+
+                    Mutex _mutex;
+
+                    NUMADomainAllocator<Element> _allocator;
+
+                    //! Buffers to reuse, ordered by number of elements
+                    std::map<std::size_t, std::vector<Element*>> _buffers;
+            };
+
+
+            /*!
+                @brief      Buffers cached by a single worker thread
+
+                Aligned to a cache line to prevent false sharing between worker threads.
+            */
+            class alignas(64) Magazine
+            {
+
+                public:
+
+                    auto pop(std::size_t const nr_elements) -> Element*
+                    {
+                        // Search from the back: the most recently deallocated buffer is most likely still
+                        // in cache
+                        auto it = std::find_if(
+                            buffers.rbegin(),
+                            buffers.rend(),
+                            [nr_elements](auto const& entry) -> bool { return entry.first == nr_elements; });
+
+                        if (it == buffers.rend())
+                        {
+                            return nullptr;
+                        }
+
+                        Element* buffer{it->second};
+                        buffers.erase(std::next(it).base());
+
+                        return buffer;
+                    }
+
+                    //! Index of the NUMA domain the worker thread is bound to
+                    std::size_t domain_idx{0};
+
+                    //! Cached buffers and their number of elements, oldest first
+                    std::vector<std::pair<std::size_t, Element*>> buffers{};
+            };
+
+
+            void initialize()
+            {
+                // Determining the NUMA domains involves locking an hpx::mutex, which may suspend the
+                // calling HPX thread. Threads waiting for the initialization to finish must therefore also
+                // wait on an hpx::mutex, instead of blocking their worker thread (e.g. in std::call_once).
+                if (_initialized.load(std::memory_order_acquire))
+                {
+                    return;
+                }
+
+                Lock const lock{_initialization_mutex};
+
+                if (!_initialized.load(std::memory_order_relaxed))
+                {
+                    std::size_t const nr_domains{nr_numa_targets()};
+
+                    _domains.reserve(nr_domains);
+
+                    for (TargetIndex target_idx = 0; target_idx < nr_domains; ++target_idx)
+                    {
+                        _domains.push_back(std::make_unique<Domain>(target_idx));
+                    }
+
+                    std::size_t const nr_worker_threads{hpx::get_num_worker_threads()};
+
+                    _magazines.resize(nr_worker_threads);
+
+                    for (std::size_t thread_idx = 0; thread_idx < nr_worker_threads; ++thread_idx)
+                    {
+                        _magazines[thread_idx].domain_idx = worker_thread_target_index(thread_idx);
+                        _magazines[thread_idx].buffers.reserve(magazine_capacity);
+                    }
+
+                    _initialized.store(true, std::memory_order_release);
+                }
+            }
+
+
+            /*!
+                @brief      Return the magazine of the calling worker thread, or nullptr if the calling
+                            thread is not an HPX worker thread
+            */
+            auto this_magazine() -> Magazine*
+            {
+                std::size_t const thread_idx{hpx::get_worker_thread_num()};
+
+                return thread_idx < _magazines.size() ? &_magazines[thread_idx] : nullptr;
+            }
+
+
+            using Mutex = hpx::mutex;
             using Lock = std::lock_guard<Mutex>;
 
-            //! Mutex for using the cache
-            Mutex _mutex;
+            Mutex _initialization_mutex;
+
+            std::atomic<bool> _initialized{false};
+
+            std::atomic<bool> _drained{false};
+
+            std::atomic<std::size_t> _max_nr_bytes;
+
+            std::atomic<std::size_t> _nr_hits{0};
+
+            std::atomic<std::size_t> _nr_misses{0};
+
+            std::atomic<std::size_t> _nr_bytes_held{0};
 
-            //! Allocator to use for managing requests for memory
-            std::allocator<Element> _allocator;
+            std::atomic<std::size_t> _nr_buffers_released{0};
 
-            //! Cache containing stacks of buffers to reuse, ordered by nr_elements
-            std::map<std::size_t, std::stack<Element*>> _cache;
+            //! Per NUMA domain, a free list of buffers
+            std::vector<std::unique_ptr<Domain>> _domains;
+
+            //! Per worker thread, a magazine of buffers
+            std::vector<Magazine> _magazines;
     };
 
 
     /*!
         @brief      Allocator for buffers of @a Element s
 
-        This allocator is useful if there is a limited set of buffer sizes
-        that are allocated and deallocated over and over again. Underneath
-        a cache of buffers is used. Deallocating a buffer puts the buffer into
-        the cache for reuse.
+        This allocator is useful if there is a limited set of buffer sizes that are allocated and
+        deallocated over and over again. Underneath a BufferPool is used, shared by all instances for the
+        same @a Element type. Deallocating a buffer puts the buffer into the pool for reuse.
+
+        The maximum number of bytes held by the pool can be configured using the
+        `lue.partition_allocator.max_nr_bytes` configuration entry.
 
-        @warning    Allocated memory is not freed until the application exits
-        @warning    The buffer's memory is not initialized. The caller needs
-                    to instantiate or copy Element instances into the buffer.
+        The pool is drained when the HPX runtime shuts down. Buffers deallocated afterwards are released to
+        the system immediately.
+
+        @warning    The buffer's memory is not initialized. The caller needs to instantiate or copy
+                    Element instances into the buffer.
     */
     template<typename Element>
     class PartitionAllocator
@@ -112,7 +592,7 @@ namespace lue {
 
         public:
 
-            inline Element* allocate(std::size_t const nr_elements)
+            inline auto allocate(std::size_t const nr_elements) -> Element*
             {
                 return resource().allocate(nr_elements);
             }
@@ -123,13 +603,31 @@ namespace lue {
                 resource().deallocate(buffer, nr_elements);
             }
 
-        private:
 
-            inline static RecycleBin<Element>& resource()
+            inline static auto resource() -> BufferPool<Element>&
             {
-                static RecycleBin<Element> _resource{};
+                static BufferPool<Element> _resource{optional_configuration_entry<std::uint64_t>(
+                    "lue.partition_allocator", "max_nr_bytes", BufferPool<Element>::default_max_nr_bytes)};
+
+                // Give back the buffers held while the runtime is still alive, instead of during the
+                // destruction of static objects
+                [[maybe_unused]] static bool const drain_at_shutdown{
+                    (hpx::register_shutdown_function([]() { _resource.drain(); }), true)};
+
                 return _resource;
             }
+
+
+            inline static auto statistics() -> BufferPoolStatistics
+            {
+                return resource().statistics();
+            }
+
+
+            inline static void trim(std::size_t const max_nr_bytes = 0)
+            {
+                resource().trim(max_nr_bytes);
+            }
     };
 
 }  // namespace lue
@@ -0,0 +1,263 @@
+#pragma once
+#include "lue/framework/core/assert.hpp"
+#include "lue/framework/core/define.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+
+namespace lue {
+
+    /*!
+        @brief      Packed bitmask representing the validity of a collection of elements
+
+        Each element is represented by a single bit. A set bit means the element is valid, an unset bit
+        means it contains no-data. Bits are packed into 64 bit words, which allows masks to be combined
+        word-wide and enables algorithms to process valid elements in dense, branchless loops.
+
+        Bits in the last word beyond the number of elements are always unset.
+
+        The detect() and mark() functions convert between this representation and the representation
+        in which no-data is stored in the elements themselves, using no-data policies.
+    */
+    class ValidityMask
+    {
+
+        public:
+
+            using Word = std::uint64_t;
+
+            static constexpr Count nr_bits_per_word{64};
+
+
+            /*!
+                @brief      Construct an instance for @a nr_elements elements
+                @param      valid Initial validity of all elements
+            */
+            explicit ValidityMask(Count const nr_elements = 0, bool const valid = true):
+
+                _nr_elements{nr_elements},
+                _words(static_cast<std::size_t>(nr_words(nr_elements)), valid ? ~Word{0} : Word{0})
+
+            {
+                lue_hpx_assert(nr_elements >= 0);
+
+                clear_padding_bits();
+            }
+
+
+            /*!
+                @brief      Create a mask given @a nr_elements elements in @a data, using the input
+                            no-data policy @a indp to detect no-data
+                @tparam     Data Collection of elements supporting element access by linear index
+            */
+            template<typename InputNoDataPolicy, typename Data>
+            static auto detect(InputNoDataPolicy const& indp, Data const& data, Count const nr_elements)
+                -> ValidityMask
+            {
+                ValidityMask mask{nr_elements, false};
+
+                Count const nr_full_words{nr_elements / nr_bits_per_word};
+                Index element_idx{0};
+
+                for (Index word_idx = 0; word_idx < nr_full_words; ++word_idx)
+                {
+                    Word word{0};
+
+                    for (Count bit_idx = 0; bit_idx < nr_bits_per_word; ++bit_idx, ++element_idx)
+                    {
+                        word |= Word{!indp.is_no_data(data, element_idx)} << bit_idx;
+                    }
+
+                    mask._words[word_idx] = word;
+                }
+
+                for (Count bit_idx = 0; element_idx < nr_elements; ++bit_idx, ++element_idx)
+                {
+                    mask._words[nr_full_words] |= Word{!indp.is_no_data(data, element_idx)} << bit_idx;
+                }
+
+                return mask;
+            }
+
+
+            /*!
+                @brief      Mark the elements in @a data which are not valid as no-data, using the output
+                            no-data policy @a ondp
+                @tparam     Data Collection of elements supporting element access by linear index
+
+                Words in which all elements are valid are skipped.
+            */
+            template<typename OutputNoDataPolicy, typename Data>
+            void mark(OutputNoDataPolicy const& ondp, Data& data) const
+            {
+                for (std::size_t word_idx = 0; word_idx < _words.size(); ++word_idx)
+                {
+                    Word invalid{~_words[word_idx]};
+
+                    if (word_idx == _words.size() - 1)
+                    {
+                        invalid &= padding_mask();
+                    }
+
+                    while (invalid != 0)
+                    {
+                        Index const bit_idx{std::countr_zero(invalid)};
+
+                        ondp.mark_no_data(
+                            data, static_cast<Index>(word_idx) * nr_bits_per_word + bit_idx);
+
+                        invalid &= invalid - 1;
+                    }
+                }
+            }
+
+
+            auto nr_elements() const -> Count
+            {
+                return _nr_elements;
+            }
+
+
+            /*!
+                @brief      Return whether the element at @a idx is valid
+            */
+            auto is_valid(Index const idx) const -> bool
+            {
+                lue_hpx_assert(idx >= 0 && idx < _nr_elements);
+
+                return (_words[idx / nr_bits_per_word] >> (idx % nr_bits_per_word)) & Word{1};
+            }
+
+
+            /*!
+                @brief      Set the validity of the element at @a idx to @a valid
+            */
+            void set_valid(Index const idx, bool const valid = true)
+            {
+                lue_hpx_assert(idx >= 0 && idx < _nr_elements);
+
+                Word const bit{Word{1} << (idx % nr_bits_per_word)};
+                Word& word{_words[idx / nr_bits_per_word]};
+
+                word = valid ? word | bit : word & ~bit;
+            }
+
+
+            /*!
+                @brief      Return the number of valid elements
+            */
+            auto nr_valid() const -> Count
+            {
+                Count result{0};
+
+                for (Word const word : _words)
+                {
+                    result += std::popcount(word);
+                }
+
+                return result;
+            }
+
+
+            /*!
+                @brief      Return whether all elements are valid
+            */
+            auto all() const -> bool
+            {
+                return nr_valid() == _nr_elements;
+            }
+
+
+            /*!
+                @brief      Return whether no element is valid
+            */
+            auto none() const -> bool
+            {
+                return std::all_of(_words.begin(), _words.end(), [](Word const word) { return word == 0; });
+            }
+
+
+            /*!
+                @brief      Combine this mask with @a other: elements are valid if they are valid in both
+            */
+            auto operator&=(ValidityMask const& other) -> ValidityMask&
+            {
+                lue_hpx_assert(other._nr_elements == _nr_elements);
+
+                std::transform(
+                    _words.begin(), _words.end(), other._words.begin(), _words.begin(), std::bit_and<Word>{});
+
+                return *this;
+            }
+
+
+            /*!
+                @brief      Combine this mask with @a other: elements are valid if they are valid in either
+            */
+            auto operator|=(ValidityMask const& other) -> ValidityMask&
+            {
+                lue_hpx_assert(other._nr_elements == _nr_elements);
+
+                std::transform(
+                    _words.begin(), _words.end(), other._words.begin(), _words.begin(), std::bit_or<Word>{});
+
+                return *this;
+            }
+
+
+            auto operator==(ValidityMask const& other) const -> bool = default;
+
+
+            auto words() const -> std::vector<Word> const&
+            {
+                return _words;
+            }
+
+        private:
+
+            static constexpr auto nr_words(Count const nr_elements) -> Count
+            {
+                return (nr_elements + nr_bits_per_word - 1) / nr_bits_per_word;
+            }
+
+
+            /*!
+                @brief      Return mask of the bits in the last word that correspond with elements
+            */
+            auto padding_mask() const -> Word
+            {
+                Count const nr_bits_used{_nr_elements % nr_bits_per_word};
+
+                return nr_bits_used == 0 ? ~Word{0} : (Word{1} << nr_bits_used) - 1;
+            }
+
+
+            void clear_padding_bits()
+            {
+                if (!_words.empty())
+                {
+                    _words.back() &= padding_mask();
+                }
+            }
+
+
+            Count _nr_elements;
+
+            std::vector<Word> _words;
+    };
+
+
+    inline auto operator&(ValidityMask lhs, ValidityMask const& rhs) -> ValidityMask
+    {
+        return lhs &= rhs;
+    }
+
+
+    inline auto operator|(ValidityMask lhs, ValidityMask const& rhs) -> ValidityMask
+    {
+        return lhs |= rhs;
+    }
+
+}  // namespace lue
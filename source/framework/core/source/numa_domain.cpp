@@ -1,4 +1,6 @@
 #include "lue/framework/core/numa_domain.hpp"
+#include <hpx/modules/resource_partitioner.hpp>
+#include <hpx/modules/topology.hpp>
 #include <hpx/synchronization/mutex.hpp>
 #include <mutex>
 
@@ -109,4 +111,25 @@ namespace lue {
         return result;
     }
 
+
+    /*!
+        @brief      Return index of the NUMA domain target worker thread @a worker_thread_idx is bound to
+
+        In case the domain cannot be determined, the index of the first target is returned.
+    */
+    TargetIndex worker_thread_target_index(std::size_t const worker_thread_idx)
+    {
+        auto& partitioner = hpx::resource::get_partitioner();
+
+        if (worker_thread_idx >= partitioner.get_num_threads())
+        {
+            return 0;
+        }
+
+        TargetIndex const result = hpx::threads::create_topology().get_numa_node_number(
+            partitioner.get_pu_num(worker_thread_idx));
+
+        return result < nr_numa_targets() ? result : 0;
+    }
+
 }  // namespace lue
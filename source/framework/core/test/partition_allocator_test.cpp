@@ -0,0 +1,94 @@
+#define BOOST_TEST_MODULE lue framework core partition_allocator
+#include "lue/framework/core/partition_allocator.hpp"
+#include "lue/framework/test/hpx_unit_test.hpp"
+
+
+BOOST_AUTO_TEST_CASE(reuse)
+{
+    lue::BufferPool<std::int32_t> pool{};
+
+    std::int32_t* buffer1 = pool.allocate(100);
+    BOOST_CHECK_EQUAL(pool.statistics().nr_misses, 1);
+    BOOST_CHECK_EQUAL(pool.statistics().nr_hits, 0);
+
+    pool.deallocate(buffer1, 100);
+    BOOST_CHECK_EQUAL(pool.statistics().nr_bytes_held, 100 * sizeof(std::int32_t));
+
+    // Same size: buffer must be reused
+    std::int32_t* buffer2 = pool.allocate(100);
+    BOOST_CHECK_EQUAL(buffer2, buffer1);
+    BOOST_CHECK_EQUAL(pool.statistics().nr_hits, 1);
+    BOOST_CHECK_EQUAL(pool.statistics().nr_bytes_held, 0);
+
+    // Different size: new buffer
+    std::int32_t* buffer3 = pool.allocate(200);
+    BOOST_CHECK_EQUAL(pool.statistics().nr_misses, 2);
+
+    pool.deallocate(buffer2, 100);
+    pool.deallocate(buffer3, 200);
+    BOOST_CHECK_EQUAL(pool.statistics().nr_bytes_held, 300 * sizeof(std::int32_t));
+}
+
+
+BOOST_AUTO_TEST_CASE(cap)
+{
+    lue::BufferPool<std::int32_t> pool{150 * sizeof(std::int32_t)};
+
+    std::int32_t* buffer1 = pool.allocate(100);
+    std::int32_t* buffer2 = pool.allocate(100);
+
+    pool.deallocate(buffer1, 100);
+    BOOST_CHECK_EQUAL(pool.statistics().nr_bytes_held, 100 * sizeof(std::int32_t));
+    BOOST_CHECK_EQUAL(pool.statistics().nr_buffers_released, 0);
+
+    // Holding on to this buffer would exceed the cap
+    pool.deallocate(buffer2, 100);
+    BOOST_CHECK_EQUAL(pool.statistics().nr_bytes_held, 100 * sizeof(std::int32_t));
+    BOOST_CHECK_EQUAL(pool.statistics().nr_buffers_released, 1);
+}
+
+
+BOOST_AUTO_TEST_CASE(trim)
+{
+    lue::BufferPool<std::int32_t> pool{};
+
+    for (std::size_t nr_elements : {10, 20, 30})
+    {
+        pool.deallocate(pool.allocate(nr_elements), nr_elements);
+    }
+
+    BOOST_CHECK_EQUAL(pool.statistics().nr_bytes_held, 60 * sizeof(std::int32_t));
+
+    pool.trim(30 * sizeof(std::int32_t));
+    BOOST_CHECK_LE(pool.statistics().nr_bytes_held, 30 * sizeof(std::int32_t));
+
+    pool.trim();
+    BOOST_CHECK_EQUAL(pool.statistics().nr_bytes_held, 0);
+    BOOST_CHECK_EQUAL(pool.statistics().nr_buffers_released, 3);
+
+    pool.set_max_nr_bytes(0);
+    std::int32_t* buffer = pool.allocate(10);
+    pool.deallocate(buffer, 10);
+    BOOST_CHECK_EQUAL(pool.statistics().nr_bytes_held, 0);
+}
+
+
+BOOST_AUTO_TEST_CASE(drain)
+{
+    lue::BufferPool<std::int32_t> pool{};
+
+    std::int32_t* buffer1 = pool.allocate(100);
+    std::int32_t* buffer2 = pool.allocate(200);
+    pool.deallocate(buffer1, 100);
+    BOOST_CHECK_EQUAL(pool.statistics().nr_bytes_held, 100 * sizeof(std::int32_t));
+
+    pool.drain();
+    BOOST_CHECK(pool.drained());
+    BOOST_CHECK_EQUAL(pool.statistics().nr_bytes_held, 0);
+    BOOST_CHECK_EQUAL(pool.statistics().nr_buffers_released, 1);
+
+    // Buffers deallocated after draining are not held anymore
+    pool.deallocate(buffer2, 200);
+    BOOST_CHECK_EQUAL(pool.statistics().nr_bytes_held, 0);
+    BOOST_CHECK_EQUAL(pool.statistics().nr_buffers_released, 2);
+}
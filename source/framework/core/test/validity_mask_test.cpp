@@ -0,0 +1,143 @@
+#define BOOST_TEST_MODULE lue framework core validity_mask
+#include "lue/framework/core/validity_mask.hpp"
+#include <boost/test/included/unit_test.hpp>
+#include <cmath>
+#include <limits>
+
+
+namespace {
+
+    using Element = float;
+    using Elements = std::vector<Element>;
+
+    class DetectNaN
+    {
+
+        public:
+
+            auto is_no_data(Elements const& data, lue::Index const idx) const -> bool
+            {
+                return std::isnan(data[idx]);
+            }
+    };
+
+
+    class MarkNaN
+    {
+
+        public:
+
+            void mark_no_data(Elements& data, lue::Index const idx) const
+            {
+                data[idx] = std::numeric_limits<Element>::quiet_NaN();
+            }
+    };
+
+}  // Anonymous namespace
+
+
+BOOST_AUTO_TEST_CASE(construct)
+{
+    {
+        lue::ValidityMask mask{};
+
+        BOOST_CHECK_EQUAL(mask.nr_elements(), 0);
+        BOOST_CHECK_EQUAL(mask.nr_valid(), 0);
+        BOOST_CHECK(mask.none());
+    }
+
+    {
+        lue::ValidityMask mask{70};
+
+        BOOST_CHECK_EQUAL(mask.nr_elements(), 70);
+        BOOST_CHECK_EQUAL(mask.nr_valid(), 70);
+        BOOST_CHECK(mask.all());
+        BOOST_CHECK_EQUAL(mask.words().size(), 2);
+    }
+
+    {
+        lue::ValidityMask mask{70, false};
+
+        BOOST_CHECK_EQUAL(mask.nr_valid(), 0);
+        BOOST_CHECK(mask.none());
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(set_valid)
+{
+    lue::ValidityMask mask{100, false};
+
+    mask.set_valid(0);
+    mask.set_valid(63);
+    mask.set_valid(64);
+    mask.set_valid(99);
+
+    BOOST_CHECK_EQUAL(mask.nr_valid(), 4);
+    BOOST_CHECK(mask.is_valid(63));
+    BOOST_CHECK(mask.is_valid(64));
+    BOOST_CHECK(!mask.is_valid(65));
+
+    mask.set_valid(63, false);
+    BOOST_CHECK(!mask.is_valid(63));
+    BOOST_CHECK_EQUAL(mask.nr_valid(), 3);
+}
+
+
+BOOST_AUTO_TEST_CASE(detect_and_mark)
+{
+    lue::Count const nr_elements{130};
+    Element const nan{std::numeric_limits<Element>::quiet_NaN()};
+
+    Elements values(nr_elements);
+
+    for (lue::Index idx = 0; idx < nr_elements; ++idx)
+    {
+        values[idx] = idx % 3 == 0 ? nan : static_cast<Element>(idx);
+    }
+
+    lue::ValidityMask const mask{lue::ValidityMask::detect(DetectNaN{}, values, nr_elements)};
+
+    BOOST_CHECK_EQUAL(mask.nr_valid(), nr_elements - 44);
+
+    for (lue::Index idx = 0; idx < nr_elements; ++idx)
+    {
+        BOOST_CHECK_EQUAL(mask.is_valid(idx), idx % 3 != 0);
+    }
+
+    Elements result(nr_elements, 5);
+    mask.mark(MarkNaN{}, result);
+
+    for (lue::Index idx = 0; idx < nr_elements; ++idx)
+    {
+        BOOST_CHECK_EQUAL(std::isnan(result[idx]), idx % 3 == 0);
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(combine)
+{
+    lue::ValidityMask mask1{70, false};
+    lue::ValidityMask mask2{70, false};
+
+    mask1.set_valid(1);
+    mask1.set_valid(68);
+    mask2.set_valid(68);
+    mask2.set_valid(69);
+
+    {
+        lue::ValidityMask const mask{mask1 & mask2};
+
+        BOOST_CHECK_EQUAL(mask.nr_valid(), 1);
+        BOOST_CHECK(mask.is_valid(68));
+    }
+
+    {
+        lue::ValidityMask const mask{mask1 | mask2};
+
+        BOOST_CHECK_EQUAL(mask.nr_valid(), 3);
+        BOOST_CHECK(mask.is_valid(1));
+        BOOST_CHECK(mask.is_valid(68));
+        BOOST_CHECK(mask.is_valid(69));
+    }
+}
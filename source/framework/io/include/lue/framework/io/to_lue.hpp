@@ -113,6 +113,10 @@ namespace lue {
 
             auto partition_ptr{detail::ready_component_ptr(partition)};
             auto& partition_server{*partition_ptr};
+
+            // Elements are written as-is. Validity masks only exist within the kernels of operations.
+            // In partition data, no-data is always represented by the sentinel values of the no-data
+            // policies, which is also how it is stored in the LUE dataset.
             Element* buffer{partition_server.data().data()};
 
             array.write(create_hyperslab(partition_server), transfer_property_list, buffer);
@@ -8,17 +8,40 @@
 #include "lue/framework/partitioned_array/serialize/shared_buffer.hpp"
 #include "lue/configure.hpp"
 #include "lue/define.hpp"
+#include <hpx/synchronization/mutex.hpp>
+#include <atomic>
 #include <initializer_list>
+#include <memory>
+#include <mutex>
 
 
 namespace lue {
 
+    /*!
+        @brief      Tag for selecting the constructor of uniform array partition data
+        @sa         ArrayPartitionData::is_uniform()
+    */
+    class UniformTag
+    {
+    };
+
+
     /*!
         @brief      Class for keeping track of array partition data values
         @warning    Copies of ArrayPartitionData instances share the underlying array with elements
 
         There is a specialization for array scalars (arrays with rank == 0). This allows scalars to be handled
         the same as arrays.
+
+        An instance can be uniform, in which case all elements have the same value. Such an instance only
+        stores the shape and the value. Algorithms can test for this using is_uniform() and short-circuit.
+        Accessing individual elements, by any means, expands the instance into a regular one first.
+        Expanding is thread-safe. Uniform instances are serialized as shape and value only.
+
+        Copies of a uniform instance share its expansion. The elements are allocated once, by whichever
+        copy is expanded first, and all copies share the same array with elements afterwards. Writing
+        elements through one copy is visible through all copies, just like with copies of regular
+        instances. Reshaping or erasing elements of a uniform copy detaches it from the other copies.
     */
     template<typename Element, Rank rank>
     class ArrayPartitionData
@@ -52,18 +75,20 @@ namespace lue {
 
             ArrayPartitionData(Shape const& shape, Element const& value);
 
+            ArrayPartitionData(Shape const& shape, Element const& value, UniformTag);
+
             template<typename InputIterator>
             ArrayPartitionData(Shape const& shape, InputIterator begin, InputIterator end);
 
             ArrayPartitionData(Shape const& shape, std::initializer_list<Element> elements);
 
-            ArrayPartitionData(ArrayPartitionData const&) = default;
+            ArrayPartitionData(ArrayPartitionData const& other);
 
             ArrayPartitionData(ArrayPartitionData&& other);
 
             ~ArrayPartitionData() = default;
 
-            ArrayPartitionData& operator=(ArrayPartitionData const&) = default;
+            ArrayPartitionData& operator=(ArrayPartitionData const& other);
 
             ArrayPartitionData& operator=(ArrayPartitionData&& other);
 
@@ -75,6 +100,10 @@ namespace lue {
 
             bool empty() const;
 
+            bool is_uniform() const;
+
+            Element const& uniform_value() const;
+
             void reshape(Shape const& shape);
 
             void erase(
@@ -102,7 +131,9 @@ namespace lue {
                     validate_idxs(_shape, idxs...);
                 }
 
-                return _span[idxs...];
+                expand();
+
+                return element_span()[idxs...];
             }
 
             template<typename... Idxs>
@@ -113,7 +144,9 @@ namespace lue {
                     validate_idxs(_shape, idxs...);
                 }
 
-                return _span[idxs...];
+                expand();
+
+                return element_span()[idxs...];
             }
 
             // template<
@@ -133,22 +166,65 @@ namespace lue {
 
             Element* data()
             {
-                return _elements.data();
+                expand();
+
+                return elements().data();
             }
 
         private:
 
+            /*!
+                @brief      Expansion state of a uniform instance, shared by all its copies
+            */
+            class Expansion
+            {
+
+                public:
+
+                    //! Mutex serializing the expansion of the copies sharing this state
+                    hpx::mutex mutex;
+
+                    std::atomic<bool> expanded{false};
+
+                    //! Elements, once expanded
+                    Elements elements;
+
+                    //! Span for converting nD indices to linear indices into the expanded elements
+                    Span span;
+            };
+
             Elements const& elements() const;
 
             Elements& elements();
 
+            Span const& element_span() const;
+
+            void expand() const;
+
+            void detach_expansion();
+
             void assert_invariants() const;
 
             friend class hpx::serialization::access;
 
             void serialize(hpx::serialization::input_archive& archive, unsigned int const /* version */)
             {
-                archive & _shape & _elements;
+                bool uniform{false};
+
+                archive & _shape & uniform;
+
+                if (uniform)
+                {
+                    archive & _uniform_value;
+                    _elements = Elements{};
+                    _expansion = std::make_shared<Expansion>();
+                }
+                else
+                {
+                    _expansion.reset();
+                    archive & _elements;
+                }
+
                 _span = Span{_elements.data(), _shape};
 
                 assert_invariants();
@@ -159,15 +235,33 @@ namespace lue {
             {
                 assert_invariants();
 
-                archive & _shape & _elements;
+                bool const uniform{is_uniform()};
+
+                archive & _shape & uniform;
+
+                if (uniform)
+                {
+                    archive & _uniform_value;
+                }
+                else
+                {
+                    archive & elements();
+                }
             }
 
             Shape _shape;
 
+            // Elements of instances which were not uniform when they were created
             Elements _elements;
 
-            // Span for converting nD indices to linear indices
+            // Span for converting nD indices to linear indices into _elements
             Span _span;
+
+            // Only set for instances which were uniform when they were created. Shared between copies.
+            std::shared_ptr<Expansion> _expansion;
+
+            // Value of all elements, in case the instance is uniform
+            Element _uniform_value;
     };
 
 
@@ -181,7 +275,9 @@ namespace lue {
 
         _shape{},
         _elements{},
-        _span{}
+        _span{},
+        _expansion{},
+        _uniform_value{}
 
     {
         // Shape is filled with indeterminate values! This may or may not
@@ -205,7 +301,9 @@ namespace lue {
 
         _shape{shape},
         _elements{lue::nr_elements(shape)},
-        _span{_elements.data(), _shape}
+        _span{_elements.data(), _shape},
+        _expansion{},
+        _uniform_value{}
 
     {
         assert_invariants();
@@ -229,6 +327,28 @@ namespace lue {
     }
 
 
+    /*!
+        @brief      Construct a uniform instance with a certain shape and value
+        @param      shape Shape of data array to create
+        @param      value Value of all elements
+
+        No memory for the individual elements is allocated until they are accessed.
+    */
+    template<typename Element, Rank rank>
+    ArrayPartitionData<Element, rank>::ArrayPartitionData(
+        Shape const& shape, Element const& value, UniformTag):
+
+        _shape{shape},
+        _elements{},
+        _span{_elements.data(), _shape},
+        _expansion{std::make_shared<Expansion>()},
+        _uniform_value{value}
+
+    {
+        assert_invariants();
+    }
+
+
     /*!
         @brief      Construct an instance with a certain shape and initial elements
         @param      shape Shape of data array to create
@@ -266,6 +386,27 @@ namespace lue {
     }
 
 
+    /*!
+        @brief      Copy-construct an instance based on @a other
+
+        In case @a other is uniform, the new instance is uniform as well and shares the expansion state
+        with @a other. Otherwise the underlying array with elements is shared.
+    */
+    template<typename Element, Rank rank>
+    ArrayPartitionData<Element, rank>::ArrayPartitionData(ArrayPartitionData const& other):
+
+        _shape{other._shape},
+        _elements{other._elements},
+        _span{_elements.data(), _shape},
+        _expansion{other._expansion},
+        _uniform_value{other._uniform_value}
+
+    {
+
+        assert_invariants();
+    }
+
+
     /*!
         @brief      Move-construct and instance based on @a other
     */
@@ -274,7 +415,9 @@ namespace lue {
 
         _shape{std::move(other._shape)},
         _elements{std::move(other._elements)},
-        _span{_elements.data(), _shape}
+        _span{_elements.data(), _shape},
+        _expansion{std::move(other._expansion)},
+        _uniform_value{std::move(other._uniform_value)}
 
     {
         lue_hpx_assert(this != &other);
@@ -289,6 +432,22 @@ namespace lue {
     }
 
 
+    /*!
+        @brief      Copy assign @a other to this instance
+    */
+    template<typename Element, Rank rank>
+    ArrayPartitionData<Element, rank>& ArrayPartitionData<Element, rank>::operator=(
+        ArrayPartitionData const& other)
+    {
+        if (this != &other)
+        {
+            *this = ArrayPartitionData{other};
+        }
+
+        return *this;
+    }
+
+
     /*!
         @brief      Move assign @a other to this instance
     */
@@ -304,6 +463,9 @@ namespace lue {
             _elements = std::move(other._elements);
             // other._elements.clear();
 
+            _expansion = std::move(other._expansion);
+            _uniform_value = std::move(other._uniform_value);
+
             _span = Span{_elements.data(), _shape};
             other._span = Span{other._elements.data(), other._shape};
 
@@ -320,7 +482,20 @@ namespace lue {
     template<typename Element, Rank rank>
     bool ArrayPartitionData<Element, rank>::operator==(ArrayPartitionData const& other) const
     {
-        return _shape == other._shape && elements() == other.elements();
+        if (_shape != other._shape)
+        {
+            return false;
+        }
+
+        if (is_uniform() && other.is_uniform())
+        {
+            return _uniform_value == other._uniform_value;
+        }
+
+        expand();
+        other.expand();
+
+        return elements() == other.elements();
     }
 
 
@@ -345,9 +520,96 @@ namespace lue {
     }
 
 
+    /*!
+        @brief      Return whether all elements have the same value and the instance has not been
+                    expanded yet
+    */
+    template<typename Element, Rank rank>
+    bool ArrayPartitionData<Element, rank>::is_uniform() const
+    {
+        return _expansion && !_expansion->expanded.load(std::memory_order_acquire);
+    }
+
+
+    /*!
+        @brief      Return the value of all elements
+        @warning    The instance must be uniform
+    */
+    template<typename Element, Rank rank>
+    Element const& ArrayPartitionData<Element, rank>::uniform_value() const
+    {
+        lue_hpx_assert(is_uniform());
+
+        return _uniform_value;
+    }
+
+
+    /*!
+        @brief      Expand a uniform instance into a regular one
+
+        Memory for the elements is allocated and all elements are set to the uniform value. The
+        elements are stored in the expansion state, which is shared by all copies of the instance. Calling
+        this function on an instance which is not uniform has no effect.
+    */
+    template<typename Element, Rank rank>
+    void ArrayPartitionData<Element, rank>::expand() const
+    {
+        // Allocating the elements may suspend the calling HPX thread (see BufferPool::initialize()).
+        // Threads waiting for the expansion to finish must therefore wait on an hpx::mutex, instead of
+        // blocking their worker thread (e.g. in std::call_once).
+        if (_expansion && !_expansion->expanded.load(std::memory_order_acquire))
+        {
+            Expansion& expansion{*_expansion};
+            std::lock_guard<hpx::mutex> const lock{expansion.mutex};
+
+            if (!expansion.expanded.load(std::memory_order_relaxed))
+            {
+                expansion.elements = Elements{lue::nr_elements(_shape)};
+                std::fill_n(expansion.elements.begin(), expansion.elements.size(), _uniform_value);
+                expansion.span = Span{expansion.elements.data(), _shape};
+
+                expansion.expanded.store(true, std::memory_order_release);
+            }
+        }
+    }
+
+
+    /*!
+        @brief      Stop sharing the expansion state with copies of this instance
+
+        A uniform instance becomes a uniform instance with its own expansion state. An expanded instance
+        becomes a regular instance, which still shares the underlying array with elements with its
+        copies.
+    */
+    template<typename Element, Rank rank>
+    void ArrayPartitionData<Element, rank>::detach_expansion()
+    {
+        if (is_uniform())
+        {
+            _expansion = std::make_shared<Expansion>();
+        }
+        else if (_expansion)
+        {
+            _elements = _expansion->elements;
+            _span = Span{_elements.data(), _shape};
+            _expansion.reset();
+        }
+    }
+
+
     template<typename Element, Rank rank>
     void ArrayPartitionData<Element, rank>::reshape(Shape const& shape)
     {
+        detach_expansion();
+
+        if (is_uniform())
+        {
+            _shape = shape;
+            _span = Span{_elements.data(), _shape};
+
+            return;
+        }
+
         // Reshaping the elements while multiple ArrayPartitionData instances
         // refer to it is dangerous because of the _span member. The other
         // instance(s) do not have there _span member updated.
@@ -379,6 +641,16 @@ namespace lue {
     void ArrayPartitionData<Element, rank>::erase(
         Rank const dimension_idx, Index const hyperslab_begin_idx, Index const hyperslab_end_idx)
     {
+        detach_expansion();
+
+        if (is_uniform())
+        {
+            _shape[dimension_idx] -= hyperslab_end_idx - hyperslab_begin_idx;
+            _span = Span{_elements.data(), _shape};
+
+            return;
+        }
+
         _shape = lue::erase(_elements, _shape, dimension_idx, hyperslab_begin_idx, hyperslab_end_idx);
         _span = Span{_elements.data(), _shape};
 
@@ -390,20 +662,30 @@ namespace lue {
     typename ArrayPartitionData<Element, rank>::Elements const& ArrayPartitionData<Element, rank>::elements()
         const
     {
-        return _elements;
+        return _expansion ? _expansion->elements : _elements;
     }
 
 
     template<typename Element, Rank rank>
     typename ArrayPartitionData<Element, rank>::Elements& ArrayPartitionData<Element, rank>::elements()
     {
-        return _elements;
+        return _expansion ? _expansion->elements : _elements;
+    }
+
+
+    template<typename Element, Rank rank>
+    typename ArrayPartitionData<Element, rank>::Span const& ArrayPartitionData<Element, rank>::element_span()
+        const
+    {
+        return _expansion ? _expansion->span : _span;
     }
 
 
     template<typename Element, Rank rank>
     typename ArrayPartitionData<Element, rank>::ConstIterator ArrayPartitionData<Element, rank>::begin() const
     {
+        expand();
+
         return elements().begin();
     }
 
@@ -411,6 +693,8 @@ namespace lue {
     template<typename Element, Rank rank>
     typename ArrayPartitionData<Element, rank>::Iterator ArrayPartitionData<Element, rank>::begin()
     {
+        expand();
+
         return elements().begin();
     }
 
@@ -418,6 +702,8 @@ namespace lue {
     template<typename Element, Rank rank>
     typename ArrayPartitionData<Element, rank>::ConstIterator ArrayPartitionData<Element, rank>::end() const
     {
+        expand();
+
         return elements().end();
     }
 
@@ -425,6 +711,8 @@ namespace lue {
     template<typename Element, Rank rank>
     typename ArrayPartitionData<Element, rank>::Iterator ArrayPartitionData<Element, rank>::end()
     {
+        expand();
+
         return elements().end();
     }
 
@@ -432,25 +720,31 @@ namespace lue {
     template<typename Element, Rank rank>
     Element& ArrayPartitionData<Element, rank>::operator[](Index const idx)
     {
-        lue_hpx_assert(idx < _elements.size());
+        expand();
+
+        lue_hpx_assert(idx < elements().size());
 
-        return _elements[idx];
+        return elements()[idx];
     }
 
 
     template<typename Element, Rank rank>
     Element const& ArrayPartitionData<Element, rank>::operator[](Index const idx) const
     {
-        lue_hpx_assert(idx < _elements.size());
+        expand();
 
-        return _elements[idx];
+        lue_hpx_assert(idx < elements().size());
+
+        return elements()[idx];
     }
 
 
     template<typename Element, Rank rank>
     typename ArrayPartitionData<Element, rank>::Span const& ArrayPartitionData<Element, rank>::span() const
     {
-        return _span;
+        expand();
+
+        return element_span();
     }
 
 
@@ -459,6 +753,22 @@ namespace lue {
     {
         static_assert(rank > 0 && rank < 3);
 
+        if (is_uniform())
+        {
+            Shape shape{};
+
+            for (Rank dimension_idx = 0; dimension_idx < rank; ++dimension_idx)
+            {
+                auto const [begin, end] = slices[dimension_idx];
+                lue_hpx_assert(end >= begin);
+                lue_hpx_assert(end <= _shape[dimension_idx]);
+
+                shape[dimension_idx] = end - begin;
+            }
+
+            return ArrayPartitionData{shape, _uniform_value, UniformTag{}};
+        }
+
         // TODO Maybe also allow a slice into a shared buffer. This would prevent
         //      the copy of the sliced elements into the new instance.
 
@@ -528,11 +838,24 @@ namespace lue {
     template<typename Element, Rank rank>
     void ArrayPartitionData<Element, rank>::assert_invariants() const
     {
-        lue_hpx_assert(lue::nr_elements(_shape) == _elements.size());
-        // lue_hpx_assert(_span.size() == _elements.size());
-        // lue_hpx_assert(_span.data_handle() == _elements.data());
-        lue_hpx_assert(static_cast<Count>(_span.size()) == static_cast<Count>(_elements.size()));
-        lue_hpx_assert(_span.data_handle() == _elements.data());
+        if (_expansion)
+        {
+            lue_hpx_assert(_elements.empty());
+
+            if (is_uniform())
+            {
+                return;
+            }
+        }
+
+        Elements const& elements{this->elements()};
+        Span const& span{element_span()};
+
+        lue_hpx_assert(lue::nr_elements(_shape) == elements.size());
+        // lue_hpx_assert(span.size() == elements.size());
+        // lue_hpx_assert(span.data_handle() == elements.data());
+        lue_hpx_assert(static_cast<Count>(span.size()) == static_cast<Count>(elements.size()));
+        lue_hpx_assert(span.data_handle() == elements.data());
     }
 
 
@@ -566,6 +889,8 @@ namespace lue {
 
             ArrayPartitionData(Shape const& shape, Element const& value);
 
+            ArrayPartitionData(Shape const& shape, Element const& value, UniformTag);
+
             ArrayPartitionData(ArrayPartitionData const&) = default;
 
             ArrayPartitionData(ArrayPartitionData&&) = default;
@@ -584,6 +909,10 @@ namespace lue {
 
             bool empty() const;
 
+            bool is_uniform() const;
+
+            Element const& uniform_value() const;
+
             void reshape(Shape const& shape);
 
             ConstIterator begin() const;
@@ -660,6 +989,21 @@ namespace lue {
     }
 
 
+    /*!
+        @brief      Construct an instance with value @a value
+
+        Array scalars are never represented as uniform array partition data. This constructor exists to
+        allow generic code to treat scalars the same as arrays.
+    */
+    template<typename Element>
+    ArrayPartitionData<Element, 0>::ArrayPartitionData(Shape const& shape, Element const& value, UniformTag):
+
+        ArrayPartitionData{shape, value}
+
+    {
+    }
+
+
     template<typename Element>
     bool ArrayPartitionData<Element, 0>::operator==(ArrayPartitionData const& other) const
     {
@@ -701,6 +1045,25 @@ namespace lue {
     }
 
 
+    /*!
+        @brief      Return false
+
+        Array scalars are never represented as uniform array partition data.
+    */
+    template<typename Element>
+    bool ArrayPartitionData<Element, 0>::is_uniform() const
+    {
+        return false;
+    }
+
+
+    template<typename Element>
+    Element const& ArrayPartitionData<Element, 0>::uniform_value() const
+    {
+        return _elements[0];
+    }
+
+
     template<typename Element>
     typename ArrayPartitionData<Element, 0>::ConstIterator ArrayPartitionData<Element, 0>::begin() const
     {
@@ -786,6 +1149,11 @@ namespace lue {
     template<typename Element, Rank rank>
     ArrayPartitionData<Element, rank> deep_copy(ArrayPartitionData<Element, rank> const& data)
     {
+        if (data.is_uniform())
+        {
+            return ArrayPartitionData<Element, rank>{data.shape(), data.uniform_value(), UniformTag{}};
+        }
+
         ArrayPartitionData<Element, rank> copy{data.shape()};
 
         std::copy(data.begin(), data.end(), copy.begin());
@@ -39,6 +39,8 @@ namespace lue {
 
             using Slices = typename Server::Slices;
 
+            using Version = typename Server::Version;
+
             ArrayPartition();
 
             explicit ArrayPartition(hpx::id_type const& component_id);
@@ -90,6 +92,10 @@ namespace lue {
             auto nr_elements(hpx::launch::async_policy) const -> hpx::future<Count>;
 
             auto nr_elements(hpx::launch::sync_policy) const -> Count;
+
+            auto version(hpx::launch::async_policy) const -> hpx::future<Version>;
+
+            auto version(hpx::launch::sync_policy) const -> Version;
     };
 
 
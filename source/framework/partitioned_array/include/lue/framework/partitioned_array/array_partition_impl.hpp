@@ -220,6 +220,38 @@ namespace lue {
     }
 
 
+    /*!
+        @brief      Return a future to the number of times the elements have been replaced
+    */
+    template<typename Element, Rank rank>
+    auto ArrayPartition<Element, rank>::version(hpx::launch::async_policy) const
+        -> hpx::future<typename ArrayPartition<Element, rank>::Version>
+    {
+        lue_hpx_assert(this->is_ready());
+        lue_hpx_assert(this->get_id());
+
+        using Action = Server::VersionAction;
+
+        return hpx::async(Action{}, this->get_id());
+    }
+
+
+    /*!
+        @brief      Return the number of times the elements have been replaced
+    */
+    template<typename Element, Rank rank>
+    auto ArrayPartition<Element, rank>::version(hpx::launch::sync_policy) const ->
+        typename ArrayPartition<Element, rank>::Version
+    {
+        lue_hpx_assert(this->is_ready());
+        lue_hpx_assert(this->get_id());
+
+        using Action = Server::VersionAction;
+
+        return Action{}(this->get_id());
+    }
+
+
     /*!
         @brief      Return a future to the offset
     */
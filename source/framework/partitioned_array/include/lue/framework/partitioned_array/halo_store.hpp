@@ -0,0 +1,188 @@
+#pragma once
+#include "lue/framework/core/array.hpp"
+#include "lue/framework/partitioned_array/array_partition_decl.hpp"
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+
+namespace lue {
+
+    /*!
+        @brief      Class template for storing the halos of the partitions of a partitioned array
+        @tparam     Element Type for representing element values
+        @tparam     rank Array rank
+
+        The halo of a partition consists of the borders of its neighbouring partitions facing it. Focal
+        operations need these to calculate results for the cells near the partition's sides. Obtaining
+        them involves copying elements between partitions, possibly located in other localities.
+        Storing them allows successive focal operations on the same array to reuse them.
+
+        Borders are stored per slot. A slot corresponds with a partition and the position of one of
+        its neighbours. Each stored border is keyed on the identity and version of the neighbouring
+        partition it was copied from, and on its width. A stored border is only reused when the
+        partition currently at the neighbour's position has the same identity and version, and
+        the border is at least as wide as asked for. Since partitions increment their version each time
+        their elements are replaced, this detects modifications by fill() and set_data(), also when
+        they are made through copies of the partition clients. Storing a border releases the one
+        previously stored in the same slot.
+
+        Instances are safe to use from multiple threads.
+    */
+    template<typename Element, Rank rank>
+    class HaloStore
+    {
+
+        public:
+
+            //! Type of client-side representation of an array partition
+            using Partition = ArrayPartition<Element, rank>;
+
+            using Version = typename Partition::Version;
+
+            /*!
+                @brief      Type of the halo of a single partition
+
+                The halo is a 3 x 3 collection of partitions, centred at the partition itself. Each
+                valid partition contains the border of the corresponding neighbouring partition, located
+                in the same locality as the centre partition. Partitions corresponding with the centre
+                and with neighbours beyond the array's extent are not valid.
+            */
+            using Halo = ArrayPartitionData<Partition, rank>;
+
+            //! Type of the collection of halos, one per array partition
+            using Halos = Array<Halo, rank>;
+
+
+            /*!
+                @brief      Border stored in a slot
+            */
+            class Border
+            {
+
+                public:
+
+                    //! ID of the neighbouring partition the border was copied from
+                    hpx::id_type neighbour_id;
+
+                    //! Version of the neighbouring partition at the time the border was copied
+                    Version version;
+
+                    //! Width of the border
+                    Radius radius;
+
+                    //! Partition containing the border
+                    Partition partition;
+            };
+
+
+            HaloStore():
+
+                _mutex{},
+                _borders{}
+
+            {
+            }
+
+
+            HaloStore(HaloStore const&) = delete;
+
+            HaloStore(HaloStore&&) = delete;
+
+            ~HaloStore() = default;
+
+            auto operator=(HaloStore const&) -> HaloStore& = delete;
+
+            auto operator=(HaloStore&&) -> HaloStore& = delete;
+
+
+            /*!
+                @brief      Make sure the store contains @a nr_slots slots
+
+                If the number of slots changes, all stored borders are released.
+            */
+            void resize(Count const nr_slots)
+            {
+                std::scoped_lock const lock{_mutex};
+
+                if (static_cast<Count>(_borders.size()) != nr_slots)
+                {
+                    _borders.clear();
+                    _borders.resize(nr_slots);
+                }
+            }
+
+
+            /*!
+                @brief      Return the border stored in slot @a slot, if it was copied from partition
+                            @a neighbour_id at @a version and is at least @a radius wide
+            */
+            auto border(
+                Index const slot,
+                hpx::id_type const& neighbour_id,
+                Version const version,
+                Radius const radius) const -> std::optional<Partition>
+            {
+                std::scoped_lock const lock{_mutex};
+
+                if (slot < static_cast<Index>(_borders.size()))
+                {
+                    auto const& border{_borders[slot]};
+
+                    if (border && border->neighbour_id == neighbour_id && border->version == version &&
+                        border->radius >= radius)
+                    {
+                        return border->partition;
+                    }
+                }
+
+                return std::nullopt;
+            }
+
+
+            /*!
+                @brief      Store @a border in slot @a slot
+
+                A border already stored for the same neighbour and version is only replaced if
+                @a border is wider. Borders stored for other neighbours or versions are released.
+                Borders for slots which are not present anymore are ignored.
+            */
+            void store(Index const slot, Border border)
+            {
+                std::scoped_lock const lock{_mutex};
+
+                if (slot < static_cast<Index>(_borders.size()))
+                {
+                    auto& stored_border{_borders[slot]};
+
+                    if (!stored_border || stored_border->neighbour_id != border.neighbour_id ||
+                        stored_border->version != border.version || stored_border->radius < border.radius)
+                    {
+                        stored_border = std::move(border);
+                    }
+                }
+            }
+
+
+            /*!
+                @brief      Release all stored borders
+
+                Focal operations which are already using the borders are not affected.
+            */
+            void clear()
+            {
+                std::scoped_lock const lock{_mutex};
+
+                _borders.clear();
+            }
+
+        private:
+
+            mutable std::mutex _mutex;
+
+            //! Per slot, the border stored, if any
+            std::vector<std::optional<Border>> _borders;
+    };
+
+}  // namespace lue
@@ -4,12 +4,17 @@
 #include "lue/framework/partitioned_array/export.hpp"
 #include <hpx/include/components.hpp>
 #include <hpx/preprocessor/cat.hpp>
+#include <cstdint>
 
 
 namespace lue::server {
 
     /*!
         @brief      Component server class for partitioned array partitions
+
+        Each instance keeps a version, which is incremented each time its elements are replaced by
+        fill() or set_data(). Copies of elements, like the halos stored with a partitioned array,
+        can compare versions to determine whether they are still up to date.
     */
     template<typename Element, Rank rank>
     class LUE_FPA_EXPORT ArrayPartition:
@@ -33,6 +38,8 @@ namespace lue::server {
 
             using Slices = typename Data::Slices;
 
+            using Version = std::uint64_t;
+
 
             ArrayPartition(Offset const& offset, Shape const& shape);
 
@@ -66,6 +73,8 @@ namespace lue::server {
 
             auto nr_elements() const -> Count;
 
+            auto version() const -> Version;
+
             HPX_DEFINE_COMPONENT_ACTION(ArrayPartition, data, DataAction)
             HPX_DEFINE_COMPONENT_ACTION(ArrayPartition, slice, SliceAction)
             HPX_DEFINE_COMPONENT_ACTION(ArrayPartition, fill, FillAction)
@@ -73,12 +82,16 @@ namespace lue::server {
             HPX_DEFINE_COMPONENT_ACTION(ArrayPartition, offset, OffsetAction)
             HPX_DEFINE_COMPONENT_ACTION(ArrayPartition, shape, ShapeAction)
             HPX_DEFINE_COMPONENT_ACTION(ArrayPartition, nr_elements, NrElementsAction)
+            HPX_DEFINE_COMPONENT_ACTION(ArrayPartition, version, VersionAction)
 
         private:
 
             Offset _offset;
 
             Data _data;
+
+            //! Number of times the elements have been replaced
+            Version _version;
     };
 
 }  // namespace lue::server
@@ -94,7 +107,8 @@ namespace lue::server {
     HPX_REGISTER_ACTION_DECLARATION(ArrayPartition::OffsetAction, HPX_PP_CAT(ArrayPartition, OffsetAction))  \
     HPX_REGISTER_ACTION_DECLARATION(ArrayPartition::ShapeAction, HPX_PP_CAT(ArrayPartition, ShapeAction))    \
     HPX_REGISTER_ACTION_DECLARATION(                                                                         \
-        ArrayPartition::NrElementsAction, HPX_PP_CAT(ArrayPartition, NrElementsAction))
+        ArrayPartition::NrElementsAction, HPX_PP_CAT(ArrayPartition, NrElementsAction))                      \
+    HPX_REGISTER_ACTION_DECLARATION(ArrayPartition::VersionAction, HPX_PP_CAT(ArrayPartition, VersionAction))
 
 // Register array partition declarations for an element type and rank
 #define LUE_REGISTER_ARRAY_PARTITION_DECLARATION(Element, rank)                                              \
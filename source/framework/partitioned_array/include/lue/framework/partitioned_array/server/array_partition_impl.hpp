@@ -15,7 +15,8 @@ namespace lue::server {
 
         Base{},
         _offset{offset},
-        _data{shape}
+        _data{shape},
+        _version{0}
 
     {
     }
@@ -25,15 +26,16 @@ namespace lue::server {
         @brief      Construct an instance based on an array partition @a
                     shape and an initial @a value
 
-        The @a shape and the @a value passed in will be passed to the
-        constructor of @a Data.
+        The data will be uniform. Memory for the individual elements is only allocated once they are
+        accessed.
     */
     template<typename Element, Rank rank>
     ArrayPartition<Element, rank>::ArrayPartition(Offset const& offset, Shape const& shape, Element value):
 
         Base{},
         _offset{offset},
-        _data{shape, value}
+        _data{shape, value, UniformTag{}},
+        _version{0}
 
     {
         // Element is assumed to be a trivial type. Otherwise, don't pass
@@ -52,7 +54,8 @@ namespace lue::server {
 
         Base{},
         _offset{offset},
-        _data{data}
+        _data{data},
+        _version{0}
 
     {
     }
@@ -68,7 +71,8 @@ namespace lue::server {
 
         Base{},
         _offset{offset},
-        _data{std::move(data)}
+        _data{std::move(data)},
+        _version{0}
 
     {
     }
@@ -79,7 +83,8 @@ namespace lue::server {
 
         Base{other},
         _offset{other._offset},
-        _data{other._data}
+        _data{other._data},
+        _version{other._version}
 
     {
     }
@@ -90,7 +95,8 @@ namespace lue::server {
 
         Base{std::move(other)},
         _offset{std::move(other._offset)},
-        _data{std::move(other._data)}
+        _data{std::move(other._data)},
+        _version{other._version}
 
     {
     }
@@ -124,7 +130,8 @@ namespace lue::server {
     template<typename Element, Rank rank>
     void ArrayPartition<Element, rank>::fill(Element value)
     {
-        std::fill(_data.begin(), _data.end(), value);
+        _data = Data{_data.shape(), value, UniformTag{}};
+        ++_version;
     }
 
 
@@ -132,6 +139,7 @@ namespace lue::server {
     void ArrayPartition<Element, rank>::set_data(Data const& data)
     {
         _data = data;
+        ++_version;
     }
 
 
@@ -155,6 +163,16 @@ namespace lue::server {
         return _data.nr_elements();
     }
 
+
+    /*!
+        @brief      Return the number of times the elements have been replaced
+    */
+    template<typename Element, Rank rank>
+    auto ArrayPartition<Element, rank>::version() const -> Version
+    {
+        return _version;
+    }
+
 }  // namespace lue::server
 
 
@@ -166,7 +184,8 @@ namespace lue::server {
     HPX_REGISTER_ACTION(ArrayPartition::SetDataAction, HPX_PP_CAT(ArrayPartition, SetDataAction));           \
     HPX_REGISTER_ACTION(ArrayPartition::OffsetAction, HPX_PP_CAT(ArrayPartition, OffsetAction));             \
     HPX_REGISTER_ACTION(ArrayPartition::ShapeAction, HPX_PP_CAT(ArrayPartition, ShapeAction));               \
-    HPX_REGISTER_ACTION(ArrayPartition::NrElementsAction, HPX_PP_CAT(ArrayPartition, NrElementsAction));
+    HPX_REGISTER_ACTION(ArrayPartition::NrElementsAction, HPX_PP_CAT(ArrayPartition, NrElementsAction));     \
+    HPX_REGISTER_ACTION(ArrayPartition::VersionAction, HPX_PP_CAT(ArrayPartition, VersionAction));
 
 #define LUE_REGISTER_ARRAY_PARTITION_COMPONENT(ArrayPartition)                                               \
     using HPX_PP_CAT(ArrayPartition, Component) = hpx::components::component<ArrayPartition>;                \
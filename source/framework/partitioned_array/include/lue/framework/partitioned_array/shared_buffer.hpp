@@ -1,5 +1,12 @@
 #pragma once
 #include "lue/framework/core/array.hpp"
+#include "lue/framework/core/assert.hpp"
+#include "lue/framework/core/define.hpp"
+#include "lue/framework/core/partition_allocator.hpp"
+#include <hpx/modules/threading_base.hpp>
+#include <algorithm>
+#include <memory>
+#include <type_traits>
 
 
 namespace lue {
@@ -8,6 +15,9 @@ namespace lue {
         @brief      Class for managing a contiguous buffer of elements which can be shared between instances
 
         Instances contain a shared pointer to a, possibly empty, array of elements.
+
+        Buffers for arithmetic elements are obtained from the PartitionAllocator when they are allocated on
+        an HPX thread. Other buffers are allocated using the standard allocator.
     */
     template<typename Element>
     class SharedBuffer
@@ -15,15 +25,217 @@ namespace lue {
 
         public:
 
-            //! The type of the collection of elements
-            using Elements = Array<Element, 1>;  // A 1D array containing the actual buffer
+            using Iterator = Element*;
 
-            //! The type of the reference counted pointer to the collection of elements
-            using Pointer = std::shared_ptr<Elements>;
+            using ConstIterator = Element const*;
+
+
+            /*!
+                @brief      Contiguous collection of value-initialized elements
+
+                The number of elements can be less than the size of the underlying buffer. Only growing
+                beyond the size of the buffer results in a new buffer. Element values are not preserved
+                when that happens.
+            */
+            class Elements
+            {
+
+                public:
+
+                    explicit Elements(Size const size):
+
+                        _nr_elements{size},
+                        _buffer_size{size},
+                        _pooled{false},
+                        _buffer{allocate(_buffer_size, _pooled)}
+
+                    {
+                    }
+
+
+                    Elements(Elements const& other) = delete;
+
+                    Elements(Elements&& other) = delete;
+
+
+                    ~Elements()
+                    {
+                        release();
+                    }
+
+
+                    auto operator=(Elements const& other) -> Elements& = delete;
+
+                    auto operator=(Elements&& other) -> Elements& = delete;
+
+
+                    auto data() -> Element*
+                    {
+                        return _buffer;
+                    }
+
+
+                    auto data() const -> Element const*
+                    {
+                        return _buffer;
+                    }
+
+
+                    auto nr_elements() const -> Size
+                    {
+                        return _nr_elements;
+                    }
+
+
+                    auto empty() const -> bool
+                    {
+                        return _nr_elements == 0;
+                    }
+
+
+                    auto begin() -> Iterator
+                    {
+                        return _buffer;
+                    }
+
+
+                    auto end() -> Iterator
+                    {
+                        return _buffer + _nr_elements;
+                    }
+
+
+                    auto begin() const -> ConstIterator
+                    {
+                        return _buffer;
+                    }
 
-            using Iterator = Elements::Iterator;
 
-            using ConstIterator = Elements::ConstIterator;
+                    auto end() const -> ConstIterator
+                    {
+                        return _buffer + _nr_elements;
+                    }
+
+
+                    auto operator[](Index const idx) -> Element&
+                    {
+                        return _buffer[idx];
+                    }
+
+
+                    auto operator[](Index const idx) const -> Element const&
+                    {
+                        return _buffer[idx];
+                    }
+
+
+                    void resize(Size const size)
+                    {
+                        if (size > _buffer_size)
+                        {
+                            release();
+                            _buffer_size = size;
+                            _buffer = allocate(_buffer_size, _pooled);
+                        }
+
+                        _nr_elements = size;
+                    }
+
+
+                    /*!
+                        @brief      Remove elements in range [@a begin - @a end)
+
+                        Elements located after the range to remove are moved into the range of removed
+                        elements. The underlying buffer is not resized.
+                    */
+                    void remove(Iterator begin, Iterator end)
+                    {
+                        lue_hpx_assert(std::distance(begin, end) <= _nr_elements);
+
+                        std::move(end, this->end(), begin);
+                        _nr_elements -= std::distance(begin, end);
+                    }
+
+
+                    void clear()
+                    {
+                        release();
+                        _nr_elements = 0;
+                        _buffer_size = 0;
+                    }
+
+                private:
+
+                    static constexpr bool poolable{std::is_arithmetic_v<Element>};
+
+
+                    static auto allocate(Size const size, bool& pooled) -> Element*
+                    {
+                        Element* buffer{nullptr};
+                        pooled = false;
+
+                        if (size > 0)
+                        {
+                            if constexpr (poolable)
+                            {
+                                // The pool requires a running HPX runtime
+                                pooled = hpx::threads::get_self_ptr() != nullptr;
+                            }
+
+                            if (pooled)
+                            {
+                                buffer =
+                                    PartitionAllocator<Element>{}.allocate(static_cast<std::size_t>(size));
+                            }
+                            else
+                            {
+                                buffer = std::allocator<Element>{}.allocate(static_cast<std::size_t>(size));
+                            }
+
+                            std::uninitialized_value_construct_n(buffer, size);
+                        }
+
+                        return buffer;
+                    }
+
+
+                    void release()
+                    {
+                        if (_buffer != nullptr)
+                        {
+                            std::destroy_n(_buffer, _buffer_size);
+
+                            if (_pooled)
+                            {
+                                PartitionAllocator<Element>{}.deallocate(
+                                    _buffer, static_cast<std::size_t>(_buffer_size));
+                            }
+                            else
+                            {
+                                std::allocator<Element>{}.deallocate(
+                                    _buffer, static_cast<std::size_t>(_buffer_size));
+                            }
+
+                            _buffer = nullptr;
+                        }
+                    }
+
+
+                    //! Number of elements in the collection
+                    Size _nr_elements;
+
+                    //! Number of elements in the underlying buffer
+                    Size _buffer_size;
+
+                    //! Whether the buffer was obtained from the PartitionAllocator
+                    bool _pooled;
+
+                    Element* _buffer;
+            };
+
+
+            //! The type of the reference counted pointer to the collection of elements
+            using Pointer = std::shared_ptr<Elements>;
 
 
             SharedBuffer():
@@ -225,9 +437,7 @@ namespace lue {
             */
             void resize(Size const size)
             {
-                (*_ptr).reshape(typename Elements::Shape{size});
-
-                // (*_ptr).resize(size, boost::container::default_init_t{});
+                (*_ptr).resize(size);
 
                 assert_invariants();
             }
@@ -288,10 +498,7 @@ namespace lue {
             {
                 lue_hpx_assert(!_ptr);
 
-                // Default initialization of the elements. In case of
-                // numeric values, the values are indeterminate
-                // _ptr = std::make_shared<Elements>(size, boost::container::default_init_t{});
-                _ptr = std::make_shared<Elements>(typename Elements::Shape{size});
+                _ptr = std::make_shared<Elements>(size);
 
                 assert_invariants();
             }
@@ -1,5 +1,6 @@
 #pragma once
 #include "lue/framework/partitioned_array/array_partition_decl.hpp"
+#include "lue/framework/partitioned_array/halo_store.hpp"
 
 
 namespace lue {
@@ -18,6 +19,11 @@ namespace lue {
 
         The array is partitioned. Partitions can be located in multiple localities (processes).
 
+        The halos of the partitions obtained by focal operations are stored with the array, allowing
+        successive focal operations to reuse them. Stored halos are only reused while the partitions
+        they were copied from are unchanged. They are released when the partitions are accessed for
+        modification, and when the array is replaced.
+
         PartitionedArray is a move-only type.
     */
     template<typename Element, Rank rank>
@@ -83,6 +89,8 @@ namespace lue {
 
             auto partitions() const -> Partitions const&;
 
+            auto halo_store() const -> std::shared_ptr<HaloStore<Element, rank>> const&;
+
         private:
 
             void assert_invariants() const;
@@ -95,6 +103,9 @@ namespace lue {
 
             //! Array of partitions
             Partitions _partitions;
+
+            //! Halos of the partitions, shared by focal operations on this array
+            std::shared_ptr<HaloStore<Element, rank>> _halo_store_ptr;
     };
 
 
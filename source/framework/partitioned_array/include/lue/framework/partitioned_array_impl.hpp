@@ -37,7 +37,8 @@ namespace lue {
 
         _shape{shape},
         _localities_ptr{std::move(localities_ptr)},
-        _partitions{std::move(partitions)}
+        _partitions{std::move(partitions)},
+        _halo_store_ptr{std::make_shared<HaloStore<Element, rank>>()}
 
     {
         assert_invariants();
@@ -98,10 +99,19 @@ namespace lue {
 
     /*!
         @brief      Return the partitions
+
+        Since partitions may be replaced through the returned reference, the halos stored in the halo
+        store are released.
     */
     template<typename Element, Rank rank>
     auto PartitionedArray<Element, rank>::partitions() -> Partitions&
     {
+        // A moved-from instance does not have a halo store anymore
+        if (_halo_store_ptr)
+        {
+            _halo_store_ptr->clear();
+        }
+
         return _partitions;
     }
 
@@ -116,6 +126,22 @@ namespace lue {
     }
 
 
+    /*!
+        @brief      Return the store of the halos of the partitions
+
+        The store is meant to be used by focal operations. It is not part of the array's logical
+        state, which is why it can be obtained through a const instance. Tasks which store halos
+        asynchronously can keep the store alive by copying the pointer.
+    */
+    template<typename Element, Rank rank>
+    auto PartitionedArray<Element, rank>::halo_store() const
+        -> std::shared_ptr<HaloStore<Element, rank>> const&
+    {
+        lue_hpx_assert(_halo_store_ptr);
+        return _halo_store_ptr;
+    }
+
+
     template<typename Element, Rank rank>
     void PartitionedArray<Element, rank>::assert_invariants() const
     {
@@ -84,6 +84,96 @@ BOOST_AUTO_TEST_CASE(construct_with_shape_and_value)
 }
 
 
+BOOST_AUTO_TEST_CASE(construct_uniform)
+{
+    Shape<2> shape{{30, 40}};
+    Data<2> data{shape, 5, lue::UniformTag{}};
+
+    BOOST_CHECK_EQUAL(data.shape(), shape);
+
+    BOOST_CHECK(!data.empty());
+    BOOST_CHECK_EQUAL(data.nr_elements(), 30 * 40);
+    BOOST_CHECK(data.is_uniform());
+    BOOST_CHECK_EQUAL(data.uniform_value(), 5);
+
+    // Copies and slices of uniform data are uniform as well
+    {
+        Data<2> copy{data};
+        BOOST_CHECK(copy.is_uniform());
+        BOOST_CHECK(copy == data);
+
+        Slices<2> slices{Slice<2>{5, 10}, Slice<2>{0, 40}};
+        auto data_slice = data.slice(slices);
+        BOOST_CHECK(data_slice.is_uniform());
+        BOOST_CHECK_EQUAL(data_slice.shape(), (Shape<2>{{5, 40}}));
+        BOOST_CHECK_EQUAL(data_slice.uniform_value(), 5);
+    }
+
+    // Accessing elements expands the instance
+    {
+        std::vector<Value> values(30 * 40, 5);
+        BOOST_CHECK_EQUAL_COLLECTIONS(data.begin(), data.end(), values.begin(), values.end());
+        BOOST_CHECK(!data.is_uniform());
+
+        data(0, 0) = 6;
+        BOOST_CHECK_EQUAL(data(0, 0), 6);
+        BOOST_CHECK_EQUAL(data(29, 39), 5);
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(write_through_uniform_copy)
+{
+    Shape<2> shape{{30, 40}};
+    Data<2> data{shape, 5, lue::UniformTag{}};
+
+    // Writing through a copy of a uniform instance must be visible through the original, as with
+    // copies of regular instances
+    {
+        Data<2> copy{data};
+        copy(3, 4) = 6;
+
+        BOOST_CHECK(!copy.is_uniform());
+        BOOST_CHECK(!data.is_uniform());
+        BOOST_CHECK_EQUAL(data(3, 4), 6);
+        BOOST_CHECK_EQUAL(data(0, 0), 5);
+        BOOST_CHECK_EQUAL(data.data(), copy.data());
+    }
+
+    // Copies made after expansion share the elements as well
+    {
+        Data<2> copy{data};
+        copy[0] = 7;
+
+        BOOST_CHECK_EQUAL(data[0], 7);
+    }
+
+    // Copies of a copy share the same expansion
+    {
+        Data<2> other{shape, 5, lue::UniformTag{}};
+        Data<2> copy1{other};
+        Data<2> copy2{copy1};
+
+        copy2(29, 39) = 8;
+
+        BOOST_CHECK_EQUAL(other(29, 39), 8);
+        BOOST_CHECK_EQUAL(copy1(29, 39), 8);
+    }
+
+    // Reshaping a uniform copy detaches it from the original
+    {
+        Data<2> other{shape, 5, lue::UniformTag{}};
+        Data<2> copy{other};
+
+        copy.reshape(Shape<2>{{3, 4}});
+        copy(0, 0) = 9;
+
+        BOOST_CHECK(other.is_uniform());
+        BOOST_CHECK_EQUAL(other(0, 0), 5);
+    }
+}
+
+
 BOOST_AUTO_TEST_CASE(construct_initializer_list)
 {
     Shape<2> shape{{3, 2}};
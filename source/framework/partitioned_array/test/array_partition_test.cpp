@@ -2,6 +2,7 @@
 #include "lue/framework/partitioned_array/array_partition_data.hpp"
 #include "lue/framework/partitioned_array/array_partition_decl.hpp"
 #include "lue/framework/test/hpx_unit_test.hpp"
+#include <algorithm>
 
 
 namespace {
@@ -57,6 +58,48 @@ BOOST_AUTO_TEST_CASE(construct_initialized_with_single_value)
 }
 
 
+BOOST_AUTO_TEST_CASE(version)
+{
+    Offset offset{3, 4};
+    Shape shape{{5, 6}};
+
+    PartitionClient partition{hpx::find_here(), offset, shape, 9};
+    BOOST_CHECK_EQUAL(partition.version(hpx::launch::sync), 0u);
+
+    // Reading elements does not change the version
+    partition.data(hpx::launch::sync);
+    BOOST_CHECK_EQUAL(partition.version(hpx::launch::sync), 0u);
+
+    // Replacing them does, also when done through a copy of the client
+    partition.fill(hpx::launch::sync, 5);
+    BOOST_CHECK_EQUAL(partition.version(hpx::launch::sync), 1u);
+
+    PartitionClient copy{partition};
+    copy.set_data(hpx::launch::sync, Data{shape, 6});
+    BOOST_CHECK_EQUAL(partition.version(hpx::launch::sync), 2u);
+}
+
+
+BOOST_AUTO_TEST_CASE(reuse_buffer)
+{
+    Shape shape{{5, 6}};
+
+    {
+        Data data{shape};
+    }
+
+    auto const nr_hits{lue::PartitionAllocator<Value>::statistics().nr_hits};
+
+    {
+        // The buffer of the previous partition data, of the same shape, must be reused
+        Data data{shape, 5};
+        BOOST_CHECK(std::all_of(data.begin(), data.end(), [](Value const value) { return value == 5; }));
+    }
+
+    BOOST_CHECK_GT(lue::PartitionAllocator<Value>::statistics().nr_hits, nr_hits);
+}
+
+
 // BOOST_AUTO_TEST_CASE(scalar_array)
 // {
 //     std::size_t const rank = 0;
@@ -197,3 +197,52 @@ BOOST_AUTO_TEST_CASE(array_with_array_partitions)
         partitions[i] = Partition{};
     }
 }
+
+
+BOOST_AUTO_TEST_CASE(halo_store)
+{
+    using HaloStore = lue::HaloStore<Value, rank>;
+    using Partition = HaloStore::Partition;
+    using Border = HaloStore::Border;
+
+    PartitionedArray array{};
+    auto const store_ptr{array.halo_store()};
+    HaloStore& store{*store_ptr};
+
+    Partition const neighbour1{hpx::find_here(), Offset{}, Shape{{2, 2}}, 1};
+    Partition const neighbour2{hpx::find_here(), Offset{}, Shape{{2, 2}}, 2};
+    Partition const border{hpx::find_here(), Offset{}, Shape{{2, 2}}, 3};
+    hpx::id_type const neighbour_id1{neighbour1.get_id()};
+    hpx::id_type const neighbour_id2{neighbour2.get_id()};
+
+    store.resize(2);
+    BOOST_CHECK(!store.border(0, neighbour_id1, 0, 1));
+
+    // Borders serve requests for radii up to the one they were stored for, as long as they were
+    // copied from the same neighbour, at the same version
+    store.store(0, Border{neighbour_id1, 0, 2, border});
+    BOOST_CHECK(store.border(0, neighbour_id1, 0, 1));
+    BOOST_CHECK(store.border(0, neighbour_id1, 0, 2));
+    BOOST_CHECK(!store.border(0, neighbour_id1, 0, 3));
+    BOOST_CHECK(!store.border(0, neighbour_id1, 1, 1));
+    BOOST_CHECK(!store.border(0, neighbour_id2, 0, 1));
+    BOOST_CHECK(!store.border(1, neighbour_id1, 0, 1));
+
+    // Narrower borders don't replace wider ones of the same neighbour and version
+    store.store(0, Border{neighbour_id1, 0, 1, Partition{}});
+    BOOST_CHECK_EQUAL(store.border(0, neighbour_id1, 0, 2)->get_id(), border.get_id());
+
+    // Borders of a newer version replace older ones
+    store.store(0, Border{neighbour_id1, 1, 1, border});
+    BOOST_CHECK(!store.border(0, neighbour_id1, 0, 1));
+    BOOST_CHECK(store.border(0, neighbour_id1, 1, 1));
+
+    // The store moves along with the array
+    PartitionedArray moved_array{std::move(array)};
+    BOOST_CHECK_EQUAL(moved_array.halo_store(), store_ptr);
+    BOOST_CHECK(store.border(0, neighbour_id1, 1, 1));
+
+    // Accessing the partitions for modification releases the borders
+    moved_array.partitions();
+    BOOST_CHECK(!store.border(0, neighbour_id1, 1, 1));
+}
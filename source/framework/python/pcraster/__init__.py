@@ -852,14 +852,51 @@ def ldd(expression):
     raise RuntimeError("Unsupported argument: {}".format(expression))
 
 
+def lddcreate_thresholds_are_disabled(*thresholds):
+    """
+    Return whether none of the depression thresholds passed in is effective
+
+    PCRaster keeps depressions exceeding one of the thresholds. A threshold is only
+    ineffective if it is at least 1e31. Spatial thresholds are reduced to their minimum
+    value first.
+    """
+    threshold_value = np.float32(1e31)
+
+    for threshold in read_if_necessary(*thresholds):
+        if is_spatial(threshold):
+            threshold = lfr.minimum(threshold)
+
+        if is_non_spatial(threshold):
+            threshold = threshold.future.get()
+
+        if not threshold >= threshold_value:
+            return False
+
+    return True
+
+
 def lddcreate(elevation, outflowdepth, corevolume, corearea, catchmentprecipitation):
+    # All depressions are removed. Keeping depressions exceeding a threshold is not supported.
+    if not lddcreate_thresholds_are_disabled(
+        outflowdepth, corevolume, corearea, catchmentprecipitation
+    ):
+        raise NotImplementedError("lddcreate with depression thresholds smaller than 1e31")
+
     elevation = read_if_necessary(elevation)[0]
 
-    return lfr.d8_flow_direction(elevation)
+    return lfr.fill_depressions(elevation)[1]
+
 
+def lddcreatedem(elevation, outflowdepth, corevolume, corearea, catchmentprecipitation):
+    # All depressions are removed. Keeping depressions exceeding a threshold is not supported.
+    if not lddcreate_thresholds_are_disabled(
+        outflowdepth, corevolume, corearea, catchmentprecipitation
+    ):
+        raise NotImplementedError("lddcreatedem with depression thresholds smaller than 1e31")
+
+    elevation = read_if_necessary(elevation)[0]
 
-def lddcreatedem(*args):
-    raise NotImplementedError("lddcreatedem")
+    return lfr.fill_depressions(elevation)[0]
 
 
 def ldddist(*args):
@@ -871,6 +908,9 @@ def lddmask(*args):
 
 
 def lddrepair(*args):
+    # Deferred: LUE has no operation yet for breaking cycles in, and redirecting invalid
+    # cells of, an existing flow direction network. Flow directions created by lddcreate
+    # are sound already and do not need repairing.
     raise NotImplementedError("lddrepair")
 
 
@@ -16,6 +16,7 @@ namespace lue::framework {
     void bind_decreasing_order(pybind11::module& module);
     void bind_downstream(pybind11::module& module);
     void bind_downstream_distance(pybind11::module& module);
+    void bind_fill_depressions(pybind11::module& module);
     void bind_first_n(pybind11::module& module);
 #ifdef LUE_FRAMEWORK_WITH_DEVELOPMENT_OPERATIONS
     void bind_inflow_count(pybind11::module& module);
@@ -41,6 +42,7 @@ namespace lue::framework {
         bind_decreasing_order(module);
         bind_downstream(module);
         bind_downstream_distance(module);
+        bind_fill_depressions(module);
         bind_first_n(module);
 #ifdef LUE_FRAMEWORK_WITH_DEVELOPMENT_OPERATIONS
         bind_inflow_count(module);
@@ -0,0 +1,38 @@
+#include "lue/framework/algorithm/value_policies/fill_depressions.hpp"
+#include "lue/framework/configure.hpp"
+#include "lue/py/bind.hpp"
+
+
+using namespace pybind11::literals;
+
+
+namespace lue::framework {
+    namespace {
+
+        class Binder
+        {
+
+            public:
+
+                template<std::floating_point ElevationElement>
+                static void bind(pybind11::module& module)
+                {
+                    Rank const rank{2};
+
+                    module.def(
+                        "fill_depressions",
+                        [](PartitionedArray<ElevationElement, rank> const& elevation) -> auto
+                        { return value_policies::fill_depressions<FlowDirectionElement>(elevation); },
+                        "elevation"_a);
+                }
+        };
+
+    }  // Anonymous namespace
+
+
+    void bind_fill_depressions(pybind11::module& module)
+    {
+        bind<Binder, FloatingPointElements>(module);
+    }
+
+}  // namespace lue::framework
@@ -0,0 +1,27 @@
+import lue.framework as lfr
+import lue_test
+from lue_test.operation_test import OperationTest, setUpModule, tearDownModule
+
+
+class FillDepressionsTest(OperationTest):
+    @lue_test.framework_test_case
+    def test_overloads(self):
+        array_shape = (60, 40)
+        elevation = 5
+
+        for element_type in lfr.floating_point_element_types:
+            elevation_array = lfr.create_array(array_shape, element_type, elevation)
+            self.assert_overload(lfr.fill_depressions, elevation_array)
+
+    @lue_test.framework_test_case
+    def test_flat(self):
+        array_shape = (60, 40)
+
+        # A flat surface does not contain depressions
+        elevation = lfr.create_array(
+            array_shape, lfr.floating_point_element_types[0], 5
+        )
+        filled_elevation, flow_direction = lfr.fill_depressions(elevation)
+
+        self.assertTrue(lfr.all(filled_elevation == elevation).future.get())
+        self.assertTrue(lfr.all(lfr.valid(flow_direction)).future.get())
@@ -149,21 +149,62 @@ class RoutingOperationTest(OperationTest):
                 non_spatial,
             )
 
+    # Elevation containing a pit at (2, 2), which spills over the flat at (3, 2) and
+    # (3, 3) into the outlet at (3, 4), on the border of the array
+    elevation = np.array(
+        [
+            [9, 9, 9, 9, 9],
+            [9, 6, 7, 6, 9],
+            [9, 7, 2, 7, 9],
+            [9, 5, 4, 4, 1],
+            [9, 9, 9, 9, 9],
+        ],
+        dtype=np.float32,
+    )
+
     @lue_test.framework_test_case
     def test_lddcreate(self):
-        for type_ in [np.float32]:
-            spatial, non_spatial = (
-                self.spatial[type_],
-                self.non_spatial[type_],
-            )
+        elevation = lfr.from_numpy(self.elevation, partition_shape=(5, 5))
+        threshold = lfr.create_scalar(np.float32, 1e31)
 
-            _ = lpr.lddcreate(
-                spatial,
-                non_spatial,
-                non_spatial,
-                non_spatial,
-                non_spatial,
-            )
+        ldd = lfr.to_numpy(lpr.lddcreate(elevation, 1e31, threshold, 1e31, 1e31))
+
+        # The filled pit drains over the flat, towards the cell that drains already
+        self.assertEqual(ldd[2, 2], 3)
+
+        # The flat drains towards its edge, into the outlet
+        self.assertEqual(ldd[3, 2], 6)
+        self.assertEqual(ldd[3, 3], 6)
+
+        # The outlet has no lower neighbour and drains into the outside world
+        self.assertEqual(ldd[3, 4], 5)
+
+        with self.assertRaises(NotImplementedError):
+            lpr.lddcreate(elevation, 1e31, 1e31, 1e31, 9e30)
+
+        with self.assertRaises(NotImplementedError):
+            lpr.lddcreate(elevation, self.spatial[np.float32], 1e31, 1e31, 1e31)
+
+    @lue_test.framework_test_case
+    def test_lddcreatedem(self):
+        elevation = lfr.from_numpy(self.elevation, partition_shape=(5, 5))
+        threshold = lfr.create_scalar(np.float32, 1e31)
+
+        filled_elevation = lfr.to_numpy(
+            lpr.lddcreatedem(elevation, 1e31, threshold, 1e31, 1e31)
+        )
+
+        # Only the pit is raised, to the elevation of the flat it spills over
+        filled_elevation_we_want = self.elevation.copy()
+        filled_elevation_we_want[2, 2] = 4
+
+        np.testing.assert_array_equal(filled_elevation, filled_elevation_we_want)
+
+        with self.assertRaises(NotImplementedError):
+            lpr.lddcreatedem(elevation, 1e31, 1e31, 1e31, 9e30)
+
+        with self.assertRaises(NotImplementedError):
+            lpr.lddcreatedem(elevation, self.spatial[np.float32], 1e31, 1e31, 1e31)
 
     @lue_test.framework_test_case
     def test_upstream(self):